@@ -32,4 +32,5 @@ scons -Q --enable-werror --build-3rdparty=all \
       --enable-tests \
       --enable-benchmarks \
       --enable-examples \
+      --enable-io-uring \
       test
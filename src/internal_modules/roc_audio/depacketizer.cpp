@@ -33,9 +33,11 @@ inline void write_beep(sample_t* buf, size_t bufsz) {
 Depacketizer::Depacketizer(packet::IReader& reader,
                            IFrameDecoder& payload_decoder,
                            const audio::SampleSpec& sample_spec,
-                           bool beep)
+                           bool beep,
+                           FrameStatusBuffer* status_buffer)
     : reader_(reader)
     , payload_decoder_(payload_decoder)
+    , status_buffer_(status_buffer)
     , sample_spec_(sample_spec)
     , timestamp_(0)
     , zero_samples_(0)
@@ -84,6 +86,12 @@ void Depacketizer::read_frame_(Frame& frame) {
     roc_panic_if(buff_ptr != buff_end);
 
     set_frame_flags_(frame, info);
+
+    if (status_buffer_) {
+        status_buffer_->add(frame.flags(),
+                            packet::timestamp_t(frame.num_samples()
+                                                / sample_spec_.num_channels()));
+    }
 }
 
 sample_t*
@@ -12,6 +12,7 @@
 #ifndef ROC_AUDIO_DEPACKETIZER_H_
 #define ROC_AUDIO_DEPACKETIZER_H_
 
+#include "roc_audio/frame_status_buffer.h"
 #include "roc_audio/iframe_decoder.h"
 #include "roc_audio/iframe_reader.h"
 #include "roc_audio/sample.h"
@@ -36,10 +37,12 @@ public:
     //!  - @p payload_decoder is used to extract samples from packets
     //!  - @p sample_spec defines a set of channels in the output frames
     //!  - @p beep enables weird beeps instead of silence on packet loss
+    //!  - @p status_buffer is used to record status of every frame; may be NULL
     Depacketizer(packet::IReader& reader,
                  IFrameDecoder& payload_decoder,
                  const audio::SampleSpec& sample_spec,
-                 bool beep);
+                 bool beep,
+                 FrameStatusBuffer* status_buffer);
 
     //! Read audio frame.
     virtual bool read(Frame& frame);
@@ -82,6 +85,7 @@ private:
 
     packet::IReader& reader_;
     IFrameDecoder& payload_decoder_;
+    FrameStatusBuffer* status_buffer_;
 
     const audio::SampleSpec sample_spec_;
 
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/frame_status_buffer.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+FrameStatusBuffer::FrameStatusBuffer(core::IAllocator& allocator)
+    : statuses_(allocator)
+    , mask_(0)
+    , rd_pos_(0)
+    , wr_pos_(0)
+    , duration_(0) {
+}
+
+bool FrameStatusBuffer::reserve(size_t n_statuses) {
+    roc_panic_if_msg(size() != 0, "frame status buffer: can't reserve non-empty buffer");
+
+    size_t buf_size = 1;
+    while (buf_size < n_statuses) {
+        buf_size *= 2;
+    }
+
+    if (!statuses_.resize(buf_size)) {
+        return false;
+    }
+
+    mask_ = buf_size - 1;
+    rd_pos_ = wr_pos_ = 0;
+    duration_ = 0;
+
+    return true;
+}
+
+size_t FrameStatusBuffer::size() const {
+    return wr_pos_ - rd_pos_;
+}
+
+packet::timestamp_t FrameStatusBuffer::duration() const {
+    return duration_;
+}
+
+const FrameCounters& FrameStatusBuffer::counters() const {
+    return counters_;
+}
+
+bool FrameStatusBuffer::read(FrameStatus& status) {
+    if (rd_pos_ == wr_pos_) {
+        return false;
+    }
+
+    status = statuses_[rd_pos_ & mask_];
+    rd_pos_++;
+
+    duration_ -= status.duration;
+
+    return true;
+}
+
+} // namespace audio
+} // namespace roc
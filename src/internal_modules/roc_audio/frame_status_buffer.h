@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/frame_status_buffer.h
+//! @brief Frame status buffer.
+
+#ifndef ROC_AUDIO_FRAME_STATUS_BUFFER_H_
+#define ROC_AUDIO_FRAME_STATUS_BUFFER_H_
+
+#include "roc_audio/frame.h"
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace audio {
+
+//! Status of a frame.
+struct FrameStatus {
+    //! Frame flags, see Frame.
+    unsigned flags;
+
+    //! Frame duration, number of samples per channel.
+    packet::timestamp_t duration;
+
+    FrameStatus()
+        : flags(0)
+        , duration(0) {
+    }
+};
+
+//! Cumulative frame counters.
+struct FrameCounters {
+    //! Number of frames.
+    size_t n_frames;
+
+    //! Number of frames without samples from packets.
+    size_t n_blank_frames;
+
+    //! Number of frames not fully filled with samples from packets.
+    size_t n_incomplete_frames;
+
+    //! Number of frames during which late packets were dropped.
+    size_t n_drop_frames;
+
+    //! Number of statuses which didn't fit into buffer and were merged
+    //! into the newest status in buffer.
+    size_t n_merged_statuses;
+
+    FrameCounters()
+        : n_frames(0)
+        , n_blank_frames(0)
+        , n_incomplete_frames(0)
+        , n_drop_frames(0)
+        , n_merged_statuses(0) {
+    }
+};
+
+//! Frame status buffer.
+//! @remarks
+//!  Fixed-size queue of statuses of recently produced frames, plus cumulative
+//!  counters. Producer (depacketizer) adds a status for every frame, which
+//!  costs a few stores; consumer (watchdog) drains the buffer at control rate.
+//!  If the buffer is full, new statuses are merged into the newest one: flags
+//!  are combined and durations are added, so that consumer still sees the
+//!  whole duration. If the buffer is not reserved, only counters are
+//!  maintained. Not thread-safe.
+class FrameStatusBuffer : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit FrameStatusBuffer(core::IAllocator& allocator);
+
+    //! Allocate buffer for at least given number of statuses.
+    //! @returns
+    //!  false if allocation failed.
+    bool reserve(size_t n_statuses);
+
+    //! Get number of statuses that can be read.
+    size_t size() const;
+
+    //! Get total duration of statuses that can be read.
+    packet::timestamp_t duration() const;
+
+    //! Get cumulative counters.
+    const FrameCounters& counters() const;
+
+    //! Add status of next frame.
+    void add(unsigned flags, packet::timestamp_t duration) {
+        counters_.n_frames++;
+        counters_.n_blank_frames += !(flags & Frame::FlagNonblank);
+        counters_.n_incomplete_frames += !!(flags & Frame::FlagIncomplete);
+        counters_.n_drop_frames += !!(flags & Frame::FlagDrops);
+
+        if (statuses_.size() == 0) {
+            return;
+        }
+
+        duration_ += duration;
+
+        if (wr_pos_ - rd_pos_ == statuses_.size()) {
+            FrameStatus& status = statuses_[(wr_pos_ - 1) & mask_];
+            status.flags |= flags;
+            status.duration += duration;
+
+            counters_.n_merged_statuses++;
+            return;
+        }
+
+        FrameStatus& status = statuses_[wr_pos_ & mask_];
+        status.flags = flags;
+        status.duration = duration;
+
+        wr_pos_++;
+    }
+
+    //! Read status of oldest frame.
+    //! @returns
+    //!  false if there are no statuses.
+    bool read(FrameStatus& status);
+
+private:
+    core::Array<FrameStatus> statuses_;
+    size_t mask_;
+
+    size_t rd_pos_;
+    size_t wr_pos_;
+
+    packet::timestamp_t duration_;
+
+    FrameCounters counters_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_FRAME_STATUS_BUFFER_H_
@@ -14,25 +14,43 @@ namespace audio {
 
 namespace {
 
-// Calculates dot product of arrays IR of filter (@p coeff) and input array (@p samples).
+// Number of independent accumulators in dot product.
+// Allows compiler to vectorize the loop and hides latency of additions.
+enum { DotProdLanes = 8 };
+
+// Calculates dot product of IR of filter (@p coeff) and contiguous window of
+// fe_decim_len input samples (@p samples).
 //
-// - @p coeff Filter impulse response.
-// - @p samples Array with sample values.
-// - @p sample_ind index in input array to start from.
-// - @p len How many samples do we need at output.
-// - @p len_mask Bit mask of input array length.
-float dot_prod(const float* coeff,
-               const float* samples,
-               const size_t sample_ind,
-               const size_t len,
-               const size_t len_mask) {
-    double accum = 0;
-
-    for (size_t i = sample_ind, j = 0; j < len; i = (i - 1) & len_mask, ++j) {
-        accum += (double)coeff[j] * (double)samples[i];
+// Samples are absolute latencies, so accumulation is done in double, as
+// before; lanes only change the order of additions.
+float dot_prod(const float* coeff, const float* samples) {
+    double accum[DotProdLanes];
+
+    for (size_t k = 0; k < DotProdLanes; k++) {
+        accum[k] = 0;
+    }
+
+    for (size_t i = 0; i < fe_decim_len; i += DotProdLanes) {
+        for (size_t k = 0; k < DotProdLanes; k++) {
+            accum[k] += (double)coeff[i + k] * (double)samples[i + k];
+        }
     }
 
-    return (float)accum;
+    double result = 0;
+
+    for (size_t k = 0; k < DotProdLanes; k++) {
+        result += accum[k];
+    }
+
+    return (float)result;
+}
+
+// Stores sample to decimator buffer, moving window one step back.
+void push_to_buff(float* buff, size_t& ind, float sample) {
+    ind = (ind - 1) & fe_decim_len_mask;
+
+    buff[ind] = sample;
+    buff[ind + fe_decim_len] = sample;
 }
 
 } // namespace
@@ -59,10 +77,15 @@ FreqEstimator::FreqEstimator(FreqEstimatorConfig config,
         roc_panic("freq estimator: decim_len should be power of two");
     }
 
+    if (fe_decim_len % DotProdLanes != 0) {
+        roc_panic("freq estimator: decim_len should be multiple of %d",
+                  (int)DotProdLanes);
+    }
+
     memset(dec1_casc_buff_, 0, sizeof(dec1_casc_buff_));
     memset(dec2_casc_buff_, 0, sizeof(dec2_casc_buff_));
 
-    for (size_t i = 0; i < fe_decim_len; i++) {
+    for (size_t i = 0; i < fe_decim_len * 2; i++) {
         dec1_casc_buff_[i] = target_;
         dec2_casc_buff_[i] = target_;
     }
@@ -75,43 +98,43 @@ float FreqEstimator::freq_coeff() const {
 void FreqEstimator::update(packet::timestamp_t current) {
     float filtered;
 
-    if (run_decimators_(current, filtered)) {
+    if (push_sample_(current) && run_decimators_(filtered)) {
         coeff_ = run_controller_(filtered);
     }
 }
 
-bool FreqEstimator::run_decimators_(packet::timestamp_t current, float& filtered) {
+// Stores new sample to the first stage decimator.
+// Returns true if it's time to calculate first decimator's output.
+bool FreqEstimator::push_sample_(packet::timestamp_t current) {
+    push_to_buff(dec1_casc_buff_, dec1_ind_, (float)current);
+
     samples_counter_++;
 
-    dec1_casc_buff_[dec1_ind_] = (float)current;
-
-    if ((samples_counter_ % config_.decimation_factor1) == 0) {
-        // Time to calculate first decimator's samples.
-        dec2_casc_buff_[dec2_ind_] = dot_prod(fe_decim_h, dec1_casc_buff_, dec1_ind_,
-                                              fe_decim_len, fe_decim_len_mask)
-            / fe_decim_h_gain;
-
-        // If the second stage decimator is totally turned off
-        if (config_.decimation_factor2 == 0) {
-            filtered = dec2_casc_buff_[dec2_ind_];
-            return true;
-        } else if (((samples_counter_
-                     % (config_.decimation_factor1 * config_.decimation_factor2))
-                    == 0)) {
-            samples_counter_ = 0;
-
-            // Time to calculate second decimator (and freq estimator's) output.
-            filtered = dot_prod(fe_decim_h, dec2_casc_buff_, dec2_ind_, fe_decim_len,
-                                fe_decim_len_mask)
-                / fe_decim_h_gain;
-
-            return true;
-        }
+    return (samples_counter_ % config_.decimation_factor1) == 0;
+}
+
+// Calculates output of decimators.
+// Returns true if freq estimator's output is ready.
+bool FreqEstimator::run_decimators_(float& filtered) {
+    const float dec1_out =
+        dot_prod(fe_decim_h, dec1_casc_buff_ + dec1_ind_) / fe_decim_h_gain;
 
-        dec2_ind_ = (dec2_ind_ + 1) & fe_decim_len_mask;
+    // If the second stage decimator is totally turned off
+    if (config_.decimation_factor2 == 0) {
+        filtered = dec1_out;
+        return true;
     }
 
-    dec1_ind_ = (dec1_ind_ + 1) & fe_decim_len_mask;
+    push_to_buff(dec2_casc_buff_, dec2_ind_, dec1_out);
+
+    if ((samples_counter_ % (config_.decimation_factor1 * config_.decimation_factor2))
+        == 0) {
+        samples_counter_ = 0;
+
+        // Time to calculate second decimator (and freq estimator's) output.
+        filtered = dot_prod(fe_decim_h, dec2_casc_buff_ + dec2_ind_) / fe_decim_h_gain;
+        return true;
+    }
 
     return false;
 }
@@ -57,16 +57,20 @@ public:
     void update(packet::timestamp_t current_latency);
 
 private:
-    bool run_decimators_(packet::timestamp_t current, float& filtered);
+    bool push_sample_(packet::timestamp_t current);
+    bool run_decimators_(float& filtered);
     float run_controller_(float current);
 
     const FreqEstimatorConfig config_;
     const float target_; // Target latency.
 
-    float dec1_casc_buff_[fe_decim_len];
+    // Decimator buffers hold latencies, newest first.
+    // Every sample is stored twice, at index and index + fe_decim_len, so that
+    // filter window is always contiguous and doesn't need index wrapping.
+    float dec1_casc_buff_[fe_decim_len * 2];
     size_t dec1_ind_;
 
-    float dec2_casc_buff_[fe_decim_len];
+    float dec2_casc_buff_[fe_decim_len * 2];
     size_t dec2_ind_;
 
     size_t samples_counter_; // Input samples counter.
@@ -22,6 +22,7 @@ const core::nanoseconds_t LogInterval = 5 * core::Second;
 LatencyMonitor::LatencyMonitor(const packet::SortedQueue& queue,
                                const Depacketizer& depacketizer,
                                ResamplerReader* resampler,
+                               const packet::JitterEstimator* jitter_estimator,
                                const LatencyMonitorConfig& config,
                                core::nanoseconds_t target_latency,
                                const audio::SampleSpec& input_sample_spec,
@@ -30,6 +31,7 @@ LatencyMonitor::LatencyMonitor(const packet::SortedQueue& queue,
     : queue_(queue)
     , depacketizer_(depacketizer)
     , resampler_(resampler)
+    , jitter_estimator_(jitter_estimator)
     , fe_(fe_config,
           (packet::timestamp_t)input_sample_spec.ns_2_rtp_timestamp(target_latency))
     , rate_limiter_(LogInterval)
@@ -42,6 +44,7 @@ LatencyMonitor::LatencyMonitor(const packet::SortedQueue& queue,
     , min_latency_(input_sample_spec.ns_2_rtp_timestamp(config.min_latency))
     , max_latency_(input_sample_spec.ns_2_rtp_timestamp(config.max_latency))
     , max_scaling_delta_(config.max_scaling_delta)
+    , jitter_tolerance_(config.jitter_tolerance)
     , input_sample_spec_(input_sample_spec)
     , output_sample_spec_(output_sample_spec)
     , valid_(false) {
@@ -137,26 +140,31 @@ bool LatencyMonitor::get_latency_(packet::timestamp_diff_t& latency) const {
 }
 
 bool LatencyMonitor::check_latency_(packet::timestamp_diff_t latency) const {
-    if (latency < min_latency_) {
+    const packet::timestamp_diff_t margin = jitter_margin_();
+
+    const packet::timestamp_diff_t min_latency = min_latency_ - margin;
+    const packet::timestamp_diff_t max_latency = max_latency_ + margin;
+
+    if (latency < min_latency) {
         roc_log(
             LogDebug,
             "latency monitor: latency out of bounds: latency=%ld(%.3fms) min=%ld(%.3fms)",
             (long)latency,
             (double)input_sample_spec_.rtp_timestamp_2_ns(latency) / core::Millisecond,
-            (long)min_latency_,
-            (double)input_sample_spec_.rtp_timestamp_2_ns(min_latency_)
+            (long)min_latency,
+            (double)input_sample_spec_.rtp_timestamp_2_ns(min_latency)
                 / core::Millisecond);
         return false;
     }
 
-    if (latency > max_latency_) {
+    if (latency > max_latency) {
         roc_log(
             LogDebug,
             "latency monitor: latency out of bounds: latency=%ld(%.3fms) max=%ld(%.3fms)",
             (long)latency,
             (double)input_sample_spec_.rtp_timestamp_2_ns(latency) / core::Millisecond,
-            (long)max_latency_,
-            (double)input_sample_spec_.rtp_timestamp_2_ns(max_latency_)
+            (long)max_latency,
+            (double)input_sample_spec_.rtp_timestamp_2_ns(max_latency)
                 / core::Millisecond);
         return false;
     }
@@ -215,7 +223,8 @@ bool LatencyMonitor::update_resampler_(packet::timestamp_t pos,
     if (rate_limiter_.allow()) {
         roc_log(LogDebug,
                 "latency monitor:"
-                " latency=%lu(%.3fms) target=%lu(%.3fms) fe=%.5f trim_fe=%.5f",
+                " latency=%lu(%.3fms) target=%lu(%.3fms) jitter=%.3fms"
+                " fe=%.5f trim_fe=%.5f",
                 (unsigned long)latency,
                 (double)input_sample_spec_.rtp_timestamp_2_ns(
                     (packet::timestamp_diff_t)latency)
@@ -224,7 +233,7 @@ bool LatencyMonitor::update_resampler_(packet::timestamp_t pos,
                 (double)input_sample_spec_.rtp_timestamp_2_ns(
                     (packet::timestamp_diff_t)target_latency_)
                     / core::Millisecond,
-                (double)freq_coeff, (double)trimmed_coeff);
+                jitter_ms_(), (double)freq_coeff, (double)trimmed_coeff);
     }
 
     if (!resampler_->set_scaling(trimmed_coeff)) {
@@ -239,16 +248,35 @@ bool LatencyMonitor::update_resampler_(packet::timestamp_t pos,
 
 void LatencyMonitor::report_latency_(packet::timestamp_diff_t latency) {
     if (rate_limiter_.allow()) {
-        roc_log(LogDebug, "latency monitor: latency=%ld(%.3fms) target=%lu(%.3fms)",
+        roc_log(LogDebug,
+                "latency monitor: latency=%ld(%.3fms) target=%lu(%.3fms) jitter=%.3fms",
                 (long)latency,
                 (double)input_sample_spec_.rtp_timestamp_2_ns(latency)
                     / core::Millisecond,
                 (unsigned long)target_latency_,
                 (double)input_sample_spec_.rtp_timestamp_2_ns(
                     (packet::timestamp_diff_t)target_latency_)
-                    / core::Millisecond);
+                    / core::Millisecond,
+                jitter_ms_());
     }
 }
 
+packet::timestamp_diff_t LatencyMonitor::jitter_margin_() const {
+    if (!jitter_estimator_ || jitter_tolerance_ <= 0) {
+        return 0;
+    }
+
+    return input_sample_spec_.ns_2_rtp_timestamp(core::nanoseconds_t(
+        (double)jitter_estimator_->jitter() * (double)jitter_tolerance_));
+}
+
+double LatencyMonitor::jitter_ms_() const {
+    if (!jitter_estimator_) {
+        return 0;
+    }
+
+    return (double)jitter_estimator_->jitter() / core::Millisecond;
+}
+
 } // namespace audio
 } // namespace roc
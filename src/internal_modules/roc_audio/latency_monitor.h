@@ -19,6 +19,7 @@
 #include "roc_core/noncopyable.h"
 #include "roc_core/rate_limiter.h"
 #include "roc_core/time.h"
+#include "roc_packet/jitter_estimator.h"
 #include "roc_packet/sorted_queue.h"
 #include "roc_packet/units.h"
 
@@ -44,16 +45,24 @@ struct LatencyMonitorConfig {
     //! For example, 0.01 allows freq_coeff values in range [0.99; 1.01].
     float max_scaling_delta;
 
+    //! Jitter tolerance, in units of estimated interarrival jitter.
+    //! Latency bounds are widened by this number of jitters, so that session
+    //! isn't terminated because of spikes caused by network jitter.
+    //! Zero disables the adjustment.
+    float jitter_tolerance;
+
     LatencyMonitorConfig()
         : fe_update_interval(5 * core::Millisecond)
         , min_latency(0)
         , max_latency(0)
-        , max_scaling_delta(0.005f) {
+        , max_scaling_delta(0.005f)
+        , jitter_tolerance(0) {
     }
 };
 
 //! Session latency monitor.
 //!  - calculates session latency
+//!  - widens latency bounds according to interarrival jitter
 //!  - calculates session scaling factor
 //!  - trims scaling factor to the allowed range
 //!  - updates resampler scaling
@@ -65,6 +74,7 @@ public:
     //! @b Parameters
     //!  - @p queue and @p depacketizer are used to calculate the latency
     //!  - @p resampler is used to set the scaling factor, may be null
+    //!  - @p jitter_estimator is used to adjust latency bounds, may be null
     //!  - @p config defines various miscellaneous parameters
     //!  - @p target_latency defines FreqEstimator target latency, in samples
     //!  - @p input_sample_spec is the sample spec of the input packets
@@ -72,6 +82,7 @@ public:
     LatencyMonitor(const packet::SortedQueue& queue,
                    const Depacketizer& depacketizer,
                    ResamplerReader* resampler,
+                   const packet::JitterEstimator* jitter_estimator,
                    const LatencyMonitorConfig& config,
                    core::nanoseconds_t target_latency,
                    const audio::SampleSpec& input_sample_spec,
@@ -97,9 +108,13 @@ private:
 
     void report_latency_(packet::timestamp_diff_t latency);
 
+    packet::timestamp_diff_t jitter_margin_() const;
+    double jitter_ms_() const;
+
     const packet::SortedQueue& queue_;
     const Depacketizer& depacketizer_;
     ResamplerReader* resampler_;
+    const packet::JitterEstimator* jitter_estimator_;
     FreqEstimator fe_;
 
     core::RateLimiter rate_limiter_;
@@ -113,6 +128,7 @@ private:
     const packet::timestamp_diff_t max_latency_;
 
     const float max_scaling_delta_;
+    const float jitter_tolerance_;
 
     const audio::SampleSpec input_sample_spec_;
     const audio::SampleSpec output_sample_spec_;
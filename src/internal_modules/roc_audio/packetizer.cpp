@@ -47,6 +47,10 @@ bool Packetizer::valid() const {
     return valid_;
 }
 
+packet::source_t Packetizer::source() const {
+    return source_;
+}
+
 void Packetizer::write(Frame& frame) {
     if (frame.num_samples() % sample_spec_.num_channels() != 0) {
         roc_panic("packetizer: unexpected frame size");
@@ -64,6 +64,9 @@ public:
     //! Check if object is successfully constructed.
     bool valid() const;
 
+    //! Get SSRC of produced packets.
+    packet::source_t source() const;
+
 private:
     bool begin_packet_();
     void end_packet_();
@@ -14,10 +14,130 @@
 namespace roc {
 namespace audio {
 
+namespace {
+
+// Position of most significant bit set, value should be non-zero.
+size_t msb_index(uint64_t value) {
+    size_t index = 0;
+
+    for (size_t shift = 32; shift != 0; shift /= 2) {
+        if (value >> shift) {
+            value >>= shift;
+            index += shift;
+        }
+    }
+
+    return index;
+}
+
+double ns_2_ms(core::nanoseconds_t value) {
+    return (double)value / core::Millisecond;
+}
+
+} // namespace
+
+ProfilerHistogram::ProfilerHistogram() {
+    clear();
+}
+
+void ProfilerHistogram::add(core::nanoseconds_t value) {
+    if (value < 0) {
+        value = 0;
+    }
+
+    buckets_[bucket_index_((uint64_t)value)]++;
+    count_++;
+
+    if (value > max_) {
+        max_ = value;
+    }
+}
+
+void ProfilerHistogram::clear() {
+    memset(buckets_, 0, sizeof(buckets_));
+    count_ = 0;
+    max_ = 0;
+}
+
+size_t ProfilerHistogram::count() const {
+    return count_;
+}
+
+core::nanoseconds_t ProfilerHistogram::max() const {
+    return max_;
+}
+
+core::nanoseconds_t ProfilerHistogram::quantile(double quantile) const {
+    if (count_ == 0) {
+        return 0;
+    }
+
+    // number of values that should be less or equal to result
+    size_t rank = (size_t)(quantile * count_ + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    if (rank > count_) {
+        rank = count_;
+    }
+
+    size_t seen = 0;
+
+    for (size_t n = 0; n < NumBuckets; n++) {
+        seen += buckets_[n];
+
+        if (seen >= rank) {
+            if (n == NumBuckets - 1) {
+                // last bucket has no upper bound
+                return max_;
+            }
+            const core::nanoseconds_t value = (core::nanoseconds_t)bucket_max_value_(n);
+            // bucket bound may exceed actual values
+            return value < max_ ? value : max_;
+        }
+    }
+
+    return max_;
+}
+
+size_t ProfilerHistogram::bucket_index_(uint64_t value) {
+    if (value < SubBuckets) {
+        return (size_t)value;
+    }
+
+    const size_t msb = msb_index(value);
+
+    if (msb >= MaxValueBits) {
+        return NumBuckets - 1;
+    }
+
+    // shift value so that it has exactly SubBucketBits+1 significant bits,
+    // then drop the leading one to get index inside group
+    const size_t shift = msb - SubBucketBits;
+    const size_t group = shift + 1;
+
+    return group * SubBuckets + (size_t)((value >> shift) - SubBuckets);
+}
+
+uint64_t ProfilerHistogram::bucket_max_value_(size_t index) {
+    if (index < SubBuckets) {
+        return index;
+    }
+
+    const size_t group = index / SubBuckets;
+    const size_t shift = group - 1;
+
+    const uint64_t base = (uint64_t)(index % SubBuckets + SubBuckets) << shift;
+
+    return base + ((uint64_t)1 << shift) - 1;
+}
+
 Profiler::Profiler(core::IAllocator& allocator,
                    const audio::SampleSpec& sample_spec,
-                   ProfilerConfig profiler_config)
-    : rate_limiter_(profiler_config.profiling_interval)
+                   ProfilerConfig profiler_config,
+                   const char* name)
+    : name_(name)
+    , rate_limiter_(profiler_config.profiling_interval)
     , interval_(profiler_config.profiling_interval)
     , chunk_length_(
           (size_t)(sample_spec.sample_rate()
@@ -48,6 +168,12 @@ Profiler::Profiler(core::IAllocator& allocator,
     valid_ = true;
 }
 
+Profiler::~Profiler() {
+    if (valid_ && histogram_.count() != 0) {
+        log_histogram();
+    }
+}
+
 bool Profiler::valid() const {
     return valid_;
 }
@@ -103,11 +229,16 @@ void Profiler::add_frame(size_t frame_size, core::nanoseconds_t elapsed) {
 
     update_moving_avg_(frame_size, elapsed);
 
+    histogram_.add(elapsed);
+
     if (rate_limiter_.allow()) {
         roc_log(LogDebug,
-                "profiler: avg for last %.1f sec: %lu sample/sec (%.2f sec/sec)",
-                (double)interval_ / core::Second, (unsigned long)get_moving_avg(),
+                "profiler: %s: avg for last %.1f sec: %lu sample/sec (%.2f sec/sec)",
+                name_, (double)interval_ / core::Second,
+                (unsigned long)get_moving_avg(),
                 (double)get_moving_avg() / sample_spec_.sample_rate());
+
+        log_histogram();
     }
 }
 
@@ -128,5 +259,22 @@ float Profiler::get_moving_avg() {
     }
 }
 
+const char* Profiler::name() const {
+    return name_;
+}
+
+const ProfilerHistogram& Profiler::histogram() const {
+    return histogram_;
+}
+
+void Profiler::log_histogram() const {
+    roc_log(LogDebug,
+            "profiler: %s: frame time for %lu frames:"
+            " p50=%.3fms p99=%.3fms p999=%.3fms max=%.3fms",
+            name_, (unsigned long)histogram_.count(),
+            ns_2_ms(histogram_.quantile(0.5)), ns_2_ms(histogram_.quantile(0.99)),
+            ns_2_ms(histogram_.quantile(0.999)), ns_2_ms(histogram_.max()));
+}
+
 } // namespace audio
 } // namespace roc
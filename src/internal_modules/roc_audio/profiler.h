@@ -47,6 +47,63 @@ struct ProfilerConfig {
     core::nanoseconds_t chunk_duration;
 };
 
+//! Histogram of frame processing times.
+//!
+//! Log-linear histogram, similar to HdrHistogram. Values are grouped by their
+//! most significant bit, and every group is split into SubBuckets linear
+//! buckets, so relative error of reported values is below 1/SubBuckets for
+//! any magnitude.
+//!
+//! All buckets are stored inside the object, so adding values never
+//! allocates memory and takes constant time.
+class ProfilerHistogram {
+public:
+    enum {
+        //! Number of bits of precision of recorded values.
+        SubBucketBits = 5,
+
+        //! Number of linear buckets per power of two.
+        SubBuckets = 1 << SubBucketBits,
+
+        //! Values up to 2^MaxValueBits nanoseconds (~18 minutes) are recorded
+        //! precisely, larger values are put into the last bucket.
+        MaxValueBits = 40,
+
+        //! Total number of buckets.
+        NumBuckets = (MaxValueBits - SubBucketBits + 1) * SubBuckets
+    };
+
+    //! Initialize empty histogram.
+    ProfilerHistogram();
+
+    //! Add value.
+    void add(core::nanoseconds_t value);
+
+    //! Remove all values.
+    void clear();
+
+    //! Get number of added values.
+    size_t count() const;
+
+    //! Get maximum added value.
+    core::nanoseconds_t max() const;
+
+    //! Get value at given quantile.
+    //! @remarks
+    //!  @p quantile is in range [0; 1], e.g. 0.99 for 99th percentile.
+    //!  Returns the highest value that falls into the same bucket as the
+    //!  requested one, or zero if histogram is empty.
+    core::nanoseconds_t quantile(double quantile) const;
+
+private:
+    static size_t bucket_index_(uint64_t value);
+    static uint64_t bucket_max_value_(size_t index);
+
+    uint32_t buckets_[NumBuckets];
+    size_t count_;
+    core::nanoseconds_t max_;
+};
+
 //! Profiler
 //! The role of the profiler is to report the average processing speed (# of samples
 //! processed per time unit) during the last N seconds. We want to calculate the average
@@ -62,12 +119,21 @@ struct ProfilerConfig {
 //! moving average is calculated. When the buffer is not entirely full the cumulative
 //! moving average algorithm is used and once the buffer is full the simple moving average
 //! algorithm is used.
+//!
+//! In addition, profiler records time spent on every frame into a histogram,
+//! to report tail latency of the profiled stage.
 class Profiler : public core::NonCopyable<> {
 public:
     //! Initialization.
+    //! @remarks
+    //!  @p name identifies profiled stage in logs, should be a string literal.
     Profiler(core::IAllocator& allocator,
              const audio::SampleSpec& sample_spec,
-             ProfilerConfig profiler_config);
+             ProfilerConfig profiler_config,
+             const char* name);
+
+    //! Log collected statistics.
+    ~Profiler();
 
     //! Check if the profiler was succefully constructed.
     bool valid() const;
@@ -78,9 +144,22 @@ public:
     //! For Testing Only
     float get_moving_avg();
 
+    //! Get name of profiled stage.
+    const char* name() const;
+
+    //! Get histogram of frame processing times.
+    //! @remarks
+    //!  Contains all frames since profiler creation.
+    const ProfilerHistogram& histogram() const;
+
+    //! Log percentiles of frame processing times.
+    void log_histogram() const;
+
 private:
     void update_moving_avg_(size_t frame_size, core::nanoseconds_t elapsed);
 
+    const char* name_;
+
     core::RateLimiter rate_limiter_;
 
     core::nanoseconds_t interval_;
@@ -96,6 +175,8 @@ private:
 
     const audio::SampleSpec sample_spec_;
 
+    ProfilerHistogram histogram_;
+
     bool valid_;
     bool buffer_full_;
 };
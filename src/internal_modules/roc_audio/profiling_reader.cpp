@@ -17,8 +17,9 @@ namespace audio {
 ProfilingReader::ProfilingReader(IFrameReader& reader,
                                  core::IAllocator& allocator,
                                  const audio::SampleSpec& sample_spec,
-                                 ProfilerConfig profiler_config)
-    : profiler_(allocator, sample_spec, profiler_config)
+                                 ProfilerConfig profiler_config,
+                                 const char* name)
+    : profiler_(allocator, sample_spec, profiler_config, name)
     , reader_(reader) {
 }
 
@@ -44,5 +45,9 @@ bool ProfilingReader::valid() const {
     return profiler_.valid();
 }
 
+const Profiler& ProfilingReader::profiler() const {
+    return profiler_;
+}
+
 } // namespace audio
 } // namespace roc
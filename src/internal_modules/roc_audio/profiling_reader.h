@@ -26,10 +26,13 @@ namespace audio {
 class ProfilingReader : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialization.
+    //! @remarks
+    //!  @p name identifies profiled stage in logs, should be a string literal.
     ProfilingReader(IFrameReader& reader,
                     core::IAllocator& allocator,
                     const audio::SampleSpec& sample_spec,
-                    ProfilerConfig profiler_config);
+                    ProfilerConfig profiler_config,
+                    const char* name);
 
     //! Read audio frame.
     virtual bool read(Frame& frame);
@@ -37,6 +40,9 @@ public:
     //! Check if the profiler was succefully constructed.
     bool valid() const;
 
+    //! Get underlying profiler.
+    const Profiler& profiler() const;
+
 private:
     core::nanoseconds_t read_(Frame& frame, bool& ret);
 
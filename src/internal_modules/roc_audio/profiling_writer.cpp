@@ -17,8 +17,9 @@ namespace audio {
 ProfilingWriter::ProfilingWriter(IFrameWriter& writer,
                                  core::IAllocator& allocator,
                                  const audio::SampleSpec& sample_spec,
-                                 ProfilerConfig profiler_config)
-    : profiler_(allocator, sample_spec, profiler_config)
+                                 ProfilerConfig profiler_config,
+                                 const char* name)
+    : profiler_(allocator, sample_spec, profiler_config, name)
     , writer_(writer) {
 }
 
@@ -40,5 +41,9 @@ bool ProfilingWriter::valid() const {
     return profiler_.valid();
 }
 
+const Profiler& ProfilingWriter::profiler() const {
+    return profiler_;
+}
+
 } // namespace audio
 } // namespace roc
@@ -26,10 +26,13 @@ namespace audio {
 class ProfilingWriter : public IFrameWriter, public core::NonCopyable<> {
 public:
     //! Initialization.
+    //! @remarks
+    //!  @p name identifies profiled stage in logs, should be a string literal.
     ProfilingWriter(IFrameWriter& writer,
                     core::IAllocator& allocator,
                     const audio::SampleSpec& sample_spec,
-                    ProfilerConfig profiler_config);
+                    ProfilerConfig profiler_config,
+                    const char* name);
 
     //! Write audio frame.
     virtual void write(Frame& frame);
@@ -37,6 +40,9 @@ public:
     //! Check if the profiler was succefully constructed.
     bool valid() const;
 
+    //! Get underlying profiler.
+    const Profiler& profiler() const;
+
 private:
     core::nanoseconds_t write_(Frame& frame);
 
@@ -19,6 +19,9 @@ const char* resampler_backend_to_str(ResamplerBackend backend) {
     case ResamplerBackend_Speex:
         return "speex";
 
+    case ResamplerBackend_Drift:
+        return "drift";
+
     case ResamplerBackend_Default:
         break;
     }
@@ -24,7 +24,11 @@ enum ResamplerBackend {
     ResamplerBackend_Builtin,
 
     //! SpeexDSP resampler.
-    ResamplerBackend_Speex
+    ResamplerBackend_Speex,
+
+    //! Lightweight resampler for clock drift compensation.
+    //! Supports only equal input and output rates and scaling close to 1.
+    ResamplerBackend_Drift
 };
 
 //! Get string name of resampler backend.
@@ -7,6 +7,7 @@
  */
 
 #include "roc_audio/resampler_builtin.h"
+#include "roc_audio/sinc_table_cache.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/stddefs.h"
@@ -102,7 +103,7 @@ inline size_t get_window_interp(ResamplerProfile profile) {
 
 } // namespace
 
-BuiltinResampler::BuiltinResampler(core::IAllocator& allocator,
+BuiltinResampler::BuiltinResampler(core::IAllocator&,
                                    core::BufferFactory<sample_t>& buffer_factory,
                                    ResamplerProfile profile,
                                    core::nanoseconds_t frame_length,
@@ -120,7 +121,6 @@ BuiltinResampler::BuiltinResampler(core::IAllocator& allocator,
     , qt_half_sinc_window_size_(float_to_fixedpoint(window_size_))
     , window_interp_(get_window_interp(profile))
     , window_interp_bits_(calc_bits(window_interp_))
-    , sinc_table_(allocator)
     , sinc_table_ptr_(NULL)
     , qt_half_window_size_(float_to_fixedpoint((float)window_size_ / scaling_))
     , qt_epsilon_(float_to_fixedpoint(5e-8f))
@@ -133,7 +133,7 @@ BuiltinResampler::BuiltinResampler(core::IAllocator& allocator,
         return;
     }
 
-    if (!fill_sinc_()) {
+    if (!acquire_sinc_()) {
         return;
     }
 
@@ -151,6 +151,9 @@ BuiltinResampler::BuiltinResampler(core::IAllocator& allocator,
 }
 
 BuiltinResampler::~BuiltinResampler() {
+    if (sinc_table_ptr_) {
+        SincTableCache::instance().release(sinc_table_ptr_);
+    }
 }
 
 bool BuiltinResampler::valid() const {
@@ -330,29 +333,13 @@ bool BuiltinResampler::check_config_() const {
     return true;
 }
 
-bool BuiltinResampler::fill_sinc_() {
-    if (!sinc_table_.resize(window_size_ * window_interp_ + 2)) {
+bool BuiltinResampler::acquire_sinc_() {
+    sinc_table_ptr_ = SincTableCache::instance().acquire(window_size_, window_interp_);
+    if (!sinc_table_ptr_) {
         roc_log(LogError, "builtin resampler: can't allocate sinc table");
         return false;
     }
 
-    const double sinc_step = 1.0 / (double)window_interp_;
-    double sinc_t = sinc_step;
-
-    sinc_table_[0] = 1.0f;
-    for (size_t i = 1; i < sinc_table_.size(); ++i) {
-        const double window = 0.54
-            - 0.46
-                * std::cos(2 * M_PI
-                           * ((double)(i - 1) / 2.0 / (double)sinc_table_.size() + 0.5));
-        sinc_table_[i] = (float)(std::sin(M_PI * sinc_t) / M_PI / sinc_t * window);
-        sinc_t += sinc_step;
-    }
-    sinc_table_[sinc_table_.size() - 2] = 0;
-    sinc_table_[sinc_table_.size() - 1] = 0;
-
-    sinc_table_ptr_ = &sinc_table_[0];
-
     return true;
 }
 
@@ -18,7 +18,6 @@
 #include "roc_audio/resampler_profile.h"
 #include "roc_audio/sample.h"
 #include "roc_audio/sample_spec.h"
-#include "roc_core/array.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/slice.h"
@@ -77,7 +76,7 @@ private:
 
     bool check_config_() const;
 
-    bool fill_sinc_();
+    bool acquire_sinc_();
     sample_t sinc_(fixedpoint_t x, float fract_x);
 
     // Computes single sample of the particular audio channel.
@@ -103,7 +102,7 @@ private:
     const size_t window_interp_;
     const size_t window_interp_bits_;
 
-    core::Array<sample_t> sinc_table_;
+    // shared between all resamplers with the same window parameters
     const sample_t* sinc_table_ptr_;
 
     // half window len in Q8.24 in terms of input signal
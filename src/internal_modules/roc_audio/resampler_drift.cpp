@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/resampler_drift.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Catmull-Rom spline through (-1, xm1), (0, x0), (1, x1), (2, x2), evaluated at t.
+inline sample_t
+interpolate(sample_t xm1, sample_t x0, sample_t x1, sample_t x2, sample_t t) {
+    return x0
+        + 0.5f * t
+        * (x1 - xm1
+           + t * (2.0f * xm1 - 5.0f * x0 + 4.0f * x1 - x2
+                  + t * (3.0f * (x0 - x1) + x2 - xm1)));
+}
+
+// Maximum allowed deviation of scaling factor from 1. Larger scaling would
+// produce audible aliasing without a low-pass filter.
+const float MaxScalingDelta = 0.1f;
+
+} // namespace
+
+DriftResampler::DriftResampler(core::IAllocator&,
+                               core::BufferFactory<sample_t>& buffer_factory,
+                               ResamplerProfile,
+                               core::nanoseconds_t frame_length,
+                               const audio::SampleSpec& sample_spec)
+    : sample_spec_(sample_spec)
+    , num_ch_(sample_spec.num_channels())
+    , n_ready_frames_(1)
+    , prev_frame_(NULL)
+    , curr_frame_(NULL)
+    , frame_size_(sample_spec.ns_2_samples_overall(frame_length))
+    , frame_size_ch_(num_ch_ ? frame_size_ / num_ch_ : 0)
+    , position_(0)
+    , step_(1)
+    , valid_(false) {
+    if (!check_config_()) {
+        return;
+    }
+
+    if (!alloc_frames_(buffer_factory)) {
+        return;
+    }
+
+    roc_log(LogDebug, "drift resampler: initializing: frame_size=%lu channels_num=%lu",
+            (unsigned long)frame_size_, (unsigned long)num_ch_);
+
+    valid_ = true;
+}
+
+bool DriftResampler::valid() const {
+    return valid_;
+}
+
+bool DriftResampler::set_scaling(size_t input_sample_rate,
+                                 size_t output_sample_rate,
+                                 float multiplier) {
+    if (input_sample_rate == 0 || output_sample_rate == 0) {
+        roc_log(LogError, "drift resampler: invalid rate");
+        return false;
+    }
+
+    // There is no anti-aliasing filter, so real rate conversion is not supported.
+    if (input_sample_rate != output_sample_rate) {
+        roc_log(LogError,
+                "drift resampler: input and output rates should be equal:"
+                " input_rate=%lu output_rate=%lu",
+                (unsigned long)input_sample_rate, (unsigned long)output_sample_rate);
+        return false;
+    }
+
+    // Also filters out NaN.
+    if (!(multiplier >= 1.0f - MaxScalingDelta
+          && multiplier <= 1.0f + MaxScalingDelta)) {
+        roc_log(LogError,
+                "drift resampler: scaling out of range: scaling=%.5f max_delta=%.5f",
+                (double)multiplier, (double)MaxScalingDelta);
+        return false;
+    }
+
+    const double new_step = (double)multiplier;
+
+    // One output sample should never skip a whole frame, otherwise
+    // interpolation window won't fit into previous and current frames.
+    if (new_step > double(frame_size_ch_ - NumTaps)) {
+        roc_log(LogError,
+                "drift resampler: scaling does not fit frame size:"
+                " frame_size=%lu scaling=%.5f",
+                (unsigned long)frame_size_, new_step);
+        return false;
+    }
+
+    step_ = new_step;
+
+    return true;
+}
+
+const core::Slice<sample_t>& DriftResampler::begin_push_input() {
+    if (n_ready_frames_ < 2) {
+        return frames_[n_ready_frames_];
+    }
+
+    core::Slice<sample_t> new_last_frame = frames_[0];
+    frames_[0] = frames_[1];
+    frames_[1] = new_last_frame;
+
+    return frames_[1];
+}
+
+void DriftResampler::end_push_input() {
+    prev_frame_ = frames_[0].data();
+    curr_frame_ = frames_[1].data();
+
+    if (n_ready_frames_ < 2) {
+        n_ready_frames_++;
+    }
+
+    if (position_ >= double(frame_size_ch_ - NumTaps / 2)) {
+        position_ -= double(frame_size_ch_);
+    }
+}
+
+size_t DriftResampler::pop_output(Frame& out) {
+    if (n_ready_frames_ < 2) {
+        return 0;
+    }
+
+    // Last position for which all taps are inside current frame.
+    const double max_position = double(frame_size_ch_ - NumTaps / 2);
+
+    // Positions at which left taps still reach previous frame.
+    const double min_inner_position = double(NumTaps / 2 - 1);
+
+    sample_t* out_data = out.samples();
+    size_t out_pos = 0;
+
+    for (; out_pos < out.num_samples(); out_pos += num_ch_) {
+        if (position_ >= max_position) {
+            break;
+        }
+
+        // Position is never below -NumTaps/2, so truncation of shifted
+        // value gives floor without calling floor().
+        const ptrdiff_t index = ptrdiff_t(position_ + NumTaps / 2) - NumTaps / 2;
+        const sample_t t = sample_t(position_ - double(index));
+
+        if (position_ >= min_inner_position) {
+            const sample_t* in = curr_frame_ + (size_t(index) - 1) * num_ch_;
+
+            for (size_t ch = 0; ch < num_ch_; ch++) {
+                out_data[out_pos + ch] =
+                    interpolate(in[ch], in[num_ch_ + ch], in[num_ch_ * 2 + ch],
+                                in[num_ch_ * 3 + ch], t);
+            }
+        } else {
+            for (size_t ch = 0; ch < num_ch_; ch++) {
+                out_data[out_pos + ch] = interpolate(
+                    input_sample_(index - 1, ch), input_sample_(index, ch),
+                    input_sample_(index + 1, ch), input_sample_(index + 2, ch), t);
+            }
+        }
+
+        position_ += step_;
+    }
+
+    return out_pos;
+}
+
+bool DriftResampler::alloc_frames_(core::BufferFactory<sample_t>& buffer_factory) {
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(frames_); n++) {
+        frames_[n] = buffer_factory.new_buffer();
+
+        if (!frames_[n]) {
+            roc_log(LogError, "drift resampler: can't allocate frame buffer");
+            return false;
+        }
+
+        frames_[n].reslice(0, frame_size_);
+    }
+
+    // first frame serves as zero history for the first input frame
+    memset(frames_[0].data(), 0, frames_[0].size() * sizeof(sample_t));
+
+    return true;
+}
+
+bool DriftResampler::check_config_() const {
+    if (num_ch_ < 1) {
+        roc_log(LogError, "drift resampler: invalid num_channels: num_channels=%lu",
+                (unsigned long)num_ch_);
+        return false;
+    }
+
+    if (frame_size_ != frame_size_ch_ * num_ch_) {
+        roc_log(LogError,
+                "drift resampler: frame_size is not multiple of num_channels:"
+                " frame_size=%lu num_channels=%lu",
+                (unsigned long)frame_size_, (unsigned long)num_ch_);
+        return false;
+    }
+
+    if (frame_size_ch_ <= NumTaps) {
+        roc_log(LogError,
+                "drift resampler: frame_size is too small:"
+                " frame_size=%lu num_channels=%lu",
+                (unsigned long)frame_size_, (unsigned long)num_ch_);
+        return false;
+    }
+
+    return true;
+}
+
+sample_t DriftResampler::input_sample_(ptrdiff_t index, size_t channel) const {
+    if (index < 0) {
+        return prev_frame_[size_t(ptrdiff_t(frame_size_ch_) + index) * num_ch_
+                           + channel];
+    }
+
+    return curr_frame_[size_t(index) * num_ch_ + channel];
+}
+
+} // namespace audio
+} // namespace roc
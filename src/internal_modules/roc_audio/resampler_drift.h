@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/resampler_drift.h
+//! @brief Drift resampler.
+
+#ifndef ROC_AUDIO_RESAMPLER_DRIFT_H_
+#define ROC_AUDIO_RESAMPLER_DRIFT_H_
+
+#include "roc_audio/frame.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_profile.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace audio {
+
+//! Lightweight resampler for clock drift compensation.
+//!
+//! Uses 4-point cubic (Catmull-Rom) interpolation instead of windowed sinc.
+//! It has no anti-aliasing filter, so it's suitable only when scaling factor
+//! is very close to 1, i.e. when input and output rates are equal and the
+//! resampler is used only to compensate the difference between sender and
+//! receiver clocks. In this case it needs a few operations per sample instead
+//! of dozens of sinc taps.
+//!
+//! When scaling factor is exactly 1, output is equal to input.
+//!
+//! Input and output rates must be equal, and scaling factor must be within
+//! 10% of 1, otherwise set_scaling() fails. Resampler profile is ignored.
+class DriftResampler : public IResampler, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    DriftResampler(core::IAllocator& allocator,
+                   core::BufferFactory<sample_t>& buffer_factory,
+                   ResamplerProfile profile,
+                   core::nanoseconds_t frame_length,
+                   const audio::SampleSpec& sample_spec);
+
+    //! Check if object is successfully constructed.
+    virtual bool valid() const;
+
+    //! Set new resample factor.
+    virtual bool set_scaling(size_t input_rate, size_t output_rate, float multiplier);
+
+    //! Get buffer to be filled with input data.
+    virtual const core::Slice<sample_t>& begin_push_input();
+
+    //! Commit buffer with input data.
+    virtual void end_push_input();
+
+    //! Read samples from input frame and fill output frame.
+    virtual size_t pop_output(Frame& out);
+
+private:
+    enum {
+        // Number of input samples used to compute one output sample.
+        NumTaps = 4
+    };
+
+    bool alloc_frames_(core::BufferFactory<sample_t>&);
+
+    bool check_config_() const;
+
+    // Get input sample by index relative to the beginning of current frame.
+    // Negative indices refer to previous frame.
+    sample_t input_sample_(ptrdiff_t index, size_t channel) const;
+
+    const audio::SampleSpec sample_spec_;
+    const size_t num_ch_;
+
+    core::Slice<sample_t> frames_[2];
+    size_t n_ready_frames_;
+
+    const sample_t* prev_frame_;
+    const sample_t* curr_frame_;
+
+    const size_t frame_size_;
+    const size_t frame_size_ch_;
+
+    // time position of next output sample in terms of input samples indexes
+    // for example 0 -- time position of first sample in curr_frame_
+    double position_;
+
+    // time distance between two output samples, equals to resampling factor
+    double step_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_RESAMPLER_DRIFT_H_
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/sinc_table_cache.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+SincTableCache::SincTableCache() {
+}
+
+size_t SincTableCache::table_size(size_t window_size, size_t window_interp) {
+    return window_size * window_interp + 2;
+}
+
+const sample_t* SincTableCache::acquire(size_t window_size, size_t window_interp) {
+    core::Mutex::Lock lock(mutex_);
+
+    Table* free_table = NULL;
+
+    for (size_t n = 0; n < MaxTables; n++) {
+        Table& table = tables_[n];
+
+        if (table.ref_count == 0) {
+            if (!free_table) {
+                free_table = &table;
+            }
+            continue;
+        }
+
+        if (table.window_size == window_size && table.window_interp == window_interp) {
+            table.ref_count++;
+            return table.data;
+        }
+    }
+
+    if (!free_table) {
+        roc_log(LogError, "sinc table cache: too many different tables: max=%lu",
+                (unsigned long)MaxTables);
+        return NULL;
+    }
+
+    const size_t size = table_size(window_size, window_interp);
+
+    sample_t* data = (sample_t*)allocator_.allocate(size * sizeof(sample_t));
+    if (!data) {
+        roc_log(LogError, "sinc table cache: can't allocate table: size=%lu",
+                (unsigned long)size);
+        return NULL;
+    }
+
+    fill_table_(data, size, window_interp);
+
+    free_table->window_size = window_size;
+    free_table->window_interp = window_interp;
+    free_table->size = size;
+    free_table->ref_count = 1;
+    free_table->data = data;
+
+    roc_log(LogDebug,
+            "sinc table cache: created table: window_size=%lu window_interp=%lu",
+            (unsigned long)window_size, (unsigned long)window_interp);
+
+    return data;
+}
+
+void SincTableCache::release(const sample_t* data) {
+    core::Mutex::Lock lock(mutex_);
+
+    for (size_t n = 0; n < MaxTables; n++) {
+        Table& table = tables_[n];
+
+        if (table.ref_count == 0 || table.data != data) {
+            continue;
+        }
+
+        if (--table.ref_count == 0) {
+            allocator_.deallocate(table.data);
+            table = Table();
+        }
+
+        return;
+    }
+
+    roc_panic("sinc table cache: attempt to release unknown table");
+}
+
+size_t SincTableCache::num_tables() const {
+    core::Mutex::Lock lock(mutex_);
+
+    size_t n_tables = 0;
+
+    for (size_t n = 0; n < MaxTables; n++) {
+        if (tables_[n].ref_count != 0) {
+            n_tables++;
+        }
+    }
+
+    return n_tables;
+}
+
+size_t SincTableCache::num_bytes() const {
+    core::Mutex::Lock lock(mutex_);
+
+    size_t n_bytes = 0;
+
+    for (size_t n = 0; n < MaxTables; n++) {
+        if (tables_[n].ref_count != 0) {
+            n_bytes += tables_[n].size * sizeof(sample_t);
+        }
+    }
+
+    return n_bytes;
+}
+
+void SincTableCache::fill_table_(sample_t* data, size_t size, size_t window_interp) {
+    const double sinc_step = 1.0 / (double)window_interp;
+    double sinc_t = sinc_step;
+
+    data[0] = 1.0f;
+    for (size_t i = 1; i < size; ++i) {
+        const double window = 0.54
+            - 0.46 * std::cos(2 * M_PI * ((double)(i - 1) / 2.0 / (double)size + 0.5));
+        data[i] = (float)(std::sin(M_PI * sinc_t) / M_PI / sinc_t * window);
+        sinc_t += sinc_step;
+    }
+    data[size - 2] = 0;
+    data[size - 1] = 0;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/sinc_table_cache.h
+//! @brief Shared sinc tables.
+
+#ifndef ROC_AUDIO_SINC_TABLE_CACHE_H_
+#define ROC_AUDIO_SINC_TABLE_CACHE_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/singleton.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Process-wide cache of windowed sinc tables used by builtin resampler.
+//!
+//! A table depends only on window size and number of interpolation points per
+//! window unit, which are defined by resampler profile. All resamplers with the
+//! same parameters share one read-only table.
+//!
+//! Tables are reference-counted: a table is computed when it's acquired first
+//! time and freed when the last user releases it.
+//!
+//! Thread-safe.
+class SincTableCache : public core::NonCopyable<> {
+public:
+    //! Get instance.
+    static SincTableCache& instance() {
+        return core::Singleton<SincTableCache>::instance();
+    }
+
+    //! Get number of elements in a table with given parameters.
+    static size_t table_size(size_t window_size, size_t window_interp);
+
+    //! Acquire table with given parameters.
+    //! @returns
+    //!  pointer to table_size() samples, or NULL if allocation failed.
+    //! @remarks
+    //!  Computes the table if there are no other users of it.
+    const sample_t* acquire(size_t window_size, size_t window_interp);
+
+    //! Release table returned by acquire().
+    void release(const sample_t* table);
+
+    //! Get number of tables currently allocated.
+    size_t num_tables() const;
+
+    //! Get total size of tables currently allocated, in bytes.
+    size_t num_bytes() const;
+
+private:
+    friend class core::Singleton<SincTableCache>;
+
+    enum { MaxTables = 8 };
+
+    struct Table {
+        Table()
+            : window_size(0)
+            , window_interp(0)
+            , size(0)
+            , ref_count(0)
+            , data(NULL) {
+        }
+
+        size_t window_size;
+        size_t window_interp;
+        size_t size;
+        size_t ref_count;
+        sample_t* data;
+    };
+
+    SincTableCache();
+
+    static void fill_table_(sample_t* data, size_t size, size_t window_interp);
+
+    core::Mutex mutex_;
+    core::HeapAllocator allocator_;
+
+    Table tables_[MaxTables];
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_SINC_TABLE_CACHE_H_
@@ -12,18 +12,28 @@
 namespace roc {
 namespace audio {
 
-Watchdog::Watchdog(IFrameReader& reader,
-                   const audio::SampleSpec& sample_spec,
+namespace {
+
+// Maximum number of frames between updates, which are processed precisely.
+// Update is normally invoked once per output frame, which corresponds to
+// one or a few depacketizer frames.
+enum { StatusBufferSize = 256 };
+
+} // namespace
+
+Watchdog::Watchdog(const audio::SampleSpec& sample_spec,
                    const WatchdogConfig& config,
                    core::IAllocator& allocator)
-    : reader_(reader)
-    , sample_spec_(sample_spec)
+    : status_buffer_(allocator)
+    , n_merged_statuses_(0)
     , max_blank_duration_(
           (packet::timestamp_t)sample_spec.ns_2_rtp_timestamp(config.no_playback_timeout))
     , max_drops_duration_((packet::timestamp_t)sample_spec.ns_2_rtp_timestamp(
           config.broken_playback_timeout))
     , drop_detection_window_((packet::timestamp_t)sample_spec.ns_2_rtp_timestamp(
           config.breakage_detection_window))
+    , update_interval_(
+          (packet::timestamp_t)sample_spec.ns_2_rtp_timestamp(config.update_interval))
     , curr_read_pos_(0)
     , last_pos_before_blank_(0)
     , last_pos_before_drops_(0)
@@ -34,12 +44,13 @@ Watchdog::Watchdog(IFrameReader& reader,
     , alive_(true)
     , valid_(false) {
     if (config.no_playback_timeout < 0 || config.broken_playback_timeout < 0
-        || config.breakage_detection_window < 0) {
+        || config.breakage_detection_window < 0 || config.update_interval < 0) {
         roc_log(LogError,
                 "watchdog: invalid config: "
-                "no_packets_timeout=%ld drops_timeout=%ld drop_detection_window=%ld",
+                "no_packets_timeout=%ld drops_timeout=%ld drop_detection_window=%ld"
+                " update_interval=%ld",
                 (long)config.no_playback_timeout, (long)config.broken_playback_timeout,
-                (long)config.breakage_detection_window);
+                (long)config.breakage_detection_window, (long)config.update_interval);
         return;
     }
 
@@ -61,11 +72,16 @@ Watchdog::Watchdog(IFrameReader& reader,
         }
     }
 
+    if (!status_buffer_.reserve(StatusBufferSize)) {
+        return;
+    }
+
     roc_log(LogDebug,
             "watchdog: initializing: "
-            "max_blank_duration=%lu max_drops_duration=%lu drop_detection_window=%lu",
+            "max_blank_duration=%lu max_drops_duration=%lu drop_detection_window=%lu"
+            " update_interval=%lu",
             (unsigned long)max_blank_duration_, (unsigned long)max_drops_duration_,
-            (unsigned long)drop_detection_window_);
+            (unsigned long)drop_detection_window_, (unsigned long)update_interval_);
 
     valid_ = true;
 }
@@ -74,38 +90,49 @@ bool Watchdog::valid() const {
     return valid_;
 }
 
-bool Watchdog::read(Frame& frame) {
+FrameStatusBuffer& Watchdog::status_buffer() {
+    return status_buffer_;
+}
+
+const FrameCounters& Watchdog::counters() const {
+    return status_buffer_.counters();
+}
+
+bool Watchdog::update() {
     if (!alive_) {
-        if (frame.num_samples() != 0) {
-            memset(frame.samples(), 0, frame.num_samples() * sizeof(sample_t));
-        }
+        return false;
+    }
+
+    // update is invoked for every frame, but statuses are processed in batches;
+    // buffer is drained before it's full, so statuses are normally not merged
+    if (status_buffer_.duration() < update_interval_
+        && status_buffer_.size() < StatusBufferSize / 2 && !timeout_pending_()) {
         return true;
     }
 
-    if (!reader_.read(frame)) {
-        return false;
+    if (status_buffer_.counters().n_merged_statuses != n_merged_statuses_) {
+        roc_log(LogDebug, "watchdog: status buffer overrun: n_merged=%lu",
+                (unsigned long)(status_buffer_.counters().n_merged_statuses
+                                - n_merged_statuses_));
+        n_merged_statuses_ = status_buffer_.counters().n_merged_statuses;
     }
 
-    const packet::timestamp_t next_read_pos = packet::timestamp_t(
-        curr_read_pos_ + frame.num_samples() / sample_spec_.num_channels());
+    FrameStatus status;
 
-    update_blank_timeout_(frame, next_read_pos);
-    update_drops_timeout_(frame, next_read_pos);
-    update_status_(frame);
+    while (status_buffer_.read(status)) {
+        const packet::timestamp_t next_read_pos = curr_read_pos_ + status.duration;
 
-    curr_read_pos_ = next_read_pos;
+        update_blank_timeout_(status.flags, next_read_pos);
+        update_drops_timeout_(status.flags, next_read_pos);
+        update_status_(status.flags);
 
-    if (!check_drops_timeout_()) {
-        flush_status_();
-        alive_ = false;
-    }
+        curr_read_pos_ = next_read_pos;
 
-    return true;
-}
-
-bool Watchdog::update() {
-    if (!alive_) {
-        return false;
+        if (!check_drops_timeout_()) {
+            flush_status_();
+            alive_ = false;
+            return false;
+        }
     }
 
     if (!check_blank_timeout_()) {
@@ -117,13 +144,13 @@ bool Watchdog::update() {
     return true;
 }
 
-void Watchdog::update_blank_timeout_(const Frame& frame,
+void Watchdog::update_blank_timeout_(unsigned flags,
                                      packet::timestamp_t next_read_pos) {
     if (max_blank_duration_ == 0) {
         return;
     }
 
-    if (frame.flags() & Frame::FlagNonblank) {
+    if (flags & Frame::FlagNonblank) {
         last_pos_before_blank_ = next_read_pos;
     }
 }
@@ -146,13 +173,13 @@ bool Watchdog::check_blank_timeout_() const {
     return false;
 }
 
-void Watchdog::update_drops_timeout_(const Frame& frame,
+void Watchdog::update_drops_timeout_(unsigned flags,
                                      packet::timestamp_t next_read_pos) {
     if (max_drops_duration_ == 0) {
         return;
     }
 
-    curr_window_flags_ |= frame.flags();
+    curr_window_flags_ |= flags;
 
     const packet::timestamp_t window_start =
         curr_read_pos_ / drop_detection_window_ * drop_detection_window_;
@@ -169,11 +196,28 @@ void Watchdog::update_drops_timeout_(const Frame& frame,
         if (next_read_pos % drop_detection_window_ == 0) {
             curr_window_flags_ = 0;
         } else {
-            curr_window_flags_ = frame.flags();
+            curr_window_flags_ = flags;
         }
     }
 }
 
+// Checks if buffered statuses may reach one of the timeouts.
+bool Watchdog::timeout_pending_() const {
+    const packet::timestamp_t end_pos = curr_read_pos_ + status_buffer_.duration();
+
+    if (max_blank_duration_ != 0
+        && end_pos - last_pos_before_blank_ >= max_blank_duration_) {
+        return true;
+    }
+
+    if (max_drops_duration_ != 0
+        && end_pos - last_pos_before_drops_ >= max_drops_duration_) {
+        return true;
+    }
+
+    return false;
+}
+
 bool Watchdog::check_drops_timeout_() {
     if (max_drops_duration_ == 0) {
         return true;
@@ -193,13 +237,11 @@ bool Watchdog::check_drops_timeout_() {
     return false;
 }
 
-void Watchdog::update_status_(const Frame& frame) {
+void Watchdog::update_status_(unsigned flags) {
     if (status_.size() == 0) {
         return;
     }
 
-    const unsigned flags = frame.flags();
-
     char symbol = '.';
 
     if (!(flags & Frame::FlagNonblank)) {
@@ -12,7 +12,7 @@
 #ifndef ROC_AUDIO_WATCHDOG_H_
 #define ROC_AUDIO_WATCHDOG_H_
 
-#include "roc_audio/iframe_reader.h"
+#include "roc_audio/frame_status_buffer.h"
 #include "roc_audio/sample_spec.h"
 #include "roc_core/array.h"
 #include "roc_core/iallocator.h"
@@ -46,6 +46,13 @@ struct WatchdogConfig {
     //! @see broken_playback_timeout.
     core::nanoseconds_t breakage_detection_window;
 
+    //! Update interval, nanoseconds.
+    //! @remarks
+    //!  Frame statuses are processed in batches, when their total duration
+    //!  reaches this interval, or earlier if a timeout may be reached.
+    //!  Set to zero to process statuses on every update.
+    core::nanoseconds_t update_interval;
+
     //! Frame status window size for logging, number of frames.
     //! @remarks
     //!  Used for debug logging. Set to zero to disable.
@@ -56,6 +63,7 @@ struct WatchdogConfig {
         : no_playback_timeout(2 * core::Second)
         , broken_playback_timeout(2 * core::Second)
         , breakage_detection_window(300 * core::Millisecond)
+        , update_interval(10 * core::Millisecond)
         , frame_status_window(20) {
     }
 };
@@ -63,23 +71,30 @@ struct WatchdogConfig {
 //! Watchdog.
 //! @remarks
 //!  Terminates session if it is considered dead or corrupted.
-class Watchdog : public IFrameReader, public core::NonCopyable<> {
+//!
+//!  Watchdog is not a part of the frame chain. Instead, depacketizer records
+//!  status of every frame it produces into watchdog's status buffer, and
+//!  watchdog processes recorded statuses when it's updated.
+class Watchdog : public core::NonCopyable<> {
 public:
     //! Initialize.
-    Watchdog(IFrameReader& reader,
-             const audio::SampleSpec& sample_spec,
+    Watchdog(const audio::SampleSpec& sample_spec,
              const WatchdogConfig& config,
              core::IAllocator& allocator);
 
     //! Check if object is successfully constructed.
     bool valid() const;
 
-    //! Read audio frame.
-    //! @remarks
-    //!  Updates stream state and reads frame from the input reader.
-    virtual bool read(Frame& frame);
+    //! Get buffer to which frame statuses should be recorded.
+    FrameStatusBuffer& status_buffer();
+
+    //! Get frame counters.
+    const FrameCounters& counters() const;
 
     //! Update stream.
+    //! @remarks
+    //!  Processes statuses of frames recorded since previous update, if their
+    //!  duration reached update interval or status buffer is half full.
     //! @returns
     //!  false if during the session timeout each frame has an empty flag or the maximum
     //!  allowed number of consecutive windows that can contain frames that aren't fully
@@ -87,22 +102,24 @@ public:
     bool update();
 
 private:
-    void update_blank_timeout_(const Frame& frame, packet::timestamp_t next_read_pos);
+    void update_blank_timeout_(unsigned flags, packet::timestamp_t next_read_pos);
     bool check_blank_timeout_() const;
 
-    void update_drops_timeout_(const Frame& frame, packet::timestamp_t next_read_pos);
+    void update_drops_timeout_(unsigned flags, packet::timestamp_t next_read_pos);
     bool check_drops_timeout_();
 
-    void update_status_(const Frame& frame);
-    void flush_status_();
+    bool timeout_pending_() const;
 
-    IFrameReader& reader_;
+    void update_status_(unsigned flags);
+    void flush_status_();
 
-    const audio::SampleSpec sample_spec_;
+    FrameStatusBuffer status_buffer_;
+    size_t n_merged_statuses_;
 
     const packet::timestamp_t max_blank_duration_;
     const packet::timestamp_t max_drops_duration_;
     const packet::timestamp_t drop_detection_window_;
+    const packet::timestamp_t update_interval_;
 
     packet::timestamp_t curr_read_pos_;
     packet::timestamp_t last_pos_before_blank_;
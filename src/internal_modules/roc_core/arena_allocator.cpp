@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/arena_allocator.h"
+#include "roc_core/align_ops.h"
+#include "roc_core/log.h"
+#include "roc_core/memory_map.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+ArenaAllocator::ArenaAllocator(IAllocator& fallback, const ArenaConfig& config)
+    : fallback_(fallback)
+    , data_(NULL)
+    , size_(0)
+    , map_size_(0)
+    , pos_(0)
+    , n_blocks_(0)
+    , n_fallbacks_(0)
+    , hdr_size_(AlignOps::align_max(sizeof(BlockHeader))) {
+    if (config.size != 0 && !reserve_(config)) {
+        roc_log(LogError, "arena allocator: falling back to default allocator");
+    }
+}
+
+ArenaAllocator::~ArenaAllocator() {
+    if (n_blocks_ != 0) {
+        roc_panic("arena allocator: detected leak(s): %lu blocks was not freed",
+                  (unsigned long)n_blocks_);
+    }
+
+    release_();
+}
+
+size_t ArenaAllocator::size() const {
+    return size_;
+}
+
+size_t ArenaAllocator::used_size() const {
+    Mutex::Lock lock(mutex_);
+
+    return pos_;
+}
+
+size_t ArenaAllocator::num_fallbacks() const {
+    Mutex::Lock lock(mutex_);
+
+    return n_fallbacks_;
+}
+
+void* ArenaAllocator::allocate(size_t size) {
+    const size_t block_size = hdr_size_ + AlignOps::align_max(size);
+
+    {
+        Mutex::Lock lock(mutex_);
+
+        if (block_size <= size_ - pos_) {
+            BlockHeader* hdr = (BlockHeader*)(data_ + pos_);
+            hdr->size = block_size;
+
+            pos_ += block_size;
+            n_blocks_++;
+
+            return (char*)hdr + hdr_size_;
+        }
+
+        n_fallbacks_++;
+    }
+
+    return fallback_.allocate(size);
+}
+
+void ArenaAllocator::deallocate(void* memory) {
+    if (memory == NULL) {
+        roc_panic("arena allocator: deallocating null pointer");
+    }
+
+    if (!owns_(memory)) {
+        fallback_.deallocate(memory);
+        return;
+    }
+
+    Mutex::Lock lock(mutex_);
+
+    if (n_blocks_ == 0) {
+        roc_panic("arena allocator: unpaired deallocate");
+    }
+
+    BlockHeader* hdr = (BlockHeader*)((char*)memory - hdr_size_);
+    const size_t block_pos = size_t((char*)hdr - data_);
+
+    n_blocks_--;
+
+    if (n_blocks_ == 0) {
+        pos_ = 0;
+    } else if (block_pos + hdr->size == pos_) {
+        pos_ = block_pos;
+    }
+}
+
+bool ArenaAllocator::reserve_(const ArenaConfig& config) {
+    const size_t page_size =
+        config.huge_pages && memory_huge_page_size() != 0 ? memory_huge_page_size()
+                                                          : memory_page_size();
+
+    map_size_ = AlignOps::align_as(config.size, page_size);
+
+    data_ = (char*)memory_map(map_size_, config.huge_pages);
+    if (!data_) {
+        map_size_ = 0;
+        return false;
+    }
+
+    bool locked = false;
+    if (config.lock) {
+        // not fatal, but page faults are still possible after swapping
+        locked = memory_lock(data_, map_size_);
+    }
+
+    if (config.prefault) {
+        memory_prefault(data_, map_size_);
+    }
+
+    size_ = map_size_;
+
+    roc_log(LogDebug,
+            "arena allocator: reserved arena: size=%lu huge_pages=%d locked=%d"
+            " prefaulted=%d",
+            (unsigned long)size_, (int)config.huge_pages, (int)locked,
+            (int)config.prefault);
+
+    return true;
+}
+
+void ArenaAllocator::release_() {
+    if (data_) {
+        memory_unmap(data_, map_size_);
+    }
+
+    data_ = NULL;
+    size_ = 0;
+    map_size_ = 0;
+}
+
+bool ArenaAllocator::owns_(const void* memory) const {
+    return (const char*)memory >= data_ && (const char*)memory < data_ + size_;
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/arena_allocator.h
+//! @brief Arena allocator.
+
+#ifndef ROC_CORE_ARENA_ALLOCATOR_H_
+#define ROC_CORE_ARENA_ALLOCATOR_H_
+
+#include "roc_core/iallocator.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Arena config.
+struct ArenaConfig {
+    //! Arena size in bytes.
+    //! If zero, arena is disabled.
+    size_t size;
+
+    //! Back arena with huge pages.
+    //! Uses explicit huge pages if they're configured in the system, and
+    //! transparent huge pages otherwise.
+    bool huge_pages;
+
+    //! Lock arena in RAM.
+    bool lock;
+
+    //! Touch all arena pages upfront.
+    bool prefault;
+
+    ArenaConfig()
+        : size(0)
+        , huge_pages(false)
+        , lock(false)
+        , prefault(true) {
+    }
+};
+
+//! Arena allocator.
+//!
+//! Reserves a large memory region upfront and serves allocations from it,
+//! so that the region may be pre-faulted, locked, and backed by huge pages.
+//! Intended as the allocator for slab pools used in real-time path, so that
+//! their slab growth doesn't cause page faults and buffers share TLB entries.
+//!
+//! Memory is handed out sequentially. Freed block is reclaimed only if it is
+//! the last allocated one, or when all blocks are freed. Slab pools free
+//! their slabs only at destruction, so this is enough for them.
+//!
+//! When arena is exhausted or disabled, allocations are forwarded to the
+//! fallback allocator.
+//!
+//! The memory is always maximum aligned. Thread-safe.
+class ArenaAllocator : public IAllocator, public NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  If arena can't be reserved, all allocations go to @p fallback.
+    ArenaAllocator(IAllocator& fallback, const ArenaConfig& config);
+
+    //! Deinitialize.
+    ~ArenaAllocator();
+
+    //! Get arena size in bytes.
+    //! @returns
+    //!  zero if arena is disabled or can't be reserved.
+    size_t size() const;
+
+    //! Get number of bytes currently used in arena.
+    size_t used_size() const;
+
+    //! Get number of allocations forwarded to fallback allocator.
+    size_t num_fallbacks() const;
+
+    //! Allocate memory.
+    virtual void* allocate(size_t size);
+
+    //! Deallocate previously allocated memory.
+    virtual void deallocate(void*);
+
+private:
+    struct BlockHeader {
+        size_t size;
+    };
+
+    bool reserve_(const ArenaConfig& config);
+    void release_();
+
+    bool owns_(const void* memory) const;
+
+    IAllocator& fallback_;
+
+    mutable Mutex mutex_;
+
+    char* data_;
+    size_t size_;
+    size_t map_size_;
+
+    size_t pos_;
+    size_t n_blocks_;
+    size_t n_fallbacks_;
+
+    const size_t hdr_size_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_ARENA_ALLOCATOR_H_
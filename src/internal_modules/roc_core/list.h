@@ -71,7 +71,7 @@ public:
     }
 
     //! Check if element belongs to list.
-    bool contains(const T& element) {
+    bool contains(const T& element) const {
         const ListNode::ListNodeData* data = element.list_node_data();
         return (data->list == this);
     }
@@ -114,6 +114,24 @@ public:
         return container_of_(data->next);
     }
 
+    //! Get list element previous to given one.
+    //!
+    //! @returns
+    //!  list element preceding @p element if @p element is not
+    //!  first, or NULL otherwise.
+    //!
+    //! @pre
+    //!  @p element should be member of this list.
+    Pointer prevof(T& element) const {
+        ListNode::ListNodeData* data = element.list_node_data();
+        check_is_member_(data, this);
+
+        if (data->prev == &head_) {
+            return NULL;
+        }
+        return container_of_(data->prev);
+    }
+
     //! Prepend element to list.
     //!
     //! @remarks
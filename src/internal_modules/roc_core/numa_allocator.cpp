@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/numa_allocator.h"
+#include "roc_core/numa.h"
+
+namespace roc {
+namespace core {
+
+NumaAllocator::NumaAllocator(IAllocator& allocator, int node)
+    : allocator_(allocator)
+    , node_(node) {
+}
+
+int NumaAllocator::node() const {
+    return node_;
+}
+
+void* NumaAllocator::allocate(size_t size) {
+    void* memory = allocator_.allocate(size);
+
+    if (memory && node_ >= 0) {
+        // failure is not fatal, memory will be placed by default policy
+        (void)numa_bind_memory(memory, size, (size_t)node_);
+    }
+
+    return memory;
+}
+
+void NumaAllocator::deallocate(void* memory) {
+    allocator_.deallocate(memory);
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/numa_allocator.h
+//! @brief NUMA-aware allocator.
+
+#ifndef ROC_CORE_NUMA_ALLOCATOR_H_
+#define ROC_CORE_NUMA_ALLOCATOR_H_
+
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+
+namespace roc {
+namespace core {
+
+//! NUMA-aware allocator.
+//!
+//! Allocates memory using another allocator and asks the kernel to place
+//! its pages on the given NUMA node. Intended for slab pools, so that slabs
+//! are placed on the node of the thread that uses objects from them.
+//!
+//! If @p node is negative or NUMA is not supported, works exactly as the
+//! underlying allocator.
+class NumaAllocator : public IAllocator, public NonCopyable<> {
+public:
+    //! Initialize.
+    NumaAllocator(IAllocator& allocator, int node);
+
+    //! Get NUMA node.
+    int node() const;
+
+    //! Allocate memory.
+    virtual void* allocate(size_t size);
+
+    //! Deallocate previously allocated memory.
+    virtual void deallocate(void*);
+
+private:
+    IAllocator& allocator_;
+    const int node_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_NUMA_ALLOCATOR_H_
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/memory_map.h"
+#include "roc_core/panic.h"
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// Huge page size is not queried from the kernel; 2MB is the default on
+// x86_64 and aarch64 with 4K pages.
+enum { HugePageSize = 2 * 1024 * 1024 };
+
+} // namespace
+
+size_t memory_page_size() {
+    const long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0) {
+        roc_panic("memory map: sysconf(_SC_PAGESIZE) failed");
+    }
+    return (size_t)page_size;
+}
+
+size_t memory_huge_page_size() {
+#if defined(__linux__)
+    return HugePageSize;
+#else
+    return 0;
+#endif
+}
+
+void* memory_map(size_t size, bool huge_pages) {
+    roc_panic_if_not(size > 0);
+
+    void* memory = MAP_FAILED;
+
+#if defined(MAP_HUGETLB)
+    if (huge_pages) {
+        memory = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (memory == MAP_FAILED) {
+            const int err = errno;
+            roc_log(LogDebug,
+                    "memory map: can't map %lu bytes with explicit huge pages,"
+                    " falling back to regular pages: %s",
+                    (unsigned long)size, errno_to_str(err).c_str());
+        }
+    }
+#endif
+
+    if (memory == MAP_FAILED) {
+        memory =
+            mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            const int err = errno;
+            roc_log(LogError, "memory map: can't map %lu bytes: %s",
+                    (unsigned long)size, errno_to_str(err).c_str());
+            return NULL;
+        }
+
+#if defined(MADV_HUGEPAGE)
+        if (huge_pages && madvise(memory, size, MADV_HUGEPAGE) != 0) {
+            const int err = errno;
+            roc_log(LogDebug, "memory map: madvise(MADV_HUGEPAGE): %s",
+                    errno_to_str(err).c_str());
+        }
+#endif
+    }
+
+    return memory;
+}
+
+void memory_unmap(void* memory, size_t size) {
+    if (munmap(memory, size) != 0) {
+        const int err = errno;
+        roc_panic("memory map: munmap(): %s", errno_to_str(err).c_str());
+    }
+}
+
+bool memory_lock(void* memory, size_t size) {
+    if (mlock(memory, size) != 0) {
+        const int err = errno;
+        roc_log(LogError, "memory map: can't lock %lu bytes: %s", (unsigned long)size,
+                errno_to_str(err).c_str());
+        return false;
+    }
+    return true;
+}
+
+void memory_prefault(void* memory, size_t size) {
+    const size_t page_size = memory_page_size();
+
+    volatile char* data = (volatile char*)memory;
+
+    for (size_t off = 0; off < size; off += page_size) {
+        data[off] = 0;
+    }
+}
+
+} // namespace core
+} // namespace roc
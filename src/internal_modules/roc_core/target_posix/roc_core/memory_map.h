@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_posix/roc_core/memory_map.h
+//! @brief Page-level memory mapping.
+
+#ifndef ROC_CORE_MEMORY_MAP_H_
+#define ROC_CORE_MEMORY_MAP_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Get size of a regular memory page.
+size_t memory_page_size();
+
+//! Get size of a huge memory page.
+//! @returns
+//!  huge page size, or zero if huge pages are not supported.
+size_t memory_huge_page_size();
+
+//! Map anonymous private read-write memory region.
+//! @remarks
+//!  If @p huge_pages is true, first tries explicit huge pages, and then
+//!  regular pages with a hint to use transparent huge pages. @p size should
+//!  be a multiple of huge page size in this case.
+//! @returns
+//!  page aligned region, or NULL on failure.
+void* memory_map(size_t size, bool huge_pages);
+
+//! Unmap memory region returned by memory_map().
+void memory_unmap(void* memory, size_t size);
+
+//! Lock memory region in RAM, so that it's never swapped out.
+//! @returns
+//!  false if the region can't be locked, e.g. because of RLIMIT_MEMLOCK.
+bool memory_lock(void* memory, size_t size);
+
+//! Touch every page of memory region, so that later accesses don't cause
+//! page faults.
+void memory_prefault(void* memory, size_t size);
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_MEMORY_MAP_H_
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+#include <errno.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/numa.h"
+
+#if defined(__linux__) && defined(SYS_getcpu) && defined(SYS_set_mempolicy)              \
+    && defined(SYS_mbind) && defined(CPU_SET)
+#define ROC_CORE_NUMA_SUPPORTED
+#endif
+
+namespace roc {
+namespace core {
+
+#if defined(ROC_CORE_NUMA_SUPPORTED)
+
+namespace {
+
+// Maximum supported node number + 1.
+enum { MaxNodes = sizeof(unsigned long) * 8 };
+
+// Parse node cpulist from sysfs, e.g. "0-3,8-11".
+bool read_node_cpus(size_t node, cpu_set_t& cpus) {
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%lu/cpulist",
+             (unsigned long)node);
+
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        const int err = errno;
+        roc_log(LogError, "numa: can't open %s: %s", path, errno_to_str(err).c_str());
+        return false;
+    }
+
+    CPU_ZERO(&cpus);
+
+    size_t n_cpus = 0;
+    unsigned long first = 0, last = 0;
+
+    for (;;) {
+        const int n = fscanf(fp, "%lu", &first);
+        if (n != 1) {
+            break;
+        }
+
+        last = first;
+
+        int c = fgetc(fp);
+        if (c == '-') {
+            if (fscanf(fp, "%lu", &last) != 1) {
+                break;
+            }
+            c = fgetc(fp);
+        }
+
+        for (unsigned long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET(cpu, &cpus);
+            n_cpus++;
+        }
+
+        if (c != ',') {
+            break;
+        }
+    }
+
+    fclose(fp);
+
+    if (n_cpus == 0) {
+        roc_log(LogError, "numa: node %lu has no cpus", (unsigned long)node);
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+int numa_current_node() {
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0) {
+        return -1;
+    }
+    return (int)node;
+}
+
+bool numa_bind_thread(size_t node) {
+    if (node >= MaxNodes) {
+        roc_log(LogError, "numa: node %lu out of range", (unsigned long)node);
+        return false;
+    }
+
+    cpu_set_t cpus;
+    if (!read_node_cpus(node, cpus)) {
+        return false;
+    }
+
+    if (int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus)) {
+        roc_log(LogError, "numa: pthread_setaffinity_np(): node=%lu: %s",
+                (unsigned long)node, errno_to_str(err).c_str());
+        return false;
+    }
+
+    const unsigned long nodemask = 1ul << node;
+
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, &nodemask, (unsigned long)MaxNodes)
+        != 0) {
+        const int err = errno;
+        roc_log(LogError, "numa: set_mempolicy(): node=%lu: %s", (unsigned long)node,
+                errno_to_str(err).c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool numa_bind_memory(void* memory, size_t size, size_t node) {
+    if (node >= MaxNodes) {
+        roc_log(LogError, "numa: node %lu out of range", (unsigned long)node);
+        return false;
+    }
+
+    const long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0) {
+        return false;
+    }
+
+    // mbind() requires page-aligned start, so we shrink region to whole pages
+    const unsigned long page_mask = ~((unsigned long)page_size - 1);
+
+    const unsigned long begin =
+        ((unsigned long)memory + (unsigned long)page_size - 1) & page_mask;
+    const unsigned long end = ((unsigned long)memory + size) & page_mask;
+
+    if (begin >= end) {
+        // region is smaller than a page, nothing to do
+        return true;
+    }
+
+    const unsigned long nodemask = 1ul << node;
+
+    if (syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED, &nodemask,
+                (unsigned long)MaxNodes, 0)
+        != 0) {
+        const int err = errno;
+        roc_log(LogDebug, "numa: mbind(): node=%lu: %s", (unsigned long)node,
+                errno_to_str(err).c_str());
+        return false;
+    }
+
+    return true;
+}
+
+#else // !ROC_CORE_NUMA_SUPPORTED
+
+int numa_current_node() {
+    return -1;
+}
+
+bool numa_bind_thread(size_t node) {
+    roc_log(LogError, "numa: can't bind thread to node %lu: not supported",
+            (unsigned long)node);
+    return false;
+}
+
+bool numa_bind_memory(void*, size_t, size_t) {
+    return false;
+}
+
+#endif // ROC_CORE_NUMA_SUPPORTED
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_posix/roc_core/numa.h
+//! @brief NUMA helpers.
+
+#ifndef ROC_CORE_NUMA_H_
+#define ROC_CORE_NUMA_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Get NUMA node of the CPU on which the current thread is running.
+//! @returns
+//!  node number, or -1 if it's unknown or NUMA is not supported.
+int numa_current_node();
+
+//! Restrict current thread to CPUs of given NUMA node and make the node
+//! preferred for memory allocated by the thread.
+//! @returns
+//!  false if the node is invalid or NUMA is not supported.
+bool numa_bind_thread(size_t node);
+
+//! Make given NUMA node preferred for pages of given memory region.
+//! @remarks
+//!  Only pages fully covered by the region are affected, and only those
+//!  which are not yet faulted in. Should be called right after allocation.
+//! @returns
+//!  false if the node is invalid or NUMA is not supported.
+bool numa_bind_memory(void* memory, size_t size, size_t node);
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_NUMA_H_
@@ -7,6 +7,7 @@
  */
 
 #if defined(__linux__)
+#include <sched.h>
 #include <sys/syscall.h>
 #elif defined(__FreeBSD__) || defined(__OpenBSD__)
 #include <pthread_np.h>
@@ -17,6 +18,7 @@
 #include <unistd.h>
 #include "roc_core/errno_to_str.h"
 #include "roc_core/log.h"
+#include "roc_core/numa.h"
 #include "roc_core/panic.h"
 #include "roc_core/thread.h"
 #include "roc_core/macro_helpers.h"
@@ -132,6 +134,43 @@ bool Thread::set_realtime() {
     return true;
 }
 
+#if defined(__linux__) && defined(CPU_SET)
+
+bool Thread::set_cpu_affinity(size_t cpu) {
+    if (cpu >= CPU_SETSIZE) {
+        roc_log(LogError, "thread: can't set cpu affinity: cpu=%lu out of range",
+                (unsigned long)cpu);
+        return false;
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+
+    if (int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set)) {
+        roc_log(LogError,
+                "thread: can't set cpu affinity: pthread_setaffinity_np(): cpu=%lu: %s",
+                (unsigned long)cpu, errno_to_str(err).c_str());
+        return false;
+    }
+
+    return true;
+}
+
+#else
+
+bool Thread::set_cpu_affinity(size_t cpu) {
+    roc_log(LogError, "thread: can't set cpu affinity: not supported: cpu=%lu",
+            (unsigned long)cpu);
+    return false;
+}
+
+#endif
+
+bool Thread::set_numa_node(size_t node) {
+    return numa_bind_thread(node);
+}
+
 Thread::Thread()
     : started_(0)
     , joinable_(0) {
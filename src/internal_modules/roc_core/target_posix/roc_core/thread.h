@@ -40,6 +40,19 @@ public:
     //! Raise current thread priority to realtime.
     static bool set_realtime();
 
+    //! Pin current thread to given CPU.
+    //! @returns
+    //!  false if the CPU is invalid or the operation is not supported.
+    static bool set_cpu_affinity(size_t cpu);
+
+    //! Bind current thread to given NUMA node.
+    //! @remarks
+    //!  Restricts thread to CPUs of the node and makes the node preferred
+    //!  for memory first touched by the thread.
+    //! @returns
+    //!  false if the node is invalid or the operation is not supported.
+    static bool set_numa_node(size_t node);
+
     //! Check if thread was started and can be joined.
     //! @returns
     //!  true if start() was called and join() was not called yet.
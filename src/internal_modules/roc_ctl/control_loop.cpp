@@ -9,6 +9,7 @@
 #include "roc_ctl/control_loop.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_core/thread.h"
 #include "roc_ctl/control_interface_map.h"
 
 namespace roc {
@@ -90,9 +91,29 @@ ControlLoop::Tasks::PipelineProcessing::PipelineProcessing(
     , pipeline_(pipeline) {
 }
 
-ControlLoop::ControlLoop(netio::NetworkLoop& network_loop, core::IAllocator& allocator)
-    : network_loop_(network_loop)
+ControlLoop::Tasks::SenderUpdate::SenderUpdate(pipeline::SenderLoop& sender)
+    : ControlTask(&ControlLoop::task_sender_update_)
+    , sender_(sender) {
+}
+
+ControlLoop::ConfigureThreadTask::ConfigureThreadTask()
+    : ControlTask(&ControlLoop::task_configure_thread_) {
+}
+
+ControlLoop::ControlLoop(const ControlLoopConfig& config,
+                         netio::NetworkLoop& network_loop,
+                         core::IAllocator& allocator)
+    : config_(config)
+    , network_loop_(network_loop)
     , allocator_(allocator) {
+    if (!task_queue_.valid()) {
+        return;
+    }
+
+    if (config_.cpu_affinity >= 0 || config_.numa_node >= 0) {
+        ConfigureThreadTask task;
+        schedule_and_wait(task);
+    }
 }
 
 ControlLoop::~ControlLoop() {
@@ -127,6 +148,24 @@ void ControlLoop::wait(ControlTask& task) {
     task_queue_.wait(task);
 }
 
+ControlTaskResult ControlLoop::task_configure_thread_(ControlTask&) {
+    if (config_.numa_node >= 0) {
+        if (core::Thread::set_numa_node((size_t)config_.numa_node)) {
+            roc_log(LogDebug, "control loop: bound control thread to numa node %d",
+                    config_.numa_node);
+        }
+    }
+
+    if (config_.cpu_affinity >= 0) {
+        if (core::Thread::set_cpu_affinity((size_t)config_.cpu_affinity)) {
+            roc_log(LogDebug, "control loop: pinned control thread to cpu %d",
+                    config_.cpu_affinity);
+        }
+    }
+
+    return ControlTaskSuccess;
+}
+
 ControlTaskResult ControlLoop::task_create_endpoint_(ControlTask& control_task) {
     Tasks::CreateEndpoint& task = (Tasks::CreateEndpoint&)control_task;
 
@@ -305,5 +344,13 @@ ControlTaskResult ControlLoop::task_pipeline_processing_(ControlTask& control_ta
     return ControlTaskSuccess;
 }
 
+ControlTaskResult ControlLoop::task_sender_update_(ControlTask& control_task) {
+    Tasks::SenderUpdate& task = (Tasks::SenderUpdate&)control_task;
+
+    task.sender_.update();
+
+    return ControlTaskSuccess;
+}
+
 } // namespace ctl
 } // namespace roc
@@ -26,6 +26,23 @@
 namespace roc {
 namespace ctl {
 
+//! Control loop parameters.
+struct ControlLoopConfig {
+    //! Pin control thread to given CPU.
+    //! Set to -1 to disable pinning (default).
+    int cpu_affinity;
+
+    //! Bind control thread to given NUMA node.
+    //! If cpu_affinity is also set, it should be one of the node CPUs.
+    //! Set to -1 to disable binding (default).
+    int numa_node;
+
+    ControlLoopConfig()
+        : cpu_affinity(-1)
+        , numa_node(-1) {
+    }
+};
+
 //! Control loop thread.
 //! @remarks
 //!  This class is a task-based facade for the whole roc_ctl module.
@@ -170,10 +187,24 @@ public:
 
             pipeline::PipelineLoop& pipeline_;
         };
+
+        //! Process due sender pipeline updates on control thread.
+        class SenderUpdate : public ControlTask {
+        public:
+            //! Set task parameters.
+            SenderUpdate(pipeline::SenderLoop& sender);
+
+        private:
+            friend class ControlLoop;
+
+            pipeline::SenderLoop& sender_;
+        };
     };
 
     //! Initialize.
-    ControlLoop(netio::NetworkLoop& network_loop, core::IAllocator& allocator);
+    ControlLoop(const ControlLoopConfig& config,
+                netio::NetworkLoop& network_loop,
+                core::IAllocator& allocator);
 
     virtual ~ControlLoop();
 
@@ -208,6 +239,13 @@ public:
     void wait(ControlTask& task);
 
 private:
+    // Applies thread settings on control thread.
+    class ConfigureThreadTask : public ControlTask {
+    public:
+        ConfigureThreadTask();
+    };
+
+    ControlTaskResult task_configure_thread_(ControlTask&);
     ControlTaskResult task_create_endpoint_(ControlTask&);
     ControlTaskResult task_delete_endpoint_(ControlTask&);
     ControlTaskResult task_bind_endpoint_(ControlTask&);
@@ -217,6 +255,9 @@ private:
     ControlTaskResult task_attach_source_(ControlTask&);
     ControlTaskResult task_detach_source_(ControlTask&);
     ControlTaskResult task_pipeline_processing_(ControlTask&);
+    ControlTaskResult task_sender_update_(ControlTask&);
+
+    const ControlLoopConfig config_;
 
     netio::NetworkLoop& network_loop_;
     core::IAllocator& allocator_;
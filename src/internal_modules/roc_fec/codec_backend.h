@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/codec_backend.h
+//! @brief FEC codec backend.
+
+#ifndef ROC_FEC_CODEC_BACKEND_H_
+#define ROC_FEC_CODEC_BACKEND_H_
+
+namespace roc {
+namespace fec {
+
+//! FEC codec backends.
+enum CodecBackend {
+    //! Default backend.
+    //! OpenFEC if it's enabled and supports the scheme, otherwise built-in.
+    CodecBackend_Default,
+
+    //! Roc built-in codec.
+    //! Supports only LDPC-Staircase scheme.
+    CodecBackend_Builtin,
+
+    //! OpenFEC codec.
+    CodecBackend_OpenFEC
+};
+
+//! Get string name of codec backend.
+const char* codec_backend_to_str(CodecBackend);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_CODEC_BACKEND_H_
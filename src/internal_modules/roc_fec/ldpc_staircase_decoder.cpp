@@ -0,0 +1,529 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/ldpc_staircase_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/xor_ops.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+bool get_bit(const uint64_t* bits, size_t n) {
+    return (bits[n / 64] >> (n % 64)) & 1;
+}
+
+void set_bit(uint64_t* bits, size_t n) {
+    bits[n / 64] |= (uint64_t)1 << (n % 64);
+}
+
+} // namespace
+
+LdpcStaircaseDecoder::LdpcStaircaseDecoder(const CodecConfig& config,
+                                           core::BufferFactory<uint8_t>& buffer_factory,
+                                           core::IAllocator& allocator)
+    : sblen_(0)
+    , rblen_(0)
+    , payload_size_(0)
+    , matrix_(config.ldpc_prng_seed, config.ldpc_N1, allocator)
+    , buffer_factory_(buffer_factory)
+    , buff_tab_(allocator)
+    , recv_tab_(allocator)
+    , row_unknown_(allocator)
+    , row_queue_(allocator)
+    , row_queue_head_(0)
+    , row_queue_tail_(0)
+    , n_known_(0)
+    , n_known_source_(0)
+    , elim_vars_(allocator)
+    , elim_var_cols_(allocator)
+    , elim_bits_(allocator)
+    , elim_buffs_(allocator)
+    , has_new_packets_(false)
+    , valid_(false) {
+    if (config.scheme != packet::FEC_LDPC_Staircase) {
+        roc_panic("ldpc decoder: unexpected fec scheme");
+    }
+
+    roc_log(LogDebug, "ldpc decoder: initializing: prng_seed=%ld n1=%d",
+            (long)config.ldpc_prng_seed, (int)config.ldpc_N1);
+
+    if (config.ldpc_N1 == 0) {
+        roc_log(LogError, "ldpc decoder: n1 should be positive");
+        return;
+    }
+
+    valid_ = true;
+}
+
+LdpcStaircaseDecoder::~LdpcStaircaseDecoder() {
+}
+
+bool LdpcStaircaseDecoder::valid() const {
+    return valid_;
+}
+
+size_t LdpcStaircaseDecoder::max_block_length() const {
+    roc_panic_if_not(valid());
+
+    return LdpcStaircaseMatrix::MaxBlockLength;
+}
+
+bool LdpcStaircaseDecoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
+    roc_panic_if_not(valid());
+
+    if (!resize_tabs_(sblen + rblen)) {
+        return false;
+    }
+
+    if (!row_unknown_.resize(rblen) || !row_queue_.resize(rblen)) {
+        return false;
+    }
+
+    if (!matrix_.build(sblen, rblen)) {
+        return false;
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+    payload_size_ = payload_size;
+
+    // row i contains its source symbols and repair symbols i and i-1
+    for (size_t i = 0; i < rblen; i++) {
+        row_unknown_[i] =
+            uint32_t(matrix_.row_end(i) - matrix_.row_begin(i)) + (i == 0 ? 1 : 2);
+    }
+
+    row_queue_head_ = 0;
+    row_queue_tail_ = 0;
+
+    n_known_ = 0;
+    n_known_source_ = 0;
+
+    return true;
+}
+
+void LdpcStaircaseDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("ldpc decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buffer) {
+        roc_panic("ldpc decoder: null buffer");
+    }
+
+    if (buffer.size() == 0 || buffer.size() != payload_size_) {
+        roc_panic("ldpc decoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    if (buff_tab_[index]) {
+        roc_panic("ldpc decoder: can't overwrite buffer: index=%lu",
+                  (unsigned long)index);
+    }
+
+    buff_tab_[index] = buffer;
+    recv_tab_[index] = true;
+
+    has_new_packets_ = true;
+
+    mark_known_(index);
+}
+
+core::Slice<uint8_t> LdpcStaircaseDecoder::repair(size_t index) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("ldpc decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buff_tab_[index]) {
+        decode_();
+    }
+
+    return buff_tab_[index];
+}
+
+void LdpcStaircaseDecoder::end() {
+    roc_panic_if_not(valid());
+
+    report_();
+    reset_tabs_();
+
+    has_new_packets_ = false;
+}
+
+bool LdpcStaircaseDecoder::resize_tabs_(size_t size) {
+    if (!buff_tab_.resize(size)) {
+        return false;
+    }
+    if (!recv_tab_.resize(size)) {
+        return false;
+    }
+    if (!elim_var_cols_.resize(size)) {
+        return false;
+    }
+
+    return true;
+}
+
+void LdpcStaircaseDecoder::reset_tabs_() {
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+        recv_tab_[i] = false;
+    }
+
+    for (size_t i = 0; i < elim_buffs_.size(); ++i) {
+        elim_buffs_[i] = core::Slice<uint8_t>();
+    }
+}
+
+void LdpcStaircaseDecoder::decode_() {
+    peel_();
+
+    if (n_known_source_ == sblen_) {
+        return;
+    }
+
+    // elimination can't solve more than it solved last time,
+    // until new packets arrive
+    if (!has_new_packets_) {
+        return;
+    }
+
+    has_new_packets_ = false;
+
+    // no chance to repair all source packets
+    if (n_known_ < sblen_) {
+        return;
+    }
+
+    eliminate_();
+    peel_();
+}
+
+void LdpcStaircaseDecoder::mark_known_(size_t index) {
+    n_known_++;
+
+    if (index < sblen_) {
+        n_known_source_++;
+
+        const uint32_t* rows_end = matrix_.col_end(index);
+
+        for (const uint32_t* row = matrix_.col_begin(index); row != rows_end; ++row) {
+            decrement_row_(*row);
+        }
+    } else {
+        const size_t row = index - sblen_;
+
+        decrement_row_(row);
+        if (row + 1 < rblen_) {
+            decrement_row_(row + 1);
+        }
+    }
+}
+
+void LdpcStaircaseDecoder::decrement_row_(size_t row) {
+    roc_panic_if(row_unknown_[row] == 0);
+
+    // counter reaches one only once, so queue never overflows
+    if (--row_unknown_[row] == 1) {
+        row_queue_[row_queue_tail_++] = (uint32_t)row;
+    }
+}
+
+void LdpcStaircaseDecoder::peel_() {
+    while (row_queue_head_ != row_queue_tail_) {
+        const size_t row = row_queue_[row_queue_head_++];
+
+        // row may be solved already by solving other rows
+        if (row_unknown_[row] != 1) {
+            continue;
+        }
+
+        if (!solve_row_(row)) {
+            // retry on next call
+            row_queue_head_--;
+            return;
+        }
+    }
+}
+
+bool LdpcStaircaseDecoder::solve_row_(size_t row) {
+    core::Slice<uint8_t> buffer = new_buffer_();
+    if (!buffer) {
+        return false;
+    }
+
+    uint8_t* data = buffer.data();
+    memset(data, 0, payload_size_);
+
+    size_t unknown = NoVar;
+
+    for (const uint32_t* col = matrix_.row_begin(row); col != matrix_.row_end(row);
+         ++col) {
+        if (buff_tab_[*col]) {
+            XorOps::xor_to(data, buff_tab_[*col].data(), payload_size_);
+        } else {
+            unknown = *col;
+        }
+    }
+
+    for (size_t n = 0; n < (row == 0 ? 1u : 2u); n++) {
+        const size_t index = sblen_ + row - n;
+
+        if (buff_tab_[index]) {
+            XorOps::xor_to(data, buff_tab_[index].data(), payload_size_);
+        } else {
+            unknown = index;
+        }
+    }
+
+    roc_panic_if(unknown == NoVar);
+
+    roc_log(LogTrace, "ldpc decoder: repaired packet: index=%lu row=%lu",
+            (unsigned long)unknown, (unsigned long)row);
+
+    buff_tab_[unknown] = buffer;
+    mark_known_(unknown);
+
+    return true;
+}
+
+void LdpcStaircaseDecoder::eliminate_() {
+    size_t n_vars = 0;
+
+    for (size_t i = 0; i < sblen_ + rblen_; i++) {
+        if (buff_tab_[i]) {
+            elim_var_cols_[i] = NoVar;
+        } else {
+            elim_var_cols_[i] = (uint32_t)n_vars++;
+        }
+    }
+
+    if (n_vars > MaxElimVars) {
+        roc_log(LogDebug, "ldpc decoder: too many unknown packets for elimination: %lu",
+                (unsigned long)n_vars);
+        return;
+    }
+
+    if (!elim_vars_.resize(n_vars)) {
+        return;
+    }
+
+    for (size_t i = 0; i < sblen_ + rblen_; i++) {
+        if (elim_var_cols_[i] != NoVar) {
+            elim_vars_[elim_var_cols_[i]] = (uint32_t)i;
+        }
+    }
+
+    const size_t n_words = (n_vars + 63) / 64;
+
+    if (build_equations_(n_words)) {
+        const size_t rank = reduce_equations_(n_vars, n_words);
+
+        roc_log(LogTrace, "ldpc decoder: elimination: n_vars=%lu n_eqs=%lu rank=%lu",
+                (unsigned long)n_vars, (unsigned long)elim_buffs_.size(),
+                (unsigned long)rank);
+
+        apply_equations_(n_vars, n_words, rank);
+    }
+
+    for (size_t i = 0; i < elim_buffs_.size(); ++i) {
+        elim_buffs_[i] = core::Slice<uint8_t>();
+    }
+}
+
+bool LdpcStaircaseDecoder::build_equations_(size_t n_words) {
+    size_t n_eqs = 0;
+
+    for (size_t row = 0; row < rblen_; row++) {
+        if (row_unknown_[row] != 0) {
+            n_eqs++;
+        }
+    }
+
+    if (!elim_bits_.resize(n_eqs * n_words) || !elim_buffs_.resize(n_eqs)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < n_eqs * n_words; i++) {
+        elim_bits_[i] = 0;
+    }
+
+    size_t eq = 0;
+
+    for (size_t row = 0; row < rblen_; row++) {
+        if (row_unknown_[row] == 0) {
+            continue;
+        }
+
+        core::Slice<uint8_t> buffer = new_buffer_();
+        if (!buffer) {
+            return false;
+        }
+
+        uint8_t* data = buffer.data();
+        memset(data, 0, payload_size_);
+
+        uint64_t* bits = &elim_bits_[eq * n_words];
+
+        for (const uint32_t* col = matrix_.row_begin(row); col != matrix_.row_end(row);
+             ++col) {
+            if (buff_tab_[*col]) {
+                XorOps::xor_to(data, buff_tab_[*col].data(), payload_size_);
+            } else {
+                set_bit(bits, elim_var_cols_[*col]);
+            }
+        }
+
+        for (size_t n = 0; n < (row == 0 ? 1u : 2u); n++) {
+            const size_t index = sblen_ + row - n;
+
+            if (buff_tab_[index]) {
+                XorOps::xor_to(data, buff_tab_[index].data(), payload_size_);
+            } else {
+                set_bit(bits, elim_var_cols_[index]);
+            }
+        }
+
+        elim_buffs_[eq++] = buffer;
+    }
+
+    return true;
+}
+
+// Gauss-Jordan elimination over GF(2); returns number of pivot rows,
+// which are moved to the beginning
+size_t LdpcStaircaseDecoder::reduce_equations_(size_t n_vars, size_t n_words) {
+    const size_t n_eqs = elim_buffs_.size();
+
+    size_t rank = 0;
+
+    for (size_t var = 0; var < n_vars && rank < n_eqs; var++) {
+        size_t pivot = rank;
+        while (pivot < n_eqs && !get_bit(&elim_bits_[pivot * n_words], var)) {
+            pivot++;
+        }
+
+        if (pivot == n_eqs) {
+            continue;
+        }
+
+        if (pivot != rank) {
+            for (size_t w = 0; w < n_words; w++) {
+                const uint64_t tmp = elim_bits_[pivot * n_words + w];
+                elim_bits_[pivot * n_words + w] = elim_bits_[rank * n_words + w];
+                elim_bits_[rank * n_words + w] = tmp;
+            }
+
+            const core::Slice<uint8_t> tmp = elim_buffs_[pivot];
+            elim_buffs_[pivot] = elim_buffs_[rank];
+            elim_buffs_[rank] = tmp;
+        }
+
+        const uint64_t* pivot_bits = &elim_bits_[rank * n_words];
+
+        for (size_t eq = 0; eq < n_eqs; eq++) {
+            uint64_t* bits = &elim_bits_[eq * n_words];
+
+            if (eq == rank || !get_bit(bits, var)) {
+                continue;
+            }
+
+            for (size_t w = 0; w < n_words; w++) {
+                bits[w] ^= pivot_bits[w];
+            }
+
+            XorOps::xor_to(elim_buffs_[eq].data(), elim_buffs_[rank].data(),
+                           payload_size_);
+        }
+
+        rank++;
+    }
+
+    return rank;
+}
+
+// pivot row with single variable left holds value of that variable
+void LdpcStaircaseDecoder::apply_equations_(size_t n_vars, size_t n_words, size_t rank) {
+    for (size_t eq = 0; eq < rank; eq++) {
+        const uint64_t* bits = &elim_bits_[eq * n_words];
+
+        size_t var = NoVar;
+        size_t n_bits = 0;
+
+        for (size_t n = 0; n < n_vars && n_bits < 2; n++) {
+            if (get_bit(bits, n)) {
+                var = n;
+                n_bits++;
+            }
+        }
+
+        if (n_bits != 1) {
+            continue;
+        }
+
+        const size_t index = elim_vars_[var];
+
+        roc_log(LogTrace, "ldpc decoder: repaired packet by elimination: index=%lu",
+                (unsigned long)index);
+
+        buff_tab_[index] = elim_buffs_[eq];
+        mark_known_(index);
+    }
+}
+
+core::Slice<uint8_t> LdpcStaircaseDecoder::new_buffer_() {
+    core::Slice<uint8_t> buffer = buffer_factory_.new_buffer();
+
+    if (!buffer) {
+        roc_log(LogError, "ldpc decoder: can't allocate buffer");
+        return core::Slice<uint8_t>();
+    }
+
+    if (buffer.capacity() < payload_size_) {
+        roc_log(LogError, "ldpc decoder: packet size too large: size=%lu max=%lu",
+                (unsigned long)payload_size_, (unsigned long)buffer.capacity());
+        return core::Slice<uint8_t>();
+    }
+
+    buffer.reslice(0, payload_size_);
+
+    return buffer;
+}
+
+void LdpcStaircaseDecoder::report_() {
+    size_t n_lost = 0, n_repaired = 0;
+
+    for (size_t i = 0; i < sblen_ + rblen_ && i < buff_tab_.size(); ++i) {
+        if (recv_tab_[i]) {
+            continue;
+        }
+        n_lost++;
+        if (buff_tab_[i]) {
+            n_repaired++;
+        }
+    }
+
+    if (n_lost == 0) {
+        return;
+    }
+
+    roc_log(LogDebug, "ldpc decoder: repaired %u/%u/%u", (unsigned)n_repaired,
+            (unsigned)n_lost, (unsigned)(sblen_ + rblen_));
+}
+
+} // namespace fec
+} // namespace roc
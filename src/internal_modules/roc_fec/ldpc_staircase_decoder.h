@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/ldpc_staircase_decoder.h
+//! @brief LDPC-Staircase decoder.
+
+#ifndef ROC_FEC_LDPC_STAIRCASE_DECODER_H_
+#define ROC_FEC_LDPC_STAIRCASE_DECODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/codec_config.h"
+#include "roc_fec/iblock_decoder.h"
+#include "roc_fec/ldpc_staircase_matrix.h"
+
+namespace roc {
+namespace fec {
+
+//! LDPC-Staircase decoder.
+//! @remarks
+//!  Native implementation of LDPC-Staircase scheme, compatible with OpenFEC.
+//!
+//!  Decoding is iterative (peeling): every row of parity check matrix is an
+//!  equation "XOR of its symbols is zero", and when only one symbol of a
+//!  row is unknown, it's restored as XOR of the others, which may in turn
+//!  leave single unknown symbol in other rows. Set() only updates counters
+//!  of unknown symbols per row; payloads are XORed lazily in repair().
+//!
+//!  If peeling gets stuck while enough packets were received, decoder
+//!  falls back to Gaussian elimination over remaining unknown symbols,
+//!  similar to maximum likelihood decoding in OpenFEC.
+//!
+//!  All tables are reused between blocks and grow only when block size
+//!  grows; repaired payloads are allocated from buffer factory.
+class LdpcStaircaseDecoder : public IBlockDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit LdpcStaircaseDecoder(const CodecConfig& config,
+                                  core::BufferFactory<uint8_t>& buffer_factory,
+                                  core::IAllocator& allocator);
+
+    virtual ~LdpcStaircaseDecoder();
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get the maximum number of encoding symbols for the scheme being used.
+    virtual size_t max_block_length() const;
+
+    //! Start block.
+    //!
+    //! @remarks
+    //!  Performs an initial setup for a block. Should be called before
+    //!  any operations for the block.
+    virtual bool begin(size_t sblen, size_t rblen, size_t payload_size);
+
+    //! Store source or repair packet buffer for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Repair source packet buffer.
+    virtual core::Slice<uint8_t> repair(size_t index);
+
+    //! Finish block.
+    //!
+    //! @remarks
+    //!  Cleanups the resources allocated for the block. Should be called after
+    //!  all operations for the block.
+    virtual void end();
+
+private:
+    // Maximum number of unknown symbols for Gaussian elimination.
+    enum { MaxElimVars = 1024 };
+
+    enum { NoVar = 0xffffffff };
+
+    bool resize_tabs_(size_t size);
+    void reset_tabs_();
+
+    void decode_();
+
+    void mark_known_(size_t index);
+    void decrement_row_(size_t row);
+
+    void peel_();
+    bool solve_row_(size_t row);
+
+    void eliminate_();
+    bool build_equations_(size_t n_words);
+    size_t reduce_equations_(size_t n_vars, size_t n_words);
+    void apply_equations_(size_t n_vars, size_t n_words, size_t rank);
+
+    core::Slice<uint8_t> new_buffer_();
+
+    void report_();
+
+    size_t sblen_;
+    size_t rblen_;
+    size_t payload_size_;
+
+    // rebuilt only when block size changes
+    LdpcStaircaseMatrix matrix_;
+
+    core::BufferFactory<uint8_t>& buffer_factory_;
+
+    // received and repaired source and repair packets
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+
+    // true if packet is received, false if it's is lost or repaired
+    core::Array<bool> recv_tab_;
+
+    // number of unknown symbols in every row
+    core::Array<uint32_t> row_unknown_;
+
+    // rows that had single unknown symbol
+    core::Array<uint32_t> row_queue_;
+    size_t row_queue_head_;
+    size_t row_queue_tail_;
+
+    size_t n_known_;
+    size_t n_known_source_;
+
+    // elimination state: unknown symbols, bit matrix of equations (one row
+    // per row of parity check matrix having unknown symbols), and equations
+    // right hand side, which becomes symbol value when equation is solved
+    core::Array<uint32_t> elim_vars_;
+    core::Array<uint32_t> elim_var_cols_;
+    core::Array<uint64_t> elim_bits_;
+    core::Array<core::Slice<uint8_t> > elim_buffs_;
+
+    bool has_new_packets_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_LDPC_STAIRCASE_DECODER_H_
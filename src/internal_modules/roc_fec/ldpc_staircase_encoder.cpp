@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/ldpc_staircase_encoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/xor_ops.h"
+
+namespace roc {
+namespace fec {
+
+LdpcStaircaseEncoder::LdpcStaircaseEncoder(const CodecConfig& config,
+                                           core::BufferFactory<uint8_t>&,
+                                           core::IAllocator& allocator)
+    : sblen_(0)
+    , rblen_(0)
+    , payload_size_(0)
+    , matrix_(config.ldpc_prng_seed, config.ldpc_N1, allocator)
+    , buff_tab_(allocator)
+    , valid_(false) {
+    if (config.scheme != packet::FEC_LDPC_Staircase) {
+        roc_panic("ldpc encoder: unexpected fec scheme");
+    }
+
+    roc_log(LogDebug, "ldpc encoder: initializing: prng_seed=%ld n1=%d",
+            (long)config.ldpc_prng_seed, (int)config.ldpc_N1);
+
+    if (config.ldpc_N1 == 0) {
+        roc_log(LogError, "ldpc encoder: n1 should be positive");
+        return;
+    }
+
+    valid_ = true;
+}
+
+LdpcStaircaseEncoder::~LdpcStaircaseEncoder() {
+}
+
+bool LdpcStaircaseEncoder::valid() const {
+    return valid_;
+}
+
+size_t LdpcStaircaseEncoder::alignment() const {
+    return XorOps::Alignment;
+}
+
+size_t LdpcStaircaseEncoder::max_block_length() const {
+    roc_panic_if_not(valid());
+
+    return LdpcStaircaseMatrix::MaxBlockLength;
+}
+
+bool LdpcStaircaseEncoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
+    roc_panic_if_not(valid());
+
+    if (!buff_tab_.resize(sblen + rblen)) {
+        return false;
+    }
+
+    if (!matrix_.build(sblen, rblen)) {
+        return false;
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+    payload_size_ = payload_size;
+
+    return true;
+}
+
+void LdpcStaircaseEncoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("ldpc encoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buffer) {
+        roc_panic("ldpc encoder: null buffer");
+    }
+
+    if (buffer.size() == 0 || buffer.size() != payload_size_) {
+        roc_panic("ldpc encoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    if ((uintptr_t)buffer.data() % XorOps::Alignment != 0) {
+        roc_panic("ldpc encoder: buffer data should be %d-byte aligned: index=%lu",
+                  (int)XorOps::Alignment, (unsigned long)index);
+    }
+
+    buff_tab_[index] = buffer;
+}
+
+void LdpcStaircaseEncoder::fill() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < rblen_; i++) {
+        core::Slice<uint8_t>& repair = buff_tab_[sblen_ + i];
+        if (!repair) {
+            roc_panic("ldpc encoder: repair buffer not set: index=%lu",
+                      (unsigned long)(sblen_ + i));
+        }
+
+        uint8_t* data = repair.data();
+
+        // staircase: start from previous repair packet
+        if (i == 0) {
+            memset(data, 0, payload_size_);
+        } else {
+            memcpy(data, buff_tab_[sblen_ + i - 1].data(), payload_size_);
+        }
+
+        for (const uint32_t* col = matrix_.row_begin(i); col != matrix_.row_end(i);
+             ++col) {
+            const core::Slice<uint8_t>& source = buff_tab_[*col];
+            if (!source) {
+                roc_panic("ldpc encoder: source buffer not set: index=%lu",
+                          (unsigned long)*col);
+            }
+
+            XorOps::xor_to(data, source.data(), payload_size_);
+        }
+    }
+}
+
+void LdpcStaircaseEncoder::end() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/ldpc_staircase_encoder.h
+//! @brief LDPC-Staircase encoder.
+
+#ifndef ROC_FEC_LDPC_STAIRCASE_ENCODER_H_
+#define ROC_FEC_LDPC_STAIRCASE_ENCODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/codec_config.h"
+#include "roc_fec/iblock_encoder.h"
+#include "roc_fec/ldpc_staircase_matrix.h"
+
+namespace roc {
+namespace fec {
+
+//! LDPC-Staircase encoder.
+//! @remarks
+//!  Native implementation of LDPC-Staircase scheme, producing the same
+//!  repair packets as OpenFEC for the same block size and codec parameters.
+//!  Repair packet i is XOR of source packets of row i of parity check
+//!  matrix and repair packet i-1.
+class LdpcStaircaseEncoder : public IBlockEncoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit LdpcStaircaseEncoder(const CodecConfig& config,
+                                  core::BufferFactory<uint8_t>& buffer_factory,
+                                  core::IAllocator& allocator);
+
+    virtual ~LdpcStaircaseEncoder();
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get buffer alignment requirement.
+    virtual size_t alignment() const;
+
+    //! Get the maximum number of encoding symbols for the scheme being used.
+    virtual size_t max_block_length() const;
+
+    //! Start block.
+    //!
+    //! @remarks
+    //!  Performs an initial setup for a block. Should be called before
+    //!  any operations for the block.
+    virtual bool begin(size_t sblen, size_t rblen, size_t payload_size);
+
+    //! Store packet data for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Fill repair packets.
+    virtual void fill();
+
+    //! Finish block.
+    //!
+    //! @remarks
+    //!  Cleanups the resources allocated for the block. Should be called after
+    //!  all operations for the block.
+    virtual void end();
+
+private:
+    size_t sblen_;
+    size_t rblen_;
+    size_t payload_size_;
+
+    // rebuilt only when block size changes
+    LdpcStaircaseMatrix matrix_;
+
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_LDPC_STAIRCASE_ENCODER_H_
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/ldpc_staircase_matrix.h"
+#include "roc_core/log.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// Park-Miller "minimal standard" PRNG parameters, RFC 5170, section 5.7.
+const uint32_t PrngA = 16807;
+const uint32_t PrngM = 0x7FFFFFFF;
+
+} // namespace
+
+LdpcStaircaseMatrix::LdpcStaircaseMatrix(int32_t prng_seed,
+                                         size_t n1,
+                                         core::IAllocator& allocator)
+    : prng_seed_(prng_seed)
+    , n1_(n1)
+    , built_(false)
+    , n_source_(0)
+    , n_repair_(0)
+    , prng_state_(0)
+    , entry_rows_(allocator)
+    , entry_cols_(allocator)
+    , n_entries_(0)
+    , row_degree_(allocator)
+    , choices_(allocator)
+    , row_offsets_(allocator)
+    , row_cols_(allocator)
+    , col_offsets_(allocator)
+    , col_rows_(allocator) {
+}
+
+bool LdpcStaircaseMatrix::build(size_t n_source, size_t n_repair) {
+    if (built_ && n_source_ == n_source && n_repair_ == n_repair) {
+        return true;
+    }
+
+    built_ = false;
+
+    if (n1_ == 0 || n_source == 0 || n_source + n_repair > MaxBlockLength) {
+        roc_log(LogError,
+                "ldpc matrix: invalid parameters: n_source=%lu n_repair=%lu n1=%lu",
+                (unsigned long)n_source, (unsigned long)n_repair, (unsigned long)n1_);
+        return false;
+    }
+
+    n_source_ = n_source;
+    n_repair_ = n_repair;
+
+    const size_t n1 = std::min(n1_, n_repair);
+    const size_t max_entries = n1 * n_source + 2 * n_repair;
+
+    if (!entry_rows_.resize(max_entries) || !entry_cols_.resize(max_entries)
+        || !row_degree_.resize(n_repair) || !choices_.resize(n1 * n_source)
+        || !row_offsets_.resize(n_repair + 1) || !col_offsets_.resize(n_source + 1)) {
+        return false;
+    }
+
+    roc_log(LogTrace, "ldpc matrix: building: n_source=%lu n_repair=%lu n1=%lu",
+            (unsigned long)n_source, (unsigned long)n_repair, (unsigned long)n1);
+
+    if (n_repair != 0) {
+        build_left_();
+    }
+
+    if (!build_index_()) {
+        return false;
+    }
+
+    built_ = true;
+    return true;
+}
+
+size_t LdpcStaircaseMatrix::n_source() const {
+    return n_source_;
+}
+
+size_t LdpcStaircaseMatrix::n_repair() const {
+    return n_repair_;
+}
+
+const uint32_t* LdpcStaircaseMatrix::row_begin(size_t row) const {
+    return row_cols_.data() + row_offsets_[row];
+}
+
+const uint32_t* LdpcStaircaseMatrix::row_end(size_t row) const {
+    return row_cols_.data() + row_offsets_[row + 1];
+}
+
+const uint32_t* LdpcStaircaseMatrix::col_begin(size_t col) const {
+    return col_rows_.data() + col_offsets_[col];
+}
+
+const uint32_t* LdpcStaircaseMatrix::col_end(size_t col) const {
+    return col_rows_.data() + col_offsets_[col + 1];
+}
+
+// Follows left_matrix_init() from RFC 5170, section 6.2.
+void LdpcStaircaseMatrix::build_left_() {
+    const uint32_t k = (uint32_t)n_source_;
+    const uint32_t n_k = (uint32_t)n_repair_;
+    const uint32_t n1 = (uint32_t)std::min(n1_, n_repair_);
+    const uint32_t n_choices = n1 * k;
+
+    prng_state_ = (uint32_t)prng_seed_;
+    n_entries_ = 0;
+
+    for (uint32_t i = 0; i < n_k; i++) {
+        row_degree_[i] = 0;
+    }
+
+    // initialize list of all possible choices, in order to guarantee
+    // homogeneous distribution of ones
+    for (uint32_t h = 0; h < n_choices; h++) {
+        choices_[h] = h % n_k;
+    }
+
+    // add N1 ones to every column
+    uint32_t t = 0;
+
+    for (uint32_t j = 0; j < k; j++) {
+        for (uint32_t h = 0; h < n1; h++) {
+            uint32_t i = t;
+            while (i < n_choices && has_entry_(choices_[i], j)) {
+                i++;
+            }
+
+            if (i < n_choices) {
+                // choose one of remaining choices
+                do {
+                    i = t + rand_(n_choices - t);
+                } while (has_entry_(choices_[i], j));
+
+                insert_entry_(choices_[i], j);
+
+                // replace with choice that was never taken
+                choices_[i] = choices_[t];
+                t++;
+            } else {
+                // no choice left, choose random row
+                do {
+                    i = rand_(n_k);
+                } while (has_entry_(i, j));
+
+                insert_entry_(i, j);
+            }
+        }
+    }
+
+    // add extra ones to avoid rows with less than two ones
+    for (uint32_t i = 0; i < n_k; i++) {
+        if (row_degree_[i] == 0) {
+            insert_entry_(i, rand_(k));
+        }
+        if (row_degree_[i] == 1 && k > 1) {
+            uint32_t j;
+            do {
+                j = rand_(k);
+            } while (has_entry_(i, j));
+
+            insert_entry_(i, j);
+        }
+    }
+}
+
+bool LdpcStaircaseMatrix::build_index_() {
+    if (!row_cols_.resize(n_entries_) || !col_rows_.resize(n_entries_)) {
+        return false;
+    }
+
+    for (size_t i = 0; i <= n_repair_; i++) {
+        row_offsets_[i] = 0;
+    }
+    for (size_t j = 0; j <= n_source_; j++) {
+        col_offsets_[j] = 0;
+    }
+
+    for (size_t e = 0; e < n_entries_; e++) {
+        row_offsets_[entry_rows_[e] + 1]++;
+        col_offsets_[entry_cols_[e] + 1]++;
+    }
+
+    for (size_t i = 0; i < n_repair_; i++) {
+        row_offsets_[i + 1] += row_offsets_[i];
+    }
+    for (size_t j = 0; j < n_source_; j++) {
+        col_offsets_[j + 1] += col_offsets_[j];
+    }
+
+    // row_degree_ and choices_ are reused as insertion positions
+    for (size_t i = 0; i < n_repair_; i++) {
+        row_degree_[i] = row_offsets_[i];
+    }
+
+    for (size_t e = 0; e < n_entries_; e++) {
+        row_cols_[row_degree_[entry_rows_[e]]++] = entry_cols_[e];
+    }
+
+    if (n_entries_ == 0) {
+        return true;
+    }
+
+    for (size_t j = 0; j < n_source_; j++) {
+        choices_[j] = col_offsets_[j];
+    }
+
+    for (size_t e = 0; e < n_entries_; e++) {
+        col_rows_[choices_[entry_cols_[e]]++] = entry_rows_[e];
+    }
+
+    return true;
+}
+
+bool LdpcStaircaseMatrix::has_entry_(uint32_t row, uint32_t col) const {
+    const size_t n1 = std::min(n1_, n_repair_);
+    const size_t n_regular = std::min(n1 * n_source_, n_entries_);
+
+    // regular entries of column
+    for (size_t e = col * n1; e < std::min(col * n1 + n1, n_regular); e++) {
+        if (entry_rows_[e] == row) {
+            return true;
+        }
+    }
+
+    // extra entries
+    for (size_t e = n_regular; e < n_entries_; e++) {
+        if (entry_cols_[e] == col && entry_rows_[e] == row) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void LdpcStaircaseMatrix::insert_entry_(uint32_t row, uint32_t col) {
+    entry_rows_[n_entries_] = row;
+    entry_cols_[n_entries_] = col;
+    n_entries_++;
+
+    row_degree_[row]++;
+}
+
+// Returns value in range [0; max-1], RFC 5170, section 5.7.
+uint32_t LdpcStaircaseMatrix::rand_(uint32_t max) {
+    // Park-Miller generator, Carta's implementation without division
+    uint32_t lo = PrngA * (prng_state_ & 0xFFFF);
+    const uint32_t hi = PrngA * (prng_state_ >> 16);
+
+    lo += (hi & 0x7FFF) << 16;
+    if (lo > PrngM) {
+        lo &= PrngM;
+        ++lo;
+    }
+    lo += hi >> 15;
+    if (lo > PrngM) {
+        lo &= PrngM;
+        ++lo;
+    }
+
+    prng_state_ = lo;
+
+    return (uint32_t)((double)prng_state_ * (double)max / (double)PrngM);
+}
+
+} // namespace fec
+} // namespace roc
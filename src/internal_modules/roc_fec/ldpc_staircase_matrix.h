@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/ldpc_staircase_matrix.h
+//! @brief LDPC-Staircase parity check matrix.
+
+#ifndef ROC_FEC_LDPC_STAIRCASE_MATRIX_H_
+#define ROC_FEC_LDPC_STAIRCASE_MATRIX_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! LDPC-Staircase parity check matrix.
+//! @remarks
+//!  Holds left part (H1) of parity check matrix, built as defined in
+//!  RFC 5170, section 6.2, from the same PRNG seed and N1 as OpenFEC does,
+//!  so that repair symbols are compatible with it. Right part (H2) is a
+//!  staircase and is not stored: row i additionally contains repair
+//!  symbols i and i-1.
+//!
+//!  Matrix is stored in sparse form both by rows and by columns. Memory
+//!  is reused when matrix is rebuilt for new block size, and matrix is
+//!  not rebuilt if block size is unchanged.
+class LdpcStaircaseMatrix : public core::NonCopyable<> {
+public:
+    //! Maximum number of encoding symbols in block.
+    enum { MaxBlockLength = 50000 };
+
+    //! Initialize.
+    LdpcStaircaseMatrix(int32_t prng_seed, size_t n1, core::IAllocator& allocator);
+
+    //! Build matrix for given block size.
+    //! @remarks
+    //!  If N1 is larger than @p n_repair, every source symbol is added to
+    //!  all rows instead.
+    //! @returns
+    //!  false if parameters are invalid or allocation failed.
+    bool build(size_t n_source, size_t n_repair);
+
+    //! Get number of source symbols (columns of H1).
+    size_t n_source() const;
+
+    //! Get number of repair symbols (rows).
+    size_t n_repair() const;
+
+    //! Get source symbols of given row.
+    const uint32_t* row_begin(size_t row) const;
+
+    //! Get end of source symbols of given row.
+    const uint32_t* row_end(size_t row) const;
+
+    //! Get rows containing given source symbol.
+    const uint32_t* col_begin(size_t col) const;
+
+    //! Get end of rows containing given source symbol.
+    const uint32_t* col_end(size_t col) const;
+
+private:
+    void build_left_();
+    bool build_index_();
+
+    bool has_entry_(uint32_t row, uint32_t col) const;
+    void insert_entry_(uint32_t row, uint32_t col);
+
+    uint32_t rand_(uint32_t max);
+
+    const int32_t prng_seed_;
+    const size_t n1_;
+
+    bool built_;
+    size_t n_source_;
+    size_t n_repair_;
+
+    uint32_t prng_state_;
+
+    // entries in order of insertion; first N1 * n_source entries are
+    // placed column by column, N1 per column, and the rest are extra
+    // entries added to rows with less than two entries
+    core::Array<uint32_t> entry_rows_;
+    core::Array<uint32_t> entry_cols_;
+    size_t n_entries_;
+
+    // number of entries per row
+    core::Array<uint32_t> row_degree_;
+
+    // list of possible row choices, see RFC 5170
+    core::Array<uint32_t> choices_;
+
+    // compressed sparse rows and columns
+    core::Array<uint32_t> row_offsets_;
+    core::Array<uint32_t> row_cols_;
+    core::Array<uint32_t> col_offsets_;
+    core::Array<uint32_t> col_rows_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_LDPC_STAIRCASE_MATRIX_H_
@@ -34,19 +34,28 @@ Reader::Reader(const ReaderConfig& config,
     , valid_(false)
     , alive_(true)
     , started_(false)
-    , can_repair_(false)
+    , decoding_(false)
+    , decoding_outdated_(false)
     , next_packet_(0)
     , cur_sbn_(0)
     , payload_size_(0)
     , source_block_resized_(false)
     , repair_block_resized_(false)
     , payload_resized_(false)
+    , n_block_source_(0)
+    , n_block_repair_(0)
+    , n_decoded_blocks_(0)
+    , n_skipped_blocks_(0)
     , n_packets_(0)
     , max_sbn_jump_(config.max_sbn_jump)
     , fec_scheme_(fec_scheme) {
     valid_ = true;
 }
 
+Reader::~Reader() {
+    end_decoding_();
+}
+
 bool Reader::valid() const {
     return valid_;
 }
@@ -59,6 +68,14 @@ bool Reader::alive() const {
     return alive_;
 }
 
+size_t Reader::n_decoded_blocks() const {
+    return n_decoded_blocks_;
+}
+
+size_t Reader::n_skipped_blocks() const {
+    return n_skipped_blocks_;
+}
+
 packet::PacketPtr Reader::read() {
     roc_panic_if_not(valid());
     if (!alive_) {
@@ -160,6 +177,13 @@ packet::PacketPtr Reader::get_next_packet_() {
 void Reader::next_block_() {
     roc_log(LogTrace, "fec reader: next block: sbn=%lu", (unsigned long)cur_sbn_);
 
+    if (decoding_) {
+        end_decoding_();
+        n_decoded_blocks_++;
+    } else {
+        n_skipped_blocks_++;
+    }
+
     for (size_t n = 0; n < source_block_.size(); n++) {
         source_block_[n] = NULL;
     }
@@ -175,28 +199,92 @@ void Reader::next_block_() {
     repair_block_resized_ = false;
     payload_resized_ = false;
 
-    can_repair_ = false;
+    n_block_source_ = 0;
+    n_block_repair_ = 0;
 
     fill_block_();
 }
 
 void Reader::try_repair_() {
-    if (!can_repair_) {
+    if (!decoding_) {
+        if (!can_begin_decoding_()) {
+            return;
+        }
+        if (!begin_decoding_()) {
+            return;
+        }
+    }
+
+    if (repair_next_packet_()) {
         return;
     }
 
-    if (!source_block_resized_ || !repair_block_resized_ || !payload_resized_) {
+    if (!decoding_outdated_) {
         return;
     }
 
+    // new packets arrived after decoder was started; decoder may have already
+    // filled their slots by itself, so instead of adding them, restart it
+    end_decoding_();
+
+    if (!begin_decoding_()) {
+        return;
+    }
+
+    (void)repair_next_packet_();
+}
+
+bool Reader::repair_next_packet_() {
+    // repair only packets up to the next received one, because only they are
+    // going to be read now; the rest is repaired when reader reaches them
+    for (size_t n = next_packet_; n < source_block_.size(); n++) {
+        if (source_block_[n]) {
+            break;
+        }
+
+        core::Slice<uint8_t> buffer = decoder_.repair(n);
+        if (!buffer) {
+            continue;
+        }
+
+        packet::PacketPtr pp = parse_repaired_packet_(buffer);
+        if (!pp) {
+            continue;
+        }
+
+        source_block_[n] = pp;
+        return true;
+    }
+
+    return false;
+}
+
+bool Reader::can_begin_decoding_() const {
+    if (!source_block_resized_ || !repair_block_resized_ || !payload_resized_) {
+        return false;
+    }
+
+    // no codec can repair a block having less than sblen packets,
+    // so don't touch decoder until enough packets arrive
+    if (n_block_repair_ == 0) {
+        return false;
+    }
+
+    if (n_block_source_ + n_block_repair_ < source_block_.size()) {
+        return false;
+    }
+
+    return true;
+}
+
+bool Reader::begin_decoding_() {
     if (!decoder_.begin(source_block_.size(), repair_block_.size(), payload_size_)) {
         roc_log(LogDebug,
                 "fec reader: can't begin decoder block, shutting down:"
                 " sbl=%lu rbl=%lu payload_size=%lu",
                 (unsigned long)source_block_.size(), (unsigned long)repair_block_.size(),
                 (unsigned long)payload_size_);
-        alive_ = false;
-        return;
+        return (alive_ = false);
     }
 
     for (size_t n = 0; n < source_block_.size(); n++) {
@@ -213,26 +301,19 @@ void Reader::try_repair_() {
         decoder_.set(source_block_.size() + n, repair_block_[n]->fec()->payload);
     }
 
-    for (size_t n = 0; n < source_block_.size(); n++) {
-        if (source_block_[n]) {
-            continue;
-        }
+    decoding_ = true;
+    decoding_outdated_ = false;
 
-        core::Slice<uint8_t> buffer = decoder_.repair(n);
-        if (!buffer) {
-            continue;
-        }
-
-        packet::PacketPtr pp = parse_repaired_packet_(buffer);
-        if (!pp) {
-            continue;
-        }
+    return true;
+}
 
-        source_block_[n] = pp;
+void Reader::end_decoding_() {
+    if (!decoding_) {
+        return;
     }
 
     decoder_.end();
-    can_repair_ = false;
+    decoding_ = false;
 }
 
 packet::PacketPtr Reader::parse_repaired_packet_(const core::Slice<uint8_t>& buffer) {
@@ -335,9 +416,13 @@ void Reader::fill_source_block_() {
         const size_t p_num = fec.encoding_symbol_id;
 
         if (!source_block_[p_num]) {
-            can_repair_ = true;
             source_block_[p_num] = pp;
+            n_block_source_++;
             n_added++;
+
+            if (decoding_) {
+                decoding_outdated_ = true;
+            }
         }
     }
 
@@ -401,9 +486,13 @@ void Reader::fill_repair_block_() {
         const size_t p_num = fec.encoding_symbol_id - fec.source_block_length;
 
         if (!repair_block_[p_num]) {
-            can_repair_ = true;
             repair_block_[p_num] = pp;
+            n_block_repair_++;
             n_added++;
+
+            if (decoding_) {
+                decoding_outdated_ = true;
+            }
         }
     }
 
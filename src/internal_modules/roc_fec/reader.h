@@ -57,6 +57,8 @@ public:
            packet::PacketFactory& packet_factory,
            core::IAllocator& allocator);
 
+    ~Reader();
+
     //! Check if object is successfully constructed.
     bool valid() const;
 
@@ -66,9 +68,21 @@ public:
     //! Is decoder alive?
     bool alive() const;
 
+    //! Get number of blocks for which decoder was used.
+    size_t n_decoded_blocks() const;
+
+    //! Get number of blocks for which decoder was not used.
+    //! @remarks
+    //!  These are blocks without losses, and blocks with losses that
+    //!  couldn't be repaired because not enough packets were received.
+    size_t n_skipped_blocks() const;
+
     //! Read packet.
     //! @remarks
     //!  When a packet loss is detected, try to restore it from repair packets.
+    //!  Decoding is lazy: decoder is started only when a missing packet is
+    //!  about to be read and the block has enough packets to repair it, and
+    //!  only packets that are actually read are requested from decoder.
     virtual packet::PacketPtr read();
 
 private:
@@ -79,6 +93,11 @@ private:
 
     void next_block_();
     void try_repair_();
+    bool repair_next_packet_();
+
+    bool can_begin_decoding_() const;
+    bool begin_decoding_();
+    void end_decoding_();
 
     packet::PacketPtr parse_repaired_packet_(const core::Slice<uint8_t>& buffer);
 
@@ -124,7 +143,8 @@ private:
 
     bool alive_;
     bool started_;
-    bool can_repair_;
+    bool decoding_;
+    bool decoding_outdated_;
 
     size_t next_packet_;
     packet::blknum_t cur_sbn_;
@@ -135,6 +155,12 @@ private:
     bool repair_block_resized_;
     bool payload_resized_;
 
+    size_t n_block_source_;
+    size_t n_block_repair_;
+
+    size_t n_decoded_blocks_;
+    size_t n_skipped_blocks_;
+
     unsigned n_packets_;
 
     const size_t max_sbn_jump_;
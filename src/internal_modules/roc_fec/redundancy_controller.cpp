@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/redundancy_controller.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// Estimates decay exponentially and never reach zero; residuals below this
+// value are not rounded up to an extra packet.
+const float Tolerance = 0.05f;
+
+float update_estimate(float estimate, float value, float release_factor) {
+    if (value >= estimate) {
+        return value;
+    }
+    return estimate + (value - estimate) * release_factor;
+}
+
+} // namespace
+
+RedundancyController::RedundancyController(const RedundancyControllerConfig& config,
+                                           size_t n_source_packets,
+                                           size_t n_repair_packets)
+    : config_(config)
+    , n_source_packets_(n_source_packets)
+    , n_repair_packets_(n_repair_packets)
+    , interleaving_depth_(1)
+    , loss_estimate_(0)
+    , burst_estimate_(0) {
+    roc_panic_if_msg(n_source_packets == 0,
+                     "redundancy controller: n_source_packets can't be zero");
+
+    roc_panic_if_msg(config.min_repair_packets > config.max_repair_packets,
+                     "redundancy controller: min_repair_packets > max_repair_packets");
+
+    roc_panic_if_msg(config.max_interleaving_depth == 0,
+                     "redundancy controller: max_interleaving_depth can't be zero");
+
+    // start from estimates matching initial block size, so that redundancy
+    // is released gradually if link is better than expected
+    if (config_.loss_margin > 0) {
+        loss_estimate_ =
+            float(n_repair_packets) / (float(n_source_packets) * config_.loss_margin);
+    }
+    burst_estimate_ = float(n_repair_packets);
+
+    recompute_();
+}
+
+void RedundancyController::update(float fract_loss,
+                                  const packet::LossRuns& loss_runs) {
+    // longest burst that can be repaired with deepest interleaving
+    const float max_burst =
+        float(config_.max_repair_packets * config_.max_interleaving_depth);
+
+    float burst = (float)loss_runs.max_lost_run();
+    if (burst > max_burst) {
+        burst = max_burst;
+    }
+
+    if (fract_loss < 0) {
+        fract_loss = 0;
+    }
+    if (fract_loss > 1) {
+        fract_loss = 1;
+    }
+
+    loss_estimate_ = update_estimate(loss_estimate_, fract_loss, config_.release_factor);
+    burst_estimate_ = update_estimate(burst_estimate_, burst, config_.release_factor);
+
+    const size_t prev_repair_packets = n_repair_packets_;
+    const size_t prev_interleaving_depth = interleaving_depth_;
+
+    recompute_();
+
+    if (n_repair_packets_ != prev_repair_packets
+        || interleaving_depth_ != prev_interleaving_depth) {
+        roc_log(LogDebug,
+                "redundancy controller: updating block size:"
+                " sblen=%lu rblen=%lu->%lu depth=%lu->%lu loss=%.3f burst=%.1f",
+                (unsigned long)n_source_packets_, (unsigned long)prev_repair_packets,
+                (unsigned long)n_repair_packets_,
+                (unsigned long)prev_interleaving_depth,
+                (unsigned long)interleaving_depth_, (double)loss_estimate_,
+                (double)burst_estimate_);
+    }
+}
+
+size_t RedundancyController::n_source_packets() const {
+    return n_source_packets_;
+}
+
+size_t RedundancyController::n_repair_packets() const {
+    return n_repair_packets_;
+}
+
+size_t RedundancyController::interleaving_depth() const {
+    return interleaving_depth_;
+}
+
+void RedundancyController::recompute_() {
+    const float loss = loss_estimate_ * config_.loss_margin * (float)n_source_packets_;
+
+    const size_t n_loss = loss > Tolerance ? (size_t)std::ceil(loss - Tolerance) : 0;
+
+    // interleave as few blocks as possible, since every block adds latency
+    size_t depth = 1;
+    while (depth < config_.max_interleaving_depth
+           && burst_estimate_ / float(depth)
+               > float(config_.max_repair_packets) + Tolerance) {
+        depth++;
+    }
+
+    // every interleaved block gets its share of the burst
+    const float burst = burst_estimate_ / float(depth);
+
+    const size_t n_burst = burst > Tolerance ? (size_t)std::ceil(burst - Tolerance) : 0;
+
+    size_t n_repair = std::max(n_loss, n_burst);
+
+    if (n_repair < config_.min_repair_packets) {
+        n_repair = config_.min_repair_packets;
+    }
+    if (n_repair > config_.max_repair_packets) {
+        n_repair = config_.max_repair_packets;
+    }
+
+    n_repair_packets_ = n_repair;
+    interleaving_depth_ = depth;
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/redundancy_controller.h
+//! @brief FEC redundancy controller.
+
+#ifndef ROC_FEC_REDUNDANCY_CONTROLLER_H_
+#define ROC_FEC_REDUNDANCY_CONTROLLER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/loss_runs.h"
+
+namespace roc {
+namespace fec {
+
+//! FEC redundancy controller parameters.
+struct RedundancyControllerConfig {
+    //! Minimum number of repair packets in block.
+    size_t min_repair_packets;
+
+    //! Maximum number of repair packets in block.
+    size_t max_repair_packets;
+
+    //! Maximum number of blocks to interleave.
+    //! @remarks
+    //!  If loss bursts are longer than max_repair_packets, controller
+    //!  suggests to interleave several blocks, so that every block loses
+    //!  a part of the burst. 1 disables interleaving.
+    size_t max_interleaving_depth;
+
+    //! How many times more repair packets to send than packets expected
+    //! to be lost in block.
+    float loss_margin;
+
+    //! How fast estimates go down when link becomes better.
+    //! @remarks
+    //!  On every report, estimate is moved by this fraction towards reported
+    //!  value. When reported value is higher than estimate, estimate is
+    //!  updated immediately.
+    float release_factor;
+
+    RedundancyControllerConfig()
+        : min_repair_packets(1)
+        , max_repair_packets(20)
+        , max_interleaving_depth(1)
+        , loss_margin(2)
+        , release_factor(0.1f) {
+    }
+};
+
+//! FEC redundancy controller.
+//! @remarks
+//!  Chooses number of repair packets per block based on loss reports from
+//!  receiver. Takes into account both average loss ratio and longest loss
+//!  burst, because block code can't repair block that lost more packets
+//!  than there are repair packets in it.
+//!
+//!  Number of source packets per block is kept fixed, because it defines
+//!  latency that receiver has to tolerate to repair a block.
+//!
+//!  When bursts are too long to be repaired within one block, controller
+//!  also chooses minimum interleaving depth that spreads the burst over
+//!  enough blocks, up to configured maximum.
+class RedundancyController : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p config defines adaptation parameters
+    //!  - @p n_source_packets is the number of source packets per block
+    //!  - @p n_repair_packets is the initial number of repair packets per block
+    RedundancyController(const RedundancyControllerConfig& config,
+                         size_t n_source_packets,
+                         size_t n_repair_packets);
+
+    //! Update estimates using a report from receiver.
+    //!
+    //! @b Parameters
+    //!  - @p fract_loss is the fraction of packets lost since previous report
+    //!  - @p loss_runs are the runs of received and lost packets since previous
+    //!    report; may be empty if receiver doesn't report them
+    void update(float fract_loss, const packet::LossRuns& loss_runs);
+
+    //! Get number of source packets per block.
+    size_t n_source_packets() const;
+
+    //! Get number of repair packets per block.
+    size_t n_repair_packets() const;
+
+    //! Get number of blocks to interleave.
+    size_t interleaving_depth() const;
+
+private:
+    void recompute_();
+
+    const RedundancyControllerConfig config_;
+
+    const size_t n_source_packets_;
+    size_t n_repair_packets_;
+    size_t interleaving_depth_;
+
+    float loss_estimate_;
+    float burst_estimate_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_REDUNDANCY_CONTROLLER_H_
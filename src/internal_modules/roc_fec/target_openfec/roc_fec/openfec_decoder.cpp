@@ -70,6 +70,8 @@ OpenfecDecoder::~OpenfecDecoder() {
     if (of_sess_) {
         destroy_session_();
     }
+
+    free_tabs_();
 }
 
 bool OpenfecDecoder::valid() const {
@@ -95,7 +97,6 @@ bool OpenfecDecoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
     max_index_ = 0;
 
     update_session_params_(sblen, rblen, payload_size);
-    reset_session_();
 
     return true;
 }
@@ -128,15 +129,6 @@ void OpenfecDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
     data_tab_[index] = buffer.data();
     recv_tab_[index] = true;
 
-    // register new packet and try to repair more packets
-    roc_log(LogTrace, "openfec decoder: of_decode_with_new_symbol(): index=%lu",
-            (unsigned long)index);
-
-    if (of_decode_with_new_symbol(of_sess_, data_tab_[index], (unsigned int)index)
-        != OF_STATUS_OK) {
-        roc_panic("openfec decoder: can't add packet to OF session");
-    }
-
     if (max_index_ < index) {
         max_index_ = index;
     }
@@ -154,11 +146,16 @@ core::Slice<uint8_t> OpenfecDecoder::repair(size_t index) {
 }
 
 void OpenfecDecoder::end() {
-    if (of_sess_ != NULL) {
+    if (status_.size() != 0) {
         report_();
+    }
+
+    if (of_sess_ != NULL) {
         destroy_session_();
     }
 
+    free_tabs_();
+
     reset_tabs_();
 
     has_new_packets_ = false;
@@ -181,6 +178,24 @@ void OpenfecDecoder::reset_tabs_() {
     }
 }
 
+void OpenfecDecoder::free_tabs_() {
+    // OpenFEC may allocate memory without calling source_cb_()
+    // we should free() such memory manually
+    for (size_t i = 0; i < sblen_; i++) {
+        if (data_tab_[i] == NULL) {
+            continue;
+        }
+        if (buff_tab_[i] && buff_tab_[i].data() == data_tab_[i]) {
+            continue;
+        }
+
+        roc_log(LogTrace, "openfec decoder: of_free(): index=%lu", (unsigned long)i);
+        of_free(data_tab_[i]);
+
+        data_tab_[i] = NULL;
+    }
+}
+
 bool OpenfecDecoder::resize_tabs_(size_t size) {
     if (!buff_tab_.resize(size)) {
         return false;
@@ -199,14 +214,16 @@ bool OpenfecDecoder::resize_tabs_(size_t size) {
 }
 
 void OpenfecDecoder::update_() {
-    roc_panic_if(of_sess_ == NULL);
-
     if (!has_new_packets_) {
         return;
     }
 
     decode_();
 
+    if (of_sess_ == NULL) {
+        return;
+    }
+
     roc_log(LogTrace, "openfec decoder: of_get_source_symbols_tab()");
 
     of_get_source_symbols_tab(of_sess_, &data_tab_[0]);
@@ -223,15 +240,14 @@ void OpenfecDecoder::decode_() {
         return;
     }
 
-    if (decoding_finished_) {
-        // it's not allowed to decode twice, so we recreate the session
-        reset_session_();
+    // session is created only when decoding is actually needed; it's not
+    // allowed to decode twice, so we recreate the session for every decoding
+    reset_session_();
 
-        roc_log(LogTrace, "openfec decoder: of_set_available_symbols()");
+    roc_log(LogTrace, "openfec decoder: of_set_available_symbols()");
 
-        if (of_set_available_symbols(of_sess_, &data_tab_[0]) != OF_STATUS_OK) {
-            roc_panic("openfec decoder: can't add packets to OF session");
-        }
+    if (of_set_available_symbols(of_sess_, &data_tab_[0]) != OF_STATUS_OK) {
+        roc_panic("openfec decoder: can't add packets to OF session");
     }
 
     // try to repair more packets
@@ -312,22 +328,6 @@ void OpenfecDecoder::destroy_session_() {
 
     of_release_codec_instance(of_sess_);
     of_sess_ = NULL;
-
-    // OpenFEC may allocate memory without calling source_cb_()
-    // we should free() such memory manually
-    for (size_t i = 0; i < sblen_; i++) {
-        if (data_tab_[i] == NULL) {
-            continue;
-        }
-        if (buff_tab_[i] && buff_tab_[i].data() == data_tab_[i]) {
-            continue;
-        }
-
-        roc_log(LogTrace, "openfec decoder: of_free(): index=%lu", (unsigned long)i);
-        of_free(data_tab_[i]);
-
-        data_tab_[i] = NULL;
-    }
 }
 
 void OpenfecDecoder::report_() {
@@ -76,6 +76,7 @@ private:
     void update_session_params_(size_t sblen, size_t rblen, size_t payload_size);
 
     void reset_tabs_();
+    void free_tabs_();
     bool resize_tabs_(size_t size);
 
     void update_();
@@ -106,7 +107,10 @@ private:
         of_ldpc_parameters ldpc_params_;
     } codec_params_;
 
-    // session is recreated for every new block
+    // session is created lazily, when source packets have to be repaired,
+    // so blocks and block restarts that don't need decoding don't create it;
+    // unlike encoder, decoder can't reuse sessions, because OpenFEC keeps
+    // decoding state in session and provides no way to reset it
     of_session_t* of_sess_;
     of_parameters_t* of_sess_params_;
 
@@ -19,7 +19,8 @@ OpenfecEncoder::OpenfecEncoder(const CodecConfig& config,
     : sblen_(0)
     , rblen_(0)
     , payload_size_(0)
-    , of_sess_(NULL)
+    , cur_sess_(NULL)
+    , use_counter_(0)
     , buff_tab_(allocator)
     , data_tab_(allocator)
     , valid_(false) {
@@ -54,8 +55,10 @@ OpenfecEncoder::OpenfecEncoder(const CodecConfig& config,
 }
 
 OpenfecEncoder::~OpenfecEncoder() {
-    if (of_sess_) {
-        of_release_codec_instance(of_sess_);
+    for (size_t n = 0; n < MaxSessions; n++) {
+        if (sessions_[n].of_sess) {
+            release_session_(sessions_[n]);
+        }
     }
 }
 
@@ -76,7 +79,11 @@ size_t OpenfecEncoder::max_block_length() const {
 bool OpenfecEncoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
     roc_panic_if_not(valid());
 
-    if (sblen_ == sblen && rblen_ == rblen && payload_size_ == payload_size) {
+    use_counter_++;
+
+    if (cur_sess_ && sblen_ == sblen && rblen_ == rblen
+        && payload_size_ == payload_size) {
+        cur_sess_->last_used = use_counter_;
         return true;
     }
 
@@ -88,8 +95,12 @@ bool OpenfecEncoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
     rblen_ = rblen;
     payload_size_ = payload_size;
 
-    update_session_params_(sblen, rblen, payload_size);
-    reset_session_();
+    cur_sess_ = find_session_(sblen, rblen, payload_size);
+    if (!cur_sess_) {
+        cur_sess_ = create_session_(sblen, rblen, payload_size);
+    }
+
+    cur_sess_->last_used = use_counter_;
 
     return true;
 }
@@ -122,13 +133,14 @@ void OpenfecEncoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
 
 void OpenfecEncoder::fill() {
     roc_panic_if_not(valid());
+    roc_panic_if_not(cur_sess_);
 
     for (size_t i = sblen_; i < sblen_ + rblen_; ++i) {
         roc_log(LogTrace, "openfec encoder: of_build_repair_symbol(): index=%lu",
                 (unsigned long)i);
 
         if (OF_STATUS_OK
-            != of_build_repair_symbol(of_sess_, &data_tab_[0], (uint32_t)i)) {
+            != of_build_repair_symbol(cur_sess_->of_sess, &data_tab_[0], (uint32_t)i)) {
             roc_panic("openfec encoder: of_build_repair_symbol() failed");
         }
     }
@@ -163,21 +175,51 @@ void OpenfecEncoder::update_session_params_(size_t sblen,
     of_sess_params_->encoding_symbol_length = (uint32_t)payload_size;
 }
 
-void OpenfecEncoder::reset_session_() {
-    if (of_sess_ != NULL) {
-        roc_log(LogTrace, "openfec encoder: of_release_codec_instance()");
+OpenfecEncoder::Session*
+OpenfecEncoder::find_session_(size_t sblen, size_t rblen, size_t payload_size) {
+    for (size_t n = 0; n < MaxSessions; n++) {
+        Session& session = sessions_[n];
+
+        if (session.of_sess && session.sblen == sblen && session.rblen == rblen
+            && session.payload_size == payload_size) {
+            return &session;
+        }
+    }
+
+    return NULL;
+}
+
+OpenfecEncoder::Session*
+OpenfecEncoder::create_session_(size_t sblen, size_t rblen, size_t payload_size) {
+    Session* session = NULL;
+
+    // take free slot or evict least recently used session
+    for (size_t n = 0; n < MaxSessions; n++) {
+        if (!sessions_[n].of_sess) {
+            session = &sessions_[n];
+            break;
+        }
+        if (!session || sessions_[n].last_used < session->last_used) {
+            session = &sessions_[n];
+        }
+    }
 
-        of_release_codec_instance(of_sess_);
-        of_sess_ = NULL;
+    roc_panic_if(!session);
+
+    if (session->of_sess) {
+        release_session_(*session);
     }
 
+    update_session_params_(sblen, rblen, payload_size);
+
     roc_log(LogTrace, "openfec encoder: of_create_codec_instance()");
 
-    if (OF_STATUS_OK != of_create_codec_instance(&of_sess_, codec_id_, OF_ENCODER, 0)) {
+    if (OF_STATUS_OK
+        != of_create_codec_instance(&session->of_sess, codec_id_, OF_ENCODER, 0)) {
         roc_panic("openfec encoder: of_create_codec_instance() failed");
     }
 
-    roc_panic_if(of_sess_ == NULL);
+    roc_panic_if(session->of_sess == NULL);
 
     roc_log(
         LogTrace,
@@ -186,9 +228,27 @@ void OpenfecEncoder::reset_session_() {
         (unsigned long)of_sess_params_->nb_repair_symbols,
         (unsigned long)of_sess_params_->encoding_symbol_length);
 
-    if (OF_STATUS_OK != of_set_fec_parameters(of_sess_, of_sess_params_)) {
+    if (OF_STATUS_OK != of_set_fec_parameters(session->of_sess, of_sess_params_)) {
         roc_panic("openfec encoder: of_set_fec_parameters() failed");
     }
+
+    session->sblen = sblen;
+    session->rblen = rblen;
+    session->payload_size = payload_size;
+
+    return session;
+}
+
+void OpenfecEncoder::release_session_(Session& session) {
+    roc_log(LogTrace,
+            "openfec encoder: of_release_codec_instance(): nb_src=%lu nb_rpr=%lu"
+            " symbol_len=%lu",
+            (unsigned long)session.sblen, (unsigned long)session.rblen,
+            (unsigned long)session.payload_size);
+
+    of_release_codec_instance(session.of_sess);
+
+    session = Session();
 }
 
 } // namespace fec
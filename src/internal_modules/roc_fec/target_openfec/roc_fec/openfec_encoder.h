@@ -76,18 +76,51 @@ public:
     virtual void end();
 
 private:
-    bool resize_tabs_(size_t size);
-    void reset_session_();
-    void update_session_params_(size_t sblen, size_t rblen, size_t payload_size);
+    // Maximum number of cached codec sessions.
+    enum { MaxSessions = 4 };
 
     enum { Alignment = 8 };
 
+    // Codec session for specific block parameters.
+    struct Session {
+        of_session_t* of_sess;
+
+        size_t sblen;
+        size_t rblen;
+        size_t payload_size;
+
+        // value of use_counter_ when session was used last time
+        size_t last_used;
+
+        Session()
+            : of_sess(NULL)
+            , sblen(0)
+            , rblen(0)
+            , payload_size(0)
+            , last_used(0) {
+        }
+    };
+
+    bool resize_tabs_(size_t size);
+
+    Session* find_session_(size_t sblen, size_t rblen, size_t payload_size);
+    Session* create_session_(size_t sblen, size_t rblen, size_t payload_size);
+    void release_session_(Session& session);
+
+    void update_session_params_(size_t sblen, size_t rblen, size_t payload_size);
+
     size_t sblen_;
     size_t rblen_;
 
     size_t payload_size_;
 
-    of_session_t* of_sess_;
+    // sessions are cached and reused when block parameters are unchanged,
+    // because creating a session is expensive, e.g. for LDPC-Staircase it
+    // builds parity check matrix; least recently used session is evicted
+    Session sessions_[MaxSessions];
+    Session* cur_sess_;
+    size_t use_counter_;
+
     of_parameters_t* of_sess_params_;
 
     of_codec_id_t codec_id_;
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/xor_ops.h
+//! @brief Payload XOR operations.
+
+#ifndef ROC_FEC_XOR_OPS_H_
+#define ROC_FEC_XOR_OPS_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! Payload XOR operations.
+//! @remarks
+//!  Payloads are processed in 64-byte chunks of machine words, which
+//!  compilers turn into SIMD instructions available on target (SSE2,
+//!  AVX2, NEON). Buffers are expected to be word-aligned, otherwise a
+//!  slower byte-wise loop is used.
+class XorOps {
+public:
+    //! Word alignment required for fast path.
+    enum { Alignment = sizeof(uint64_t) };
+
+    //! XOR @p src into @p dst.
+    static inline void xor_to(uint8_t* dst, const uint8_t* src, size_t size) {
+        size_t pos = 0;
+
+        if ((((uintptr_t)dst | (uintptr_t)src) % Alignment) == 0) {
+            uint64_t* dst_w = (uint64_t*)dst;
+            const uint64_t* src_w = (const uint64_t*)src;
+
+            const size_t n_chunks = size / ChunkSize;
+
+            for (size_t n = 0; n < n_chunks; n++) {
+                dst_w[0] ^= src_w[0];
+                dst_w[1] ^= src_w[1];
+                dst_w[2] ^= src_w[2];
+                dst_w[3] ^= src_w[3];
+                dst_w[4] ^= src_w[4];
+                dst_w[5] ^= src_w[5];
+                dst_w[6] ^= src_w[6];
+                dst_w[7] ^= src_w[7];
+
+                dst_w += ChunkWords;
+                src_w += ChunkWords;
+            }
+
+            pos = n_chunks * ChunkSize;
+
+            for (; pos + Alignment <= size; pos += Alignment) {
+                *dst_w++ ^= *src_w++;
+            }
+        }
+
+        for (; pos < size; pos++) {
+            dst[pos] ^= src[pos];
+        }
+    }
+
+private:
+    enum { ChunkWords = 8, ChunkSize = ChunkWords * sizeof(uint64_t) };
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_XOR_OPS_H_
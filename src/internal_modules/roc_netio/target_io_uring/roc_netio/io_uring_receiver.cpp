@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#include "roc_core/atomic_ops.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/memory_map.h"
+#include "roc_core/panic.h"
+#include "roc_netio/io_uring_receiver.h"
+
+namespace roc {
+namespace netio {
+
+IoUringReceiver::IoUringReceiver(core::BufferFactory<uint8_t>& buffer_factory)
+    : ring_(NumBuffers)
+    , buffer_factory_(buffer_factory)
+    , buf_ring_(NULL)
+    , buf_ring_size_(0)
+    , buf_ring_tail_(0)
+    , buf_ring_registered_(false)
+    , fd_(-1)
+    , armed_(false)
+    , failed_(false)
+    , n_received_(0)
+    , valid_(false) {
+    memset(&msg_, 0, sizeof(msg_));
+    msg_.msg_namelen = sizeof(sockaddr_in6);
+    msg_.msg_controllen = CMSG_SPACE(sizeof(timespec));
+
+    if (!ring_.valid()) {
+        return;
+    }
+
+    const size_t header_size =
+        sizeof(io_uring_recvmsg_out) + msg_.msg_namelen + msg_.msg_controllen;
+
+    if (buffer_factory_.buffer_size() <= header_size) {
+        roc_log(LogError,
+                "io_uring receiver: buffer size is too small:"
+                " buffer_size=%lu header_size=%lu",
+                (unsigned long)buffer_factory_.buffer_size(),
+                (unsigned long)header_size);
+        return;
+    }
+
+    if (!alloc_buffers_()) {
+        return;
+    }
+
+    valid_ = true;
+}
+
+IoUringReceiver::~IoUringReceiver() {
+    stop();
+    free_buffers_();
+}
+
+bool IoUringReceiver::valid() const {
+    return valid_;
+}
+
+int IoUringReceiver::event_fd() const {
+    roc_panic_if(!valid_);
+
+    return ring_.event_fd();
+}
+
+void IoUringReceiver::clear_event() {
+    roc_panic_if(!valid_);
+
+    ring_.clear_event();
+}
+
+bool IoUringReceiver::start(int fd) {
+    roc_panic_if(!valid_);
+    roc_panic_if(fd < 0);
+
+    if (fd_ >= 0) {
+        roc_panic("io_uring receiver: can't call start() twice");
+    }
+
+    fd_ = fd;
+
+    return arm_();
+}
+
+IoUringReceiver::FetchStatus IoUringReceiver::fetch(IoUringDatagram& datagram) {
+    roc_panic_if(!valid_);
+
+    io_uring_cqe cqe;
+
+    while (!failed_ && ring_.next_cqe(cqe)) {
+        if (cqe.user_data != Tag_Recv) {
+            continue;
+        }
+        if (handle_recv_(cqe, datagram) == Fetch_Datagram) {
+            return Fetch_Datagram;
+        }
+    }
+
+    return failed_ ? Fetch_Error : Fetch_Empty;
+}
+
+void IoUringReceiver::stop() {
+    if (!armed_) {
+        return;
+    }
+
+    io_uring_sqe* sqe = ring_.get_sqe();
+    roc_panic_if_msg(!sqe, "io_uring receiver: submission queue is full");
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->addr = Tag_Recv;
+    sqe->user_data = Tag_Cancel;
+
+    // wait until kernel posts final completion for receive request, after
+    // that it won't touch buffers anymore; datagrams still in completion
+    // queue are dropped
+    bool cancelled = false;
+
+    while (armed_ || !cancelled) {
+        if (!ring_.submit_and_wait()) {
+            roc_log(LogError, "io_uring receiver: can't cancel receive request");
+            break;
+        }
+
+        io_uring_cqe cqe;
+        while (ring_.next_cqe(cqe)) {
+            if (cqe.user_data == Tag_Cancel) {
+                cancelled = true;
+            } else if (cqe.user_data == Tag_Recv && !(cqe.flags & IORING_CQE_F_MORE)) {
+                armed_ = false;
+            }
+        }
+    }
+
+    roc_log(LogDebug, "io_uring receiver: stopped receiving: n_received=%lu",
+            (unsigned long)n_received_);
+}
+
+bool IoUringReceiver::alloc_buffers_() {
+    const size_t page_size = core::memory_page_size();
+
+    buf_ring_size_ =
+        (NumBuffers * sizeof(io_uring_buf) + page_size - 1) / page_size * page_size;
+
+    if (!(buf_ring_ = (io_uring_buf*)core::memory_map(buf_ring_size_, false))) {
+        roc_log(LogError, "io_uring receiver: can't allocate buffer ring");
+        return false;
+    }
+
+    if (!ring_.register_buffer_ring(buf_ring_, NumBuffers, BufferGroup)) {
+        return false;
+    }
+    buf_ring_registered_ = true;
+
+    if (!buffers_.resize(NumBuffers)) {
+        roc_log(LogError, "io_uring receiver: can't allocate buffer table");
+        return false;
+    }
+
+    for (uint16_t buffer_id = 0; buffer_id < NumBuffers; buffer_id++) {
+        if (!(buffers_[buffer_id] = buffer_factory_.new_buffer())) {
+            roc_log(LogError, "io_uring receiver: can't allocate buffer");
+            return false;
+        }
+        add_buffer_(buffer_id);
+    }
+
+    commit_buffers_();
+
+    return true;
+}
+
+void IoUringReceiver::free_buffers_() {
+    if (buf_ring_registered_) {
+        ring_.unregister_buffer_ring(BufferGroup);
+        buf_ring_registered_ = false;
+    }
+
+    if (buf_ring_) {
+        core::memory_unmap(buf_ring_, buf_ring_size_);
+        buf_ring_ = NULL;
+    }
+
+    if (!buffers_.resize(0)) {
+        roc_panic("io_uring receiver: can't free buffer table");
+    }
+}
+
+void IoUringReceiver::add_buffer_(uint16_t buffer_id) {
+    core::Buffer<uint8_t>& buffer = *buffers_[buffer_id];
+
+    io_uring_buf& buf = buf_ring_[buf_ring_tail_ & (NumBuffers - 1)];
+
+    buf.addr = (uint64_t)(uintptr_t)buffer.data();
+    buf.len = (uint32_t)buffer.size();
+    buf.bid = buffer_id;
+
+    buf_ring_tail_++;
+}
+
+void IoUringReceiver::commit_buffers_() {
+    // ring tail overlays reserved field of first entry
+    core::AtomicOps::store_release(buf_ring_[0].resv, buf_ring_tail_);
+}
+
+bool IoUringReceiver::arm_() {
+    io_uring_sqe* sqe = ring_.get_sqe();
+    if (!sqe) {
+        roc_log(LogError, "io_uring receiver: submission queue is full");
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = fd_;
+    sqe->addr = (uint64_t)(uintptr_t)&msg_;
+    sqe->len = 1;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BufferGroup;
+    sqe->user_data = Tag_Recv;
+
+    if (!ring_.submit()) {
+        return false;
+    }
+
+    armed_ = true;
+
+    return true;
+}
+
+IoUringReceiver::FetchStatus IoUringReceiver::handle_recv_(const io_uring_cqe& cqe,
+                                                           IoUringDatagram& datagram) {
+    bool fetched = false;
+
+    if (!(cqe.flags & IORING_CQE_F_MORE)) {
+        // request finished, e.g. because buffer ring was exhausted or
+        // because of an error; it should be re-submitted
+        armed_ = false;
+    }
+
+    if (cqe.res < 0) {
+        if ((cqe.res == -EINVAL || cqe.res == -EOPNOTSUPP) && n_received_ == 0) {
+            roc_log(LogDebug, "io_uring receiver: multishot recvmsg not supported");
+            failed_ = true;
+            return Fetch_Error;
+        }
+        if (cqe.res == -ENOBUFS) {
+            roc_log(LogDebug, "io_uring receiver: buffer ring exhausted");
+        } else {
+            roc_log(LogError, "io_uring receiver: recvmsg(): %s",
+                    core::errno_to_str(-cqe.res).c_str());
+        }
+    } else if (cqe.flags & IORING_CQE_F_BUFFER) {
+        const uint16_t buffer_id = uint16_t(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        roc_panic_if(buffer_id >= NumBuffers);
+
+        const FetchStatus status = parse_(buffer_id, (size_t)cqe.res, datagram);
+
+        if (status == Fetch_Datagram) {
+            // hand out filled buffer and put a new one into ring instead;
+            // if allocation fails, datagram is dropped and buffer is reused
+            core::SharedPtr<core::Buffer<uint8_t> > buffer =
+                buffer_factory_.new_buffer();
+            if (buffer) {
+                buffers_[buffer_id] = buffer;
+                fetched = true;
+                n_received_++;
+            } else {
+                roc_log(LogError, "io_uring receiver: can't allocate buffer");
+                datagram.data = core::Slice<uint8_t>();
+            }
+        }
+
+        add_buffer_(buffer_id);
+        commit_buffers_();
+
+        if (status == Fetch_Error) {
+            failed_ = true;
+            return Fetch_Error;
+        }
+    }
+
+    if (!armed_ && !arm_()) {
+        failed_ = true;
+        return Fetch_Error;
+    }
+
+    return fetched ? Fetch_Datagram : Fetch_Empty;
+}
+
+IoUringReceiver::FetchStatus
+IoUringReceiver::parse_(uint16_t buffer_id, size_t size, IoUringDatagram& datagram) {
+    core::Buffer<uint8_t>& buffer = *buffers_[buffer_id];
+
+    // buffer layout: recvmsg header, space reserved for sender address,
+    // space reserved for control messages, payload
+    const io_uring_recvmsg_out* out = (const io_uring_recvmsg_out*)buffer.data();
+
+    const size_t name_off = sizeof(io_uring_recvmsg_out);
+    const size_t control_off = name_off + msg_.msg_namelen;
+    const size_t payload_off = control_off + msg_.msg_controllen;
+
+    if (size < payload_off || size - payload_off < out->payloadlen) {
+        roc_log(LogError, "io_uring receiver: unexpected completion size: size=%lu",
+                (unsigned long)size);
+        return Fetch_Empty;
+    }
+
+    if (out->flags & MSG_TRUNC) {
+        // kernel reports only truncated length, so there is no way to tell
+        // if datagram would fit into buffer without header; give up and let
+        // caller switch to receiving into whole buffer
+        roc_log(LogDebug,
+                "io_uring receiver: got truncated datagram: max_payload_size=%lu",
+                (unsigned long)(buffer.size() - payload_off));
+        return Fetch_Error;
+    }
+
+    if (out->namelen > msg_.msg_namelen
+        || !datagram.src_addr.set_host_port_saddr(
+            (const sockaddr*)(buffer.data() + name_off))) {
+        roc_log(LogError, "io_uring receiver: can't determine source address");
+        return Fetch_Empty;
+    }
+
+    datagram.timestamp = 0;
+
+    if (out->controllen != 0) {
+        msghdr control;
+        memset(&control, 0, sizeof(control));
+
+        control.msg_control = buffer.data() + control_off;
+        control.msg_controllen =
+            out->controllen < msg_.msg_controllen ? out->controllen : msg_.msg_controllen;
+
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&control); cmsg;
+             cmsg = CMSG_NXTHDR(&control, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                timespec ts;
+                memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                datagram.timestamp =
+                    core::nanoseconds_t(ts.tv_sec) * core::Second + ts.tv_nsec;
+            }
+        }
+    }
+
+    datagram.data =
+        core::Slice<uint8_t>(buffer, payload_off, payload_off + out->payloadlen);
+
+    return Fetch_Datagram;
+}
+
+} // namespace netio
+} // namespace roc
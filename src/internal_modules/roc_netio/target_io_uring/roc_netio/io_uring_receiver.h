@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_io_uring/roc_netio/io_uring_receiver.h
+//! @brief Datagram receiver based on io_uring.
+
+#ifndef ROC_NETIO_IO_URING_RECEIVER_H_
+#define ROC_NETIO_IO_URING_RECEIVER_H_
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/array.h"
+#include "roc_core/buffer.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_core/time.h"
+#include "roc_netio/io_uring_ring.h"
+
+namespace roc {
+namespace netio {
+
+//! Datagram received by IoUringReceiver.
+struct IoUringDatagram {
+    //! Datagram payload.
+    core::Slice<uint8_t> data;
+
+    //! Sender address.
+    address::SocketAddr src_addr;
+
+    //! Kernel receive timestamp, nanoseconds since Unix epoch.
+    //! Zero if not available.
+    core::nanoseconds_t timestamp;
+
+    IoUringDatagram()
+        : timestamp(0) {
+    }
+};
+
+//! Datagram receiver based on io_uring.
+//! @remarks
+//!  Uses single multishot recvmsg request with provided buffer ring, so that
+//!  kernel picks a buffer and posts a completion for every datagram without
+//!  a separate submission. Buffers in the ring are allocated from buffer
+//!  factory; when datagram is fetched, its buffer is handed out as payload
+//!  and replaced in the ring with a new one, so there is no copying.
+//!
+//!  Every buffer holds recvmsg header, sender address, and control message
+//!  with kernel timestamp before the payload, so maximum payload size is
+//!  slightly less than buffer size. Datagram that doesn't fit is dropped and
+//!  receiving fails, so that the caller can fall back to regular receiving.
+//!
+//!  Requires Linux 6.0 or later. Not thread-safe.
+class IoUringReceiver : public core::NonCopyable<> {
+public:
+    //! Fetch status.
+    enum FetchStatus {
+        //! Datagram was fetched.
+        Fetch_Datagram,
+
+        //! No more datagrams for now.
+        Fetch_Empty,
+
+        //! Receiving failed and can't be resumed.
+        Fetch_Error
+    };
+
+    //! Initialize.
+    explicit IoUringReceiver(core::BufferFactory<uint8_t>& buffer_factory);
+
+    ~IoUringReceiver();
+
+    //! Check if ring and buffers were successfully created.
+    bool valid() const;
+
+    //! Get eventfd that becomes readable when datagrams are received.
+    int event_fd() const;
+
+    //! Reset eventfd before fetching datagrams.
+    void clear_event();
+
+    //! Start receiving datagrams from socket.
+    bool start(int fd);
+
+    //! Fetch next received datagram.
+    //! @remarks
+    //!  Should be called until it returns Fetch_Empty after every wakeup.
+    //!  Returns Fetch_Error if multishot recvmsg isn't supported or if
+    //!  received datagram was truncated.
+    FetchStatus fetch(IoUringDatagram& datagram);
+
+    //! Stop receiving datagrams.
+    //! @remarks
+    //!  Cancels receive request and blocks until kernel releases buffers.
+    void stop();
+
+private:
+    enum { NumBuffers = 64, BufferGroup = 0 };
+
+    enum { Tag_Recv = 1, Tag_Cancel = 2 };
+
+    bool alloc_buffers_();
+    void free_buffers_();
+
+    void add_buffer_(uint16_t buffer_id);
+    void commit_buffers_();
+
+    bool arm_();
+    FetchStatus handle_recv_(const io_uring_cqe& cqe, IoUringDatagram& datagram);
+    FetchStatus parse_(uint16_t buffer_id, size_t size, IoUringDatagram& datagram);
+
+    IoUringRing ring_;
+
+    core::BufferFactory<uint8_t>& buffer_factory_;
+
+    // buffers owned by kernel, indexed by buffer id
+    core::Array<core::SharedPtr<core::Buffer<uint8_t> >, NumBuffers> buffers_;
+
+    // ring of provided buffers shared with kernel; io_uring_buf_ring isn't
+    // used because in C++ its flexible array member gets wrong offset
+    io_uring_buf* buf_ring_;
+    size_t buf_ring_size_;
+    uint16_t buf_ring_tail_;
+    bool buf_ring_registered_;
+
+    // template for multishot recvmsg, defines space reserved in every
+    // buffer for sender address and control messages
+    msghdr msg_;
+
+    int fd_;
+    bool armed_;
+    bool failed_;
+
+    size_t n_received_;
+
+    bool valid_;
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_IO_URING_RECEIVER_H_
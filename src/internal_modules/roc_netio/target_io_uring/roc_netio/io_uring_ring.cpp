@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "roc_core/atomic_ops.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_netio/io_uring_ring.h"
+
+namespace roc {
+namespace netio {
+
+namespace {
+
+int sys_io_uring_setup(unsigned entries, io_uring_params* params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+int sys_io_uring_enter(int fd,
+                       unsigned to_submit,
+                       unsigned min_complete,
+                       unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+int sys_io_uring_register(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+template <class T> T* ring_ptr(void* ring, unsigned offset) {
+    return (T*)((char*)ring + offset);
+}
+
+} // namespace
+
+IoUringRing::IoUringRing(size_t n_entries)
+    : ring_fd_(-1)
+    , event_fd_(-1)
+    , sq_ring_(NULL)
+    , sq_ring_size_(0)
+    , cq_ring_(NULL)
+    , cq_ring_size_(0)
+    , sqes_(NULL)
+    , sqes_size_(0)
+    , sq_head_(NULL)
+    , sq_tail_(NULL)
+    , sq_array_(NULL)
+    , sq_mask_(0)
+    , sq_entries_(0)
+    , cq_head_(NULL)
+    , cq_tail_(NULL)
+    , cqes_(NULL)
+    , cq_mask_(0)
+    , sqe_tail_(0)
+    , n_pending_(0)
+    , valid_(false) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    if ((ring_fd_ = sys_io_uring_setup((unsigned)n_entries, &params)) < 0) {
+        roc_log(LogDebug, "io_uring: io_uring_setup(): %s",
+                core::errno_to_str(errno).c_str());
+        return;
+    }
+
+    if (!map_rings_(params)) {
+        return;
+    }
+
+    if (!register_event_fd_()) {
+        return;
+    }
+
+    roc_log(LogDebug, "io_uring: created ring: sq_entries=%u cq_entries=%u features=0x%x",
+            params.sq_entries, params.cq_entries, params.features);
+
+    valid_ = true;
+}
+
+IoUringRing::~IoUringRing() {
+    if (event_fd_ >= 0) {
+        if (close(event_fd_) != 0) {
+            roc_log(LogError, "io_uring: close(eventfd): %s",
+                    core::errno_to_str(errno).c_str());
+        }
+    }
+
+    unmap_rings_();
+
+    if (ring_fd_ >= 0) {
+        if (close(ring_fd_) != 0) {
+            roc_log(LogError, "io_uring: close(ring): %s",
+                    core::errno_to_str(errno).c_str());
+        }
+    }
+}
+
+bool IoUringRing::valid() const {
+    return valid_;
+}
+
+int IoUringRing::event_fd() const {
+    roc_panic_if(!valid_);
+
+    return event_fd_;
+}
+
+void IoUringRing::clear_event() {
+    roc_panic_if(!valid_);
+
+    uint64_t value = 0;
+    if (read(event_fd_, &value, sizeof(value)) < 0 && errno != EAGAIN
+        && errno != EINTR) {
+        roc_log(LogError, "io_uring: read(eventfd): %s",
+                core::errno_to_str(errno).c_str());
+    }
+}
+
+io_uring_sqe* IoUringRing::get_sqe() {
+    roc_panic_if(!valid_);
+
+    const unsigned head = core::AtomicOps::load_acquire(*sq_head_);
+
+    if (sqe_tail_ - head >= sq_entries_) {
+        return NULL;
+    }
+
+    const unsigned index = sqe_tail_ & sq_mask_;
+
+    io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+
+    sq_array_[index] = index;
+
+    sqe_tail_++;
+    n_pending_++;
+
+    return sqe;
+}
+
+bool IoUringRing::submit() {
+    roc_panic_if(!valid_);
+
+    if (n_pending_ == 0) {
+        return true;
+    }
+
+    core::AtomicOps::store_release(*sq_tail_, sqe_tail_);
+
+    for (;;) {
+        const int ret = sys_io_uring_enter(ring_fd_, n_pending_, 0, 0);
+        if (ret >= 0) {
+            n_pending_ -= (unsigned)ret;
+            return true;
+        }
+        if (errno != EINTR) {
+            roc_log(LogError, "io_uring: io_uring_enter(): %s",
+                    core::errno_to_str(errno).c_str());
+            return false;
+        }
+    }
+}
+
+bool IoUringRing::submit_and_wait() {
+    roc_panic_if(!valid_);
+
+    core::AtomicOps::store_release(*sq_tail_, sqe_tail_);
+
+    for (;;) {
+        const int ret =
+            sys_io_uring_enter(ring_fd_, n_pending_, 1, IORING_ENTER_GETEVENTS);
+        if (ret >= 0) {
+            n_pending_ -= (unsigned)ret;
+            return true;
+        }
+        if (errno != EINTR) {
+            roc_log(LogError, "io_uring: io_uring_enter(): %s",
+                    core::errno_to_str(errno).c_str());
+            return false;
+        }
+    }
+}
+
+bool IoUringRing::next_cqe(io_uring_cqe& cqe) {
+    roc_panic_if(!valid_);
+
+    const unsigned head = *cq_head_;
+    const unsigned tail = core::AtomicOps::load_acquire(*cq_tail_);
+
+    if (head == tail) {
+        return false;
+    }
+
+    cqe = cqes_[head & cq_mask_];
+
+    core::AtomicOps::store_release(*cq_head_, head + 1);
+
+    return true;
+}
+
+bool IoUringRing::register_buffer_ring(void* ring_addr,
+                                       size_t n_entries,
+                                       uint16_t group_id) {
+    roc_panic_if(!valid_);
+
+    io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+
+    reg.ring_addr = (uint64_t)(uintptr_t)ring_addr;
+    reg.ring_entries = (uint32_t)n_entries;
+    reg.bgid = group_id;
+
+    if (sys_io_uring_register(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) != 0) {
+        roc_log(LogDebug, "io_uring: can't register buffer ring: %s",
+                core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void IoUringRing::unregister_buffer_ring(uint16_t group_id) {
+    roc_panic_if(!valid_);
+
+    io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+
+    reg.bgid = group_id;
+
+    if (sys_io_uring_register(ring_fd_, IORING_UNREGISTER_PBUF_RING, &reg, 1) != 0) {
+        roc_log(LogError, "io_uring: can't unregister buffer ring: %s",
+                core::errno_to_str(errno).c_str());
+    }
+}
+
+bool IoUringRing::map_rings_(const io_uring_params& params) {
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+
+    // since 5.4, both rings may be mapped with a single call
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP);
+    if (single_mmap) {
+        if (cq_ring_size_ > sq_ring_size_) {
+            sq_ring_size_ = cq_ring_size_;
+        }
+        cq_ring_size_ = sq_ring_size_;
+    }
+
+    void* sq_ring = mmap(NULL, sq_ring_size_, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_ring == MAP_FAILED) {
+        roc_log(LogError, "io_uring: mmap(sq): %s", core::errno_to_str(errno).c_str());
+        return false;
+    }
+    sq_ring_ = sq_ring;
+
+    if (single_mmap) {
+        cq_ring_ = sq_ring_;
+    } else {
+        void* cq_ring = mmap(NULL, cq_ring_size_, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED) {
+            roc_log(LogError, "io_uring: mmap(cq): %s",
+                    core::errno_to_str(errno).c_str());
+            return false;
+        }
+        cq_ring_ = cq_ring;
+    }
+
+    void* sqes = mmap(NULL, sqes_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        roc_log(LogError, "io_uring: mmap(sqes): %s", core::errno_to_str(errno).c_str());
+        return false;
+    }
+    sqes_ = (io_uring_sqe*)sqes;
+
+    sq_head_ = ring_ptr<unsigned>(sq_ring_, params.sq_off.head);
+    sq_tail_ = ring_ptr<unsigned>(sq_ring_, params.sq_off.tail);
+    sq_array_ = ring_ptr<unsigned>(sq_ring_, params.sq_off.array);
+    sq_mask_ = *ring_ptr<unsigned>(sq_ring_, params.sq_off.ring_mask);
+    sq_entries_ = *ring_ptr<unsigned>(sq_ring_, params.sq_off.ring_entries);
+
+    cq_head_ = ring_ptr<unsigned>(cq_ring_, params.cq_off.head);
+    cq_tail_ = ring_ptr<unsigned>(cq_ring_, params.cq_off.tail);
+    cqes_ = ring_ptr<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+    cq_mask_ = *ring_ptr<unsigned>(cq_ring_, params.cq_off.ring_mask);
+
+    sqe_tail_ = *sq_tail_;
+
+    return true;
+}
+
+void IoUringRing::unmap_rings_() {
+    if (sqes_) {
+        munmap(sqes_, sqes_size_);
+        sqes_ = NULL;
+    }
+
+    if (cq_ring_ && cq_ring_ != sq_ring_) {
+        munmap(cq_ring_, cq_ring_size_);
+    }
+    cq_ring_ = NULL;
+
+    if (sq_ring_) {
+        munmap(sq_ring_, sq_ring_size_);
+        sq_ring_ = NULL;
+    }
+}
+
+bool IoUringRing::register_event_fd_() {
+    if ((event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0) {
+        roc_log(LogError, "io_uring: eventfd(): %s", core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    if (sys_io_uring_register(ring_fd_, IORING_REGISTER_EVENTFD, &event_fd_, 1) != 0) {
+        roc_log(LogError, "io_uring: can't register eventfd: %s",
+                core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace netio
+} // namespace roc
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_io_uring/roc_netio/io_uring_ring.h
+//! @brief io_uring submission and completion queues.
+
+#ifndef ROC_NETIO_IO_URING_RING_H_
+#define ROC_NETIO_IO_URING_RING_H_
+
+#include <linux/io_uring.h>
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace netio {
+
+//! io_uring submission and completion queues.
+//! @remarks
+//!  Thin wrapper for io_uring system calls, so that we don't depend on
+//!  liburing. Ring is not thread-safe and should be used from one thread.
+//!
+//!  Ring has an eventfd registered, which becomes readable when completions
+//!  are posted. It allows to drive the ring from another event loop: poll
+//!  eventfd, then call clear_event() and drain completions by next_cqe().
+class IoUringRing : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p n_entries is number of submission queue entries; kernel rounds it
+    //!  up to power of two and allocates twice larger completion queue.
+    explicit IoUringRing(size_t n_entries);
+
+    ~IoUringRing();
+
+    //! Check if ring was successfully created.
+    //! @remarks
+    //!  May be false if kernel doesn't support io_uring or it's forbidden.
+    bool valid() const;
+
+    //! Get eventfd that becomes readable when completions are posted.
+    int event_fd() const;
+
+    //! Reset eventfd counter.
+    void clear_event();
+
+    //! Get free submission queue entry.
+    //! @remarks
+    //!  Returned entry is zeroed; it's passed to kernel by next submit().
+    //! @returns
+    //!  NULL if submission queue is full.
+    io_uring_sqe* get_sqe();
+
+    //! Pass prepared submission queue entries to kernel.
+    bool submit();
+
+    //! Pass prepared entries to kernel and block until there is a completion.
+    bool submit_and_wait();
+
+    //! Fetch next completion queue entry.
+    //! @returns
+    //!  false if completion queue is empty.
+    bool next_cqe(io_uring_cqe& cqe);
+
+    //! Register provided buffer ring.
+    //! @remarks
+    //!  @p ring_addr should be page aligned and hold @p n_entries entries,
+    //!  where @p n_entries is power of two.
+    bool register_buffer_ring(void* ring_addr, size_t n_entries, uint16_t group_id);
+
+    //! Unregister provided buffer ring.
+    void unregister_buffer_ring(uint16_t group_id);
+
+private:
+    bool map_rings_(const io_uring_params& params);
+    void unmap_rings_();
+
+    bool register_event_fd_();
+
+    int ring_fd_;
+    int event_fd_;
+
+    void* sq_ring_;
+    size_t sq_ring_size_;
+    void* cq_ring_;
+    size_t cq_ring_size_;
+    io_uring_sqe* sqes_;
+    size_t sqes_size_;
+
+    unsigned* sq_head_;
+    unsigned* sq_tail_;
+    unsigned* sq_array_;
+    unsigned sq_mask_;
+    unsigned sq_entries_;
+
+    unsigned* cq_head_;
+    unsigned* cq_tail_;
+    io_uring_cqe* cqes_;
+    unsigned cq_mask_;
+
+    // entries prepared by get_sqe() but not yet passed to kernel
+    unsigned sqe_tail_;
+    unsigned n_pending_;
+
+    bool valid_;
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_IO_URING_RING_H_
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <string.h>
+
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_netio/io_uring_sender.h"
+
+namespace roc {
+namespace netio {
+
+IoUringSender::IoUringSender()
+    : ring_(NumSlots)
+    , n_free_(0)
+    , fd_(-1)
+    , valid_(false) {
+    if (!ring_.valid()) {
+        return;
+    }
+
+    for (size_t n = 0; n < NumSlots; n++) {
+        memset(&slots_[n].msg, 0, sizeof(slots_[n].msg));
+        memset(&slots_[n].iov, 0, sizeof(slots_[n].iov));
+
+        free_slots_[n_free_++] = uint16_t(NumSlots - n - 1);
+    }
+
+    valid_ = true;
+}
+
+bool IoUringSender::valid() const {
+    return valid_;
+}
+
+int IoUringSender::event_fd() const {
+    roc_panic_if(!valid_);
+
+    return ring_.event_fd();
+}
+
+void IoUringSender::clear_event() {
+    roc_panic_if(!valid_);
+
+    ring_.clear_event();
+}
+
+void IoUringSender::start(int fd) {
+    roc_panic_if(!valid_);
+    roc_panic_if(fd < 0);
+
+    fd_ = fd;
+}
+
+bool IoUringSender::can_send() const {
+    roc_panic_if(!valid_);
+
+    return n_free_ != 0;
+}
+
+void IoUringSender::send(const packet::PacketPtr& pp) {
+    roc_panic_if(!valid_);
+    roc_panic_if(fd_ < 0);
+
+    if (n_free_ == 0) {
+        roc_panic("io_uring sender: no free slots");
+    }
+
+    const uint16_t slot_index = free_slots_[--n_free_];
+    Slot& slot = slots_[slot_index];
+
+    // packet holds destination address and payload until completion
+    slot.packet = pp;
+
+    slot.iov.iov_base = pp->data().data();
+    slot.iov.iov_len = pp->data().size();
+
+    slot.msg.msg_name = (void*)pp->udp()->dst_addr.saddr();
+    slot.msg.msg_namelen = (socklen_t)pp->udp()->dst_addr.slen();
+    slot.msg.msg_iov = &slot.iov;
+    slot.msg.msg_iovlen = 1;
+
+    // submission queue has a free entry for every free slot
+    io_uring_sqe* sqe = ring_.get_sqe();
+    roc_panic_if_msg(!sqe, "io_uring sender: submission queue is full");
+
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = fd_;
+    sqe->addr = (uint64_t)(uintptr_t)&slot.msg;
+    sqe->len = 1;
+    sqe->user_data = slot_index;
+}
+
+bool IoUringSender::flush() {
+    roc_panic_if(!valid_);
+
+    return ring_.submit();
+}
+
+bool IoUringSender::reap(packet::PacketPtr& pp, int& result) {
+    roc_panic_if(!valid_);
+
+    io_uring_cqe cqe;
+    if (!ring_.next_cqe(cqe)) {
+        return false;
+    }
+
+    roc_panic_if(cqe.user_data >= NumSlots);
+
+    const uint16_t slot_index = uint16_t(cqe.user_data);
+    Slot& slot = slots_[slot_index];
+
+    pp = slot.packet;
+    result = cqe.res;
+
+    slot.packet.reset();
+    free_slots_[n_free_++] = slot_index;
+
+    return true;
+}
+
+size_t IoUringSender::num_pending() const {
+    return NumSlots - n_free_;
+}
+
+} // namespace netio
+} // namespace roc
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_io_uring/roc_netio/io_uring_sender.h
+//! @brief Datagram sender based on io_uring.
+
+#ifndef ROC_NETIO_IO_URING_SENDER_H_
+#define ROC_NETIO_IO_URING_SENDER_H_
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "roc_core/noncopyable.h"
+#include "roc_netio/io_uring_ring.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace netio {
+
+//! Datagram sender based on io_uring.
+//! @remarks
+//!  Packets added by send() are accumulated in submission queue and passed
+//!  to kernel by a single flush(), so that a batch of packets costs one
+//!  system call. Packet is referenced until its completion is fetched by
+//!  reap(). Not thread-safe.
+class IoUringSender : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    IoUringSender();
+
+    //! Check if ring was successfully created.
+    bool valid() const;
+
+    //! Get eventfd that becomes readable when sends are completed.
+    int event_fd() const;
+
+    //! Reset eventfd before fetching completions.
+    void clear_event();
+
+    //! Set socket to send packets to.
+    void start(int fd);
+
+    //! Check if another packet can be added.
+    bool can_send() const;
+
+    //! Add packet to current batch.
+    //! @pre
+    //!  can_send() should be true.
+    void send(const packet::PacketPtr& pp);
+
+    //! Pass current batch to kernel.
+    bool flush();
+
+    //! Fetch completed packet.
+    //! @remarks
+    //!  Sets @p result to number of bytes sent or to negative errno.
+    //! @returns
+    //!  false if there are no more completions.
+    bool reap(packet::PacketPtr& pp, int& result);
+
+    //! Get number of packets not yet reaped.
+    size_t num_pending() const;
+
+private:
+    enum { NumSlots = 64 };
+
+    struct Slot {
+        msghdr msg;
+        iovec iov;
+        packet::PacketPtr packet;
+    };
+
+    IoUringRing ring_;
+
+    Slot slots_[NumSlots];
+
+    // stack of free slot indices
+    uint16_t free_slots_[NumSlots];
+    size_t n_free_;
+
+    int fd_;
+
+    bool valid_;
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_IO_URING_SENDER_H_
@@ -31,9 +31,11 @@ NetworkLoop::PortHandle NetworkLoop::Tasks::AddUdpReceiverPort::get_handle() con
     return (PortHandle)port_handle_;
 }
 
-NetworkLoop::Tasks::AddUdpSenderPort::AddUdpSenderPort(UdpSenderConfig& config) {
+NetworkLoop::Tasks::AddUdpSenderPort::AddUdpSenderPort(UdpSenderConfig& config,
+                                                       packet::IWriter* inbound_writer) {
     func_ = &NetworkLoop::task_add_udp_sender_;
     config_ = &config;
+    inbound_writer_ = inbound_writer;
     writer_ = NULL;
 }
 
@@ -102,10 +104,12 @@ NetworkLoop::Tasks::ResolveEndpointAddress::get_address() const {
     return resolve_req_.resolved_address;
 }
 
-NetworkLoop::NetworkLoop(packet::PacketFactory& packet_factory,
+NetworkLoop::NetworkLoop(const NetworkLoopConfig& config,
+                         packet::PacketFactory& packet_factory,
                          core::BufferFactory<uint8_t>& buffer_factory,
                          core::IAllocator& allocator)
-    : packet_factory_(packet_factory)
+    : config_(config)
+    , packet_factory_(packet_factory)
     , buffer_factory_(buffer_factory)
     , allocator_(allocator)
     , started_(false)
@@ -157,7 +161,7 @@ NetworkLoop::~NetworkLoop() {
             // If the thread was never started we should manually run the loop to
             // wait all opened handles to be closed. Otherwise, uv_loop_close()
             // will fail with EBUSY.
-            NetworkLoop::run(); // non-virtual call from dtor
+            run_loop_();
         }
 
         if (int err = uv_loop_close(&loop_)) {
@@ -275,16 +279,70 @@ void NetworkLoop::handle_resolved(ResolverRequest& req) {
 }
 
 void NetworkLoop::run() {
-    roc_log(LogDebug, "network loop: starting event loop");
+    configure_thread_();
+    run_loop_();
+}
+
+void NetworkLoop::configure_thread_() {
+    if (config_.numa_node >= 0) {
+        if (core::Thread::set_numa_node((size_t)config_.numa_node)) {
+            roc_log(LogDebug, "network loop: bound network thread to numa node %d",
+                    config_.numa_node);
+        }
+    }
 
-    int err = uv_run(&loop_, UV_RUN_DEFAULT);
-    if (err != 0) {
-        roc_log(LogInfo, "network loop: uv_run() returned non-zero");
+    if (config_.cpu_affinity >= 0) {
+        if (core::Thread::set_cpu_affinity((size_t)config_.cpu_affinity)) {
+            roc_log(LogDebug, "network loop: pinned network thread to cpu %d",
+                    config_.cpu_affinity);
+        }
+    }
+
+    if (config_.realtime_priority) {
+        if (core::Thread::set_realtime()) {
+            roc_log(LogDebug, "network loop: set realtime priority for network thread");
+        }
+    }
+}
+
+void NetworkLoop::run_loop_() {
+    if (config_.busy_poll_budget > 0) {
+        roc_log(LogDebug, "network loop: starting event loop: busy_poll_budget=%.3fms",
+                (double)config_.busy_poll_budget / core::Millisecond);
+
+        run_loop_busy_poll_();
+    } else {
+        roc_log(LogDebug, "network loop: starting event loop");
+
+        int err = uv_run(&loop_, UV_RUN_DEFAULT);
+        if (err != 0) {
+            roc_log(LogInfo, "network loop: uv_run() returned non-zero");
+        }
     }
 
     roc_log(LogDebug, "network loop: finishing event loop");
 }
 
+void NetworkLoop::run_loop_busy_poll_() {
+    for (;;) {
+        // Spin: poll for events without blocking until budget expires.
+        const core::nanoseconds_t spin_deadline =
+            core::timestamp(core::ClockMonotonic) + config_.busy_poll_budget;
+
+        do {
+            if (uv_run(&loop_, UV_RUN_NOWAIT) == 0) {
+                // no more active handles, loop is stopped
+                return;
+            }
+        } while (core::timestamp(core::ClockMonotonic) < spin_deadline);
+
+        // Park: block until at least one event arrives.
+        if (uv_run(&loop_, UV_RUN_ONCE) == 0) {
+            return;
+        }
+    }
+}
+
 void NetworkLoop::task_sem_cb_(uv_async_t* handle) {
     roc_panic_if_not(handle);
 
@@ -388,7 +446,8 @@ void NetworkLoop::task_add_udp_receiver_(NetworkTask& base_task) {
 
     core::SharedPtr<UdpReceiverPort> port =
         new (allocator_) UdpReceiverPort(*task.config_, *task.writer_, loop_,
-                                         packet_factory_, buffer_factory_, allocator_);
+                                         packet_factory_, buffer_factory_, allocator_,
+                                         config_.io_uring);
     if (!port) {
         roc_log(
             LogError,
@@ -427,8 +486,9 @@ void NetworkLoop::task_add_udp_receiver_(NetworkTask& base_task) {
 void NetworkLoop::task_add_udp_sender_(NetworkTask& base_task) {
     Tasks::AddUdpSenderPort& task = (Tasks::AddUdpSenderPort&)base_task;
 
-    core::SharedPtr<UdpSenderPort> port =
-        new (allocator_) UdpSenderPort(*task.config_, loop_, allocator_);
+    core::SharedPtr<UdpSenderPort> port = new (allocator_)
+        UdpSenderPort(*task.config_, task.inbound_writer_, loop_, packet_factory_,
+                      buffer_factory_, allocator_, config_.io_uring);
     if (!port) {
         roc_log(LogError,
                 "network loop: can't add udp sender port %s: can't allocate udp sender",
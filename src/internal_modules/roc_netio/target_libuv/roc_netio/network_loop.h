@@ -24,6 +24,7 @@
 #include "roc_core/optional.h"
 #include "roc_core/semaphore.h"
 #include "roc_core/thread.h"
+#include "roc_core/time.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
 #include "roc_netio/iconn.h"
@@ -43,6 +44,45 @@
 namespace roc {
 namespace netio {
 
+//! Network event loop parameters.
+struct NetworkLoopConfig {
+    //! Busy-poll spin budget.
+    //! If non-zero, after every wakeup the event loop keeps polling sockets
+    //! without blocking during this interval before parking again, which
+    //! reduces wakeup jitter at the cost of CPU time.
+    //! Set to zero to always block in the event loop (default).
+    core::nanoseconds_t busy_poll_budget;
+
+    //! Raise network thread priority to realtime.
+    bool realtime_priority;
+
+    //! Pin network thread to given CPU.
+    //! Set to -1 to disable pinning (default).
+    int cpu_affinity;
+
+    //! Bind network thread to given NUMA node.
+    //! If cpu_affinity is also set, it should be one of the node CPUs.
+    //! Set to -1 to disable binding (default).
+    int numa_node;
+
+    //! Use io_uring for UDP ports.
+    //! If set, and roc was built with io_uring support, and kernel supports
+    //! it, UDP datagrams are received and sent via io_uring rings instead of
+    //! libuv. Otherwise UDP ports silently fall back to libuv.
+    //! Received datagrams share buffer with a small io_uring header; when
+    //! a datagram doesn't fit, it's dropped and receiver port falls back
+    //! to libuv too.
+    bool io_uring;
+
+    NetworkLoopConfig()
+        : busy_poll_budget(0)
+        , realtime_priority(false)
+        , cpu_affinity(-1)
+        , numa_node(-1)
+        , io_uring(false) {
+    }
+};
+
 //! Network event loop thread.
 //! @remarks
 //!  This class is a task-based facade for the whole roc_netio module.
@@ -84,8 +124,12 @@ public:
         public:
             //! Set task parameters.
             //! @remarks
-            //!  Updates @p config with the actual bind address.
-            AddUdpSenderPort(UdpSenderConfig& config);
+            //!  - Updates @p config with the actual bind address.
+            //!  - If @p inbound_writer is non-NULL, passes packets received on the
+            //!    port to it, e.g. control reports from receivers. It is called from
+            //!    network thread. It should not block the caller.
+            AddUdpSenderPort(UdpSenderConfig& config,
+                             packet::IWriter* inbound_writer = NULL);
 
             //! Get created port handle.
             //! @pre
@@ -104,6 +148,7 @@ public:
             friend class NetworkLoop;
 
             UdpSenderConfig* config_;
+            packet::IWriter* inbound_writer_;
             packet::IWriter* writer_;
         };
 
@@ -185,7 +230,8 @@ public:
     //! Initialize.
     //! @remarks
     //!  Start background thread if the object was successfully constructed.
-    NetworkLoop(packet::PacketFactory& packet_factory,
+    NetworkLoop(const NetworkLoopConfig& config,
+                packet::PacketFactory& packet_factory,
                 core::BufferFactory<uint8_t>& buffer_factory,
                 core::IAllocator& allocator);
 
@@ -223,6 +269,10 @@ private:
 
     virtual void run();
 
+    void configure_thread_();
+    void run_loop_();
+    void run_loop_busy_poll_();
+
     void process_pending_tasks_();
     void finish_task_(NetworkTask&);
 
@@ -244,6 +294,8 @@ private:
     void task_add_tcp_client_(NetworkTask&);
     void task_resolve_endpoint_address_(NetworkTask&);
 
+    const NetworkLoopConfig config_;
+
     packet::PacketFactory& packet_factory_;
     core::BufferFactory<uint8_t>& buffer_factory_;
     core::IAllocator& allocator_;
@@ -12,6 +12,8 @@
 #include "roc_core/panic.h"
 #include "roc_core/shared_ptr.h"
 #include "roc_core/string_builder.h"
+#include "roc_core/time.h"
+#include "roc_netio/socket_ops.h"
 
 namespace roc {
 namespace netio {
@@ -21,7 +23,8 @@ UdpReceiverPort::UdpReceiverPort(const UdpReceiverConfig& config,
                                  uv_loop_t& event_loop,
                                  packet::PacketFactory& packet_factory,
                                  core::BufferFactory<uint8_t>& buffer_factory,
-                                 core::IAllocator& allocator)
+                                 core::IAllocator& allocator,
+                                 bool io_uring)
     : BasicPort(allocator)
     , config_(config)
     , writer_(writer)
@@ -29,6 +32,15 @@ UdpReceiverPort::UdpReceiverPort(const UdpReceiverConfig& config,
     , close_handler_arg_(NULL)
     , loop_(event_loop)
     , handle_initialized_(false)
+    , recv_poll_initialized_(false)
+    , recv_poll_started_(false)
+#ifdef ROC_TARGET_IO_URING
+    , uring_poll_initialized_(false)
+    , uring_recv_started_(false)
+#endif // ROC_TARGET_IO_URING
+    , io_uring_(io_uring)
+    , fd_(-1)
+    , timestamps_enabled_(false)
     , multicast_group_joined_(false)
     , recv_started_(false)
     , closed_(false)
@@ -39,7 +51,12 @@ UdpReceiverPort::UdpReceiverPort(const UdpReceiverConfig& config,
 }
 
 UdpReceiverPort::~UdpReceiverPort() {
-    if (handle_initialized_) {
+    bool initialized = handle_initialized_ || recv_poll_initialized_;
+#ifdef ROC_TARGET_IO_URING
+    initialized = initialized || uring_poll_initialized_;
+#endif // ROC_TARGET_IO_URING
+
+    if (initialized) {
         roc_panic(
             "udp receiver: %s: receiver was not fully closed before calling destructor",
             descriptor());
@@ -97,19 +114,32 @@ bool UdpReceiverPort::open() {
         return false;
     }
 
+    // libuv doesn't pass control messages to recv callback, so when kernel
+    // timestamps are enabled, we poll socket and read SCM_TIMESTAMPNS via
+    // recvmsg() ourselves; io_uring receiver reads it from completions
+    if (int err = uv_fileno((uv_handle_t*)&handle_, &fd_)) {
+        roc_log(LogError,
+                "udp receiver: %s: uv_fileno(): [%s] %s:"
+                " disabling kernel receive timestamps",
+                descriptor(), uv_err_name(err), uv_strerror(err));
+        fd_ = -1;
+    } else if (config_.kernel_timestamps) {
+        timestamps_enabled_ = socket_enable_recv_timestamps(fd_);
+    }
+
+    roc_log(LogDebug, "udp receiver: %s: kernel receive timestamps %s", descriptor(),
+            timestamps_enabled_ ? "enabled" : "disabled");
+
     if (config_.multicast_interface[0]) {
         if (!join_multicast_group_()) {
             return false;
         }
     }
 
-    if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
-        roc_log(LogError, "udp receiver: %s: uv_udp_recv_start(): [%s] %s", descriptor(),
-                uv_err_name(err), uv_strerror(err));
+    if (!start_recv_()) {
         return false;
     }
 
-    recv_started_ = true;
     update_descriptor();
 
     roc_log(LogDebug, "udp receiver: %s: opened port", descriptor());
@@ -126,7 +156,7 @@ AsyncOperationStatus UdpReceiverPort::async_close(ICloseHandler& handler,
     close_handler_ = &handler;
     close_handler_arg_ = handler_arg;
 
-    if (!handle_initialized_) {
+    if (!handle_initialized_ && !recv_poll_initialized_) {
         return AsyncOp_Completed;
     }
 
@@ -136,19 +166,24 @@ AsyncOperationStatus UdpReceiverPort::async_close(ICloseHandler& handler,
 
     roc_log(LogDebug, "udp receiver: %s: initiating asynchronous close", descriptor());
 
-    if (recv_started_) {
-        if (int err = uv_udp_recv_stop(&handle_)) {
-            roc_log(LogError, "udp receiver: %s: uv_udp_recv_stop(): [%s] %s",
-                    descriptor(), uv_err_name(err), uv_strerror(err));
-        }
-        recv_started_ = false;
-    }
+    stop_recv_();
 
     if (multicast_group_joined_) {
         leave_multicast_group_();
     }
 
-    if (!uv_is_closing((uv_handle_t*)&handle_)) {
+#ifdef ROC_TARGET_IO_URING
+    if (uring_poll_initialized_ && !uv_is_closing((uv_handle_t*)&uring_poll_)) {
+        uv_close((uv_handle_t*)&uring_poll_, close_cb_);
+    }
+#endif // ROC_TARGET_IO_URING
+
+    // poll handle should be closed before socket
+    if (recv_poll_initialized_ && !uv_is_closing((uv_handle_t*)&recv_poll_)) {
+        uv_close((uv_handle_t*)&recv_poll_, close_cb_);
+    }
+
+    if (handle_initialized_ && !uv_is_closing((uv_handle_t*)&handle_)) {
         uv_close((uv_handle_t*)&handle_, close_cb_);
     }
 
@@ -160,7 +195,27 @@ void UdpReceiverPort::close_cb_(uv_handle_t* handle) {
 
     UdpReceiverPort& self = *(UdpReceiverPort*)handle->data;
 
-    self.handle_initialized_ = false;
+    if (handle == (uv_handle_t*)&self.handle_) {
+        self.handle_initialized_ = false;
+    }
+
+    if (handle == (uv_handle_t*)&self.recv_poll_) {
+        self.recv_poll_initialized_ = false;
+    }
+
+#ifdef ROC_TARGET_IO_URING
+    if (handle == (uv_handle_t*)&self.uring_poll_) {
+        self.uring_poll_initialized_ = false;
+    }
+
+    if (self.uring_poll_initialized_) {
+        return;
+    }
+#endif // ROC_TARGET_IO_URING
+
+    if (self.handle_initialized_ || self.recv_poll_initialized_) {
+        return;
+    }
 
     roc_log(LogDebug, "udp receiver: %s: closed port", self.descriptor());
 
@@ -264,34 +319,278 @@ void UdpReceiverPort::recv_cb_(uv_udp_t* handle,
         return;
     }
 
-    self.packet_counter_++;
-
-    roc_log(LogTrace, "udp receiver: %s: received packet: num=%u src=%s dst=%s nread=%ld",
-            self.descriptor(), self.packet_counter_,
-            address::socket_addr_to_str(src_addr).c_str(),
-            address::socket_addr_to_str(self.config_.bind_address).c_str(), (long)nread);
-
     if ((size_t)nread > bp->size()) {
         roc_panic("udp receiver: %s: unexpected buffer size: got %ld, max %ld",
                   self.descriptor(), (long)nread, (long)bp->size());
     }
 
-    packet::PacketPtr pp = self.packet_factory_.new_packet();
+    self.handle_packet_(core::Slice<uint8_t>(*bp, 0, (size_t)nread), src_addr,
+                        core::timestamp(core::ClockUnix));
+}
+
+void UdpReceiverPort::recv_poll_cb_(uv_poll_t* handle, int status, int events) {
+    roc_panic_if_not(handle);
+
+    UdpReceiverPort& self = *(UdpReceiverPort*)handle->data;
+
+    (void)events;
+
+    if (status < 0) {
+        roc_log(LogError, "udp receiver: %s: uv_poll(): [%s] %s", self.descriptor(),
+                uv_err_name(status), uv_strerror(status));
+        return;
+    }
+
+    // poll is level-triggered, so if we stop before draining socket, we'll be
+    // called again on next loop iteration, after other handles are served
+    for (size_t n = 0; n < MaxRecvBatch && self.recv_poll_started_; n++) {
+        // buffer is reused until datagram is actually read into it
+        if (!self.recv_buffer_) {
+            if (!(self.recv_buffer_ = self.buffer_factory_.new_buffer())) {
+                roc_log(LogError, "udp receiver: %s: can't allocate buffer",
+                        self.descriptor());
+                return;
+            }
+        }
+
+        address::SocketAddr src_addr;
+        core::nanoseconds_t timestamp = 0;
+
+        const ssize_t nread =
+            socket_try_recv_from(self.fd_, self.recv_buffer_->data(),
+                                 self.recv_buffer_->size(), src_addr, timestamp);
+
+        if (nread == IOErr_WouldBlock) {
+            break;
+        }
+
+        if (nread < 0) {
+            // truncated or malformed datagram was dropped
+            continue;
+        }
+
+        if (nread == 0) {
+            roc_log(LogTrace, "udp receiver: %s: empty packet: num=%u src=%s dst=%s",
+                    self.descriptor(), self.packet_counter_,
+                    address::socket_addr_to_str(src_addr).c_str(),
+                    address::socket_addr_to_str(self.config_.bind_address).c_str());
+            continue;
+        }
+
+        core::SharedPtr<core::Buffer<uint8_t> > bp = self.recv_buffer_;
+        self.recv_buffer_ = NULL;
+
+        if (timestamp == 0) {
+            timestamp = core::timestamp(core::ClockUnix);
+        }
+
+        self.handle_packet_(core::Slice<uint8_t>(*bp, 0, (size_t)nread), src_addr,
+                            timestamp);
+    }
+}
+
+bool UdpReceiverPort::start_recv_() {
+#ifdef ROC_TARGET_IO_URING
+    if (io_uring_ && start_uring_recv_()) {
+        return true;
+    }
+#endif // ROC_TARGET_IO_URING
+
+    if (io_uring_) {
+        roc_log(LogDebug, "udp receiver: %s: io_uring not available, using libuv",
+                descriptor());
+    }
+
+    return start_libuv_recv_();
+}
+
+bool UdpReceiverPort::start_libuv_recv_() {
+    if (timestamps_enabled_) {
+        if (!recv_poll_initialized_) {
+            if (int err = uv_poll_init_socket(&loop_, &recv_poll_, fd_)) {
+                roc_log(LogError, "udp receiver: %s: uv_poll_init_socket(): [%s] %s",
+                        descriptor(), uv_err_name(err), uv_strerror(err));
+                return false;
+            }
+
+            recv_poll_.data = this;
+            recv_poll_initialized_ = true;
+        }
+
+        // poll handle is closed in async_close()
+        if (int err = uv_poll_start(&recv_poll_, UV_READABLE, recv_poll_cb_)) {
+            roc_log(LogError, "udp receiver: %s: uv_poll_start(): [%s] %s",
+                    descriptor(), uv_err_name(err), uv_strerror(err));
+            return false;
+        }
+
+        recv_poll_started_ = true;
+
+        return true;
+    }
+
+    if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
+        roc_log(LogError, "udp receiver: %s: uv_udp_recv_start(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    recv_started_ = true;
+
+    return true;
+}
+
+void UdpReceiverPort::stop_recv_() {
+#ifdef ROC_TARGET_IO_URING
+    stop_uring_recv_();
+#endif // ROC_TARGET_IO_URING
+
+    if (recv_poll_started_) {
+        if (int err = uv_poll_stop(&recv_poll_)) {
+            roc_log(LogError, "udp receiver: %s: uv_poll_stop(): [%s] %s", descriptor(),
+                    uv_err_name(err), uv_strerror(err));
+        }
+        recv_poll_started_ = false;
+    }
+
+    if (recv_started_) {
+        if (int err = uv_udp_recv_stop(&handle_)) {
+            roc_log(LogError, "udp receiver: %s: uv_udp_recv_stop(): [%s] %s",
+                    descriptor(), uv_err_name(err), uv_strerror(err));
+        }
+        recv_started_ = false;
+    }
+
+    recv_buffer_ = NULL;
+}
+
+void UdpReceiverPort::handle_packet_(const core::Slice<uint8_t>& data,
+                                     const address::SocketAddr& src_addr,
+                                     core::nanoseconds_t timestamp) {
+    packet_counter_++;
+
+    roc_log(LogTrace, "udp receiver: %s: received packet: num=%u src=%s dst=%s nread=%ld",
+            descriptor(), packet_counter_, address::socket_addr_to_str(src_addr).c_str(),
+            address::socket_addr_to_str(config_.bind_address).c_str(),
+            (long)data.size());
+
+    packet::PacketPtr pp = packet_factory_.new_packet();
     if (!pp) {
-        roc_log(LogError, "udp receiver: %s: can't allocate packet", self.descriptor());
+        roc_log(LogError, "udp receiver: %s: can't allocate packet", descriptor());
         return;
     }
 
     pp->add_flags(packet::Packet::FlagUDP);
 
     pp->udp()->src_addr = src_addr;
-    pp->udp()->dst_addr = self.config_.bind_address;
+    pp->udp()->dst_addr = config_.bind_address;
+
+    pp->udp()->receive_timestamp = timestamp;
 
-    pp->set_data(core::Slice<uint8_t>(*bp, 0, (size_t)nread));
+    pp->set_data(data);
 
-    self.writer_.write(pp);
+    writer_.write(pp);
 }
 
+#ifdef ROC_TARGET_IO_URING
+
+void UdpReceiverPort::uring_poll_cb_(uv_poll_t* handle, int status, int events) {
+    roc_panic_if_not(handle);
+
+    UdpReceiverPort& self = *(UdpReceiverPort*)handle->data;
+
+    (void)events;
+
+    if (status < 0) {
+        roc_log(LogError, "udp receiver: %s: uv_poll(): [%s] %s", self.descriptor(),
+                uv_err_name(status), uv_strerror(status));
+        return;
+    }
+
+    if (!self.uring_recv_started_) {
+        return;
+    }
+
+    self.uring_receiver_->clear_event();
+
+    IoUringDatagram datagram;
+
+    for (;;) {
+        const IoUringReceiver::FetchStatus fetch_status =
+            self.uring_receiver_->fetch(datagram);
+
+        if (fetch_status == IoUringReceiver::Fetch_Empty) {
+            break;
+        }
+
+        if (fetch_status == IoUringReceiver::Fetch_Error) {
+            roc_log(LogInfo, "udp receiver: %s: io_uring receive failed, using libuv",
+                    self.descriptor());
+
+            self.stop_uring_recv_();
+            self.start_libuv_recv_();
+            break;
+        }
+
+        self.handle_packet_(datagram.data, datagram.src_addr,
+                            datagram.timestamp != 0 ? datagram.timestamp
+                                                    : core::timestamp(core::ClockUnix));
+    }
+}
+
+bool UdpReceiverPort::start_uring_recv_() {
+    if (fd_ < 0) {
+        return false;
+    }
+
+    uring_receiver_.reset(new (uring_receiver_) IoUringReceiver(buffer_factory_));
+
+    if (!uring_receiver_->valid() || !uring_receiver_->start(fd_)) {
+        uring_receiver_.reset();
+        return false;
+    }
+
+    if (int err = uv_poll_init(&loop_, &uring_poll_, uring_receiver_->event_fd())) {
+        roc_log(LogError, "udp receiver: %s: uv_poll_init(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        uring_receiver_.reset();
+        return false;
+    }
+
+    uring_poll_.data = this;
+    uring_poll_initialized_ = true;
+
+    // poll handle is closed in async_close()
+    if (int err = uv_poll_start(&uring_poll_, UV_READABLE, uring_poll_cb_)) {
+        roc_log(LogError, "udp receiver: %s: uv_poll_start(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        uring_receiver_->stop();
+        return false;
+    }
+
+    uring_recv_started_ = true;
+
+    roc_log(LogDebug, "udp receiver: %s: receiving via io_uring", descriptor());
+
+    return true;
+}
+
+void UdpReceiverPort::stop_uring_recv_() {
+    if (!uring_recv_started_) {
+        return;
+    }
+
+    if (int err = uv_poll_stop(&uring_poll_)) {
+        roc_log(LogError, "udp receiver: %s: uv_poll_stop(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+    }
+
+    uring_receiver_->stop();
+    uring_recv_started_ = false;
+}
+
+#endif // ROC_TARGET_IO_URING
+
 bool UdpReceiverPort::join_multicast_group_() {
     if (!config_.bind_address.multicast()) {
         roc_log(LogError,
@@ -15,15 +15,23 @@
 #include <uv.h>
 
 #include "roc_address/socket_addr.h"
+#include "roc_core/buffer.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list.h"
 #include "roc_core/list_node.h"
+#include "roc_core/optional.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/time.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet_factory.h"
 
+#ifdef ROC_TARGET_IO_URING
+#include "roc_netio/io_uring_receiver.h"
+#endif // ROC_TARGET_IO_URING
+
 namespace roc {
 namespace netio {
 
@@ -43,13 +51,28 @@ struct UdpReceiverConfig {
     //! binding to non-ephemeral port.
     bool reuseaddr;
 
+    //! If set, request kernel receive timestamps (SO_TIMESTAMPNS) for socket.
+    //! If not set, or if kernel doesn't support them, packets are stamped with
+    //! user-space time when they are read from socket.
+    bool kernel_timestamps;
+
     UdpReceiverConfig()
-        : reuseaddr(false) {
+        : reuseaddr(false)
+        , kernel_timestamps(false) {
         multicast_interface[0] = '\0';
     }
 };
 
 //! UDP receiver.
+//! @remarks
+//!  If @p io_uring is set and io_uring backend is available, datagrams are
+//!  received via io_uring ring, whose eventfd is polled by libuv loop.
+//!  Otherwise, or if ring can't be used, receiver falls back to libuv.
+//!
+//!  When kernel receive timestamps are enabled in config and supported by
+//!  kernel, libuv is only used to poll socket, and datagrams are read using
+//!  recvmsg(), so that timestamp is taken from control message. Otherwise,
+//!  uv_udp_recv_start() is used and packets are stamped with user-space time.
 class UdpReceiverPort : public BasicPort {
 public:
     //! Initialize.
@@ -58,7 +81,8 @@ public:
                     uv_loop_t& event_loop,
                     packet::PacketFactory& packet_factory,
                     core::BufferFactory<uint8_t>& buffer_factory,
-                    core::IAllocator& allocator);
+                    core::IAllocator& allocator,
+                    bool io_uring);
 
     //! Destroy.
     virtual ~UdpReceiverPort();
@@ -77,6 +101,9 @@ protected:
     virtual void format_descriptor(core::StringBuilder& b);
 
 private:
+    // maximum number of datagrams read from socket in one poll callback
+    enum { MaxRecvBatch = 64 };
+
     static void close_cb_(uv_handle_t* handle);
     static void alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf);
     static void recv_cb_(uv_udp_t* handle,
@@ -84,10 +111,26 @@ private:
                          const uv_buf_t* buf,
                          const sockaddr* addr,
                          unsigned flags);
+    static void recv_poll_cb_(uv_poll_t* handle, int status, int events);
+
+    bool start_recv_();
+    bool start_libuv_recv_();
+    void stop_recv_();
+
+    void handle_packet_(const core::Slice<uint8_t>& data,
+                        const address::SocketAddr& src_addr,
+                        core::nanoseconds_t timestamp);
 
     bool join_multicast_group_();
     void leave_multicast_group_();
 
+#ifdef ROC_TARGET_IO_URING
+    static void uring_poll_cb_(uv_poll_t* handle, int status, int events);
+
+    bool start_uring_recv_();
+    void stop_uring_recv_();
+#endif // ROC_TARGET_IO_URING
+
     UdpReceiverConfig config_;
     packet::IWriter& writer_;
 
@@ -99,6 +142,23 @@ private:
     uv_udp_t handle_;
     bool handle_initialized_;
 
+    uv_poll_t recv_poll_;
+    bool recv_poll_initialized_;
+    bool recv_poll_started_;
+    core::SharedPtr<core::Buffer<uint8_t> > recv_buffer_;
+
+#ifdef ROC_TARGET_IO_URING
+    core::Optional<IoUringReceiver> uring_receiver_;
+    uv_poll_t uring_poll_;
+    bool uring_poll_initialized_;
+    bool uring_recv_started_;
+#endif // ROC_TARGET_IO_URING
+
+    const bool io_uring_;
+
+    uv_os_fd_t fd_;
+    bool timestamps_enabled_;
+
     bool multicast_group_joined_;
     bool recv_started_;
     bool closed_;
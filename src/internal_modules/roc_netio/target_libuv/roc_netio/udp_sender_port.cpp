@@ -8,9 +8,12 @@
 
 #include "roc_netio/udp_sender_port.h"
 #include "roc_address/socket_addr_to_str.h"
+#include "roc_core/errno_to_str.h"
 #include "roc_core/log.h"
 #include "roc_core/macro_helpers.h"
 #include "roc_core/panic.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/time.h"
 #include "roc_netio/socket_ops.h"
 
 namespace roc {
@@ -23,18 +26,33 @@ const core::nanoseconds_t PacketLogInterval = 20 * core::Second;
 } // namespace
 
 UdpSenderPort::UdpSenderPort(const UdpSenderConfig& config,
+                             packet::IWriter* inbound_writer,
                              uv_loop_t& event_loop,
-                             core::IAllocator& allocator)
+                             packet::PacketFactory& packet_factory,
+                             core::BufferFactory<uint8_t>& buffer_factory,
+                             core::IAllocator& allocator,
+                             bool io_uring)
     : BasicPort(allocator)
     , config_(config)
+    , inbound_writer_(inbound_writer)
     , close_handler_(NULL)
     , close_handler_arg_(NULL)
     , loop_(event_loop)
+    , packet_factory_(packet_factory)
+    , buffer_factory_(buffer_factory)
     , write_sem_initialized_(false)
     , handle_initialized_(false)
+    , recv_started_(false)
+#ifdef ROC_TARGET_IO_URING
+    , uring_poll_initialized_(false)
+    , uring_send_started_(false)
+    , uring_wakeup_pending_(0)
+#endif // ROC_TARGET_IO_URING
+    , io_uring_(io_uring)
     , pending_packets_(0)
     , sent_packets_(0)
     , sent_packets_blk_(0)
+    , recv_packets_(0)
     , stopped_(true)
     , closed_(false)
     , fd_()
@@ -43,7 +61,12 @@ UdpSenderPort::UdpSenderPort(const UdpSenderConfig& config,
 }
 
 UdpSenderPort::~UdpSenderPort() {
-    if (handle_initialized_ || write_sem_initialized_) {
+    bool initialized = handle_initialized_ || write_sem_initialized_;
+#ifdef ROC_TARGET_IO_URING
+    initialized = initialized || uring_poll_initialized_;
+#endif // ROC_TARGET_IO_URING
+
+    if (initialized) {
         roc_panic("udp sender: %s: sender was not fully closed before calling destructor",
                   descriptor());
     }
@@ -124,6 +147,25 @@ bool UdpSenderPort::open() {
                   uv_err_name(fd_err), uv_strerror(fd_err));
     }
 
+    bool uring_started = false;
+#ifdef ROC_TARGET_IO_URING
+    uring_started = io_uring_ && start_uring_send_();
+#endif // ROC_TARGET_IO_URING
+
+    if (io_uring_ && !uring_started) {
+        roc_log(LogDebug, "udp sender: %s: io_uring not available, using libuv",
+                descriptor());
+    }
+
+    if (inbound_writer_) {
+        if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
+            roc_log(LogError, "udp sender: %s: uv_udp_recv_start(): [%s] %s",
+                    descriptor(), uv_err_name(err), uv_strerror(err));
+            return false;
+        }
+        recv_started_ = true;
+    }
+
     stopped_ = false;
     update_descriptor();
 
@@ -143,6 +185,14 @@ AsyncOperationStatus UdpSenderPort::async_close(ICloseHandler& handler,
 
     stopped_ = true;
 
+    if (recv_started_) {
+        if (int err = uv_udp_recv_stop(&handle_)) {
+            roc_log(LogError, "udp sender: %s: uv_udp_recv_stop(): [%s] %s",
+                    descriptor(), uv_err_name(err), uv_strerror(err));
+        }
+        recv_started_ = false;
+    }
+
     if (fully_closed_()) {
         return AsyncOp_Completed;
     }
@@ -179,6 +229,23 @@ void UdpSenderPort::write(const packet::PacketPtr& pp) {
 void UdpSenderPort::write_(const packet::PacketPtr& pp) {
     const bool had_pending = (++pending_packets_ > 1);
 
+#ifdef ROC_TARGET_IO_URING
+    if (uring_send_started_) {
+        // io_uring passes queued packets to kernel in batches from event loop
+        // thread, so we don't try to send packet right here, and wake up event
+        // loop only if it isn't already going to process the queue
+        queue_.push_back(*pp);
+
+        if (uring_wakeup_pending_.exchange(1) == 0) {
+            if (int err = uv_async_send(&write_sem_)) {
+                roc_panic("udp sender: %s: uv_async_send(): [%s] %s", descriptor(),
+                          uv_err_name(err), uv_strerror(err));
+            }
+        }
+        return;
+    }
+#endif // ROC_TARGET_IO_URING
+
     if (!had_pending) {
         if (try_nonblocking_send_(pp)) {
             --pending_packets_;
@@ -201,10 +268,20 @@ void UdpSenderPort::close_cb_(uv_handle_t* handle) {
 
     if (handle == (uv_handle_t*)&self.handle_) {
         self.handle_initialized_ = false;
-    } else {
+    } else if (handle == (uv_handle_t*)&self.write_sem_) {
         self.write_sem_initialized_ = false;
     }
 
+#ifdef ROC_TARGET_IO_URING
+    if (handle == (uv_handle_t*)&self.uring_poll_) {
+        self.uring_poll_initialized_ = false;
+    }
+
+    if (self.uring_poll_initialized_) {
+        return;
+    }
+#endif // ROC_TARGET_IO_URING
+
     if (self.handle_initialized_ || self.write_sem_initialized_) {
         return;
     }
@@ -222,6 +299,16 @@ void UdpSenderPort::write_sem_cb_(uv_async_t* handle) {
 
     UdpSenderPort& self = *(UdpSenderPort*)handle->data;
 
+#ifdef ROC_TARGET_IO_URING
+    if (self.uring_send_started_) {
+        // reset flag before processing queue, so that packets added after
+        // we stop processing will schedule another wake up
+        self.uring_wakeup_pending_ = 0;
+        self.uring_send_();
+        return;
+    }
+#endif // ROC_TARGET_IO_URING
+
     // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
     // try_pop_front_exclusive() may return NULL if the queue is not empty, but
     // push_back() is currently in progress. In this case we can exit the loop
@@ -289,8 +376,116 @@ void UdpSenderPort::send_cb_(uv_udp_send_t* req, int status) {
     }
 }
 
+void UdpSenderPort::alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf) {
+    roc_panic_if_not(handle);
+    roc_panic_if_not(buf);
+
+    UdpSenderPort& self = *(UdpSenderPort*)handle->data;
+
+    core::SharedPtr<core::Buffer<uint8_t> > bp = self.buffer_factory_.new_buffer();
+    if (!bp) {
+        roc_log(LogError, "udp sender: %s: can't allocate buffer", self.descriptor());
+
+        buf->base = NULL;
+        buf->len = 0;
+
+        return;
+    }
+
+    if (size > bp->size()) {
+        size = bp->size();
+    }
+
+    bp->incref(); // will be decremented in recv_cb_()
+
+    buf->base = (char*)bp->data();
+    buf->len = size;
+}
+
+void UdpSenderPort::recv_cb_(uv_udp_t* handle,
+                             ssize_t nread,
+                             const uv_buf_t* buf,
+                             const sockaddr* sockaddr,
+                             unsigned flags) {
+    roc_panic_if_not(handle);
+    roc_panic_if_not(buf);
+
+    UdpSenderPort& self = *(UdpSenderPort*)handle->data;
+
+    if (!buf->base) {
+        return;
+    }
+
+    core::SharedPtr<core::Buffer<uint8_t> > bp =
+        core::Buffer<uint8_t>::container_of(buf->base);
+
+    // one reference for incref() called from alloc_cb_()
+    // one reference for the shared pointer above
+    roc_panic_if(bp->getref() != 2);
+
+    // decrement reference counter incremented in alloc_cb_()
+    bp->decref();
+
+    if (nread < 0) {
+        roc_log(LogError, "udp sender: %s: network error: nread=%ld", self.descriptor(),
+                (long)nread);
+        return;
+    }
+
+    if (nread == 0 || !sockaddr) {
+        return;
+    }
+
+    if (flags & UV_UDP_PARTIAL) {
+        roc_log(LogDebug, "udp sender: %s: ignoring partial read: nread=%ld",
+                self.descriptor(), (long)nread);
+        return;
+    }
+
+    if ((size_t)nread > bp->size()) {
+        roc_panic("udp sender: %s: unexpected buffer size: got %ld, max %ld",
+                  self.descriptor(), (long)nread, (long)bp->size());
+    }
+
+    address::SocketAddr src_addr;
+    if (!src_addr.set_host_port_saddr(sockaddr)) {
+        roc_log(LogError, "udp sender: %s: can't determine source address",
+                self.descriptor());
+        return;
+    }
+
+    packet::PacketPtr pp = self.packet_factory_.new_packet();
+    if (!pp) {
+        roc_log(LogError, "udp sender: %s: can't allocate packet", self.descriptor());
+        return;
+    }
+
+    self.recv_packets_++;
+
+    roc_log(LogTrace, "udp sender: %s: received packet: num=%u src=%s dst=%s nread=%ld",
+            self.descriptor(), self.recv_packets_,
+            address::socket_addr_to_str(src_addr).c_str(),
+            address::socket_addr_to_str(self.config_.bind_address).c_str(),
+            (long)nread);
+
+    pp->add_flags(packet::Packet::FlagUDP);
+
+    pp->udp()->src_addr = src_addr;
+    pp->udp()->dst_addr = self.config_.bind_address;
+    pp->udp()->receive_timestamp = core::timestamp(core::ClockUnix);
+
+    pp->set_data(core::Slice<uint8_t>(*bp, 0, (size_t)nread));
+
+    self.inbound_writer_->write(pp);
+}
+
 bool UdpSenderPort::fully_closed_() const {
-    if (!handle_initialized_ && !write_sem_initialized_) {
+    bool initialized = handle_initialized_ || write_sem_initialized_;
+#ifdef ROC_TARGET_IO_URING
+    initialized = initialized || uring_poll_initialized_;
+#endif // ROC_TARGET_IO_URING
+
+    if (!initialized) {
         return true;
     }
 
@@ -315,6 +510,12 @@ void UdpSenderPort::start_closing_() {
     if (write_sem_initialized_ && !uv_is_closing((uv_handle_t*)&write_sem_)) {
         uv_close((uv_handle_t*)&write_sem_, close_cb_);
     }
+
+#ifdef ROC_TARGET_IO_URING
+    if (uring_poll_initialized_ && !uv_is_closing((uv_handle_t*)&uring_poll_)) {
+        uv_close((uv_handle_t*)&uring_poll_, close_cb_);
+    }
+#endif // ROC_TARGET_IO_URING
 }
 
 bool UdpSenderPort::try_nonblocking_send_(const packet::PacketPtr& pp) {
@@ -339,6 +540,112 @@ bool UdpSenderPort::try_nonblocking_send_(const packet::PacketPtr& pp) {
     return success;
 }
 
+#ifdef ROC_TARGET_IO_URING
+
+void UdpSenderPort::uring_poll_cb_(uv_poll_t* handle, int status, int events) {
+    roc_panic_if_not(handle);
+
+    UdpSenderPort& self = *(UdpSenderPort*)handle->data;
+
+    (void)events;
+
+    if (status < 0) {
+        roc_log(LogError, "udp sender: %s: uv_poll(): [%s] %s", self.descriptor(),
+                uv_err_name(status), uv_strerror(status));
+        return;
+    }
+
+    self.uring_sender_->clear_event();
+
+    packet::PacketPtr pp;
+    int result = 0;
+
+    while (self.uring_sender_->reap(pp, result)) {
+        if (result < 0) {
+            roc_log(LogError,
+                    "udp sender: %s:"
+                    " can't send packet: src=%s dst=%s sz=%ld: %s",
+                    self.descriptor(),
+                    address::socket_addr_to_str(self.config_.bind_address).c_str(),
+                    address::socket_addr_to_str(pp->udp()->dst_addr).c_str(),
+                    (long)pp->data().size(), core::errno_to_str(-result).c_str());
+        }
+
+        --self.pending_packets_;
+    }
+
+    // slots were freed, continue with packets that didn't fit before
+    self.uring_send_();
+
+    if (self.pending_packets_ == 0 && self.stopped_) {
+        self.start_closing_();
+    }
+}
+
+bool UdpSenderPort::start_uring_send_() {
+    uring_sender_.reset(new (uring_sender_) IoUringSender());
+
+    if (!uring_sender_->valid()) {
+        uring_sender_.reset();
+        return false;
+    }
+
+    uring_sender_->start(fd_);
+
+    if (int err = uv_poll_init(&loop_, &uring_poll_, uring_sender_->event_fd())) {
+        roc_log(LogError, "udp sender: %s: uv_poll_init(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        uring_sender_.reset();
+        return false;
+    }
+
+    uring_poll_.data = this;
+    uring_poll_initialized_ = true;
+
+    // poll handle is closed in start_closing_()
+    if (int err = uv_poll_start(&uring_poll_, UV_READABLE, uring_poll_cb_)) {
+        roc_log(LogError, "udp sender: %s: uv_poll_start(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    uring_send_started_ = true;
+
+    roc_log(LogDebug, "udp sender: %s: sending via io_uring", descriptor());
+
+    return true;
+}
+
+void UdpSenderPort::uring_send_() {
+    // see comment in write_sem_cb_() regarding try_pop_front_exclusive();
+    // packets that don't fit into ring stay in queue until uring_poll_cb_()
+    while (uring_sender_->can_send()) {
+        packet::PacketPtr pp = queue_.try_pop_front_exclusive();
+        if (!pp) {
+            break;
+        }
+
+        const int packet_num = ++sent_packets_;
+        ++sent_packets_blk_;
+
+        roc_log(LogTrace, "udp sender: %s: sending packet: num=%d src=%s dst=%s sz=%ld",
+                descriptor(), packet_num,
+                address::socket_addr_to_str(config_.bind_address).c_str(),
+                address::socket_addr_to_str(pp->udp()->dst_addr).c_str(),
+                (long)pp->data().size());
+
+        uring_sender_->send(pp);
+    }
+
+    // whole batch is passed to kernel with one system call
+    if (!uring_sender_->flush()) {
+        roc_log(LogError, "udp sender: %s: can't submit packets to io_uring",
+                descriptor());
+    }
+}
+
+#endif // ROC_TARGET_IO_URING
+
 void UdpSenderPort::report_stats_() {
     if (!rate_limiter_.allow()) {
         return;
@@ -16,12 +16,19 @@
 
 #include "roc_address/socket_addr.h"
 #include "roc_core/atomic.h"
+#include "roc_core/buffer_factory.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/mpsc_queue.h"
+#include "roc_core/optional.h"
 #include "roc_core/rate_limiter.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
 #include "roc_packet/iwriter.h"
+#include "roc_packet/packet_factory.h"
+
+#ifdef ROC_TARGET_IO_URING
+#include "roc_netio/io_uring_sender.h"
+#endif // ROC_TARGET_IO_URING
 
 namespace roc {
 namespace netio {
@@ -55,12 +62,24 @@ struct UdpSenderConfig {
 };
 
 //! UDP sender.
+//! @remarks
+//!  If @p io_uring is set and io_uring backend is available, all packets are
+//!  queued and passed to kernel in batches via io_uring ring, whose eventfd
+//!  is polled by libuv loop; non-blocking send is not used in this case.
+//!  Otherwise, or if ring can't be used, sender falls back to libuv.
+//!
+//!  If @p inbound_writer is set, sender also receives packets sent to its
+//!  bind address, e.g. reports from receivers, and passes them to the writer.
 class UdpSenderPort : public BasicPort, public packet::IWriter {
 public:
     //! Initialize.
     UdpSenderPort(const UdpSenderConfig& config,
+                  packet::IWriter* inbound_writer,
                   uv_loop_t& event_loop,
-                  core::IAllocator& allocator);
+                  packet::PacketFactory& packet_factory,
+                  core::BufferFactory<uint8_t>& buffer_factory,
+                  core::IAllocator& allocator,
+                  bool io_uring);
 
     //! Destroy.
     ~UdpSenderPort();
@@ -87,6 +106,12 @@ private:
     static void close_cb_(uv_handle_t* handle);
     static void write_sem_cb_(uv_async_t* handle);
     static void send_cb_(uv_udp_send_t* req, int status);
+    static void alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf);
+    static void recv_cb_(uv_udp_t* handle,
+                         ssize_t nread,
+                         const uv_buf_t* buf,
+                         const sockaddr* addr,
+                         unsigned flags);
 
     void write_(const packet::PacketPtr&);
 
@@ -96,18 +121,41 @@ private:
     bool try_nonblocking_send_(const packet::PacketPtr& pp);
     void report_stats_();
 
+#ifdef ROC_TARGET_IO_URING
+    static void uring_poll_cb_(uv_poll_t* handle, int status, int events);
+
+    bool start_uring_send_();
+    void uring_send_();
+#endif // ROC_TARGET_IO_URING
+
     UdpSenderConfig config_;
 
+    packet::IWriter* inbound_writer_;
+
     ICloseHandler* close_handler_;
     void* close_handler_arg_;
 
     uv_loop_t& loop_;
 
+    packet::PacketFactory& packet_factory_;
+    core::BufferFactory<uint8_t>& buffer_factory_;
+
     uv_async_t write_sem_;
     bool write_sem_initialized_;
 
     uv_udp_t handle_;
     bool handle_initialized_;
+    bool recv_started_;
+
+#ifdef ROC_TARGET_IO_URING
+    core::Optional<IoUringSender> uring_sender_;
+    uv_poll_t uring_poll_;
+    bool uring_poll_initialized_;
+    bool uring_send_started_;
+    core::Atomic<int> uring_wakeup_pending_;
+#endif // ROC_TARGET_IO_URING
+
+    const bool io_uring_;
 
     address::SocketAddr address_;
 
@@ -117,6 +165,8 @@ private:
     core::Atomic<int> sent_packets_;
     core::Atomic<int> sent_packets_blk_;
 
+    unsigned recv_packets_;
+
     bool stopped_;
     bool closed_;
 
@@ -11,6 +11,7 @@
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <signal.h>
+#include <string.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <time.h>
@@ -343,6 +344,18 @@ bool socket_setup(SocketHandle sock, const SocketOptions& options) {
     return true;
 }
 
+bool socket_enable_recv_timestamps(SocketHandle sock) {
+    roc_panic_if(sock < 0);
+
+#if defined(SO_TIMESTAMPNS) && defined(SCM_TIMESTAMPNS)
+    // kernel will attach SCM_TIMESTAMPNS control message to every datagram,
+    // which is read by socket_try_recv_from()
+    return set_int_option(sock, SOL_SOCKET, SO_TIMESTAMPNS, "SO_TIMESTAMPNS", 1);
+#else
+    return false;
+#endif
+}
+
 bool socket_bind(SocketHandle sock, address::SocketAddr& local_address) {
     roc_panic_if(sock < 0);
     roc_panic_if(!local_address.has_host_port());
@@ -467,6 +480,83 @@ ssize_t socket_try_recv(SocketHandle sock, void* buf, size_t bufsz) {
     return ret;
 }
 
+ssize_t socket_try_recv_from(SocketHandle sock,
+                             void* buf,
+                             size_t bufsz,
+                             address::SocketAddr& remote_address,
+                             core::nanoseconds_t& timestamp) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!buf);
+
+    sockaddr_storage addr;
+    memset(&addr, 0, sizeof(addr));
+
+    iovec iov;
+    iov.iov_base = buf;
+    iov.iov_len = bufsz;
+
+#if defined(SCM_TIMESTAMPNS)
+    union {
+        cmsghdr align;
+        char data[CMSG_SPACE(sizeof(timespec))];
+    } control;
+#endif
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = &addr;
+    msg.msg_namelen = sizeof(addr);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+#if defined(SCM_TIMESTAMPNS)
+    msg.msg_control = control.data;
+    msg.msg_controllen = sizeof(control.data);
+#endif
+
+    ssize_t ret;
+    while ((ret = recvmsg(sock, &msg, MSG_DONTWAIT)) == -1) {
+        roc_panic_if(is_malformed(errno));
+
+        if (errno != EINTR) {
+            break;
+        }
+    }
+
+    if (ret < 0 && is_ewouldblock(errno)) {
+        return IOErr_WouldBlock;
+    }
+
+    if (ret < 0) {
+        roc_log(LogError, "socket: recvmsg(): %s", core::errno_to_str().c_str());
+        return IOErr_Failure;
+    }
+
+    if (msg.msg_flags & MSG_TRUNC) {
+        roc_log(LogDebug, "socket: recvmsg(): datagram truncated: bufsz=%lu",
+                (unsigned long)bufsz);
+        return IOErr_Failure;
+    }
+
+    if (!remote_address.set_host_port_saddr((const sockaddr*)&addr)) {
+        roc_log(LogError, "socket: recvmsg(): can't determine source address");
+        return IOErr_Failure;
+    }
+
+    timestamp = 0;
+
+#if defined(SCM_TIMESTAMPNS)
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec ts;
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            timestamp = core::nanoseconds_t(ts.tv_sec) * core::Second + ts.tv_nsec;
+        }
+    }
+#endif
+
+    return ret;
+}
+
 #if defined(SO_NOSIGPIPE) || defined(MSG_NOSIGNAL)
 
 // This version is used if either SO_NOSIGPIPE or MSG_NOSIGNAL is available
@@ -14,6 +14,7 @@
 
 #include "roc_address/socket_addr.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/time.h"
 #include "roc_netio/io_error.h"
 #include "roc_netio/socket_options.h"
 
@@ -43,6 +44,12 @@ bool socket_accept(SocketHandle sock,
 //! Set socket options.
 bool socket_setup(SocketHandle sock, const SocketOptions& options);
 
+//! Enable kernel receive timestamps for datagram socket.
+//! @remarks
+//!  Timestamps are reported by socket_try_recv_from().
+//! @returns false if not supported by platform or failed.
+bool socket_enable_recv_timestamps(SocketHandle sock);
+
 //! Bind socket to local address.
 bool socket_bind(SocketHandle sock, address::SocketAddr& local_address);
 
@@ -65,6 +72,19 @@ bool socket_end_connect(SocketHandle sock);
 //! @returns number of bytes read (>= 0) or IOError (< 0).
 ssize_t socket_try_recv(SocketHandle sock, void* buf, size_t bufsz);
 
+//! Try to receive datagram from socket without blocking.
+//! @remarks
+//!  Sets @p remote_address to sender address, and @p timestamp to kernel
+//!  receive timestamp in nanoseconds since Unix epoch, or to zero if it's
+//!  not available (see socket_enable_recv_timestamps()).
+//!  Truncated datagrams are dropped and reported as IOErr_Failure.
+//! @returns number of bytes read (>= 0) or IOError (< 0).
+ssize_t socket_try_recv_from(SocketHandle sock,
+                             void* buf,
+                             size_t bufsz,
+                             address::SocketAddr& remote_address,
+                             core::nanoseconds_t& timestamp);
+
 //! Try to write bytes to socket without blocking.
 //! @returns number of bytes written (>= 0) or IOError (< 0).
 ssize_t socket_try_send(SocketHandle sock, const void* buf, size_t bufsz);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/block_interleaver.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+BlockInterleaver::BlockInterleaver(IWriter& writer,
+                                   core::IAllocator& allocator,
+                                   size_t max_depth,
+                                   size_t max_block_length)
+    : writer_(writer)
+    , max_depth_(max_depth)
+    , max_block_length_(max_block_length)
+    , next_depth_(max_depth)
+    , packets_(allocator)
+    , block_counts_(allocator)
+    , has_group_(false)
+    , group_sbn_(0)
+    , group_depth_(0)
+    , group_size_(0)
+    , valid_(false) {
+    roc_panic_if_msg(max_depth == 0, "block interleaver: max_depth can't be zero");
+    roc_panic_if_msg(max_block_length == 0,
+                     "block interleaver: max_block_length can't be zero");
+
+    if (!packets_.resize(max_depth_ * max_block_length_)) {
+        return;
+    }
+    if (!block_counts_.resize(max_depth_)) {
+        return;
+    }
+
+    roc_log(LogDebug, "block interleaver: initializing: max_depth=%lu max_blen=%lu",
+            (unsigned long)max_depth_, (unsigned long)max_block_length_);
+
+    valid_ = true;
+}
+
+bool BlockInterleaver::valid() const {
+    return valid_;
+}
+
+void BlockInterleaver::write(const PacketPtr& packet) {
+    roc_panic_if_not(valid());
+
+    const FEC* fec = packet->fec();
+
+    if (!fec || fec->encoding_symbol_id >= max_block_length_) {
+        writer_.write(packet);
+        return;
+    }
+
+    if (has_group_) {
+        const blknum_diff_t blk = blknum_diff(fec->source_block_number, group_sbn_);
+
+        if (blk < 0) {
+            writer_.write(packet);
+            return;
+        }
+
+        if ((size_t)blk >= group_depth_) {
+            end_group_();
+        }
+    }
+
+    if (!has_group_) {
+        if (next_depth_ == 1 || fec->encoding_symbol_id != 0) {
+            writer_.write(packet);
+            return;
+        }
+        begin_group_(fec->source_block_number);
+    }
+
+    const size_t blk = (size_t)blknum_diff(fec->source_block_number, group_sbn_);
+    const size_t pos = blk * max_block_length_ + fec->encoding_symbol_id;
+
+    if (packets_[pos]) {
+        writer_.write(packet);
+        return;
+    }
+
+    packets_[pos] = packet;
+    group_size_++;
+    block_counts_[blk]++;
+
+    // last block of group is complete
+    if (blk == group_depth_ - 1 && block_counts_[blk] >= fec->block_length) {
+        end_group_();
+    }
+}
+
+void BlockInterleaver::flush() {
+    roc_panic_if_not(valid());
+
+    if (has_group_) {
+        end_group_();
+    }
+}
+
+void BlockInterleaver::set_depth(size_t depth) {
+    if (depth < 1) {
+        depth = 1;
+    }
+    if (depth > max_depth_) {
+        depth = max_depth_;
+    }
+
+    if (next_depth_ != depth) {
+        roc_log(LogDebug, "block interleaver: changing depth: %lu->%lu",
+                (unsigned long)next_depth_, (unsigned long)depth);
+    }
+
+    next_depth_ = depth;
+}
+
+size_t BlockInterleaver::depth() const {
+    return next_depth_;
+}
+
+size_t BlockInterleaver::max_depth() const {
+    return max_depth_;
+}
+
+void BlockInterleaver::begin_group_(blknum_t sbn) {
+    has_group_ = true;
+    group_sbn_ = sbn;
+    group_depth_ = next_depth_;
+    group_size_ = 0;
+}
+
+void BlockInterleaver::end_group_() {
+    // send packets column-wise
+    for (size_t esi = 0; esi < max_block_length_ && group_size_ != 0; esi++) {
+        for (size_t blk = 0; blk < group_depth_; blk++) {
+            PacketPtr& pp = packets_[blk * max_block_length_ + esi];
+            if (pp) {
+                writer_.write(pp);
+                pp = NULL;
+                group_size_--;
+            }
+        }
+    }
+
+    for (size_t blk = 0; blk < group_depth_; blk++) {
+        block_counts_[blk] = 0;
+    }
+
+    has_group_ = false;
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/block_interleaver.h
+//! @brief Interleaves packets of several FEC blocks.
+
+#ifndef ROC_PACKET_BLOCK_INTERLEAVER_H_
+#define ROC_PACKET_BLOCK_INTERLEAVER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace packet {
+
+//! Interleaves packets of several FEC blocks.
+//! @remarks
+//!  Buffers a group of consecutive FEC blocks and sends their packets
+//!  column-wise: first packet of every block, then second packet of every
+//!  block, and so on. Loss burst of N packets then hits each block of the
+//!  group with about N/depth packets, so that every block can be repaired
+//!  with fewer repair packets.
+//!
+//!  Depth is the number of blocks in a group. It can be changed at any
+//!  time, and the new value is applied when the next group begins. Depth 1
+//!  disables interleaving.
+//!
+//!  Packets are reordered only within a group, so receiver sees reordering
+//!  distance of at most depth * block_length packets and has to buffer
+//!  that many packets before repairing a block.
+//!
+//!  Groups always begin with the first packet of a block. Packets that
+//!  arrive between groups with depth 1, packets without FEC fields, and
+//!  packets that don't fit the buffer are passed through as is.
+class BlockInterleaver : public IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p writer receives reordered packets
+    //!  - @p allocator is used to allocate group buffer
+    //!  - @p max_depth defines maximum number of blocks in group
+    //!  - @p max_block_length defines maximum number of source and repair
+    //!    packets in block
+    BlockInterleaver(IWriter& writer,
+                     core::IAllocator& allocator,
+                     size_t max_depth,
+                     size_t max_block_length);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Write next packet.
+    //! @remarks
+    //!  Packet is added to current group. When group is complete, all its
+    //!  packets are sent to output writer.
+    virtual void write(const PacketPtr& packet);
+
+    //! Send all buffered packets to output writer.
+    void flush();
+
+    //! Set number of blocks in group.
+    //! @remarks
+    //!  Applied when next group begins. Clamped to [1; max_depth].
+    void set_depth(size_t depth);
+
+    //! Get number of blocks in group.
+    //! @remarks
+    //!  Initially equal to max_depth.
+    size_t depth() const;
+
+    //! Get maximum number of blocks in group.
+    size_t max_depth() const;
+
+private:
+    void begin_group_(blknum_t sbn);
+    void end_group_();
+
+    IWriter& writer_;
+
+    const size_t max_depth_;
+    const size_t max_block_length_;
+
+    size_t next_depth_;
+
+    // Packets of current group, indexed by (block * max_block_length + esi).
+    core::Array<PacketPtr> packets_;
+
+    // Number of packets buffered for every block of current group.
+    core::Array<size_t> block_counts_;
+
+    bool has_group_;
+    blknum_t group_sbn_;
+    size_t group_depth_;
+    size_t group_size_;
+
+    bool valid_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_BLOCK_INTERLEAVER_H_
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/deduplicator.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+Deduplicator::Deduplicator(IWriter& writer)
+    : writer_(writer)
+    , newest_(0)
+    , started_(false)
+    , n_passed_(0)
+    , n_duplicate_(0) {
+    memset(window_, 0, sizeof(window_));
+}
+
+void Deduplicator::write(const PacketPtr& packet) {
+    if (!packet) {
+        roc_panic("deduplicator: unexpected null packet");
+    }
+
+    if (packet->rtp() && !check_and_set_(packet->rtp()->seqnum)) {
+        roc_log(LogTrace, "deduplicator: dropping duplicate packet: sn=%lu",
+                (unsigned long)packet->rtp()->seqnum);
+        n_duplicate_++;
+        return;
+    }
+
+    n_passed_++;
+    writer_.write(packet);
+}
+
+size_t Deduplicator::n_passed_packets() const {
+    return n_passed_;
+}
+
+size_t Deduplicator::n_duplicate_packets() const {
+    return n_duplicate_;
+}
+
+bool Deduplicator::check_and_set_(seqnum_t sn) {
+    if (!started_) {
+        started_ = true;
+        newest_ = sn;
+        set_(sn);
+        return true;
+    }
+
+    const seqnum_diff_t dist = seqnum_diff(sn, newest_);
+
+    if (dist > 0) {
+        advance_(sn);
+        set_(sn);
+        return true;
+    }
+
+    if (-dist >= (seqnum_diff_t)WindowSize) {
+        // too old to be remembered
+        return true;
+    }
+
+    if (test_(sn)) {
+        return false;
+    }
+
+    set_(sn);
+    return true;
+}
+
+void Deduplicator::advance_(seqnum_t sn) {
+    const seqnum_diff_t dist = seqnum_diff(sn, newest_);
+
+    if (dist >= (seqnum_diff_t)WindowSize) {
+        memset(window_, 0, sizeof(window_));
+    } else {
+        // forget seqnums that leave the window
+        for (seqnum_t n = seqnum_t(newest_ + 1); n != seqnum_t(sn + 1); n++) {
+            clear_(n);
+        }
+    }
+
+    newest_ = sn;
+}
+
+bool Deduplicator::test_(seqnum_t sn) const {
+    const size_t pos = sn % WindowSize;
+    return (window_[pos / WordBits] >> (pos % WordBits)) & 1;
+}
+
+void Deduplicator::set_(seqnum_t sn) {
+    const size_t pos = sn % WindowSize;
+    window_[pos / WordBits] |= uint64_t(1) << (pos % WordBits);
+}
+
+void Deduplicator::clear_(seqnum_t sn) {
+    const size_t pos = sn % WindowSize;
+    window_[pos / WordBits] &= ~(uint64_t(1) << (pos % WordBits));
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/deduplicator.h
+//! @brief Drops duplicate packets.
+
+#ifndef ROC_PACKET_DEDUPLICATOR_H_
+#define ROC_PACKET_DEDUPLICATOR_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace packet {
+
+//! Drops duplicate packets.
+//! @remarks
+//!  Remembers seqnums of recently passed RTP packets in a bitmap window
+//!  that follows the newest seqnum, so that duplicate check is O(1).
+//!  Used when the same stream is delivered over several network paths:
+//!  whichever copy arrives first is passed to output writer.
+//!
+//!  Packets without RTP header, and packets older than the window, are
+//!  passed as is, because they can't be checked.
+class Deduplicator : public IWriter, public core::NonCopyable<> {
+public:
+    //! Number of seqnums remembered.
+    enum { WindowSize = 1024 };
+
+    //! Initialize.
+    explicit Deduplicator(IWriter& writer);
+
+    //! Write packet.
+    //! @remarks
+    //!  Passes packet to output writer unless it's a duplicate.
+    virtual void write(const PacketPtr& packet);
+
+    //! Get number of packets passed to output writer.
+    size_t n_passed_packets() const;
+
+    //! Get number of dropped duplicates.
+    size_t n_duplicate_packets() const;
+
+private:
+    enum { WordBits = 64, NumWords = WindowSize / WordBits };
+
+    bool check_and_set_(seqnum_t sn);
+    void advance_(seqnum_t sn);
+
+    bool test_(seqnum_t sn) const;
+    void set_(seqnum_t sn);
+    void clear_(seqnum_t sn);
+
+    IWriter& writer_;
+
+    uint64_t window_[NumWords];
+
+    seqnum_t newest_;
+    bool started_;
+
+    size_t n_passed_;
+    size_t n_duplicate_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_DEDUPLICATOR_H_
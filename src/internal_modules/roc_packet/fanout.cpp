@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/fanout.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+Fanout::Fanout(PacketFactory& packet_factory, core::IAllocator& allocator)
+    : packet_factory_(packet_factory)
+    , writers_(allocator) {
+}
+
+size_t Fanout::num_outputs() const {
+    return writers_.size();
+}
+
+bool Fanout::add_output(IWriter& writer) {
+    if (!writers_.grow_exp(writers_.size() + 1)) {
+        roc_log(LogError, "packet fanout: can't allocate output");
+        return false;
+    }
+
+    writers_.push_back(&writer);
+    return true;
+}
+
+void Fanout::remove_output(IWriter& writer) {
+    for (size_t n = 0; n < writers_.size(); n++) {
+        if (writers_[n] != &writer) {
+            continue;
+        }
+
+        for (; n + 1 < writers_.size(); n++) {
+            writers_[n] = writers_[n + 1];
+        }
+
+        if (!writers_.resize(writers_.size() - 1)) {
+            roc_panic("packet fanout: can't remove output");
+        }
+        return;
+    }
+
+    roc_panic("packet fanout: can't remove output: writer not found");
+}
+
+void Fanout::write(const PacketPtr& packet) {
+    if (!packet) {
+        roc_panic("packet fanout: unexpected null packet");
+    }
+
+    PacketPtr pp = packet;
+
+    for (size_t n = 0; n < writers_.size(); n++) {
+        if (n != 0) {
+            // clone previous packet instead of original one: if previous
+            // writer composed it, the clone is marked as composed too
+            if (!(pp = clone_(*pp))) {
+                roc_log(LogError, "packet fanout: can't allocate packet, dropping");
+                return;
+            }
+        }
+
+        writers_[n]->write(pp);
+    }
+}
+
+PacketPtr Fanout::clone_(const Packet& packet) {
+    PacketPtr pp = packet_factory_.new_packet();
+    if (!pp) {
+        return NULL;
+    }
+
+    // UDP header is per-writer and is not copied
+    pp->add_flags(packet.flags() & ~unsigned(Packet::FlagUDP));
+
+    if (packet.rtp()) {
+        *pp->rtp() = *packet.rtp();
+    }
+
+    if (packet.fec()) {
+        *pp->fec() = *packet.fec();
+    }
+
+    if (packet.rtcp()) {
+        *pp->rtcp() = *packet.rtcp();
+    }
+
+    pp->set_data(packet.data());
+
+    return pp;
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/fanout.h
+//! @brief Duplicate packets to multiple writers.
+
+#ifndef ROC_PACKET_FANOUT_H_
+#define ROC_PACKET_FANOUT_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace packet {
+
+//! Duplicate packets to multiple writers.
+//!
+//! The first writer receives the original packet. Every other writer receives
+//! a new packet object that shares data buffer with the original one, so that
+//! each writer may assign its own UDP address, but payload is neither copied
+//! nor composed more than once.
+//!
+//! Writers should not modify packet data after the packet was composed.
+class Fanout : public IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    Fanout(PacketFactory& packet_factory, core::IAllocator& allocator);
+
+    //! Get number of outputs.
+    size_t num_outputs() const;
+
+    //! Add output writer.
+    bool add_output(IWriter& writer);
+
+    //! Remove output writer.
+    void remove_output(IWriter& writer);
+
+    //! Write packet.
+    //! @remarks
+    //!  Writes packet to every output writer.
+    virtual void write(const PacketPtr& packet);
+
+private:
+    PacketPtr clone_(const Packet& packet);
+
+    PacketFactory& packet_factory_;
+
+    core::Array<IWriter*, 2> writers_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_FANOUT_H_
@@ -32,6 +32,9 @@ enum FecScheme {
 };
 
 //! FECFRAME packet.
+//! @remarks
+//!  Fields used by compare() go first, and block number is placed into
+//!  padding after scheme, to keep the structure compact.
 struct FEC {
     //! The FEC scheme to which the packet belongs to.
     //!
@@ -39,6 +42,14 @@ struct FEC {
     //!  Defines both FEC header or footer format and FEC payalod format.
     FecScheme fec_scheme;
 
+    //! Number of a source block in a packet stream.
+    //!
+    //! @remarks
+    //!  Source block is formed from the source packets.
+    //!  Blocks are numbered sequentially starting from a random number.
+    //!  Block number can wrap.
+    blknum_t source_block_number;
+
     //! The index number of packet in a block.
     //!
     //! @remarks
@@ -48,14 +59,6 @@ struct FEC {
     //!  n is a number of repair packets per block.
     size_t encoding_symbol_id;
 
-    //! Number of a source block in a packet stream.
-    //!
-    //! @remarks
-    //!  Source block is formed from the source packets.
-    //!  Blocks are numbered sequentially starting from a random number.
-    //!  Block number can wrap.
-    blknum_t source_block_number;
-
     //! Number of source packets in the block to which this packet belongs to.
     //!
     //! @remarks
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/jitter_estimator.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+// Gain parameter from RFC 3550.
+const core::nanoseconds_t JitterGain = 16;
+
+} // namespace
+
+JitterEstimator::JitterEstimator(IWriter& writer, const audio::SampleSpec& sample_spec)
+    : writer_(writer)
+    , sample_spec_(sample_spec)
+    , jitter_(0)
+    , prev_recv_ts_(0)
+    , prev_rtp_ts_(0)
+    , n_packets_(0) {
+}
+
+void JitterEstimator::write(const PacketPtr& packet) {
+    if (!packet) {
+        roc_panic("jitter estimator: unexpected null packet");
+    }
+
+    update_(*packet);
+
+    writer_.write(packet);
+}
+
+core::nanoseconds_t JitterEstimator::jitter() const {
+    return jitter_;
+}
+
+timestamp_t JitterEstimator::rtp_jitter() const {
+    return (timestamp_t)sample_spec_.ns_2_rtp_timestamp(jitter_);
+}
+
+size_t JitterEstimator::n_packets() const {
+    return n_packets_;
+}
+
+void JitterEstimator::update_(const Packet& packet) {
+    const UDP* udp = packet.udp();
+    const RTP* rtp = packet.rtp();
+
+    if (!udp || !rtp || udp->receive_timestamp == 0) {
+        return;
+    }
+
+    if (n_packets_ != 0) {
+        // D(i,j) = (Rj - Ri) - (Sj - Si)
+        const core::nanoseconds_t recv_delta = udp->receive_timestamp - prev_recv_ts_;
+        const core::nanoseconds_t send_delta =
+            sample_spec_.rtp_timestamp_2_ns(timestamp_diff(rtp->timestamp, prev_rtp_ts_));
+
+        core::nanoseconds_t d = recv_delta - send_delta;
+        if (d < 0) {
+            d = -d;
+        }
+
+        // J(i) = J(i-1) + (|D(i-1,i)| - J(i-1))/16
+        jitter_ += (d - jitter_) / JitterGain;
+    }
+
+    prev_recv_ts_ = udp->receive_timestamp;
+    prev_rtp_ts_ = rtp->timestamp;
+
+    n_packets_++;
+}
+
+} // namespace packet
+} // namespace roc
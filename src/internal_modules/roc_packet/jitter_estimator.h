@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/jitter_estimator.h
+//! @brief Interarrival jitter estimator.
+
+#ifndef ROC_PACKET_JITTER_ESTIMATOR_H_
+#define ROC_PACKET_JITTER_ESTIMATOR_H_
+
+#include "roc_audio/sample_spec.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/time.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace packet {
+
+//! Interarrival jitter estimator.
+//! @remarks
+//!  Computes interarrival jitter as defined in RFC 3550, section 6.4.1,
+//!  using packet receive timestamps and RTP timestamps, and passes packets
+//!  to the next writer unchanged.
+//!
+//!  Receive timestamps are taken from UDP header, where they are set by
+//!  network receiver, preferably from kernel. Packets without UDP or RTP
+//!  headers or without receive timestamp are not taken into account.
+class JitterEstimator : public IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p writer is used to write packets
+    //!  - @p sample_spec is the specifications of incoming packets
+    JitterEstimator(IWriter& writer, const audio::SampleSpec& sample_spec);
+
+    //! Write packet.
+    virtual void write(const PacketPtr& packet);
+
+    //! Get estimated jitter, in nanoseconds.
+    //! @remarks
+    //!  Returns zero until at least two packets are received.
+    core::nanoseconds_t jitter() const;
+
+    //! Get estimated jitter, in RTP timestamp units.
+    //! @remarks
+    //!  This is the value reported in RTCP receiver reports.
+    timestamp_t rtp_jitter() const;
+
+    //! Get number of packets taken into account.
+    size_t n_packets() const;
+
+private:
+    void update_(const Packet& packet);
+
+    IWriter& writer_;
+
+    const audio::SampleSpec sample_spec_;
+
+    core::nanoseconds_t jitter_;
+
+    core::nanoseconds_t prev_recv_ts_;
+    timestamp_t prev_rtp_ts_;
+
+    size_t n_packets_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_JITTER_ESTIMATOR_H_
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/loss_runs.h
+//! @brief Runs of received and lost packets.
+
+#ifndef ROC_PACKET_LOSS_RUNS_H_
+#define ROC_PACKET_LOSS_RUNS_H_
+
+#include "roc_core/stddefs.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace packet {
+
+//! Runs of received and lost packets.
+//! @remarks
+//!  Describes which packets were received and which were lost in a range of
+//!  sequence numbers, as lengths of alternating runs, starting from a run of
+//!  received packets, which may be empty. Runs with even indices are runs of
+//!  received packets, and runs with odd indices are runs of lost packets.
+struct LossRuns {
+    enum {
+        //! Maximum number of runs.
+        MaxRuns = 16
+    };
+
+    //! Sequence number of first packet in range.
+    seqnum_t begin;
+
+    //! Number of runs.
+    size_t n_runs;
+
+    //! Lengths of runs.
+    seqnum_t runs[MaxRuns];
+
+    LossRuns()
+        : begin(0)
+        , n_runs(0) {
+    }
+
+    //! Clear runs and set first sequence number.
+    void reset(seqnum_t begin_seqnum) {
+        begin = begin_seqnum;
+        n_runs = 0;
+    }
+
+    //! Append packets to the end of range.
+    //! @remarks
+    //!  Extends last run if it has same type, or starts a new one.
+    //! @returns
+    //!  false if there is no room for a new run.
+    bool add_run(bool received, seqnum_t length) {
+        if (length == 0) {
+            return true;
+        }
+
+        if (n_runs != 0 && is_received_run(n_runs - 1) == received) {
+            runs[n_runs - 1] = seqnum_t(runs[n_runs - 1] + length);
+            return true;
+        }
+
+        if (n_runs == 0 && !received) {
+            // first run is always a run of received packets
+            runs[n_runs++] = 0;
+        }
+
+        if (n_runs == MaxRuns) {
+            return false;
+        }
+
+        runs[n_runs++] = length;
+        return true;
+    }
+
+    //! Check if run with given index is a run of received packets.
+    static bool is_received_run(size_t index) {
+        return index % 2 == 0;
+    }
+
+    //! Get total number of packets in range.
+    size_t n_packets() const {
+        size_t n = 0;
+        for (size_t i = 0; i < n_runs; i++) {
+            n += runs[i];
+        }
+        return n;
+    }
+
+    //! Get number of lost packets in range.
+    size_t n_lost() const {
+        size_t n = 0;
+        for (size_t i = 1; i < n_runs; i += 2) {
+            n += runs[i];
+        }
+        return n;
+    }
+
+    //! Get length of longest run of lost packets.
+    size_t max_lost_run() const {
+        size_t n = 0;
+        for (size_t i = 1; i < n_runs; i += 2) {
+            if (runs[i] > n) {
+                n = runs[i];
+            }
+        }
+        return n;
+    }
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_LOSS_RUNS_H_
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/loss_tracker.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+LossTracker::LossTracker(IWriter& writer)
+    : writer_(writer)
+    , started_(false)
+    , source_(0)
+    , base_seqnum_(0)
+    , highest_seqnum_(0)
+    , n_received_(0)
+    , expected_prior_(0)
+    , received_prior_(0)
+    , report_begin_(0) {
+    memset(window_, 0, sizeof(window_));
+}
+
+void LossTracker::write(const PacketPtr& packet) {
+    if (!packet) {
+        roc_panic("loss tracker: unexpected null packet");
+    }
+
+    if (const RTP* rtp = packet->rtp()) {
+        update_(*rtp);
+    }
+
+    writer_.write(packet);
+}
+
+source_t LossTracker::source() const {
+    return source_;
+}
+
+size_t LossTracker::n_received() const {
+    return n_received_;
+}
+
+int64_t LossTracker::n_lost() const {
+    if (!started_) {
+        return 0;
+    }
+    return (highest_seqnum_ - base_seqnum_ + 1) - (int64_t)n_received_;
+}
+
+uint32_t LossTracker::ext_highest_seqnum() const {
+    return (uint32_t)highest_seqnum_;
+}
+
+float LossTracker::report_fract_loss() {
+    if (!started_) {
+        return 0;
+    }
+
+    const int64_t expected = highest_seqnum_ - base_seqnum_ + 1;
+
+    const int64_t expected_interval = expected - expected_prior_;
+    const int64_t received_interval = int64_t(n_received_ - received_prior_);
+
+    expected_prior_ = expected;
+    received_prior_ = n_received_;
+
+    const int64_t lost_interval = expected_interval - received_interval;
+
+    if (expected_interval <= 0 || lost_interval <= 0) {
+        return 0;
+    }
+
+    return float(lost_interval) / float(expected_interval);
+}
+
+void LossTracker::report_loss_runs(LossRuns& runs) {
+    runs.reset((seqnum_t)report_begin_);
+
+    if (!started_) {
+        return;
+    }
+
+    int64_t sn = report_begin_;
+
+    while (sn <= highest_seqnum_) {
+        const bool received = get_bit_(sn);
+
+        int64_t end = sn + 1;
+        while (end <= highest_seqnum_ && get_bit_(end) == received) {
+            end++;
+        }
+
+        if (!runs.add_run(received, seqnum_t(end - sn))) {
+            break;
+        }
+
+        sn = end;
+    }
+
+    report_begin_ = sn;
+}
+
+void LossTracker::update_(const RTP& rtp) {
+    if (!started_) {
+        started_ = true;
+        source_ = rtp.source;
+        base_seqnum_ = highest_seqnum_ = report_begin_ = rtp.seqnum;
+        expected_prior_ = 0;
+        received_prior_ = 0;
+        set_bit_(rtp.seqnum, true);
+        n_received_++;
+        return;
+    }
+
+    source_ = rtp.source;
+    n_received_++;
+
+    const int64_t sn = extend_(rtp.seqnum);
+
+    if (sn > highest_seqnum_) {
+        clear_range_(highest_seqnum_ + 1, sn);
+        highest_seqnum_ = sn;
+
+        // window overrun, oldest packets won't be reported as runs
+        if (highest_seqnum_ - report_begin_ >= WindowSize) {
+            report_begin_ = highest_seqnum_ - WindowSize + 1;
+        }
+    }
+
+    if (sn >= report_begin_) {
+        set_bit_(sn, true);
+    }
+}
+
+int64_t LossTracker::extend_(seqnum_t seqnum) const {
+    return highest_seqnum_ + seqnum_diff(seqnum, (seqnum_t)highest_seqnum_);
+}
+
+void LossTracker::clear_range_(int64_t from, int64_t to) {
+    if (to - from >= WindowSize) {
+        memset(window_, 0, sizeof(window_));
+        return;
+    }
+
+    for (int64_t sn = from; sn <= to; sn++) {
+        set_bit_(sn, false);
+    }
+}
+
+bool LossTracker::get_bit_(int64_t ext_seqnum) const {
+    const size_t bit = size_t(ext_seqnum % WindowSize);
+    return (window_[bit / WordBits] >> (bit % WordBits)) & 1;
+}
+
+void LossTracker::set_bit_(int64_t ext_seqnum, bool value) {
+    const size_t bit = size_t(ext_seqnum % WindowSize);
+    if (value) {
+        window_[bit / WordBits] |= (uint32_t(1) << (bit % WordBits));
+    } else {
+        window_[bit / WordBits] &= ~(uint32_t(1) << (bit % WordBits));
+    }
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/loss_tracker.h
+//! @brief Packet loss tracker.
+
+#ifndef ROC_PACKET_LOSS_TRACKER_H_
+#define ROC_PACKET_LOSS_TRACKER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/loss_runs.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace packet {
+
+//! Packet loss tracker.
+//! @remarks
+//!  Tracks RTP sequence numbers of incoming packets and computes loss
+//!  statistics for receiver reports, and passes packets to the next writer
+//!  unchanged.
+//!
+//!  Cumulative loss and fraction lost are computed as defined in RFC 3550,
+//!  appendix A.3. Runs of received and lost packets are kept for a sliding
+//!  window of recent sequence numbers, for RFC 3611 loss RLE reports.
+//!
+//!  Packets without RTP header are not taken into account.
+class LossTracker : public IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p writer is used to write packets
+    explicit LossTracker(IWriter& writer);
+
+    //! Write packet.
+    virtual void write(const PacketPtr& packet);
+
+    //! Get source ID of tracked packets.
+    source_t source() const;
+
+    //! Get number of received packets, including duplicates.
+    size_t n_received() const;
+
+    //! Get cumulative number of lost packets.
+    //! @remarks
+    //!  May be negative if packets were duplicated.
+    int64_t n_lost() const;
+
+    //! Get extended highest sequence number received.
+    //! @remarks
+    //!  Low 16 bits are sequence number, and high 16 bits are number of
+    //!  sequence number cycles.
+    uint32_t ext_highest_seqnum() const;
+
+    //! Get fraction of packets lost since previous call.
+    //! @remarks
+    //!  Returns value in range [0; 1].
+    float report_fract_loss();
+
+    //! Get runs of received and lost packets since previous call.
+    //! @remarks
+    //!  Covers sequence numbers from the end of previously reported range
+    //!  up to highest received sequence number. If the window was overrun,
+    //!  oldest sequence numbers are skipped. If there are more runs than
+    //!  fit into @p runs, the rest is left for the next call.
+    void report_loss_runs(LossRuns& runs);
+
+private:
+    enum {
+        // how many recent sequence numbers are remembered
+        WindowSize = 1024,
+        WordBits = 32
+    };
+
+    void update_(const RTP& rtp);
+
+    int64_t extend_(seqnum_t seqnum) const;
+
+    void clear_range_(int64_t from, int64_t to);
+
+    bool get_bit_(int64_t ext_seqnum) const;
+    void set_bit_(int64_t ext_seqnum, bool value);
+
+    IWriter& writer_;
+
+    bool started_;
+    source_t source_;
+
+    int64_t base_seqnum_;
+    int64_t highest_seqnum_;
+
+    size_t n_received_;
+
+    int64_t expected_prior_;
+    size_t received_prior_;
+
+    int64_t report_begin_;
+    uint32_t window_[WindowSize / WordBits];
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_LOSS_TRACKER_H_
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/pacer.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+Pacer::Pacer(IWriter& writer, core::IAllocator& allocator, const PacerConfig& config)
+    : writer_(writer)
+    , config_(config)
+    , cost_(0)
+    , credit_(0)
+    , now_(0)
+    , queue_(allocator)
+    , queue_head_(0)
+    , queue_size_(0)
+    , n_sent_(0)
+    , n_delayed_(0)
+    , n_forced_(0)
+    , valid_(false) {
+    if (config_.rate_headroom < 1.0f || config_.burst_packets == 0
+        || config_.max_delay <= 0 || config_.max_queue_packets == 0) {
+        roc_log(LogError,
+                "pacer: invalid config: rate_headroom=%.3f burst_packets=%lu"
+                " max_delay=%.3fms max_queue_packets=%lu",
+                (double)config_.rate_headroom, (unsigned long)config_.burst_packets,
+                (double)config_.max_delay / core::Millisecond,
+                (unsigned long)config_.max_queue_packets);
+        return;
+    }
+
+    if (!queue_.resize(config_.max_queue_packets)) {
+        roc_log(LogError, "pacer: can't allocate queue: size=%lu",
+                (unsigned long)config_.max_queue_packets);
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool Pacer::valid() const {
+    return valid_;
+}
+
+void Pacer::set_interval(core::nanoseconds_t interval) {
+    roc_panic_if_not(valid());
+
+    if (interval <= 0) {
+        flush();
+        cost_ = credit_ = 0;
+        return;
+    }
+
+    const core::nanoseconds_t cost =
+        core::nanoseconds_t(double(interval) / double(config_.rate_headroom));
+
+    if (cost == cost_) {
+        return;
+    }
+
+    roc_log(LogDebug, "pacer: setting interval: interval=%.3fms cost=%.3fms burst=%lu",
+            (double)interval / core::Millisecond, (double)cost / core::Millisecond,
+            (unsigned long)config_.burst_packets);
+
+    const bool first = (cost_ == 0);
+
+    cost_ = cost;
+
+    const core::nanoseconds_t max_credit = max_credit_();
+    if (first || credit_ > max_credit) {
+        credit_ = max_credit;
+    }
+
+    drain_();
+}
+
+void Pacer::write(const PacketPtr& packet) {
+    roc_panic_if_not(valid());
+
+    if (!packet) {
+        roc_panic("pacer: unexpected null packet");
+    }
+
+    if (cost_ == 0) {
+        n_sent_++;
+        writer_.write(packet);
+        return;
+    }
+
+    if (queue_size_ == 0 && credit_ >= cost_) {
+        credit_ -= cost_;
+        n_sent_++;
+        writer_.write(packet);
+        return;
+    }
+
+    if (queue_size_ == queue_.size()) {
+        n_forced_++;
+        send_front_();
+    }
+
+    Entry& entry = queue_[(queue_head_ + queue_size_) % queue_.size()];
+    entry.packet = packet;
+    entry.time = now_;
+    queue_size_++;
+
+    n_delayed_++;
+}
+
+void Pacer::advance(core::nanoseconds_t now) {
+    roc_panic_if_not(valid());
+
+    refill_(now);
+    drain_();
+}
+
+core::nanoseconds_t Pacer::deadline() const {
+    roc_panic_if_not(valid());
+
+    if (queue_size_ == 0) {
+        return 0;
+    }
+
+    const core::nanoseconds_t expire_time = queue_[queue_head_].time + config_.max_delay;
+    const core::nanoseconds_t credit_time = now_ + (cost_ - credit_);
+
+    return expire_time < credit_time ? expire_time : credit_time;
+}
+
+void Pacer::flush() {
+    roc_panic_if_not(valid());
+
+    while (queue_size_ != 0) {
+        send_front_();
+    }
+}
+
+size_t Pacer::queue_size() const {
+    return queue_size_;
+}
+
+size_t Pacer::n_sent_packets() const {
+    return n_sent_;
+}
+
+size_t Pacer::n_delayed_packets() const {
+    return n_delayed_;
+}
+
+size_t Pacer::n_forced_packets() const {
+    return n_forced_;
+}
+
+void Pacer::refill_(core::nanoseconds_t now) {
+    // ignore clock going backwards
+    if (now <= now_) {
+        return;
+    }
+
+    const core::nanoseconds_t max_credit = max_credit_();
+
+    if (now - now_ >= max_credit - credit_) {
+        credit_ = max_credit;
+    } else {
+        credit_ += now - now_;
+    }
+
+    now_ = now;
+}
+
+core::nanoseconds_t Pacer::max_credit_() const {
+    return cost_ * core::nanoseconds_t(config_.burst_packets);
+}
+
+void Pacer::drain_() {
+    while (queue_size_ != 0) {
+        if (credit_ >= cost_) {
+            credit_ -= cost_;
+        } else if (queue_[queue_head_].time + config_.max_delay <= now_) {
+            credit_ = 0;
+            n_forced_++;
+        } else {
+            break;
+        }
+
+        send_front_();
+    }
+}
+
+void Pacer::send_front_() {
+    roc_panic_if(queue_size_ == 0);
+
+    Entry& entry = queue_[queue_head_];
+
+    PacketPtr packet = entry.packet;
+    entry.packet = NULL;
+
+    queue_head_ = (queue_head_ + 1) % queue_.size();
+    queue_size_--;
+
+    n_sent_++;
+    writer_.write(packet);
+}
+
+} // namespace packet
+} // namespace roc
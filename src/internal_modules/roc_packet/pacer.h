@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/pacer.h
+//! @brief Spreads outgoing packets evenly in time.
+
+#ifndef ROC_PACKET_PACER_H_
+#define ROC_PACKET_PACER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/time.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace packet {
+
+//! Pacer parameters.
+struct PacerConfig {
+    //! Pacing rate relative to nominal packet rate.
+    //! @remarks
+    //!  Should be greater than one, so that queue drains even if packets
+    //!  are produced slightly faster than nominal rate.
+    float rate_headroom;
+
+    //! Maximum number of packets sent back-to-back.
+    size_t burst_packets;
+
+    //! Maximum time packet can spend in queue.
+    //! @remarks
+    //!  Packets that waited that long are sent regardless of rate.
+    core::nanoseconds_t max_delay;
+
+    //! Maximum number of packets in queue.
+    //! @remarks
+    //!  When queue is full, oldest packet is sent regardless of rate.
+    size_t max_queue_packets;
+
+    PacerConfig()
+        : rate_headroom(1.25f)
+        , burst_packets(2)
+        , max_delay(20 * core::Millisecond)
+        , max_queue_packets(64) {
+    }
+};
+
+//! Spreads outgoing packets evenly in time.
+//! @remarks
+//!  Packets are released to output writer according to a token bucket:
+//!  tokens are added at nominal packet rate multiplied by headroom, and
+//!  bucket holds at most burst_packets tokens. Packets that can't be sent
+//!  immediately are queued and released later by advance().
+//!
+//!  Pacer has no clock of its own; it's driven by the owner, which passes
+//!  current time to advance() and should call it again not later than
+//!  deadline(). Packets are queued using time passed to the last advance(),
+//!  so the owner should also call advance() right before writing packets.
+//!  When interval is not set, packets are passed through.
+class Pacer : public IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p writer receives paced packets
+    //!  - @p allocator is used to allocate queue
+    //!  - @p config defines pacing parameters
+    Pacer(IWriter& writer, core::IAllocator& allocator, const PacerConfig& config);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Set nominal interval between packets.
+    //! @remarks
+    //!  Usually packet duration multiplied by share of source packets among
+    //!  all packets. Zero disables pacing.
+    void set_interval(core::nanoseconds_t interval);
+
+    //! Write packet.
+    //! @remarks
+    //!  Sends packet immediately if queue is empty and rate permits,
+    //!  otherwise adds it to queue. Uses time passed to the last advance().
+    virtual void write(const PacketPtr& packet);
+
+    //! Advance time and send packets that are due.
+    void advance(core::nanoseconds_t now);
+
+    //! Get time when advance() should be called next.
+    //! @returns
+    //!  0 if queue is empty.
+    core::nanoseconds_t deadline() const;
+
+    //! Send all queued packets.
+    void flush();
+
+    //! Get number of queued packets.
+    size_t queue_size() const;
+
+    //! Get number of packets that were sent.
+    size_t n_sent_packets() const;
+
+    //! Get number of packets that were delayed.
+    size_t n_delayed_packets() const;
+
+    //! Get number of packets that were sent regardless of rate, because
+    //! they waited too long or queue was full.
+    size_t n_forced_packets() const;
+
+private:
+    struct Entry {
+        PacketPtr packet;
+        core::nanoseconds_t time;
+
+        Entry()
+            : time(0) {
+        }
+    };
+
+    core::nanoseconds_t max_credit_() const;
+
+    void refill_(core::nanoseconds_t now);
+    void drain_();
+    void send_front_();
+
+    IWriter& writer_;
+
+    const PacerConfig config_;
+
+    // cost of one packet and current credit, in nanoseconds
+    core::nanoseconds_t cost_;
+    core::nanoseconds_t credit_;
+    core::nanoseconds_t now_;
+
+    // ring buffer of queued packets
+    core::Array<Entry> queue_;
+    size_t queue_head_;
+    size_t queue_size_;
+
+    size_t n_sent_;
+    size_t n_delayed_;
+    size_t n_forced_;
+
+    bool valid_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_PACER_H_
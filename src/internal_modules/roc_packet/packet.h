@@ -127,14 +127,20 @@ public:
     }
 
 private:
+    // Fields are ordered by access frequency. Flags and RTP and FEC headers,
+    // which are used by compare() on every SortedQueue::write() and by
+    // routing, go right after intrusive list and queue nodes, so that RTP
+    // keys share the first two cache lines with them. UDP header, which is
+    // large because of embedded send request, goes last.
     unsigned flags_;
 
-    UDP udp_;
     RTP rtp_;
     FEC fec_;
-    RTCP rtcp_;
 
     core::Slice<uint8_t> data_;
+
+    RTCP rtcp_;
+    UDP udp_;
 };
 
 } // namespace packet
@@ -17,6 +17,7 @@ RTP::RTP()
     , timestamp(0)
     , duration(0)
     , marker(false)
+    , redundancy_size(0)
     , payload_type(0) {
 }
 
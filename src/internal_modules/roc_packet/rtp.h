@@ -50,6 +50,14 @@ struct RTP {
     //!  Marker bit meaning depends on packet type.
     bool marker;
 
+    //! Redundant data size, in bytes.
+    //! @remarks
+    //!  Size of redundant block headers and redundant blocks that immediately
+    //!  precede payload in packets with redundant audio data (RFC 2198). Zero
+    //!  if packet doesn't carry redundant data. Stored as size instead of slice
+    //!  to keep packet small.
+    uint16_t redundancy_size;
+
     //! Packet payload type.
     unsigned int payload_type;
 
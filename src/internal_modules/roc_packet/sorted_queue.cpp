@@ -14,12 +14,14 @@ namespace roc {
 namespace packet {
 
 SortedQueue::SortedQueue(size_t max_size)
-    : max_size_(max_size) {
+    : max_size_(max_size)
+    , next_hint_(0) {
 }
 
 PacketPtr SortedQueue::read() {
     if (PacketPtr packet = list_.back()) {
         list_.remove(*packet);
+        remove_hint_(*packet);
         return packet;
     }
 
@@ -45,6 +47,11 @@ void SortedQueue::write(const PacketPtr& packet) {
 
     PacketPtr pos = list_.front();
 
+    // if packet isn't the newest, it's likely next to recently inserted one
+    if (pos && packet->compare(*pos) < 0 && !find_by_hint_(*packet, pos)) {
+        pos = list_.nextof(*pos);
+    }
+
     for (; pos; pos = list_.nextof(*pos)) {
         const int cmp = packet->compare(*pos);
 
@@ -65,6 +72,8 @@ void SortedQueue::write(const PacketPtr& packet) {
     } else {
         list_.push_back(*packet);
     }
+
+    add_hint_(packet);
 }
 
 size_t SortedQueue::size() const {
@@ -83,5 +92,44 @@ PacketPtr SortedQueue::latest() const {
     return latest_;
 }
 
+bool SortedQueue::find_by_hint_(const Packet& packet, PacketPtr& pos) const {
+    for (size_t n = 0; n < MaxHints; n++) {
+        Packet* hint = hints_[n].get();
+
+        if (!hint) {
+            continue;
+        }
+
+        // packet should go right after hint, i.e. between hint and
+        // next newer packet
+        if (packet.compare(*hint) <= 0) {
+            continue;
+        }
+
+        PacketPtr newer = list_.prevof(*hint);
+        if (newer && packet.compare(*newer) >= 0) {
+            continue;
+        }
+
+        pos = hint;
+        return true;
+    }
+
+    return false;
+}
+
+void SortedQueue::add_hint_(const PacketPtr& packet) {
+    hints_[next_hint_] = packet;
+    next_hint_ = (next_hint_ + 1) % MaxHints;
+}
+
+void SortedQueue::remove_hint_(const Packet& packet) {
+    for (size_t n = 0; n < MaxHints; n++) {
+        if (hints_[n].get() == &packet) {
+            hints_[n] = NULL;
+        }
+    }
+}
+
 } // namespace packet
 } // namespace roc
@@ -24,6 +24,11 @@ namespace packet {
 //! Sorted packet queue.
 //! @remarks
 //!  Packets order is determined by Packet::compare() method.
+//!
+//!  Besides the newest packet, queue remembers a few recently inserted
+//!  packets and first tries to insert new packet right after one of them.
+//!  This keeps insertion cheap when packets of several interleaved streams
+//!  arrive in turn, e.g. when sender interleaves multiple FEC blocks.
 class SortedQueue : public IWriter, public IReader, public core::NonCopyable<> {
 public:
     //! Construct empty queue.
@@ -70,9 +75,18 @@ public:
     PacketPtr latest() const;
 
 private:
+    enum { MaxHints = 8 };
+
+    bool find_by_hint_(const Packet& packet, PacketPtr& pos) const;
+    void add_hint_(const PacketPtr& packet);
+    void remove_hint_(const Packet& packet);
+
     core::List<Packet> list_;
     PacketPtr latest_;
     const size_t max_size_;
+
+    PacketPtr hints_[MaxHints];
+    size_t next_hint_;
 };
 
 } // namespace packet
@@ -17,6 +17,7 @@
 #include "roc_address/socket_addr.h"
 #include "roc_core/slice.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/time.h"
 
 namespace roc {
 namespace packet {
@@ -29,8 +30,18 @@ struct UDP {
     //! Destination address.
     address::SocketAddr dst_addr;
 
+    //! Packet receive timestamp, nanoseconds since Unix epoch.
+    //! @remarks
+    //!  Set by receiver. If supported, it's the time when the packet was
+    //!  received by kernel, otherwise the time when it was read from socket.
+    //!  Zero if unknown.
+    core::nanoseconds_t receive_timestamp;
+
     //! Sender request state.
     uv_udp_send_t request;
+
+    //! Construct zero UDP packet.
+    UDP();
 };
 
 } // namespace packet
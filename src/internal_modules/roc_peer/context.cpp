@@ -15,12 +15,17 @@ namespace peer {
 
 Context::Context(const ContextConfig& config, core::IAllocator& allocator)
     : allocator_(allocator)
-    , packet_factory_(allocator_, false)
-    , byte_buffer_factory_(allocator_, config.max_packet_size, config.poisoning)
+    , arena_allocator_(allocator_, config.arena)
+    , network_allocator_(arena_allocator_, config.network_loop.numa_node)
+    , packet_factory_(network_allocator_, false)
+    , byte_buffer_factory_(network_allocator_, config.max_packet_size, config.poisoning)
     , sample_buffer_factory_(
-          allocator_, config.max_frame_size / sizeof(audio::sample_t), config.poisoning)
-    , network_loop_(packet_factory_, byte_buffer_factory_, allocator_)
-    , control_loop_(network_loop_, allocator_)
+          arena_allocator_,
+          config.max_frame_size / sizeof(audio::sample_t),
+          config.poisoning)
+    , network_loop_(
+          config.network_loop, packet_factory_, byte_buffer_factory_, allocator_)
+    , control_loop_(config.control_loop, network_loop_, allocator_)
     , ref_counter_(0) {
     roc_log(LogDebug, "context: initializing");
 }
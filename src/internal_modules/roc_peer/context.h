@@ -13,9 +13,11 @@
 #define ROC_PEER_CONTEXT_H_
 
 #include "roc_audio/sample.h"
+#include "roc_core/arena_allocator.h"
 #include "roc_core/atomic.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/iallocator.h"
+#include "roc_core/numa_allocator.h"
 #include "roc_ctl/control_loop.h"
 #include "roc_netio/network_loop.h"
 #include "roc_packet/packet_factory.h"
@@ -34,6 +36,18 @@ struct ContextConfig {
     //! Enable memory poisoning.
     bool poisoning;
 
+    //! Memory arena for packet and buffer pools.
+    //! Disabled by default.
+    core::ArenaConfig arena;
+
+    //! Network loop parameters.
+    //! If NUMA node is set, packet and byte buffer pools, which are mostly
+    //! used by network thread, allocate their slabs on that node too.
+    netio::NetworkLoopConfig network_loop;
+
+    //! Control loop parameters.
+    ctl::ControlLoopConfig control_loop;
+
     ContextConfig()
         : max_packet_size(2048)
         , max_frame_size(4096)
@@ -82,6 +96,8 @@ public:
 
 private:
     core::IAllocator& allocator_;
+    core::ArenaAllocator arena_allocator_;
+    core::NumaAllocator network_allocator_;
 
     packet::PacketFactory packet_factory_;
     core::BufferFactory<uint8_t> byte_buffer_factory_;
@@ -50,6 +50,14 @@ Receiver::~Receiver() {
         }
 
         for (size_t p = 0; p < address::Iface_Max; p++) {
+            if (slots_[s].ports[p].outgoing_handle) {
+                netio::NetworkLoop::Tasks::RemovePort task(
+                    slots_[s].ports[p].outgoing_handle);
+                if (!context().network_loop().schedule_and_wait(task)) {
+                    roc_panic("receiver peer: can't remove port");
+                }
+            }
+
             if (!slots_[s].ports[p].handle) {
                 continue;
             }
@@ -219,8 +227,25 @@ bool Receiver::bind(size_t slot_index,
         return false;
     }
 
-    pipeline::ReceiverLoop::Tasks::CreateEndpoint endpoint_task(slot->slot, iface,
-                                                                uri.proto());
+    packet::IWriter* outgoing_writer = NULL;
+
+    if (iface == address::Iface_AudioControl) {
+        // control endpoint sends receiver reports back to senders
+        if (!setup_outgoing_port_(slot->ports[iface], iface,
+                                  resolve_task.get_address().family())) {
+            roc_log(LogError,
+                    "receiver peer:"
+                    " can't bind %s interface of slot %lu:"
+                    " can't bind outgoing port",
+                    address::interface_to_str(iface), (unsigned long)slot_index);
+            return false;
+        }
+
+        outgoing_writer = slot->ports[iface].outgoing_writer;
+    }
+
+    pipeline::ReceiverLoop::Tasks::CreateEndpoint endpoint_task(
+        slot->slot, iface, uri.proto(), outgoing_writer);
     if (!pipeline_.schedule_and_wait(endpoint_task)) {
         roc_log(LogError,
                 "receiver peer:"
@@ -306,6 +331,36 @@ Receiver::Slot* Receiver::get_slot_(size_t slot_index) {
     return &slots_[slot_index];
 }
 
+bool Receiver::setup_outgoing_port_(Port& port,
+                                    address::Interface iface,
+                                    address::AddrFamily family) {
+    if (port.outgoing_handle) {
+        return true;
+    }
+
+    if (family == address::Family_IPv4) {
+        port.outgoing_config.bind_address.set_host_port(address::Family_IPv4, "0.0.0.0",
+                                                        0);
+    } else {
+        port.outgoing_config.bind_address.set_host_port(address::Family_IPv6, "::", 0);
+    }
+
+    netio::NetworkLoop::Tasks::AddUdpSenderPort port_task(port.outgoing_config);
+
+    if (!context().network_loop().schedule_and_wait(port_task)) {
+        return false;
+    }
+
+    port.outgoing_handle = port_task.get_handle();
+    port.outgoing_writer = port_task.get_writer();
+
+    roc_log(LogInfo, "receiver peer: bound outgoing port of %s interface to %s",
+            address::interface_to_str(iface),
+            address::socket_addr_to_str(port.outgoing_config.bind_address).c_str());
+
+    return true;
+}
+
 void Receiver::schedule_task_processing(pipeline::PipelineLoop&,
                                         core::nanoseconds_t deadline) {
     context().control_loop().schedule_at(processing_task_, deadline, NULL);
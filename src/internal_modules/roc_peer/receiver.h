@@ -55,8 +55,15 @@ private:
         netio::UdpReceiverConfig config;
         netio::NetworkLoop::PortHandle handle;
 
+        // used to send packets back to remote peer, e.g. receiver reports
+        netio::UdpSenderConfig outgoing_config;
+        netio::NetworkLoop::PortHandle outgoing_handle;
+        packet::IWriter* outgoing_writer;
+
         Port()
-            : handle(NULL) {
+            : handle(NULL)
+            , outgoing_handle(NULL)
+            , outgoing_writer(NULL) {
         }
     };
 
@@ -74,6 +81,10 @@ private:
 
     Slot* get_slot_(size_t slot_index);
 
+    bool setup_outgoing_port_(Port& port,
+                              address::Interface iface,
+                              address::AddrFamily family);
+
     virtual void schedule_task_processing(pipeline::PipelineLoop&,
                                           core::nanoseconds_t delay);
     virtual void cancel_task_processing(pipeline::PipelineLoop&);
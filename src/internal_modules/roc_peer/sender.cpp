@@ -19,6 +19,7 @@ namespace peer {
 Sender::Sender(Context& context, const pipeline::SenderConfig& pipeline_config)
     : BasicPeer(context)
     , pipeline_(*this,
+                *this,
                 pipeline_config,
                 format_map_,
                 context.packet_factory(),
@@ -26,6 +27,8 @@ Sender::Sender(Context& context, const pipeline::SenderConfig& pipeline_config)
                 context.sample_buffer_factory(),
                 context.allocator())
     , processing_task_(pipeline_)
+    , update_task_(pipeline_)
+    , update_stopped_(false)
     , slots_(context.allocator())
     , valid_(false) {
     roc_log(LogDebug, "sender peer: initializing");
@@ -45,6 +48,16 @@ Sender::~Sender() {
 
     context().control_loop().wait(processing_task_);
 
+    {
+        // update task reschedules itself, so prevent it before cancelling
+        core::Mutex::Lock lock(update_mutex_);
+
+        update_stopped_ = true;
+        context().control_loop().async_cancel(update_task_);
+    }
+
+    context().control_loop().wait(update_task_);
+
     for (size_t s = 0; s < slots_.size(); s++) {
         if (!slots_[s].slot) {
             continue;
@@ -207,24 +220,27 @@ bool Sender::connect(size_t slot_index,
 
     const address::SocketAddr& address = resolve_task.get_address();
 
-    Port& port = select_outgoing_port_(*slot, iface, address.family());
-
-    if (!setup_outgoing_port_(port, iface, address.family())) {
+    // endpoint is created before port, so that port can pass packets
+    // received from network, like receiver reports, to endpoint
+    pipeline::SenderLoop::Tasks::CreateEndpoint endpoint_task(slot->slot, iface,
+                                                              uri.proto());
+    if (!pipeline_.schedule_and_wait(endpoint_task)) {
         roc_log(LogError,
                 "sender peer:"
                 " can't connect %s interface of slot %lu:"
-                " can't bind to local port",
+                " can't add endpoint to pipeline",
                 address::interface_to_str(iface), (unsigned long)slot_index);
         return false;
     }
 
-    pipeline::SenderLoop::Tasks::CreateEndpoint endpoint_task(slot->slot, iface,
-                                                              uri.proto());
-    if (!pipeline_.schedule_and_wait(endpoint_task)) {
+    Port& port = select_outgoing_port_(*slot, iface, address.family());
+
+    if (!setup_outgoing_port_(port, iface, address.family(),
+                              endpoint_task.get_inbound_writer())) {
         roc_log(LogError,
                 "sender peer:"
                 " can't connect %s interface of slot %lu:"
-                " can't add endpoint to pipeline",
+                " can't bind to local port",
                 address::interface_to_str(iface), (unsigned long)slot_index);
         return false;
     }
@@ -367,7 +383,8 @@ Sender::Port& Sender::select_outgoing_port_(Slot& slot,
 
 bool Sender::setup_outgoing_port_(Port& port,
                                   address::Interface iface,
-                                  address::AddrFamily family) {
+                                  address::AddrFamily family,
+                                  packet::IWriter* inbound_writer) {
     if (port.config.bind_address.has_host_port()) {
         if (port.config.bind_address.family() != family) {
             roc_log(LogError,
@@ -393,7 +410,8 @@ bool Sender::setup_outgoing_port_(Port& port,
             }
         }
 
-        netio::NetworkLoop::Tasks::AddUdpSenderPort port_task(port.config);
+        netio::NetworkLoop::Tasks::AddUdpSenderPort port_task(port.config,
+                                                              inbound_writer);
 
         if (!context().network_loop().schedule_and_wait(port_task)) {
             roc_log(LogError, "sender peer: can't bind %s interface to local port",
@@ -421,5 +439,15 @@ void Sender::cancel_task_processing(pipeline::PipelineLoop&) {
     context().control_loop().async_cancel(processing_task_);
 }
 
+void Sender::schedule_update(pipeline::SenderLoop&, core::nanoseconds_t deadline) {
+    core::Mutex::Lock lock(update_mutex_);
+
+    if (update_stopped_) {
+        return;
+    }
+
+    context().control_loop().schedule_at(update_task_, deadline, NULL);
+}
+
 } // namespace peer
 } // namespace roc
@@ -21,6 +21,7 @@
 #include "roc_peer/basic_peer.h"
 #include "roc_peer/context.h"
 #include "roc_pipeline/ipipeline_task_scheduler.h"
+#include "roc_pipeline/isender_update_scheduler.h"
 #include "roc_pipeline/sender_loop.h"
 #include "roc_rtp/format_map.h"
 
@@ -28,7 +29,9 @@ namespace roc {
 namespace peer {
 
 //! Sender peer.
-class Sender : public BasicPeer, private pipeline::IPipelineTaskScheduler {
+class Sender : public BasicPeer,
+               private pipeline::IPipelineTaskScheduler,
+               private pipeline::ISenderUpdateScheduler {
 public:
     //! Initialize.
     Sender(Context& context, const pipeline::SenderConfig& pipeline_config);
@@ -86,12 +89,15 @@ private:
     select_outgoing_port_(Slot& slot, address::Interface, address::AddrFamily family);
     bool setup_outgoing_port_(Port& port,
                               address::Interface iface,
-                              address::AddrFamily family);
+                              address::AddrFamily family,
+                              packet::IWriter* inbound_writer);
 
     virtual void schedule_task_processing(pipeline::PipelineLoop&,
                                           core::nanoseconds_t delay);
     virtual void cancel_task_processing(pipeline::PipelineLoop&);
 
+    virtual void schedule_update(pipeline::SenderLoop&, core::nanoseconds_t deadline);
+
     core::Mutex mutex_;
 
     rtp::FormatMap format_map_;
@@ -99,6 +105,10 @@ private:
     pipeline::SenderLoop pipeline_;
     ctl::ControlLoop::Tasks::PipelineProcessing processing_task_;
 
+    ctl::ControlLoop::Tasks::SenderUpdate update_task_;
+    core::Mutex update_mutex_;
+    bool update_stopped_;
+
     core::Array<Slot, 8> slots_;
 
     bool used_interfaces_[address::Iface_Max];
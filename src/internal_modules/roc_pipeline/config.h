@@ -24,7 +24,9 @@
 #include "roc_core/time.h"
 #include "roc_fec/codec_config.h"
 #include "roc_fec/reader.h"
+#include "roc_fec/redundancy_controller.h"
 #include "roc_fec/writer.h"
+#include "roc_packet/pacer.h"
 #include "roc_packet/units.h"
 #include "roc_rtp/headers.h"
 #include "roc_rtp/validator.h"
@@ -88,12 +90,21 @@ struct TaskConfig {
     //! thread switch overhead, scheduler jitter clock drift, we use a wide interval.
     core::nanoseconds_t task_processing_prohibited_interval;
 
+    //! Busy-poll spin budget.
+    //! When pipeline paces frames itself (timing is enabled), it sleeps until
+    //! next frame is due. If this setting is non-zero, pipeline thread wakes up
+    //! this much earlier and spins until the deadline, which reduces wakeup
+    //! jitter at the cost of CPU time.
+    //! Set to zero to always sleep (default).
+    core::nanoseconds_t busy_poll_budget;
+
     TaskConfig()
         : enable_precise_task_scheduling(true)
         , min_frame_length_between_tasks(200 * core::Microsecond)
         , max_frame_length_between_tasks(DefaultInternalFrameLength)
         , max_inframe_task_processing(20 * core::Microsecond)
-        , task_processing_prohibited_interval(200 * core::Microsecond) {
+        , task_processing_prohibited_interval(200 * core::Microsecond)
+        , busy_poll_budget(0) {
     }
 };
 
@@ -114,6 +125,12 @@ struct SenderConfig {
     //! FEC encoder parameters.
     fec::CodecConfig fec_encoder;
 
+    //! FEC redundancy controller parameters.
+    fec::RedundancyControllerConfig fec_redundancy;
+
+    //! Pacer parameters.
+    packet::PacerConfig pacer;
+
     //! Input sample spec
     audio::SampleSpec input_sample_spec;
 
@@ -132,6 +149,33 @@ struct SenderConfig {
     //! Interleave packets.
     bool interleaving;
 
+    //! Number of FEC blocks to interleave.
+    //! @remarks
+    //!  Used when interleaving is enabled. If 1, packets are shuffled within
+    //!  every block. If greater, packets of that many consecutive blocks are
+    //!  sent column-wise, to spread loss bursts among blocks; receiver latency
+    //!  should cover that many blocks. With fec_adaptation, this is the
+    //!  maximum depth, and actual depth is chosen according to reported bursts.
+    size_t interleaving_depth;
+
+    //! Number of previous packets to repeat in every packet.
+    //! @remarks
+    //!  If non-zero, every packet carries copies of payloads of that many
+    //!  previous packets (RFC 2198), so that receiver can restore a lost
+    //!  packet as soon as next packet arrives. Trades bandwidth for loss
+    //!  protection with almost no added latency. Used only with bare RTP.
+    size_t redundancy_depth;
+
+    //! Adapt number of FEC repair packets to losses reported by receiver.
+    bool fec_adaptation;
+
+    //! Spread outgoing packets evenly in time.
+    //! @remarks
+    //!  If enabled, packets produced in bursts (e.g. repair packets written
+    //!  at the end of FEC block, or interleaved blocks) are delayed so that
+    //!  they are sent at nominal packet rate plus configured headroom.
+    bool pacing;
+
     //! Constrain receiver speed using a CPU timer according to the sample rate.
     bool timing;
 
@@ -153,6 +197,10 @@ struct SenderConfig {
         , payload_type(rtp::PayloadType_L16_Stereo)
         , resampling(false)
         , interleaving(false)
+        , interleaving_depth(1)
+        , redundancy_depth(0)
+        , fec_adaptation(false)
+        , pacing(false)
         , timing(false)
         , poisoning(false)
         , profiling(false) {
@@ -169,6 +217,12 @@ struct ReceiverSessionConfig {
     //! Packet payload type.
     unsigned int payload_type;
 
+    //! Restore lost packets from redundant audio data.
+    //! @remarks
+    //!  Enabled for sessions which first packet carries redundant audio
+    //!  data (RFC 2198).
+    bool enable_redundancy;
+
     //! FEC reader parameters.
     fec::ReaderConfig fec_reader;
 
@@ -188,6 +242,9 @@ struct ReceiverSessionConfig {
     audio::WatchdogConfig watchdog;
 
     //! To specify which resampling backend will be used.
+    //! @remarks
+    //!  If set to default, and session and output sample rates are equal,
+    //!  drift resampler is used.
     audio::ResamplerBackend resampler_backend;
 
     //! Resampler profile.
@@ -196,6 +253,7 @@ struct ReceiverSessionConfig {
     ReceiverSessionConfig()
         : target_latency(DefaultLatency)
         , payload_type(0)
+        , enable_redundancy(false)
         , freq_estimator_config()
         , resampler_backend(audio::ResamplerBackend_Default)
         , resampler_profile(audio::ResamplerProfile_Medium) {
@@ -232,6 +290,21 @@ struct ReceiverCommonConfig {
     //! Insert weird beeps instead of silence on packet loss.
     bool beeping;
 
+    //! Construct new sessions on a background thread.
+    //! When enabled, the pipeline thread doesn't block on session construction;
+    //! packets from a new source are buffered until its session is built and
+    //! attached to the mixer.
+    bool async_session_creation;
+
+    //! Merge copies of the same stream received via multiple paths.
+    //! @remarks
+    //!  When enabled, sessions are shared by all slots and keyed by RTP
+    //!  source (SSRC) instead of sender address, so a stream sent over
+    //!  several networks or multicast groups ends up in one session.
+    //!  Duplicate packets are dropped, and whichever copy arrives first
+    //!  is used.
+    bool multipath;
+
     ReceiverCommonConfig()
         : output_sample_spec(DefaultSampleRate, DefaultChannelMask)
         , internal_frame_length(DefaultInternalFrameLength)
@@ -239,7 +312,9 @@ struct ReceiverCommonConfig {
         , timing(false)
         , poisoning(false)
         , profiling(false)
-        , beeping(false) {
+        , beeping(false)
+        , async_session_creation(false)
+        , multipath(false) {
     }
 };
 
@@ -83,7 +83,8 @@ ConverterSink::ConverterSink(const ConverterConfig& config,
 
     if (config.profiling) {
         profiler_.reset(new (profiler_) audio::ProfilingWriter(
-            *awriter, allocator, config.input_sample_spec, config.profiler_config));
+            *awriter, allocator, config.input_sample_spec, config.profiler_config,
+            "converter"));
         if (!profiler_ || !profiler_->valid()) {
             return;
         }
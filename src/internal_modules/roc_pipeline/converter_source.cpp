@@ -82,7 +82,8 @@ ConverterSource::ConverterSource(const ConverterConfig& config,
 
     if (config.profiling) {
         profiler_.reset(new (profiler_) audio::ProfilingReader(
-            *areader, allocator, config.output_sample_spec, config.profiler_config));
+            *areader, allocator, config.output_sample_spec, config.profiler_config,
+            "converter"));
         if (!profiler_ || !profiler_->valid()) {
             return;
         }
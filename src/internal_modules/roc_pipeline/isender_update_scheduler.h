@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/isender_update_scheduler.h
+//! @brief Sender update scheduler interface.
+
+#ifndef ROC_PIPELINE_ISENDER_UPDATE_SCHEDULER_H_
+#define ROC_PIPELINE_ISENDER_UPDATE_SCHEDULER_H_
+
+#include "roc_core/time.h"
+
+namespace roc {
+namespace pipeline {
+
+class SenderLoop;
+
+//! Sender update scheduler interface.
+//! SenderLoop uses this interface to request timer wakeups between frames.
+//! Method calls may come from different threads, but are serialized.
+class ISenderUpdateScheduler {
+public:
+    virtual ~ISenderUpdateScheduler();
+
+    //! Schedule sender update.
+    //!
+    //! @p sender calls this when it wants SenderLoop::update() to be invoked
+    //! asynchronously at given time, e.g. to send packets delayed by pacer.
+    //!
+    //! @p deadline is an absolute timestamp in nanoseconds from the same clock
+    //! domain as core::timestamp(). It replaces previously scheduled deadline.
+    virtual void schedule_update(SenderLoop& sender, core::nanoseconds_t deadline) = 0;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_ISENDER_UPDATE_SCHEDULER_H_
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/metrics.h
+//! @brief Pipeline metrics.
+
+#ifndef ROC_PIPELINE_METRICS_H_
+#define ROC_PIPELINE_METRICS_H_
+
+#include "roc_audio/frame_status_buffer.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Metrics of receiver session.
+struct ReceiverSessionMetrics {
+    //! RTP source ID of the session.
+    packet::source_t source;
+
+    //! Counters of frames produced by the session.
+    //! Collected by watchdog; zero if watchdog is disabled.
+    audio::FrameCounters frames;
+
+    ReceiverSessionMetrics()
+        : source(0) {
+    }
+};
+
+//! Metrics of sender session.
+struct SenderSessionMetrics {
+    //! RTP source ID of the session.
+    packet::source_t source;
+
+    //! Round-trip time to receiver.
+    //! Measured using receiver reports; zero until first measurement.
+    core::nanoseconds_t rtt;
+
+    SenderSessionMetrics()
+        : source(0)
+        , rtt(0) {
+    }
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_METRICS_H_
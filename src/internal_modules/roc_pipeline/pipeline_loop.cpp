@@ -270,6 +270,18 @@ bool PipelineLoop::process_subframes_and_tasks_precise_(audio::Frame& frame) {
     return frame_res;
 }
 
+void PipelineLoop::lock_pipeline() {
+    pipeline_mutex_.lock();
+}
+
+void PipelineLoop::unlock_pipeline() {
+    pipeline_mutex_.unlock();
+
+    if (pending_frames_ == 0 && pending_tasks_ != 0) {
+        schedule_async_task_processing_();
+    }
+}
+
 void PipelineLoop::schedule_async_task_processing_() {
     core::nanoseconds_t next_frame_deadline;
     if (!next_frame_deadline_.try_load(next_frame_deadline)) {
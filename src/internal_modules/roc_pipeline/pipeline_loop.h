@@ -253,6 +253,17 @@ protected:
     //! Split frame and process subframes and some of the enqueued tasks.
     bool process_subframes_and_tasks(audio::Frame& frame);
 
+    //! Acquire pipeline state outside of frame and task processing.
+    //! @remarks
+    //!  Blocks until currently processed frame or task, if any, is finished.
+    //!  Should be used only for short operations.
+    void lock_pipeline();
+
+    //! Release pipeline state acquired by lock_pipeline().
+    //! @remarks
+    //!  Schedules processing of tasks enqueued meanwhile.
+    void unlock_pipeline();
+
     //! Get current time.
     virtual core::nanoseconds_t timestamp_imp() const = 0;
 
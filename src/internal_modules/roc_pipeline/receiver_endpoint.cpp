@@ -12,6 +12,7 @@
 #include "roc_fec/composer.h"
 #include "roc_fec/headers.h"
 #include "roc_fec/parser.h"
+#include "roc_rtp/headers.h"
 
 namespace roc {
 namespace pipeline {
@@ -25,6 +26,7 @@ ReceiverEndpoint::ReceiverEndpoint(address::Protocol proto,
     , proto_(proto)
     , receiver_state_(receiver_state)
     , session_group_(session_group)
+    , format_map_(format_map)
     , parser_(NULL) {
     packet::IParser* parser = NULL;
 
@@ -126,7 +128,7 @@ void ReceiverEndpoint::pull_packets() {
     // queue were added in a very short time or are being added currently. It's
     // acceptable to consider such packets late and to be pulled next time.
     while (packet::PacketPtr packet = queue_.try_pop_front_exclusive()) {
-        if (!parser_->parse(*packet, packet->data())) {
+        if (!parse_packet_(*packet)) {
             roc_log(LogDebug, "receiver endpoint: can't parse packet");
             continue;
         }
@@ -149,5 +151,27 @@ void ReceiverEndpoint::write(const packet::PacketPtr& packet) {
     queue_.push_back(*packet);
 }
 
+bool ReceiverEndpoint::parse_packet_(packet::Packet& packet) {
+    // Packets with redundant audio data are recognized by payload type.
+    // Redundancy parser is inserted when the first such packet arrives,
+    // so that other streams don't pay for it.
+    if (proto_ == address::Proto_RTP && !redundancy_parser_) {
+        const core::Slice<uint8_t>& data = packet.data();
+
+        if (data.size() >= sizeof(rtp::Header)
+            && ((const rtp::Header*)data.data())->payload_type()
+                == rtp::PayloadType_Redundant) {
+            redundancy_parser_.reset(new (redundancy_parser_) rtp::RedundancyParser(
+                format_map_, *rtp_parser_));
+            if (!redundancy_parser_) {
+                return false;
+            }
+            parser_ = redundancy_parser_.get();
+        }
+    }
+
+    return parser_->parse(packet, packet.data());
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -27,6 +27,7 @@
 #include "roc_rtcp/parser.h"
 #include "roc_rtp/format_map.h"
 #include "roc_rtp/parser.h"
+#include "roc_rtp/redundancy_parser.h"
 
 namespace roc {
 namespace pipeline {
@@ -69,14 +70,19 @@ public:
 private:
     virtual void write(const packet::PacketPtr& packet);
 
+    bool parse_packet_(packet::Packet& packet);
+
     const address::Protocol proto_;
 
     ReceiverState& receiver_state_;
     ReceiverSessionGroup& session_group_;
 
+    const rtp::FormatMap& format_map_;
+
     packet::IParser* parser_;
 
     core::Optional<rtp::Parser> rtp_parser_;
+    core::Optional<rtp::RedundancyParser> redundancy_parser_;
     core::ScopedPtr<packet::IParser> fec_parser_;
     core::Optional<rtcp::Parser> rtcp_parser_;
 
@@ -19,7 +19,8 @@ ReceiverLoop::Task::Task()
     , slot_(NULL)
     , iface_(address::Iface_Invalid)
     , proto_(address::Proto_None)
-    , writer_(NULL) {
+    , writer_(NULL)
+    , outbound_writer_(NULL) {
 }
 
 ReceiverLoop::Tasks::CreateSlot::CreateSlot() {
@@ -36,7 +37,8 @@ ReceiverLoop::SlotHandle ReceiverLoop::Tasks::CreateSlot::get_handle() const {
 
 ReceiverLoop::Tasks::CreateEndpoint::CreateEndpoint(SlotHandle slot,
                                                     address::Interface iface,
-                                                    address::Protocol proto) {
+                                                    address::Protocol proto,
+                                                    packet::IWriter* outbound_writer) {
     func_ = &ReceiverLoop::task_create_endpoint_;
     if (!slot) {
         roc_panic("receiver source: slot handle is null");
@@ -44,6 +46,7 @@ ReceiverLoop::Tasks::CreateEndpoint::CreateEndpoint(SlotHandle slot,
     slot_ = (ReceiverSlot*)slot;
     iface_ = iface;
     proto_ = proto;
+    outbound_writer_ = outbound_writer;
 }
 
 packet::IWriter* ReceiverLoop::Tasks::CreateEndpoint::get_writer() const {
@@ -90,6 +93,7 @@ ReceiverLoop::ReceiverLoop(IPipelineTaskScheduler& scheduler,
         if (!ticker_) {
             return;
         }
+        ticker_->set_spin_budget(config.tasks.busy_poll_budget);
     }
 
     valid_ = true;
@@ -218,7 +222,8 @@ bool ReceiverLoop::task_create_slot_(Task& task) {
 }
 
 bool ReceiverLoop::task_create_endpoint_(Task& task) {
-    ReceiverEndpoint* endpoint = task.slot_->create_endpoint(task.iface_, task.proto_);
+    ReceiverEndpoint* endpoint =
+        task.slot_->create_endpoint(task.iface_, task.proto_, task.outbound_writer_);
     if (!endpoint) {
         return false;
     }
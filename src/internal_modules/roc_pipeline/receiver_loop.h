@@ -57,10 +57,11 @@ public:
 
         bool (ReceiverLoop::*func_)(Task&); //!< Task implementation method.
 
-        ReceiverSlot* slot_;       //!< Slot.
-        address::Interface iface_; //!< Interface.
-        address::Protocol proto_;  //!< Protocol.
-        packet::IWriter* writer_;  //!< Packet writer.
+        ReceiverSlot* slot_;               //!< Slot.
+        address::Interface iface_;         //!< Interface.
+        address::Protocol proto_;          //!< Protocol.
+        packet::IWriter* writer_;          //!< Packet writer.
+        packet::IWriter* outbound_writer_; //!< Outbound packet writer.
     };
 
     //! Subclasses for specific tasks.
@@ -83,9 +84,12 @@ public:
             //! @remarks
             //!  Each slot can have one source and zero or one repair endpoint.
             //!  The protocols of endpoints in one slot should be compatible.
+            //!  If @p outbound_writer is non-NULL, endpoint uses it to send packets
+            //!  back to remote peer; only control endpoint supports it.
             CreateEndpoint(SlotHandle slot,
                            address::Interface iface,
-                           address::Protocol proto);
+                           address::Protocol proto,
+                           packet::IWriter* outbound_writer);
 
             //! Get packet writer for the endpoint.
             //! @remarks
@@ -11,6 +11,7 @@
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_fec/codec_map.h"
+#include "roc_packet/ntp.h"
 
 namespace roc {
 namespace pipeline {
@@ -18,15 +19,18 @@ namespace pipeline {
 ReceiverSession::ReceiverSession(
     const ReceiverSessionConfig& session_config,
     const ReceiverCommonConfig& common_config,
-    const address::SocketAddr& src_address,
+    const ReceiverSessionMatcher& matcher,
     const rtp::FormatMap& format_map,
     packet::PacketFactory& packet_factory,
     core::BufferFactory<uint8_t>& byte_buffer_factory,
     core::BufferFactory<audio::sample_t>& sample_buffer_factory,
     core::IAllocator& allocator)
     : RefCounted(allocator)
-    , src_address_(src_address)
-    , audio_reader_(NULL) {
+    , matcher_(matcher)
+    , audio_reader_(NULL)
+    , packet_writer_(NULL)
+    , last_sr_(0)
+    , last_sr_time_(0) {
     const rtp::Format* format = format_map.format(session_config.payload_type);
     if (!format) {
         return;
@@ -36,6 +40,16 @@ ReceiverSession::ReceiverSession(
     if (!queue_router_) {
         return;
     }
+    packet_writer_ = queue_router_.get();
+
+    if (common_config.multipath) {
+        // copies of the same packet arrive via different paths
+        deduplicator_.reset(new (deduplicator_) packet::Deduplicator(*packet_writer_));
+        if (!deduplicator_) {
+            return;
+        }
+        packet_writer_ = deduplicator_.get();
+    }
 
     source_queue_.reset(new (source_queue_) packet::SortedQueue(0));
     if (!source_queue_) {
@@ -44,6 +58,19 @@ ReceiverSession::ReceiverSession(
 
     packet::IWriter* pwriter = source_queue_.get();
 
+    jitter_estimator_.reset(new (jitter_estimator_)
+                                packet::JitterEstimator(*pwriter, format->sample_spec));
+    if (!jitter_estimator_) {
+        return;
+    }
+    pwriter = jitter_estimator_.get();
+
+    loss_tracker_.reset(new (loss_tracker_) packet::LossTracker(*pwriter));
+    if (!loss_tracker_) {
+        return;
+    }
+    pwriter = loss_tracker_.get();
+
     if (!queue_router_->add_route(*pwriter, packet::Packet::FlagAudio)) {
         return;
     }
@@ -114,23 +141,48 @@ ReceiverSession::ReceiverSession(
         preader = fec_validator_.get();
     }
 
-    depacketizer_.reset(new (depacketizer_) audio::Depacketizer(
-        *preader, *payload_decoder_, format->sample_spec, common_config.beeping));
-    if (!depacketizer_) {
-        return;
+    // Packets with redundant audio data can restore preceding packets that
+    // were lost and not repaired by FEC.
+    if (session_config.enable_redundancy) {
+        redundancy_reader_.reset(new (redundancy_reader_) rtp::RedundancyReader(
+            *preader, *payload_decoder_, packet_factory));
+        if (!redundancy_reader_) {
+            return;
+        }
+        preader = redundancy_reader_.get();
     }
 
-    audio::IFrameReader* areader = depacketizer_.get();
-
+    // Watchdog doesn't wrap depacketizer; instead, depacketizer records frame
+    // statuses, and watchdog checks them in advance().
     if (session_config.watchdog.no_playback_timeout != 0
         || session_config.watchdog.broken_playback_timeout != 0
         || session_config.watchdog.frame_status_window != 0) {
         watchdog_.reset(new (watchdog_) audio::Watchdog(
-            *areader, format->sample_spec, session_config.watchdog, allocator));
+            format->sample_spec, session_config.watchdog, allocator));
         if (!watchdog_ || !watchdog_->valid()) {
             return;
         }
-        areader = watchdog_.get();
+    }
+
+    depacketizer_.reset(new (depacketizer_) audio::Depacketizer(
+        *preader, *payload_decoder_, format->sample_spec, common_config.beeping,
+        watchdog_ ? &watchdog_->status_buffer() : NULL));
+    if (!depacketizer_) {
+        return;
+    }
+
+    audio::IFrameReader* areader = depacketizer_.get();
+
+    // Per-stage probes measure time spent in the stage and all stages before
+    // it, so that the cost of a stage is the difference between neighbours.
+    if (common_config.profiling) {
+        depacketizer_profiler_.reset(new (depacketizer_profiler_) audio::ProfilingReader(
+            *areader, allocator, format->sample_spec, common_config.profiler_config,
+            "depacketizer"));
+        if (!depacketizer_profiler_ || !depacketizer_profiler_->valid()) {
+            return;
+        }
+        areader = depacketizer_profiler_.get();
     }
 
     if (format->sample_spec.channel_mask()
@@ -157,28 +209,46 @@ ReceiverSession::ReceiverSession(
             areader = resampler_poisoner_.get();
         }
 
-        resampler_.reset(
-            audio::ResamplerMap::instance().new_resampler(
-                session_config.resampler_backend, allocator, sample_buffer_factory,
-                session_config.resampler_profile, common_config.internal_frame_length,
-                audio::SampleSpec(format->sample_spec.sample_rate(),
-                                  common_config.output_sample_spec.channel_mask())),
-            allocator);
+        const audio::SampleSpec resampler_spec(
+            format->sample_spec.sample_rate(),
+            common_config.output_sample_spec.channel_mask());
+
+        // If session and output rates are equal, resampler only compensates
+        // clock drift, and lightweight drift resampler is enough for that.
+        audio::ResamplerBackend resampler_backend = session_config.resampler_backend;
+        if (resampler_backend == audio::ResamplerBackend_Default
+            && format->sample_spec.sample_rate()
+                == common_config.output_sample_spec.sample_rate()) {
+            resampler_backend = audio::ResamplerBackend_Drift;
+        }
+
+        resampler_.reset(audio::ResamplerMap::instance().new_resampler(
+                             resampler_backend, allocator, sample_buffer_factory,
+                             session_config.resampler_profile,
+                             common_config.internal_frame_length, resampler_spec),
+                         allocator);
 
         if (!resampler_) {
             return;
         }
 
         resampler_reader_.reset(new (resampler_reader_) audio::ResamplerReader(
-            *areader, *resampler_,
-            audio::SampleSpec(format->sample_spec.sample_rate(),
-                              common_config.output_sample_spec.channel_mask()),
-            common_config.output_sample_spec));
+            *areader, *resampler_, resampler_spec, common_config.output_sample_spec));
 
         if (!resampler_reader_ || !resampler_reader_->valid()) {
             return;
         }
         areader = resampler_reader_.get();
+
+        if (common_config.profiling) {
+            resampler_profiler_.reset(new (resampler_profiler_) audio::ProfilingReader(
+                *areader, allocator, common_config.output_sample_spec,
+                common_config.profiler_config, "resampler"));
+            if (!resampler_profiler_ || !resampler_profiler_->valid()) {
+                return;
+            }
+            areader = resampler_profiler_.get();
+        }
     }
 
     if (common_config.poisoning) {
@@ -190,7 +260,7 @@ ReceiverSession::ReceiverSession(
     }
 
     latency_monitor_.reset(new (latency_monitor_) audio::LatencyMonitor(
-        *source_queue_, *depacketizer_, resampler_reader_.get(),
+        *source_queue_, *depacketizer_, resampler_reader_.get(), jitter_estimator_.get(),
         session_config.latency_monitor, session_config.target_latency,
         format->sample_spec, common_config.output_sample_spec,
         session_config.freq_estimator_config));
@@ -208,16 +278,11 @@ bool ReceiverSession::valid() const {
 bool ReceiverSession::handle(const packet::PacketPtr& packet) {
     roc_panic_if(!valid());
 
-    packet::UDP* udp = packet->udp();
-    if (!udp) {
-        return false;
-    }
-
-    if (udp->src_addr != src_address_) {
+    if (!matcher_.match(*packet)) {
         return false;
     }
 
-    queue_router_->write(packet);
+    packet_writer_->write(packet);
     return true;
 }
 
@@ -252,9 +317,52 @@ audio::IFrameReader& ReceiverSession::reader() {
     return *audio_reader_;
 }
 
+packet::source_t ReceiverSession::source() const {
+    roc_panic_if(!valid());
+
+    return loss_tracker_->source();
+}
+
+ReceiverSessionMetrics ReceiverSession::get_metrics() const {
+    roc_panic_if(!valid());
+
+    ReceiverSessionMetrics metrics;
+    metrics.source = loss_tracker_->source();
+
+    if (watchdog_) {
+        metrics.frames = watchdog_->counters();
+    }
+
+    return metrics;
+}
+
+rtcp::ReceptionMetrics ReceiverSession::get_reception_metrics() {
+    roc_panic_if(!valid());
+
+    rtcp::ReceptionMetrics metrics;
+    metrics.ssrc = loss_tracker_->source();
+    metrics.fract_loss = loss_tracker_->report_fract_loss();
+    metrics.cum_loss = loss_tracker_->n_lost();
+    metrics.ext_last_seqnum = loss_tracker_->ext_highest_seqnum();
+    metrics.jitter = jitter_estimator_->rtp_jitter();
+    loss_tracker_->report_loss_runs(metrics.loss_runs);
+
+    if (last_sr_ != 0) {
+        metrics.last_sr = last_sr_;
+        metrics.delay_last_sr = packet::nanoseconds_2_ntp(
+            core::timestamp(core::ClockMonotonic) - last_sr_time_);
+    }
+
+    return metrics;
+}
+
 void ReceiverSession::add_sending_metrics(const rtcp::SendingMetrics& metrics) {
-    // TODO
-    (void)metrics;
+    roc_panic_if(!valid());
+
+    // remember when sender report was received, to report LSR and DLSR
+    // back to sender, which uses them to estimate round-trip time
+    last_sr_ = metrics.origin_ntp;
+    last_sr_time_ = core::timestamp(core::ClockMonotonic);
 }
 
 void ReceiverSession::add_link_metrics(const rtcp::LinkMetrics& metrics) {
@@ -12,7 +12,6 @@
 #ifndef ROC_PIPELINE_RECEIVER_SESSION_H_
 #define ROC_PIPELINE_RECEIVER_SESSION_H_
 
-#include "roc_address/socket_addr.h"
 #include "roc_audio/channel_mapper_reader.h"
 #include "roc_audio/depacketizer.h"
 #include "roc_audio/iframe_decoder.h"
@@ -20,6 +19,7 @@
 #include "roc_audio/iresampler.h"
 #include "roc_audio/latency_monitor.h"
 #include "roc_audio/poison_reader.h"
+#include "roc_audio/profiling_reader.h"
 #include "roc_audio/resampler_reader.h"
 #include "roc_audio/watchdog.h"
 #include "roc_core/buffer_factory.h"
@@ -30,18 +30,24 @@
 #include "roc_core/scoped_ptr.h"
 #include "roc_fec/iblock_decoder.h"
 #include "roc_fec/reader.h"
+#include "roc_packet/deduplicator.h"
 #include "roc_packet/delayed_reader.h"
 #include "roc_packet/iparser.h"
 #include "roc_packet/ireader.h"
+#include "roc_packet/jitter_estimator.h"
+#include "roc_packet/loss_tracker.h"
 #include "roc_packet/packet.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_packet/router.h"
 #include "roc_packet/sorted_queue.h"
 #include "roc_pipeline/config.h"
+#include "roc_pipeline/metrics.h"
+#include "roc_pipeline/receiver_session_matcher.h"
 #include "roc_rtcp/metrics.h"
 #include "roc_rtp/format_map.h"
 #include "roc_rtp/parser.h"
 #include "roc_rtp/populator.h"
+#include "roc_rtp/redundancy_reader.h"
 #include "roc_rtp/validator.h"
 
 namespace roc {
@@ -61,7 +67,7 @@ public:
     //! Initialize.
     ReceiverSession(const ReceiverSessionConfig& session_config,
                     const ReceiverCommonConfig& common_config,
-                    const address::SocketAddr& src_address,
+                    const ReceiverSessionMatcher& matcher,
                     const rtp::FormatMap& format_map,
                     packet::PacketFactory& packet_factory,
                     core::BufferFactory<uint8_t>& byte_buffer_factory,
@@ -89,6 +95,18 @@ public:
     //! Get audio reader.
     audio::IFrameReader& reader();
 
+    //! Get RTP source ID of received packets.
+    packet::source_t source() const;
+
+    //! Get session metrics.
+    ReceiverSessionMetrics get_metrics() const;
+
+    //! Get metrics to be reported to sender.
+    //! @remarks
+    //!  Fraction lost and loss runs are computed since previous call,
+    //!  other statistics are cumulative.
+    rtcp::ReceptionMetrics get_reception_metrics();
+
     //! Handle metrics obtained from sender.
     void add_sending_metrics(const rtcp::SendingMetrics& metrics);
 
@@ -96,12 +114,17 @@ public:
     void add_link_metrics(const rtcp::LinkMetrics& metrics);
 
 private:
-    const address::SocketAddr src_address_;
+    ReceiverSessionMatcher matcher_;
 
     audio::IFrameReader* audio_reader_;
 
+    packet::IWriter* packet_writer_;
+
     core::Optional<packet::Router> queue_router_;
+    core::Optional<packet::Deduplicator> deduplicator_;
 
+    core::Optional<packet::JitterEstimator> jitter_estimator_;
+    core::Optional<packet::LossTracker> loss_tracker_;
     core::Optional<packet::SortedQueue> source_queue_;
     core::Optional<packet::SortedQueue> repair_queue_;
 
@@ -117,17 +140,25 @@ private:
     core::Optional<fec::Reader> fec_reader_;
     core::Optional<rtp::Validator> fec_validator_;
 
+    core::Optional<rtp::RedundancyReader> redundancy_reader_;
+
     core::Optional<audio::Depacketizer> depacketizer_;
+    core::Optional<audio::ProfilingReader> depacketizer_profiler_;
 
     core::Optional<audio::ChannelMapperReader> channel_mapper_reader_;
 
     core::Optional<audio::PoisonReader> resampler_poisoner_;
     core::Optional<audio::ResamplerReader> resampler_reader_;
     core::ScopedPtr<audio::IResampler> resampler_;
+    core::Optional<audio::ProfilingReader> resampler_profiler_;
 
     core::Optional<audio::PoisonReader> session_poisoner_;
 
     core::Optional<audio::LatencyMonitor> latency_monitor_;
+
+    // NTP timestamp of last sender report and local time when it was received.
+    packet::ntp_timestamp_t last_sr_;
+    core::nanoseconds_t last_sr_time_;
 };
 
 } // namespace pipeline
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/receiver_session_builder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+ReceiverSessionBuilder::ReceiverSessionBuilder()
+    : started_(false)
+    , stop_(false) {
+    started_ = Thread::start();
+}
+
+ReceiverSessionBuilder::~ReceiverSessionBuilder() {
+    if (!started_) {
+        return;
+    }
+
+    stop_ = true;
+    sem_.post();
+
+    Thread::join();
+}
+
+bool ReceiverSessionBuilder::valid() const {
+    return started_;
+}
+
+void ReceiverSessionBuilder::schedule(ReceiverSessionRequest& request) {
+    if (!valid()) {
+        roc_panic("session builder: attempt to use invalid builder");
+    }
+
+    queue_.push_back(request);
+    sem_.post();
+}
+
+void ReceiverSessionBuilder::run() {
+    roc_log(LogDebug, "session builder: starting thread");
+
+    for (;;) {
+        sem_.wait();
+
+        if (stop_) {
+            break;
+        }
+
+        while (core::SharedPtr<ReceiverSessionRequest> request =
+                   queue_.pop_front_exclusive()) {
+            request->build();
+        }
+    }
+
+    roc_log(LogDebug, "session builder: finishing thread");
+}
+
+} // namespace pipeline
+} // namespace roc
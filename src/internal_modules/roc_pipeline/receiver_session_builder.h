@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/receiver_session_builder.h
+//! @brief Background receiver session builder.
+
+#ifndef ROC_PIPELINE_RECEIVER_SESSION_BUILDER_H_
+#define ROC_PIPELINE_RECEIVER_SESSION_BUILDER_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/mpsc_queue.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/thread.h"
+#include "roc_pipeline/receiver_session_request.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Background receiver session builder.
+//!
+//! Constructing a receiver session involves multiple allocations and
+//! precomputations (e.g. resampler tables). To keep them out of the pipeline
+//! thread, session group may schedule session requests to this builder, which
+//! constructs sessions on its own thread.
+//!
+//! Scheduling is lock-free and wait-free, so it can be used on the pipeline
+//! thread. Completion is reported via ReceiverSessionRequest::done().
+class ReceiverSessionBuilder : public core::NonCopyable<>, private core::Thread {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Starts background thread.
+    ReceiverSessionBuilder();
+
+    //! Destroy.
+    //! @remarks
+    //!  Stops background thread. Requests that were not processed yet are
+    //!  released and never become done.
+    virtual ~ReceiverSessionBuilder();
+
+    //! Check if the object was successfully constructed.
+    bool valid() const;
+
+    //! Enqueue request for asynchronous construction.
+    //! @remarks
+    //!  Acquires ownership of the request until it's processed.
+    void schedule(ReceiverSessionRequest& request);
+
+private:
+    virtual void run();
+
+    bool started_;
+    core::Atomic<int> stop_;
+
+    core::Semaphore sem_;
+    core::MpscQueue<ReceiverSessionRequest> queue_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_RECEIVER_SESSION_BUILDER_H_
@@ -9,6 +9,8 @@
 #include "roc_pipeline/receiver_session_group.h"
 #include "roc_address/socket_addr_to_str.h"
 #include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/time.h"
 
 namespace roc {
 namespace pipeline {
@@ -17,6 +19,7 @@ ReceiverSessionGroup::ReceiverSessionGroup(
     const ReceiverConfig& receiver_config,
     ReceiverState& receiver_state,
     audio::Mixer& mixer,
+    ReceiverSessionBuilder* session_builder,
     const rtp::FormatMap& format_map,
     packet::PacketFactory& packet_factory,
     core::BufferFactory<uint8_t>& byte_buffer_factory,
@@ -28,8 +31,18 @@ ReceiverSessionGroup::ReceiverSessionGroup(
     , sample_buffer_factory_(sample_buffer_factory)
     , format_map_(format_map)
     , mixer_(mixer)
+    , session_builder_(session_builder)
     , receiver_state_(receiver_state)
-    , receiver_config_(receiver_config) {
+    , receiver_config_(receiver_config)
+    , control_writer_(NULL)
+    , report_sessions_(allocator) {
+}
+
+ReceiverSessionGroup::~ReceiverSessionGroup() {
+    while (core::SharedPtr<ReceiverSessionRequest> request = pending_sessions_.front()) {
+        pending_sessions_.remove(*request);
+        receiver_state_.add_pending_sessions(-1);
+    }
 }
 
 void ReceiverSessionGroup::route_packet(const packet::PacketPtr& packet) {
@@ -42,6 +55,8 @@ void ReceiverSessionGroup::route_packet(const packet::PacketPtr& packet) {
 }
 
 void ReceiverSessionGroup::advance_sessions(packet::timestamp_t timestamp) {
+    attach_pending_sessions_();
+
     core::SharedPtr<ReceiverSession> curr, next;
 
     for (curr = sessions_.front(); curr; curr = next) {
@@ -52,6 +67,8 @@ void ReceiverSessionGroup::advance_sessions(packet::timestamp_t timestamp) {
             remove_session_(*curr);
         }
     }
+
+    generate_control_packets_();
 }
 
 void ReceiverSessionGroup::reclock_sessions(packet::ntp_timestamp_t timestamp) {
@@ -67,38 +84,84 @@ void ReceiverSessionGroup::reclock_sessions(packet::ntp_timestamp_t timestamp) {
     }
 }
 
+void ReceiverSessionGroup::set_control_writer(packet::IWriter& writer) {
+    control_writer_ = &writer;
+}
+
 size_t ReceiverSessionGroup::num_sessions() const {
     return sessions_.size();
 }
 
+void ReceiverSessionGroup::get_metrics(ReceiverSessionMetrics* metrics,
+                                       size_t* metrics_size) const {
+    roc_panic_if(!metrics_size);
+    roc_panic_if(!metrics && *metrics_size != 0);
+
+    size_t n = 0;
+
+    for (core::SharedPtr<ReceiverSession> sess = sessions_.front();
+         sess && n < *metrics_size; sess = sessions_.nextof(*sess)) {
+        metrics[n++] = sess->get_metrics();
+    }
+
+    *metrics_size = n;
+}
+
 void ReceiverSessionGroup::on_update_source(packet::source_t ssrc, const char* cname) {
-    // TODO
-    (void)ssrc;
-    (void)cname;
+    roc_log(LogDebug, "session group: source description: ssrc=%lu cname=%s",
+            (unsigned long)ssrc, cname);
 }
 
 void ReceiverSessionGroup::on_remove_source(packet::source_t ssrc) {
-    // TODO
-    (void)ssrc;
+    core::SharedPtr<ReceiverSession> curr, next;
+
+    for (curr = sessions_.front(); curr; curr = next) {
+        next = sessions_.nextof(*curr);
+
+        if (curr->source() == ssrc) {
+            // Sender said goodbye.
+            remove_session_(*curr);
+        }
+    }
 }
 
 size_t ReceiverSessionGroup::on_get_num_sources() {
-    // TODO
-    return 0;
+    // rtcp::Session requests metrics of every source by index right after
+    // this call, so we remember sessions to avoid list traversal per source
+    if (!report_sessions_.resize(sessions_.size())) {
+        roc_log(LogError, "session group: can't allocate report sessions: n_sessions=%lu",
+                (unsigned long)sessions_.size());
+        report_sessions_.resize(0);
+        return 0;
+    }
+
+    size_t n = 0;
+
+    for (core::SharedPtr<ReceiverSession> sess = sessions_.front(); sess;
+         sess = sessions_.nextof(*sess)) {
+        report_sessions_[n++] = sess.get();
+    }
+
+    return report_sessions_.size();
 }
 
 rtcp::ReceptionMetrics
 ReceiverSessionGroup::on_get_reception_metrics(size_t source_index) {
-    // TODO
-    (void)source_index;
-    return rtcp::ReceptionMetrics();
+    if (source_index >= report_sessions_.size()) {
+        roc_panic("session group: source index out of bounds: index=%lu size=%lu",
+                  (unsigned long)source_index, (unsigned long)report_sessions_.size());
+    }
+
+    return report_sessions_[source_index]->get_reception_metrics();
 }
 
 void ReceiverSessionGroup::on_add_sending_metrics(const rtcp::SendingMetrics& metrics) {
     core::SharedPtr<ReceiverSession> sess;
 
     for (sess = sessions_.front(); sess; sess = sessions_.nextof(*sess)) {
-        sess->add_sending_metrics(metrics);
+        if (sess->source() == metrics.ssrc) {
+            sess->add_sending_metrics(metrics);
+        }
     }
 }
 
@@ -119,6 +182,15 @@ void ReceiverSessionGroup::route_transport_packet_(const packet::PacketPtr& pack
         }
     }
 
+    core::SharedPtr<ReceiverSessionRequest> request;
+
+    for (request = pending_sessions_.front(); request;
+         request = pending_sessions_.nextof(*request)) {
+        if (request->handle(packet)) {
+            return;
+        }
+    }
+
     if (can_create_session_(packet)) {
         create_session_(packet);
     }
@@ -131,17 +203,53 @@ void ReceiverSessionGroup::route_control_packet_(const packet::PacketPtr& packet
 
     if (!rtcp_session_) {
         rtcp_session_.reset(new (rtcp_session_) rtcp::Session(
-            this, NULL, NULL, *rtcp_composer_, packet_factory_, byte_buffer_factory_));
+            this, NULL, this, *rtcp_composer_, packet_factory_, byte_buffer_factory_));
     }
 
     if (!rtcp_session_->valid()) {
         return;
     }
 
+    if (packet->udp()) {
+        // Reports are sent back to the sender of the latest control packet.
+        control_address_ = packet->udp()->src_addr;
+    }
+
     // This will invoke IReceiverController methods implemented by us.
     rtcp_session_->process_packet(packet);
 }
 
+void ReceiverSessionGroup::generate_control_packets_() {
+    if (!control_writer_ || !control_address_.has_host_port()) {
+        return;
+    }
+
+    if (!rtcp_session_ || !rtcp_session_->valid()) {
+        return;
+    }
+
+    if (rtcp_session_->generation_deadline() > core::timestamp(core::ClockMonotonic)) {
+        return;
+    }
+
+    // This will invoke IReceiverHooks methods and write() implemented by us.
+    rtcp_session_->generate_packets();
+}
+
+void ReceiverSessionGroup::write(const packet::PacketPtr& packet) {
+    roc_panic_if(!control_writer_);
+
+    packet->add_flags(packet::Packet::FlagUDP);
+    packet->udp()->dst_addr = control_address_;
+
+    if (!rtcp_composer_->compose(*packet)) {
+        roc_panic("session group: can't compose control packet");
+    }
+    packet->add_flags(packet::Packet::FlagComposed);
+
+    control_writer_->write(packet);
+}
+
 bool ReceiverSessionGroup::can_create_session_(const packet::PacketPtr& packet) {
     if (packet->flags() & packet::Packet::FlagRepair) {
         roc_log(LogDebug, "session group: ignoring repair packet for unknown session");
@@ -166,28 +274,84 @@ void ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
 
     const ReceiverSessionConfig sess_config = make_session_config_(packet);
 
+    const ReceiverSessionMatcher matcher(*packet, receiver_config_.common.multipath);
+
     const address::SocketAddr src_address = packet->udp()->src_addr;
     const address::SocketAddr dst_address = packet->udp()->dst_addr;
 
-    roc_log(LogInfo, "session group: creating session: src_addr=%s dst_addr=%s",
+    roc_log(LogInfo, "session group: creating session: src_addr=%s dst_addr=%s ssrc=%lu",
             address::socket_addr_to_str(src_address).c_str(),
-            address::socket_addr_to_str(dst_address).c_str());
+            address::socket_addr_to_str(dst_address).c_str(),
+            (unsigned long)matcher.source());
 
-    core::SharedPtr<ReceiverSession> sess = new (allocator_) ReceiverSession(
-        sess_config, receiver_config_.common, src_address, format_map_, packet_factory_,
-        byte_buffer_factory_, sample_buffer_factory_, allocator_);
+    core::SharedPtr<ReceiverSessionRequest> request = new (allocator_)
+        ReceiverSessionRequest(sess_config, receiver_config_.common, matcher,
+                               format_map_, packet_factory_, byte_buffer_factory_,
+                               sample_buffer_factory_, allocator_);
 
-    if (!sess || !sess->valid()) {
-        roc_log(LogError, "session group: can't create session, initialization failed");
+    if (!request) {
+        roc_log(LogError, "session group: can't create session, allocation failed");
         return;
     }
 
-    if (!sess->handle(packet)) {
+    if (!request->handle(packet)) {
         roc_log(LogError,
                 "session group: can't create session, can't handle first packet");
         return;
     }
 
+    if (session_builder_) {
+        // Session will be attached in advance_sessions() when it's ready;
+        // until then, packets from the same source are buffered in request.
+        pending_sessions_.push_back(*request);
+        receiver_state_.add_pending_sessions(+1);
+
+        session_builder_->schedule(*request);
+        return;
+    }
+
+    request->build();
+    attach_session_(*request);
+}
+
+void ReceiverSessionGroup::attach_pending_sessions_() {
+    core::SharedPtr<ReceiverSessionRequest> curr, next;
+
+    for (curr = pending_sessions_.front(); curr; curr = next) {
+        next = pending_sessions_.nextof(*curr);
+
+        if (!curr->done()) {
+            continue;
+        }
+
+        pending_sessions_.remove(*curr);
+        receiver_state_.add_pending_sessions(-1);
+
+        attach_session_(*curr);
+    }
+}
+
+void ReceiverSessionGroup::attach_session_(ReceiverSessionRequest& request) {
+    core::SharedPtr<ReceiverSession> sess = request.session();
+    if (!sess) {
+        roc_log(LogError, "session group: can't create session, initialization failed");
+        return;
+    }
+
+    roc_log(LogDebug,
+            "session group: attaching session: n_buffered_packets=%lu"
+            " n_dropped_packets=%lu",
+            (unsigned long)request.num_packets(),
+            (unsigned long)request.num_dropped_packets());
+
+    while (packet::PacketPtr packet = request.next_packet()) {
+        if (!sess->handle(packet)) {
+            roc_log(LogError,
+                    "session group: can't create session, can't handle buffered packet");
+            return;
+        }
+    }
+
     mixer_.add_input(sess->reader());
     sessions_.push_back(*sess);
 
@@ -210,6 +374,7 @@ ReceiverSessionGroup::make_session_config_(const packet::PacketPtr& packet) cons
     packet::RTP* rtp = packet->rtp();
     if (rtp) {
         config.payload_type = rtp->payload_type;
+        config.enable_redundancy = rtp->redundancy_size != 0;
     }
 
     packet::FEC* fec = packet->fec();
@@ -12,11 +12,16 @@
 #ifndef ROC_PIPELINE_RECEIVER_SESSION_GROUP_H_
 #define ROC_PIPELINE_RECEIVER_SESSION_GROUP_H_
 
+#include "roc_address/socket_addr.h"
 #include "roc_audio/mixer.h"
+#include "roc_core/array.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
+#include "roc_packet/iwriter.h"
 #include "roc_pipeline/receiver_session.h"
+#include "roc_pipeline/receiver_session_builder.h"
+#include "roc_pipeline/receiver_session_request.h"
 #include "roc_pipeline/receiver_state.h"
 #include "roc_rtcp/composer.h"
 #include "roc_rtcp/session.h"
@@ -28,30 +33,56 @@ namespace pipeline {
 //!
 //! Contains:
 //!  - a set of related receiver sessions
-class ReceiverSessionGroup : public core::NonCopyable<>, private rtcp::IReceiverHooks {
+//!  - a set of pending session requests, if sessions are built asynchronously
+//!  - RTCP session that processes control packets and sends receiver reports
+class ReceiverSessionGroup : public core::NonCopyable<>,
+                             private rtcp::IReceiverHooks,
+                             private packet::IWriter {
 public:
     //! Initialize.
+    //! @remarks
+    //!  If @p session_builder is non-NULL, new sessions are constructed on
+    //!  its thread, otherwise they're constructed in-place.
     ReceiverSessionGroup(const ReceiverConfig& receiver_config,
                          ReceiverState& receiver_state,
                          audio::Mixer& mixer,
+                         ReceiverSessionBuilder* session_builder,
                          const rtp::FormatMap& format_map,
                          packet::PacketFactory& packet_factory,
                          core::BufferFactory<uint8_t>& byte_buffer_factory,
                          core::BufferFactory<audio::sample_t>& sample_buffer_factory,
                          core::IAllocator& allocator);
 
+    //! Destroy.
+    //! @remarks
+    //!  Releases pending session requests; requests that are still being
+    //!  built are released by builder thread when done.
+    ~ReceiverSessionGroup();
+
     //! Route packet to session.
     void route_packet(const packet::PacketPtr& packet);
 
-    //! Advance session timestamp.
+    //! Attach sessions that were built asynchronously and advance session timestamp.
     void advance_sessions(packet::timestamp_t timestamp);
 
     //! Adjust session clock to match consumer clock.
     void reclock_sessions(packet::ntp_timestamp_t timestamp);
 
+    //! Set writer for outbound control packets.
+    //! @remarks
+    //!  If set, group periodically generates RTCP receiver reports and sends
+    //!  them to the address from which the latest control packet was received.
+    void set_control_writer(packet::IWriter& writer);
+
     //! Get number of alive sessions.
     size_t num_sessions() const;
 
+    //! Get metrics of sessions.
+    //! @remarks
+    //!  Fills @p metrics with metrics of up to @p metrics_size sessions and
+    //!  sets @p metrics_size to the number of filled entries.
+    void get_metrics(ReceiverSessionMetrics* metrics, size_t* metrics_size) const;
+
 private:
     // Implementation of rtcp::IReceiverHooks interface.
     // These methods are invoked by rtcp::Session.
@@ -62,12 +93,20 @@ private:
     virtual void on_add_sending_metrics(const rtcp::SendingMetrics& metrics);
     virtual void on_add_link_metrics(const rtcp::LinkMetrics& metrics);
 
+    // Implementation of packet::IWriter interface.
+    // Invoked by rtcp::Session to send generated reports.
+    virtual void write(const packet::PacketPtr& packet);
+
     void route_transport_packet_(const packet::PacketPtr& packet);
     void route_control_packet_(const packet::PacketPtr& packet);
 
+    void generate_control_packets_();
+
     bool can_create_session_(const packet::PacketPtr& packet);
 
     void create_session_(const packet::PacketPtr& packet);
+    void attach_pending_sessions_();
+    void attach_session_(ReceiverSessionRequest& request);
     void remove_session_(ReceiverSession& sess);
 
     ReceiverSessionConfig make_session_config_(const packet::PacketPtr& packet) const;
@@ -82,13 +121,23 @@ private:
 
     audio::Mixer& mixer_;
 
+    ReceiverSessionBuilder* session_builder_;
+
     ReceiverState& receiver_state_;
     const ReceiverConfig& receiver_config_;
 
     core::Optional<rtcp::Composer> rtcp_composer_;
     core::Optional<rtcp::Session> rtcp_session_;
 
+    packet::IWriter* control_writer_;
+    address::SocketAddr control_address_;
+
+    // sessions reported in current RTCP packet, filled by on_get_num_sources()
+    // and indexed by on_get_reception_metrics()
+    core::Array<ReceiverSession*, 8> report_sessions_;
+
     core::List<ReceiverSession> sessions_;
+    core::List<ReceiverSessionRequest> pending_sessions_;
 };
 
 } // namespace pipeline
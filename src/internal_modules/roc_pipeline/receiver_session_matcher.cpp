@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/receiver_session_matcher.h"
+#include "roc_address/socket_addr_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+ReceiverSessionMatcher::ReceiverSessionMatcher(const packet::Packet& first_packet,
+                                               bool multipath)
+    : n_addrs_(0)
+    , source_(0)
+    , multipath_(multipath) {
+    if (!first_packet.udp() || !first_packet.rtp()) {
+        roc_panic("session matcher: first packet should have udp and rtp headers");
+    }
+
+    add_address_(first_packet.udp()->src_addr);
+    source_ = first_packet.rtp()->source;
+}
+
+bool ReceiverSessionMatcher::match(const packet::Packet& packet) {
+    const packet::UDP* udp = packet.udp();
+    if (!udp) {
+        return false;
+    }
+
+    if (!multipath_) {
+        return udp->src_addr == addrs_[0];
+    }
+
+    const packet::RTP* rtp = packet.rtp();
+    if (!rtp) {
+        return has_address_(udp->src_addr);
+    }
+
+    if (rtp->source != source_) {
+        return false;
+    }
+
+    if (!has_address_(udp->src_addr)) {
+        add_address_(udp->src_addr);
+    }
+
+    return true;
+}
+
+packet::source_t ReceiverSessionMatcher::source() const {
+    return source_;
+}
+
+size_t ReceiverSessionMatcher::num_paths() const {
+    return n_addrs_;
+}
+
+bool ReceiverSessionMatcher::has_address_(const address::SocketAddr& addr) const {
+    for (size_t n = 0; n < n_addrs_; n++) {
+        if (addrs_[n] == addr) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ReceiverSessionMatcher::add_address_(const address::SocketAddr& addr) {
+    if (n_addrs_ == MaxPaths) {
+        roc_log(LogTrace, "session matcher: too many paths, ignoring address: addr=%s",
+                address::socket_addr_to_str(addr).c_str());
+        return;
+    }
+
+    if (n_addrs_ != 0) {
+        roc_log(LogDebug, "session matcher: adding path: src_addr=%s n_paths=%lu",
+                address::socket_addr_to_str(addr).c_str(), (unsigned long)n_addrs_ + 1);
+    }
+
+    addrs_[n_addrs_++] = addr;
+}
+
+} // namespace pipeline
+} // namespace roc
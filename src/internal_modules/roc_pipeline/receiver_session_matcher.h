@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/receiver_session_matcher.h
+//! @brief Receiver session matcher.
+
+#ifndef ROC_PIPELINE_RECEIVER_SESSION_MATCHER_H_
+#define ROC_PIPELINE_RECEIVER_SESSION_MATCHER_H_
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Receiver session matcher.
+//!
+//! Decides whether a packet belongs to a session.
+//!
+//! By default, session is identified by sender address of the first packet.
+//!
+//! In multipath mode, session is identified by RTP source of the first
+//! packet, and RTP packets from any address are accepted. Addresses that
+//! delivered session's RTP packets are remembered, and packets without
+//! RTP header (e.g. FEC repair packets) are accepted from those addresses.
+class ReceiverSessionMatcher {
+public:
+    //! Maximum number of remembered addresses in multipath mode.
+    enum { MaxPaths = 8 };
+
+    //! Initialize from the first packet of session.
+    //! @pre
+    //!  Packet should have UDP and RTP headers.
+    ReceiverSessionMatcher(const packet::Packet& first_packet, bool multipath);
+
+    //! Check if packet belongs to session.
+    //! @remarks
+    //!  In multipath mode, may remember packet sender address.
+    bool match(const packet::Packet& packet);
+
+    //! Get RTP source of the first packet.
+    packet::source_t source() const;
+
+    //! Get number of remembered sender addresses.
+    size_t num_paths() const;
+
+private:
+    bool has_address_(const address::SocketAddr& addr) const;
+    void add_address_(const address::SocketAddr& addr);
+
+    address::SocketAddr addrs_[MaxPaths];
+    size_t n_addrs_;
+
+    packet::source_t source_;
+
+    bool multipath_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_RECEIVER_SESSION_MATCHER_H_
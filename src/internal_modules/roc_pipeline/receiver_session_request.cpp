@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/receiver_session_request.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+ReceiverSessionRequest::ReceiverSessionRequest(
+    const ReceiverSessionConfig& session_config,
+    const ReceiverCommonConfig& common_config,
+    const ReceiverSessionMatcher& matcher,
+    const rtp::FormatMap& format_map,
+    packet::PacketFactory& packet_factory,
+    core::BufferFactory<uint8_t>& byte_buffer_factory,
+    core::BufferFactory<audio::sample_t>& sample_buffer_factory,
+    core::IAllocator& allocator)
+    : RefCounted(allocator)
+    , session_config_(session_config)
+    , common_config_(common_config)
+    , session_matcher_(matcher)
+    , matcher_(matcher)
+    , format_map_(format_map)
+    , packet_factory_(packet_factory)
+    , byte_buffer_factory_(byte_buffer_factory)
+    , sample_buffer_factory_(sample_buffer_factory)
+    , allocator_(allocator)
+    , n_dropped_(0)
+    , done_(false) {
+}
+
+void ReceiverSessionRequest::build() {
+    if (done_) {
+        roc_panic("session request: build() called twice");
+    }
+
+    core::SharedPtr<ReceiverSession> sess = new (allocator_) ReceiverSession(
+        session_config_, common_config_, session_matcher_, format_map_,
+        packet_factory_, byte_buffer_factory_, sample_buffer_factory_, allocator_);
+
+    if (sess && sess->valid()) {
+        session_ = sess;
+    }
+
+    done_ = true;
+}
+
+bool ReceiverSessionRequest::done() const {
+    return done_;
+}
+
+core::SharedPtr<ReceiverSession> ReceiverSessionRequest::session() const {
+    roc_panic_if_not(done_);
+
+    return session_;
+}
+
+bool ReceiverSessionRequest::handle(const packet::PacketPtr& packet) {
+    if (!matcher_.match(*packet)) {
+        return false;
+    }
+
+    if (packets_.size() >= MaxPackets) {
+        // session is built too slowly; don't let the buffer grow unbounded
+        n_dropped_++;
+        return true;
+    }
+
+    packets_.write(packet);
+    return true;
+}
+
+packet::PacketPtr ReceiverSessionRequest::next_packet() {
+    return packets_.read();
+}
+
+size_t ReceiverSessionRequest::num_packets() const {
+    return packets_.size();
+}
+
+size_t ReceiverSessionRequest::num_dropped_packets() const {
+    return n_dropped_;
+}
+
+} // namespace pipeline
+} // namespace roc
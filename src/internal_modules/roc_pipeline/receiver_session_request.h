@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/receiver_session_request.h
+//! @brief Receiver session request.
+
+#ifndef ROC_PIPELINE_RECEIVER_SESSION_REQUEST_H_
+#define ROC_PIPELINE_RECEIVER_SESSION_REQUEST_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/list_node.h"
+#include "roc_core/mpsc_queue_node.h"
+#include "roc_core/ref_counted.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+#include "roc_pipeline/config.h"
+#include "roc_pipeline/receiver_session.h"
+#include "roc_pipeline/receiver_session_matcher.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Receiver session request.
+//!
+//! Holds everything needed to construct a receiver session, and packets
+//! that were received from the session source before the session was built.
+//!
+//! Lifecycle:
+//!  - request is created on pipeline thread when the first packet from a
+//!    new source arrives
+//!  - build() is invoked either in-place or on ReceiverSessionBuilder thread
+//!  - after done() returns true, pipeline thread takes session() and
+//!    feeds it with buffered packets
+//!
+//! Packet buffering is performed only by pipeline thread. Session is
+//! published to pipeline thread via done() flag. Number of buffered packets
+//! is limited; packets beyond the limit are dropped.
+class ReceiverSessionRequest
+    : public core::RefCounted<ReceiverSessionRequest, core::StandardAllocation>,
+      public core::ListNode,
+      public core::MpscQueueNode {
+    typedef core::RefCounted<ReceiverSessionRequest, core::StandardAllocation> RefCounted;
+
+public:
+    //! Initialize.
+    ReceiverSessionRequest(const ReceiverSessionConfig& session_config,
+                           const ReceiverCommonConfig& common_config,
+                           const ReceiverSessionMatcher& matcher,
+                           const rtp::FormatMap& format_map,
+                           packet::PacketFactory& packet_factory,
+                           core::BufferFactory<uint8_t>& byte_buffer_factory,
+                           core::BufferFactory<audio::sample_t>& sample_buffer_factory,
+                           core::IAllocator& allocator);
+
+    //! Construct session.
+    //! @remarks
+    //!  May be called from any thread, but only once.
+    void build();
+
+    //! Check if build() was completed.
+    //! @remarks
+    //!  After this method returns true, session() result is visible to the
+    //!  calling thread.
+    bool done() const;
+
+    //! Get constructed session.
+    //! @returns
+    //!  NULL if construction failed.
+    //! @pre
+    //!  done() should return true.
+    core::SharedPtr<ReceiverSession> session() const;
+
+    //! Buffer packet if it's dedicated for the requested session.
+    //! @returns
+    //!  true if the packet was consumed, i.e. buffered or dropped because
+    //!  too many packets are already buffered.
+    bool handle(const packet::PacketPtr& packet);
+
+    //! Get next buffered packet.
+    //! @returns
+    //!  NULL if there are no more packets.
+    packet::PacketPtr next_packet();
+
+    //! Get number of buffered packets.
+    size_t num_packets() const;
+
+    //! Get number of packets dropped because buffer was full.
+    size_t num_dropped_packets() const;
+
+    //! Maximum number of buffered packets.
+    enum { MaxPackets = 500 };
+
+private:
+    const ReceiverSessionConfig session_config_;
+    const ReceiverCommonConfig common_config_;
+
+    // session gets a copy of the initial matcher, because matcher_ is
+    // updated on pipeline thread while build() may run on another thread
+    const ReceiverSessionMatcher session_matcher_;
+    ReceiverSessionMatcher matcher_;
+
+    const rtp::FormatMap& format_map_;
+
+    packet::PacketFactory& packet_factory_;
+    core::BufferFactory<uint8_t>& byte_buffer_factory_;
+    core::BufferFactory<audio::sample_t>& sample_buffer_factory_;
+
+    core::IAllocator& allocator_;
+
+    packet::Queue packets_;
+    size_t n_dropped_;
+
+    core::SharedPtr<ReceiverSession> session_;
+    core::Atomic<int> done_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_RECEIVER_SESSION_REQUEST_H_
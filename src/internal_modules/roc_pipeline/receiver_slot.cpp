@@ -16,6 +16,8 @@ namespace pipeline {
 ReceiverSlot::ReceiverSlot(const ReceiverConfig& receiver_config,
                            ReceiverState& receiver_state,
                            audio::Mixer& mixer,
+                           ReceiverSessionBuilder* session_builder,
+                           ReceiverSessionGroup* shared_session_group,
                            const rtp::FormatMap& format_map,
                            packet::PacketFactory& packet_factory,
                            core::BufferFactory<uint8_t>& byte_buffer_factory,
@@ -24,22 +26,29 @@ ReceiverSlot::ReceiverSlot(const ReceiverConfig& receiver_config,
     : RefCounted(allocator)
     , format_map_(format_map)
     , receiver_state_(receiver_state)
-    , session_group_(receiver_config,
-                     receiver_state,
-                     mixer,
-                     format_map,
-                     packet_factory,
-                     byte_buffer_factory,
-                     sample_buffer_factory,
-                     allocator) {
+    , session_group_(shared_session_group) {
     roc_log(LogDebug, "receiver slot: initializing");
+
+    if (!session_group_) {
+        own_session_group_.reset(new (own_session_group_) ReceiverSessionGroup(
+            receiver_config, receiver_state, mixer, session_builder, format_map,
+            packet_factory, byte_buffer_factory, sample_buffer_factory, allocator));
+        session_group_ = own_session_group_.get();
+    }
 }
 
 ReceiverEndpoint* ReceiverSlot::create_endpoint(address::Interface iface,
-                                                address::Protocol proto) {
+                                                address::Protocol proto,
+                                                packet::IWriter* outbound_writer) {
     roc_log(LogDebug, "receiver slot: adding %s endpoint %s",
             address::interface_to_str(iface), address::proto_to_str(proto));
 
+    if (outbound_writer && iface != address::Iface_AudioControl) {
+        roc_log(LogError, "receiver slot: outbound writer is supported only for %s",
+                address::interface_to_str(address::Iface_AudioControl));
+        return NULL;
+    }
+
     switch (iface) {
     case address::Iface_AudioSource:
         return create_source_endpoint_(proto);
@@ -48,7 +57,7 @@ ReceiverEndpoint* ReceiverSlot::create_endpoint(address::Interface iface,
         return create_repair_endpoint_(proto);
 
     case address::Iface_AudioControl:
-        return create_control_endpoint_(proto);
+        return create_control_endpoint_(proto, outbound_writer);
 
     default:
         break;
@@ -93,15 +102,24 @@ void ReceiverSlot::advance(packet::timestamp_t timestamp) {
         repair_endpoint_->pull_packets();
     }
 
-    session_group_.advance_sessions(timestamp);
+    if (own_session_group_) {
+        own_session_group_->advance_sessions(timestamp);
+    }
 }
 
 void ReceiverSlot::reclock(packet::ntp_timestamp_t timestamp) {
-    session_group_.reclock_sessions(timestamp);
+    if (own_session_group_) {
+        own_session_group_->reclock_sessions(timestamp);
+    }
 }
 
 size_t ReceiverSlot::num_sessions() const {
-    return session_group_.num_sessions();
+    return session_group_->num_sessions();
+}
+
+void ReceiverSlot::get_metrics(ReceiverSessionMetrics* metrics,
+                               size_t* metrics_size) const {
+    session_group_->get_metrics(metrics, metrics_size);
 }
 
 ReceiverEndpoint* ReceiverSlot::create_source_endpoint_(address::Protocol proto) {
@@ -121,7 +139,7 @@ ReceiverEndpoint* ReceiverSlot::create_source_endpoint_(address::Protocol proto)
     }
 
     source_endpoint_.reset(new (source_endpoint_) ReceiverEndpoint(
-        proto, receiver_state_, session_group_, format_map_, allocator()));
+        proto, receiver_state_, *session_group_, format_map_, allocator()));
 
     if (!source_endpoint_ || !source_endpoint_->valid()) {
         roc_log(LogError, "receiver slot: can't create source endpoint");
@@ -149,7 +167,7 @@ ReceiverEndpoint* ReceiverSlot::create_repair_endpoint_(address::Protocol proto)
     }
 
     repair_endpoint_.reset(new (repair_endpoint_) ReceiverEndpoint(
-        proto, receiver_state_, session_group_, format_map_, allocator()));
+        proto, receiver_state_, *session_group_, format_map_, allocator()));
 
     if (!repair_endpoint_ || !repair_endpoint_->valid()) {
         roc_log(LogError, "receiver slot: can't create repair endpoint");
@@ -160,7 +178,9 @@ ReceiverEndpoint* ReceiverSlot::create_repair_endpoint_(address::Protocol proto)
     return repair_endpoint_.get();
 }
 
-ReceiverEndpoint* ReceiverSlot::create_control_endpoint_(address::Protocol proto) {
+ReceiverEndpoint*
+ReceiverSlot::create_control_endpoint_(address::Protocol proto,
+                                       packet::IWriter* outbound_writer) {
     if (control_endpoint_) {
         roc_log(LogError, "receiver slot: audio control endpoint is already set");
         return NULL;
@@ -171,7 +191,7 @@ ReceiverEndpoint* ReceiverSlot::create_control_endpoint_(address::Protocol proto
     }
 
     control_endpoint_.reset(new (control_endpoint_) ReceiverEndpoint(
-        proto, receiver_state_, session_group_, format_map_, allocator()));
+        proto, receiver_state_, *session_group_, format_map_, allocator()));
 
     if (!control_endpoint_ || !control_endpoint_->valid()) {
         roc_log(LogError, "receiver slot: can't create control endpoint");
@@ -179,6 +199,10 @@ ReceiverEndpoint* ReceiverSlot::create_control_endpoint_(address::Protocol proto
         return NULL;
     }
 
+    if (outbound_writer) {
+        session_group_->set_control_writer(*outbound_writer);
+    }
+
     return control_endpoint_.get();
 }
 
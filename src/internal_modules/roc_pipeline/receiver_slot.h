@@ -18,6 +18,7 @@
 #include "roc_core/iallocator.h"
 #include "roc_core/list.h"
 #include "roc_core/list_node.h"
+#include "roc_core/optional.h"
 #include "roc_core/ref_counted.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/receiver_endpoint.h"
@@ -33,15 +34,23 @@ namespace pipeline {
 //! Contains:
 //!  - one or more related receiver endpoints, one per each type
 //!  - one session group associated with those endpoints
+//!
+//! Session group may be shared by several slots, in which case it's owned
+//! and advanced by the caller.
 class ReceiverSlot : public core::RefCounted<ReceiverSlot, core::StandardAllocation>,
                      public core::ListNode {
     typedef core::RefCounted<ReceiverSlot, core::StandardAllocation> RefCounted;
 
 public:
     //! Initialize.
+    //! @remarks
+    //!  If @p shared_session_group is non-NULL, endpoints route packets to it,
+    //!  otherwise slot creates its own session group.
     ReceiverSlot(const ReceiverConfig& receiver_config,
                  ReceiverState& receiver_state,
                  audio::Mixer& mixer,
+                 ReceiverSessionBuilder* session_builder,
+                 ReceiverSessionGroup* shared_session_group,
                  const rtp::FormatMap& format_map,
                  packet::PacketFactory& packet_factory,
                  core::BufferFactory<uint8_t>& byte_buffer_factory,
@@ -49,7 +58,12 @@ public:
                  core::IAllocator& allocator);
 
     //! Create endpoint.
-    ReceiverEndpoint* create_endpoint(address::Interface iface, address::Protocol proto);
+    //! @remarks
+    //!  If @p outbound_writer is non-NULL, it's used to send packets back to
+    //!  remote peer. Only control endpoint supports it.
+    ReceiverEndpoint* create_endpoint(address::Interface iface,
+                                      address::Protocol proto,
+                                      packet::IWriter* outbound_writer);
 
     //! Delete endpoint.
     void delete_endpoint(address::Interface iface);
@@ -63,15 +77,21 @@ public:
     //! Get number of alive sessions.
     size_t num_sessions() const;
 
+    //! Get metrics of sessions.
+    //! @see ReceiverSessionGroup::get_metrics().
+    void get_metrics(ReceiverSessionMetrics* metrics, size_t* metrics_size) const;
+
 private:
     ReceiverEndpoint* create_source_endpoint_(address::Protocol proto);
     ReceiverEndpoint* create_repair_endpoint_(address::Protocol proto);
-    ReceiverEndpoint* create_control_endpoint_(address::Protocol proto);
+    ReceiverEndpoint* create_control_endpoint_(address::Protocol proto,
+                                               packet::IWriter* outbound_writer);
 
     const rtp::FormatMap& format_map_;
 
     ReceiverState& receiver_state_;
-    ReceiverSessionGroup session_group_;
+    core::Optional<ReceiverSessionGroup> own_session_group_;
+    ReceiverSessionGroup* session_group_;
 
     core::Optional<ReceiverEndpoint> source_endpoint_;
     core::Optional<ReceiverEndpoint> repair_endpoint_;
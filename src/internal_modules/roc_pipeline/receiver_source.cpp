@@ -30,6 +30,13 @@ ReceiverSource::ReceiverSource(
     , audio_reader_(NULL)
     , config_(config)
     , timestamp_(0) {
+    if (config.common.async_session_creation) {
+        session_builder_.reset(new (session_builder_) ReceiverSessionBuilder());
+        if (!session_builder_ || !session_builder_->valid()) {
+            return;
+        }
+    }
+
     mixer_.reset(new (mixer_) audio::Mixer(sample_buffer_factory,
                                            config.common.internal_frame_length,
                                            config.common.output_sample_spec));
@@ -38,6 +45,14 @@ ReceiverSource::ReceiverSource(
     }
     audio::IFrameReader* areader = mixer_.get();
 
+    if (config.common.multipath) {
+        // all slots route packets to one group, so that streams received
+        // via different slots are merged by RTP source
+        shared_session_group_.reset(new (shared_session_group_) ReceiverSessionGroup(
+            config_, state_, *mixer_, session_builder_.get(), format_map,
+            packet_factory, byte_buffer_factory, sample_buffer_factory, allocator));
+    }
+
     if (config.common.poisoning) {
         poisoner_.reset(new (poisoner_) audio::PoisonReader(*areader));
         if (!poisoner_) {
@@ -49,7 +64,7 @@ ReceiverSource::ReceiverSource(
     if (config.common.profiling) {
         profiler_.reset(new (profiler_) audio::ProfilingReader(
             *areader, allocator, config.common.output_sample_spec,
-            config.common.profiler_config));
+            config.common.profiler_config, "receiver"));
         if (!profiler_ || !profiler_->valid()) {
             return;
         }
@@ -65,7 +80,8 @@ bool ReceiverSource::valid() const {
 
 ReceiverSlot* ReceiverSource::create_slot() {
     core::SharedPtr<ReceiverSlot> slot = new (allocator_)
-        ReceiverSlot(config_, state_, *mixer_, format_map_, packet_factory_,
+        ReceiverSlot(config_, state_, *mixer_, session_builder_.get(),
+                     shared_session_group_.get(), format_map_, packet_factory_,
                      byte_buffer_factory_, sample_buffer_factory_, allocator_);
     if (!slot) {
         return NULL;
@@ -79,6 +95,27 @@ size_t ReceiverSource::num_sessions() const {
     return state_.num_sessions();
 }
 
+void ReceiverSource::get_metrics(ReceiverSessionMetrics* metrics,
+                                 size_t* metrics_size) const {
+    roc_panic_if(!metrics_size);
+
+    if (shared_session_group_) {
+        shared_session_group_->get_metrics(metrics, metrics_size);
+        return;
+    }
+
+    size_t n = 0;
+
+    for (core::SharedPtr<ReceiverSlot> slot = slots_.front(); slot;
+         slot = slots_.nextof(*slot)) {
+        size_t slot_size = *metrics_size - n;
+        slot->get_metrics(metrics + n, &slot_size);
+        n += slot_size;
+    }
+
+    *metrics_size = n;
+}
+
 sndio::DeviceType ReceiverSource::type() const {
     return sndio::DeviceType_Source;
 }
@@ -96,6 +133,11 @@ sndio::DeviceState ReceiverSource::state() const {
         return sndio::DeviceState_Active;
     }
 
+    if (state_.has_pending_sessions()) {
+        // we don't have sessions, but some sessions are being created
+        return sndio::DeviceState_Active;
+    }
+
     // no sessions and packets; we can sleep until there are some
     return sndio::DeviceState_Idle;
 }
@@ -131,6 +173,10 @@ void ReceiverSource::reclock(packet::ntp_timestamp_t timestamp) {
          slot = slots_.nextof(*slot)) {
         slot->reclock(timestamp);
     }
+
+    if (shared_session_group_) {
+        shared_session_group_->reclock_sessions(timestamp);
+    }
 }
 
 bool ReceiverSource::read(audio::Frame& frame) {
@@ -141,6 +187,10 @@ bool ReceiverSource::read(audio::Frame& frame) {
         slot->advance(timestamp_);
     }
 
+    if (shared_session_group_) {
+        shared_session_group_->advance_sessions(timestamp_);
+    }
+
     if (!audio_reader_->read(frame)) {
         return false;
     }
@@ -26,6 +26,8 @@
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/receiver_endpoint.h"
+#include "roc_pipeline/receiver_session_builder.h"
+#include "roc_pipeline/receiver_session_group.h"
 #include "roc_pipeline/receiver_slot.h"
 #include "roc_pipeline/receiver_state.h"
 #include "roc_rtp/format_map.h"
@@ -38,6 +40,7 @@ namespace pipeline {
 //!
 //! Contains:
 //!  - one or more receiver slots
+//!  - session group shared by all slots, in multipath mode
 //!  - mixer, to mix audio from all slots
 //!
 //! Pipeline:
@@ -62,6 +65,10 @@ public:
     //! Get number of connected sessions.
     size_t num_sessions() const;
 
+    //! Get metrics of sessions of all slots.
+    //! @see ReceiverSessionGroup::get_metrics().
+    void get_metrics(ReceiverSessionMetrics* metrics, size_t* metrics_size) const;
+
     //! Get device type.
     virtual sndio::DeviceType type() const;
 
@@ -101,6 +108,11 @@ private:
     core::IAllocator& allocator_;
 
     ReceiverState state_;
+
+    core::Optional<ReceiverSessionBuilder> session_builder_;
+
+    core::Optional<ReceiverSessionGroup> shared_session_group_;
+
     core::List<ReceiverSlot> slots_;
 
     core::Optional<audio::Mixer> mixer_;
@@ -14,6 +14,7 @@ namespace pipeline {
 
 ReceiverState::ReceiverState()
     : pending_packets_(0)
+    , pending_sessions_(0)
     , sessions_(0) {
 }
 
@@ -26,6 +27,15 @@ void ReceiverState::add_pending_packets(int increment) {
     roc_panic_if(result < 0);
 }
 
+bool ReceiverState::has_pending_sessions() const {
+    return pending_sessions_;
+}
+
+void ReceiverState::add_pending_sessions(int increment) {
+    const long result = pending_sessions_ += increment;
+    roc_panic_if(result < 0);
+}
+
 size_t ReceiverState::num_sessions() const {
     return (size_t)sessions_;
 }
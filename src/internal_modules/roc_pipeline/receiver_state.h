@@ -32,6 +32,12 @@ public:
     //! Add given number to pending packets counter.
     void add_pending_packets(int increment);
 
+    //! Check whether pending sessions counter is non-zero.
+    bool has_pending_sessions() const;
+
+    //! Add given number to pending sessions counter.
+    void add_pending_sessions(int increment);
+
     //! Get sessions counter.
     size_t num_sessions() const;
 
@@ -40,6 +46,7 @@ public:
 
 private:
     core::Atomic<int> pending_packets_;
+    core::Atomic<int> pending_sessions_;
     core::Atomic<int> sessions_;
 };
 
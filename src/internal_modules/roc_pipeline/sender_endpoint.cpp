@@ -15,10 +15,13 @@
 namespace roc {
 namespace pipeline {
 
-SenderEndpoint::SenderEndpoint(address::Protocol proto, core::IAllocator& allocator)
+SenderEndpoint::SenderEndpoint(address::Protocol proto,
+                               const SenderConfig& config,
+                               core::IAllocator& allocator)
     : proto_(proto)
     , dst_writer_(NULL)
-    , composer_(NULL) {
+    , composer_(NULL)
+    , parser_(NULL) {
     packet::IComposer* composer = NULL;
 
     switch (proto) {
@@ -36,6 +39,17 @@ SenderEndpoint::SenderEndpoint(address::Protocol proto, core::IAllocator& alloca
     }
 
     switch (proto) {
+    case address::Proto_RTP:
+        if (config.redundancy_depth != 0) {
+            redundancy_composer_.reset(
+                new (redundancy_composer_)
+                    rtp::RedundancyComposer(*composer, config.redundancy_depth));
+            if (!redundancy_composer_) {
+                return;
+            }
+            composer = redundancy_composer_.get();
+        }
+        break;
     case address::Proto_RTP_LDPC_Source:
         fec_composer_.reset(
             new (allocator)
@@ -89,6 +103,12 @@ SenderEndpoint::SenderEndpoint(address::Protocol proto, core::IAllocator& alloca
             return;
         }
         composer = rtcp_composer_.get();
+
+        rtcp_parser_.reset(new (rtcp_parser_) rtcp::Parser());
+        if (!rtcp_parser_) {
+            return;
+        }
+        parser_ = rtcp_parser_.get();
         break;
     default:
         break;
@@ -145,6 +165,45 @@ void SenderEndpoint::set_destination_address(const address::SocketAddr& addr) {
     dst_address_ = addr;
 }
 
+packet::IWriter* SenderEndpoint::inbound_writer() {
+    roc_panic_if(!valid());
+
+    if (!parser_) {
+        return NULL;
+    }
+
+    return &inbound_writer_;
+}
+
+packet::PacketPtr SenderEndpoint::pull_packet() {
+    roc_panic_if(!valid());
+
+    if (!parser_) {
+        return NULL;
+    }
+
+    // see comment in ReceiverEndpoint::pull_packets() regarding
+    // try_pop_front_exclusive()
+    while (packet::PacketPtr packet = inbound_writer_.queue.try_pop_front_exclusive()) {
+        if (!parser_->parse(*packet, packet->data())) {
+            roc_log(LogDebug, "sender endpoint: can't parse packet");
+            continue;
+        }
+
+        return packet;
+    }
+
+    return NULL;
+}
+
+void SenderEndpoint::InboundWriter::write(const packet::PacketPtr& packet) {
+    if (!packet) {
+        roc_panic("sender endpoint: unexpected null packet");
+    }
+
+    queue.push_back(*packet);
+}
+
 void SenderEndpoint::write(const packet::PacketPtr& packet) {
     roc_panic_if(!valid());
 
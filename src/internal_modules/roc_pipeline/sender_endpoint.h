@@ -13,15 +13,19 @@
 #define ROC_PIPELINE_SENDER_ENDPOINT_H_
 
 #include "roc_core/iallocator.h"
+#include "roc_core/mpsc_queue.h"
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_packet/icomposer.h"
+#include "roc_packet/iparser.h"
 #include "roc_packet/iwriter.h"
 #include "roc_pipeline/config.h"
 #include "roc_rtcp/composer.h"
+#include "roc_rtcp/parser.h"
 #include "roc_rtp/composer.h"
+#include "roc_rtp/redundancy_composer.h"
 
 namespace roc {
 namespace pipeline {
@@ -30,10 +34,13 @@ namespace pipeline {
 //!
 //! Contains:
 //!  - a pipeline for processing packets for single network endpoint
+//!  - for control endpoint, a queue of packets received from network endpoint
 class SenderEndpoint : public core::NonCopyable<>, private packet::IWriter {
 public:
     //! Initialize.
-    SenderEndpoint(address::Protocol proto, core::IAllocator& allocator);
+    SenderEndpoint(address::Protocol proto,
+                   const SenderConfig& config,
+                   core::IAllocator& allocator);
 
     //! Check if pipeline was succefully constructed.
     bool valid() const;
@@ -68,7 +75,29 @@ public:
     //!  the specified destination address.
     void set_destination_address(const address::SocketAddr&);
 
+    //! Get inbound packet writer.
+    //! @remarks
+    //!  Packets passed to this writer will be returned by pull_packet().
+    //!  This writer is thread-safe and lock-free.
+    //!  The writer is passed to netio thread.
+    //! @returns
+    //!  NULL if endpoint protocol doesn't expect packets from network.
+    packet::IWriter* inbound_writer();
+
+    //! Pull next packet written to inbound writer.
+    //! @remarks
+    //!  Returns parsed packet, or NULL if there are no more packets.
+    //!  Packets that can't be parsed are dropped.
+    packet::PacketPtr pull_packet();
+
 private:
+    class InboundWriter : public packet::IWriter {
+    public:
+        virtual void write(const packet::PacketPtr& packet);
+
+        core::MpscQueue<packet::Packet> queue;
+    };
+
     virtual void write(const packet::PacketPtr& packet);
 
     const address::Protocol proto_;
@@ -79,8 +108,15 @@ private:
     packet::IComposer* composer_;
 
     core::Optional<rtp::Composer> rtp_composer_;
+    core::Optional<rtp::RedundancyComposer> redundancy_composer_;
     core::ScopedPtr<packet::IComposer> fec_composer_;
     core::Optional<rtcp::Composer> rtcp_composer_;
+
+    packet::IParser* parser_;
+
+    core::Optional<rtcp::Parser> rtcp_parser_;
+
+    InboundWriter inbound_writer_;
 };
 
 } // namespace pipeline
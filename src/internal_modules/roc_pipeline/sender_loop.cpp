@@ -55,6 +55,13 @@ SenderLoop::EndpointHandle SenderLoop::Tasks::CreateEndpoint::get_handle() const
     return (EndpointHandle)endpoint_;
 }
 
+packet::IWriter* SenderLoop::Tasks::CreateEndpoint::get_inbound_writer() const {
+    if (!success()) {
+        return NULL;
+    }
+    return writer_;
+}
+
 SenderLoop::Tasks::SetEndpointDestinationWriter::SetEndpointDestinationWriter(
     EndpointHandle endpoint, packet::IWriter& writer) {
     func_ = &SenderLoop::task_set_endpoint_destination_writer_;
@@ -84,6 +91,7 @@ SenderLoop::Tasks::CheckSlotIsReady::CheckSlotIsReady(SlotHandle slot) {
 }
 
 SenderLoop::SenderLoop(IPipelineTaskScheduler& scheduler,
+                       ISenderUpdateScheduler& update_scheduler,
                        const SenderConfig& config,
                        const rtp::FormatMap& format_map,
                        packet::PacketFactory& packet_factory,
@@ -91,6 +99,7 @@ SenderLoop::SenderLoop(IPipelineTaskScheduler& scheduler,
                        core::BufferFactory<audio::sample_t>& sample_buffer_factory,
                        core::IAllocator& allocator)
     : PipelineLoop(scheduler, config.tasks, config.input_sample_spec)
+    , update_scheduler_(update_scheduler)
     , sink_(config,
             format_map,
             packet_factory,
@@ -98,6 +107,7 @@ SenderLoop::SenderLoop(IPipelineTaskScheduler& scheduler,
             sample_buffer_factory,
             allocator)
     , timestamp_(0)
+    , update_deadline_(0)
     , valid_(false) {
     if (!sink_.valid()) {
         return;
@@ -108,6 +118,7 @@ SenderLoop::SenderLoop(IPipelineTaskScheduler& scheduler,
         if (!ticker_) {
             return;
         }
+        ticker_->set_spin_budget(config.tasks.busy_poll_budget);
     }
 
     valid_ = true;
@@ -205,6 +216,23 @@ void SenderLoop::write(audio::Frame& frame) {
         packet::timestamp_t(frame.num_samples() / sink_.sample_spec().num_channels());
 }
 
+void SenderLoop::update() {
+    roc_panic_if_not(valid());
+
+    lock_pipeline();
+
+    // scheduled update is fired
+    update_deadline_ = 0;
+
+    if (sink_.get_update_deadline() <= core::timestamp(core::ClockMonotonic)) {
+        sink_.update();
+    }
+
+    schedule_update_();
+
+    unlock_pipeline();
+}
+
 core::nanoseconds_t SenderLoop::timestamp_imp() const {
     return core::timestamp(core::ClockMonotonic);
 }
@@ -216,6 +244,8 @@ bool SenderLoop::process_subframe_imp(audio::Frame& frame) {
         sink_.update();
     }
 
+    schedule_update_();
+
     return true;
 }
 
@@ -235,7 +265,12 @@ bool SenderLoop::task_create_endpoint_(Task& task) {
     roc_panic_if(!task.slot_);
 
     task.endpoint_ = task.slot_->create_endpoint(task.iface_, task.proto_);
-    return (bool)task.endpoint_;
+    if (!task.endpoint_) {
+        return false;
+    }
+
+    task.writer_ = task.endpoint_->inbound_writer();
+    return true;
 }
 
 bool SenderLoop::task_set_endpoint_destination_writer_(Task& task) {
@@ -259,5 +294,16 @@ bool SenderLoop::task_check_slot_is_ready_(Task& task) {
     return task.slot_->is_ready();
 }
 
+void SenderLoop::schedule_update_() {
+    const core::nanoseconds_t deadline = sink_.get_update_deadline();
+
+    if (deadline == 0 || deadline == update_deadline_) {
+        return;
+    }
+
+    update_deadline_ = deadline;
+    update_scheduler_.schedule_update(*this, deadline);
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -17,6 +17,7 @@
 #include "roc_core/mutex.h"
 #include "roc_core/ticker.h"
 #include "roc_pipeline/config.h"
+#include "roc_pipeline/isender_update_scheduler.h"
 #include "roc_pipeline/pipeline_loop.h"
 #include "roc_pipeline/sender_sink.h"
 #include "roc_sndio/isink.h"
@@ -37,6 +38,10 @@ namespace pipeline {
 //!  - PipelineLoop - can be used to schedule tasks on the pipeline
 //!    (can be used from any thread)
 //!
+//! Some work, like sending packets delayed by pacer, should be done between
+//! frames. SenderLoop requests it via ISenderUpdateScheduler, which should
+//! invoke update() at requested time.
+//!
 //! @note
 //!  Private inheritance from ISink is used to decorate actual implementation
 //!  of ISink - SenderSource, in order to integrate it with PipelineLoop.
@@ -91,6 +96,13 @@ public:
 
             //! Get created endpoint handle.
             EndpointHandle get_handle() const;
+
+            //! Get writer for packets received from network.
+            //! @remarks
+            //!  The returned writer may be used from any thread.
+            //!  Returns NULL if endpoint doesn't receive packets; only control
+            //!  endpoint does.
+            packet::IWriter* get_inbound_writer() const;
         };
 
         //! Set writer to which endpoint will write packets.
@@ -120,6 +132,7 @@ public:
 
     //! Initialize.
     SenderLoop(IPipelineTaskScheduler& scheduler,
+               ISenderUpdateScheduler& update_scheduler,
                const SenderConfig& config,
                const rtp::FormatMap& format_map,
                packet::PacketFactory& packet_factory,
@@ -135,6 +148,12 @@ public:
     //!  Samples written to the sink are sent to remote peers.
     sndio::ISink& sink();
 
+    //! Process sink updates that are due.
+    //! @remarks
+    //!  Sends packets delayed by pacer and generates control packets without
+    //!  waiting for next frame. Should be invoked by ISenderUpdateScheduler.
+    void update();
+
 private:
     // Methods of sndio::ISink
     virtual sndio::DeviceType type() const;
@@ -159,6 +178,10 @@ private:
     bool task_set_endpoint_destination_address_(Task&);
     bool task_check_slot_is_ready_(Task&);
 
+    void schedule_update_();
+
+    ISenderUpdateScheduler& update_scheduler_;
+
     SenderSink sink_;
 
     core::Optional<core::Ticker> ticker_;
@@ -166,6 +189,9 @@ private:
 
     core::Mutex sink_mutex_;
 
+    // deadline passed to update scheduler
+    core::nanoseconds_t update_deadline_;
+
     bool valid_;
 };
 
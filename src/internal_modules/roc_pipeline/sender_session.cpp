@@ -26,8 +26,13 @@ SenderSession::SenderSession(const SenderConfig& config,
     , packet_factory_(packet_factory)
     , byte_buffer_factory_(byte_buffer_factory)
     , sample_buffer_factory_(sample_buffer_factory)
+    , source_proto_(address::Proto_None)
+    , repair_proto_(address::Proto_None)
     , audio_writer_(NULL)
-    , num_sources_(0) {
+    , paced_writer_(NULL)
+    , transport_session_(NULL)
+    , num_sources_(0)
+    , rtt_(0) {
 }
 
 bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
@@ -35,14 +40,6 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
     roc_panic_if(audio_writer_);
     roc_panic_if(!source_endpoint);
 
-    if (source_endpoint) {
-        num_sources_++;
-    }
-
-    if (repair_endpoint) {
-        num_sources_++;
-    }
-
     const rtp::Format* format = format_map_.format(config_.payload_type);
     if (!format) {
         return false;
@@ -54,24 +51,76 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
     }
     packet::IWriter* pwriter = router_.get();
 
-    if (!router_->add_route(source_endpoint->writer(), packet::Packet::FlagAudio)) {
+    source_fanout_.reset(new (source_fanout_)
+                             packet::Fanout(packet_factory_, allocator_));
+    if (!source_fanout_ || !source_fanout_->add_output(source_endpoint->writer())) {
+        return false;
+    }
+
+    if (!router_->add_route(*source_fanout_, packet::Packet::FlagAudio)) {
         return false;
     }
 
+    source_proto_ = source_endpoint->proto();
+
     if (repair_endpoint) {
-        if (!router_->add_route(repair_endpoint->writer(), packet::Packet::FlagRepair)) {
+        repair_fanout_.reset(new (repair_fanout_)
+                                 packet::Fanout(packet_factory_, allocator_));
+        if (!repair_fanout_ || !repair_fanout_->add_output(repair_endpoint->writer())) {
+            return false;
+        }
+
+        if (!router_->add_route(*repair_fanout_, packet::Packet::FlagRepair)) {
+            return false;
+        }
+
+        repair_proto_ = repair_endpoint->proto();
+    }
+
+    // pacer goes after interleaver and FEC writer, which both produce
+    // packets in bursts
+    if (config_.pacing) {
+        pacer_.reset(new (pacer_) packet::Pacer(*pwriter, allocator_, config_.pacer));
+        if (!pacer_ || !pacer_->valid()) {
             return false;
         }
+        pwriter = pacer_.get();
+
+        if (repair_endpoint) {
+            update_pacer_interval_(config_.fec_writer.n_source_packets,
+                                   config_.fec_writer.n_repair_packets);
+        } else {
+            update_pacer_interval_(1, 0);
+        }
+    }
 
+    if (repair_endpoint) {
         if (config_.interleaving) {
-            interleaver_.reset(new (interleaver_) packet::Interleaver(
-                *pwriter, allocator_,
-                config_.fec_writer.n_source_packets
-                    + config_.fec_writer.n_repair_packets));
-            if (!interleaver_ || !interleaver_->valid()) {
-                return false;
+            // with adaptation, interleave over largest possible block
+            const size_t n_repair_packets = config_.fec_adaptation
+                ? std::max(config_.fec_writer.n_repair_packets,
+                           config_.fec_redundancy.max_repair_packets)
+                : config_.fec_writer.n_repair_packets;
+
+            const size_t block_length =
+                config_.fec_writer.n_source_packets + n_repair_packets;
+
+            if (config_.interleaving_depth > 1) {
+                block_interleaver_.reset(
+                    new (block_interleaver_) packet::BlockInterleaver(
+                        *pwriter, allocator_, config_.interleaving_depth, block_length));
+                if (!block_interleaver_ || !block_interleaver_->valid()) {
+                    return false;
+                }
+                pwriter = block_interleaver_.get();
+            } else {
+                interleaver_.reset(new (interleaver_) packet::Interleaver(
+                    *pwriter, allocator_, block_length));
+                if (!interleaver_ || !interleaver_->valid()) {
+                    return false;
+                }
+                pwriter = interleaver_.get();
             }
-            pwriter = interleaver_.get();
         }
 
         fec_encoder_.reset(fec::CodecMap::instance().new_encoder(
@@ -89,6 +138,23 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             return false;
         }
         pwriter = fec_writer_.get();
+
+        if (config_.fec_adaptation) {
+            fec::RedundancyControllerConfig controller_config = config_.fec_redundancy;
+            controller_config.max_interleaving_depth =
+                block_interleaver_ ? block_interleaver_->max_depth() : 1;
+
+            fec_controller_.reset(new (fec_controller_) fec::RedundancyController(
+                controller_config, config_.fec_writer.n_source_packets,
+                config_.fec_writer.n_repair_packets));
+            if (!fec_controller_) {
+                return false;
+            }
+
+            if (block_interleaver_) {
+                block_interleaver_->set_depth(fec_controller_->interleaving_depth());
+            }
+        }
     }
 
     payload_encoder_.reset(format->new_encoder(allocator_), allocator_);
@@ -106,6 +172,18 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
 
     audio::IFrameWriter* awriter = packetizer_.get();
 
+    // Per-stage probes measure time spent in the stage and all stages after
+    // it, so that the cost of a stage is the difference between neighbours.
+    if (config_.profiling) {
+        packetizer_profiler_.reset(new (packetizer_profiler_) audio::ProfilingWriter(
+            *awriter, allocator_, format->sample_spec, config_.profiler_config,
+            "packetizer"));
+        if (!packetizer_profiler_ || !packetizer_profiler_->valid()) {
+            return false;
+        }
+        awriter = packetizer_profiler_.get();
+    }
+
     if (format->sample_spec.channel_mask() != config_.input_sample_spec.channel_mask()) {
         channel_mapper_writer_.reset(
             new (channel_mapper_writer_) audio::ChannelMapperWriter(
@@ -150,13 +228,92 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             return false;
         }
         awriter = resampler_writer_.get();
+
+        if (config_.profiling) {
+            resampler_profiler_.reset(new (resampler_profiler_) audio::ProfilingWriter(
+                *awriter, allocator_, config_.input_sample_spec, config_.profiler_config,
+                "resampler"));
+            if (!resampler_profiler_ || !resampler_profiler_->valid()) {
+                return false;
+            }
+            awriter = resampler_profiler_.get();
+        }
+    }
+
+    // pacer clock is advanced before every frame, so that packets produced
+    // from the frame are queued and sent using current time
+    if (pacer_) {
+        paced_writer_ = awriter;
+        awriter = this;
     }
 
     audio_writer_ = awriter;
 
+    // sources are reported only when pipeline is complete
+    num_sources_ = repair_endpoint ? 2 : 1;
+
+    return true;
+}
+
+bool SenderSession::can_share_transport_pipeline(SenderEndpoint* source_endpoint,
+                                                 SenderEndpoint* repair_endpoint) const {
+    roc_panic_if(!source_endpoint);
+
+    if (!audio_writer_) {
+        return false;
+    }
+
+    // endpoints with the same protocols use equivalent composers, so packets
+    // prepared for our endpoints are valid for their endpoints as well
+    return source_endpoint->proto() == source_proto_
+        && (repair_endpoint ? repair_endpoint->proto() : address::Proto_None)
+        == repair_proto_;
+}
+
+bool SenderSession::share_transport_pipeline(SenderEndpoint* source_endpoint,
+                                             SenderEndpoint* repair_endpoint) {
+    roc_panic_if(!can_share_transport_pipeline(source_endpoint, repair_endpoint));
+
+    if (!source_fanout_->add_output(source_endpoint->writer())) {
+        return false;
+    }
+
+    if (repair_endpoint) {
+        if (!repair_fanout_->add_output(repair_endpoint->writer())) {
+            return false;
+        }
+    }
+
+    roc_log(LogDebug, "sender session: sharing transport pipeline: n_destinations=%lu",
+            (unsigned long)source_fanout_->num_outputs());
+
     return true;
 }
 
+void SenderSession::unshare_transport_pipeline(SenderEndpoint* source_endpoint,
+                                               SenderEndpoint* repair_endpoint) {
+    roc_panic_if(!source_endpoint);
+    roc_panic_if(!source_fanout_);
+
+    source_fanout_->remove_output(source_endpoint->writer());
+
+    if (repair_endpoint) {
+        roc_panic_if(!repair_fanout_);
+        repair_fanout_->remove_output(repair_endpoint->writer());
+    }
+
+    roc_log(LogDebug,
+            "sender session: unsharing transport pipeline: n_destinations=%lu",
+            (unsigned long)source_fanout_->num_outputs());
+}
+
+void SenderSession::set_transport_session(SenderSession* session) {
+    roc_panic_if(session == this);
+    roc_panic_if(session && audio_writer_);
+
+    transport_session_ = session;
+}
+
 bool SenderSession::create_control_pipeline(SenderEndpoint* control_endpoint) {
     roc_panic_if(rtcp_session_);
     roc_panic_if(!control_endpoint);
@@ -180,29 +337,85 @@ audio::IFrameWriter* SenderSession::writer() const {
     return audio_writer_;
 }
 
+SenderSessionMetrics SenderSession::get_metrics() const {
+    SenderSessionMetrics metrics;
+
+    if (transport_session_) {
+        metrics.source = transport_session_->get_metrics().source;
+    } else if (packetizer_) {
+        metrics.source = packetizer_->source();
+    }
+
+    metrics.rtt = rtt_;
+
+    return metrics;
+}
+
+void SenderSession::route_control_packet(const packet::PacketPtr& packet) {
+    roc_panic_if(!rtcp_session_);
+
+    if (!packet->rtcp()) {
+        roc_panic("sender session: unexpected non-rtcp packet");
+    }
+
+    rtcp_session_->process_packet(packet);
+}
+
 core::nanoseconds_t SenderSession::get_update_deadline() const {
+    core::nanoseconds_t deadline = 0;
+
     if (rtcp_session_) {
-        return rtcp_session_->generation_deadline();
+        deadline = rtcp_session_->generation_deadline();
     }
 
-    return 0;
+    if (pacer_) {
+        const core::nanoseconds_t pacer_deadline = pacer_->deadline();
+
+        if (pacer_deadline != 0 && (deadline == 0 || pacer_deadline < deadline)) {
+            deadline = pacer_deadline;
+        }
+    }
+
+    return deadline;
+}
+
+void SenderSession::write(audio::Frame& frame) {
+    roc_panic_if(!pacer_ || !paced_writer_);
+
+    pacer_->advance(core::timestamp(core::ClockMonotonic));
+    paced_writer_->write(frame);
 }
 
 void SenderSession::update() {
-    if (rtcp_session_) {
+    if (pacer_) {
+        pacer_->advance(core::timestamp(core::ClockMonotonic));
+    }
+
+    // update may be invoked for pacer, before report is due
+    if (rtcp_session_
+        && rtcp_session_->generation_deadline()
+            <= core::timestamp(core::ClockMonotonic)) {
         rtcp_session_->generate_packets();
     }
 }
 
 size_t SenderSession::on_get_num_sources() {
+    if (transport_session_) {
+        return transport_session_->on_get_num_sources();
+    }
+
     return num_sources_;
 }
 
 packet::source_t SenderSession::on_get_sending_source(size_t source_index) {
+    if (transport_session_) {
+        return transport_session_->on_get_sending_source(source_index);
+    }
+
     switch (source_index) {
     case 0:
-        // TODO
-        return 123;
+        roc_panic_if(!packetizer_);
+        return packetizer_->source();
 
     case 1:
         // TODO
@@ -215,6 +428,10 @@ packet::source_t SenderSession::on_get_sending_source(size_t source_index) {
 
 rtcp::SendingMetrics
 SenderSession::on_get_sending_metrics(packet::ntp_timestamp_t report_time) {
+    if (transport_session_) {
+        return transport_session_->on_get_sending_metrics(report_time);
+    }
+
     // TODO
 
     rtcp::SendingMetrics metrics;
@@ -224,13 +441,61 @@ SenderSession::on_get_sending_metrics(packet::ntp_timestamp_t report_time) {
 }
 
 void SenderSession::on_add_reception_metrics(const rtcp::ReceptionMetrics& metrics) {
-    // TODO
-    (void)metrics;
+    if (transport_session_) {
+        // shared FEC controller adapts to reports from all destinations
+        transport_session_->on_add_reception_metrics(metrics);
+        return;
+    }
+
+    // reports may describe other streams received by the same receiver
+    if (!packetizer_ || metrics.ssrc != packetizer_->source()) {
+        return;
+    }
+
+    if (!fec_controller_) {
+        return;
+    }
+
+    fec_controller_->update(metrics.fract_loss, metrics.loss_runs);
+
+    // new size is applied by writer starting from next block; if it exceeds
+    // codec limits, writer keeps current size
+    if (fec_writer_->resize(fec_controller_->n_source_packets(),
+                            fec_controller_->n_repair_packets())) {
+        update_pacer_interval_(fec_controller_->n_source_packets(),
+                               fec_controller_->n_repair_packets());
+    }
+
+    // new depth is applied by interleaver starting from next group of blocks
+    if (block_interleaver_) {
+        block_interleaver_->set_depth(fec_controller_->interleaving_depth());
+    }
 }
 
 void SenderSession::on_add_link_metrics(const rtcp::LinkMetrics& metrics) {
-    // TODO
-    (void)metrics;
+    // round-trip is measured per receiver, so unlike reception metrics,
+    // it's not passed to shared transport session
+    if (on_get_num_sources() == 0 || metrics.ssrc != on_get_sending_source(0)) {
+        return;
+    }
+
+    rtt_ = metrics.rtt;
+
+    roc_log(LogTrace, "sender session: got link metrics: rtt=%.3fms",
+            (double)metrics.rtt / core::Millisecond);
+}
+
+void SenderSession::update_pacer_interval_(size_t n_source_packets,
+                                           size_t n_repair_packets) {
+    if (!pacer_) {
+        return;
+    }
+
+    // every source packet carries packet_length of audio, and repair packets
+    // share the same time slot, so nominal interval is shorter with FEC
+    pacer_->set_interval(core::nanoseconds_t(
+        double(config_.packet_length) * double(n_source_packets)
+        / double(n_source_packets + n_repair_packets)));
 }
 
 } // namespace pipeline
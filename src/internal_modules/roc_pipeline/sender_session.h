@@ -14,9 +14,11 @@
 
 #include "roc_audio/channel_mapper_writer.h"
 #include "roc_audio/iframe_encoder.h"
+#include "roc_audio/iframe_writer.h"
 #include "roc_audio/iresampler.h"
 #include "roc_audio/packetizer.h"
 #include "roc_audio/poison_writer.h"
+#include "roc_audio/profiling_writer.h"
 #include "roc_audio/resampler_map.h"
 #include "roc_audio/resampler_writer.h"
 #include "roc_core/buffer_factory.h"
@@ -25,11 +27,16 @@
 #include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_fec/iblock_encoder.h"
+#include "roc_fec/redundancy_controller.h"
 #include "roc_fec/writer.h"
+#include "roc_packet/block_interleaver.h"
+#include "roc_packet/fanout.h"
 #include "roc_packet/interleaver.h"
+#include "roc_packet/pacer.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_packet/router.h"
 #include "roc_pipeline/config.h"
+#include "roc_pipeline/metrics.h"
 #include "roc_pipeline/sender_endpoint.h"
 #include "roc_rtcp/composer.h"
 #include "roc_rtcp/session.h"
@@ -43,7 +50,13 @@ namespace pipeline {
 //! Contains:
 //!  - a pipeline for processing audio frames from single sender and converting
 //!    them into packets
-class SenderSession : public core::NonCopyable<>, private rtcp::ISenderHooks {
+//!
+//! Transport pipeline may be shared by multiple slots with the same endpoint
+//! protocols. In this case audio is encoded once, and packets are duplicated
+//! to endpoints of every slot.
+class SenderSession : public core::NonCopyable<>,
+                      private audio::IFrameWriter,
+                      private rtcp::ISenderHooks {
 public:
     //! Initialize.
     SenderSession(const SenderConfig& config,
@@ -57,12 +70,52 @@ public:
     bool create_transport_pipeline(SenderEndpoint* source_endpoint,
                                    SenderEndpoint* repair_endpoint);
 
+    //! Check if transport sub-pipeline can be shared with given endpoints.
+    //! @remarks
+    //!  True if transport sub-pipeline is created, and given endpoints have
+    //!  the same protocols as endpoints it was created for.
+    bool can_share_transport_pipeline(SenderEndpoint* source_endpoint,
+                                      SenderEndpoint* repair_endpoint) const;
+
+    //! Add endpoints to existing transport sub-pipeline.
+    //! @remarks
+    //!  Packets produced by transport sub-pipeline will be duplicated to
+    //!  given endpoints too.
+    bool share_transport_pipeline(SenderEndpoint* source_endpoint,
+                                  SenderEndpoint* repair_endpoint);
+
+    //! Remove endpoints from existing transport sub-pipeline.
+    //! @remarks
+    //!  Should be called for endpoints added by share_transport_pipeline()
+    //!  before they are destroyed.
+    void unshare_transport_pipeline(SenderEndpoint* source_endpoint,
+                                    SenderEndpoint* repair_endpoint);
+
+    //! Use transport sub-pipeline of another session.
+    //! @remarks
+    //!  Control sub-pipeline of this session will report sources and sending
+    //!  metrics of @p session, and pass reception metrics to it. The caller
+    //!  should ensure that @p session outlives this session, or reset it to
+    //!  NULL before @p session is destroyed.
+    void set_transport_session(SenderSession* session);
+
     //! Create control sub-pipeline.
     bool create_control_pipeline(SenderEndpoint* control_endpoint);
 
     //! Get audio writer.
     audio::IFrameWriter* writer() const;
 
+    //! Get session metrics.
+    //! @remarks
+    //!  If transport sub-pipeline is shared, round-trip time is still
+    //!  specific to receiver of this session.
+    SenderSessionMetrics get_metrics() const;
+
+    //! Route packet received by control endpoint.
+    //! @remarks
+    //!  Passes reports from receivers to control sub-pipeline.
+    void route_control_packet(const packet::PacketPtr& packet);
+
     //! Get deadline when the pipeline should be updated.
     core::nanoseconds_t get_update_deadline() const;
 
@@ -70,6 +123,10 @@ public:
     void update();
 
 private:
+    // Implementation of audio::IFrameWriter interface.
+    // Used as audio writer when pacing is enabled.
+    virtual void write(audio::Frame& frame);
+
     // Implementation of rtcp::ISenderHooks interface.
     // These methods are invoked by rtcp::Session.
     virtual size_t on_get_num_sources();
@@ -79,6 +136,8 @@ private:
     virtual void on_add_reception_metrics(const rtcp::ReceptionMetrics& metrics);
     virtual void on_add_link_metrics(const rtcp::LinkMetrics& metrics);
 
+    void update_pacer_interval_(size_t n_source_packets, size_t n_repair_packets);
+
     core::IAllocator& allocator_;
 
     const SenderConfig& config_;
@@ -90,27 +149,43 @@ private:
     core::BufferFactory<audio::sample_t>& sample_buffer_factory_;
 
     core::Optional<packet::Router> router_;
+    core::Optional<packet::Pacer> pacer_;
+
+    core::Optional<packet::Fanout> source_fanout_;
+    core::Optional<packet::Fanout> repair_fanout_;
+
+    address::Protocol source_proto_;
+    address::Protocol repair_proto_;
 
     core::Optional<packet::Interleaver> interleaver_;
+    core::Optional<packet::BlockInterleaver> block_interleaver_;
 
     core::ScopedPtr<fec::IBlockEncoder> fec_encoder_;
     core::Optional<fec::Writer> fec_writer_;
+    core::Optional<fec::RedundancyController> fec_controller_;
 
     core::ScopedPtr<audio::IFrameEncoder> payload_encoder_;
     core::Optional<audio::Packetizer> packetizer_;
+    core::Optional<audio::ProfilingWriter> packetizer_profiler_;
 
     core::Optional<audio::ChannelMapperWriter> channel_mapper_writer_;
 
     core::Optional<audio::PoisonWriter> resampler_poisoner_;
     core::Optional<audio::ResamplerWriter> resampler_writer_;
     core::ScopedPtr<audio::IResampler> resampler_;
+    core::Optional<audio::ProfilingWriter> resampler_profiler_;
 
     core::Optional<rtcp::Composer> rtcp_composer_;
     core::Optional<rtcp::Session> rtcp_session_;
 
     audio::IFrameWriter* audio_writer_;
+    audio::IFrameWriter* paced_writer_;
+
+    SenderSession* transport_session_;
 
     size_t num_sources_;
+
+    core::nanoseconds_t rtt_;
 };
 
 } // namespace pipeline
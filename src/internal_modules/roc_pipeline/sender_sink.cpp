@@ -43,7 +43,8 @@ SenderSink::SenderSink(const SenderConfig& config,
 
     if (config.profiling) {
         profiler_.reset(new (profiler_) audio::ProfilingWriter(
-            *awriter, allocator, config.input_sample_spec, config.profiler_config));
+            *awriter, allocator, config.input_sample_spec, config.profiler_config,
+            "sender"));
         if (!profiler_ || !profiler_->valid()) {
             return;
         }
@@ -63,8 +64,8 @@ SenderSlot* SenderSink::create_slot() {
     roc_log(LogInfo, "sender sink: adding slot");
 
     core::SharedPtr<SenderSlot> slot = new (allocator_)
-        SenderSlot(config_, format_map_, fanout_, packet_factory_, byte_buffer_factory_,
-                   sample_buffer_factory_, allocator_);
+        SenderSlot(config_, format_map_, fanout_, slots_, packet_factory_,
+                   byte_buffer_factory_, sample_buffer_factory_, allocator_);
 
     if (!slot) {
         roc_log(LogError, "sender sink: can't allocate slot");
@@ -78,6 +79,20 @@ SenderSlot* SenderSink::create_slot() {
     return slot.get();
 }
 
+void SenderSink::get_metrics(SenderSessionMetrics* metrics,
+                             size_t* metrics_size) const {
+    roc_panic_if(!metrics_size);
+
+    size_t n = 0;
+
+    for (core::SharedPtr<SenderSlot> slot = slots_.front(); slot && n < *metrics_size;
+         slot = slots_.nextof(*slot)) {
+        metrics[n++] = slot->get_metrics();
+    }
+
+    *metrics_size = n;
+}
+
 core::nanoseconds_t SenderSink::get_update_deadline() {
     if (!update_deadline_valid_) {
         compute_update_deadline_();
@@ -131,7 +146,20 @@ bool SenderSink::has_clock() const {
 void SenderSink::write(audio::Frame& frame) {
     roc_panic_if(!valid());
 
+    // reports are applied before encoding frame, so that packets produced
+    // from it already use updated parameters
+    core::SharedPtr<SenderSlot> slot;
+
+    for (slot = slots_.front(); slot; slot = slots_.nextof(*slot)) {
+        slot->pull_packets();
+    }
+
     audio_writer_->write(frame);
+
+    // written packets may be queued by pacer, which moves update deadline
+    if (config_.pacing) {
+        invalidate_update_deadline_();
+    }
 }
 
 void SenderSink::compute_update_deadline_() {
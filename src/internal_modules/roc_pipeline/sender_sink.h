@@ -28,6 +28,7 @@
 #include "roc_packet/packet_factory.h"
 #include "roc_packet/router.h"
 #include "roc_pipeline/config.h"
+#include "roc_pipeline/metrics.h"
 #include "roc_pipeline/sender_endpoint.h"
 #include "roc_pipeline/sender_slot.h"
 #include "roc_rtp/format_map.h"
@@ -61,6 +62,12 @@ public:
     //! Create slot.
     SenderSlot* create_slot();
 
+    //! Get metrics of sessions of all slots.
+    //! @remarks
+    //!  Fills @p metrics with metrics of up to @p metrics_size slots and
+    //!  sets @p metrics_size to the number of filled entries.
+    void get_metrics(SenderSessionMetrics* metrics, size_t* metrics_size) const;
+
     //! Get deadline when the pipeline should be updated.
     core::nanoseconds_t get_update_deadline();
 
@@ -17,6 +17,7 @@ namespace pipeline {
 SenderSlot::SenderSlot(const SenderConfig& config,
                        const rtp::FormatMap& format_map,
                        audio::Fanout& fanout,
+                       core::List<SenderSlot>& peer_slots,
                        packet::PacketFactory& packet_factory,
                        core::BufferFactory<uint8_t>& byte_buffer_factory,
                        core::BufferFactory<audio::sample_t>& sample_buffer_factory,
@@ -24,6 +25,7 @@ SenderSlot::SenderSlot(const SenderConfig& config,
     : RefCounted(allocator)
     , config_(config)
     , fanout_(fanout)
+    , peer_slots_(peer_slots)
     , session_(config,
                format_map,
                packet_factory,
@@ -32,6 +34,14 @@ SenderSlot::SenderSlot(const SenderConfig& config,
                allocator) {
 }
 
+SenderSlot::~SenderSlot() {
+    if (shared_slot_) {
+        session_.set_transport_session(NULL);
+        shared_slot_->session_.unshare_transport_pipeline(source_endpoint_.get(),
+                                                          repair_endpoint_.get());
+    }
+}
+
 SenderEndpoint* SenderSlot::create_endpoint(address::Interface iface,
                                             address::Protocol proto) {
     roc_log(LogDebug, "sender slot: adding %s endpoint %s",
@@ -68,16 +78,10 @@ SenderEndpoint* SenderSlot::create_endpoint(address::Interface iface,
     case address::Iface_AudioRepair:
         if (source_endpoint_
             && (repair_endpoint_ || config_.fec_encoder.scheme == packet::FEC_None)) {
-            if (!session_.create_transport_pipeline(source_endpoint_.get(),
-                                                    repair_endpoint_.get())) {
+            if (!create_transport_pipeline_()) {
                 return NULL;
             }
         }
-        if (session_.writer()) {
-            if (!fanout_.has_output(*session_.writer())) {
-                fanout_.add_output(*session_.writer());
-            }
-        }
         break;
 
     case address::Iface_AudioControl:
@@ -100,10 +104,25 @@ audio::IFrameWriter* SenderSlot::writer() {
 }
 
 bool SenderSlot::is_ready() const {
-    return session_.writer() && source_endpoint_->has_destination_writer()
+    return (session_.writer() || shared_slot_)
+        && source_endpoint_->has_destination_writer()
         && (!repair_endpoint_ || repair_endpoint_->has_destination_writer());
 }
 
+SenderSessionMetrics SenderSlot::get_metrics() const {
+    return session_.get_metrics();
+}
+
+void SenderSlot::pull_packets() {
+    if (!control_endpoint_) {
+        return;
+    }
+
+    while (packet::PacketPtr packet = control_endpoint_->pull_packet()) {
+        session_.route_control_packet(packet);
+    }
+}
+
 core::nanoseconds_t SenderSlot::get_update_deadline() const {
     return session_.get_update_deadline();
 }
@@ -112,6 +131,46 @@ void SenderSlot::update() {
     session_.update();
 }
 
+bool SenderSlot::create_transport_pipeline_() {
+    if (core::SharedPtr<SenderSlot> slot = find_shared_slot_()) {
+        if (!slot->session_.share_transport_pipeline(source_endpoint_.get(),
+                                                     repair_endpoint_.get())) {
+            return false;
+        }
+        shared_slot_ = slot;
+        session_.set_transport_session(&slot->session_);
+        return true;
+    }
+
+    if (!session_.create_transport_pipeline(source_endpoint_.get(),
+                                            repair_endpoint_.get())) {
+        return false;
+    }
+
+    if (!fanout_.has_output(*session_.writer())) {
+        fanout_.add_output(*session_.writer());
+    }
+
+    return true;
+}
+
+core::SharedPtr<SenderSlot> SenderSlot::find_shared_slot_() {
+    core::SharedPtr<SenderSlot> slot;
+
+    for (slot = peer_slots_.front(); slot; slot = peer_slots_.nextof(*slot)) {
+        if (slot.get() == this) {
+            continue;
+        }
+
+        if (slot->session_.can_share_transport_pipeline(source_endpoint_.get(),
+                                                        repair_endpoint_.get())) {
+            return slot;
+        }
+    }
+
+    return NULL;
+}
+
 SenderEndpoint* SenderSlot::create_source_endpoint_(address::Protocol proto) {
     if (source_endpoint_) {
         roc_log(LogError, "sender slot: audio source endpoint is already set");
@@ -133,7 +192,8 @@ SenderEndpoint* SenderSlot::create_source_endpoint_(address::Protocol proto) {
         return NULL;
     }
 
-    source_endpoint_.reset(new (source_endpoint_) SenderEndpoint(proto, allocator()));
+    source_endpoint_.reset(new (source_endpoint_)
+                               SenderEndpoint(proto, config_, allocator()));
     if (!source_endpoint_ || !source_endpoint_->valid()) {
         roc_log(LogError, "sender slot: can't create source endpoint");
         source_endpoint_.reset(NULL);
@@ -164,7 +224,8 @@ SenderEndpoint* SenderSlot::create_repair_endpoint_(address::Protocol proto) {
         return NULL;
     }
 
-    repair_endpoint_.reset(new (repair_endpoint_) SenderEndpoint(proto, allocator()));
+    repair_endpoint_.reset(new (repair_endpoint_)
+                               SenderEndpoint(proto, config_, allocator()));
     if (!repair_endpoint_ || !repair_endpoint_->valid()) {
         roc_log(LogError, "sender slot: can't create repair endpoint");
         repair_endpoint_.reset(NULL);
@@ -184,7 +245,8 @@ SenderEndpoint* SenderSlot::create_control_endpoint_(address::Protocol proto) {
         return NULL;
     }
 
-    control_endpoint_.reset(new (control_endpoint_) SenderEndpoint(proto, allocator()));
+    control_endpoint_.reset(new (control_endpoint_)
+                                SenderEndpoint(proto, config_, allocator()));
     if (!control_endpoint_ || !control_endpoint_->valid()) {
         roc_log(LogError, "sender slot: can't create control endpoint");
         control_endpoint_.reset(NULL);
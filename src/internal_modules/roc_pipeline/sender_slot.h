@@ -17,9 +17,11 @@
 #include "roc_audio/fanout.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/iallocator.h"
+#include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
 #include "roc_core/ref_counted.h"
+#include "roc_core/shared_ptr.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/sender_endpoint.h"
@@ -33,6 +35,11 @@ namespace pipeline {
 //! Contains:
 //!  - one or more related sender endpoints, one per each type
 //!  - one session associated with those endpoints
+//!
+//! If another slot already has transport endpoints with the same protocols,
+//! the slot doesn't create own transport pipeline, and instead attaches its
+//! endpoints to the pipeline of that slot. In this case, control endpoint of
+//! the slot reports and adjusts that shared pipeline.
 class SenderSlot : public core::RefCounted<SenderSlot, core::StandardAllocation>,
                    public core::ListNode {
     typedef core::RefCounted<SenderSlot, core::StandardAllocation> RefCounted;
@@ -42,21 +49,36 @@ public:
     SenderSlot(const SenderConfig& config,
                const rtp::FormatMap& format_map,
                audio::Fanout& fanout,
+               core::List<SenderSlot>& peer_slots,
                packet::PacketFactory& packet_factory,
                core::BufferFactory<uint8_t>& byte_buffer_factory,
                core::BufferFactory<audio::sample_t>& sample_buffer_factory,
                core::IAllocator& allocator);
 
+    //! Deinitialize.
+    //! @remarks
+    //!  Detaches endpoints from transport pipeline of another slot, if any.
+    ~SenderSlot();
+
     //! Add endpoint.
     SenderEndpoint* create_endpoint(address::Interface iface, address::Protocol proto);
 
     //! Get audio writer.
-    //! @returns NULL if slot is not ready.
+    //! @returns NULL if slot is not ready, or if it uses transport pipeline
+    //! of another slot.
     audio::IFrameWriter* writer();
 
     //! Check if slot configuration is done.
     bool is_ready() const;
 
+    //! Get metrics of slot session.
+    SenderSessionMetrics get_metrics() const;
+
+    //! Pull packets received by endpoints.
+    //! @remarks
+    //!  Passes reports received by control endpoint to the session.
+    void pull_packets();
+
     //! Get deadline when the pipeline should be updated.
     core::nanoseconds_t get_update_deadline() const;
 
@@ -68,15 +90,23 @@ private:
     SenderEndpoint* create_repair_endpoint_(address::Protocol proto);
     SenderEndpoint* create_control_endpoint_(address::Protocol proto);
 
+    bool create_transport_pipeline_();
+    core::SharedPtr<SenderSlot> find_shared_slot_();
+
     const SenderConfig& config_;
 
     audio::Fanout& fanout_;
+    core::List<SenderSlot>& peer_slots_;
 
     core::Optional<SenderEndpoint> source_endpoint_;
     core::Optional<SenderEndpoint> repair_endpoint_;
     core::Optional<SenderEndpoint> control_endpoint_;
 
     SenderSession session_;
+
+    // slot which transport pipeline we use; holding a reference keeps
+    // that pipeline alive until our endpoints are detached from it
+    core::SharedPtr<SenderSlot> shared_slot_;
 };
 
 } // namespace pipeline
@@ -261,6 +261,44 @@ void Builder::end_xr_dlrr() {
     state_ = XR_HEAD;
 }
 
+void Builder::begin_xr_loss_rle(const header::XrLossRleBlock& loss_rle) {
+    roc_panic_if_not(state_ == XR_HEAD);
+
+    header::XrLossRleBlock* p =
+        (header::XrLossRleBlock*)cur_slice_.extend(sizeof(header::XrLossRleBlock));
+    memcpy(p, &loss_rle, sizeof(loss_rle));
+    xr_header_ = &p->header();
+
+    state_ = XR_LOSS_RLE_HEAD;
+}
+
+void Builder::add_xr_loss_rle_chunk(const header::XrLossRleChunk& chunk) {
+    roc_panic_if_not(state_ == XR_LOSS_RLE_HEAD || state_ == XR_LOSS_RLE_CHUNK);
+
+    header::XrLossRleChunk* p =
+        (header::XrLossRleChunk*)cur_slice_.extend(sizeof(header::XrLossRleChunk));
+    memcpy(p, &chunk, sizeof(chunk));
+
+    state_ = XR_LOSS_RLE_CHUNK;
+}
+
+void Builder::end_xr_loss_rle() {
+    roc_panic_if_not(state_ == XR_LOSS_RLE_HEAD || state_ == XR_LOSS_RLE_CHUNK);
+
+    size_t block_len = size_t(cur_slice_.data_end() - (uint8_t*)xr_header_);
+
+    if (block_len % 4 != 0) {
+        header::XrLossRleChunk* p =
+            (header::XrLossRleChunk*)cur_slice_.extend(sizeof(header::XrLossRleChunk));
+        p->reset();
+        block_len += sizeof(header::XrLossRleChunk);
+    }
+
+    xr_header_->set_len_bytes(block_len);
+
+    state_ = XR_HEAD;
+}
+
 void Builder::end_xr() {
     roc_panic_if_not(state_ == XR_HEAD);
 
@@ -75,6 +75,16 @@ public:
     //! Finish current DLRR block.
     void end_xr_dlrr();
 
+    //! Start Loss RLE block inside current XR packet.
+    void begin_xr_loss_rle(const header::XrLossRleBlock& loss_rle);
+
+    //! Add chunk to current Loss RLE block.
+    void add_xr_loss_rle_chunk(const header::XrLossRleChunk& chunk);
+
+    //! Finish current Loss RLE block.
+    //! Pads block with null chunk if needed.
+    void end_xr_loss_rle();
+
     //! Finish current XR packet.
     void end_xr();
 
@@ -130,6 +140,8 @@ private:
         XR_HEAD,
         XR_DLRR_HEAD,
         XR_DLRR_REPORT,
+        XR_LOSS_RLE_HEAD,
+        XR_LOSS_RLE_CHUNK,
         SDES_HEAD,
         SDES_CHUNK,
         BYE_HEAD,
@@ -290,13 +290,14 @@ private:
         //! @name Fraction lost since last SR/RR.
         // @{
         Losses_FractLost_shift = 24,
-        Losses_FractLost_mask = 0x0F,
+        Losses_FractLost_mask = 0xFF,
         // @}
 
         //! @name cumul. no. pkts lost (signed!).
         // @{
-        Losses_CumLoss_shift = 24,
-        Losses_CumLoss_mask = 0x0FFF
+        Losses_CumLoss_shift = 0,
+        Losses_CumLoss_mask = 0xFFFFFF,
+        Losses_CumLoss_sign = 0x800000
         // @}
     };
 
@@ -343,7 +344,7 @@ public:
     float fract_loss() const {
         const uint32_t tmp = core::ntoh32u(losses_);
         uint8_t losses8 = (tmp >> Losses_FractLost_shift) & Losses_FractLost_mask;
-        float res = float(losses8) / float(1 << Losses_FractLost_shift);
+        float res = float(losses8) / float(1 << 8);
 
         return res;
     }
@@ -371,9 +372,10 @@ public:
     //!
     //! May be negative in case of packet repeats.
     int32_t cumloss() const {
-        uint32_t res = core::ntoh32u(losses_) & Losses_CumLoss_mask;
+        uint32_t res =
+            (core::ntoh32u(losses_) >> Losses_CumLoss_shift) & Losses_CumLoss_mask;
         // If res is negative
-        if (res & (1 << (Losses_CumLoss_shift - 1))) {
+        if (res & Losses_CumLoss_sign) {
             // Make whole leftest byte filled with 1.
             res |= ~(uint32_t)Losses_CumLoss_mask;
         }
@@ -386,14 +388,13 @@ public:
     void set_cumloss(int32_t l) {
         uint32_t losses = core::ntoh32u(losses_);
 
-        if (l > Losses_CumLoss_mask) {
-            l = Losses_CumLoss_mask;
-        } else if (l < -(int32_t)Losses_CumLoss_mask) {
-            l = -Losses_CumLoss_mask;
+        if (l > (int32_t)Losses_CumLoss_sign - 1) {
+            l = (int32_t)Losses_CumLoss_sign - 1;
+        } else if (l < -(int32_t)Losses_CumLoss_sign) {
+            l = -(int32_t)Losses_CumLoss_sign;
         }
-        set_bitfield<uint32_t>(losses, (uint32_t)l,
-                               sizeof(losses_) * 8 - Losses_CumLoss_shift,
-                               Losses_CumLoss_mask);
+        set_bitfield<uint32_t>(losses, (uint32_t)l & Losses_CumLoss_mask,
+                               Losses_CumLoss_shift, Losses_CumLoss_mask);
 
         losses_ = core::hton32u(losses);
     }
@@ -1098,6 +1099,192 @@ public:
     }
 } ROC_ATTR_PACKED_END;
 
+//! XR Loss RLE chunk.
+//!
+//! RFC 3611 4.1.1. "Run Length Chunk" and 4.1.2. "Bit Vector Chunk"
+//!
+//! @code
+//!  0                   1
+//!  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |C|R|        run length         |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |C|        bit vector           |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+//!
+//! C=0 denotes run length chunk, where R=1 means a run of received packets,
+//! and R=0 means a run of lost packets. C=1 denotes bit vector chunk, where
+//! each bit, starting from the most significant, is set for received packet.
+//! Chunk of all zeros is a null chunk used for padding.
+ROC_ATTR_PACKED_BEGIN class XrLossRleChunk {
+private:
+    enum {
+        ChunkType_bit = 15,
+        RunType_bit = 14,
+        RunLength_mask = 0x3FFF,
+        BitVector_mask = 0x7FFF
+    };
+
+    uint16_t chunk_;
+
+public:
+    enum {
+        //! Maximum length of run in run length chunk.
+        MaxRunLength = RunLength_mask,
+
+        //! Number of packets described by bit vector chunk.
+        BitVectorLength = 15
+    };
+
+    XrLossRleChunk() {
+        reset();
+    }
+
+    //! Reset to initial state (null chunk).
+    void reset() {
+        chunk_ = 0;
+    }
+
+    //! Check if this is a null chunk.
+    bool is_null() const {
+        return chunk_ == 0;
+    }
+
+    //! Check if this is a bit vector chunk.
+    bool is_bit_vector() const {
+        return (core::ntoh16u(chunk_) >> ChunkType_bit) & 1;
+    }
+
+    //! Check if run length chunk describes received packets.
+    bool run_received() const {
+        return (core::ntoh16u(chunk_) >> RunType_bit) & 1;
+    }
+
+    //! Get run length of run length chunk.
+    uint16_t run_length() const {
+        return core::ntoh16u(chunk_) & RunLength_mask;
+    }
+
+    //! Set run length chunk.
+    void set_run(const bool received, const uint16_t length) {
+        roc_panic_if_not(length <= MaxRunLength);
+        chunk_ = core::hton16u(uint16_t((received ? 1 : 0) << RunType_bit) | length);
+    }
+
+    //! Get bit vector of bit vector chunk.
+    uint16_t bit_vector() const {
+        return core::ntoh16u(chunk_) & BitVector_mask;
+    }
+
+    //! Set bit vector chunk.
+    void set_bit_vector(const uint16_t bits) {
+        chunk_ = core::hton16u(uint16_t(1 << ChunkType_bit) | (bits & BitVector_mask));
+    }
+} ROC_ATTR_PACKED_END;
+
+//! XR Loss RLE Report block.
+//!
+//! RFC 3611 4.1. "Loss RLE Report Block"
+//!
+//! @code
+//!  0                   1                   2                   3
+//!  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |     BT=1      | rsvd. |   T   |         block length          |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |                        SSRC of source                         |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |          begin_seq            |             end_seq           |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |          chunk 1              |             chunk 2           |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! :                              ...                              :
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |          chunk n-1            |             chunk n           |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+//!
+//! end_seq is one past the last sequence number covered by the report.
+ROC_ATTR_PACKED_BEGIN class XrLossRleBlock {
+private:
+    XrBlockHeader header_;
+    uint32_t ssrc_;
+    uint16_t begin_seq_;
+    uint16_t end_seq_;
+
+public:
+    XrLossRleBlock() {
+        reset();
+    }
+
+    //! Reset to initial state (all zeros).
+    void reset() {
+        header_.reset(XR_LOSS_RLE);
+        ssrc_ = 0;
+        begin_seq_ = end_seq_ = 0;
+    }
+
+    //! Get common block header.
+    const XrBlockHeader& header() const {
+        return header_;
+    }
+
+    //! Get common block header.
+    XrBlockHeader& header() {
+        return header_;
+    }
+
+    //! Get SSRC of source being reported.
+    uint32_t ssrc() const {
+        return core::ntoh32u(ssrc_);
+    }
+
+    //! Set SSRC of source being reported.
+    void set_ssrc(const uint32_t ssrc) {
+        ssrc_ = core::hton32u(ssrc);
+    }
+
+    //! Get first sequence number covered by report.
+    packet::seqnum_t begin_seqnum() const {
+        return core::ntoh16u(begin_seq_);
+    }
+
+    //! Set first sequence number covered by report.
+    void set_begin_seqnum(const packet::seqnum_t sn) {
+        begin_seq_ = core::hton16u(sn);
+    }
+
+    //! Get sequence number following last one covered by report.
+    packet::seqnum_t end_seqnum() const {
+        return core::ntoh16u(end_seq_);
+    }
+
+    //! Set sequence number following last one covered by report.
+    void set_end_seqnum(const packet::seqnum_t sn) {
+        end_seq_ = core::hton16u(sn);
+    }
+
+    //! Get number of chunks, including trailing null chunk, if any.
+    size_t num_chunks() const {
+        return (header_.len_bytes() - sizeof(*this)) / sizeof(XrLossRleChunk);
+    }
+
+    //! Get chunk by index.
+    const XrLossRleChunk& get_chunk(const size_t i) const {
+        return get_block_by_index<const XrLossRleChunk>(this, i, num_chunks(),
+                                                        "rtcp xr_loss_rle");
+    }
+
+    //! Get chunk by index.
+    XrLossRleChunk& get_chunk(const size_t i) {
+        return get_block_by_index<XrLossRleChunk>(this, i, num_chunks(),
+                                                  "rtcp xr_loss_rle");
+    }
+} ROC_ATTR_PACKED_END;
+
 //! XR Receiver Reference Time Report block.
 //!
 //! RFC 3611 4.4. "Receiver Reference Time Report Block"
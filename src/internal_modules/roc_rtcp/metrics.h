@@ -14,6 +14,7 @@
 
 #include "roc_core/stddefs.h"
 #include "roc_core/time.h"
+#include "roc_packet/loss_runs.h"
 #include "roc_packet/units.h"
 
 namespace roc {
@@ -21,6 +22,9 @@ namespace rtcp {
 
 //! Metrics sent from sender to receiver.
 struct SendingMetrics {
+    //! From which source these metrics were sent.
+    packet::source_t ssrc;
+
     //! NTP time when these metrics were generated.
     packet::ntp_timestamp_t origin_ntp;
 
@@ -28,7 +32,8 @@ struct SendingMetrics {
     packet::timestamp_t origin_rtp;
 
     SendingMetrics()
-        : origin_ntp(0)
+        : ssrc(0)
+        , origin_ntp(0)
         , origin_rtp(0) {
     }
 };
@@ -41,20 +46,52 @@ struct ReceptionMetrics {
     //! Fraction of lost packets.
     float fract_loss;
 
+    //! Cumulative number of lost packets.
+    //! May be negative if packets were duplicated.
+    int64_t cum_loss;
+
+    //! Extended highest sequence number received.
+    //! Low 16 bits are sequence number, high 16 bits are number of cycles.
+    uint32_t ext_last_seqnum;
+
+    //! Interarrival jitter, in RTP timestamp units.
+    packet::timestamp_t jitter;
+
+    //! NTP timestamp of last sender report received from source.
+    //! Zero if no sender reports were received.
+    packet::ntp_timestamp_t last_sr;
+
+    //! Delay between receiving last sender report and sending these metrics.
+    //! Zero if no sender reports were received.
+    packet::ntp_timestamp_t delay_last_sr;
+
+    //! Runs of received and lost packets since previous report.
+    //! Used to estimate length of loss bursts.
+    packet::LossRuns loss_runs;
+
     ReceptionMetrics()
         : ssrc(0)
-        , fract_loss(0) {
+        , fract_loss(0)
+        , cum_loss(0)
+        , ext_last_seqnum(0)
+        , jitter(0)
+        , last_sr(0)
+        , delay_last_sr(0) {
     }
 };
 
 //! Metrics for network link.
 //! Calculated independently on both sender and receiver.
 struct LinkMetrics {
+    //! SSRC of the source for which round-trip was measured.
+    packet::source_t ssrc;
+
     //! Estimated round-trip time.
     core::nanoseconds_t rtt;
 
     LinkMetrics()
-        : rtt(0) {
+        : ssrc(0)
+        , rtt(0) {
     }
 };
 
@@ -124,6 +124,30 @@ void print_xr_dlrr(core::Printer& p, const header::XrDlrrBlock& blk) {
     }
 }
 
+void print_xr_loss_rle(core::Printer& p, const header::XrLossRleBlock& blk) {
+    p.writef("|- loss_rle:\n");
+
+    print_xr_block_header(p, blk.header());
+
+    p.writef("|-- block body:\n");
+    p.writef("|--- ssrc: %lu\n", (unsigned long)blk.ssrc());
+    p.writef("|--- begin_seq: %lu\n", (unsigned long)blk.begin_seqnum());
+    p.writef("|--- end_seq: %lu\n", (unsigned long)blk.end_seqnum());
+
+    for (size_t n = 0; n < blk.num_chunks(); n++) {
+        const header::XrLossRleChunk& chunk = blk.get_chunk(n);
+
+        if (chunk.is_null()) {
+            p.writef("|--- chunk: null\n");
+        } else if (chunk.is_bit_vector()) {
+            p.writef("|--- chunk: bits 0x%04x\n", (unsigned)chunk.bit_vector());
+        } else {
+            p.writef("|--- chunk: %s %lu\n", chunk.run_received() ? "received" : "lost",
+                     (unsigned long)chunk.run_length());
+        }
+    }
+}
+
 void print_xr(core::Printer& p, const XrTraverser& xr) {
     p.writef("+ xr:\n");
 
@@ -148,6 +172,10 @@ void print_xr(core::Printer& p, const XrTraverser& xr) {
         case XrTraverser::Iterator::DRLL_BLOCK:
             print_xr_dlrr(p, iter.get_dlrr());
             break;
+
+        case XrTraverser::Iterator::LOSS_RLE_BLOCK:
+            print_xr_loss_rle(p, iter.get_loss_rle());
+            break;
         }
     }
 }
@@ -15,6 +15,35 @@
 namespace roc {
 namespace rtcp {
 
+namespace {
+
+// Maximum number of sources reported in XR loss RLE blocks.
+const size_t MaxLossRleBlocks = 8;
+
+// LSR and DLSR fields hold middle 32 bits of NTP timestamp.
+uint32_t ntp_to_compact(packet::ntp_timestamp_t ntp) {
+    return uint32_t(ntp >> 16);
+}
+
+packet::ntp_timestamp_t ntp_from_compact(uint32_t compact) {
+    return packet::ntp_timestamp_t(compact) << 16;
+}
+
+// Header clamps cumulative loss to 24 bits, but accepts only 32-bit values.
+int32_t clamp_cum_loss(int64_t cum_loss) {
+    const int64_t max_loss = 0x7fffffff;
+
+    if (cum_loss > max_loss) {
+        return (int32_t)max_loss;
+    }
+    if (cum_loss < -max_loss) {
+        return (int32_t)-max_loss;
+    }
+    return (int32_t)cum_loss;
+}
+
+} // namespace
+
 Session::Session(IReceiverHooks* recv_hooks,
                  ISenderHooks* send_hooks,
                  packet::IWriter* packet_writer,
@@ -124,11 +153,11 @@ void Session::parse_reports_(const Traverser& traverser) {
     while ((state = iter.next()) != Traverser::Iterator::END) {
         switch (state) {
         case Traverser::Iterator::SR: {
-            parse_sender_report_(iter.get_sr());
+            parse_sender_report_(traverser, iter.get_sr());
         } break;
 
         case Traverser::Iterator::RR: {
-            parse_receiver_report_(iter.get_rr());
+            parse_receiver_report_(traverser, iter.get_rr());
         } break;
 
         default:
@@ -184,8 +213,10 @@ void Session::parse_goodbye_(const ByeTraverser& bye) {
     }
 }
 
-void Session::parse_sender_report_(const header::SenderReportPacket& sr) {
+void Session::parse_sender_report_(const Traverser& traverser,
+                                   const header::SenderReportPacket& sr) {
     SendingMetrics metrics;
+    metrics.ssrc = sr.ssrc();
     metrics.origin_ntp = sr.ntp_timestamp();
     metrics.origin_rtp = sr.rtp_timestamp();
 
@@ -194,23 +225,132 @@ void Session::parse_sender_report_(const header::SenderReportPacket& sr) {
     }
 
     for (size_t n = 0; n < sr.num_blocks(); n++) {
-        parse_reception_block_(sr.get_block(n));
+        parse_reception_block_(traverser, sr.get_block(n));
     }
 }
 
-void Session::parse_receiver_report_(const header::ReceiverReportPacket& rr) {
+void Session::parse_receiver_report_(const Traverser& traverser,
+                                     const header::ReceiverReportPacket& rr) {
     for (size_t n = 0; n < rr.num_blocks(); n++) {
-        parse_reception_block_(rr.get_block(n));
+        parse_reception_block_(traverser, rr.get_block(n));
     }
 }
 
-void Session::parse_reception_block_(const header::ReceptionReportBlock& blk) {
+void Session::parse_reception_block_(const Traverser& traverser,
+                                     const header::ReceptionReportBlock& blk) {
+    if (!send_hooks_) {
+        return;
+    }
+
     ReceptionMetrics metrics;
     metrics.ssrc = blk.ssrc();
     metrics.fract_loss = blk.fract_loss();
+    metrics.cum_loss = blk.cumloss();
+    metrics.ext_last_seqnum = blk.last_seqnum();
+    metrics.jitter = blk.jitter();
+    metrics.last_sr = ntp_from_compact(blk.last_sr());
+    metrics.delay_last_sr = ntp_from_compact(blk.delay_last_sr());
 
-    if (send_hooks_) {
-        send_hooks_->on_add_reception_metrics(metrics);
+    parse_loss_runs_(traverser, metrics);
+
+    send_hooks_->on_add_reception_metrics(metrics);
+
+    if (blk.last_sr() != 0) {
+        parse_round_trip_(blk);
+    }
+}
+
+void Session::parse_round_trip_(const header::ReceptionReportBlock& blk) {
+    // RFC 3550, 6.4.1: RTT = A - LSR - DLSR, where A is report arrival time,
+    // all in compact NTP format; arithmetic is modulo 2^32
+    const uint32_t arrival = ntp_to_compact(packet::ntp_timestamp());
+    const uint32_t rtt = arrival - blk.last_sr() - blk.delay_last_sr();
+
+    // arrival time is before LSR + DLSR, i.e. clocks are not monotonic
+    // or report is corrupted
+    if (rtt >= 0x80000000) {
+        roc_log(LogTrace, "rtcp session: ignoring invalid round-trip time: ssrc=%lu",
+                (unsigned long)blk.ssrc());
+        return;
+    }
+
+    LinkMetrics metrics;
+    metrics.ssrc = blk.ssrc();
+    metrics.rtt = packet::ntp_2_nanoseconds(ntp_from_compact(rtt));
+
+    send_hooks_->on_add_link_metrics(metrics);
+}
+
+void Session::parse_loss_runs_(const Traverser& traverser, ReceptionMetrics& metrics) {
+    Traverser::Iterator iter = traverser.iter();
+    Traverser::Iterator::State state;
+
+    while ((state = iter.next()) != Traverser::Iterator::END) {
+        if (state != Traverser::Iterator::XR) {
+            continue;
+        }
+
+        XrTraverser xr = iter.get_xr();
+        if (!xr.parse()) {
+            roc_log(LogTrace, "rtcp session: can't parse xr packet");
+            continue;
+        }
+
+        XrTraverser::Iterator xr_iter = xr.iter();
+        XrTraverser::Iterator::State xr_state;
+
+        while ((xr_state = xr_iter.next()) != XrTraverser::Iterator::END) {
+            if (xr_state != XrTraverser::Iterator::LOSS_RLE_BLOCK) {
+                continue;
+            }
+
+            const header::XrLossRleBlock& blk = xr_iter.get_loss_rle();
+            if (blk.ssrc() != metrics.ssrc) {
+                continue;
+            }
+
+            parse_loss_rle_block_(blk, metrics.loss_runs);
+            return;
+        }
+    }
+}
+
+void Session::parse_loss_rle_block_(const header::XrLossRleBlock& blk,
+                                    packet::LossRuns& runs) {
+    runs.reset(blk.begin_seqnum());
+
+    // number of packets covered by block; chunks may describe more packets
+    // than that, e.g. bit vector may have unused trailing bits
+    size_t remaining = (size_t)packet::seqnum_t(blk.end_seqnum() - blk.begin_seqnum());
+
+    for (size_t n = 0; n < blk.num_chunks() && remaining != 0; n++) {
+        const header::XrLossRleChunk& chunk = blk.get_chunk(n);
+
+        if (chunk.is_null()) {
+            break;
+        }
+
+        if (chunk.is_bit_vector()) {
+            const uint16_t bits = chunk.bit_vector();
+            const size_t n_bits = header::XrLossRleChunk::BitVectorLength;
+
+            for (size_t b = 0; b < n_bits && remaining != 0; b++) {
+                const bool received = (bits >> (n_bits - 1 - b)) & 1;
+                if (!runs.add_run(received, 1)) {
+                    return;
+                }
+                remaining--;
+            }
+        } else {
+            size_t len = chunk.run_length();
+            if (len > remaining) {
+                len = remaining;
+            }
+            if (!runs.add_run(chunk.run_received(), (packet::seqnum_t)len)) {
+                return;
+            }
+            remaining -= len;
+        }
     }
 }
 
@@ -297,8 +437,15 @@ void Session::build_sender_report_(Builder& bld, packet::ntp_timestamp_t report_
 
     const SendingMetrics metrics = send_hooks_->on_get_sending_metrics(report_time);
 
+    // receivers match SR to their sessions by SSRC of the media stream and
+    // echo its timestamp in reception reports, so SR is sent on its behalf
+    packet::source_t ssrc = ssrc_;
+    if (send_hooks_->on_get_num_sources() != 0) {
+        ssrc = send_hooks_->on_get_sending_source(0);
+    }
+
     header::SenderReportPacket sr;
-    sr.set_ssrc(ssrc_);
+    sr.set_ssrc(ssrc);
     sr.set_ntp_timestamp(metrics.origin_ntp);
     sr.set_rtp_timestamp(metrics.origin_rtp);
 
@@ -322,12 +469,20 @@ void Session::build_receiver_report_(Builder& bld, packet::ntp_timestamp_t repor
 
     bld.begin_rr(rr);
 
+    // metrics are fetched once, because fetching them resets per-report
+    // counters; they're used both for RR and XR blocks
+    ReceptionMetrics metrics[header::PacketMaxBlocks];
+    size_t num_sources = 0;
+
     if (recv_hooks_) {
-        const size_t num_sources = recv_hooks_->on_get_num_sources();
+        num_sources = recv_hooks_->on_get_num_sources();
+        if (num_sources > header::PacketMaxBlocks) {
+            num_sources = header::PacketMaxBlocks;
+        }
 
         for (size_t n = 0; n < num_sources; n++) {
-            bld.add_rr_report(
-                build_reception_block_(recv_hooks_->on_get_reception_metrics(n)));
+            metrics[n] = recv_hooks_->on_get_reception_metrics(n);
+            bld.add_rr_report(build_reception_block_(metrics[n]));
         }
     }
 
@@ -345,6 +500,14 @@ void Session::build_receiver_report_(Builder& bld, packet::ntp_timestamp_t repor
         bld.add_xr_rrtr(rrtr);
     }
 
+    // loss RLE blocks are larger than RR blocks, so we report only first
+    // few sources to fit into packet
+    for (size_t n = 0; n < num_sources && n < MaxLossRleBlocks; n++) {
+        if (metrics[n].loss_runs.n_runs != 0) {
+            build_loss_rle_block_(bld, metrics[n]);
+        }
+    }
+
     bld.end_xr();
 }
 
@@ -353,10 +516,44 @@ Session::build_reception_block_(const ReceptionMetrics& metrics) {
     header::ReceptionReportBlock blk;
 
     blk.set_ssrc(metrics.ssrc);
+    blk.set_fract_loss(ssize_t(metrics.fract_loss * 256), 256);
+    blk.set_cumloss(clamp_cum_loss(metrics.cum_loss));
+    blk.set_last_seqnum(metrics.ext_last_seqnum);
+    blk.set_jitter(metrics.jitter);
+    blk.set_last_sr(ntp_to_compact(metrics.last_sr));
+    blk.set_delay_last_sr(ntp_to_compact(metrics.delay_last_sr));
 
     return blk;
 }
 
+void Session::build_loss_rle_block_(Builder& bld, const ReceptionMetrics& metrics) {
+    const packet::LossRuns& runs = metrics.loss_runs;
+
+    header::XrLossRleBlock blk;
+    blk.set_ssrc(metrics.ssrc);
+    blk.set_begin_seqnum(runs.begin);
+    blk.set_end_seqnum(packet::seqnum_t(runs.begin + runs.n_packets()));
+
+    bld.begin_xr_loss_rle(blk);
+
+    for (size_t n = 0; n < runs.n_runs; n++) {
+        size_t len = runs.runs[n];
+
+        while (len != 0) {
+            const size_t chunk_len =
+                std::min(len, (size_t)header::XrLossRleChunk::MaxRunLength);
+
+            header::XrLossRleChunk chunk;
+            chunk.set_run(packet::LossRuns::is_received_run(n), (uint16_t)chunk_len);
+            bld.add_xr_loss_rle_chunk(chunk);
+
+            len -= chunk_len;
+        }
+    }
+
+    bld.end_xr_loss_rle();
+}
+
 void Session::build_session_description_(Builder& bld) {
     bld.begin_sdes();
 
@@ -60,9 +60,16 @@ private:
 
     void parse_session_description_(const SdesTraverser& sdes);
     void parse_goodbye_(const ByeTraverser& bye);
-    void parse_sender_report_(const header::SenderReportPacket& sr);
-    void parse_receiver_report_(const header::ReceiverReportPacket& rr);
-    void parse_reception_block_(const header::ReceptionReportBlock& blk);
+    void parse_sender_report_(const Traverser& traverser,
+                              const header::SenderReportPacket& sr);
+    void parse_receiver_report_(const Traverser& traverser,
+                                const header::ReceiverReportPacket& rr);
+    void parse_reception_block_(const Traverser& traverser,
+                                const header::ReceptionReportBlock& blk);
+    void parse_round_trip_(const header::ReceptionReportBlock& blk);
+    void parse_loss_runs_(const Traverser& traverser, ReceptionMetrics& metrics);
+    void parse_loss_rle_block_(const header::XrLossRleBlock& blk,
+                               packet::LossRuns& runs);
 
     packet::PacketPtr generate_packet_();
 
@@ -70,6 +77,7 @@ private:
     void build_sender_report_(Builder& bld, packet::ntp_timestamp_t report_time);
     void build_receiver_report_(Builder& bld, packet::ntp_timestamp_t report_time);
     header::ReceptionReportBlock build_reception_block_(const ReceptionMetrics& metrics);
+    void build_loss_rle_block_(Builder& bld, const ReceptionMetrics& metrics);
     void build_session_description_(Builder& bld);
     void build_source_description_(Builder& bld, packet::source_t ssrc);
 
@@ -101,6 +101,7 @@ XrTraverser::Iterator::State XrTraverser::Iterator::next() {
     // Walk through all block packets and seek for known types.
     while (p_block_header->block_type() != header::XR_RRTR
            && p_block_header->block_type() != header::XR_DLRR
+           && p_block_header->block_type() != header::XR_LOSS_RLE
            && pcur_ < data_.data_end()) {
         const size_t block_len = p_block_header->len_bytes();
         // If the block is incorrect, skip the whole packet.
@@ -120,6 +121,14 @@ XrTraverser::Iterator::State XrTraverser::Iterator::next() {
         state_ = RRTR_BLOCK;
     } else if (p_block_header->block_type() == header::XR_DLRR) {
         state_ = DRLL_BLOCK;
+    } else if (p_block_header->block_type() == header::XR_LOSS_RLE) {
+        // Chunks are accessed by length from header, so it must be valid.
+        if (p_block_header->len_bytes() < sizeof(header::XrLossRleBlock)
+            || pcur_ + p_block_header->len_bytes() > data_.data_end()) {
+            state_ = END;
+        } else {
+            state_ = LOSS_RLE_BLOCK;
+        }
     } else {
         roc_panic("xr traverser: impossible branch");
     }
@@ -141,5 +150,12 @@ const header::XrDlrrBlock& XrTraverser::Iterator::get_dlrr() const {
     return *(header::XrDlrrBlock*)pcur_;
 }
 
+const header::XrLossRleBlock& XrTraverser::Iterator::get_loss_rle() const {
+    roc_panic_if_msg(state_ != LOSS_RLE_BLOCK,
+                     "xt traverser:"
+                     " attempt to access block with wrong type or at wrong state");
+    return *(header::XrLossRleBlock*)pcur_;
+}
+
 } // namespace rtcp
 } // namespace roc
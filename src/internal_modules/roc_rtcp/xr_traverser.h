@@ -27,10 +27,11 @@ public:
     public:
         //! Iterator state.
         enum State {
-            BEGIN,      //!< Iterator created.
-            RRTR_BLOCK, //!< RRTR block (receiver reference time).
-            DRLL_BLOCK, //!< DLRR block (delay since last receiver report).
-            END         //!< Parsed whole packet.
+            BEGIN,          //!< Iterator created.
+            RRTR_BLOCK,     //!< RRTR block (receiver reference time).
+            DRLL_BLOCK,     //!< DLRR block (delay since last receiver report).
+            LOSS_RLE_BLOCK, //!< Loss RLE block (lost packets run lengths).
+            END             //!< Parsed whole packet.
         };
 
         //! Advance iterator.
@@ -44,6 +45,10 @@ public:
         //! @pre Can be used if next() returned DLRR_BLOCK.
         const header::XrDlrrBlock& get_dlrr() const;
 
+        //! Get Loss RLE block (lost packets run lengths).
+        //! @pre Can be used if next() returned LOSS_RLE_BLOCK.
+        const header::XrLossRleBlock& get_loss_rle() const;
+
     private:
         friend class XrTraverser;
 
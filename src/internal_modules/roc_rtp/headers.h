@@ -28,7 +28,8 @@ enum Version {
 //! RTP payload type.
 enum PayloadType {
     PayloadType_L16_Stereo = 10, //!< Audio, 16-bit samples, 2 channels, 44100 Hz.
-    PayloadType_L16_Mono = 11    //!< Audio, 16-bit samples, 1 channel, 44100 Hz.
+    PayloadType_L16_Mono = 11,   //!< Audio, 16-bit samples, 1 channel, 44100 Hz.
+    PayloadType_Redundant = 100  //!< Redundant audio data (RFC 2198).
 };
 
 //! RTP header.
@@ -252,6 +253,171 @@ public:
     }
 } ROC_ATTR_PACKED_END;
 
+//! Redundant block header.
+//! @remarks
+//!  Used in packets with PayloadType_Redundant (RFC 2198). Payload begins
+//!  with a list of redundant block headers, terminated with a primary block
+//!  header, followed by data of redundant blocks and then primary block.
+//!
+//! @code
+//!    0             1               2               3               4
+//!    0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |F|   block PT  |  timestamp offset         |   block length    |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+ROC_ATTR_PACKED_BEGIN class RedundantHeader {
+private:
+    enum {
+        //! @name Follow flag.
+        // @{
+        Field_FollowShift = 31,
+        Field_FollowMask = 0x1,
+        // @}
+
+        //! @name Block payload type.
+        // @{
+        Field_PayloadTypeShift = 24,
+        Field_PayloadTypeMask = 0x7f,
+        // @}
+
+        //! @name Block timestamp offset.
+        // @{
+        Field_OffsetShift = 10,
+        Field_OffsetMask = 0x3fff,
+        // @}
+
+        //! @name Block length.
+        // @{
+        Field_LengthShift = 0,
+        Field_LengthMask = 0x3ff
+        // @}
+    };
+
+    uint32_t fields_;
+
+    uint32_t get_field_(int shift, uint32_t mask) const {
+        return (core::ntoh32u(fields_) >> shift) & mask;
+    }
+
+    void set_field_(int shift, uint32_t mask, uint32_t value) {
+        roc_panic_if((value & mask) != value);
+        uint32_t fields = core::ntoh32u(fields_);
+        fields &= ~(mask << shift);
+        fields |= (value << shift);
+        fields_ = core::hton32u(fields);
+    }
+
+public:
+    //! Field limits.
+    enum {
+        MaxTimestampOffset = Field_OffsetMask, //!< Maximum timestamp offset.
+        MaxBlockLength = Field_LengthMask      //!< Maximum block length, bytes.
+    };
+
+    //! Clear header.
+    void clear() {
+        fields_ = 0;
+    }
+
+    //! Check if another block header follows this one.
+    //! @remarks
+    //!  Always true for redundant block headers.
+    bool follow() const {
+        return get_field_(Field_FollowShift, Field_FollowMask);
+    }
+
+    //! Set follow flag.
+    void set_follow(bool v) {
+        set_field_(Field_FollowShift, Field_FollowMask, v);
+    }
+
+    //! Get block payload type.
+    unsigned int payload_type() const {
+        return get_field_(Field_PayloadTypeShift, Field_PayloadTypeMask);
+    }
+
+    //! Set block payload type.
+    void set_payload_type(unsigned int pt) {
+        set_field_(Field_PayloadTypeShift, Field_PayloadTypeMask, pt);
+    }
+
+    //! Get block timestamp offset.
+    //! @remarks
+    //!  Block timestamp is primary block timestamp minus this offset.
+    uint32_t timestamp_offset() const {
+        return get_field_(Field_OffsetShift, Field_OffsetMask);
+    }
+
+    //! Set block timestamp offset.
+    void set_timestamp_offset(uint32_t offset) {
+        set_field_(Field_OffsetShift, Field_OffsetMask, offset);
+    }
+
+    //! Get block length in bytes.
+    size_t block_length() const {
+        return get_field_(Field_LengthShift, Field_LengthMask);
+    }
+
+    //! Set block length in bytes.
+    void set_block_length(size_t len) {
+        set_field_(Field_LengthShift, Field_LengthMask, (uint32_t)len);
+    }
+} ROC_ATTR_PACKED_END;
+
+//! Primary block header.
+//! @remarks
+//!  Terminates the list of redundant block headers.
+//!
+//! @code
+//!    0 1 2 3 4 5 6 7
+//!   +-+-+-+-+-+-+-+-+
+//!   |0|   Block PT  |
+//!   +-+-+-+-+-+-+-+-+
+//! @endcode
+ROC_ATTR_PACKED_BEGIN class PrimaryHeader {
+private:
+    enum {
+        //! @name Follow flag.
+        // @{
+        Field_FollowShift = 7,
+        Field_FollowMask = 0x1,
+        // @}
+
+        //! @name Block payload type.
+        // @{
+        Field_PayloadTypeShift = 0,
+        Field_PayloadTypeMask = 0x7f
+        // @}
+    };
+
+    uint8_t fields_;
+
+public:
+    //! Clear header.
+    void clear() {
+        fields_ = 0;
+    }
+
+    //! Check if another block header follows this one.
+    //! @remarks
+    //!  Always false for primary block header.
+    bool follow() const {
+        return (fields_ >> Field_FollowShift) & Field_FollowMask;
+    }
+
+    //! Get block payload type.
+    unsigned int payload_type() const {
+        return (fields_ >> Field_PayloadTypeShift) & Field_PayloadTypeMask;
+    }
+
+    //! Set block payload type.
+    void set_payload_type(unsigned int pt) {
+        roc_panic_if((pt & Field_PayloadTypeMask) != pt);
+        fields_ = (uint8_t)(pt << Field_PayloadTypeShift);
+    }
+} ROC_ATTR_PACKED_END;
+
 } // namespace rtp
 } // namespace roc
 
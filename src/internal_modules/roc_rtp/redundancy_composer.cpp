@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtp/redundancy_composer.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_rtp/headers.h"
+
+namespace roc {
+namespace rtp {
+
+RedundancyComposer::RedundancyComposer(packet::IComposer& inner_composer, size_t depth)
+    : inner_composer_(inner_composer)
+    , depth_(std::min(depth, (size_t)MaxDepth))
+    , history_size_(0) {
+}
+
+bool RedundancyComposer::align(core::Slice<uint8_t>& buffer,
+                               size_t header_size,
+                               size_t payload_alignment) {
+    // primary block offset depends on redundant blocks, so it can't be
+    // aligned in advance; align the beginning of payload instead
+    return inner_composer_.align(buffer, header_size, payload_alignment);
+}
+
+bool RedundancyComposer::prepare(packet::Packet& packet,
+                                 core::Slice<uint8_t>& buffer,
+                                 size_t payload_size) {
+    // redundant blocks must be the immediately preceding packets, so that
+    // receiver can derive their sequence numbers
+    size_t n_blocks = 0;
+
+    while (n_blocks < depth_ && n_blocks < history_size_) {
+        const packet::RTP* rtp = history_[history_size_ - n_blocks - 1]->rtp();
+
+        if (!rtp || rtp->payload.size() > RedundantHeader::MaxBlockLength
+            || rtp->payload_type > 0x7f) {
+            break;
+        }
+
+        n_blocks++;
+    }
+
+    // if buffer is too small, drop oldest blocks
+    for (;;) {
+        const size_t redundancy_size = redundancy_size_(n_blocks);
+
+        if (inner_composer_.prepare(packet, buffer, redundancy_size + payload_size)) {
+            packet::RTP& rtp = *packet.rtp();
+
+            rtp.redundancy_size = (uint16_t)redundancy_size;
+            rtp.payload = rtp.payload.subslice(redundancy_size, rtp.payload.size());
+
+            write_blocks_(rtp.payload.data() - redundancy_size, n_blocks);
+            break;
+        }
+
+        if (n_blocks == 0) {
+            return false;
+        }
+
+        n_blocks--;
+    }
+
+    remember_(packet);
+
+    return true;
+}
+
+bool RedundancyComposer::pad(packet::Packet& packet, size_t padding_size) {
+    // primary block is the last one, so padding goes right after it
+    return inner_composer_.pad(packet, padding_size);
+}
+
+bool RedundancyComposer::compose(packet::Packet& packet) {
+    packet::RTP* rtp = packet.rtp();
+    if (!rtp) {
+        roc_panic("redundancy composer: unexpected non-rtp packet");
+    }
+
+    if (rtp->redundancy_size == 0) {
+        roc_panic("redundancy composer: unexpected packet without redundancy");
+    }
+
+    if (!inner_composer_.compose(packet)) {
+        return false;
+    }
+
+    size_t pos = history_size_;
+    while (pos > 0 && history_[pos - 1].get() != &packet) {
+        pos--;
+    }
+
+    uint8_t* data = rtp->payload.data() - rtp->redundancy_size;
+
+    size_t n_blocks = 0;
+    while (((const RedundantHeader*)data)[n_blocks].follow()) {
+        n_blocks++;
+    }
+
+    if (pos == 0 || pos - 1 < n_blocks) {
+        roc_log(LogError,
+                "redundancy composer: packet composed too late, can't find its blocks:"
+                " sn=%lu n_blocks=%lu",
+                (unsigned long)rtp->seqnum, (unsigned long)n_blocks);
+        return false;
+    }
+
+    for (size_t n = 0; n < n_blocks; n++) {
+        const packet::RTP& block_rtp = *history_[pos - 1 - n_blocks + n]->rtp();
+
+        const packet::timestamp_diff_t offset =
+            packet::timestamp_diff(rtp->timestamp, block_rtp.timestamp);
+
+        if (offset < 0
+            || offset > (packet::timestamp_diff_t)RedundantHeader::MaxTimestampOffset) {
+            roc_log(LogError,
+                    "redundancy composer: block timestamp offset out of range:"
+                    " sn=%lu offset=%ld",
+                    (unsigned long)rtp->seqnum, (long)offset);
+            return false;
+        }
+
+        RedundantHeader& header = ((RedundantHeader*)data)[n];
+        header.set_payload_type(block_rtp.payload_type);
+        header.set_timestamp_offset((uint32_t)offset);
+    }
+
+    PrimaryHeader& primary = *(PrimaryHeader*)(data + n_blocks * sizeof(RedundantHeader));
+    primary.set_payload_type(rtp->payload_type);
+
+    Header& header = *(Header*)rtp->header.data();
+    header.set_payload_type(PayloadType_Redundant);
+
+    return true;
+}
+
+size_t RedundancyComposer::redundancy_size_(size_t n_blocks) const {
+    size_t size = sizeof(PrimaryHeader);
+
+    for (size_t n = 0; n < n_blocks; n++) {
+        size += sizeof(RedundantHeader)
+            + history_[history_size_ - n - 1]->rtp()->payload.size();
+    }
+
+    return size;
+}
+
+void RedundancyComposer::write_blocks_(uint8_t* headers, size_t n_blocks) const {
+    uint8_t* blocks =
+        headers + n_blocks * sizeof(RedundantHeader) + sizeof(PrimaryHeader);
+
+    // blocks go from oldest to newest; payload type and timestamp offset
+    // are filled in compose()
+    for (size_t n = 0; n < n_blocks; n++) {
+        const core::Slice<uint8_t>& block =
+            history_[history_size_ - n_blocks + n]->rtp()->payload;
+
+        RedundantHeader& header = ((RedundantHeader*)headers)[n];
+        header.clear();
+        header.set_follow(true);
+        header.set_block_length(block.size());
+
+        memcpy(blocks, block.data(), block.size());
+        blocks += block.size();
+    }
+
+    ((PrimaryHeader*)(headers + n_blocks * sizeof(RedundantHeader)))->clear();
+}
+
+void RedundancyComposer::remember_(packet::Packet& packet) {
+    if (history_size_ == MaxDepth + 1) {
+        for (size_t n = 1; n < history_size_; n++) {
+            history_[n - 1] = history_[n];
+        }
+        history_size_--;
+    }
+
+    history_[history_size_++] = &packet;
+}
+
+} // namespace rtp
+} // namespace roc
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtp/redundancy_composer.h
+//! @brief RTP redundant audio composer.
+
+#ifndef ROC_RTP_REDUNDANCY_COMPOSER_H_
+#define ROC_RTP_REDUNDANCY_COMPOSER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_packet/icomposer.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace rtp {
+
+//! RTP redundant audio composer.
+//! @remarks
+//!  Composes packets with redundant audio data (RFC 2198). Every packet
+//!  carries a copy of payloads of up to @p depth previous packets, so that
+//!  receiver can restore a lost packet as soon as one of the next packets
+//!  arrives, without waiting for a whole FEC block.
+//!
+//!  RTP header is composed by inner composer. Redundant blocks are taken
+//!  from previously prepared packets, so packets should be composed in the
+//!  same order as they are prepared, and payload of a packet should not
+//!  change after next packet is prepared, as it is done by packetizer.
+//!  If there is not enough space in buffer, oldest blocks are omitted.
+class RedundancyComposer : public packet::IComposer, public core::NonCopyable<> {
+public:
+    //! Maximum number of redundant blocks in packet.
+    enum { MaxDepth = 8 };
+
+    //! Initialization.
+    //!
+    //! @b Parameters
+    //!  - @p inner_composer is used to compose RTP header
+    //!  - @p depth defines number of previous packets to repeat in every
+    //!    packet; clamped to MaxDepth
+    RedundancyComposer(packet::IComposer& inner_composer, size_t depth);
+
+    //! Adjust buffer to align payload.
+    virtual bool
+    align(core::Slice<uint8_t>& buffer, size_t header_size, size_t payload_alignment);
+
+    //! Prepare buffer for composing a packet.
+    virtual bool
+    prepare(packet::Packet& packet, core::Slice<uint8_t>& buffer, size_t payload_size);
+
+    //! Pad packet.
+    virtual bool pad(packet::Packet& packet, size_t padding_size);
+
+    //! Compose packet to buffer.
+    virtual bool compose(packet::Packet& packet);
+
+private:
+    size_t redundancy_size_(size_t n_blocks) const;
+    void write_blocks_(uint8_t* headers, size_t n_blocks) const;
+    void remember_(packet::Packet& packet);
+
+    packet::IComposer& inner_composer_;
+
+    const size_t depth_;
+
+    // Recently prepared packets, oldest first.
+    packet::PacketPtr history_[MaxDepth + 1];
+    size_t history_size_;
+};
+
+} // namespace rtp
+} // namespace roc
+
+#endif // ROC_RTP_REDUNDANCY_COMPOSER_H_
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtp/redundancy_parser.h"
+#include "roc_core/log.h"
+#include "roc_rtp/headers.h"
+
+namespace roc {
+namespace rtp {
+
+RedundancyParser::RedundancyParser(const FormatMap& format_map,
+                                   packet::IParser& inner_parser)
+    : format_map_(format_map)
+    , inner_parser_(inner_parser) {
+}
+
+bool RedundancyParser::parse(packet::Packet& packet,
+                             const core::Slice<uint8_t>& buffer) {
+    if (!inner_parser_.parse(packet, buffer)) {
+        return false;
+    }
+
+    packet::RTP* rtp = packet.rtp();
+    if (!rtp || rtp->payload_type != PayloadType_Redundant) {
+        return true;
+    }
+
+    const uint8_t* data = rtp->payload.data();
+    const size_t size = rtp->payload.size();
+
+    size_t headers_size = 0;
+    size_t blocks_size = 0;
+
+    for (;;) {
+        if (size < headers_size + sizeof(PrimaryHeader)) {
+            roc_log(LogDebug, "redundancy parser: bad packet: truncated block header");
+            return false;
+        }
+
+        if (!((const PrimaryHeader*)(data + headers_size))->follow()) {
+            break;
+        }
+
+        if (size < headers_size + sizeof(RedundantHeader)) {
+            roc_log(LogDebug, "redundancy parser: bad packet: truncated block header");
+            return false;
+        }
+
+        blocks_size += ((const RedundantHeader*)(data + headers_size))->block_length();
+        headers_size += sizeof(RedundantHeader);
+    }
+
+    const PrimaryHeader& primary = *(const PrimaryHeader*)(data + headers_size);
+    headers_size += sizeof(PrimaryHeader);
+
+    if (size < headers_size + blocks_size || headers_size + blocks_size > 0xffff) {
+        roc_log(LogDebug,
+                "redundancy parser: bad packet: blocks don't fit payload:"
+                " payload_size=%lu blocks_size=%lu",
+                (unsigned long)size, (unsigned long)(headers_size + blocks_size));
+        return false;
+    }
+
+    rtp->payload_type = primary.payload_type();
+    rtp->redundancy_size = (uint16_t)(headers_size + blocks_size);
+    rtp->payload = rtp->payload.subslice(headers_size + blocks_size, size);
+
+    if (const Format* format = format_map_.format(rtp->payload_type)) {
+        packet.add_flags(format->packet_flags);
+    }
+
+    return true;
+}
+
+} // namespace rtp
+} // namespace roc
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtp/redundancy_parser.h
+//! @brief RTP redundant audio parser.
+
+#ifndef ROC_RTP_REDUNDANCY_PARSER_H_
+#define ROC_RTP_REDUNDANCY_PARSER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_packet/iparser.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace rtp {
+
+//! RTP redundant audio parser.
+//! @remarks
+//!  Parses packets with redundant audio data (RFC 2198). RTP header is
+//!  parsed by inner parser. If packet has PayloadType_Redundant, its payload
+//!  and payload type are replaced with those of primary block, and size of
+//!  redundant blocks is stored in packet::RTP::redundancy_size. Other packets
+//!  are left as is.
+class RedundancyParser : public packet::IParser, public core::NonCopyable<> {
+public:
+    //! Initialization.
+    //!
+    //! @b Parameters
+    //!  - @p format_map is used to get packet parameters by primary
+    //!    block payload type
+    //!  - @p inner_parser is used to parse RTP header
+    RedundancyParser(const FormatMap& format_map, packet::IParser& inner_parser);
+
+    //! Parse packet from buffer.
+    virtual bool parse(packet::Packet& packet, const core::Slice<uint8_t>& buffer);
+
+private:
+    const FormatMap& format_map_;
+    packet::IParser& inner_parser_;
+};
+
+} // namespace rtp
+} // namespace roc
+
+#endif // ROC_RTP_REDUNDANCY_PARSER_H_
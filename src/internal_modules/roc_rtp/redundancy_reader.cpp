@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtp/redundancy_reader.h"
+#include "roc_core/log.h"
+#include "roc_rtp/headers.h"
+
+namespace roc {
+namespace rtp {
+
+RedundancyReader::RedundancyReader(packet::IReader& reader,
+                                   audio::IFrameDecoder& decoder,
+                                   packet::PacketFactory& packet_factory)
+    : reader_(reader)
+    , decoder_(decoder)
+    , packet_factory_(packet_factory)
+    , has_next_(false)
+    , next_seqnum_(0)
+    , n_restored_(0) {
+}
+
+packet::PacketPtr RedundancyReader::read() {
+    if (packet::PacketPtr pp = pending_.read()) {
+        return pp;
+    }
+
+    packet::PacketPtr pp = reader_.read();
+    if (!pp) {
+        return NULL;
+    }
+
+    const packet::RTP* rtp = pp->rtp();
+    if (!rtp) {
+        roc_log(LogDebug, "redundancy reader: passing through non-rtp packet");
+        return pp;
+    }
+
+    if (has_next_ && packet::seqnum_lt(next_seqnum_, rtp->seqnum)
+        && rtp->redundancy_size != 0) {
+        restore_(pp);
+    }
+
+    if (!has_next_ || packet::seqnum_le(next_seqnum_, rtp->seqnum)) {
+        next_seqnum_ = packet::seqnum_t(rtp->seqnum + 1);
+        has_next_ = true;
+    }
+
+    if (pending_.size() != 0) {
+        pending_.write(pp);
+        return pending_.read();
+    }
+
+    return pp;
+}
+
+size_t RedundancyReader::n_restored() const {
+    return n_restored_;
+}
+
+void RedundancyReader::restore_(const packet::PacketPtr& packet) {
+    const packet::RTP& rtp = *packet->rtp();
+
+    // redundant data immediately precedes payload in packet buffer
+    const size_t payload_offset = size_t(rtp.payload.data() - packet->data().data());
+    const core::Slice<uint8_t> redundancy =
+        packet->data().subslice(payload_offset - rtp.redundancy_size, payload_offset);
+
+    const uint8_t* headers = redundancy.data();
+
+    size_t n_blocks = 0;
+    while (((const RedundantHeader*)headers)[n_blocks].follow()) {
+        n_blocks++;
+    }
+
+    size_t offset = n_blocks * sizeof(RedundantHeader) + sizeof(PrimaryHeader);
+
+    // blocks go from oldest to newest, and the newest one is a copy of
+    // the packet immediately preceding this one
+    for (size_t n = 0; n < n_blocks; n++) {
+        const RedundantHeader& header = ((const RedundantHeader*)headers)[n];
+
+        const size_t length = header.block_length();
+        const core::Slice<uint8_t> payload = redundancy.subslice(offset, offset + length);
+
+        offset += length;
+
+        const packet::seqnum_t seqnum = packet::seqnum_t(rtp.seqnum - (n_blocks - n));
+
+        if (packet::seqnum_lt(seqnum, next_seqnum_)) {
+            continue;
+        }
+
+        if (header.payload_type() != rtp.payload_type) {
+            continue;
+        }
+
+        const packet::timestamp_t timestamp =
+            packet::timestamp_t(rtp.timestamp - header.timestamp_offset());
+
+        packet::PacketPtr restored = new_packet_(packet, seqnum, timestamp, payload);
+        if (!restored) {
+            continue;
+        }
+
+        roc_log(LogTrace, "redundancy reader: restored packet: sn=%lu ts=%lu",
+                (unsigned long)restored->rtp()->seqnum,
+                (unsigned long)restored->rtp()->timestamp);
+
+        pending_.write(restored);
+        n_restored_++;
+    }
+}
+
+packet::PacketPtr RedundancyReader::new_packet_(const packet::PacketPtr& packet,
+                                                packet::seqnum_t seqnum,
+                                                packet::timestamp_t timestamp,
+                                                const core::Slice<uint8_t>& payload) {
+    packet::PacketPtr restored = packet_factory_.new_packet();
+    if (!restored) {
+        roc_log(LogError, "redundancy reader: can't allocate packet");
+        return NULL;
+    }
+
+    restored->add_flags(packet::Packet::FlagRTP | packet::Packet::FlagAudio
+                        | packet::Packet::FlagRestored);
+
+    // payload refers to the buffer of the original packet
+    restored->set_data(packet->data());
+
+    packet::RTP& rtp = *restored->rtp();
+
+    rtp.source = packet->rtp()->source;
+    rtp.seqnum = seqnum;
+    rtp.timestamp = timestamp;
+    rtp.payload_type = packet->rtp()->payload_type;
+    rtp.payload = payload;
+    rtp.duration = (packet::timestamp_t)decoder_.decoded_sample_count(payload.data(),
+                                                                      payload.size());
+
+    return restored;
+}
+
+} // namespace rtp
+} // namespace roc
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtp/redundancy_reader.h
+//! @brief Restores lost packets from redundant audio data.
+
+#ifndef ROC_RTP_REDUNDANCY_READER_H_
+#define ROC_RTP_REDUNDANCY_READER_H_
+
+#include "roc_audio/iframe_decoder.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/ireader.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+
+namespace roc {
+namespace rtp {
+
+//! Restores lost packets from redundant audio data.
+//! @remarks
+//!  Reads packets in order from upstream reader. When there is a gap in
+//!  sequence numbers, and the packet after the gap carries redundant copies
+//!  (RFC 2198) of the missing packets, creates restored packets from them
+//!  and returns them before the packet after the gap.
+//!
+//!  Since the copies arrive with the very next packets, lost packets can be
+//!  restored with latency of a few packets, instead of a whole FEC block.
+//!  Only redundant blocks with the same payload type as primary block are
+//!  used. Non-RTP packets are passed through unchanged.
+class RedundancyReader : public packet::IReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p reader is input packet reader
+    //!  - @p decoder is used to find duration of restored packets
+    //!  - @p packet_factory is used to allocate restored packets
+    RedundancyReader(packet::IReader& reader,
+                     audio::IFrameDecoder& decoder,
+                     packet::PacketFactory& packet_factory);
+
+    //! Read next packet.
+    virtual packet::PacketPtr read();
+
+    //! Get number of restored packets.
+    size_t n_restored() const;
+
+private:
+    void restore_(const packet::PacketPtr& packet);
+
+    packet::PacketPtr new_packet_(const packet::PacketPtr& packet,
+                                  packet::seqnum_t seqnum,
+                                  packet::timestamp_t timestamp,
+                                  const core::Slice<uint8_t>& payload);
+
+    packet::IReader& reader_;
+    audio::IFrameDecoder& decoder_;
+    packet::PacketFactory& packet_factory_;
+
+    // Restored packets and packet after them.
+    packet::Queue pending_;
+
+    bool has_next_;
+    packet::seqnum_t next_seqnum_;
+
+    size_t n_restored_;
+};
+
+} // namespace rtp
+} // namespace roc
+
+#endif // ROC_RTP_REDUNDANCY_READER_H_
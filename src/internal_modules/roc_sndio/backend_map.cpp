@@ -58,6 +58,12 @@ void BackendMap::register_backends_() {
     sox_backend_.reset(new (sox_backend_) SoxBackend);
     backends_.push_back(sox_backend_.get());
 #endif // ROC_TARGET_SOX
+#ifdef ROC_TARGET_POSIX
+    // mmap backend is tried after sox, so it handles files by default only
+    // when sox is disabled; otherwise it's selected explicitly by driver name
+    mmap_backend_.reset(new (mmap_backend_) MmapBackend);
+    backends_.push_back(mmap_backend_.get());
+#endif // ROC_TARGET_POSIX
 }
 
 void BackendMap::register_drivers_() {
@@ -22,6 +22,10 @@
 #include "roc_sndio/pulseaudio_backend.h"
 #endif // ROC_TARGET_PULSEAUDIO
 
+#ifdef ROC_TARGET_POSIX
+#include "roc_sndio/mmap_backend.h"
+#endif // ROC_TARGET_POSIX
+
 #ifdef ROC_TARGET_SOX
 #include "roc_sndio/sox_backend.h"
 #endif // ROC_TARGET_SOX
@@ -65,6 +69,10 @@ private:
     core::Optional<PulseaudioBackend> pulseaudio_backend_;
 #endif // ROC_TARGET_PULSEAUDIO
 
+#ifdef ROC_TARGET_POSIX
+    core::Optional<MmapBackend> mmap_backend_;
+#endif // ROC_TARGET_POSIX
+
 #ifdef ROC_TARGET_SOX
     core::Optional<SoxBackend> sox_backend_;
 #endif // ROC_TARGET_SOX
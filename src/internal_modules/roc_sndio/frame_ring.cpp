@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/frame_ring.h"
+#include "roc_core/atomic_ops.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace sndio {
+
+FrameRing::FrameRing(core::BufferFactory<audio::sample_t>& buffer_factory,
+                     size_t frame_size,
+                     size_t num_frames)
+    : frame_size_(frame_size)
+    , num_frames_(num_frames)
+    , write_pos_(0)
+    , read_pos_(0)
+    , valid_(false) {
+    if (num_frames_ < 1 || num_frames_ > MaxFrames) {
+        roc_log(LogError, "frame ring: invalid number of frames: num=%lu max=%lu",
+                (unsigned long)num_frames_, (unsigned long)MaxFrames);
+        return;
+    }
+
+    if (buffer_factory.buffer_size() < frame_size_) {
+        roc_log(LogError, "frame ring: buffer size is too small: required=%lu actual=%lu",
+                (unsigned long)frame_size_, (unsigned long)buffer_factory.buffer_size());
+        return;
+    }
+
+    for (size_t n = 0; n < num_frames_; n++) {
+        frames_[n] = buffer_factory.new_buffer();
+        if (!frames_[n]) {
+            roc_log(LogError, "frame ring: can't allocate frame buffer");
+            return;
+        }
+        frames_[n].reslice(0, frame_size_);
+    }
+
+    valid_ = true;
+}
+
+bool FrameRing::valid() const {
+    return valid_;
+}
+
+size_t FrameRing::frame_size() const {
+    return frame_size_;
+}
+
+size_t FrameRing::num_frames() const {
+    return num_frames_;
+}
+
+size_t FrameRing::num_queued() const {
+    const size_t read_pos = core::AtomicOps::load_acquire(read_pos_);
+    const size_t write_pos = core::AtomicOps::load_acquire(write_pos_);
+
+    return write_pos - read_pos;
+}
+
+audio::sample_t* FrameRing::begin_write() {
+    roc_panic_if(!valid_);
+
+    const size_t write_pos = core::AtomicOps::load_relaxed(write_pos_);
+    const size_t read_pos = core::AtomicOps::load_acquire(read_pos_);
+
+    if (write_pos - read_pos == num_frames_) {
+        return NULL;
+    }
+
+    return frames_[write_pos % num_frames_].data();
+}
+
+void FrameRing::end_write() {
+    const size_t write_pos = core::AtomicOps::load_relaxed(write_pos_);
+
+    core::AtomicOps::store_release(write_pos_, write_pos + 1);
+}
+
+audio::sample_t* FrameRing::begin_read() {
+    roc_panic_if(!valid_);
+
+    const size_t read_pos = core::AtomicOps::load_relaxed(read_pos_);
+    const size_t write_pos = core::AtomicOps::load_acquire(write_pos_);
+
+    if (write_pos == read_pos) {
+        return NULL;
+    }
+
+    return frames_[read_pos % num_frames_].data();
+}
+
+void FrameRing::end_read() {
+    const size_t read_pos = core::AtomicOps::load_relaxed(read_pos_);
+
+    core::AtomicOps::store_release(read_pos_, read_pos + 1);
+}
+
+} // namespace sndio
+} // namespace roc
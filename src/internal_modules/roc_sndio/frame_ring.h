@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/frame_ring.h
+//! @brief Frame ring.
+
+#ifndef ROC_SNDIO_FRAME_RING_H_
+#define ROC_SNDIO_FRAME_RING_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace sndio {
+
+//! Single-producer single-consumer ring of preallocated frames.
+//!
+//! Producer fills a frame in place between begin_write() and end_write(),
+//! consumer reads it in place between begin_read() and end_read(). All
+//! frames are allocated during construction, and no locks are taken.
+//!
+//! Thread-safe for one producer thread and one consumer thread.
+class FrameRing : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Allocates @p num_frames buffers of @p frame_size samples.
+    FrameRing(core::BufferFactory<audio::sample_t>& buffer_factory,
+              size_t frame_size,
+              size_t num_frames);
+
+    //! Check if the object was successfully constructed.
+    bool valid() const;
+
+    //! Get number of samples in every frame.
+    size_t frame_size() const;
+
+    //! Get ring capacity, in frames.
+    size_t num_frames() const;
+
+    //! Get number of frames written but not read yet.
+    //! @remarks
+    //!  May be called from any thread.
+    size_t num_queued() const;
+
+    //! Get next frame to be filled by producer.
+    //! @returns
+    //!  NULL if the ring is full.
+    audio::sample_t* begin_write();
+
+    //! Make frame returned by begin_write() available to consumer.
+    void end_write();
+
+    //! Get next frame to be read by consumer.
+    //! @returns
+    //!  NULL if the ring is empty.
+    audio::sample_t* begin_read();
+
+    //! Return frame returned by begin_read() to producer.
+    void end_read();
+
+private:
+    enum { MaxFrames = 128 };
+
+    core::Slice<audio::sample_t> frames_[MaxFrames];
+
+    size_t frame_size_;
+    size_t num_frames_;
+
+    // monotonic counters; updated only by producer and consumer, respectively
+    size_t write_pos_;
+    size_t read_pos_;
+
+    bool valid_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_FRAME_RING_H_
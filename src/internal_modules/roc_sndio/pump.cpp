@@ -18,15 +18,25 @@ Pump::Pump(core::BufferFactory<audio::sample_t>& buffer_factory,
            ISink& sink,
            core::nanoseconds_t frame_length,
            const audio::SampleSpec& sample_spec,
-           Mode mode)
+           Mode mode,
+           core::nanoseconds_t buffer_length,
+           const PumpThreadConfig& thread_config)
     : main_source_(source)
     , backup_source_(backup_source)
     , sink_(sink)
     , sample_spec_(sample_spec)
+    , frame_length_(frame_length)
+    , thread_config_(thread_config)
+    , frame_size_(0)
+    , sink_thread_(*this)
+    , sink_latency_(0)
     , n_bufs_(0)
     , oneshot_(mode == ModeOneshot)
-    , stop_(0) {
-    size_t frame_size = sample_spec_.ns_2_samples_overall(frame_length);
+    , stop_(0)
+    , source_done_(0)
+    , n_underruns_(0)
+    , n_overruns_(0) {
+    const size_t frame_size = sample_spec_.ns_2_samples_overall(frame_length);
     if (frame_size == 0) {
         roc_log(LogError, "pump: frame size cannot be 0");
         return;
@@ -38,22 +48,50 @@ Pump::Pump(core::BufferFactory<audio::sample_t>& buffer_factory,
         return;
     }
 
-    frame_buffer_ = buffer_factory.new_buffer();
-    if (!frame_buffer_) {
-        roc_log(LogError, "pump: can't allocate frame buffer");
-        return;
+    if (buffer_length > 0) {
+        size_t num_frames = size_t(buffer_length / frame_length);
+        if (num_frames < 2) {
+            num_frames = 2;
+        }
+
+        ring_.reset(new (ring_) FrameRing(buffer_factory, frame_size, num_frames));
+        if (!ring_->valid()) {
+            return;
+        }
+
+        roc_log(LogDebug, "pump: enabled decoupled mode: num_frames=%lu frame_size=%lu",
+                (unsigned long)num_frames, (unsigned long)frame_size);
+    } else {
+        frame_buffer_ = buffer_factory.new_buffer();
+        if (!frame_buffer_) {
+            roc_log(LogError, "pump: can't allocate frame buffer");
+            return;
+        }
+
+        frame_buffer_.reslice(0, frame_size);
     }
 
-    frame_buffer_.reslice(0, frame_size);
+    frame_size_ = frame_size;
 }
 
 bool Pump::valid() const {
-    return frame_buffer_;
+    return frame_size_ != 0;
 }
 
 bool Pump::run() {
     roc_log(LogDebug, "pump: starting main loop");
 
+    configure_thread_();
+
+    if (ring_) {
+        sink_latency_.exclusive_store(sink_.latency());
+
+        if (!sink_thread_.start()) {
+            roc_log(LogError, "pump: can't start sink thread");
+            return false;
+        }
+    }
+
     ISource* current_source = &main_source_;
 
     while (!stop_) {
@@ -86,7 +124,12 @@ bool Pump::run() {
             }
         }
 
-        audio::Frame frame(frame_buffer_.data(), frame_buffer_.size());
+        audio::sample_t* frame_data = begin_frame_(*current_source);
+        if (!frame_data) {
+            break;
+        }
+
+        audio::Frame frame(frame_data, frame_size_);
 
         if (!current_source->read(frame)) {
             roc_log(LogDebug, "pump: got eof from source");
@@ -99,10 +142,10 @@ bool Pump::run() {
             }
         }
 
-        sink_.write(frame);
+        end_frame_(frame);
 
         current_source->reclock(packet::ntp_timestamp()
-                                + packet::nanoseconds_2_ntp(sink_.latency()));
+                                + packet::nanoseconds_2_ntp(latency_()));
 
         if (current_source == &main_source_) {
             n_bufs_++;
@@ -112,11 +155,143 @@ bool Pump::run() {
     roc_log(LogDebug, "pump: exiting main loop, wrote %lu buffers from main source",
             (unsigned long)n_bufs_);
 
+    if (ring_) {
+        source_done_ = 1;
+        read_sem_.post();
+
+        sink_thread_.join();
+
+        roc_log(LogDebug, "pump: sink thread finished: underruns=%lu overruns=%lu",
+                (unsigned long)num_underruns(), (unsigned long)num_overruns());
+    }
+
     return !stop_;
 }
 
 void Pump::stop() {
     stop_ = 1;
+
+    if (ring_) {
+        write_sem_.post();
+    }
+}
+
+size_t Pump::num_underruns() const {
+    return (size_t)n_underruns_;
+}
+
+size_t Pump::num_overruns() const {
+    return (size_t)n_overruns_;
+}
+
+audio::sample_t* Pump::begin_frame_(ISource& source) {
+    if (!ring_) {
+        return frame_buffer_.data();
+    }
+
+    bool waited = false;
+
+    for (;;) {
+        if (audio::sample_t* frame_data = ring_->begin_write()) {
+            return frame_data;
+        }
+
+        if (stop_) {
+            return NULL;
+        }
+
+        if (!waited && source.has_clock()) {
+            n_overruns_++;
+        }
+        waited = true;
+
+        write_sem_.wait();
+    }
+}
+
+void Pump::end_frame_(audio::Frame& frame) {
+    if (!ring_) {
+        sink_.write(frame);
+        return;
+    }
+
+    ring_->end_write();
+    read_sem_.post();
+}
+
+void Pump::configure_thread_() {
+    if (thread_config_.numa_node >= 0) {
+        if (core::Thread::set_numa_node((size_t)thread_config_.numa_node)) {
+            roc_log(LogDebug, "pump: bound pump thread to numa node %d",
+                    thread_config_.numa_node);
+        }
+    }
+
+    if (thread_config_.cpu_affinity >= 0) {
+        if (core::Thread::set_cpu_affinity((size_t)thread_config_.cpu_affinity)) {
+            roc_log(LogDebug, "pump: pinned pump thread to cpu %d",
+                    thread_config_.cpu_affinity);
+        }
+    }
+
+    if (thread_config_.realtime_priority) {
+        if (core::Thread::set_realtime()) {
+            roc_log(LogDebug, "pump: set realtime priority for pump thread");
+        }
+    }
+}
+
+void Pump::run_sink_() {
+    roc_log(LogDebug, "pump: starting sink loop");
+
+    size_t n_frames = 0;
+    bool waited = false;
+
+    for (;;) {
+        // if source is done, all its frames are already visible
+        const bool source_done = source_done_;
+
+        audio::sample_t* frame_data = ring_->begin_read();
+
+        if (!frame_data) {
+            if (source_done) {
+                break;
+            }
+
+            if (!waited && n_frames != 0 && sink_.has_clock()) {
+                n_underruns_++;
+            }
+            waited = true;
+
+            read_sem_.wait();
+            continue;
+        }
+
+        waited = false;
+
+        audio::Frame frame(frame_data, ring_->frame_size());
+        sink_.write(frame);
+
+        sink_latency_.exclusive_store(sink_.latency());
+
+        ring_->end_read();
+        write_sem_.post();
+
+        n_frames++;
+    }
+
+    roc_log(LogDebug, "pump: exiting sink loop, wrote %lu buffers",
+            (unsigned long)n_frames);
+}
+
+core::nanoseconds_t Pump::latency_() const {
+    if (!ring_) {
+        return sink_.latency();
+    }
+
+    // sink is owned by sink thread, so use latency snapshot taken there
+    return sink_latency_.wait_load()
+        + core::nanoseconds_t(ring_->num_queued()) * frame_length_;
 }
 
 } // namespace sndio
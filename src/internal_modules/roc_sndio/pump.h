@@ -17,18 +17,55 @@
 #include "roc_core/atomic.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/seqlock.h"
 #include "roc_core/slice.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
 #include "roc_packet/units.h"
+#include "roc_sndio/frame_ring.h"
 #include "roc_sndio/isink.h"
 #include "roc_sndio/isource.h"
 
 namespace roc {
 namespace sndio {
 
+//! Pump thread parameters.
+//! @remarks
+//!  Pump is used by Roc tools to drive pipelines, so these parameters affect
+//!  the thread on which pipeline frames are processed.
+struct PumpThreadConfig {
+    //! Raise pump thread priority to realtime.
+    bool realtime_priority;
+
+    //! Pin pump thread to given CPU.
+    //! Set to -1 to disable pinning (default).
+    int cpu_affinity;
+
+    //! Bind pump thread to given NUMA node.
+    //! If cpu_affinity is also set, it should be one of the node CPUs.
+    //! Set to -1 to disable binding (default).
+    int numa_node;
+
+    PumpThreadConfig()
+        : realtime_priority(false)
+        , cpu_affinity(-1)
+        , numa_node(-1) {
+    }
+};
+
 //! Audio pump.
 //! @remarks
 //!  Reads frames from source and writes them to sink.
+//!
+//!  By default, reading and writing are performed synchronously on the thread
+//!  that invoked run(), so a slow write to sink delays next read from source.
+//!
+//!  In decoupled mode, sink is written on a separate thread. Source and sink
+//!  threads are connected via lock-free ring of preallocated frames, so that
+//!  short hiccups of one side are absorbed by the ring and don't stall the
+//!  other side.
 class Pump : public core::NonCopyable<> {
 public:
     //! Pump mode.
@@ -41,13 +78,22 @@ public:
     };
 
     //! Initialize.
+    //! @remarks
+    //!  If @p buffer_length is non-zero, enables decoupled mode with a ring
+    //!  of frames of given total duration, typically Config::latency.
+    //!
+    //!  @p thread_config is applied to the thread that invokes run(), when
+    //!  run() starts. In decoupled mode, sink thread is started after that
+    //!  and inherits CPU affinity, scheduling policy, and memory policy.
     Pump(core::BufferFactory<audio::sample_t>& buffer_factory,
          ISource& source,
          ISource* backup_source,
          ISink& sink,
          core::nanoseconds_t frame_length,
          const audio::SampleSpec& sample_spec,
-         Mode mode);
+         Mode mode,
+         core::nanoseconds_t buffer_length = 0,
+         const PumpThreadConfig& thread_config = PumpThreadConfig());
 
     //! Check if the object was successfulyl constructed.
     bool valid() const;
@@ -63,19 +109,73 @@ public:
     //!  May be called from any thread.
     void stop();
 
+    //! Get number of times when sink had to wait for source.
+    //! @remarks
+    //!  Counted only in decoupled mode and only if sink has own clock,
+    //!  i.e. when waiting means that the device is starving.
+    size_t num_underruns() const;
+
+    //! Get number of times when source had to wait for sink.
+    //! @remarks
+    //!  Counted only in decoupled mode and only if source has own clock,
+    //!  i.e. when waiting means that the device is overflowing.
+    size_t num_overruns() const;
+
 private:
+    class SinkThread : public core::Thread {
+    public:
+        explicit SinkThread(Pump& pump)
+            : pump_(pump) {
+        }
+
+    private:
+        virtual void run() {
+            pump_.run_sink_();
+        }
+
+        Pump& pump_;
+    };
+
+    audio::sample_t* begin_frame_(ISource& source);
+    void end_frame_(audio::Frame& frame);
+
+    void run_sink_();
+
+    void configure_thread_();
+
+    core::nanoseconds_t latency_() const;
+
     ISource& main_source_;
     ISource* backup_source_;
     ISink& sink_;
 
     audio::SampleSpec sample_spec_;
+    core::nanoseconds_t frame_length_;
+
+    const PumpThreadConfig thread_config_;
 
+    // used only in synchronous mode
     core::Slice<audio::sample_t> frame_buffer_;
+    size_t frame_size_;
+
+    // used only in decoupled mode
+    core::Optional<FrameRing> ring_;
+    SinkThread sink_thread_;
+
+    // sink latency, updated by sink thread after every write
+    core::Seqlock<core::nanoseconds_t> sink_latency_;
+
+    core::Semaphore read_sem_;
+    core::Semaphore write_sem_;
 
     size_t n_bufs_;
     const bool oneshot_;
 
     core::Atomic<int> stop_;
+    core::Atomic<int> source_done_;
+
+    core::Atomic<int> n_underruns_;
+    core::Atomic<int> n_overruns_;
 };
 
 } // namespace sndio
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/mmap_backend.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_sndio/mmap_format.h"
+#include "roc_sndio/mmap_sink.h"
+#include "roc_sndio/mmap_source.h"
+
+namespace roc {
+namespace sndio {
+
+MmapBackend::MmapBackend() {
+    roc_log(LogDebug, "mmap backend: initializing");
+}
+
+void MmapBackend::discover_drivers(core::Array<DriverInfo, MaxDrivers>& driver_list) {
+    for (size_t n = 0; n < mmap_num_formats(); n++) {
+        if (!driver_list.grow(driver_list.size() + 1)) {
+            roc_panic("mmap backend: can't grow drivers array");
+        }
+
+        driver_list.push_back(DriverInfo(mmap_nth_format(n).driver, DriverType_File,
+                                         DriverFlag_SupportsSource
+                                             | DriverFlag_SupportsSink,
+                                         this));
+    }
+}
+
+IDevice* MmapBackend::open_device(DeviceType device_type,
+                                  DriverType driver_type,
+                                  const char* driver,
+                                  const char* path,
+                                  const Config& config,
+                                  core::IAllocator& allocator) {
+    if (driver_type != DriverType_File) {
+        return NULL;
+    }
+
+    if (!path || strcmp(path, "-") == 0) {
+        // stdin and stdout can't be mapped
+        return NULL;
+    }
+
+    const MmapFormat* format = mmap_find_format(driver, path);
+    if (!format) {
+        roc_log(LogDebug, "mmap backend: format is not supported: driver=%s path=%s",
+                driver, path);
+        return NULL;
+    }
+
+    switch (device_type) {
+    case DeviceType_Sink: {
+        core::ScopedPtr<MmapSink> sink(new (allocator) MmapSink(allocator, config),
+                                       allocator);
+        if (!sink || !sink->valid()) {
+            roc_log(LogDebug, "mmap backend: can't construct sink: driver=%s path=%s",
+                    format->driver, path);
+            return NULL;
+        }
+
+        if (!sink->open(*format, path)) {
+            roc_log(LogDebug, "mmap backend: open failed: driver=%s path=%s",
+                    format->driver, path);
+            return NULL;
+        }
+
+        return sink.release();
+    } break;
+
+    case DeviceType_Source: {
+        core::ScopedPtr<MmapSource> source(new (allocator) MmapSource(allocator, config),
+                                           allocator);
+        if (!source || !source->valid()) {
+            roc_log(LogDebug, "mmap backend: can't construct source: driver=%s path=%s",
+                    format->driver, path);
+            return NULL;
+        }
+
+        if (!source->open(*format, path)) {
+            roc_log(LogDebug, "mmap backend: open failed: driver=%s path=%s",
+                    format->driver, path);
+            return NULL;
+        }
+
+        return source.release();
+    } break;
+
+    default:
+        break;
+    }
+
+    roc_panic("mmap backend: invalid device type");
+}
+
+} // namespace sndio
+} // namespace roc
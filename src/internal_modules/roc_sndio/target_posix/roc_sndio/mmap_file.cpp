@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_sndio/mmap_file.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+// Minimum step of file growth when writing.
+const size_t MinGrowth = 1024 * 1024;
+
+} // namespace
+
+MmapFile::MmapFile()
+    : fd_(-1)
+    , writable_(false)
+    , data_(NULL)
+    , size_(0) {
+}
+
+MmapFile::~MmapFile() {
+    if (fd_ != -1) {
+        (void)close(size_);
+    }
+}
+
+bool MmapFile::open_read(const char* path) {
+    roc_panic_if(fd_ != -1);
+
+    fd_ = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd_ == -1) {
+        roc_log(LogDebug, "mmap file: can't open: path=%s: %s", path,
+                core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    writable_ = false;
+
+    struct stat st;
+    if (fstat(fd_, &st) == -1) {
+        roc_log(LogError, "mmap file: fstat: path=%s: %s", path,
+                core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    if (!S_ISREG(st.st_mode)) {
+        roc_log(LogDebug, "mmap file: not a regular file: path=%s", path);
+        return false;
+    }
+
+    if ((unsigned long long)st.st_size > (size_t)-1) {
+        roc_log(LogError, "mmap file: file is too large to map: path=%s", path);
+        return false;
+    }
+
+    return map_((size_t)st.st_size);
+}
+
+bool MmapFile::open_write(const char* path) {
+    roc_panic_if(fd_ != -1);
+
+    fd_ = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ == -1) {
+        roc_log(LogDebug, "mmap file: can't open: path=%s: %s", path,
+                core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    writable_ = true;
+
+    return true;
+}
+
+bool MmapFile::reserve(size_t size) {
+    roc_panic_if(fd_ == -1 || !writable_);
+
+    if (size <= size_) {
+        return true;
+    }
+
+    size_t new_size = size_ * 2;
+    if (new_size < size_ + MinGrowth) {
+        new_size = size_ + MinGrowth;
+    }
+    if (new_size < size) {
+        new_size = size;
+    }
+
+    unmap_();
+
+    // unlike ftruncate(), fallocate reports lack of disk space now,
+    // instead of SIGBUS on access to mapped memory later
+    int err = posix_fallocate(fd_, 0, (off_t)new_size);
+    if (err == EINVAL || err == EOPNOTSUPP) {
+        err = ftruncate(fd_, (off_t)new_size) == -1 ? errno : 0;
+    }
+    if (err != 0) {
+        roc_log(LogError, "mmap file: can't grow file: size=%lu: %s",
+                (unsigned long)new_size, core::errno_to_str(err).c_str());
+        return false;
+    }
+
+    return map_(new_size);
+}
+
+bool MmapFile::close(size_t final_size) {
+    if (fd_ == -1) {
+        return true;
+    }
+
+    bool ok = true;
+
+    unmap_();
+
+    if (writable_ && ftruncate(fd_, (off_t)final_size) == -1) {
+        roc_log(LogError, "mmap file: ftruncate: %s", core::errno_to_str(errno).c_str());
+        ok = false;
+    }
+
+    if (::close(fd_) == -1) {
+        roc_log(LogError, "mmap file: close: %s", core::errno_to_str(errno).c_str());
+        ok = false;
+    }
+
+    fd_ = -1;
+
+    return ok;
+}
+
+bool MmapFile::is_open() const {
+    return fd_ != -1;
+}
+
+uint8_t* MmapFile::data() const {
+    return data_;
+}
+
+size_t MmapFile::size() const {
+    return size_;
+}
+
+bool MmapFile::map_(size_t size) {
+    roc_panic_if(data_);
+
+    size_ = size;
+
+    if (size_ == 0) {
+        // empty files can't be mapped
+        return true;
+    }
+
+    void* addr = mmap(NULL, size_, writable_ ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                      writable_ ? MAP_SHARED : MAP_PRIVATE, fd_, 0);
+    if (addr == MAP_FAILED) {
+        roc_log(LogError, "mmap file: mmap: size=%lu: %s", (unsigned long)size_,
+                core::errno_to_str(errno).c_str());
+        size_ = 0;
+        return false;
+    }
+
+    data_ = (uint8_t*)addr;
+
+    (void)posix_madvise(data_, size_, POSIX_MADV_SEQUENTIAL);
+
+    return true;
+}
+
+void MmapFile::unmap_() {
+    if (!data_) {
+        return;
+    }
+
+    if (munmap(data_, size_) == -1) {
+        roc_panic("mmap file: munmap: %s", core::errno_to_str(errno).c_str());
+    }
+
+    data_ = NULL;
+}
+
+} // namespace sndio
+} // namespace roc
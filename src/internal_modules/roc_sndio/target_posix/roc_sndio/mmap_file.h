@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/target_posix/roc_sndio/mmap_file.h
+//! @brief Memory-mapped file.
+
+#ifndef ROC_SNDIO_MMAP_FILE_H_
+#define ROC_SNDIO_MMAP_FILE_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace sndio {
+
+//! Memory-mapped file.
+//! @remarks
+//!  Maps the whole file into memory and hints the kernel that it will be
+//!  accessed sequentially.
+class MmapFile : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    MmapFile();
+
+    //! Unmap and close file.
+    ~MmapFile();
+
+    //! Open existing file for reading and map it.
+    bool open_read(const char* path);
+
+    //! Create or truncate file for writing.
+    //! @remarks
+    //!  Nothing is mapped until reserve() is called.
+    bool open_write(const char* path);
+
+    //! Ensure that at least @p size bytes of the file are mapped.
+    //! @remarks
+    //!  Grows file and remaps it if needed. Pointers returned by data()
+    //!  before the call are invalidated.
+    bool reserve(size_t size);
+
+    //! Unmap file, set its final size, and close it.
+    //! @remarks
+    //!  Size is changed only if the file was opened for writing.
+    bool close(size_t final_size);
+
+    //! Check if file is open.
+    bool is_open() const;
+
+    //! Get mapped memory.
+    uint8_t* data() const;
+
+    //! Get size of mapped memory.
+    size_t size() const;
+
+private:
+    bool map_(size_t size);
+    void unmap_();
+
+    int fd_;
+    bool writable_;
+
+    uint8_t* data_;
+    size_t size_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_MMAP_FILE_H_
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <strings.h>
+
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_sndio/mmap_format.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+// driver names are prefixed to not clash with sox drivers;
+// WAV files are written as 32-bit integers, same as sox backend does;
+// headerless files use native endian, same as sox raw formats
+const MmapFormat formats[] = {
+    { "mmap_wav", "wav", true, audio::PcmEncoding_SInt32 },
+    { "mmap_f32", NULL, false, audio::PcmEncoding_Float32 },
+    { "mmap_s16", NULL, false, audio::PcmEncoding_SInt16 },
+    { "mmap_s32", NULL, false, audio::PcmEncoding_SInt32 },
+};
+
+bool has_extension(const char* path, const char* ext) {
+    const size_t path_len = strlen(path);
+    const size_t ext_len = strlen(ext);
+
+    if (path_len <= ext_len + 1 || path[path_len - ext_len - 1] != '.') {
+        return false;
+    }
+
+    return strcasecmp(path + path_len - ext_len, ext) == 0;
+}
+
+} // namespace
+
+size_t mmap_num_formats() {
+    return ROC_ARRAY_SIZE(formats);
+}
+
+const MmapFormat& mmap_nth_format(size_t n) {
+    roc_panic_if(n >= ROC_ARRAY_SIZE(formats));
+
+    return formats[n];
+}
+
+const MmapFormat* mmap_find_format(const char* driver, const char* path) {
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(formats); n++) {
+        if (driver) {
+            if (strcmp(formats[n].driver, driver) == 0) {
+                return &formats[n];
+            }
+        } else if (path) {
+            // only self-describing formats are detected by extension
+            if (formats[n].extension && has_extension(path, formats[n].extension)) {
+                return &formats[n];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/target_posix/roc_sndio/mmap_format.h
+//! @brief Formats supported by mmap backend.
+
+#ifndef ROC_SNDIO_MMAP_FORMAT_H_
+#define ROC_SNDIO_MMAP_FORMAT_H_
+
+#include "roc_audio/pcm_format.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace sndio {
+
+//! File format supported by mmap backend.
+struct MmapFormat {
+    //! Driver name.
+    const char* driver;
+
+    //! File extension used for auto-detection.
+    //! NULL if the format can be selected only by driver name.
+    const char* extension;
+
+    //! Whether file has WAV header.
+    bool has_header;
+
+    //! Sample encoding for headerless files, and for WAV files being written.
+    audio::PcmEncoding encoding;
+};
+
+//! Get number of supported formats.
+size_t mmap_num_formats();
+
+//! Get supported format by index.
+const MmapFormat& mmap_nth_format(size_t n);
+
+//! Find format by driver name or, if @p driver is NULL, by file extension.
+//! @returns
+//!  NULL if the format is not supported.
+const MmapFormat* mmap_find_format(const char* driver, const char* path);
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_MMAP_FORMAT_H_
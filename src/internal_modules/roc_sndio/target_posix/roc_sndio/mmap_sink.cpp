@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/mmap_sink.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_sndio/wav_header.h"
+
+namespace roc {
+namespace sndio {
+
+MmapSink::MmapSink(core::IAllocator&, const Config& config)
+    : sample_spec_(config.sample_spec)
+    , has_header_(false)
+    , data_begin_(0)
+    , write_pos_(0)
+    , size_exceeded_(false)
+    , valid_(false) {
+    if (config.sample_spec.num_channels() == 0) {
+        roc_log(LogError, "mmap sink: # of channels is zero");
+        return;
+    }
+
+    if (config.latency != 0) {
+        roc_log(LogError, "mmap sink: setting io latency not supported by mmap backend");
+        return;
+    }
+
+    valid_ = true;
+}
+
+MmapSink::~MmapSink() {
+    close_();
+}
+
+bool MmapSink::valid() const {
+    return valid_;
+}
+
+bool MmapSink::open(const MmapFormat& format, const char* path) {
+    roc_panic_if(!valid_);
+
+    roc_log(LogDebug, "mmap sink: opening: driver=%s path=%s", format.driver, path);
+
+    if (file_.is_open()) {
+        roc_panic("mmap sink: can't call open() more than once");
+    }
+
+    if (sample_spec_.sample_rate() == 0) {
+        // let other backends choose default rate
+        roc_log(LogDebug, "mmap sink: can't open: sample rate required: path=%s", path);
+        return false;
+    }
+
+    if (!file_.open_write(path)) {
+        return false;
+    }
+
+    has_header_ = format.has_header;
+    data_begin_ = has_header_ ? WavHeader::ComposedSize : 0;
+    write_pos_ = data_begin_;
+
+    mapper_.reset(new (mapper_) audio::PcmMapper(
+        audio::PcmFormat(audio::PcmEncoding_Float32, audio::PcmEndian_Native),
+        audio::PcmFormat(format.encoding,
+                         has_header_ ? audio::PcmEndian_Little
+                                     : audio::PcmEndian_Native)));
+
+    roc_log(LogInfo,
+            "mmap sink: opened: driver=%s path=%s out_bits=%lu out_rate=%lu out_ch=%lu",
+            format.driver, path, (unsigned long)mapper_->output_bit_count(1),
+            (unsigned long)sample_spec_.sample_rate(),
+            (unsigned long)sample_spec_.num_channels());
+
+    return true;
+}
+
+DeviceType MmapSink::type() const {
+    return DeviceType_Sink;
+}
+
+DeviceState MmapSink::state() const {
+    return DeviceState_Active;
+}
+
+void MmapSink::pause() {
+    // no-op
+}
+
+bool MmapSink::resume() {
+    return true;
+}
+
+bool MmapSink::restart() {
+    return true;
+}
+
+audio::SampleSpec MmapSink::sample_spec() const {
+    roc_panic_if(!valid_);
+
+    if (!mapper_) {
+        roc_panic("mmap sink: sample_spec(): non-open output file");
+    }
+
+    return sample_spec_;
+}
+
+core::nanoseconds_t MmapSink::latency() const {
+    roc_panic_if(!valid_);
+
+    if (!mapper_) {
+        roc_panic("mmap sink: latency(): non-open output file");
+    }
+
+    return 0;
+}
+
+bool MmapSink::has_clock() const {
+    roc_panic_if(!valid_);
+
+    if (!mapper_) {
+        roc_panic("mmap sink: has_clock(): non-open output file");
+    }
+
+    return false;
+}
+
+void MmapSink::write(audio::Frame& frame) {
+    roc_panic_if(!valid_);
+
+    if (!mapper_) {
+        roc_panic("mmap sink: write: non-open output file");
+    }
+
+    const size_t n_samples = frame.num_samples();
+    const size_t n_bytes = mapper_->output_byte_count(n_samples);
+
+    if (has_header_ && write_pos_ - data_begin_ + n_bytes > WavHeader::MaxDataSize) {
+        // WAV header can't describe larger file
+        if (!size_exceeded_) {
+            roc_log(LogError,
+                    "mmap sink: reached maximum wav file size, dropping frames:"
+                    " max_size=%lu",
+                    (unsigned long)WavHeader::MaxDataSize);
+            size_exceeded_ = true;
+        }
+        return;
+    }
+
+    if (!file_.reserve(write_pos_ + n_bytes)) {
+        roc_log(LogError, "mmap sink: failed to write output frame");
+        return;
+    }
+
+    size_t in_bit_off = 0;
+    size_t out_bit_off = 0;
+
+    mapper_->map(frame.samples(), n_samples * sizeof(audio::sample_t), in_bit_off,
+                 file_.data() + write_pos_, file_.size() - write_pos_, out_bit_off,
+                 n_samples);
+
+    write_pos_ += out_bit_off / 8;
+}
+
+void MmapSink::close_() {
+    if (!file_.is_open()) {
+        return;
+    }
+
+    roc_log(LogDebug, "mmap sink: closing output");
+
+    if (has_header_ && file_.reserve(data_begin_)) {
+        WavHeader header(mapper_->output_format().encoding, sample_spec_.num_channels(),
+                         sample_spec_.sample_rate());
+        header.set_data_size(write_pos_ - data_begin_);
+        header.compose(file_.data());
+    }
+
+    if (!file_.close(write_pos_)) {
+        roc_log(LogError, "mmap sink: failed to close output file");
+    }
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/target_posix/roc_sndio/mmap_sink.h
+//! @brief Memory-mapped file sink.
+
+#ifndef ROC_SNDIO_MMAP_SINK_H_
+#define ROC_SNDIO_MMAP_SINK_H_
+
+#include "roc_audio/pcm_mapper.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/stddefs.h"
+#include "roc_sndio/config.h"
+#include "roc_sndio/isink.h"
+#include "roc_sndio/mmap_file.h"
+#include "roc_sndio/mmap_format.h"
+
+namespace roc {
+namespace sndio {
+
+//! Memory-mapped file sink.
+//! @remarks
+//!  Writes samples to WAV or headerless PCM file. The file is grown in large
+//!  steps and mapped into memory, and samples are converted from frames
+//!  directly into the mapping, without intermediate buffers and write()
+//!  syscalls. WAV header is written when the sink is destroyed.
+class MmapSink : public ISink, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    MmapSink(core::IAllocator& allocator, const Config& config);
+
+    virtual ~MmapSink();
+
+    //! Check if the object was successfully constructed.
+    bool valid() const;
+
+    //! Open output file.
+    //!
+    //! @b Parameters
+    //!  - @p format is file format;
+    //!  - @p path is output file name.
+    //!
+    //! @remarks
+    //!  Sample rate should be set in config.
+    bool open(const MmapFormat& format, const char* path);
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Get device state.
+    virtual DeviceState state() const;
+
+    //! Pause reading.
+    virtual void pause();
+
+    //! Resume paused reading.
+    virtual bool resume();
+
+    //! Restart reading from the beginning.
+    virtual bool restart();
+
+    //! Get sample specification of the sink.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get latency of the sink.
+    virtual core::nanoseconds_t latency() const;
+
+    //! Check if the sink has own clock.
+    virtual bool has_clock() const;
+
+    //! Write audio frame.
+    virtual void write(audio::Frame& frame);
+
+private:
+    void close_();
+
+    MmapFile file_;
+    core::Optional<audio::PcmMapper> mapper_;
+
+    audio::SampleSpec sample_spec_;
+
+    bool has_header_;
+    size_t data_begin_;
+    size_t write_pos_;
+    bool size_exceeded_;
+
+    bool valid_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_MMAP_SINK_H_
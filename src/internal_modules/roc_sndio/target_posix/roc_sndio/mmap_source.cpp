@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/mmap_source.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_sndio/wav_header.h"
+
+namespace roc {
+namespace sndio {
+
+MmapSource::MmapSource(core::IAllocator&, const Config& config)
+    : sample_spec_(config.sample_spec)
+    , data_begin_(0)
+    , data_end_(0)
+    , read_pos_(0)
+    , paused_(false)
+    , valid_(false) {
+    if (config.sample_spec.num_channels() == 0) {
+        roc_log(LogError, "mmap source: # of channels is zero");
+        return;
+    }
+
+    if (config.latency != 0) {
+        roc_log(LogError,
+                "mmap source: setting io latency not supported by mmap backend");
+        return;
+    }
+
+    valid_ = true;
+}
+
+MmapSource::~MmapSource() {
+    (void)file_.close(0);
+}
+
+bool MmapSource::valid() const {
+    return valid_;
+}
+
+bool MmapSource::open(const MmapFormat& format, const char* path) {
+    roc_panic_if(!valid_);
+
+    roc_log(LogDebug, "mmap source: opening: driver=%s path=%s", format.driver, path);
+
+    if (file_.is_open()) {
+        roc_panic("mmap source: can't call open() more than once");
+    }
+
+    if (!file_.open_read(path)) {
+        return false;
+    }
+
+    if (!setup_format_(format, path)) {
+        return false;
+    }
+
+    read_pos_ = data_begin_;
+
+    roc_log(LogInfo,
+            "mmap source: opened: driver=%s path=%s in_bits=%lu in_rate=%lu in_ch=%lu"
+            " n_samples=%lu",
+            format.driver, path, (unsigned long)mapper_->input_bit_count(1),
+            (unsigned long)sample_spec_.sample_rate(),
+            (unsigned long)sample_spec_.num_channels(),
+            (unsigned long)mapper_->input_sample_count(data_end_ - data_begin_));
+
+    return true;
+}
+
+DeviceType MmapSource::type() const {
+    return DeviceType_Source;
+}
+
+DeviceState MmapSource::state() const {
+    roc_panic_if(!valid_);
+
+    if (paused_) {
+        return DeviceState_Paused;
+    } else {
+        return DeviceState_Active;
+    }
+}
+
+void MmapSource::pause() {
+    roc_panic_if(!valid_);
+
+    paused_ = true;
+}
+
+bool MmapSource::resume() {
+    roc_panic_if(!valid_);
+
+    paused_ = false;
+    return true;
+}
+
+bool MmapSource::restart() {
+    roc_panic_if(!valid_);
+
+    if (!mapper_) {
+        roc_panic("mmap source: restart: non-open input file");
+    }
+
+    roc_log(LogDebug, "mmap source: restarting");
+
+    read_pos_ = data_begin_;
+    paused_ = false;
+
+    return true;
+}
+
+audio::SampleSpec MmapSource::sample_spec() const {
+    roc_panic_if(!valid_);
+
+    if (!mapper_) {
+        roc_panic("mmap source: sample_spec(): non-open input file");
+    }
+
+    return sample_spec_;
+}
+
+core::nanoseconds_t MmapSource::latency() const {
+    roc_panic_if(!valid_);
+
+    if (!mapper_) {
+        roc_panic("mmap source: latency(): non-open input file");
+    }
+
+    return 0;
+}
+
+bool MmapSource::has_clock() const {
+    roc_panic_if(!valid_);
+
+    if (!mapper_) {
+        roc_panic("mmap source: has_clock(): non-open input file");
+    }
+
+    return false;
+}
+
+void MmapSource::reclock(packet::ntp_timestamp_t) {
+    // no-op
+}
+
+bool MmapSource::read(audio::Frame& frame) {
+    roc_panic_if(!valid_);
+
+    if (paused_) {
+        return false;
+    }
+
+    if (!mapper_) {
+        roc_panic("mmap source: read: non-open input file");
+    }
+
+    size_t n_samples = mapper_->input_sample_count(data_end_ - read_pos_);
+    if (n_samples == 0) {
+        return false;
+    }
+    if (n_samples > frame.num_samples()) {
+        n_samples = frame.num_samples();
+    }
+
+    size_t in_bit_off = 0;
+    size_t out_bit_off = 0;
+
+    n_samples = mapper_->map(file_.data() + read_pos_, data_end_ - read_pos_,
+                             in_bit_off, frame.samples(),
+                             frame.num_samples() * sizeof(audio::sample_t), out_bit_off,
+                             n_samples);
+
+    read_pos_ += in_bit_off / 8;
+
+    if (n_samples < frame.num_samples()) {
+        memset(frame.samples() + n_samples, 0,
+               (frame.num_samples() - n_samples) * sizeof(audio::sample_t));
+    }
+
+    return true;
+}
+
+bool MmapSource::setup_format_(const MmapFormat& format, const char* path) {
+    audio::PcmFormat in_format;
+    size_t num_channels = 0;
+
+    if (format.has_header) {
+        WavHeader header;
+        if (!header.parse(file_.data(), file_.size())) {
+            roc_log(LogDebug, "mmap source: can't open: unsupported wav file: path=%s",
+                    path);
+            return false;
+        }
+
+        in_format = header.format();
+        num_channels = header.num_channels();
+        sample_spec_.set_sample_rate(header.sample_rate());
+
+        data_begin_ = header.data_offset();
+        data_end_ = header.data_offset() + header.data_size();
+    } else {
+        if (sample_spec_.sample_rate() == 0) {
+            roc_log(LogDebug,
+                    "mmap source: can't open: sample rate required for raw file:"
+                    " path=%s",
+                    path);
+            return false;
+        }
+
+        in_format = audio::PcmFormat(format.encoding, audio::PcmEndian_Native);
+        num_channels = sample_spec_.num_channels();
+
+        data_begin_ = 0;
+        data_end_ = file_.size();
+    }
+
+    if (num_channels != sample_spec_.num_channels()) {
+        roc_log(LogError,
+                "mmap source: can't open: unsupported # of channels: "
+                "expected=%lu actual=%lu",
+                (unsigned long)sample_spec_.num_channels(), (unsigned long)num_channels);
+        return false;
+    }
+
+    mapper_.reset(new (mapper_) audio::PcmMapper(
+        in_format, audio::PcmFormat(audio::PcmEncoding_Float32, audio::PcmEndian_Native)));
+
+    // drop incomplete trailing block, if any
+    const size_t block_size = mapper_->input_byte_count(num_channels);
+    data_end_ -= (data_end_ - data_begin_) % block_size;
+
+    return true;
+}
+
+} // namespace sndio
+} // namespace roc
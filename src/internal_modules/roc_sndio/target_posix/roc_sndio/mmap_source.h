@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/target_posix/roc_sndio/mmap_source.h
+//! @brief Memory-mapped file source.
+
+#ifndef ROC_SNDIO_MMAP_SOURCE_H_
+#define ROC_SNDIO_MMAP_SOURCE_H_
+
+#include "roc_audio/pcm_mapper.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/units.h"
+#include "roc_sndio/config.h"
+#include "roc_sndio/isource.h"
+#include "roc_sndio/mmap_file.h"
+#include "roc_sndio/mmap_format.h"
+
+namespace roc {
+namespace sndio {
+
+//! Memory-mapped file source.
+//! @remarks
+//!  Reads samples from WAV or headerless PCM file. The file is mapped into
+//!  memory and samples are converted directly from the mapping into frames,
+//!  without intermediate buffers and read() syscalls.
+class MmapSource : public ISource, private core::NonCopyable<> {
+public:
+    //! Initialize.
+    MmapSource(core::IAllocator& allocator, const Config& config);
+
+    virtual ~MmapSource();
+
+    //! Check if the object was successfully constructed.
+    bool valid() const;
+
+    //! Open input file.
+    //!
+    //! @b Parameters
+    //!  - @p format is file format;
+    //!  - @p path is input file name.
+    //!
+    //! @remarks
+    //!  For headerless formats, sample rate is taken from config and should
+    //!  be non-zero.
+    bool open(const MmapFormat& format, const char* path);
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Get device state.
+    virtual DeviceState state() const;
+
+    //! Pause reading.
+    virtual void pause();
+
+    //! Resume paused reading.
+    virtual bool resume();
+
+    //! Restart reading from the beginning.
+    virtual bool restart();
+
+    //! Get sample specification of the source.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get latency of the source.
+    virtual core::nanoseconds_t latency() const;
+
+    //! Check if the source has own clock.
+    virtual bool has_clock() const;
+
+    //! Adjust source clock to match consumer clock.
+    virtual void reclock(packet::ntp_timestamp_t timestamp);
+
+    //! Read frame.
+    virtual bool read(audio::Frame&);
+
+private:
+    bool setup_format_(const MmapFormat& format, const char* path);
+
+    MmapFile file_;
+    core::Optional<audio::PcmMapper> mapper_;
+
+    audio::SampleSpec sample_spec_;
+
+    size_t data_begin_;
+    size_t data_end_;
+    size_t read_pos_;
+
+    bool paused_;
+    bool valid_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_MMAP_SOURCE_H_
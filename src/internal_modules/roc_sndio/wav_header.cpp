@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/wav_header.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum {
+    FormatTag_PCM = 0x0001,
+    FormatTag_IEEE_Float = 0x0003,
+    FormatTag_Extensible = 0xFFFE
+};
+
+const size_t ChunkHeaderSize = 8;
+const size_t MinFmtSize = 16;
+const size_t ExtensibleFmtSize = 40;
+
+uint16_t read_u16(const uint8_t* p) {
+    return uint16_t(p[0] | (p[1] << 8));
+}
+
+uint32_t read_u32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16)
+        | (uint32_t(p[3]) << 24);
+}
+
+void write_u16(uint8_t* p, uint16_t v) {
+    p[0] = uint8_t(v);
+    p[1] = uint8_t(v >> 8);
+}
+
+void write_u32(uint8_t* p, uint32_t v) {
+    p[0] = uint8_t(v);
+    p[1] = uint8_t(v >> 8);
+    p[2] = uint8_t(v >> 16);
+    p[3] = uint8_t(v >> 24);
+}
+
+bool select_encoding(unsigned format_tag, size_t bits, audio::PcmEncoding& encoding) {
+    if (format_tag == FormatTag_PCM) {
+        switch (bits) {
+        case 8:
+            encoding = audio::PcmEncoding_UInt8;
+            return true;
+        case 16:
+            encoding = audio::PcmEncoding_SInt16;
+            return true;
+        case 24:
+            encoding = audio::PcmEncoding_SInt24;
+            return true;
+        case 32:
+            encoding = audio::PcmEncoding_SInt32;
+            return true;
+        }
+    } else if (format_tag == FormatTag_IEEE_Float) {
+        switch (bits) {
+        case 32:
+            encoding = audio::PcmEncoding_Float32;
+            return true;
+        case 64:
+            encoding = audio::PcmEncoding_Float64;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t sample_bits(audio::PcmEncoding encoding) {
+    switch (encoding) {
+    case audio::PcmEncoding_UInt8:
+        return 8;
+    case audio::PcmEncoding_SInt16:
+        return 16;
+    case audio::PcmEncoding_SInt24:
+        return 24;
+    case audio::PcmEncoding_SInt32:
+    case audio::PcmEncoding_Float32:
+        return 32;
+    case audio::PcmEncoding_Float64:
+        return 64;
+    default:
+        break;
+    }
+
+    roc_panic("wav header: unsupported encoding: %d", (int)encoding);
+}
+
+} // namespace
+
+WavHeader::WavHeader()
+    : encoding_()
+    , num_channels_(0)
+    , sample_rate_(0)
+    , data_offset_(0)
+    , data_size_(0) {
+}
+
+WavHeader::WavHeader(audio::PcmEncoding encoding,
+                     size_t num_channels,
+                     size_t sample_rate)
+    : encoding_(encoding)
+    , num_channels_(num_channels)
+    , sample_rate_(sample_rate)
+    , data_offset_(ComposedSize)
+    , data_size_(0) {
+}
+
+bool WavHeader::parse(const uint8_t* data, size_t size) {
+    if (size < 12 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    bool has_fmt = false;
+    size_t pos = 12;
+
+    while (pos + ChunkHeaderSize <= size) {
+        const uint8_t* chunk = data + pos;
+        const size_t chunk_size = read_u32(chunk + 4);
+        const size_t body_pos = pos + ChunkHeaderSize;
+
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            if (chunk_size < MinFmtSize || body_pos + chunk_size > size) {
+                roc_log(LogDebug, "wav header: bad fmt chunk");
+                return false;
+            }
+
+            const uint8_t* fmt = data + body_pos;
+
+            unsigned format_tag = read_u16(fmt);
+            const size_t bits = read_u16(fmt + 14);
+
+            if (format_tag == FormatTag_Extensible) {
+                if (chunk_size < ExtensibleFmtSize) {
+                    roc_log(LogDebug, "wav header: bad extensible fmt chunk");
+                    return false;
+                }
+                // first two bytes of sub-format GUID hold format tag
+                format_tag = read_u16(fmt + 24);
+            }
+
+            if (!select_encoding(format_tag, bits, encoding_)) {
+                roc_log(LogDebug, "wav header: unsupported format: tag=%u bits=%lu",
+                        format_tag, (unsigned long)bits);
+                return false;
+            }
+
+            num_channels_ = read_u16(fmt + 2);
+            sample_rate_ = read_u32(fmt + 4);
+            has_fmt = true;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!has_fmt || num_channels_ == 0) {
+                roc_log(LogDebug, "wav header: data chunk before fmt chunk");
+                return false;
+            }
+
+            data_offset_ = body_pos;
+            data_size_ = chunk_size;
+
+            if (data_size_ > size - data_offset_) {
+                data_size_ = size - data_offset_;
+            }
+
+            // drop incomplete sample at the end, if any
+            const size_t block_size = sample_bits(encoding_) / 8 * num_channels_;
+            data_size_ -= data_size_ % block_size;
+
+            return true;
+        }
+
+        // chunks are padded to even size
+        pos = body_pos + chunk_size + (chunk_size & 1);
+    }
+
+    roc_log(LogDebug, "wav header: no data chunk");
+    return false;
+}
+
+void WavHeader::compose(uint8_t* data) const {
+    const size_t bits = sample_bits(encoding_);
+    const size_t block_size = bits / 8 * num_channels_;
+
+    const bool is_float = encoding_ == audio::PcmEncoding_Float32
+        || encoding_ == audio::PcmEncoding_Float64;
+
+    memcpy(data, "RIFF", 4);
+    write_u32(data + 4, uint32_t(ComposedSize - 8 + data_size_));
+    memcpy(data + 8, "WAVE", 4);
+
+    memcpy(data + 12, "fmt ", 4);
+    write_u32(data + 16, uint32_t(MinFmtSize));
+    write_u16(data + 20, uint16_t(is_float ? FormatTag_IEEE_Float : FormatTag_PCM));
+    write_u16(data + 22, uint16_t(num_channels_));
+    write_u32(data + 24, uint32_t(sample_rate_));
+    write_u32(data + 28, uint32_t(sample_rate_ * block_size));
+    write_u16(data + 32, uint16_t(block_size));
+    write_u16(data + 34, uint16_t(bits));
+
+    memcpy(data + 36, "data", 4);
+    write_u32(data + 40, uint32_t(data_size_));
+}
+
+audio::PcmFormat WavHeader::format() const {
+    return audio::PcmFormat(encoding_, audio::PcmEndian_Little);
+}
+
+size_t WavHeader::num_channels() const {
+    return num_channels_;
+}
+
+size_t WavHeader::sample_rate() const {
+    return sample_rate_;
+}
+
+size_t WavHeader::data_offset() const {
+    return data_offset_;
+}
+
+size_t WavHeader::data_size() const {
+    return data_size_;
+}
+
+void WavHeader::set_data_size(size_t size) {
+    roc_panic_if_msg(size > MaxDataSize, "wav header: data size is too large: size=%lu",
+                     (unsigned long)size);
+
+    data_size_ = size;
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/wav_header.h
+//! @brief WAV header.
+
+#ifndef ROC_SNDIO_WAV_HEADER_H_
+#define ROC_SNDIO_WAV_HEADER_H_
+
+#include "roc_audio/pcm_format.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace sndio {
+
+//! WAV file header.
+//! @remarks
+//!  Supports uncompressed integer and floating point PCM, including
+//!  WAVE_FORMAT_EXTENSIBLE files. Samples are always little-endian.
+class WavHeader {
+public:
+    //! Size of header produced by compose().
+    static const size_t ComposedSize = 44;
+
+    //! Maximum size of sample data.
+    //! RIFF chunk sizes are 32-bit, so larger files can't be described.
+    static const size_t MaxDataSize = 0xFFFFFFFFu - (ComposedSize - 8);
+
+    //! Initialize empty header.
+    WavHeader();
+
+    //! Initialize header for writing.
+    WavHeader(audio::PcmEncoding encoding, size_t num_channels, size_t sample_rate);
+
+    //! Parse header from the beginning of the file.
+    //! @returns
+    //!  false if the file is not a WAV file or uses unsupported encoding.
+    //! @remarks
+    //!  If data size in header exceeds file size (e.g. when the file was
+    //!  written to a pipe or wasn't finalized), it's truncated to file size.
+    bool parse(const uint8_t* data, size_t size);
+
+    //! Compose header into ComposedSize bytes of @p data.
+    void compose(uint8_t* data) const;
+
+    //! Get sample format.
+    audio::PcmFormat format() const;
+
+    //! Get number of channels.
+    size_t num_channels() const;
+
+    //! Get sample rate.
+    size_t sample_rate() const;
+
+    //! Get offset of sample data from the beginning of the file.
+    size_t data_offset() const;
+
+    //! Get size of sample data in bytes.
+    size_t data_size() const;
+
+    //! Set size of sample data in bytes.
+    //! @pre
+    //!  @p size should not exceed MaxDataSize.
+    void set_data_size(size_t size);
+
+private:
+    audio::PcmEncoding encoding_;
+    size_t num_channels_;
+    size_t sample_rate_;
+    size_t data_offset_;
+    size_t data_size_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_WAV_HEADER_H_
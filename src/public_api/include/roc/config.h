@@ -361,6 +361,14 @@ typedef struct roc_context_config {
      * If zero, default value is used.
      */
     unsigned int max_frame_size;
+
+    /** Enable io_uring for network I/O.
+     * If non-zero, and the library was built with io_uring support, and the kernel
+     * supports it, UDP datagrams are sent and received via io_uring instead of libuv.
+     * Otherwise, libuv is used.
+     * If zero, io_uring is not used.
+     */
+    unsigned int enable_io_uring;
 } roc_context_config;
 
 /** Sender configuration.
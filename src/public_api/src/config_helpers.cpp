@@ -24,6 +24,8 @@ bool context_config_from_user(peer::ContextConfig& out, const roc_context_config
         out.max_frame_size = in.max_frame_size;
     }
 
+    out.network_loop.io_uring = (in.enable_io_uring != 0);
+
     return true;
 }
 
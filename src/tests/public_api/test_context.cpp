@@ -30,6 +30,20 @@ TEST(context, open_close) {
     LONGS_EQUAL(0, roc_context_close(context));
 }
 
+TEST(context, open_io_uring) {
+    roc_context_config config;
+    memset(&config, 0, sizeof(config));
+    config.enable_io_uring = 1;
+
+    // Should succeed regardless of whether io_uring is available,
+    // falling back to libuv otherwise.
+    roc_context* context = NULL;
+    CHECK(roc_context_open(&config, &context) == 0);
+    CHECK(context);
+
+    LONGS_EQUAL(0, roc_context_close(context));
+}
+
 TEST(context, open_null) {
     roc_context* context = NULL;
     LONGS_EQUAL(-1, roc_context_open(NULL, &context));
@@ -34,7 +34,8 @@ public:
           core::HeapAllocator& allocator,
           packet::PacketFactory& packet_factory,
           core::BufferFactory<uint8_t>& byte_buffer_factory)
-        : net_loop_(packet_factory, byte_buffer_factory, allocator)
+        : net_loop_(
+              netio::NetworkLoopConfig(), packet_factory, byte_buffer_factory, allocator)
         , n_source_packets_(n_source_packets)
         , n_repair_packets_(n_repair_packets)
         , pos_(0) {
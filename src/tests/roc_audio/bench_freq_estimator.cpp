@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/freq_estimator.h"
+#include "roc_core/fast_random.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// Measures cost of FreqEstimator updates on a receiver with many sessions,
+// each having its own estimator updated once per frame.
+//
+// Argument is decimation factor of the first stage.
+//
+// Reported time is per round, i.e. one update of every estimator.
+
+enum { NumEstimators = 1000, Target = 10000, NumLatencies = 1024 };
+
+class EstimatorSet {
+public:
+    EstimatorSet(size_t decimation_factor) {
+        FreqEstimatorConfig config;
+        config.decimation_factor1 = decimation_factor;
+
+        for (size_t n = 0; n < NumEstimators; n++) {
+            estimators_[n] = new FreqEstimator(config, Target);
+        }
+
+        for (size_t n = 0; n < NumLatencies; n++) {
+            noise_[n] = packet::timestamp_t(Target - 100 + core::fast_random(0, 200));
+        }
+    }
+
+    ~EstimatorSet() {
+        for (size_t n = 0; n < NumEstimators; n++) {
+            delete estimators_[n];
+        }
+    }
+
+    FreqEstimator** estimators() {
+        return estimators_;
+    }
+
+    // Different latency for every estimator in every round.
+    const packet::timestamp_t* latencies(size_t round) {
+        for (size_t n = 0; n < NumEstimators; n++) {
+            latencies_[n] = noise_[(n + round) % NumLatencies];
+        }
+        return latencies_;
+    }
+
+private:
+    FreqEstimator* estimators_[NumEstimators];
+    packet::timestamp_t latencies_[NumEstimators];
+    packet::timestamp_t noise_[NumLatencies];
+};
+
+void BM_FreqEstimator_Update(benchmark::State& state) {
+    EstimatorSet set((size_t)state.range(0));
+
+    size_t round = 0;
+    float sum = 0;
+
+    while (state.KeepRunning()) {
+        const packet::timestamp_t* latencies = set.latencies(round++);
+
+        for (size_t n = 0; n < NumEstimators; n++) {
+            set.estimators()[n]->update(latencies[n]);
+            sum += set.estimators()[n]->freq_coeff();
+        }
+    }
+
+    benchmark::DoNotOptimize(sum);
+}
+
+BENCHMARK(BM_FreqEstimator_Update)
+    ->Arg(1)
+    ->Arg(fe_decim_factor_max)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
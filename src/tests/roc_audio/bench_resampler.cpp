@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_drift.h"
+#include "roc_audio/resampler_map.h"
+#include "roc_audio/resampler_reader.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/scoped_ptr.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// Measures per-frame cost of resampling in receiver session, when input and
+// output rates are equal and resampler only compensates clock drift.
+//
+// Bench_Builtin  - full builtin resampler with given profile
+// Bench_Drift    - drift resampler (ResamplerBackend_Drift)
+
+enum { SampleRate = 44100, ChMask = 0x3, FrameSize = 440, NumIterations = 20000 };
+
+const float Scaling = 1.0001f;
+
+core::HeapAllocator allocator;
+core::BufferFactory<sample_t> buffer_factory(allocator, FrameSize * 2, true);
+
+class SineReader : public IFrameReader {
+public:
+    SineReader()
+        : pos_(0) {
+    }
+
+    virtual bool read(Frame& frame) {
+        for (size_t n = 0; n < frame.num_samples(); n++) {
+            frame.samples()[n] = (sample_t)std::sin(M_PI / 1000 * double(pos_++));
+        }
+        return true;
+    }
+
+private:
+    size_t pos_;
+};
+
+void run_resampler(benchmark::State& state, IResampler& resampler) {
+    const SampleSpec sample_spec(SampleRate, ChMask);
+
+    SineReader input;
+    ResamplerReader reader(input, resampler, sample_spec, sample_spec);
+    roc_panic_if(!reader.valid());
+    roc_panic_if(!reader.set_scaling(Scaling));
+
+    sample_t samples[FrameSize];
+
+    while (state.KeepRunning()) {
+        Frame frame(samples, FrameSize);
+        reader.read(frame);
+    }
+}
+
+void BM_Resampler_Builtin(benchmark::State& state) {
+    const SampleSpec sample_spec(SampleRate, ChMask);
+
+    core::ScopedPtr<IResampler> resampler(
+        ResamplerMap::instance().new_resampler(
+            ResamplerBackend_Builtin, allocator, buffer_factory,
+            (ResamplerProfile)state.range(0), sample_spec.samples_overall_2_ns(FrameSize),
+            sample_spec),
+        allocator);
+    roc_panic_if(!resampler || !resampler->valid());
+
+    run_resampler(state, *resampler);
+}
+
+BENCHMARK(BM_Resampler_Builtin)
+    ->Arg(ResamplerProfile_Low)
+    ->Arg(ResamplerProfile_Medium)
+    ->Arg(ResamplerProfile_High)
+    ->Iterations(NumIterations)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_Resampler_Drift(benchmark::State& state) {
+    const SampleSpec sample_spec(SampleRate, ChMask);
+
+    DriftResampler resampler(allocator, buffer_factory, ResamplerProfile_Medium,
+                             sample_spec.samples_overall_2_ns(FrameSize), sample_spec);
+    roc_panic_if(!resampler.valid());
+
+    run_resampler(state, resampler);
+}
+
+BENCHMARK(BM_Resampler_Drift)->Iterations(NumIterations)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
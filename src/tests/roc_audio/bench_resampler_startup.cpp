@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_map.h"
+#include "roc_audio/sinc_table_cache.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/scoped_ptr.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// Measures construction time of builtin resampler, which is a part of receiver
+// session startup time, and memory occupied by sinc tables.
+//
+// Bench_Unshared  - no other resampler with the same profile exists, so every
+//                   construction computes a new sinc table (this is also what
+//                   every construction costed before tables were shared)
+// Bench_Shared    - another resampler with the same profile exists, so the
+//                   table is taken from cache
+//
+// Output columns:
+//
+// kb_shared    -  sinc table memory for NumSessions resamplers, with sharing
+// kb_unshared  -  sinc table memory for NumSessions resamplers, without sharing
+
+enum { SampleRate = 44100, ChMask = 0x3, FrameSize = 512, NumSessions = 100 };
+
+core::HeapAllocator allocator;
+core::BufferFactory<sample_t> buffer_factory(allocator, FrameSize, true);
+
+IResampler* new_resampler(ResamplerProfile profile) {
+    const SampleSpec sample_spec(SampleRate, ChMask);
+
+    return ResamplerMap::instance().new_resampler(
+        ResamplerBackend_Builtin, allocator, buffer_factory, profile,
+        sample_spec.samples_overall_2_ns(FrameSize), sample_spec);
+}
+
+void report_memory(benchmark::State& state, ResamplerProfile profile) {
+    const size_t base_bytes = SincTableCache::instance().num_bytes();
+
+    core::ScopedPtr<IResampler> resamplers[NumSessions];
+    for (size_t n = 0; n < NumSessions; n++) {
+        resamplers[n].reset(new_resampler(profile), allocator);
+        roc_panic_if(!resamplers[n] || !resamplers[n]->valid());
+    }
+
+    const size_t shared_bytes = SincTableCache::instance().num_bytes() - base_bytes;
+
+    state.counters["kb_shared"] = double(shared_bytes) / 1024;
+    state.counters["kb_unshared"] = double(shared_bytes) * NumSessions / 1024;
+}
+
+void BM_ResamplerStartup_Unshared(benchmark::State& state) {
+    const ResamplerProfile profile = (ResamplerProfile)state.range(0);
+
+    while (state.KeepRunning()) {
+        core::ScopedPtr<IResampler> resampler(new_resampler(profile), allocator);
+        roc_panic_if(!resampler || !resampler->valid());
+    }
+
+    report_memory(state, profile);
+}
+
+BENCHMARK(BM_ResamplerStartup_Unshared)
+    ->Arg(ResamplerProfile_Low)
+    ->Arg(ResamplerProfile_Medium)
+    ->Arg(ResamplerProfile_High)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_ResamplerStartup_Shared(benchmark::State& state) {
+    const ResamplerProfile profile = (ResamplerProfile)state.range(0);
+
+    core::ScopedPtr<IResampler> holder(new_resampler(profile), allocator);
+    roc_panic_if(!holder || !holder->valid());
+
+    while (state.KeepRunning()) {
+        core::ScopedPtr<IResampler> resampler(new_resampler(profile), allocator);
+        roc_panic_if(!resampler || !resampler->valid());
+    }
+
+    holder.reset();
+
+    report_memory(state, profile);
+}
+
+BENCHMARK(BM_ResamplerStartup_Shared)
+    ->Arg(ResamplerProfile_Low)
+    ->Arg(ResamplerProfile_Medium)
+    ->Arg(ResamplerProfile_High)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
@@ -115,7 +115,7 @@ TEST(depacketizer, one_packet_one_read) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     queue.write(new_packet(encoder, 0, 0.11f));
 
@@ -127,7 +127,7 @@ TEST(depacketizer, one_packet_multiple_reads) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     queue.write(new_packet(encoder, 0, 0.11f));
 
@@ -143,7 +143,7 @@ TEST(depacketizer, multiple_packets_one_read) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     for (packet::timestamp_t n = 0; n < NumPackets; n++) {
         queue.write(new_packet(encoder, n * SamplesPerPacket, 0.11f));
@@ -161,7 +161,7 @@ TEST(depacketizer, multiple_packets_multiple_reads) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     queue.write(new_packet(encoder, 1 * SamplesPerPacket, 0.11f));
     queue.write(new_packet(encoder, 2 * SamplesPerPacket, 0.22f));
@@ -185,7 +185,7 @@ TEST(depacketizer, timestamp_overflow) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     const packet::timestamp_t ts2 = 0;
     const packet::timestamp_t ts1 = ts2 - SamplesPerPacket;
@@ -205,7 +205,7 @@ TEST(depacketizer, drop_late_packets) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     const packet::timestamp_t ts1 = SamplesPerPacket * 2;
     const packet::timestamp_t ts2 = SamplesPerPacket * 1;
@@ -224,7 +224,7 @@ TEST(depacketizer, drop_late_packets_timestamp_overflow) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     const packet::timestamp_t ts1 = 0;
     const packet::timestamp_t ts2 = ts1 - SamplesPerPacket;
@@ -243,7 +243,7 @@ TEST(depacketizer, zeros_no_packets) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     expect_output(dp, SamplesPerPacket, 0.00f);
 }
@@ -253,7 +253,7 @@ TEST(depacketizer, zeros_no_next_packet) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     queue.write(new_packet(encoder, 0, 0.11f));
 
@@ -266,7 +266,7 @@ TEST(depacketizer, zeros_between_packets) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     queue.write(new_packet(encoder, 1 * SamplesPerPacket, 0.11f));
     queue.write(new_packet(encoder, 3 * SamplesPerPacket, 0.33f));
@@ -281,7 +281,7 @@ TEST(depacketizer, zeros_between_packets_timestamp_overflow) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     const packet::timestamp_t ts2 = 0;
     const packet::timestamp_t ts1 = ts2 - SamplesPerPacket;
@@ -302,7 +302,7 @@ TEST(depacketizer, zeros_after_packet) {
     CHECK(SamplesPerPacket % 2 == 0);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     queue.write(new_packet(encoder, 0, 0.11f));
 
@@ -326,7 +326,7 @@ TEST(depacketizer, packet_after_zeros) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     expect_output(dp, SamplesPerPacket, 0.00f);
 
@@ -342,7 +342,7 @@ TEST(depacketizer, overlapping_packets) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     packet::timestamp_t ts1 = 0;
     packet::timestamp_t ts2 = SamplesPerPacket / 2;
@@ -364,7 +364,7 @@ TEST(depacketizer, frame_flags_incompltete_blank) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     packet::PacketPtr packets[][PacketsPerFrame] = {
         {
@@ -438,7 +438,7 @@ TEST(depacketizer, frame_flags_drops) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     packet::PacketPtr packets[] = {
         new_packet(encoder, SamplesPerPacket * 4, 0.11f),
@@ -481,7 +481,7 @@ TEST(depacketizer, timestamp) {
     PcmDecoder decoder(PcmFmt, SampleSpecs);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, SampleSpecs, false);
+    Depacketizer dp(queue, decoder, SampleSpecs, false, NULL);
 
     for (size_t n = 0; n < NumPackets * FramesPerPacket; n++) {
         expect_output(dp, SamplesPerFrame, 0.0f);
@@ -516,5 +516,55 @@ TEST(depacketizer, timestamp) {
     }
 }
 
+TEST(depacketizer, status_buffer) {
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    PcmDecoder decoder(PcmFmt, SampleSpecs);
+
+    FrameStatusBuffer status_buffer(allocator);
+    CHECK(status_buffer.reserve(16));
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false, &status_buffer);
+
+    queue.write(new_packet(encoder, 0, 0.11f));
+    queue.write(new_packet(encoder, 2 * SamplesPerPacket, 0.33f));
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+    expect_output(dp, SamplesPerPacket / 2, 0.00f);
+    expect_output(dp, SamplesPerPacket / 2, 0.00f);
+    expect_output(dp, SamplesPerPacket, 0.33f);
+
+    UNSIGNED_LONGS_EQUAL(4, status_buffer.size());
+
+    const unsigned expected_flags[] = {
+        Frame::FlagNonblank,
+        Frame::FlagIncomplete,
+        Frame::FlagIncomplete,
+        Frame::FlagNonblank,
+    };
+    const packet::timestamp_t expected_durations[] = {
+        SamplesPerPacket,
+        SamplesPerPacket / 2,
+        SamplesPerPacket / 2,
+        SamplesPerPacket,
+    };
+
+    for (size_t n = 0; n < 4; n++) {
+        FrameStatus status;
+        CHECK(status_buffer.read(status));
+
+        UNSIGNED_LONGS_EQUAL(expected_flags[n], status.flags);
+        UNSIGNED_LONGS_EQUAL(expected_durations[n], status.duration);
+    }
+
+    FrameStatus status;
+    CHECK(!status_buffer.read(status));
+
+    UNSIGNED_LONGS_EQUAL(4, status_buffer.counters().n_frames);
+    UNSIGNED_LONGS_EQUAL(2, status_buffer.counters().n_blank_frames);
+    UNSIGNED_LONGS_EQUAL(2, status_buffer.counters().n_incomplete_frames);
+    UNSIGNED_LONGS_EQUAL(0, status_buffer.counters().n_drop_frames);
+}
+
 } // namespace audio
 } // namespace roc
@@ -9,16 +9,35 @@
 #include <CppUTest/TestHarness.h>
 
 #include "roc_audio/freq_estimator.h"
+#include "roc_core/macro_helpers.h"
 
 namespace roc {
 namespace audio {
 
 namespace {
 
-enum { Target = 10000 };
+enum { Target = 10000, NumUpdates = 1000 };
 
 const double Epsilon = 0.0001;
 
+// Simulates latency controlled by estimator, when sender clock is faster
+// or slower than receiver clock by given ratio. Returns latency after
+// given number of frames.
+double run_control_loop(FreqEstimator& fe, double sender_ratio, size_t n_frames) {
+    enum { FrameSize = 100 };
+
+    double latency = Target;
+
+    for (size_t n = 0; n < n_frames; n++) {
+        fe.update(packet::timestamp_t(latency));
+        // sender adds samples at its rate, receiver removes samples at the
+        // rate scaled by estimated coefficient
+        latency += FrameSize * (sender_ratio - (double)fe.freq_coeff());
+    }
+
+    return latency;
+}
+
 } // namespace
 
 TEST_GROUP(freq_estimator) {
@@ -57,5 +76,47 @@ TEST(freq_estimator, small_queue_size) {
     } while (fe.freq_coeff() > 0.99f);
 }
 
+TEST(freq_estimator, second_stage_history) {
+    // with decimation_factor2 equal to one, every first stage output is also
+    // a second stage output; second stage filter should still see history
+    fe_config.decimation_factor1 = 2;
+    fe_config.decimation_factor2 = 1;
+
+    FreqEstimator fe(fe_config, Target);
+
+    for (size_t n = 0; n < NumUpdates; n++) {
+        fe.update(Target * 2);
+    }
+
+    CHECK((double)fe.freq_coeff() > 1.0 + Epsilon);
+}
+
+TEST(freq_estimator, control_loop) {
+    enum { NumFrames = 200000 };
+
+    const double ratios[] = { 0.999, 1.001 };
+
+    const size_t factors[][2] = {
+        { fe_decim_factor_max, fe_decim_factor_max },
+        { 2, 1 },
+        { 1, 0 },
+    };
+
+    for (size_t nr = 0; nr < ROC_ARRAY_SIZE(ratios); nr++) {
+        for (size_t nf = 0; nf < ROC_ARRAY_SIZE(factors); nf++) {
+            fe_config.decimation_factor1 = factors[nf][0];
+            fe_config.decimation_factor2 = factors[nf][1];
+
+            FreqEstimator fe(fe_config, Target);
+
+            const double latency = run_control_loop(fe, ratios[nr], NumFrames);
+
+            // latency is kept near target and coefficient follows sender
+            DOUBLES_EQUAL((double)Target, latency, Target * 0.01);
+            CHECK(((double)fe.freq_coeff() - 1.0) * (ratios[nr] - 1.0) > 0);
+        }
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -37,7 +37,7 @@ ProfilerConfig profiler_config(50 * core::Millisecond, 10 * core::Millisecond);
 TEST_GROUP(profiler) {};
 
 TEST(profiler, test_moving_average) {
-    Profiler profiler(allocator, SampleSpecs, profiler_config);
+    Profiler profiler(allocator, SampleSpecs, profiler_config, "test");
 
     TestFrame frames[] = {
         TestFrame(50, 50 * core::Second),      TestFrame(25, 25 * core::Second),
@@ -121,5 +121,111 @@ TEST(profiler, test_moving_average) {
     }
 }
 
+TEST(profiler, histogram_empty) {
+    ProfilerHistogram hist;
+
+    UNSIGNED_LONGS_EQUAL(0, hist.count());
+    LONGS_EQUAL(0, hist.max());
+    LONGS_EQUAL(0, hist.quantile(0.5));
+    LONGS_EQUAL(0, hist.quantile(0.99));
+}
+
+TEST(profiler, histogram_small_values) {
+    ProfilerHistogram hist;
+
+    // values below sub-bucket count are recorded exactly
+    for (core::nanoseconds_t v = 1; v <= 10; v++) {
+        hist.add(v);
+    }
+
+    UNSIGNED_LONGS_EQUAL(10, hist.count());
+    LONGS_EQUAL(10, hist.max());
+
+    LONGS_EQUAL(1, hist.quantile(0));
+    LONGS_EQUAL(5, hist.quantile(0.5));
+    LONGS_EQUAL(9, hist.quantile(0.9));
+    LONGS_EQUAL(10, hist.quantile(1));
+}
+
+TEST(profiler, histogram_precision) {
+    const core::nanoseconds_t values[] = {
+        33,
+        100,
+        999,
+        12345,
+        core::Microsecond * 700,
+        core::Millisecond * 3 + 17,
+        core::Second * 2 + 123456,
+        core::Minute * 10,
+    };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(values); n++) {
+        ProfilerHistogram hist;
+
+        // add smaller value to check that max isn't used as bucket bound
+        hist.add(values[n] / 2);
+        hist.add(values[n]);
+        hist.add(values[n] * 2);
+
+        const core::nanoseconds_t actual = hist.quantile(0.5);
+        const double max_error = (double)values[n] / ProfilerHistogram::SubBuckets;
+
+        CHECK(actual >= values[n]);
+        CHECK((double)(actual - values[n]) <= max_error);
+    }
+}
+
+TEST(profiler, histogram_percentiles) {
+    ProfilerHistogram hist;
+
+    // 1000 fast frames and 10 slow ones
+    for (size_t n = 0; n < 1000; n++) {
+        hist.add(core::Microsecond * 100);
+    }
+    for (size_t n = 0; n < 10; n++) {
+        hist.add(core::Millisecond * 5);
+    }
+
+    UNSIGNED_LONGS_EQUAL(1010, hist.count());
+    LONGS_EQUAL(core::Millisecond * 5, hist.max());
+
+    const double max_error = 1.0 / ProfilerHistogram::SubBuckets;
+
+    DOUBLES_EQUAL(core::Microsecond * 100, hist.quantile(0.5),
+                  core::Microsecond * 100 * max_error);
+    DOUBLES_EQUAL(core::Microsecond * 100, hist.quantile(0.99),
+                  core::Microsecond * 100 * max_error);
+    DOUBLES_EQUAL(core::Millisecond * 5, hist.quantile(0.999),
+                  core::Millisecond * 5 * max_error);
+}
+
+TEST(profiler, histogram_out_of_range) {
+    ProfilerHistogram hist;
+
+    hist.add(-1);
+    hist.add((core::nanoseconds_t)1 << 50);
+
+    UNSIGNED_LONGS_EQUAL(2, hist.count());
+    LONGS_EQUAL(0, hist.quantile(0));
+    LONGS_EQUAL((core::nanoseconds_t)1 << 50, hist.quantile(1));
+
+    hist.clear();
+
+    UNSIGNED_LONGS_EQUAL(0, hist.count());
+    LONGS_EQUAL(0, hist.max());
+}
+
+TEST(profiler, histogram_of_profiler) {
+    Profiler profiler(allocator, SampleSpecs, profiler_config, "test");
+
+    STRCMP_EQUAL("test", profiler.name());
+
+    profiler.add_frame(50, core::Millisecond);
+    profiler.add_frame(50, core::Millisecond * 2);
+
+    UNSIGNED_LONGS_EQUAL(2, profiler.histogram().count());
+    LONGS_EQUAL(core::Millisecond * 2, profiler.histogram().max());
+}
+
 } // namespace audio
 } // namespace roc
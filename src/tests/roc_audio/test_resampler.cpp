@@ -12,9 +12,11 @@
 #include "test_helpers/mock_writer.h"
 
 #include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_drift.h"
 #include "roc_audio/resampler_map.h"
 #include "roc_audio/resampler_reader.h"
 #include "roc_audio/resampler_writer.h"
+#include "roc_audio/sinc_table_cache.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
 #include "roc_core/log.h"
@@ -207,6 +209,11 @@ TEST(resampler, supported_scalings) {
                     const audio::SampleSpec in_sample_specs =
                         SampleSpec(rates[irate], ChMask);
                     for (size_t orate = 0; orate < ROC_ARRAY_SIZE(rates); orate++) {
+                        if (backend == ResamplerBackend_Drift
+                            && rates[irate] != rates[orate]) {
+                            // drift resampler can't convert rates
+                            continue;
+                        }
                         const audio::SampleSpec out_sample_specs =
                             SampleSpec(rates[orate], ChMask);
                         for (size_t sn = 0; sn < ROC_ARRAY_SIZE(scalings); sn++) {
@@ -411,5 +418,157 @@ TEST(resampler, upscale_downscale_stereo) {
     }
 }
 
+TEST(resampler, shared_sinc_table) {
+    enum { SampleRate = 44100, ChMask = 0x1 };
+    const audio::SampleSpec SampleSpecs = SampleSpec(SampleRate, ChMask);
+
+    SincTableCache& cache = SincTableCache::instance();
+
+    const size_t n_tables = cache.num_tables();
+    const size_t n_bytes = cache.num_bytes();
+
+    {
+        core::ScopedPtr<IResampler> resampler1(
+            ResamplerMap::instance().new_resampler(
+                ResamplerBackend_Builtin, allocator, buffer_factory,
+                ResamplerProfile_Medium, SampleSpecs.samples_overall_2_ns(InFrameSize),
+                SampleSpecs),
+            allocator);
+        CHECK(resampler1);
+        CHECK(resampler1->valid());
+
+        UNSIGNED_LONGS_EQUAL(n_tables + 1, cache.num_tables());
+
+        const size_t table_bytes = cache.num_bytes() - n_bytes;
+        CHECK(table_bytes > 0);
+
+        {
+            // same profile, different frame size: table is shared
+            core::ScopedPtr<IResampler> resampler2(
+                ResamplerMap::instance().new_resampler(
+                    ResamplerBackend_Builtin, allocator, buffer_factory,
+                    ResamplerProfile_Medium,
+                    SampleSpecs.samples_overall_2_ns(InFrameSize * 2), SampleSpecs),
+                allocator);
+            CHECK(resampler2);
+            CHECK(resampler2->valid());
+
+            UNSIGNED_LONGS_EQUAL(n_tables + 1, cache.num_tables());
+            UNSIGNED_LONGS_EQUAL(n_bytes + table_bytes, cache.num_bytes());
+
+            // different profile: separate table
+            core::ScopedPtr<IResampler> resampler3(
+                ResamplerMap::instance().new_resampler(
+                    ResamplerBackend_Builtin, allocator, buffer_factory,
+                    ResamplerProfile_High, SampleSpecs.samples_overall_2_ns(InFrameSize),
+                    SampleSpecs),
+                allocator);
+            CHECK(resampler3);
+            CHECK(resampler3->valid());
+
+            UNSIGNED_LONGS_EQUAL(n_tables + 2, cache.num_tables());
+        }
+
+        UNSIGNED_LONGS_EQUAL(n_tables + 1, cache.num_tables());
+        UNSIGNED_LONGS_EQUAL(n_bytes + table_bytes, cache.num_bytes());
+    }
+
+    UNSIGNED_LONGS_EQUAL(n_tables, cache.num_tables());
+    UNSIGNED_LONGS_EQUAL(n_bytes, cache.num_bytes());
+}
+
+TEST(resampler, drift_unit_scaling) {
+    enum { SampleRate = 44100, ChMask = 0x3, NumCh = 2, NumSamples = 20 * InFrameSize };
+    const audio::SampleSpec SampleSpecs = SampleSpec(SampleRate, ChMask);
+
+    DriftResampler resampler(allocator, buffer_factory, ResamplerProfile_Medium,
+                             SampleSpecs.samples_overall_2_ns(InFrameSize * NumCh),
+                             SampleSpecs);
+    CHECK(resampler.valid());
+
+    test::MockReader input_reader;
+    for (size_t n = 0; n < NumSamples * NumCh; n++) {
+        input_reader.add(1, sample_t(n % 1000) / 1000);
+    }
+    input_reader.pad_zeros();
+
+    ResamplerReader rr(input_reader, resampler, SampleSpecs, SampleSpecs);
+    CHECK(rr.valid());
+    CHECK(rr.set_scaling(1.0f));
+
+    sample_t output[(NumSamples - InFrameSize * 2) * NumCh];
+    Frame frame(output, ROC_ARRAY_SIZE(output));
+    CHECK(rr.read(frame));
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(output); n++) {
+        DOUBLES_EQUAL(sample_t(n % 1000) / 1000, output[n], 0.00001);
+    }
+}
+
+TEST(resampler, drift_small_scaling) {
+    enum { SampleRate = 44100, ChMask = 0x1, NumSamples = 100 * InFrameSize };
+    const audio::SampleSpec SampleSpecs = SampleSpec(SampleRate, ChMask);
+
+    const float scalings[] = { 0.99f, 0.999f, 1.0001f, 1.001f, 1.01f };
+    const double Threshold = 0.001;
+
+    for (size_t sn = 0; sn < ROC_ARRAY_SIZE(scalings); sn++) {
+        DriftResampler resampler(allocator, buffer_factory, ResamplerProfile_Medium,
+                                 SampleSpecs.samples_overall_2_ns(InFrameSize),
+                                 SampleSpecs);
+        CHECK(resampler.valid());
+
+        sample_t input[NumSamples];
+        generate_sine(input, NumSamples, 0);
+
+        test::MockReader input_reader;
+        for (size_t n = 0; n < NumSamples; n++) {
+            input_reader.add(1, input[n]);
+        }
+        input_reader.pad_zeros();
+
+        ResamplerReader rr(input_reader, resampler, SampleSpecs, SampleSpecs);
+        CHECK(rr.valid());
+        CHECK(rr.set_scaling(scalings[sn]));
+
+        sample_t output[NumSamples / 2];
+        Frame frame(output, ROC_ARRAY_SIZE(output));
+        CHECK(rr.read(frame));
+
+        // output sample n corresponds to input position n * scaling
+        for (size_t n = 0; n < ROC_ARRAY_SIZE(output); n++) {
+            const double expected =
+                std::sin(M_PI / 10 * (double(n) * (double)scalings[sn])) * 0.8;
+            DOUBLES_EQUAL(expected, output[n], Threshold);
+        }
+    }
+}
+
+TEST(resampler, drift_invalid_scalings) {
+    enum { SampleRate = 44100, ChMask = 0x1 };
+    const audio::SampleSpec SampleSpecs = SampleSpec(SampleRate, ChMask);
+
+    DriftResampler resampler(allocator, buffer_factory, ResamplerProfile_Medium,
+                             SampleSpecs.samples_overall_2_ns(InFrameSize), SampleSpecs);
+    CHECK(resampler.valid());
+
+    CHECK(!resampler.set_scaling(0, SampleRate, 1.0f));
+    CHECK(!resampler.set_scaling(SampleRate, 0, 1.0f));
+
+    CHECK(!resampler.set_scaling(SampleRate, SampleRate, 0.0f));
+    CHECK(!resampler.set_scaling(SampleRate, SampleRate, -0.001f));
+    CHECK(!resampler.set_scaling(SampleRate, SampleRate, 10000000000.0f));
+
+    CHECK(!resampler.set_scaling(SampleRate, SampleRate, 0.8f));
+    CHECK(!resampler.set_scaling(SampleRate, SampleRate, 1.2f));
+
+    CHECK(!resampler.set_scaling(SampleRate, 48000, 1.0f));
+    CHECK(!resampler.set_scaling(48000, SampleRate, 1.0f));
+
+    CHECK(resampler.set_scaling(SampleRate, SampleRate, 1.0f));
+    CHECK(resampler.set_scaling(SampleRate, SampleRate, 0.95f));
+    CHECK(resampler.set_scaling(SampleRate, SampleRate, 1.05f));
+}
+
 } // namespace audio
 } // namespace roc
@@ -9,9 +9,7 @@
 #include <CppUTest/TestHarness.h>
 
 #include "roc_audio/watchdog.h"
-#include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
-#include "roc_core/slice.h"
 
 namespace roc {
 namespace audio {
@@ -19,9 +17,6 @@ namespace audio {
 namespace {
 
 enum {
-    MaxBufSize = 500,
-
-    NumCh = 2,
     ChMask = 0x3,
     SamplesPerFrame = 5,
 
@@ -35,43 +30,10 @@ enum {
 const audio::SampleSpec SampleSpecs = SampleSpec(SampleRate, ChMask);
 
 core::HeapAllocator allocator;
-core::BufferFactory<sample_t> sample_buffer_factory(allocator, MaxBufSize, true);
-
-class TestFrameReader : public IFrameReader, public core::NonCopyable<> {
-public:
-    TestFrameReader()
-        : flags_(0) {
-    }
-
-    void set_flags(unsigned flags) {
-        flags_ = flags;
-    }
-
-    bool read(Frame& frame) {
-        if (flags_) {
-            frame.set_flags(flags_);
-        }
-        for (size_t n = 0; n < frame.num_samples(); n++) {
-            frame.samples()[n] = 42;
-        }
-        return true;
-    }
-
-private:
-    unsigned flags_;
-};
 
 } // namespace
 
 TEST_GROUP(watchdog) {
-    TestFrameReader test_reader;
-
-    core::Slice<sample_t> new_buffer(size_t sz) {
-        core::Slice<sample_t> buf = sample_buffer_factory.new_buffer();
-        buf.reslice(0, sz * NumCh);
-        return buf;
-    }
-
     WatchdogConfig make_config(packet::timestamp_t no_playback_timeout,
                                packet::timestamp_t broken_playback_timeout) {
         WatchdogConfig config;
@@ -79,101 +41,84 @@ TEST_GROUP(watchdog) {
         config.broken_playback_timeout =
             broken_playback_timeout * core::Second / SampleRate;
         config.breakage_detection_window = BreakageWindow * core::Second / SampleRate;
+        config.update_interval = 0;
         return config;
     }
 
-    void check_read(IFrameReader & reader, bool is_read, size_t fsz,
-                    unsigned frame_flags) {
-        core::Slice<sample_t> buf = new_buffer(fsz);
-        memset(buf.data(), 0xff, buf.size() * sizeof(sample_t));
-
-        test_reader.set_flags(frame_flags);
-
-        Frame frame(buf.data(), buf.size());
-        CHECK(reader.read(frame));
-
-        if (is_read) {
-            for (size_t n = 0; n < frame.num_samples(); n++) {
-                DOUBLES_EQUAL(42.0, (double)frame.samples()[n], 0);
-            }
-        } else {
-            for (size_t n = 0; n < frame.num_samples(); n++) {
-                DOUBLES_EQUAL(0.0, (double)frame.samples()[n], 0);
-            }
-        }
+    void add_frame(Watchdog & watchdog, size_t fsz, unsigned frame_flags) {
+        watchdog.status_buffer().add(frame_flags, (packet::timestamp_t)fsz);
     }
 
-    void check_n_reads(IFrameReader & reader, bool is_read, size_t fsz, size_t it_num,
-                       unsigned frame_flags) {
+    void add_n_frames(Watchdog & watchdog, size_t fsz, size_t it_num,
+                      unsigned frame_flags) {
         for (size_t n = 0; n < it_num; n++) {
-            check_read(reader, is_read, fsz, frame_flags);
+            add_frame(watchdog, fsz, frame_flags);
         }
     }
 };
 
 TEST(watchdog, no_playback_timeout_no_frames) {
-    Watchdog watchdog(test_reader, SampleSpecs,
-                      make_config(NoPlaybackTimeout, BrokenPlaybackTimeout), allocator);
+    Watchdog watchdog(SampleSpecs, make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
+                      allocator);
     CHECK(watchdog.valid());
 
     CHECK(watchdog.update());
 }
 
 TEST(watchdog, no_playback_timeout_blank_frames) {
-    Watchdog watchdog(test_reader, SampleSpecs,
-                      make_config(NoPlaybackTimeout, BrokenPlaybackTimeout), allocator);
+    Watchdog watchdog(SampleSpecs, make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
+                      allocator);
     CHECK(watchdog.valid());
 
     for (packet::timestamp_t n = 0; n < NoPlaybackTimeout / SamplesPerFrame; n++) {
         CHECK(watchdog.update());
-        check_read(watchdog, true, SamplesPerFrame, 0);
+        add_frame(watchdog, SamplesPerFrame, 0);
     }
 
     CHECK(!watchdog.update());
-    check_read(watchdog, false, SamplesPerFrame, Frame::FlagNonblank);
+    add_frame(watchdog, SamplesPerFrame, Frame::FlagNonblank);
 }
 
 TEST(watchdog, no_playback_timeout_blank_and_non_blank_frames) {
     CHECK(NoPlaybackTimeout % SamplesPerFrame == 0);
 
-    Watchdog watchdog(test_reader, SampleSpecs,
-                      make_config(NoPlaybackTimeout, BrokenPlaybackTimeout), allocator);
+    Watchdog watchdog(SampleSpecs, make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
+                      allocator);
     CHECK(watchdog.valid());
 
     for (unsigned int i = 0; i < 2; i++) {
         for (packet::timestamp_t n = 0; n < (NoPlaybackTimeout / SamplesPerFrame) - 1;
              n++) {
             CHECK(watchdog.update());
-            check_read(watchdog, true, SamplesPerFrame, 0);
+            add_frame(watchdog, SamplesPerFrame, 0);
         }
 
         CHECK(watchdog.update());
-        check_read(watchdog, true, SamplesPerFrame, Frame::FlagNonblank);
+        add_frame(watchdog, SamplesPerFrame, Frame::FlagNonblank);
     }
 }
 
 TEST(watchdog, no_playback_timeout_disabled) {
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
         for (packet::timestamp_t n = 0; n < NoPlaybackTimeout / SamplesPerFrame; n++) {
             CHECK(watchdog.update());
-            check_read(watchdog, true, SamplesPerFrame, 0);
+            add_frame(watchdog, SamplesPerFrame, 0);
         }
 
         CHECK(!watchdog.update());
     }
     {
-        Watchdog watchdog(test_reader, SampleSpecs, make_config(0, BrokenPlaybackTimeout),
-                          allocator);
+        Watchdog watchdog(SampleSpecs, make_config(0, BrokenPlaybackTimeout), allocator);
         CHECK(watchdog.valid());
 
         for (packet::timestamp_t n = 0; n < NoPlaybackTimeout / SamplesPerFrame; n++) {
             CHECK(watchdog.update());
-            check_read(watchdog, true, SamplesPerFrame, 0);
+            add_frame(watchdog, SamplesPerFrame, 0);
         }
 
         CHECK(watchdog.update());
@@ -182,131 +127,131 @@ TEST(watchdog, no_playback_timeout_disabled) {
 
 TEST(watchdog, broken_playback_timeout_equal_frame_sizes) {
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
-        check_n_reads(watchdog, true, BreakageWindow, BreakageWindowsPerTimeout - 1,
+        add_n_frames(watchdog, BreakageWindow, BreakageWindowsPerTimeout - 1,
                       Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
 
-        check_read(watchdog, true, BreakageWindow, Frame::FlagNonblank);
+        add_frame(watchdog, BreakageWindow, Frame::FlagNonblank);
         CHECK(watchdog.update());
-        check_read(watchdog, true, BreakageWindow, Frame::FlagNonblank);
+        add_frame(watchdog, BreakageWindow, Frame::FlagNonblank);
     }
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
-        check_read(watchdog, true, BreakageWindow, Frame::FlagNonblank);
-        check_n_reads(watchdog, true, BreakageWindow, BreakageWindowsPerTimeout - 2,
+        add_frame(watchdog, BreakageWindow, Frame::FlagNonblank);
+        add_n_frames(watchdog, BreakageWindow, BreakageWindowsPerTimeout - 2,
                       Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
-        check_read(watchdog, true, BreakageWindow, Frame::FlagNonblank);
+        add_frame(watchdog, BreakageWindow, Frame::FlagNonblank);
 
         CHECK(watchdog.update());
-        check_n_reads(watchdog, true, BreakageWindow, BreakageWindowsPerTimeout,
+        add_n_frames(watchdog, BreakageWindow, BreakageWindowsPerTimeout,
                       Frame::FlagNonblank);
     }
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
-        check_read(watchdog, true, BreakageWindow, Frame::FlagNonblank);
-        check_n_reads(watchdog, true, BreakageWindow, BreakageWindowsPerTimeout - 1,
+        add_frame(watchdog, BreakageWindow, Frame::FlagNonblank);
+        add_n_frames(watchdog, BreakageWindow, BreakageWindowsPerTimeout - 1,
                       Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
 
         CHECK(watchdog.update());
 
-        check_read(watchdog, true, BreakageWindow, Frame::FlagNonblank);
+        add_frame(watchdog, BreakageWindow, Frame::FlagNonblank);
     }
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
-        check_n_reads(watchdog, true, BreakageWindow, BreakageWindowsPerTimeout - 1,
+        add_n_frames(watchdog, BreakageWindow, BreakageWindowsPerTimeout - 1,
                       Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
-        check_read(watchdog, true, BreakageWindow,
+        add_frame(watchdog, BreakageWindow,
                    Frame::FlagNonblank | Frame::FlagIncomplete);
 
         CHECK(watchdog.update());
-        check_read(watchdog, true, BreakageWindow, Frame::FlagNonblank);
+        add_frame(watchdog, BreakageWindow, Frame::FlagNonblank);
     }
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
-        check_n_reads(watchdog, true, BreakageWindow, BreakageWindowsPerTimeout - 1,
+        add_n_frames(watchdog, BreakageWindow, BreakageWindowsPerTimeout - 1,
                       Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
-        check_read(watchdog, true, BreakageWindow,
+        add_frame(watchdog, BreakageWindow,
                    Frame::FlagNonblank | Frame::FlagDrops);
 
         CHECK(watchdog.update());
-        check_read(watchdog, true, BreakageWindow, Frame::FlagNonblank);
+        add_frame(watchdog, BreakageWindow, Frame::FlagNonblank);
     }
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
-        check_n_reads(watchdog, true, BreakageWindow, BreakageWindowsPerTimeout - 1,
+        add_n_frames(watchdog, BreakageWindow, BreakageWindowsPerTimeout - 1,
                       Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
-        check_read(watchdog, true, BreakageWindow,
+        add_frame(watchdog, BreakageWindow,
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
 
         CHECK(!watchdog.update());
-        check_read(watchdog, false, BreakageWindow, Frame::FlagNonblank);
+        add_frame(watchdog, BreakageWindow, Frame::FlagNonblank);
     }
 }
 
 TEST(watchdog, broken_playback_timeout_mixed_frame_sizes) {
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
-        check_read(watchdog, true, BreakageWindow * (BreakageWindowsPerTimeout - 1),
+        add_frame(watchdog, BreakageWindow * (BreakageWindowsPerTimeout - 1),
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
-        check_read(watchdog, true, BreakageWindow / 2, Frame::FlagNonblank);
-        check_read(watchdog, true, BreakageWindow - BreakageWindow / 2,
+        add_frame(watchdog, BreakageWindow / 2, Frame::FlagNonblank);
+        add_frame(watchdog, BreakageWindow - BreakageWindow / 2,
                    Frame::FlagNonblank);
 
         CHECK(watchdog.update());
     }
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
-        check_read(watchdog, true, BreakageWindow * (BreakageWindowsPerTimeout - 1),
+        add_frame(watchdog, BreakageWindow * (BreakageWindowsPerTimeout - 1),
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
-        check_read(watchdog, true, BreakageWindow / 2,
+        add_frame(watchdog, BreakageWindow / 2,
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
-        check_read(watchdog, true, BreakageWindow - BreakageWindow / 2,
+        add_frame(watchdog, BreakageWindow - BreakageWindow / 2,
                    Frame::FlagNonblank);
 
         CHECK(!watchdog.update());
     }
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
-        check_read(watchdog, true, BreakageWindow * (BreakageWindowsPerTimeout - 1),
+        add_frame(watchdog, BreakageWindow * (BreakageWindowsPerTimeout - 1),
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
-        check_read(watchdog, true, BreakageWindow / 2, Frame::FlagNonblank);
-        check_read(watchdog, true, BreakageWindow - BreakageWindow / 2,
+        add_frame(watchdog, BreakageWindow / 2, Frame::FlagNonblank);
+        add_frame(watchdog, BreakageWindow - BreakageWindow / 2,
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
 
         CHECK(!watchdog.update());
@@ -314,15 +259,15 @@ TEST(watchdog, broken_playback_timeout_mixed_frame_sizes) {
 }
 
 TEST(watchdog, broken_playback_timeout_constant_drops) {
-    Watchdog watchdog(test_reader, SampleSpecs,
-                      make_config(NoPlaybackTimeout, BrokenPlaybackTimeout), allocator);
+    Watchdog watchdog(SampleSpecs, make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
+                      allocator);
     CHECK(watchdog.valid());
 
     for (packet::timestamp_t n = 0; n < BreakageWindowsPerTimeout; n++) {
         CHECK(watchdog.update());
-        check_read(watchdog, true, BreakageWindow / 2,
+        add_frame(watchdog, BreakageWindow / 2,
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
-        check_read(watchdog, true, BreakageWindow - BreakageWindow / 2,
+        add_frame(watchdog, BreakageWindow - BreakageWindow / 2,
                    Frame::FlagNonblank);
     }
 
@@ -331,75 +276,75 @@ TEST(watchdog, broken_playback_timeout_constant_drops) {
 
 TEST(watchdog, broken_playback_timeout_frame_overlaps_with_breakage_window) {
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
         CHECK(watchdog.update());
 
-        check_read(watchdog, true, BreakageWindow,
+        add_frame(watchdog, BreakageWindow,
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
-        check_read(watchdog, true, BreakageWindow, Frame::FlagNonblank);
-        check_read(watchdog, true, BrokenPlaybackTimeout - BreakageWindow,
+        add_frame(watchdog, BreakageWindow, Frame::FlagNonblank);
+        add_frame(watchdog, BrokenPlaybackTimeout - BreakageWindow,
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
 
         CHECK(watchdog.update());
     }
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
         CHECK(watchdog.update());
 
-        check_read(watchdog, true, BreakageWindow + 1,
+        add_frame(watchdog, BreakageWindow + 1,
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
-        check_read(watchdog, true, BreakageWindow - 1, Frame::FlagNonblank);
-        check_read(watchdog, true, BrokenPlaybackTimeout - BreakageWindow,
+        add_frame(watchdog, BreakageWindow - 1, Frame::FlagNonblank);
+        add_frame(watchdog, BrokenPlaybackTimeout - BreakageWindow,
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
 
         CHECK(!watchdog.update());
     }
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
         CHECK(watchdog.update());
 
-        check_read(watchdog, true, BrokenPlaybackTimeout - BreakageWindow,
+        add_frame(watchdog, BrokenPlaybackTimeout - BreakageWindow,
                    Frame::FlagNonblank);
-        check_read(watchdog, true, BreakageWindow + 1,
+        add_frame(watchdog, BreakageWindow + 1,
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
 
         CHECK(watchdog.update());
 
-        check_read(watchdog, true, BreakageWindow - 1, Frame::FlagNonblank);
-        check_read(watchdog, true, BrokenPlaybackTimeout - BreakageWindow,
+        add_frame(watchdog, BreakageWindow - 1, Frame::FlagNonblank);
+        add_frame(watchdog, BrokenPlaybackTimeout - BreakageWindow,
                    Frame::FlagNonblank);
 
         CHECK(watchdog.update());
     }
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
 
         CHECK(watchdog.update());
 
-        check_read(watchdog, true, BrokenPlaybackTimeout - BreakageWindow,
+        add_frame(watchdog, BrokenPlaybackTimeout - BreakageWindow,
                    Frame::FlagNonblank);
-        check_read(watchdog, true, BreakageWindow + 1,
+        add_frame(watchdog, BreakageWindow + 1,
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
 
         CHECK(watchdog.update());
 
-        check_read(watchdog, true, BreakageWindow - 1, Frame::FlagNonblank);
-        check_read(watchdog, true, BrokenPlaybackTimeout - BreakageWindow,
+        add_frame(watchdog, BreakageWindow - 1, Frame::FlagNonblank);
+        add_frame(watchdog, BrokenPlaybackTimeout - BreakageWindow,
                    Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
 
         CHECK(!watchdog.update());
@@ -408,7 +353,7 @@ TEST(watchdog, broken_playback_timeout_frame_overlaps_with_breakage_window) {
 
 TEST(watchdog, broken_playback_timeout_disabled) {
     {
-        Watchdog watchdog(test_reader, SampleSpecs,
+        Watchdog watchdog(SampleSpecs,
                           make_config(NoPlaybackTimeout, BrokenPlaybackTimeout),
                           allocator);
         CHECK(watchdog.valid());
@@ -416,21 +361,20 @@ TEST(watchdog, broken_playback_timeout_disabled) {
         for (packet::timestamp_t n = 0; n < BrokenPlaybackTimeout / SamplesPerFrame;
              n++) {
             CHECK(watchdog.update());
-            check_read(watchdog, true, SamplesPerFrame,
+            add_frame(watchdog, SamplesPerFrame,
                        Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
         }
 
         CHECK(!watchdog.update());
     }
     {
-        Watchdog watchdog(test_reader, SampleSpecs, make_config(NoPlaybackTimeout, 0),
-                          allocator);
+        Watchdog watchdog(SampleSpecs, make_config(NoPlaybackTimeout, 0), allocator);
         CHECK(watchdog.valid());
 
         for (packet::timestamp_t n = 0; n < BrokenPlaybackTimeout / SamplesPerFrame;
              n++) {
             CHECK(watchdog.update());
-            check_read(watchdog, true, SamplesPerFrame,
+            add_frame(watchdog, SamplesPerFrame,
                        Frame::FlagNonblank | Frame::FlagIncomplete | Frame::FlagDrops);
         }
 
@@ -438,5 +382,90 @@ TEST(watchdog, broken_playback_timeout_disabled) {
     }
 }
 
+TEST(watchdog, counters) {
+    Watchdog watchdog(SampleSpecs, make_config(0, 0), allocator);
+    CHECK(watchdog.valid());
+
+    add_frame(watchdog, SamplesPerFrame, 0);
+    add_frame(watchdog, SamplesPerFrame, Frame::FlagNonblank | Frame::FlagIncomplete);
+    add_frame(watchdog, SamplesPerFrame, Frame::FlagNonblank | Frame::FlagDrops);
+    add_frame(watchdog, SamplesPerFrame, Frame::FlagNonblank);
+
+    CHECK(watchdog.update());
+
+    UNSIGNED_LONGS_EQUAL(4, watchdog.counters().n_frames);
+    UNSIGNED_LONGS_EQUAL(1, watchdog.counters().n_blank_frames);
+    UNSIGNED_LONGS_EQUAL(1, watchdog.counters().n_incomplete_frames);
+    UNSIGNED_LONGS_EQUAL(1, watchdog.counters().n_drop_frames);
+    UNSIGNED_LONGS_EQUAL(0, watchdog.counters().n_merged_statuses);
+}
+
+TEST(watchdog, status_buffer_overrun) {
+    Watchdog watchdog(SampleSpecs, make_config(NoPlaybackTimeout, 0), allocator);
+    CHECK(watchdog.valid());
+
+    // statuses that don't fit are merged, and still counted
+    size_t n_frames = 0;
+    while (watchdog.counters().n_merged_statuses == 0) {
+        add_frame(watchdog, 1, Frame::FlagNonblank);
+        n_frames++;
+    }
+
+    UNSIGNED_LONGS_EQUAL(n_frames, watchdog.counters().n_frames);
+    UNSIGNED_LONGS_EQUAL(n_frames - 1, watchdog.status_buffer().size());
+
+    CHECK(watchdog.update());
+    UNSIGNED_LONGS_EQUAL(0, watchdog.status_buffer().size());
+
+    // buffer is usable again
+    add_n_frames(watchdog, SamplesPerFrame, NoPlaybackTimeout / SamplesPerFrame, 0);
+    CHECK(!watchdog.update());
+}
+
+TEST(watchdog, status_buffer_overrun_duration) {
+    Watchdog watchdog(SampleSpecs, make_config(NoPlaybackTimeout, 0), allocator);
+    CHECK(watchdog.valid());
+
+    // fill buffer with zero-length statuses
+    while (watchdog.counters().n_merged_statuses == 0) {
+        add_frame(watchdog, 0, 0);
+    }
+
+    // statuses that don't fit still contribute their duration
+    add_n_frames(watchdog, SamplesPerFrame, NoPlaybackTimeout / SamplesPerFrame, 0);
+    UNSIGNED_LONGS_EQUAL(NoPlaybackTimeout, watchdog.status_buffer().duration());
+
+    CHECK(!watchdog.update());
+}
+
+TEST(watchdog, update_interval) {
+    enum { FramesPerUpdate = 3 };
+
+    WatchdogConfig config = make_config(NoPlaybackTimeout, 0);
+    config.update_interval =
+        SamplesPerFrame * FramesPerUpdate * core::Second / SampleRate;
+
+    Watchdog watchdog(SampleSpecs, config, allocator);
+    CHECK(watchdog.valid());
+
+    // statuses are processed in batches
+    for (size_t n = 0; n < FramesPerUpdate * 2; n++) {
+        add_frame(watchdog, SamplesPerFrame, Frame::FlagNonblank);
+        CHECK(watchdog.update());
+
+        UNSIGNED_LONGS_EQUAL((n + 1) % FramesPerUpdate,
+                             watchdog.status_buffer().size());
+    }
+
+    // timeout is detected without waiting for batch
+    for (size_t n = 0; n < NoPlaybackTimeout / SamplesPerFrame - 1; n++) {
+        add_frame(watchdog, SamplesPerFrame, 0);
+        CHECK(watchdog.update());
+    }
+
+    add_frame(watchdog, SamplesPerFrame, 0);
+    CHECK(!watchdog.update());
+}
+
 } // namespace audio
 } // namespace roc
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/arena_allocator.h"
+#include "roc_core/buffer.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+namespace {
+
+// Compares packet buffer pools backed by heap and by arena.
+//
+// Bench_FirstFrame  - cost of allocating and filling a burst of buffers from
+//                     a fresh pool, as happens when the first frames arrive;
+//                     dominated by slab growth and page faults
+// Bench_PacketPath  - cost of touching headers of buffers from a large pool
+//                     in random order, as packets are routed through queues;
+//                     dominated by cache and TLB misses, so the difference
+//                     between regular and huge pages shows TLB effect
+//
+// Argument is allocator mode:
+//  0 - heap
+//  1 - arena, pre-faulted
+//  2 - arena, pre-faulted, huge pages
+
+enum {
+    BufferSize = 2048,
+
+    // buffers in first frames burst
+    NumFirstBuffers = 512,
+
+    // buffers in pool for packet path, ~32MB total
+    NumPathBuffers = 16384,
+
+    // buffers touched per iteration of packet path
+    PathBatch = 64,
+
+    ArenaSize = 64 * 1024 * 1024
+};
+
+enum Mode { ModeHeap, ModeArena, ModeArenaHuge };
+
+ArenaConfig make_config(int mode) {
+    ArenaConfig config;
+    if (mode != ModeHeap) {
+        config.size = ArenaSize;
+        config.huge_pages = (mode == ModeArenaHuge);
+        config.prefault = true;
+    }
+    return config;
+}
+
+typedef SharedPtr<Buffer<uint8_t> > BufferPtr;
+
+void BM_Arena_FirstFrame(benchmark::State& state) {
+    HeapAllocator heap;
+    ArenaAllocator arena(heap, make_config((int)state.range(0)));
+
+    BufferPtr* buffers = new BufferPtr[NumFirstBuffers];
+
+    while (state.KeepRunning()) {
+        {
+            BufferFactory<uint8_t> factory(arena, BufferSize, false);
+
+            for (size_t n = 0; n < NumFirstBuffers; n++) {
+                buffers[n] = factory.new_buffer();
+                roc_panic_if(!buffers[n]);
+
+                memset(buffers[n]->data(), (int)n, BufferSize);
+            }
+
+            state.PauseTiming();
+
+            for (size_t n = 0; n < NumFirstBuffers; n++) {
+                buffers[n] = NULL;
+            }
+        }
+
+        state.ResumeTiming();
+    }
+
+    delete[] buffers;
+}
+
+BENCHMARK(BM_Arena_FirstFrame)
+    ->Arg(ModeHeap)
+    ->Arg(ModeArena)
+    ->Arg(ModeArenaHuge)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_Arena_PacketPath(benchmark::State& state) {
+    HeapAllocator heap;
+    ArenaAllocator arena(heap, make_config((int)state.range(0)));
+
+    {
+        BufferFactory<uint8_t> factory(arena, BufferSize, false);
+
+        BufferPtr* buffers = new BufferPtr[NumPathBuffers];
+        for (size_t n = 0; n < NumPathBuffers; n++) {
+            buffers[n] = factory.new_buffer();
+            roc_panic_if(!buffers[n]);
+
+            memset(buffers[n]->data(), 0, BufferSize);
+        }
+
+        size_t* order = new size_t[NumPathBuffers];
+        for (size_t n = 0; n < NumPathBuffers; n++) {
+            order[n] = n;
+        }
+        for (size_t n = NumPathBuffers - 1; n > 0; n--) {
+            const size_t k = (size_t)fast_random(0, (uint32_t)n);
+            std::swap(order[n], order[k]);
+        }
+
+        size_t pos = 0;
+        unsigned sum = 0;
+
+        while (state.KeepRunning()) {
+            for (size_t n = 0; n < PathBatch; n++) {
+                uint8_t* data = buffers[order[pos]]->data();
+                sum += data[0];
+                data[1] = (uint8_t)sum;
+
+                pos = (pos + 1) % NumPathBuffers;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * PathBatch);
+
+        delete[] order;
+        for (size_t n = 0; n < NumPathBuffers; n++) {
+            buffers[n] = NULL;
+        }
+        delete[] buffers;
+    }
+}
+
+BENCHMARK(BM_Arena_PacketPath)
+    ->Arg(ModeHeap)
+    ->Arg(ModeArena)
+    ->Arg(ModeArenaHuge)
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace core
+} // namespace roc
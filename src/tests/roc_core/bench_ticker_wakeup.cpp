@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/ticker.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+namespace {
+
+// Measures wakeup latency of Ticker::wait(), i.e. how late the thread returns
+// from wait() compared to the requested deadline, as pipeline thread does
+// before every frame when timing is enabled.
+//
+// Argument is spin budget in microseconds; zero means sleep-only mode.
+//
+// Reported counters are in microseconds:
+//  avg, p50, p99  - average and percentiles of wakeup latency
+//  max            - maximum wakeup latency
+
+enum {
+    // 1 tick = 1 microsecond
+    TickFreq = 1000000,
+
+    // wait period, like a 1ms frame
+    PeriodTicks = 1000,
+
+    // latency histogram, 1us buckets
+    NumBuckets = 2000
+};
+
+class LatencyHistogram {
+public:
+    LatencyHistogram()
+        : count_(0)
+        , total_(0)
+        , max_(0) {
+        for (size_t n = 0; n < NumBuckets; n++) {
+            buckets_[n] = 0;
+        }
+    }
+
+    void add(nanoseconds_t latency) {
+        size_t bucket = size_t(latency / Microsecond);
+        if (bucket >= NumBuckets) {
+            bucket = NumBuckets - 1;
+        }
+
+        buckets_[bucket]++;
+        count_++;
+        total_ += latency;
+
+        if (latency > max_) {
+            max_ = latency;
+        }
+    }
+
+    double avg() const {
+        return count_ ? double(total_) / count_ / Microsecond : 0;
+    }
+
+    double percentile(double p) const {
+        size_t sum = 0;
+        for (size_t n = 0; n < NumBuckets; n++) {
+            sum += buckets_[n];
+            if (double(sum) >= p * count_) {
+                return double(n + 1);
+            }
+        }
+        return double(NumBuckets);
+    }
+
+    double max() const {
+        return double(max_) / Microsecond;
+    }
+
+private:
+    size_t buckets_[NumBuckets];
+    size_t count_;
+    nanoseconds_t total_;
+    nanoseconds_t max_;
+};
+
+void BM_Ticker_WakeupLatency(benchmark::State& state) {
+    const nanoseconds_t spin_budget = nanoseconds_t(state.range(0)) * Microsecond;
+
+    Ticker ticker(TickFreq);
+    ticker.set_spin_budget(spin_budget);
+    ticker.start();
+
+    const nanoseconds_t start = timestamp(ClockMonotonic);
+
+    LatencyHistogram hist;
+    Ticker::ticks_t ticks = 0;
+
+    while (state.KeepRunning()) {
+        ticks += PeriodTicks;
+        ticker.wait(ticks);
+
+        const nanoseconds_t deadline = start + nanoseconds_t(ticks) * Microsecond;
+        const nanoseconds_t now = timestamp(ClockMonotonic);
+
+        hist.add(now > deadline ? now - deadline : 0);
+    }
+
+    state.counters["avg"] = hist.avg();
+    state.counters["p50"] = hist.percentile(0.50);
+    state.counters["p99"] = hist.percentile(0.99);
+    state.counters["max"] = hist.max();
+}
+
+BENCHMARK(BM_Ticker_WakeupLatency)
+    ->Arg(0)
+    ->Arg(50)
+    ->Arg(200)
+    ->Iterations(2000)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace core
+} // namespace roc
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/align_ops.h"
+#include "roc_core/arena_allocator.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/slab_pool.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { ArenaSize = 64 * 1024 };
+
+ArenaConfig make_config(size_t size) {
+    ArenaConfig config;
+    config.size = size;
+    return config;
+}
+
+} // namespace
+
+TEST_GROUP(arena_allocator) {};
+
+TEST(arena_allocator, disabled) {
+    HeapAllocator heap;
+
+    {
+        ArenaAllocator arena(heap, ArenaConfig());
+
+        UNSIGNED_LONGS_EQUAL(0, arena.size());
+
+        void* memory = arena.allocate(100);
+        CHECK(memory);
+
+        UNSIGNED_LONGS_EQUAL(1, heap.num_allocations());
+        UNSIGNED_LONGS_EQUAL(1, arena.num_fallbacks());
+        UNSIGNED_LONGS_EQUAL(0, arena.used_size());
+
+        arena.deallocate(memory);
+
+        UNSIGNED_LONGS_EQUAL(0, heap.num_allocations());
+    }
+}
+
+TEST(arena_allocator, allocate) {
+    HeapAllocator heap;
+
+    {
+        ArenaAllocator arena(heap, make_config(ArenaSize));
+
+        CHECK(arena.size() >= ArenaSize);
+
+        char* a = (char*)arena.allocate(100);
+        char* b = (char*)arena.allocate(1);
+        char* c = (char*)arena.allocate(1000);
+
+        CHECK(a && b && c);
+        CHECK(a != b && b != c);
+
+        memset(a, 1, 100);
+        memset(b, 2, 1);
+        memset(c, 3, 1000);
+
+        UNSIGNED_LONGS_EQUAL(0, (size_t)a % AlignOps::max_alignment());
+        UNSIGNED_LONGS_EQUAL(0, (size_t)b % AlignOps::max_alignment());
+        UNSIGNED_LONGS_EQUAL(0, (size_t)c % AlignOps::max_alignment());
+
+        CHECK(arena.used_size() >= 1101);
+
+        UNSIGNED_LONGS_EQUAL(0, heap.num_allocations());
+        UNSIGNED_LONGS_EQUAL(0, arena.num_fallbacks());
+
+        CHECK(a[99] == 1);
+        CHECK(b[0] == 2);
+        CHECK(c[999] == 3);
+
+        arena.deallocate(b);
+        arena.deallocate(a);
+        arena.deallocate(c);
+
+        UNSIGNED_LONGS_EQUAL(0, arena.used_size());
+    }
+}
+
+TEST(arena_allocator, reclaim_last) {
+    HeapAllocator heap;
+
+    {
+        ArenaAllocator arena(heap, make_config(ArenaSize));
+
+        void* a = arena.allocate(100);
+        const size_t used_a = arena.used_size();
+
+        void* b = arena.allocate(100);
+        CHECK(arena.used_size() > used_a);
+
+        // last block is reclaimed immediately
+        arena.deallocate(b);
+        UNSIGNED_LONGS_EQUAL(used_a, arena.used_size());
+
+        void* c = arena.allocate(100);
+        CHECK(c == b);
+
+        // non-last block is reclaimed only with all other blocks
+        arena.deallocate(a);
+        CHECK(arena.used_size() > used_a);
+
+        arena.deallocate(c);
+        UNSIGNED_LONGS_EQUAL(0, arena.used_size());
+    }
+}
+
+TEST(arena_allocator, exhausted) {
+    HeapAllocator heap;
+
+    {
+        ArenaAllocator arena(heap, make_config(ArenaSize));
+
+        void* a = arena.allocate(arena.size() / 2);
+        CHECK(a);
+        UNSIGNED_LONGS_EQUAL(0, heap.num_allocations());
+
+        void* b = arena.allocate(arena.size());
+        CHECK(b);
+        UNSIGNED_LONGS_EQUAL(1, heap.num_allocations());
+        UNSIGNED_LONGS_EQUAL(1, arena.num_fallbacks());
+
+        arena.deallocate(b);
+        UNSIGNED_LONGS_EQUAL(0, heap.num_allocations());
+
+        arena.deallocate(a);
+        UNSIGNED_LONGS_EQUAL(0, arena.used_size());
+    }
+}
+
+TEST(arena_allocator, huge_pages_and_lock) {
+    HeapAllocator heap;
+
+    ArenaConfig config = make_config(ArenaSize);
+    config.huge_pages = true;
+    config.lock = true;
+
+    {
+        // huge pages and locking may be unavailable, but arena should work
+        ArenaAllocator arena(heap, config);
+
+        CHECK(arena.size() >= ArenaSize);
+
+        char* memory = (char*)arena.allocate(ArenaSize / 2);
+        CHECK(memory);
+        memset(memory, 0, ArenaSize / 2);
+
+        UNSIGNED_LONGS_EQUAL(0, heap.num_allocations());
+
+        arena.deallocate(memory);
+    }
+}
+
+TEST(arena_allocator, slab_pool) {
+    HeapAllocator heap;
+    ArenaAllocator arena(heap, make_config(ArenaSize));
+
+    {
+        SlabPool pool(arena, 256, false);
+
+        void* objects[100];
+        for (size_t n = 0; n < 100; n++) {
+            objects[n] = pool.allocate();
+            CHECK(objects[n]);
+        }
+
+        CHECK(arena.used_size() >= 100 * 256);
+        UNSIGNED_LONGS_EQUAL(0, heap.num_allocations());
+
+        for (size_t n = 0; n < 100; n++) {
+            pool.deallocate(objects[n]);
+        }
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, arena.used_size());
+}
+
+} // namespace core
+} // namespace roc
@@ -67,6 +67,18 @@ TEST(list_operations, push_back_iterate) {
     }
 }
 
+TEST(list_operations, push_back_iterate_backward) {
+    for (size_t i = 0; i < NumObjects; ++i) {
+        list.push_back(objects[i]);
+    }
+
+    int i = NumObjects - 1;
+    for (Object* obj = list.back(); obj != NULL; obj = list.prevof(*obj)) {
+        POINTERS_EQUAL(&objects[i--], obj);
+    }
+    LONGS_EQUAL(-1, i);
+}
+
 TEST(list_operations, push_front_one) {
     list.push_front(objects[0]);
 
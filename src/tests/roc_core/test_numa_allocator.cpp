@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/numa_allocator.h"
+#include "roc_core/slab_pool.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// Larger than a page, so that binding is actually attempted.
+enum { BigSize = 1 << 20 };
+
+void check_allocate(NumaAllocator& allocator, size_t size) {
+    char* memory = (char*)allocator.allocate(size);
+    CHECK(memory);
+
+    memory[0] = 1;
+    memory[size - 1] = 2;
+
+    allocator.deallocate(memory);
+}
+
+} // namespace
+
+TEST_GROUP(numa_allocator) {};
+
+TEST(numa_allocator, no_node) {
+    HeapAllocator heap;
+    NumaAllocator numa(heap, -1);
+
+    LONGS_EQUAL(-1, numa.node());
+
+    check_allocate(numa, 16);
+    check_allocate(numa, BigSize);
+
+    LONGS_EQUAL(0, heap.num_allocations());
+}
+
+TEST(numa_allocator, node_0) {
+    HeapAllocator heap;
+    NumaAllocator numa(heap, 0);
+
+    LONGS_EQUAL(0, numa.node());
+
+    // binding may be not supported on this platform, but allocation
+    // should succeed anyway
+    check_allocate(numa, 16);
+    check_allocate(numa, BigSize);
+
+    LONGS_EQUAL(0, heap.num_allocations());
+}
+
+TEST(numa_allocator, invalid_node) {
+    HeapAllocator heap;
+    NumaAllocator numa(heap, 100000);
+
+    check_allocate(numa, BigSize);
+
+    LONGS_EQUAL(0, heap.num_allocations());
+}
+
+TEST(numa_allocator, slab_pool) {
+    HeapAllocator heap;
+    NumaAllocator numa(heap, 0);
+
+    {
+        SlabPool pool(numa, 256, false);
+
+        void* objects[1000];
+        for (size_t n = 0; n < 1000; n++) {
+            objects[n] = pool.allocate();
+            CHECK(objects[n]);
+        }
+
+        CHECK(heap.num_allocations() > 0);
+
+        for (size_t n = 0; n < 1000; n++) {
+            pool.deallocate(objects[n]);
+        }
+    }
+
+    LONGS_EQUAL(0, heap.num_allocations());
+}
+
+} // namespace core
+} // namespace roc
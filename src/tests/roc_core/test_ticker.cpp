@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/ticker.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// 1 tick = 1 microsecond
+const Ticker::ticks_t TickFreq = 1000000;
+
+} // namespace
+
+TEST_GROUP(ticker) {};
+
+TEST(ticker, wait) {
+    Ticker ticker(TickFreq);
+    ticker.start();
+
+    const nanoseconds_t start = timestamp(ClockMonotonic);
+
+    ticker.wait(1000);
+
+    CHECK(timestamp(ClockMonotonic) - start >= Millisecond - Microsecond);
+    CHECK(ticker.elapsed() >= 1000);
+}
+
+TEST(ticker, wait_spin) {
+    Ticker ticker(TickFreq);
+    ticker.set_spin_budget(500 * Microsecond);
+    ticker.start();
+
+    for (Ticker::ticks_t ticks = 200; ticks <= 2000; ticks += 200) {
+        ticker.wait(ticks);
+
+        CHECK(ticker.elapsed() >= ticks);
+    }
+}
+
+TEST(ticker, wait_spin_larger_than_interval) {
+    Ticker ticker(TickFreq);
+    ticker.set_spin_budget(10 * Millisecond);
+    ticker.start();
+
+    ticker.wait(1000);
+
+    CHECK(ticker.elapsed() >= 1000);
+}
+
+TEST(ticker, wait_past) {
+    Ticker ticker(TickFreq);
+    ticker.set_spin_budget(Millisecond);
+    ticker.start();
+
+    sleep_for(ClockMonotonic, Millisecond);
+
+    const nanoseconds_t start = timestamp(ClockMonotonic);
+
+    ticker.wait(0);
+
+    CHECK(timestamp(ClockMonotonic) - start < Millisecond);
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_fec/codec_map.h"
+
+namespace roc {
+namespace fec {
+namespace {
+
+// Measures per-block cost of FEC block encoder and decoder, including
+// codec setup done in begin() and teardown done in end().
+//
+// Bench_Encode        - begin(), set() all packets, fill(), end()
+// Bench_Decode        - begin(), set() all packets except one, repair()
+//                       all source packets, end()
+//
+// Bench_*_Constant    - every block has the same size
+// Bench_*_Alternating - block size alternates between two values, like
+//                       when sender adapts block size on the fly
+//
+// First argument is FEC scheme index in codec map, second is codec backend;
+// schemes and backends that are not enabled in build are skipped.
+
+enum {
+    PayloadSize = 256,
+    MaxPayloadSize = 1024,
+    MaxPackets = 30,
+    LostPacket = 3
+};
+
+const size_t SourceSizes[2] = { 20, 18 };
+const size_t RepairSizes[2] = { 10, 9 };
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, MaxPayloadSize, true);
+
+bool make_config(benchmark::State& state, CodecConfig& config) {
+    if ((size_t)state.range(0) >= CodecMap::instance().num_schemes()) {
+        state.SkipWithError("scheme not enabled");
+        return false;
+    }
+    config.scheme = CodecMap::instance().nth_scheme((size_t)state.range(0));
+    config.backend = (CodecBackend)state.range(1);
+    if (!CodecMap::instance().is_supported(config.scheme, config.backend)) {
+        state.SkipWithError("backend not enabled");
+        return false;
+    }
+    return true;
+}
+
+void make_buffers(core::Slice<uint8_t>* buffers) {
+    for (size_t i = 0; i < MaxPackets; i++) {
+        buffers[i] = buffer_factory.new_buffer();
+        roc_panic_if(!buffers[i]);
+
+        buffers[i].reslice(0, PayloadSize);
+        for (size_t j = 0; j < PayloadSize; j++) {
+            buffers[i].data()[j] = uint8_t(i + j);
+        }
+    }
+}
+
+void encode_block(IBlockEncoder& encoder,
+                  core::Slice<uint8_t>* buffers,
+                  size_t n_source,
+                  size_t n_repair) {
+    if (!encoder.begin(n_source, n_repair, PayloadSize)) {
+        roc_panic("bench: encoder begin() failed");
+    }
+
+    for (size_t i = 0; i < n_source + n_repair; i++) {
+        encoder.set(i, buffers[i]);
+    }
+
+    encoder.fill();
+    encoder.end();
+}
+
+void decode_block(IBlockDecoder& decoder,
+                  core::Slice<uint8_t>* buffers,
+                  size_t n_source,
+                  size_t n_repair) {
+    if (!decoder.begin(n_source, n_repair, PayloadSize)) {
+        roc_panic("bench: decoder begin() failed");
+    }
+
+    for (size_t i = 0; i < n_source + n_repair; i++) {
+        if (i != LostPacket) {
+            decoder.set(i, buffers[i]);
+        }
+    }
+
+    for (size_t i = 0; i < n_source; i++) {
+        benchmark::DoNotOptimize(decoder.repair(i));
+    }
+
+    decoder.end();
+}
+
+void run_encode(benchmark::State& state, size_t n_sizes) {
+    CodecConfig config;
+    if (!make_config(state, config)) {
+        return;
+    }
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(config, buffer_factory, allocator), allocator);
+    roc_panic_if(!encoder);
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    make_buffers(buffers);
+
+    size_t n_block = 0;
+
+    while (state.KeepRunning()) {
+        const size_t n_size = n_block++ % n_sizes;
+        encode_block(*encoder, buffers, SourceSizes[n_size], RepairSizes[n_size]);
+    }
+}
+
+void run_decode(benchmark::State& state, size_t n_sizes) {
+    CodecConfig config;
+    if (!make_config(state, config)) {
+        return;
+    }
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(config, buffer_factory, allocator), allocator);
+    roc_panic_if(!encoder);
+
+    core::ScopedPtr<IBlockDecoder> decoder(
+        CodecMap::instance().new_decoder(config, buffer_factory, allocator), allocator);
+    roc_panic_if(!decoder);
+
+    // repair packets differ for every block size
+    core::Slice<uint8_t> buffers[2][MaxPackets];
+    for (size_t n_size = 0; n_size < n_sizes; n_size++) {
+        make_buffers(buffers[n_size]);
+        encode_block(*encoder, buffers[n_size], SourceSizes[n_size],
+                     RepairSizes[n_size]);
+    }
+
+    size_t n_block = 0;
+
+    while (state.KeepRunning()) {
+        const size_t n_size = n_block++ % n_sizes;
+        decode_block(*decoder, buffers[n_size], SourceSizes[n_size],
+                     RepairSizes[n_size]);
+    }
+}
+
+void BM_BlockCodec_Encode_Constant(benchmark::State& state) {
+    run_encode(state, 1);
+}
+
+BENCHMARK(BM_BlockCodec_Encode_Constant)
+    ->ArgPair(0, CodecBackend_Builtin)
+    ->ArgPair(0, CodecBackend_OpenFEC)
+    ->ArgPair(1, CodecBackend_Builtin)
+    ->ArgPair(1, CodecBackend_OpenFEC)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_BlockCodec_Encode_Alternating(benchmark::State& state) {
+    run_encode(state, 2);
+}
+
+BENCHMARK(BM_BlockCodec_Encode_Alternating)
+    ->ArgPair(0, CodecBackend_Builtin)
+    ->ArgPair(0, CodecBackend_OpenFEC)
+    ->ArgPair(1, CodecBackend_Builtin)
+    ->ArgPair(1, CodecBackend_OpenFEC)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_BlockCodec_Decode_Constant(benchmark::State& state) {
+    run_decode(state, 1);
+}
+
+BENCHMARK(BM_BlockCodec_Decode_Constant)
+    ->ArgPair(0, CodecBackend_Builtin)
+    ->ArgPair(0, CodecBackend_OpenFEC)
+    ->ArgPair(1, CodecBackend_Builtin)
+    ->ArgPair(1, CodecBackend_OpenFEC)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_BlockCodec_Decode_Alternating(benchmark::State& state) {
+    run_decode(state, 2);
+}
+
+BENCHMARK(BM_BlockCodec_Decode_Alternating)
+    ->ArgPair(0, CodecBackend_Builtin)
+    ->ArgPair(0, CodecBackend_OpenFEC)
+    ->ArgPair(1, CodecBackend_Builtin)
+    ->ArgPair(1, CodecBackend_OpenFEC)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_fec/codec_map.h"
+
+namespace roc {
+namespace fec {
+namespace {
+
+// Compares native LDPC-Staircase codec with OpenFEC implementation of the
+// same scheme. Both produce identical repair packets. Codecs are selected
+// via CodecMap using backend from codec config.
+//
+// Bench_Encode_*  - begin(), set() all packets, fill(), end()
+// Bench_Decode_*  - begin(), set() all packets except every tenth source
+//                   packet, repair() all source packets, end()
+//
+// Argument is number of source packets in block; number of repair packets
+// is half of it. Payload size is typical for 5ms of stereo 16-bit audio.
+
+enum { PayloadSize = 880, MaxPayloadSize = 1024, MaxPackets = 300 };
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, MaxPayloadSize, true);
+
+CodecConfig make_config(CodecBackend backend) {
+    CodecConfig config;
+    config.scheme = packet::FEC_LDPC_Staircase;
+    config.backend = backend;
+    return config;
+}
+
+void make_buffers(core::Slice<uint8_t>* buffers, size_t n_packets) {
+    for (size_t i = 0; i < n_packets; i++) {
+        buffers[i] = buffer_factory.new_buffer();
+        roc_panic_if(!buffers[i]);
+
+        buffers[i].reslice(0, PayloadSize);
+        for (size_t j = 0; j < PayloadSize; j++) {
+            buffers[i].data()[j] = uint8_t(i * 3 + j);
+        }
+    }
+}
+
+void encode_block(IBlockEncoder& encoder,
+                  core::Slice<uint8_t>* buffers,
+                  size_t n_source,
+                  size_t n_repair) {
+    if (!encoder.begin(n_source, n_repair, PayloadSize)) {
+        roc_panic("bench: encoder begin() failed");
+    }
+
+    for (size_t i = 0; i < n_source + n_repair; i++) {
+        encoder.set(i, buffers[i]);
+    }
+
+    encoder.fill();
+    encoder.end();
+}
+
+void decode_block(IBlockDecoder& decoder,
+                  core::Slice<uint8_t>* buffers,
+                  size_t n_source,
+                  size_t n_repair) {
+    if (!decoder.begin(n_source, n_repair, PayloadSize)) {
+        roc_panic("bench: decoder begin() failed");
+    }
+
+    for (size_t i = 0; i < n_source + n_repair; i++) {
+        if (i >= n_source || i % 10 != 0) {
+            decoder.set(i, buffers[i]);
+        }
+    }
+
+    for (size_t i = 0; i < n_source; i++) {
+        benchmark::DoNotOptimize(decoder.repair(i));
+    }
+
+    decoder.end();
+}
+
+void run_encode(benchmark::State& state, CodecBackend backend) {
+    const size_t n_source = (size_t)state.range(0);
+    const size_t n_repair = n_source / 2;
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(make_config(backend), buffer_factory,
+                                         allocator),
+        allocator);
+    roc_panic_if(!encoder);
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    make_buffers(buffers, n_source + n_repair);
+
+    while (state.KeepRunning()) {
+        encode_block(*encoder, buffers, n_source, n_repair);
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(n_source)
+                            * PayloadSize);
+}
+
+void run_decode(benchmark::State& state, CodecBackend backend) {
+    const size_t n_source = (size_t)state.range(0);
+    const size_t n_repair = n_source / 2;
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(make_config(CodecBackend_Builtin),
+                                         buffer_factory, allocator),
+        allocator);
+    roc_panic_if(!encoder);
+
+    core::ScopedPtr<IBlockDecoder> decoder(
+        CodecMap::instance().new_decoder(make_config(backend), buffer_factory,
+                                         allocator),
+        allocator);
+    roc_panic_if(!decoder);
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    make_buffers(buffers, n_source + n_repair);
+    encode_block(*encoder, buffers, n_source, n_repair);
+
+    while (state.KeepRunning()) {
+        decode_block(*decoder, buffers, n_source, n_repair);
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(n_source)
+                            * PayloadSize);
+}
+
+void BM_LdpcStaircase_Encode_Native(benchmark::State& state) {
+    run_encode(state, CodecBackend_Builtin);
+}
+
+BENCHMARK(BM_LdpcStaircase_Encode_Native)
+    ->Arg(20)
+    ->Arg(100)
+    ->Arg(200)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_LdpcStaircase_Encode_Openfec(benchmark::State& state) {
+    run_encode(state, CodecBackend_OpenFEC);
+}
+
+BENCHMARK(BM_LdpcStaircase_Encode_Openfec)
+    ->Arg(20)
+    ->Arg(100)
+    ->Arg(200)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_LdpcStaircase_Decode_Native(benchmark::State& state) {
+    run_decode(state, CodecBackend_Builtin);
+}
+
+BENCHMARK(BM_LdpcStaircase_Decode_Native)
+    ->Arg(20)
+    ->Arg(100)
+    ->Arg(200)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_LdpcStaircase_Decode_Openfec(benchmark::State& state) {
+    run_decode(state, CodecBackend_OpenFEC);
+}
+
+BENCHMARK(BM_LdpcStaircase_Decode_Openfec)
+    ->Arg(20)
+    ->Arg(100)
+    ->Arg(200)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace fec
+} // namespace roc
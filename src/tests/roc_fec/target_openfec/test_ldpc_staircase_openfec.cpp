@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_factory.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_fec/ldpc_staircase_decoder.h"
+#include "roc_fec/ldpc_staircase_encoder.h"
+#include "roc_fec/openfec_decoder.h"
+#include "roc_fec/openfec_encoder.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxPackets = 200, MaxPayloadSize = 512, PayloadSize = 168 };
+
+const size_t NumSizes = 5;
+const size_t SourceSizes[NumSizes] = { 20, 18, 4, 100, 7 };
+const size_t RepairSizes[NumSizes] = { 10, 9, 3, 60, 40 };
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, MaxPayloadSize, true);
+
+CodecConfig make_config() {
+    CodecConfig config;
+    config.scheme = packet::FEC_LDPC_Staircase;
+    return config;
+}
+
+void encode(IBlockEncoder& encoder,
+            core::Slice<uint8_t>* buffers,
+            size_t n_source,
+            size_t n_repair,
+            bool fill_source) {
+    CHECK(encoder.begin(n_source, n_repair, PayloadSize));
+
+    for (size_t i = 0; i < n_source + n_repair; i++) {
+        if (i >= n_source || fill_source) {
+            buffers[i] = buffer_factory.new_buffer();
+            CHECK(buffers[i]);
+            buffers[i].reslice(0, PayloadSize);
+
+            for (size_t j = 0; j < PayloadSize; j++) {
+                buffers[i].data()[j] =
+                    i < n_source ? (uint8_t)core::fast_random(0, 0xff) : 0;
+            }
+        }
+
+        encoder.set(i, buffers[i]);
+    }
+
+    encoder.fill();
+    encoder.end();
+}
+
+void decode(IBlockDecoder& decoder,
+            const core::Slice<uint8_t>* buffers,
+            size_t n_source,
+            size_t n_repair) {
+    CHECK(decoder.begin(n_source, n_repair, PayloadSize));
+
+    // lose every seventh source packet
+    for (size_t i = 0; i < n_source + n_repair; i++) {
+        if (i >= n_source || i % 7 != 0) {
+            decoder.set(i, buffers[i]);
+        }
+    }
+
+    for (size_t i = 0; i < n_source; i++) {
+        core::Slice<uint8_t> buffer = decoder.repair(i);
+        CHECK(buffer);
+        CHECK(memcmp(buffer.data(), buffers[i].data(), PayloadSize) == 0);
+    }
+
+    decoder.end();
+}
+
+} // namespace
+
+TEST_GROUP(ldpc_staircase_openfec) {};
+
+TEST(ldpc_staircase_openfec, same_repair_packets) {
+    const CodecConfig config = make_config();
+
+    OpenfecEncoder openfec_encoder(config, buffer_factory, allocator);
+    LdpcStaircaseEncoder native_encoder(config, buffer_factory, allocator);
+
+    CHECK(openfec_encoder.valid());
+    CHECK(native_encoder.valid());
+
+    for (size_t n_size = 0; n_size < NumSizes; n_size++) {
+        const size_t n_source = SourceSizes[n_size];
+        const size_t n_repair = RepairSizes[n_size];
+
+        core::Slice<uint8_t> openfec_buffers[MaxPackets];
+        core::Slice<uint8_t> native_buffers[MaxPackets];
+
+        encode(openfec_encoder, openfec_buffers, n_source, n_repair, true);
+
+        for (size_t i = 0; i < n_source; i++) {
+            native_buffers[i] = openfec_buffers[i];
+        }
+
+        encode(native_encoder, native_buffers, n_source, n_repair, false);
+
+        for (size_t i = n_source; i < n_source + n_repair; i++) {
+            CHECK(memcmp(openfec_buffers[i].data(), native_buffers[i].data(),
+                         PayloadSize)
+                  == 0);
+        }
+    }
+}
+
+TEST(ldpc_staircase_openfec, native_decoder_openfec_encoder) {
+    const CodecConfig config = make_config();
+
+    OpenfecEncoder encoder(config, buffer_factory, allocator);
+    LdpcStaircaseDecoder decoder(config, buffer_factory, allocator);
+
+    for (size_t n_size = 0; n_size < NumSizes; n_size++) {
+        core::Slice<uint8_t> buffers[MaxPackets];
+
+        encode(encoder, buffers, SourceSizes[n_size], RepairSizes[n_size], true);
+        decode(decoder, buffers, SourceSizes[n_size], RepairSizes[n_size]);
+    }
+}
+
+TEST(ldpc_staircase_openfec, openfec_decoder_native_encoder) {
+    const CodecConfig config = make_config();
+
+    LdpcStaircaseEncoder encoder(config, buffer_factory, allocator);
+    OpenfecDecoder decoder(config, buffer_factory, allocator);
+
+    for (size_t n_size = 0; n_size < NumSizes; n_size++) {
+        core::Slice<uint8_t> buffers[MaxPackets];
+
+        encode(encoder, buffers, SourceSizes[n_size], RepairSizes[n_size], true);
+        decode(decoder, buffers, SourceSizes[n_size], RepairSizes[n_size]);
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -13,6 +13,7 @@
 #include "roc_core/fast_random.h"
 #include "roc_core/heap_allocator.h"
 #include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_fec/codec_map.h"
 
@@ -221,6 +222,43 @@ TEST(encoder_decoder, full_repair_payload_sizes) {
     }
 }
 
+TEST(encoder_decoder, varying_block_sizes) {
+    enum { NumIterations = 3, NumSizes = 6, PayloadSize = 251 };
+
+    // more distinct sizes than encoder keeps cached sessions, so that
+    // sessions are both reused and evicted
+    const size_t source_sizes[NumSizes] = { 20, 18, 20, 10, 15, 12 };
+    const size_t repair_sizes[NumSizes] = { 10, 9, 10, 5, 8, 6 };
+
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        CodecConfig config;
+        config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+
+        Codec code(config);
+
+        for (size_t test_num = 0; test_num < NumIterations; ++test_num) {
+            for (size_t n_size = 0; n_size < NumSizes; n_size++) {
+                const size_t n_source = source_sizes[n_size];
+                const size_t n_repair = repair_sizes[n_size];
+
+                code.encode(n_source, n_repair, PayloadSize);
+
+                CHECK(code.decoder().begin(n_source, n_repair, PayloadSize));
+
+                for (size_t i = 0; i < n_source + n_repair; ++i) {
+                    if (i == 3) {
+                        continue;
+                    }
+                    code.decoder().set(i, code.get_buffer(i));
+                }
+                CHECK(code.decode(n_source, PayloadSize));
+
+                code.decoder().end();
+            }
+        }
+    }
+}
+
 TEST(encoder_decoder, max_source_block) {
     for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); ++n_scheme) {
         CodecConfig config;
@@ -233,5 +271,44 @@ TEST(encoder_decoder, max_source_block) {
     }
 }
 
+TEST(encoder_decoder, backends) {
+    enum { NumSourcePackets = 20, NumRepairPackets = 10, PayloadSize = 251 };
+
+    const CodecBackend backends[] = { CodecBackend_Builtin, CodecBackend_OpenFEC };
+
+    // built-in codec is always available, regardless of OpenFEC
+    CHECK(CodecMap::instance().is_supported(packet::FEC_LDPC_Staircase,
+                                            CodecBackend_Builtin));
+    CHECK(!CodecMap::instance().is_supported(packet::FEC_ReedSolomon_M8,
+                                             CodecBackend_Builtin));
+
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        for (size_t n_back = 0; n_back < ROC_ARRAY_SIZE(backends); n_back++) {
+            CodecConfig config;
+            config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+            config.backend = backends[n_back];
+
+            if (!CodecMap::instance().is_supported(config.scheme, config.backend)) {
+                continue;
+            }
+
+            Codec code(config);
+            code.encode(NumSourcePackets, NumRepairPackets, PayloadSize);
+
+            CHECK(code.decoder().begin(NumSourcePackets, NumRepairPackets, PayloadSize));
+
+            for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+                if (i == 5) {
+                    continue;
+                }
+                code.decoder().set(i, code.get_buffer(i));
+            }
+            CHECK(code.decode(NumSourcePackets, PayloadSize));
+
+            code.decoder().end();
+        }
+    }
+}
+
 } // namespace fec
 } // namespace roc
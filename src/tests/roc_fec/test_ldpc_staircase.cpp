@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_factory.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_fec/ldpc_staircase_decoder.h"
+#include "roc_fec/ldpc_staircase_encoder.h"
+#include "roc_fec/ldpc_staircase_matrix.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxPackets = 64, MaxPayloadSize = 512 };
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, MaxPayloadSize, true);
+
+CodecConfig make_config() {
+    CodecConfig config;
+    config.scheme = packet::FEC_LDPC_Staircase;
+    return config;
+}
+
+bool has_entry(const LdpcStaircaseMatrix& matrix, size_t row, size_t col) {
+    for (const uint32_t* c = matrix.row_begin(row); c != matrix.row_end(row); ++c) {
+        if (*c == col) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void encode(LdpcStaircaseEncoder& encoder,
+            core::Slice<uint8_t>* buffers,
+            size_t n_source,
+            size_t n_repair,
+            size_t payload_size) {
+    CHECK(encoder.begin(n_source, n_repair, payload_size));
+
+    for (size_t i = 0; i < n_source + n_repair; i++) {
+        buffers[i] = buffer_factory.new_buffer();
+        CHECK(buffers[i]);
+        buffers[i].reslice(0, payload_size);
+
+        for (size_t j = 0; j < payload_size; j++) {
+            buffers[i].data()[j] =
+                i < n_source ? (uint8_t)core::fast_random(0, 0xff) : 0;
+        }
+
+        encoder.set(i, buffers[i]);
+    }
+
+    encoder.fill();
+    encoder.end();
+}
+
+// returns number of repaired source packets
+size_t decode(LdpcStaircaseDecoder& decoder,
+              const core::Slice<uint8_t>* buffers,
+              const bool* lost,
+              size_t n_source,
+              size_t n_repair,
+              size_t payload_size) {
+    CHECK(decoder.begin(n_source, n_repair, payload_size));
+
+    for (size_t i = 0; i < n_source + n_repair; i++) {
+        if (!lost[i]) {
+            decoder.set(i, buffers[i]);
+        }
+    }
+
+    size_t n_repaired = 0;
+
+    for (size_t i = 0; i < n_source; i++) {
+        core::Slice<uint8_t> buffer = decoder.repair(i);
+
+        if (!lost[i]) {
+            CHECK(buffer.data() == buffers[i].data());
+            continue;
+        }
+
+        if (!buffer) {
+            continue;
+        }
+
+        LONGS_EQUAL(payload_size, buffer.size());
+        CHECK(memcmp(buffer.data(), buffers[i].data(), payload_size) == 0);
+
+        n_repaired++;
+    }
+
+    decoder.end();
+
+    return n_repaired;
+}
+
+} // namespace
+
+TEST_GROUP(ldpc_staircase) {};
+
+TEST(ldpc_staircase, matrix_degrees) {
+    enum { NumSource = 20, NumRepair = 10 };
+
+    const CodecConfig config = make_config();
+
+    LdpcStaircaseMatrix matrix(config.ldpc_prng_seed, config.ldpc_N1, allocator);
+    CHECK(matrix.build(NumSource, NumRepair));
+
+    LONGS_EQUAL(NumSource, matrix.n_source());
+    LONGS_EQUAL(NumRepair, matrix.n_repair());
+
+    size_t n_row_entries = 0;
+
+    for (size_t row = 0; row < NumRepair; row++) {
+        CHECK(matrix.row_end(row) - matrix.row_begin(row) >= 2);
+
+        for (const uint32_t* col = matrix.row_begin(row); col != matrix.row_end(row);
+             ++col) {
+            CHECK(*col < NumSource);
+            n_row_entries++;
+        }
+    }
+
+    size_t n_col_entries = 0;
+
+    for (size_t col = 0; col < NumSource; col++) {
+        // every source symbol is in at least N1 distinct rows
+        CHECK(matrix.col_end(col) - matrix.col_begin(col) >= config.ldpc_N1);
+
+        for (const uint32_t* row = matrix.col_begin(col); row != matrix.col_end(col);
+             ++row) {
+            CHECK(*row < NumRepair);
+            CHECK(has_entry(matrix, *row, col));
+
+            for (const uint32_t* other = matrix.col_begin(col); other != row; ++other) {
+                CHECK(*other != *row);
+            }
+
+            n_col_entries++;
+        }
+    }
+
+    LONGS_EQUAL(n_row_entries, n_col_entries);
+}
+
+TEST(ldpc_staircase, matrix_small_repair_block) {
+    enum { NumSource = 10, NumRepair = 3 };
+
+    const CodecConfig config = make_config();
+    CHECK(NumRepair < config.ldpc_N1);
+
+    LdpcStaircaseMatrix matrix(config.ldpc_prng_seed, config.ldpc_N1, allocator);
+    CHECK(matrix.build(NumSource, NumRepair));
+
+    // N1 is larger than number of rows, so every column is in all rows
+    for (size_t col = 0; col < NumSource; col++) {
+        LONGS_EQUAL(NumRepair, matrix.col_end(col) - matrix.col_begin(col));
+    }
+}
+
+TEST(ldpc_staircase, matrix_deterministic) {
+    enum { NumSource = 30, NumRepair = 15 };
+
+    const CodecConfig config = make_config();
+
+    LdpcStaircaseMatrix matrix1(config.ldpc_prng_seed, config.ldpc_N1, allocator);
+    LdpcStaircaseMatrix matrix2(config.ldpc_prng_seed, config.ldpc_N1, allocator);
+    LdpcStaircaseMatrix matrix3(config.ldpc_prng_seed + 1, config.ldpc_N1, allocator);
+
+    CHECK(matrix1.build(NumSource, NumRepair));
+    CHECK(matrix2.build(NumSource - 1, NumRepair));
+    CHECK(matrix2.build(NumSource, NumRepair));
+    CHECK(matrix3.build(NumSource, NumRepair));
+
+    bool same_as_other_seed = true;
+
+    for (size_t row = 0; row < NumRepair; row++) {
+        for (size_t col = 0; col < NumSource; col++) {
+            CHECK(has_entry(matrix1, row, col) == has_entry(matrix2, row, col));
+
+            if (has_entry(matrix1, row, col) != has_entry(matrix3, row, col)) {
+                same_as_other_seed = false;
+            }
+        }
+    }
+
+    CHECK(!same_as_other_seed);
+}
+
+TEST(ldpc_staircase, matrix_invalid_size) {
+    const CodecConfig config = make_config();
+
+    LdpcStaircaseMatrix matrix(config.ldpc_prng_seed, config.ldpc_N1, allocator);
+
+    CHECK(!matrix.build(0, 10));
+    CHECK(!matrix.build(LdpcStaircaseMatrix::MaxBlockLength, 1));
+    CHECK(matrix.build(10, 0));
+}
+
+TEST(ldpc_staircase, encode_staircase) {
+    enum { NumSource = 20, NumRepair = 10, PayloadSize = 203 };
+
+    const CodecConfig config = make_config();
+
+    LdpcStaircaseEncoder encoder(config, buffer_factory, allocator);
+    CHECK(encoder.valid());
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    encode(encoder, buffers, NumSource, NumRepair, PayloadSize);
+
+    LdpcStaircaseMatrix matrix(config.ldpc_prng_seed, config.ldpc_N1, allocator);
+    CHECK(matrix.build(NumSource, NumRepair));
+
+    for (size_t row = 0; row < NumRepair; row++) {
+        for (size_t j = 0; j < PayloadSize; j++) {
+            uint8_t expected = row == 0 ? 0 : buffers[NumSource + row - 1].data()[j];
+
+            for (const uint32_t* col = matrix.row_begin(row); col != matrix.row_end(row);
+                 ++col) {
+                expected ^= buffers[*col].data()[j];
+            }
+
+            LONGS_EQUAL(expected, buffers[NumSource + row].data()[j]);
+        }
+    }
+}
+
+TEST(ldpc_staircase, decode_without_loss) {
+    enum { NumSource = 20, NumRepair = 10, PayloadSize = 100 };
+
+    const CodecConfig config = make_config();
+
+    LdpcStaircaseEncoder encoder(config, buffer_factory, allocator);
+    LdpcStaircaseDecoder decoder(config, buffer_factory, allocator);
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    encode(encoder, buffers, NumSource, NumRepair, PayloadSize);
+
+    bool lost[MaxPackets] = {};
+
+    LONGS_EQUAL(0, decode(decoder, buffers, lost, NumSource, NumRepair, PayloadSize));
+}
+
+TEST(ldpc_staircase, decode_source_losses) {
+    enum { NumSource = 20, NumRepair = 10, PayloadSize = 100 };
+
+    const CodecConfig config = make_config();
+
+    LdpcStaircaseEncoder encoder(config, buffer_factory, allocator);
+    LdpcStaircaseDecoder decoder(config, buffer_factory, allocator);
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    encode(encoder, buffers, NumSource, NumRepair, PayloadSize);
+
+    for (size_t n_lost = 1; n_lost <= 4; n_lost++) {
+        bool lost[MaxPackets] = {};
+        for (size_t i = 0; i < n_lost; i++) {
+            lost[i * 5 + 1] = true;
+        }
+
+        LONGS_EQUAL(n_lost,
+                    decode(decoder, buffers, lost, NumSource, NumRepair, PayloadSize));
+    }
+}
+
+TEST(ldpc_staircase, decode_mixed_losses) {
+    enum { NumSource = 20, NumRepair = 10, PayloadSize = 100 };
+
+    const CodecConfig config = make_config();
+
+    LdpcStaircaseEncoder encoder(config, buffer_factory, allocator);
+    LdpcStaircaseDecoder decoder(config, buffer_factory, allocator);
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    encode(encoder, buffers, NumSource, NumRepair, PayloadSize);
+
+    bool lost[MaxPackets] = {};
+    lost[2] = lost[7] = lost[19] = true;
+    lost[NumSource + 0] = lost[NumSource + 5] = true;
+
+    LONGS_EQUAL(3, decode(decoder, buffers, lost, NumSource, NumRepair, PayloadSize));
+}
+
+TEST(ldpc_staircase, decode_all_source_lost) {
+    enum { NumSource = 10, NumRepair = 20, PayloadSize = 77 };
+
+    const CodecConfig config = make_config();
+
+    LdpcStaircaseEncoder encoder(config, buffer_factory, allocator);
+    LdpcStaircaseDecoder decoder(config, buffer_factory, allocator);
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    encode(encoder, buffers, NumSource, NumRepair, PayloadSize);
+
+    // no row has single unknown symbol, so peeling alone can't start
+    // and decoder falls back to elimination
+    bool lost[MaxPackets] = {};
+    for (size_t i = 0; i < NumSource; i++) {
+        lost[i] = true;
+    }
+
+    LONGS_EQUAL(NumSource,
+                decode(decoder, buffers, lost, NumSource, NumRepair, PayloadSize));
+}
+
+TEST(ldpc_staircase, decode_not_enough_packets) {
+    enum { NumSource = 20, NumRepair = 10, PayloadSize = 100 };
+
+    const CodecConfig config = make_config();
+
+    LdpcStaircaseEncoder encoder(config, buffer_factory, allocator);
+    LdpcStaircaseDecoder decoder(config, buffer_factory, allocator);
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    encode(encoder, buffers, NumSource, NumRepair, PayloadSize);
+
+    bool lost[MaxPackets] = {};
+    for (size_t i = 0; i < NumRepair + 1; i++) {
+        lost[i] = true;
+    }
+
+    // whatever is repaired must be correct
+    CHECK(decode(decoder, buffers, lost, NumSource, NumRepair, PayloadSize)
+          < NumRepair + 1);
+
+    // decoder is still usable after failed block
+    lost[0] = false;
+    for (size_t i = 1; i < NumRepair + 1; i++) {
+        lost[i] = (i % 3 == 1);
+    }
+
+    LONGS_EQUAL(4, decode(decoder, buffers, lost, NumSource, NumRepair, PayloadSize));
+}
+
+TEST(ldpc_staircase, decode_random_losses) {
+    enum {
+        NumIterations = 200,
+        NumSource = 30,
+        NumRepair = 15,
+        PayloadSize = 64,
+        LossPercent = 10
+    };
+
+    const CodecConfig config = make_config();
+
+    LdpcStaircaseEncoder encoder(config, buffer_factory, allocator);
+    LdpcStaircaseDecoder decoder(config, buffer_factory, allocator);
+
+    size_t n_lost = 0, n_repaired = 0;
+
+    for (size_t iter = 0; iter < NumIterations; iter++) {
+        core::Slice<uint8_t> buffers[MaxPackets];
+        encode(encoder, buffers, NumSource, NumRepair, PayloadSize);
+
+        bool lost[MaxPackets] = {};
+        for (size_t i = 0; i < NumSource + NumRepair; i++) {
+            lost[i] = core::fast_random(0, 99) < LossPercent;
+            if (lost[i] && i < NumSource) {
+                n_lost++;
+            }
+        }
+
+        // decode() checks that repaired packets are correct
+        n_repaired +=
+            decode(decoder, buffers, lost, NumSource, NumRepair, PayloadSize);
+    }
+
+    CHECK(n_repaired > n_lost * 9 / 10);
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_fec/redundancy_controller.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { NumSourcePackets = 20, NumRepairPackets = 10, NumReports = 100 };
+
+packet::LossRuns make_runs(size_t n_received, size_t n_lost) {
+    packet::LossRuns runs;
+    CHECK(runs.add_run(true, (packet::seqnum_t)n_received));
+    CHECK(runs.add_run(false, (packet::seqnum_t)n_lost));
+    CHECK(runs.add_run(true, (packet::seqnum_t)n_received));
+    return runs;
+}
+
+} // namespace
+
+TEST_GROUP(redundancy_controller) {
+    RedundancyControllerConfig config;
+
+    void setup() {
+        config.min_repair_packets = 1;
+        config.max_repair_packets = 20;
+        config.max_interleaving_depth = 1;
+        config.loss_margin = 2;
+        config.release_factor = 0.1f;
+    }
+};
+
+TEST(redundancy_controller, initial_size) {
+    RedundancyController rc(config, NumSourcePackets, NumRepairPackets);
+
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets, rc.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(NumRepairPackets, rc.n_repair_packets());
+    UNSIGNED_LONGS_EQUAL(1, rc.interleaving_depth());
+}
+
+TEST(redundancy_controller, clean_link) {
+    RedundancyController rc(config, NumSourcePackets, NumRepairPackets);
+
+    size_t prev_repair = rc.n_repair_packets();
+
+    for (size_t n = 0; n < NumReports; n++) {
+        rc.update(0, make_runs(100, 0));
+
+        // redundancy is released gradually
+        CHECK(rc.n_repair_packets() <= prev_repair);
+        CHECK(prev_repair - rc.n_repair_packets() <= 1);
+        prev_repair = rc.n_repair_packets();
+    }
+
+    UNSIGNED_LONGS_EQUAL(config.min_repair_packets, rc.n_repair_packets());
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets, rc.n_source_packets());
+}
+
+TEST(redundancy_controller, random_loss) {
+    RedundancyController rc(config, NumSourcePackets, NumRepairPackets);
+
+    for (size_t n = 0; n < NumReports; n++) {
+        rc.update(0, make_runs(100, 0));
+    }
+    UNSIGNED_LONGS_EQUAL(config.min_repair_packets, rc.n_repair_packets());
+
+    // 10% loss, isolated losses; 20 * 0.1 * 2 = 4
+    rc.update(0.1f, make_runs(10, 1));
+    UNSIGNED_LONGS_EQUAL(4, rc.n_repair_packets());
+
+    // 25% loss; 20 * 0.25 * 2 = 10
+    rc.update(0.25f, make_runs(3, 1));
+    UNSIGNED_LONGS_EQUAL(10, rc.n_repair_packets());
+}
+
+TEST(redundancy_controller, burst_loss) {
+    RedundancyController rc(config, NumSourcePackets, NumRepairPackets);
+
+    for (size_t n = 0; n < NumReports; n++) {
+        rc.update(0, make_runs(100, 0));
+    }
+
+    // low average loss, but a burst of 7 packets
+    rc.update(0.01f, make_runs(400, 7));
+    UNSIGNED_LONGS_EQUAL(7, rc.n_repair_packets());
+}
+
+TEST(redundancy_controller, fast_attack_slow_release) {
+    RedundancyController rc(config, NumSourcePackets, NumRepairPackets);
+
+    for (size_t n = 0; n < NumReports; n++) {
+        rc.update(0, make_runs(100, 0));
+    }
+
+    rc.update(0.2f, make_runs(4, 1));
+    UNSIGNED_LONGS_EQUAL(8, rc.n_repair_packets());
+
+    // one clean report doesn't drop redundancy
+    rc.update(0, make_runs(100, 0));
+    CHECK(rc.n_repair_packets() >= 7);
+
+    for (size_t n = 0; n < NumReports; n++) {
+        rc.update(0, make_runs(100, 0));
+    }
+    UNSIGNED_LONGS_EQUAL(config.min_repair_packets, rc.n_repair_packets());
+}
+
+TEST(redundancy_controller, limits) {
+    RedundancyController rc(config, NumSourcePackets, NumRepairPackets);
+
+    rc.update(1, make_runs(0, 100));
+    UNSIGNED_LONGS_EQUAL(config.max_repair_packets, rc.n_repair_packets());
+    UNSIGNED_LONGS_EQUAL(1, rc.interleaving_depth());
+
+    config.min_repair_packets = 3;
+    RedundancyController rc2(config, NumSourcePackets, NumRepairPackets);
+
+    for (size_t n = 0; n < NumReports; n++) {
+        rc2.update(0, make_runs(100, 0));
+    }
+    UNSIGNED_LONGS_EQUAL(3, rc2.n_repair_packets());
+}
+
+TEST(redundancy_controller, no_loss_runs) {
+    RedundancyController rc(config, NumSourcePackets, NumRepairPackets);
+
+    for (size_t n = 0; n < NumReports; n++) {
+        rc.update(0, packet::LossRuns());
+    }
+    UNSIGNED_LONGS_EQUAL(config.min_repair_packets, rc.n_repair_packets());
+
+    // receiver reports only fraction lost
+    rc.update(0.15f, packet::LossRuns());
+    UNSIGNED_LONGS_EQUAL(6, rc.n_repair_packets());
+}
+
+TEST(redundancy_controller, interleaving_depth) {
+    config.max_interleaving_depth = 4;
+
+    RedundancyController rc(config, NumSourcePackets, NumRepairPackets);
+    UNSIGNED_LONGS_EQUAL(1, rc.interleaving_depth());
+
+    for (size_t n = 0; n < NumReports; n++) {
+        rc.update(0, make_runs(100, 0));
+    }
+    UNSIGNED_LONGS_EQUAL(config.min_repair_packets, rc.n_repair_packets());
+    UNSIGNED_LONGS_EQUAL(1, rc.interleaving_depth());
+
+    // burst fits into one block
+    rc.update(0.01f, make_runs(1000, 20));
+    UNSIGNED_LONGS_EQUAL(20, rc.n_repair_packets());
+    UNSIGNED_LONGS_EQUAL(1, rc.interleaving_depth());
+
+    // burst is spread over 3 blocks; 45 / 3 = 15
+    rc.update(0.02f, make_runs(1000, 45));
+    UNSIGNED_LONGS_EQUAL(15, rc.n_repair_packets());
+    UNSIGNED_LONGS_EQUAL(3, rc.interleaving_depth());
+
+    // burst is longer than max depth can handle
+    rc.update(0.05f, make_runs(1000, 200));
+    UNSIGNED_LONGS_EQUAL(config.max_repair_packets, rc.n_repair_packets());
+    UNSIGNED_LONGS_EQUAL(4, rc.interleaving_depth());
+
+    // depth is released gradually
+    size_t prev_depth = rc.interleaving_depth();
+
+    for (size_t n = 0; n < NumReports; n++) {
+        rc.update(0, make_runs(100, 0));
+
+        CHECK(rc.interleaving_depth() <= prev_depth);
+        CHECK(prev_depth - rc.interleaving_depth() <= 1);
+        prev_depth = rc.interleaving_depth();
+    }
+
+    UNSIGNED_LONGS_EQUAL(config.min_repair_packets, rc.n_repair_packets());
+    UNSIGNED_LONGS_EQUAL(1, rc.interleaving_depth());
+}
+
+} // namespace fec
+} // namespace roc
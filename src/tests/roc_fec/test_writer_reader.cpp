@@ -61,6 +61,12 @@ Composer<RS8M_PayloadID, Repair, Header> rs8m_repair_composer(NULL);
 Composer<LDPC_Source_PayloadID, Source, Footer> ldpc_source_composer(&rtp_composer);
 Composer<LDPC_Repair_PayloadID, Repair, Header> ldpc_repair_composer(NULL);
 
+// scheme different from given, even if it's the only enabled one
+packet::FecScheme other_scheme(packet::FecScheme scheme) {
+    return scheme == packet::FEC_LDPC_Staircase ? packet::FEC_ReedSolomon_M8
+                                                : packet::FEC_LDPC_Staircase;
+}
+
 } // namespace
 
 TEST_GROUP(writer_reader) {
@@ -513,6 +519,75 @@ TEST(writer_reader, multiple_blocks_1_loss) {
     }
 }
 
+TEST(writer_reader, decode_only_lossy_blocks) {
+    // Lose source packets in some blocks and repair packets in other blocks.
+    // Decoder should be used only for blocks with lost source packets.
+    enum { NumBlocks = 10 };
+
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+
+        core::ScopedPtr<IBlockEncoder> encoder(
+            CodecMap::instance().new_encoder(codec_config, buffer_factory, allocator),
+            allocator);
+
+        core::ScopedPtr<IBlockDecoder> decoder(
+            CodecMap::instance().new_decoder(codec_config, buffer_factory, allocator),
+            allocator);
+
+        CHECK(encoder);
+        CHECK(decoder);
+
+        test::PacketDispatcher dispatcher(source_parser(), repair_parser(),
+                                          packet_factory, NumSourcePackets,
+                                          NumRepairPackets);
+
+        Writer writer(writer_config, codec_config.scheme, *encoder, dispatcher,
+                      source_composer(), repair_composer(), packet_factory,
+                      buffer_factory, allocator);
+
+        Reader reader(reader_config, codec_config.scheme, *decoder,
+                      dispatcher.source_reader(), dispatcher.repair_reader(), rtp_parser,
+                      packet_factory, allocator);
+
+        CHECK(writer.valid());
+        CHECK(reader.valid());
+
+        for (size_t block_num = 0; block_num < NumBlocks; ++block_num) {
+            size_t lost_sq = size_t(-1);
+            if (block_num == 2 || block_num == 7) {
+                lost_sq = 5;
+            } else if (block_num == 4) {
+                lost_sq = NumSourcePackets + 1;
+            }
+
+            if (lost_sq != size_t(-1)) {
+                dispatcher.lose(lost_sq);
+            }
+
+            fill_all_packets(NumSourcePackets * block_num);
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                writer.write(source_packets[i]);
+            }
+            dispatcher.push_stocks();
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                packet::PacketPtr p = reader.read();
+                CHECK(p);
+
+                check_audio_packet(p, NumSourcePackets * block_num + i);
+                check_restored(p, i == lost_sq);
+            }
+
+            dispatcher.reset();
+        }
+
+        UNSIGNED_LONGS_EQUAL(2, reader.n_decoded_blocks());
+        UNSIGNED_LONGS_EQUAL(NumBlocks - 2, reader.n_skipped_blocks());
+    }
+}
+
 TEST(writer_reader, multiple_blocks_in_queue) {
     enum { NumBlocks = 3 };
 
@@ -849,15 +924,16 @@ TEST(writer_reader, repair_packets_before_source_packets) {
             packet::PacketPtr p = reader.read();
             CHECK(p);
 
-            // All packets should be restored.
+            // Packets are repaired lazily, so only packets read before
+            // source packets arrived should be restored.
             check_audio_packet(p, rd_sn);
-            check_restored(p, true);
+            check_restored(p, i == 0);
 
             rd_sn++;
 
             if (i == 0) {
                 // Deliver source packets from second block.
-                // These packets should be dropped.
+                // These packets should be used instead of repairing.
                 dispatcher.push_stocks();
             }
         }
@@ -2963,8 +3039,7 @@ TEST(writer_reader, reader_invalid_fec_scheme_source_packet) {
             packet::PacketPtr p = writer_queue.read();
             CHECK(p);
             CHECK((p->flags() & packet::Packet::FlagRepair) == 0);
-            p->fec()->fec_scheme = CodecMap::instance().nth_scheme(
-                (n_scheme + 1) % CodecMap::instance().num_schemes());
+            p->fec()->fec_scheme = other_scheme(codec_config.scheme);
             source_queue.write(p);
             UNSIGNED_LONGS_EQUAL(1, source_queue.size());
         }
@@ -3043,8 +3118,7 @@ TEST(writer_reader, reader_invalid_fec_scheme_repair_packet) {
             packet::PacketPtr p = writer_queue.read();
             CHECK(p);
             CHECK((p->flags() & packet::Packet::FlagRepair) != 0);
-            p->fec()->fec_scheme = CodecMap::instance().nth_scheme(
-                (n_scheme + 1) % CodecMap::instance().num_schemes());
+            p->fec()->fec_scheme = other_scheme(codec_config.scheme);
             repair_queue.write(p);
             UNSIGNED_LONGS_EQUAL(1, repair_queue.size());
         }
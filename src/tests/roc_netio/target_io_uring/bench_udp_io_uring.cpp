@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_netio/io_uring_sender.h"
+#include "roc_netio/network_loop.h"
+#include "roc_packet/concurrent_queue.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace netio {
+namespace {
+
+// Compares io_uring and libuv backends of UDP ports. Sender and receiver
+// ports run in two network loops and exchange packets over loopback.
+//
+// Bench_Throughput_*  - write batch of packets to sender port, read all of
+//                       them from receiver port
+// Bench_Latency_*     - write one packet, wait until it's received
+//
+// Argument is batch size. Sender port doesn't try non-blocking send from
+// caller thread, so that every packet goes through network loop. Payload
+// size is typical for 5ms of stereo 16-bit audio.
+
+enum { PayloadSize = 880, BufferSize = 2048, MaxBatch = 64 };
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, BufferSize, false);
+packet::PacketFactory packet_factory(allocator, false);
+
+address::SocketAddr make_address() {
+    address::SocketAddr addr;
+    if (!addr.set_host_port(address::Family_IPv4, "127.0.0.1", 0)) {
+        roc_panic("bench: can't set address");
+    }
+    return addr;
+}
+
+class Loopback {
+public:
+    Loopback(bool io_uring)
+        : tx_loop_(make_config_(io_uring), packet_factory, buffer_factory, allocator)
+        , rx_loop_(make_config_(io_uring), packet_factory, buffer_factory, allocator)
+        , tx_writer_(NULL) {
+        roc_panic_if(!tx_loop_.valid());
+        roc_panic_if(!rx_loop_.valid());
+
+        tx_config_.bind_address = make_address();
+        tx_config_.non_blocking_enabled = false;
+
+        rx_config_.bind_address = make_address();
+
+        NetworkLoop::Tasks::AddUdpSenderPort tx_task(tx_config_);
+        if (!tx_loop_.schedule_and_wait(tx_task)) {
+            roc_panic("bench: can't add udp sender");
+        }
+        tx_writer_ = tx_task.get_writer();
+
+        NetworkLoop::Tasks::AddUdpReceiverPort rx_task(rx_config_, rx_queue_);
+        if (!rx_loop_.schedule_and_wait(rx_task)) {
+            roc_panic("bench: can't add udp receiver");
+        }
+    }
+
+    void write(size_t n_packets) {
+        for (size_t n = 0; n < n_packets; n++) {
+            tx_writer_->write(new_packet_());
+        }
+    }
+
+    void read(size_t n_packets) {
+        for (size_t n = 0; n < n_packets; n++) {
+            benchmark::DoNotOptimize(rx_queue_.read());
+        }
+    }
+
+private:
+    static NetworkLoopConfig make_config_(bool io_uring) {
+        NetworkLoopConfig config;
+        config.io_uring = io_uring;
+        return config;
+    }
+
+    packet::PacketPtr new_packet_() {
+        packet::PacketPtr pp = packet_factory.new_packet();
+        roc_panic_if(!pp);
+
+        pp->add_flags(packet::Packet::FlagUDP);
+        pp->udp()->src_addr = tx_config_.bind_address;
+        pp->udp()->dst_addr = rx_config_.bind_address;
+
+        core::Slice<uint8_t> buf = buffer_factory.new_buffer();
+        roc_panic_if(!buf);
+        buf.reslice(0, PayloadSize);
+
+        pp->set_data(buf);
+
+        return pp;
+    }
+
+    NetworkLoop tx_loop_;
+    NetworkLoop rx_loop_;
+
+    UdpSenderConfig tx_config_;
+    UdpReceiverConfig rx_config_;
+
+    packet::IWriter* tx_writer_;
+    packet::ConcurrentQueue rx_queue_;
+};
+
+bool check_io_uring(benchmark::State& state) {
+    IoUringSender sender;
+    if (!sender.valid()) {
+        // otherwise ports would silently fall back to libuv
+        state.SkipWithError("io_uring not available");
+        return false;
+    }
+    return true;
+}
+
+void run_throughput(benchmark::State& state, bool io_uring) {
+    const size_t batch_size = (size_t)state.range(0);
+    roc_panic_if(batch_size > MaxBatch);
+
+    Loopback loopback(io_uring);
+
+    while (state.KeepRunning()) {
+        loopback.write(batch_size);
+        loopback.read(batch_size);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(batch_size));
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(batch_size)
+                            * PayloadSize);
+}
+
+void run_latency(benchmark::State& state, bool io_uring) {
+    Loopback loopback(io_uring);
+
+    while (state.KeepRunning()) {
+        loopback.write(1);
+        loopback.read(1);
+    }
+}
+
+void BM_UdpLoopback_Throughput_Libuv(benchmark::State& state) {
+    run_throughput(state, false);
+}
+
+BENCHMARK(BM_UdpLoopback_Throughput_Libuv)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_UdpLoopback_Throughput_IoUring(benchmark::State& state) {
+    if (check_io_uring(state)) {
+        run_throughput(state, true);
+    }
+}
+
+BENCHMARK(BM_UdpLoopback_Throughput_IoUring)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_UdpLoopback_Latency_Libuv(benchmark::State& state) {
+    run_latency(state, false);
+}
+
+BENCHMARK(BM_UdpLoopback_Latency_Libuv)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+void BM_UdpLoopback_Latency_IoUring(benchmark::State& state) {
+    if (check_io_uring(state)) {
+        run_latency(state, true);
+    }
+}
+
+BENCHMARK(BM_UdpLoopback_Latency_IoUring)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace netio
+} // namespace roc
@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <poll.h>
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/atomic.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/log.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/time.h"
+#include "roc_netio/io_uring_receiver.h"
+#include "roc_netio/io_uring_sender.h"
+#include "roc_netio/network_loop.h"
+#include "roc_netio/socket_ops.h"
+#include "roc_packet/concurrent_queue.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace netio {
+
+namespace {
+
+enum {
+    NumIterations = 20,
+    NumPackets = 10,
+    NumManyPackets = 300,
+    MaxProbes = 100,
+    BarrierValue = 200,
+    PayloadSize = 125,
+    BufferSize = 512
+};
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, BufferSize, true);
+packet::PacketFactory packet_factory(allocator, true);
+
+NetworkLoopConfig make_loop_config() {
+    NetworkLoopConfig config;
+    config.io_uring = true;
+    return config;
+}
+
+address::SocketAddr make_address() {
+    address::SocketAddr addr;
+    CHECK(addr.set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+    return addr;
+}
+
+SocketHandle open_socket(address::SocketAddr& addr) {
+    SocketHandle sock = SocketInvalid;
+    CHECK(socket_create(address::Family_IPv4, SocketType_Udp, sock));
+    CHECK(socket_bind(sock, addr));
+    return sock;
+}
+
+void close_socket(SocketHandle sock) {
+    CHECK(socket_close(sock));
+}
+
+void wait_event(int fd) {
+    pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    CHECK(poll(&pfd, 1, 10000) == 1);
+}
+
+void fill_payload(uint8_t* data, size_t size, int value) {
+    for (size_t n = 0; n < size; n++) {
+        data[n] = uint8_t((value + (int)n) & 0xff);
+    }
+}
+
+void send_datagram(SocketHandle sock,
+                   const address::SocketAddr& dst_addr,
+                   size_t size,
+                   int value) {
+    uint8_t data[BufferSize * 2];
+    CHECK(size <= sizeof(data));
+    fill_payload(data, size, value);
+    LONGS_EQUAL((long)size, (long)socket_try_send_to(sock, data, size, dst_addr));
+}
+
+void check_payload(const core::Slice<uint8_t>& data, size_t size, int value) {
+    uint8_t expected[BufferSize];
+    fill_payload(expected, size, value);
+
+    UNSIGNED_LONGS_EQUAL(size, data.size());
+    CHECK(memcmp(data.data(), expected, size) == 0);
+}
+
+void fetch_datagram(IoUringReceiver& receiver, IoUringDatagram& datagram) {
+    for (;;) {
+        const IoUringReceiver::FetchStatus status = receiver.fetch(datagram);
+        CHECK(status != IoUringReceiver::Fetch_Error);
+        if (status == IoUringReceiver::Fetch_Datagram) {
+            return;
+        }
+        wait_event(receiver.event_fd());
+        receiver.clear_event();
+    }
+}
+
+class CountingWriter : public packet::IWriter, public core::NonCopyable<> {
+public:
+    CountingWriter(packet::IWriter& writer)
+        : writer_(writer)
+        , count_(0) {
+    }
+
+    virtual void write(const packet::PacketPtr& pp) {
+        writer_.write(pp);
+        count_++;
+    }
+
+    int count() const {
+        return count_;
+    }
+
+private:
+    packet::IWriter& writer_;
+    core::Atomic<int> count_;
+};
+
+bool io_uring_supported(const char* test_name) {
+    IoUringSender sender;
+    if (!sender.valid()) {
+        // e.g. old kernel or io_uring forbidden by seccomp in container
+        roc_log(LogInfo, "skipping %s: io_uring not available", test_name);
+        return false;
+    }
+    return true;
+}
+
+NetworkLoop::PortHandle
+add_udp_sender(NetworkLoop& net_loop, UdpSenderConfig& config, packet::IWriter** writer) {
+    NetworkLoop::Tasks::AddUdpSenderPort task(config);
+    CHECK(net_loop.schedule_and_wait(task));
+    CHECK(task.success());
+    *writer = task.get_writer();
+    return task.get_handle();
+}
+
+NetworkLoop::PortHandle add_udp_receiver(NetworkLoop& net_loop,
+                                         UdpReceiverConfig& config,
+                                         packet::IWriter& writer) {
+    NetworkLoop::Tasks::AddUdpReceiverPort task(config, writer);
+    CHECK(net_loop.schedule_and_wait(task));
+    CHECK(task.success());
+    return task.get_handle();
+}
+
+packet::PacketPtr new_packet(const UdpSenderConfig& tx_config,
+                             const UdpReceiverConfig& rx_config,
+                             int value) {
+    packet::PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+
+    pp->add_flags(packet::Packet::FlagUDP);
+
+    pp->udp()->src_addr = tx_config.bind_address;
+    pp->udp()->dst_addr = rx_config.bind_address;
+
+    core::Slice<uint8_t> buf = buffer_factory.new_buffer();
+    CHECK(buf);
+    buf.reslice(0, PayloadSize);
+    fill_payload(buf.data(), PayloadSize, value);
+
+    pp->set_data(buf);
+
+    return pp;
+}
+
+void check_packet(const packet::PacketPtr& pp,
+                  const UdpSenderConfig& tx_config,
+                  const UdpReceiverConfig& rx_config,
+                  int value) {
+    CHECK(pp);
+    CHECK(pp->udp());
+
+    CHECK(pp->udp()->src_addr == tx_config.bind_address);
+    CHECK(pp->udp()->dst_addr == rx_config.bind_address);
+    CHECK(pp->udp()->receive_timestamp > 0);
+
+    check_payload(pp->data(), PayloadSize, value);
+}
+
+} // namespace
+
+TEST_GROUP(udp_io_uring) {};
+
+TEST(udp_io_uring, receiver) {
+    if (!io_uring_supported("udp_io_uring.receiver")) {
+        return;
+    }
+
+    address::SocketAddr rx_addr = make_address();
+    address::SocketAddr tx_addr = make_address();
+
+    SocketHandle rx_sock = open_socket(rx_addr);
+    SocketHandle tx_sock = open_socket(tx_addr);
+
+    CHECK(socket_enable_recv_timestamps(rx_sock));
+
+    {
+        IoUringReceiver receiver(buffer_factory);
+        CHECK(receiver.valid());
+        CHECK(receiver.start(rx_sock));
+
+        const core::nanoseconds_t start_ts = core::timestamp(core::ClockUnix);
+
+        for (int p = 0; p < NumPackets; p++) {
+            send_datagram(tx_sock, rx_addr, PayloadSize, p);
+        }
+
+        for (int p = 0; p < NumPackets; p++) {
+            IoUringDatagram datagram;
+            fetch_datagram(receiver, datagram);
+
+            check_payload(datagram.data, PayloadSize, p);
+            CHECK(datagram.src_addr == tx_addr);
+
+            CHECK(datagram.timestamp >= start_ts);
+            CHECK(datagram.timestamp <= core::timestamp(core::ClockUnix));
+        }
+
+        IoUringDatagram datagram;
+        CHECK(receiver.fetch(datagram) == IoUringReceiver::Fetch_Empty);
+    }
+
+    close_socket(tx_sock);
+    close_socket(rx_sock);
+}
+
+TEST(udp_io_uring, receiver_buffer_recycling) {
+    if (!io_uring_supported("udp_io_uring.receiver_buffer_recycling")) {
+        return;
+    }
+
+    address::SocketAddr rx_addr = make_address();
+    address::SocketAddr tx_addr = make_address();
+
+    SocketHandle rx_sock = open_socket(rx_addr);
+    SocketHandle tx_sock = open_socket(tx_addr);
+
+    {
+        IoUringReceiver receiver(buffer_factory);
+        CHECK(receiver.valid());
+        CHECK(receiver.start(rx_sock));
+
+        // many more datagrams than buffers in ring; received buffers are
+        // held until the end, so every buffer is replaced many times
+        core::Slice<uint8_t> received[NumManyPackets];
+
+        for (int p = 0; p < NumManyPackets; p++) {
+            send_datagram(tx_sock, rx_addr, PayloadSize, p);
+
+            IoUringDatagram datagram;
+            fetch_datagram(receiver, datagram);
+
+            received[p] = datagram.data;
+        }
+
+        for (int p = 0; p < NumManyPackets; p++) {
+            check_payload(received[p], PayloadSize, p);
+        }
+    }
+
+    close_socket(tx_sock);
+    close_socket(rx_sock);
+}
+
+TEST(udp_io_uring, receiver_truncated) {
+    if (!io_uring_supported("udp_io_uring.receiver_truncated")) {
+        return;
+    }
+
+    address::SocketAddr rx_addr = make_address();
+    address::SocketAddr tx_addr = make_address();
+
+    SocketHandle rx_sock = open_socket(rx_addr);
+    SocketHandle tx_sock = open_socket(tx_addr);
+
+    {
+        IoUringReceiver receiver(buffer_factory);
+        CHECK(receiver.valid());
+        CHECK(receiver.start(rx_sock));
+
+        send_datagram(tx_sock, rx_addr, PayloadSize, 1);
+
+        IoUringDatagram datagram;
+        fetch_datagram(receiver, datagram);
+
+        check_payload(datagram.data, PayloadSize, 1);
+
+        // doesn't fit into buffer together with header
+        send_datagram(tx_sock, rx_addr, BufferSize, 2);
+
+        IoUringReceiver::FetchStatus status;
+        while ((status = receiver.fetch(datagram)) == IoUringReceiver::Fetch_Empty) {
+            wait_event(receiver.event_fd());
+            receiver.clear_event();
+        }
+
+        CHECK(status == IoUringReceiver::Fetch_Error);
+        CHECK(receiver.fetch(datagram) == IoUringReceiver::Fetch_Error);
+    }
+
+    close_socket(tx_sock);
+    close_socket(rx_sock);
+}
+
+TEST(udp_io_uring, sender) {
+    if (!io_uring_supported("udp_io_uring.sender")) {
+        return;
+    }
+
+    UdpSenderConfig tx_config;
+    tx_config.bind_address = make_address();
+
+    UdpReceiverConfig rx_config;
+    rx_config.bind_address = make_address();
+
+    SocketHandle rx_sock = open_socket(rx_config.bind_address);
+    SocketHandle tx_sock = open_socket(tx_config.bind_address);
+
+    {
+        IoUringSender sender;
+        CHECK(sender.valid());
+        sender.start(tx_sock);
+
+        for (int p = 0; p < NumPackets; p++) {
+            CHECK(sender.can_send());
+            sender.send(new_packet(tx_config, rx_config, p));
+        }
+
+        UNSIGNED_LONGS_EQUAL(NumPackets, sender.num_pending());
+        CHECK(sender.flush());
+
+        size_t n_reaped = 0;
+        while (n_reaped < NumPackets) {
+            packet::PacketPtr pp;
+            int result = 0;
+            if (!sender.reap(pp, result)) {
+                wait_event(sender.event_fd());
+                sender.clear_event();
+                continue;
+            }
+            CHECK(pp);
+            LONGS_EQUAL(PayloadSize, result);
+            n_reaped++;
+        }
+
+        UNSIGNED_LONGS_EQUAL(0, sender.num_pending());
+    }
+
+    for (int p = 0; p < NumPackets; p++) {
+        uint8_t data[BufferSize];
+        LONGS_EQUAL(PayloadSize, (long)socket_try_recv(rx_sock, data, sizeof(data)));
+
+        uint8_t expected[PayloadSize];
+        fill_payload(expected, PayloadSize, p);
+        CHECK(memcmp(data, expected, PayloadSize) == 0);
+    }
+
+    close_socket(tx_sock);
+    close_socket(rx_sock);
+}
+
+TEST(udp_io_uring, network_loop) {
+    // works regardless of io_uring support, because ports fall back to libuv
+    packet::ConcurrentQueue rx_queue;
+
+    UdpSenderConfig tx_config;
+    tx_config.bind_address = make_address();
+    tx_config.non_blocking_enabled = false;
+
+    UdpReceiverConfig rx_config;
+    rx_config.bind_address = make_address();
+
+    NetworkLoop tx_loop(make_loop_config(), packet_factory, buffer_factory, allocator);
+    CHECK(tx_loop.valid());
+
+    NetworkLoop rx_loop(make_loop_config(), packet_factory, buffer_factory, allocator);
+    CHECK(rx_loop.valid());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
+    CHECK(add_udp_receiver(rx_loop, rx_config, rx_queue));
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            tx_writer->write(new_packet(tx_config, rx_config, p));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue.read(), tx_config, rx_config, p);
+        }
+    }
+}
+
+TEST(udp_io_uring, network_loop_fallback) {
+    // buffers have no room for io_uring header, so receiver port should
+    // get truncated datagram and fall back to libuv
+    core::BufferFactory<uint8_t> small_buffer_factory(allocator, PayloadSize, true);
+
+    packet::ConcurrentQueue rx_queue;
+    CountingWriter rx_writer(rx_queue);
+
+    UdpSenderConfig tx_config;
+    tx_config.bind_address = make_address();
+    tx_config.non_blocking_enabled = false;
+
+    UdpReceiverConfig rx_config;
+    rx_config.bind_address = make_address();
+
+    NetworkLoop tx_loop(make_loop_config(), packet_factory, buffer_factory, allocator);
+    CHECK(tx_loop.valid());
+
+    NetworkLoop rx_loop(make_loop_config(), packet_factory, small_buffer_factory,
+                        allocator);
+    CHECK(rx_loop.valid());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
+    CHECK(add_udp_receiver(rx_loop, rx_config, rx_writer));
+
+    // packets sent before fallback are lost
+    for (int n_probes = 0; rx_writer.count() == 0; n_probes++) {
+        CHECK(n_probes < MaxProbes);
+        tx_writer->write(new_packet(tx_config, rx_config, n_probes));
+        core::sleep_for(core::ClockMonotonic, core::Millisecond * 10);
+    }
+
+    // skip probes that got through
+    tx_writer->write(new_packet(tx_config, rx_config, BarrierValue));
+    for (;;) {
+        packet::PacketPtr pp = rx_queue.read();
+        CHECK(pp);
+        if (pp->data().data()[0] == BarrierValue) {
+            break;
+        }
+    }
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            tx_writer->write(new_packet(tx_config, rx_config, p));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue.read(), tx_config, rx_config, p);
+        }
+    }
+}
+
+} // namespace netio
+} // namespace roc
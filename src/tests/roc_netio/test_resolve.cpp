@@ -24,6 +24,7 @@ enum { MaxBufSize = 500 };
 core::HeapAllocator allocator;
 core::BufferFactory<uint8_t> buffer_factory(allocator, MaxBufSize, true);
 packet::PacketFactory packet_factory(allocator, true);
+NetworkLoopConfig net_loop_config;
 
 bool resolve_endpoint_address(NetworkLoop& net_loop,
                               const address::EndpointUri& endpoint_uri,
@@ -44,7 +45,7 @@ bool resolve_endpoint_address(NetworkLoop& net_loop,
 TEST_GROUP(resolve) {};
 
 TEST(resolve, ipv4) {
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     address::EndpointUri endpoint_uri(allocator);
@@ -59,7 +60,7 @@ TEST(resolve, ipv4) {
 }
 
 TEST(resolve, ipv6) {
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     address::EndpointUri endpoint_uri(allocator);
@@ -74,7 +75,7 @@ TEST(resolve, ipv6) {
 }
 
 TEST(resolve, hostname) {
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     address::EndpointUri endpoint_uri(allocator);
@@ -95,7 +96,7 @@ TEST(resolve, hostname) {
 }
 
 TEST(resolve, standard_port) {
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     address::EndpointUri endpoint_uri(allocator);
@@ -109,7 +110,7 @@ TEST(resolve, standard_port) {
 }
 
 TEST(resolve, bad_host) {
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     { // bad ipv4
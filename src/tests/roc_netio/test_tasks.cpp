@@ -27,6 +27,7 @@ enum { MaxBufSize = 500 };
 core::HeapAllocator allocator;
 core::BufferFactory<uint8_t> buffer_factory(allocator, MaxBufSize, true);
 packet::PacketFactory packet_factory(allocator, true);
+NetworkLoopConfig net_loop_config;
 
 UdpReceiverConfig make_receiver_config(const char* ip, int port) {
     UdpReceiverConfig config;
@@ -132,7 +133,7 @@ private:
 TEST_GROUP(tasks) {};
 
 TEST(tasks, synchronous_add) {
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     UdpReceiverConfig config = make_receiver_config("127.0.0.1", 0);
@@ -150,7 +151,7 @@ TEST(tasks, synchronous_add) {
 }
 
 TEST(tasks, asynchronous_add) {
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     UdpReceiverConfig config = make_receiver_config("127.0.0.1", 0);
@@ -172,7 +173,7 @@ TEST(tasks, asynchronous_add) {
 }
 
 TEST(tasks, asynchronous_add_remove) {
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     UdpReceiverConfig config = make_receiver_config("127.0.0.1", 0);
@@ -30,6 +30,7 @@ enum { MaxBufSize = 500, TotalBytes = 107701 };
 core::HeapAllocator allocator;
 core::BufferFactory<uint8_t> buffer_factory(allocator, MaxBufSize, true);
 packet::PacketFactory packet_factory(allocator, true);
+NetworkLoopConfig net_loop_config;
 
 TcpServerConfig make_server_config(const char* ip, int port) {
     TcpServerConfig config;
@@ -99,7 +100,7 @@ TEST(tcp_io, one_server_one_client_one_direction) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -138,7 +139,7 @@ TEST(tcp_io, one_server_one_client_both_directions) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -186,10 +187,12 @@ TEST(tcp_io, one_server_one_client_separate_loops) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler);
 
-    NetworkLoop client_net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop client_net_loop(net_loop_config, packet_factory, buffer_factory,
+                                allocator);
     CHECK(client_net_loop.valid());
 
-    NetworkLoop server_net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop server_net_loop(net_loop_config, packet_factory, buffer_factory,
+                                allocator);
     CHECK(server_net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -232,7 +235,7 @@ TEST(tcp_io, one_server_many_clients) {
     acceptor.push_handler(server_conn_handler1);
     acceptor.push_handler(server_conn_handler2);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -28,6 +28,7 @@ enum { MaxBufSize = 500 };
 core::HeapAllocator allocator;
 core::BufferFactory<uint8_t> buffer_factory(allocator, MaxBufSize, true);
 packet::PacketFactory packet_factory(allocator, true);
+NetworkLoopConfig net_loop_config;
 
 address::SocketAddr make_address(const char* ip, int port) {
     address::SocketAddr address;
@@ -148,7 +149,7 @@ void terminate_and_wait(test::MockConnHandler& handler,
 TEST_GROUP(tcp_ports) {};
 
 TEST(tcp_ports, no_ports) {
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     UNSIGNED_LONGS_EQUAL(0, net_loop.num_ports());
@@ -161,7 +162,7 @@ TEST(tcp_ports, add_anyaddr) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("0.0.0.0", 0);
@@ -208,7 +209,7 @@ TEST(tcp_ports, add_localhost) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -255,7 +256,7 @@ TEST(tcp_ports, add_addrinuse) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler);
 
-    NetworkLoop net_loop1(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop1(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop1.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -284,7 +285,7 @@ TEST(tcp_ports, add_addrinuse) {
 
     POINTERS_EQUAL(server_conn, acceptor.wait_added());
 
-    NetworkLoop net_loop2(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop2(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop2.valid());
 
     UNSIGNED_LONGS_EQUAL(0, net_loop2.num_ports());
@@ -307,7 +308,7 @@ TEST(tcp_ports, add_remove) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -353,7 +354,7 @@ TEST(tcp_ports, add_remove) {
 TEST(tcp_ports, add_remove_add) {
     test::MockConnAcceptor acceptor;
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -383,7 +384,7 @@ TEST(tcp_ports, connect_one_server_one_client) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -425,7 +426,7 @@ TEST(tcp_ports, connect_one_server_many_clients) {
     acceptor.push_handler(server_conn_handler1);
     acceptor.push_handler(server_conn_handler2);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -490,13 +491,16 @@ TEST(tcp_ports, connect_one_server_many_clients_many_loops) {
     acceptor.push_handler(server_conn_handler1);
     acceptor.push_handler(server_conn_handler2);
 
-    NetworkLoop net_loop_client1(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop_client1(net_loop_config, packet_factory, buffer_factory,
+                                 allocator);
     CHECK(net_loop_client1.valid());
 
-    NetworkLoop net_loop_client2(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop_client2(net_loop_config, packet_factory, buffer_factory,
+                                 allocator);
     CHECK(net_loop_client2.valid());
 
-    NetworkLoop net_loop_server(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop_server(net_loop_config, packet_factory, buffer_factory,
+                                allocator);
     CHECK(net_loop_server.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -563,7 +567,7 @@ TEST(tcp_ports, connect_many_servers_many_clients) {
     test::MockConnAcceptor acceptor2;
     acceptor2.push_handler(server_conn_handler2);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config1 = make_server_config("127.0.0.1", 0);
@@ -632,10 +636,12 @@ TEST(tcp_ports, connect_many_servers_many_clients_many_loops) {
     test::MockConnAcceptor acceptor2;
     acceptor2.push_handler(server_conn_handler2);
 
-    NetworkLoop net_loop_client(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop_client(net_loop_config, packet_factory, buffer_factory,
+                                allocator);
     CHECK(net_loop_client.valid());
 
-    NetworkLoop net_loop_server(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop_server(net_loop_config, packet_factory, buffer_factory,
+                                allocator);
     CHECK(net_loop_server.valid());
 
     TcpServerConfig server_config1 = make_server_config("127.0.0.1", 0);
@@ -699,7 +705,7 @@ TEST(tcp_ports, connect_error) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler1);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -739,7 +745,7 @@ TEST(tcp_ports, acceptor_error) {
 
     test::MockConnAcceptor acceptor;
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -790,7 +796,7 @@ TEST(tcp_ports, terminate_client_connection_normal) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -841,7 +847,7 @@ TEST(tcp_ports, terminate_client_connection_failure) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -893,7 +899,7 @@ TEST(tcp_ports, terminate_server_connection_normal) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -944,7 +950,7 @@ TEST(tcp_ports, terminate_server_connection_failure) {
     test::MockConnAcceptor acceptor;
     acceptor.push_handler(server_conn_handler);
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     TcpServerConfig server_config = make_server_config("127.0.0.1", 0);
@@ -11,6 +11,7 @@
 #include "roc_address/socket_addr.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_core/time.h"
 #include "roc_netio/network_loop.h"
 #include "roc_packet/concurrent_queue.h"
 #include "roc_packet/packet_factory.h"
@@ -25,6 +26,7 @@ enum { NumIterations = 20, NumPackets = 10, BufferSize = 125 };
 core::HeapAllocator allocator;
 core::BufferFactory<uint8_t> buffer_factory(allocator, BufferSize, true);
 packet::PacketFactory packet_factory(allocator, true);
+NetworkLoopConfig net_loop_config;
 
 UdpSenderConfig make_sender_config() {
     UdpSenderConfig config;
@@ -114,7 +116,7 @@ TEST(udp_io, one_sender_one_receiver_single_thread_non_blocking_disabled) {
 
     tx_config.non_blocking_enabled = false;
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     packet::IWriter* tx_writer = NULL;
@@ -139,7 +141,7 @@ TEST(udp_io, one_sender_one_receiver_single_loop) {
     UdpSenderConfig tx_config = make_sender_config();
     UdpReceiverConfig rx_config = make_receiver_config();
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     packet::IWriter* tx_writer = NULL;
@@ -164,14 +166,14 @@ TEST(udp_io, one_sender_one_receiver_separate_loops) {
     UdpSenderConfig tx_config = make_sender_config();
     UdpReceiverConfig rx_config = make_receiver_config();
 
-    NetworkLoop tx_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop tx_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(tx_loop.valid());
 
     packet::IWriter* tx_writer = NULL;
     CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
     CHECK(tx_writer);
 
-    NetworkLoop rx_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop rx_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(rx_loop.valid());
     CHECK(add_udp_receiver(rx_loop, rx_config, rx_queue));
 
@@ -196,18 +198,18 @@ TEST(udp_io, one_sender_many_receivers) {
     UdpReceiverConfig rx_config2 = make_receiver_config();
     UdpReceiverConfig rx_config3 = make_receiver_config();
 
-    NetworkLoop tx_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop tx_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(tx_loop.valid());
 
     packet::IWriter* tx_writer = NULL;
     CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
     CHECK(tx_writer);
 
-    NetworkLoop rx1_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop rx1_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(rx1_loop.valid());
     CHECK(add_udp_receiver(rx1_loop, rx_config1, rx_queue1));
 
-    NetworkLoop rx23_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop rx23_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(rx23_loop.valid());
     CHECK(add_udp_receiver(rx23_loop, rx_config2, rx_queue2));
     CHECK(add_udp_receiver(rx23_loop, rx_config3, rx_queue3));
@@ -235,14 +237,14 @@ TEST(udp_io, many_senders_one_receiver) {
 
     UdpReceiverConfig rx_config = make_receiver_config();
 
-    NetworkLoop tx1_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop tx1_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(tx1_loop.valid());
 
     packet::IWriter* tx_writer1 = NULL;
     CHECK(add_udp_sender(tx1_loop, tx_config1, &tx_writer1));
     CHECK(tx_writer1);
 
-    NetworkLoop tx23_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop tx23_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(tx23_loop.valid());
 
     packet::IWriter* tx_writer2 = NULL;
@@ -253,7 +255,7 @@ TEST(udp_io, many_senders_one_receiver) {
     CHECK(add_udp_sender(tx23_loop, tx_config3, &tx_writer3));
     CHECK(tx_writer3);
 
-    NetworkLoop rx_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop rx_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(rx_loop.valid());
     CHECK(add_udp_receiver(rx_loop, rx_config, rx_queue));
 
@@ -279,5 +281,132 @@ TEST(udp_io, many_senders_one_receiver) {
     }
 }
 
+TEST(udp_io, one_sender_one_receiver_busy_poll) {
+    packet::ConcurrentQueue rx_queue;
+
+    UdpSenderConfig tx_config = make_sender_config();
+    UdpReceiverConfig rx_config = make_receiver_config();
+
+    NetworkLoopConfig busy_poll_config;
+    busy_poll_config.busy_poll_budget = core::Millisecond;
+
+    NetworkLoop net_loop(busy_poll_config, packet_factory, buffer_factory, allocator);
+    CHECK(net_loop.valid());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(net_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    CHECK(add_udp_receiver(net_loop, rx_config, rx_queue));
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            tx_writer->write(new_packet(tx_config, rx_config, p));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue.read(), tx_config, rx_config, p);
+        }
+        // let event loop park between iterations
+        core::sleep_for(core::ClockMonotonic, core::Millisecond * 2);
+    }
+}
+
+TEST(udp_io, receive_timestamp) {
+    // user-space timestamps (default) and kernel timestamps
+    for (int kernel = 0; kernel < 2; kernel++) {
+        packet::ConcurrentQueue rx_queue;
+
+        UdpSenderConfig tx_config = make_sender_config();
+        UdpReceiverConfig rx_config = make_receiver_config();
+        rx_config.kernel_timestamps = (kernel != 0);
+
+        NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
+        CHECK(net_loop.valid());
+
+        packet::IWriter* tx_writer = NULL;
+        CHECK(add_udp_sender(net_loop, tx_config, &tx_writer));
+        CHECK(tx_writer);
+
+        CHECK(add_udp_receiver(net_loop, rx_config, rx_queue));
+
+        core::nanoseconds_t prev_ts = 0;
+
+        for (int p = 0; p < NumPackets; p++) {
+            const core::nanoseconds_t send_ts = core::timestamp(core::ClockUnix);
+
+            tx_writer->write(new_packet(tx_config, rx_config, p));
+
+            packet::PacketPtr pp = rx_queue.read();
+            check_packet(pp, tx_config, rx_config, p);
+
+            const core::nanoseconds_t recv_ts = core::timestamp(core::ClockUnix);
+
+            // kernel and user-space timestamps use the same clock, but may be
+            // slightly skewed, hence the tolerance
+            CHECK(pp->udp()->receive_timestamp >= send_ts - core::Millisecond);
+            CHECK(pp->udp()->receive_timestamp <= recv_ts + core::Millisecond);
+            CHECK(pp->udp()->receive_timestamp >= prev_ts);
+
+            prev_ts = pp->udp()->receive_timestamp;
+        }
+    }
+}
+
+TEST(udp_io, sender_inbound_packets) {
+    packet::ConcurrentQueue rx_queue;
+    packet::ConcurrentQueue inbound_queue;
+
+    UdpSenderConfig tx_config = make_sender_config();
+    UdpReceiverConfig rx_config = make_receiver_config();
+
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
+    CHECK(net_loop.valid());
+
+    NetworkLoop::Tasks::AddUdpSenderPort tx_task(tx_config, &inbound_queue);
+    CHECK(net_loop.schedule_and_wait(tx_task));
+    packet::IWriter* tx_writer = tx_task.get_writer();
+    CHECK(tx_writer);
+
+    CHECK(add_udp_receiver(net_loop, rx_config, rx_queue));
+
+    // remote peer replies to sender from its own port
+    UdpSenderConfig peer_config = make_sender_config();
+    packet::IWriter* peer_writer = NULL;
+    CHECK(add_udp_sender(net_loop, peer_config, &peer_writer));
+    CHECK(peer_writer);
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            tx_writer->write(new_packet(tx_config, rx_config, p));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue.read(), tx_config, rx_config, p);
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            packet::PacketPtr pp = packet_factory.new_packet();
+            CHECK(pp);
+
+            pp->add_flags(packet::Packet::FlagUDP);
+            pp->udp()->dst_addr = tx_config.bind_address;
+            pp->set_data(new_buffer(p));
+
+            peer_writer->write(pp);
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            packet::PacketPtr pp = inbound_queue.read();
+            CHECK(pp);
+            CHECK(pp->udp());
+
+            CHECK(pp->udp()->src_addr == peer_config.bind_address);
+            CHECK(pp->udp()->dst_addr == tx_config.bind_address);
+
+            core::Slice<uint8_t> expected = new_buffer(p);
+
+            UNSIGNED_LONGS_EQUAL(expected.size(), pp->data().size());
+            CHECK(memcmp(pp->data().data(), expected.data(), expected.size()) == 0);
+        }
+    }
+}
+
 } // namespace netio
 } // namespace roc
@@ -25,6 +25,7 @@ enum { MaxBufSize = 500 };
 core::HeapAllocator allocator;
 core::BufferFactory<uint8_t> buffer_factory(allocator, MaxBufSize, true);
 packet::PacketFactory packet_factory(allocator, true);
+NetworkLoopConfig net_loop_config;
 
 UdpSenderConfig make_sender_config(const char* ip, int port) {
     UdpSenderConfig config;
@@ -76,7 +77,7 @@ void remove_port(NetworkLoop& net_loop, NetworkLoop::PortHandle handle) {
 TEST_GROUP(udp_ports) {};
 
 TEST(udp_ports, no_ports) {
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     UNSIGNED_LONGS_EQUAL(0, net_loop.num_ports());
@@ -85,7 +86,7 @@ TEST(udp_ports, no_ports) {
 TEST(udp_ports, add_anyaddr) {
     packet::ConcurrentQueue queue;
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     UdpSenderConfig tx_config = make_sender_config("0.0.0.0", 0);
@@ -109,7 +110,7 @@ TEST(udp_ports, add_anyaddr) {
 TEST(udp_ports, add_localhost) {
     packet::ConcurrentQueue queue;
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     UdpSenderConfig tx_config = make_sender_config("127.0.0.1", 0);
@@ -133,7 +134,7 @@ TEST(udp_ports, add_localhost) {
 TEST(udp_ports, add_addrinuse) {
     packet::ConcurrentQueue queue;
 
-    NetworkLoop net_loop1(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop1(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop1.valid());
 
     UdpSenderConfig tx_config = make_sender_config("127.0.0.1", 0);
@@ -153,7 +154,7 @@ TEST(udp_ports, add_addrinuse) {
 
     UNSIGNED_LONGS_EQUAL(2, net_loop1.num_ports());
 
-    NetworkLoop net_loop2(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop2(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop2.valid());
 
     UNSIGNED_LONGS_EQUAL(0, net_loop2.num_ports());
@@ -168,7 +169,7 @@ TEST(udp_ports, add_addrinuse) {
 TEST(udp_ports, add_broadcast_sender) {
     packet::ConcurrentQueue queue;
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     UNSIGNED_LONGS_EQUAL(0, net_loop.num_ports());
@@ -184,7 +185,7 @@ TEST(udp_ports, add_broadcast_sender) {
 TEST(udp_ports, add_multicast_receiver) {
     packet::ConcurrentQueue queue;
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     UNSIGNED_LONGS_EQUAL(0, net_loop.num_ports());
@@ -208,7 +209,7 @@ TEST(udp_ports, add_multicast_receiver) {
 TEST(udp_ports, add_multicast_receiver_error) {
     packet::ConcurrentQueue queue;
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     UNSIGNED_LONGS_EQUAL(0, net_loop.num_ports());
@@ -239,7 +240,7 @@ TEST(udp_ports, add_multicast_receiver_error) {
 TEST(udp_ports, add_remove) {
     packet::ConcurrentQueue queue;
 
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     UdpSenderConfig tx_config = make_sender_config("0.0.0.0", 0);
@@ -265,7 +266,7 @@ TEST(udp_ports, add_remove) {
 }
 
 TEST(udp_ports, add_remove_add) {
-    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    NetworkLoop net_loop(net_loop_config, packet_factory, buffer_factory, allocator);
     CHECK(net_loop.valid());
 
     UdpSenderConfig tx_config = make_sender_config("0.0.0.0", 0);
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_packet/block_interleaver.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace packet {
+namespace {
+
+// Simulates bursty loss channel behind block interleaver and measures
+// residual loss after FEC repair versus added latency.
+//
+// Each iteration sends one group of FEC blocks through the interleaver and
+// a Gilbert-Elliott channel. The code is assumed to be ideal (MDS), i.e. a
+// block is repaired if it lost no more packets than it has repair packets,
+// which is the upper bound for any real block codec.
+//
+// Argument is interleaving depth, i.e. number of blocks in group.
+//
+// Reported counters:
+//  raw_loss       - percentage of packets lost in channel
+//  residual_loss  - percentage of source packets not repaired
+//  latency        - reordering delay added by interleaver, in packets
+
+enum {
+    SourceLen = 20,
+    RepairLen = 5,
+    BlockLen = SourceLen + RepairLen,
+    MaxDepth = 8,
+
+    // Gilbert-Elliott channel, per 10000
+    GoodToBad = 100,
+    BadToGood = 1500
+};
+
+core::HeapAllocator allocator;
+PacketFactory packet_factory(allocator, true);
+
+class BurstyChannel : public IWriter {
+public:
+    BurstyChannel()
+        : bad_(false)
+        , n_sent_(0)
+        , n_lost_(0) {
+        reset_blocks();
+    }
+
+    virtual void write(const PacketPtr& pp) {
+        if (bad_) {
+            bad_ = core::fast_random(0, 9999) >= BadToGood;
+        } else {
+            bad_ = core::fast_random(0, 9999) < GoodToBad;
+        }
+
+        n_sent_++;
+
+        if (!bad_) {
+            return;
+        }
+
+        n_lost_++;
+
+        const size_t blk = pp->fec()->source_block_number % MaxDepth;
+
+        lost_[blk]++;
+        if (pp->fec()->encoding_symbol_id < SourceLen) {
+            lost_source_[blk]++;
+        }
+    }
+
+    // Returns number of source packets that can't be repaired.
+    size_t unrepaired(blknum_t sbn) const {
+        const size_t blk = sbn % MaxDepth;
+        return lost_[blk] > RepairLen ? lost_source_[blk] : 0;
+    }
+
+    void reset_blocks() {
+        for (size_t n = 0; n < MaxDepth; n++) {
+            lost_[n] = 0;
+            lost_source_[n] = 0;
+        }
+    }
+
+    size_t n_sent() const {
+        return n_sent_;
+    }
+
+    size_t n_lost() const {
+        return n_lost_;
+    }
+
+private:
+    bool bad_;
+
+    size_t n_sent_;
+    size_t n_lost_;
+
+    size_t lost_[MaxDepth];
+    size_t lost_source_[MaxDepth];
+};
+
+void BM_BlockInterleaver_BurstLoss(benchmark::State& state) {
+    const size_t depth = (size_t)state.range(0);
+
+    BurstyChannel channel;
+
+    BlockInterleaver interleaver(channel, allocator, MaxDepth, BlockLen);
+    roc_panic_if(!interleaver.valid());
+
+    interleaver.set_depth(depth);
+
+    PacketPtr packets[MaxDepth * BlockLen];
+
+    for (size_t n = 0; n < MaxDepth * BlockLen; n++) {
+        packets[n] = packet_factory.new_packet();
+        roc_panic_if(!packets[n]);
+
+        packets[n]->add_flags(Packet::FlagFEC);
+        packets[n]->fec()->encoding_symbol_id = n % BlockLen;
+        packets[n]->fec()->source_block_length = SourceLen;
+        packets[n]->fec()->block_length = BlockLen;
+    }
+
+    blknum_t sbn = 0;
+
+    size_t n_source = 0;
+    size_t n_unrepaired = 0;
+
+    while (state.KeepRunning()) {
+        for (size_t blk = 0; blk < depth; blk++) {
+            for (size_t esi = 0; esi < BlockLen; esi++) {
+                PacketPtr& pp = packets[blk * BlockLen + esi];
+                pp->fec()->source_block_number = blknum_t(sbn + blk);
+                interleaver.write(pp);
+            }
+        }
+
+        // whole group was sent when its last packet was written
+        for (size_t blk = 0; blk < depth; blk++) {
+            n_unrepaired += channel.unrepaired(blknum_t(sbn + blk));
+        }
+        n_source += depth * SourceLen;
+
+        channel.reset_blocks();
+        sbn = blknum_t(sbn + depth);
+    }
+
+    state.counters["raw_loss"] =
+        channel.n_sent() ? double(channel.n_lost()) * 100 / channel.n_sent() : 0;
+    state.counters["residual_loss"] =
+        n_source ? double(n_unrepaired) * 100 / n_source : 0;
+    state.counters["latency"] = depth > 1 ? double(depth * BlockLen) : 0;
+}
+
+BENCHMARK(BM_BlockInterleaver_BurstLoss)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(MaxDepth)
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace packet
+} // namespace roc
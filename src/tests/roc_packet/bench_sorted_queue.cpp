@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/sorted_queue.h"
+
+namespace roc {
+namespace packet {
+namespace {
+
+// Measures cost of SortedQueue::write() for RTP packets, which is dominated
+// by reading compare keys of packets already in queue, and thus by Packet
+// layout.
+//
+// Queue is kept at constant depth: every iteration writes one packet and
+// reads one packet. Packets are preallocated, so allocation is not measured.
+//
+// Bench_InOrder    - every packet is newer than all queued ones
+// Bench_Reordered  - every second packet is late and is inserted deep into
+//                    queue, walking over most of queued packets
+//
+// Argument is queue depth.
+
+enum { NumPackets = 8192 };
+
+core::HeapAllocator allocator;
+PacketFactory packet_factory(allocator, true);
+
+class PacketStream {
+public:
+    PacketStream(size_t depth, bool reordered)
+        : pos_(0)
+        , base_sn_(0) {
+        size_t n = 0;
+
+        if (!reordered) {
+            for (; n < NumPackets; n++) {
+                seqnums_[n] = seqnum_t(n);
+            }
+        } else {
+            // odd packets are delayed by depth/2 even packets
+            const size_t delay = depth / 2;
+
+            for (size_t k = 0; n < NumPackets; k++) {
+                seqnums_[n++] = seqnum_t(k * 2);
+
+                if (k >= delay && n < NumPackets) {
+                    seqnums_[n++] = seqnum_t((k - delay) * 2 + 1);
+                }
+            }
+        }
+
+        for (n = 0; n < NumPackets; n++) {
+            packets_[n] = packet_factory.new_packet();
+            roc_panic_if(!packets_[n]);
+
+            packets_[n]->add_flags(Packet::FlagRTP);
+            packets_[n]->rtp()->seqnum = seqnums_[n];
+        }
+    }
+
+    bool has_next() const {
+        return pos_ < NumPackets;
+    }
+
+    const PacketPtr& next() {
+        return packets_[pos_++];
+    }
+
+    // Renumber packets to continue stream, must be called when no
+    // packets are in queue.
+    void restart() {
+        base_sn_ = seqnum_t(base_sn_ + NumPackets * 2);
+
+        for (size_t n = 0; n < NumPackets; n++) {
+            packets_[n]->rtp()->seqnum = seqnum_t(base_sn_ + seqnums_[n]);
+        }
+
+        pos_ = 0;
+    }
+
+private:
+    PacketPtr packets_[NumPackets];
+    seqnum_t seqnums_[NumPackets];
+
+    size_t pos_;
+    seqnum_t base_sn_;
+};
+
+void run_queue(benchmark::State& state, bool reordered) {
+    const size_t depth = (size_t)state.range(0);
+
+    PacketStream stream(depth, reordered);
+    SortedQueue queue(0);
+
+    while (state.KeepRunning()) {
+        if (!stream.has_next()) {
+            state.PauseTiming();
+            while (queue.read()) {
+            }
+            stream.restart();
+            state.ResumeTiming();
+        }
+
+        queue.write(stream.next());
+
+        if (queue.size() > depth) {
+            queue.read();
+        }
+    }
+}
+
+void BM_SortedQueue_InOrder(benchmark::State& state) {
+    run_queue(state, false);
+}
+
+BENCHMARK(BM_SortedQueue_InOrder)
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(2048)
+    ->Unit(benchmark::kNanosecond);
+
+void BM_SortedQueue_Reordered(benchmark::State& state) {
+    run_queue(state, true);
+}
+
+BENCHMARK(BM_SortedQueue_Reordered)
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(2048)
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace packet
+} // namespace roc
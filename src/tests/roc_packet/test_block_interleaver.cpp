@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/block_interleaver.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+enum { MaxDepth = 4, SourceLen = 3, RepairLen = 2, BlockLen = SourceLen + RepairLen };
+
+core::HeapAllocator allocator;
+PacketFactory packet_factory(allocator, true);
+
+PacketPtr new_packet(blknum_t sbn, size_t esi, size_t blen = BlockLen) {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagFEC);
+    packet->fec()->source_block_number = sbn;
+    packet->fec()->encoding_symbol_id = esi;
+    packet->fec()->source_block_length = SourceLen;
+    packet->fec()->block_length = blen;
+
+    return packet;
+}
+
+void write_block(IWriter& writer, blknum_t sbn, size_t blen = BlockLen) {
+    for (size_t esi = 0; esi < blen; esi++) {
+        writer.write(new_packet(sbn, esi, blen));
+    }
+}
+
+void expect_packet(Queue& queue, blknum_t sbn, size_t esi) {
+    PacketPtr pp = queue.read();
+    CHECK(pp);
+    CHECK(pp->fec());
+
+    LONGS_EQUAL(sbn, pp->fec()->source_block_number);
+    LONGS_EQUAL(esi, pp->fec()->encoding_symbol_id);
+}
+
+void expect_group(Queue& queue, blknum_t first_sbn, size_t depth, size_t blen) {
+    for (size_t esi = 0; esi < blen; esi++) {
+        for (size_t blk = 0; blk < depth; blk++) {
+            expect_packet(queue, blknum_t(first_sbn + blk), esi);
+        }
+    }
+}
+
+} // namespace
+
+TEST_GROUP(block_interleaver) {};
+
+TEST(block_interleaver, column_order) {
+    enum { NumGroups = 3 };
+
+    Queue queue;
+    BlockInterleaver interleaver(queue, allocator, MaxDepth, BlockLen);
+
+    CHECK(interleaver.valid());
+    LONGS_EQUAL(MaxDepth, interleaver.depth());
+
+    for (size_t n_group = 0; n_group < NumGroups; n_group++) {
+        const blknum_t first_sbn = blknum_t(n_group * MaxDepth);
+
+        for (size_t blk = 0; blk < MaxDepth; blk++) {
+            LONGS_EQUAL(0, queue.size());
+            write_block(interleaver, blknum_t(first_sbn + blk));
+        }
+
+        // group is sent as soon as its last block is complete
+        LONGS_EQUAL(MaxDepth * BlockLen, queue.size());
+        expect_group(queue, first_sbn, MaxDepth, BlockLen);
+    }
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(block_interleaver, depth_one) {
+    Queue queue;
+    BlockInterleaver interleaver(queue, allocator, MaxDepth, BlockLen);
+
+    CHECK(interleaver.valid());
+
+    interleaver.set_depth(1);
+    LONGS_EQUAL(1, interleaver.depth());
+
+    for (size_t esi = 0; esi < BlockLen; esi++) {
+        interleaver.write(new_packet(0, esi));
+
+        LONGS_EQUAL(1, queue.size());
+        expect_packet(queue, 0, esi);
+    }
+}
+
+TEST(block_interleaver, clamp_depth) {
+    Queue queue;
+    BlockInterleaver interleaver(queue, allocator, MaxDepth, BlockLen);
+
+    CHECK(interleaver.valid());
+
+    interleaver.set_depth(0);
+    LONGS_EQUAL(1, interleaver.depth());
+
+    interleaver.set_depth(MaxDepth + 1);
+    LONGS_EQUAL(MaxDepth, interleaver.depth());
+}
+
+TEST(block_interleaver, change_depth) {
+    Queue queue;
+    BlockInterleaver interleaver(queue, allocator, MaxDepth, BlockLen);
+
+    CHECK(interleaver.valid());
+
+    interleaver.set_depth(2);
+
+    write_block(interleaver, 0);
+
+    // current group keeps its depth
+    interleaver.set_depth(3);
+
+    write_block(interleaver, 1);
+
+    LONGS_EQUAL(2 * BlockLen, queue.size());
+    expect_group(queue, 0, 2, BlockLen);
+
+    // next group uses new depth
+    write_block(interleaver, 2);
+    write_block(interleaver, 3);
+    LONGS_EQUAL(0, queue.size());
+
+    write_block(interleaver, 4);
+
+    LONGS_EQUAL(3 * BlockLen, queue.size());
+    expect_group(queue, 2, 3, BlockLen);
+
+    // disable interleaving
+    interleaver.set_depth(1);
+
+    write_block(interleaver, 5);
+
+    LONGS_EQUAL(BlockLen, queue.size());
+    expect_group(queue, 5, 1, BlockLen);
+}
+
+TEST(block_interleaver, group_begins_at_block_boundary) {
+    Queue queue;
+    BlockInterleaver interleaver(queue, allocator, MaxDepth, BlockLen);
+
+    CHECK(interleaver.valid());
+
+    interleaver.set_depth(1);
+
+    interleaver.write(new_packet(0, 0));
+    interleaver.write(new_packet(0, 1));
+
+    interleaver.set_depth(2);
+
+    // rest of current block is not delayed
+    for (size_t esi = 2; esi < BlockLen; esi++) {
+        interleaver.write(new_packet(0, esi));
+    }
+
+    LONGS_EQUAL(BlockLen, queue.size());
+    expect_group(queue, 0, 1, BlockLen);
+
+    // next block begins new group
+    write_block(interleaver, 1);
+    LONGS_EQUAL(0, queue.size());
+
+    write_block(interleaver, 2);
+
+    LONGS_EQUAL(2 * BlockLen, queue.size());
+    expect_group(queue, 1, 2, BlockLen);
+}
+
+TEST(block_interleaver, varying_block_length) {
+    Queue queue;
+    BlockInterleaver interleaver(queue, allocator, MaxDepth, BlockLen);
+
+    CHECK(interleaver.valid());
+
+    interleaver.set_depth(2);
+
+    write_block(interleaver, 0, BlockLen);
+    write_block(interleaver, 1, BlockLen - 1);
+
+    LONGS_EQUAL(BlockLen * 2 - 1, queue.size());
+
+    for (size_t esi = 0; esi < BlockLen; esi++) {
+        expect_packet(queue, 0, esi);
+        if (esi < BlockLen - 1) {
+            expect_packet(queue, 1, esi);
+        }
+    }
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(block_interleaver, skipped_blocks) {
+    Queue queue;
+    BlockInterleaver interleaver(queue, allocator, MaxDepth, BlockLen);
+
+    CHECK(interleaver.valid());
+
+    interleaver.set_depth(2);
+
+    write_block(interleaver, 0);
+    LONGS_EQUAL(0, queue.size());
+
+    // block from next group ends current one
+    interleaver.write(new_packet(5, 0));
+
+    LONGS_EQUAL(BlockLen, queue.size());
+    expect_group(queue, 0, 1, BlockLen);
+
+    for (size_t esi = 1; esi < BlockLen; esi++) {
+        interleaver.write(new_packet(5, esi));
+    }
+    write_block(interleaver, 6);
+
+    LONGS_EQUAL(2 * BlockLen, queue.size());
+    expect_group(queue, 5, 2, BlockLen);
+}
+
+TEST(block_interleaver, flush) {
+    Queue queue;
+    BlockInterleaver interleaver(queue, allocator, MaxDepth, BlockLen);
+
+    CHECK(interleaver.valid());
+
+    write_block(interleaver, 0);
+    interleaver.write(new_packet(1, 0));
+    interleaver.write(new_packet(1, 1));
+
+    LONGS_EQUAL(0, queue.size());
+
+    interleaver.flush();
+
+    LONGS_EQUAL(BlockLen + 2, queue.size());
+
+    expect_packet(queue, 0, 0);
+    expect_packet(queue, 1, 0);
+    expect_packet(queue, 0, 1);
+    expect_packet(queue, 1, 1);
+
+    for (size_t esi = 2; esi < BlockLen; esi++) {
+        expect_packet(queue, 0, esi);
+    }
+
+    LONGS_EQUAL(0, queue.size());
+
+    // flush of empty interleaver is no-op
+    interleaver.flush();
+    LONGS_EQUAL(0, queue.size());
+
+    // new group begins after flush
+    for (size_t blk = 0; blk < MaxDepth; blk++) {
+        write_block(interleaver, blknum_t(2 + blk));
+    }
+
+    LONGS_EQUAL(MaxDepth * BlockLen, queue.size());
+    expect_group(queue, 2, MaxDepth, BlockLen);
+}
+
+TEST(block_interleaver, pass_through) {
+    Queue queue;
+    BlockInterleaver interleaver(queue, allocator, MaxDepth, BlockLen);
+
+    CHECK(interleaver.valid());
+
+    interleaver.write(new_packet(10, 0));
+    LONGS_EQUAL(0, queue.size());
+
+    // packet without fec fields
+    {
+        PacketPtr pp = packet_factory.new_packet();
+        CHECK(pp);
+        pp->add_flags(Packet::FlagRTP);
+
+        interleaver.write(pp);
+
+        LONGS_EQUAL(1, queue.size());
+        CHECK(queue.read() == pp);
+    }
+
+    // packet with too large esi
+    interleaver.write(new_packet(10, BlockLen, BlockLen + 1));
+    LONGS_EQUAL(1, queue.size());
+    expect_packet(queue, 10, BlockLen);
+
+    // packet from previous group
+    interleaver.write(new_packet(9, 1));
+    LONGS_EQUAL(1, queue.size());
+    expect_packet(queue, 9, 1);
+
+    // duplicate packet
+    interleaver.write(new_packet(10, 0));
+    LONGS_EQUAL(1, queue.size());
+    expect_packet(queue, 10, 0);
+
+    interleaver.flush();
+    LONGS_EQUAL(1, queue.size());
+    expect_packet(queue, 10, 0);
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/deduplicator.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+core::HeapAllocator allocator;
+PacketFactory packet_factory(allocator, true);
+
+PacketPtr new_packet(seqnum_t sn) {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagRTP);
+    packet->rtp()->seqnum = sn;
+
+    return packet;
+}
+
+void expect_written(Queue& queue, Deduplicator& dedup, seqnum_t sn, bool written) {
+    const size_t queue_size = queue.size();
+
+    dedup.write(new_packet(sn));
+
+    if (written) {
+        LONGS_EQUAL(queue_size + 1, queue.size());
+        PacketPtr pp = queue.read();
+        CHECK(pp);
+        LONGS_EQUAL(sn, pp->rtp()->seqnum);
+    } else {
+        LONGS_EQUAL(queue_size, queue.size());
+    }
+}
+
+} // namespace
+
+TEST_GROUP(deduplicator) {};
+
+TEST(deduplicator, no_duplicates) {
+    Queue queue;
+    Deduplicator dedup(queue);
+
+    for (seqnum_t sn = 0; sn < 5000; sn++) {
+        expect_written(queue, dedup, sn, true);
+    }
+
+    LONGS_EQUAL(5000, dedup.n_passed_packets());
+    LONGS_EQUAL(0, dedup.n_duplicate_packets());
+}
+
+TEST(deduplicator, every_packet_twice) {
+    Queue queue;
+    Deduplicator dedup(queue);
+
+    for (seqnum_t sn = 0; sn < 5000; sn++) {
+        expect_written(queue, dedup, sn, true);
+        expect_written(queue, dedup, sn, false);
+    }
+
+    LONGS_EQUAL(5000, dedup.n_passed_packets());
+    LONGS_EQUAL(5000, dedup.n_duplicate_packets());
+}
+
+TEST(deduplicator, delayed_path) {
+    enum { Delay = 100 };
+
+    Queue queue;
+    Deduplicator dedup(queue);
+
+    // second path is behind first one by Delay packets
+    for (seqnum_t sn = 0; sn < 5000; sn++) {
+        expect_written(queue, dedup, sn, true);
+
+        if (sn >= Delay) {
+            expect_written(queue, dedup, seqnum_t(sn - Delay), false);
+        }
+    }
+}
+
+TEST(deduplicator, reordered_and_lost) {
+    Queue queue;
+    Deduplicator dedup(queue);
+
+    expect_written(queue, dedup, 10, true);
+    expect_written(queue, dedup, 12, true);
+
+    // 11 arrives late on first path, then on second path
+    expect_written(queue, dedup, 11, true);
+    expect_written(queue, dedup, 11, false);
+
+    // 13 is lost on first path and arrives on second path
+    expect_written(queue, dedup, 14, true);
+    expect_written(queue, dedup, 13, true);
+    expect_written(queue, dedup, 14, false);
+    expect_written(queue, dedup, 12, false);
+}
+
+TEST(deduplicator, seqnum_overflow) {
+    Queue queue;
+    Deduplicator dedup(queue);
+
+    for (seqnum_t sn = 65530; sn != 10; sn++) {
+        expect_written(queue, dedup, sn, true);
+    }
+
+    for (seqnum_t sn = 65530; sn != 10; sn++) {
+        expect_written(queue, dedup, sn, false);
+    }
+}
+
+TEST(deduplicator, jump_forward) {
+    Queue queue;
+    Deduplicator dedup(queue);
+
+    expect_written(queue, dedup, 100, true);
+    expect_written(queue, dedup, 100 + Deduplicator::WindowSize * 3, true);
+
+    // window was reset, old seqnums are forgotten
+    expect_written(queue, dedup, 100 + Deduplicator::WindowSize * 2 + 1, true);
+    expect_written(queue, dedup, 100 + Deduplicator::WindowSize * 2 + 1, false);
+
+    // too old to be checked
+    expect_written(queue, dedup, 100, true);
+    expect_written(queue, dedup, 100, true);
+}
+
+TEST(deduplicator, window_boundary) {
+    Queue queue;
+    Deduplicator dedup(queue);
+
+    expect_written(queue, dedup, 0, true);
+    expect_written(queue, dedup, Deduplicator::WindowSize - 1, true);
+
+    // still in window
+    expect_written(queue, dedup, 0, false);
+
+    // 0 leaves window, and its slot is reused by new seqnum
+    expect_written(queue, dedup, Deduplicator::WindowSize, true);
+    expect_written(queue, dedup, Deduplicator::WindowSize, false);
+    expect_written(queue, dedup, 1, true);
+}
+
+TEST(deduplicator, non_rtp_packets) {
+    Queue queue;
+    Deduplicator dedup(queue);
+
+    for (size_t n = 0; n < 6; n++) {
+        PacketPtr packet = packet_factory.new_packet();
+        CHECK(packet);
+
+        dedup.write(packet);
+    }
+
+    LONGS_EQUAL(6, queue.size());
+    LONGS_EQUAL(6, dedup.n_passed_packets());
+}
+
+} // namespace packet
+} // namespace roc
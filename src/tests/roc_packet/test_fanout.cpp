@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/fanout.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+enum { BufSize = 100 };
+
+core::HeapAllocator allocator;
+PacketFactory packet_factory(allocator, true);
+core::BufferFactory<uint8_t> buffer_factory(allocator, BufSize, true);
+
+PacketPtr new_packet(seqnum_t sn) {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagRTP | Packet::FlagAudio);
+    packet->rtp()->seqnum = sn;
+
+    core::Slice<uint8_t> data = buffer_factory.new_buffer();
+    CHECK(data);
+    packet->set_data(data);
+
+    return packet;
+}
+
+// composes packet and assigns address, like sender endpoint does
+class ComposingWriter : public IWriter {
+public:
+    ComposingWriter()
+        : n_composed_(0) {
+    }
+
+    virtual void write(const PacketPtr& packet) {
+        packet->add_flags(Packet::FlagUDP);
+
+        if ((packet->flags() & Packet::FlagComposed) == 0) {
+            packet->add_flags(Packet::FlagComposed);
+            n_composed_++;
+        }
+
+        queue_.write(packet);
+    }
+
+    PacketPtr read() {
+        return queue_.read();
+    }
+
+    size_t num_composed() const {
+        return n_composed_;
+    }
+
+private:
+    Queue queue_;
+    size_t n_composed_;
+};
+
+} // namespace
+
+TEST_GROUP(fanout) {};
+
+TEST(fanout, no_outputs) {
+    Fanout fanout(packet_factory, allocator);
+
+    PacketPtr p = new_packet(0);
+    fanout.write(p);
+
+    LONGS_EQUAL(1, p->getref());
+}
+
+TEST(fanout, one_output) {
+    Fanout fanout(packet_factory, allocator);
+
+    Queue queue;
+    CHECK(fanout.add_output(queue));
+    LONGS_EQUAL(1, fanout.num_outputs());
+
+    PacketPtr p = new_packet(0);
+    fanout.write(p);
+
+    CHECK(queue.read() == p);
+    CHECK(!queue.read());
+}
+
+TEST(fanout, many_outputs) {
+    enum { NumOutputs = 10, NumPackets = 5 };
+
+    Fanout fanout(packet_factory, allocator);
+
+    ComposingWriter writers[NumOutputs];
+    for (size_t n = 0; n < NumOutputs; n++) {
+        CHECK(fanout.add_output(writers[n]));
+    }
+    LONGS_EQUAL(NumOutputs, fanout.num_outputs());
+
+    for (seqnum_t sn = 0; sn < NumPackets; sn++) {
+        PacketPtr p = new_packet(sn);
+        fanout.write(p);
+
+        for (size_t n = 0; n < NumOutputs; n++) {
+            PacketPtr pp = writers[n].read();
+            CHECK(pp);
+
+            if (n == 0) {
+                CHECK(pp == p);
+            } else {
+                CHECK(pp != p);
+            }
+
+            // each output has its own packet with own udp header,
+            // but they all share the same buffer
+            CHECK(pp->udp());
+            CHECK(pp->rtp());
+            CHECK(pp->flags() & Packet::FlagAudio);
+            CHECK(pp->flags() & Packet::FlagComposed);
+            LONGS_EQUAL(sn, pp->rtp()->seqnum);
+            POINTERS_EQUAL(p->data().data(), pp->data().data());
+        }
+    }
+
+    // packet is composed only once
+    for (size_t n = 0; n < NumOutputs; n++) {
+        LONGS_EQUAL(n == 0 ? NumPackets : 0, writers[n].num_composed());
+        CHECK(!writers[n].read());
+    }
+}
+
+TEST(fanout, remove_output) {
+    Fanout fanout(packet_factory, allocator);
+
+    Queue queue1;
+    Queue queue2;
+    Queue queue3;
+    CHECK(fanout.add_output(queue1));
+    CHECK(fanout.add_output(queue2));
+    CHECK(fanout.add_output(queue3));
+
+    fanout.remove_output(queue1);
+    LONGS_EQUAL(2, fanout.num_outputs());
+
+    PacketPtr p = new_packet(0);
+    fanout.write(p);
+
+    CHECK(!queue1.read());
+    CHECK(queue2.read() == p);
+    CHECK(queue3.read());
+
+    fanout.remove_output(queue3);
+    LONGS_EQUAL(1, fanout.num_outputs());
+
+    fanout.write(new_packet(1));
+
+    CHECK(queue2.read());
+    CHECK(!queue3.read());
+}
+
+} // namespace packet
+} // namespace roc
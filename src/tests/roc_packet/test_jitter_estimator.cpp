@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/jitter_estimator.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+#include "roc_pipeline/config.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+enum { SampleRate = 1000, NumSamples = 10, NumPackets = 1000 };
+
+const core::nanoseconds_t NsPerPacket = core::Second / SampleRate * NumSamples;
+const core::nanoseconds_t StartTime = 1000 * core::Second;
+
+const audio::SampleSpec SampleSpecs =
+    audio::SampleSpec(SampleRate, pipeline::DefaultChannelMask);
+
+core::HeapAllocator allocator;
+PacketFactory packet_factory(allocator, true);
+
+PacketPtr new_packet(seqnum_t sn, core::nanoseconds_t recv_ts) {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagUDP | Packet::FlagRTP);
+    packet->udp()->receive_timestamp = recv_ts;
+    packet->rtp()->seqnum = sn;
+    packet->rtp()->timestamp = timestamp_t(sn * NumSamples);
+
+    return packet;
+}
+
+} // namespace
+
+TEST_GROUP(jitter_estimator) {};
+
+TEST(jitter_estimator, forward_packets) {
+    Queue queue;
+    JitterEstimator je(queue, SampleSpecs);
+
+    for (seqnum_t n = 0; n < 10; n++) {
+        PacketPtr packet = new_packet(n, StartTime + n * NsPerPacket);
+        je.write(packet);
+        CHECK(queue.read() == packet);
+    }
+
+    CHECK(!queue.read());
+}
+
+TEST(jitter_estimator, no_jitter) {
+    Queue queue;
+    JitterEstimator je(queue, SampleSpecs);
+
+    LONGS_EQUAL(0, je.jitter());
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        je.write(new_packet(n, StartTime + n * NsPerPacket));
+    }
+
+    LONGS_EQUAL(0, je.jitter());
+    UNSIGNED_LONGS_EQUAL(NumPackets, je.n_packets());
+}
+
+TEST(jitter_estimator, constant_delay) {
+    Queue queue;
+    JitterEstimator je(queue, SampleSpecs);
+
+    // constant transit time is not jitter
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        je.write(new_packet(n, StartTime + n * NsPerPacket + 50 * core::Millisecond));
+    }
+
+    LONGS_EQUAL(0, je.jitter());
+}
+
+TEST(jitter_estimator, alternating_delay) {
+    Queue queue;
+    JitterEstimator je(queue, SampleSpecs);
+
+    const core::nanoseconds_t delta = core::Millisecond;
+
+    // every second packet is delayed by delta, so |D| is always delta,
+    // and jitter converges to delta
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        const core::nanoseconds_t delay = (n % 2) ? delta : 0;
+        je.write(new_packet(n, StartTime + n * NsPerPacket + delay));
+    }
+
+    CHECK(je.jitter() > delta * 99 / 100);
+    CHECK(je.jitter() <= delta);
+}
+
+TEST(jitter_estimator, reordered) {
+    Queue queue;
+    JitterEstimator je(queue, SampleSpecs);
+
+    // packets are received in arrival order, which may differ from sending
+    // order; D is computed between consecutively received packets
+    je.write(new_packet(1, StartTime + 1 * NsPerPacket));
+    je.write(new_packet(0, StartTime + 1 * NsPerPacket));
+
+    LONGS_EQUAL(NsPerPacket / 16, je.jitter());
+}
+
+TEST(jitter_estimator, skip_packets_without_timestamp) {
+    Queue queue;
+    JitterEstimator je(queue, SampleSpecs);
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        if (n % 3 == 0) {
+            je.write(new_packet(n, 0));
+        } else {
+            je.write(new_packet(n, StartTime + n * NsPerPacket));
+        }
+    }
+
+    LONGS_EQUAL(0, je.jitter());
+    UNSIGNED_LONGS_EQUAL(NumPackets - (NumPackets + 2) / 3, je.n_packets());
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, queue.size());
+}
+
+TEST(jitter_estimator, skip_packets_without_udp) {
+    Queue queue;
+    JitterEstimator je(queue, SampleSpecs);
+
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+    packet->add_flags(Packet::FlagRTP);
+
+    je.write(packet);
+
+    UNSIGNED_LONGS_EQUAL(0, je.n_packets());
+    CHECK(queue.read() == packet);
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/loss_tracker.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+enum { Source = 123 };
+
+core::HeapAllocator allocator;
+PacketFactory packet_factory(allocator, true);
+
+PacketPtr new_packet(seqnum_t sn) {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagRTP);
+    packet->rtp()->source = Source;
+    packet->rtp()->seqnum = sn;
+
+    return packet;
+}
+
+void write_packets(LossTracker& lt, seqnum_t begin, size_t n_packets) {
+    for (size_t n = 0; n < n_packets; n++) {
+        lt.write(new_packet(seqnum_t(begin + n)));
+    }
+}
+
+void check_runs(const LossRuns& runs,
+                seqnum_t begin,
+                const seqnum_t* expected,
+                size_t n_expected) {
+    UNSIGNED_LONGS_EQUAL(begin, runs.begin);
+    UNSIGNED_LONGS_EQUAL(n_expected, runs.n_runs);
+
+    for (size_t n = 0; n < n_expected; n++) {
+        UNSIGNED_LONGS_EQUAL(expected[n], runs.runs[n]);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(loss_tracker) {};
+
+TEST(loss_tracker, forward_packets) {
+    Queue queue;
+    LossTracker lt(queue);
+
+    for (seqnum_t n = 0; n < 10; n++) {
+        PacketPtr packet = new_packet(n);
+        lt.write(packet);
+        CHECK(queue.read() == packet);
+    }
+
+    CHECK(!queue.read());
+}
+
+TEST(loss_tracker, no_packets) {
+    Queue queue;
+    LossTracker lt(queue);
+
+    UNSIGNED_LONGS_EQUAL(0, lt.n_received());
+    LONGS_EQUAL(0, lt.n_lost());
+    DOUBLES_EQUAL(0, lt.report_fract_loss(), 0);
+
+    LossRuns runs;
+    lt.report_loss_runs(runs);
+    UNSIGNED_LONGS_EQUAL(0, runs.n_runs);
+}
+
+TEST(loss_tracker, no_losses) {
+    Queue queue;
+    LossTracker lt(queue);
+
+    write_packets(lt, 100, 50);
+
+    UNSIGNED_LONGS_EQUAL(Source, lt.source());
+    UNSIGNED_LONGS_EQUAL(50, lt.n_received());
+    LONGS_EQUAL(0, lt.n_lost());
+    UNSIGNED_LONGS_EQUAL(149, lt.ext_highest_seqnum());
+    DOUBLES_EQUAL(0, lt.report_fract_loss(), 0);
+
+    LossRuns runs;
+    lt.report_loss_runs(runs);
+
+    const seqnum_t expected[] = { 50 };
+    check_runs(runs, 100, expected, 1);
+}
+
+TEST(loss_tracker, fract_loss_per_interval) {
+    Queue queue;
+    LossTracker lt(queue);
+
+    // 10 received, 10 lost, 20 received
+    write_packets(lt, 0, 10);
+    write_packets(lt, 20, 20);
+
+    LONGS_EQUAL(10, lt.n_lost());
+    DOUBLES_EQUAL(0.25, lt.report_fract_loss(), 0.0001);
+
+    // 30 received, 10 lost, 10 received
+    write_packets(lt, 40, 30);
+    write_packets(lt, 80, 10);
+
+    LONGS_EQUAL(20, lt.n_lost());
+    DOUBLES_EQUAL(0.2, lt.report_fract_loss(), 0.0001);
+
+    // nothing new
+    DOUBLES_EQUAL(0, lt.report_fract_loss(), 0);
+}
+
+TEST(loss_tracker, duplicates) {
+    Queue queue;
+    LossTracker lt(queue);
+
+    write_packets(lt, 0, 10);
+    write_packets(lt, 5, 5);
+
+    UNSIGNED_LONGS_EQUAL(15, lt.n_received());
+    LONGS_EQUAL(-5, lt.n_lost());
+    DOUBLES_EQUAL(0, lt.report_fract_loss(), 0);
+}
+
+TEST(loss_tracker, loss_runs) {
+    Queue queue;
+    LossTracker lt(queue);
+
+    // 5 received, 3 lost, 10 received, 1 lost, 2 received
+    write_packets(lt, 1000, 5);
+    write_packets(lt, 1008, 10);
+    write_packets(lt, 1019, 2);
+
+    LossRuns runs;
+    lt.report_loss_runs(runs);
+
+    const seqnum_t expected1[] = { 5, 3, 10, 1, 2 };
+    check_runs(runs, 1000, expected1, 5);
+
+    UNSIGNED_LONGS_EQUAL(4, runs.n_lost());
+    UNSIGNED_LONGS_EQUAL(3, runs.max_lost_run());
+
+    // next report starts where previous ended
+    // 4 lost, 6 received
+    write_packets(lt, 1025, 6);
+
+    lt.report_loss_runs(runs);
+
+    const seqnum_t expected2[] = { 0, 4, 6 };
+    check_runs(runs, 1021, expected2, 3);
+}
+
+TEST(loss_tracker, reordered_packets) {
+    Queue queue;
+    LossTracker lt(queue);
+
+    // packet 3 arrives late, packet 6 doesn't arrive
+    const seqnum_t seqnums[] = { 0, 1, 2, 4, 5, 3, 7, 8 };
+
+    for (size_t n = 0; n < sizeof(seqnums) / sizeof(*seqnums); n++) {
+        lt.write(new_packet(seqnums[n]));
+    }
+
+    LONGS_EQUAL(1, lt.n_lost());
+
+    LossRuns runs;
+    lt.report_loss_runs(runs);
+
+    const seqnum_t expected[] = { 6, 1, 2 };
+    check_runs(runs, 0, expected, 3);
+}
+
+TEST(loss_tracker, seqnum_wrap) {
+    Queue queue;
+    LossTracker lt(queue);
+
+    // 65530..65535, 2 lost, 2..9
+    write_packets(lt, 65530, 6);
+    write_packets(lt, 2, 8);
+
+    UNSIGNED_LONGS_EQUAL(65536 + 9, lt.ext_highest_seqnum());
+    LONGS_EQUAL(2, lt.n_lost());
+
+    LossRuns runs;
+    lt.report_loss_runs(runs);
+
+    const seqnum_t expected[] = { 6, 2, 8 };
+    check_runs(runs, 65530, expected, 3);
+}
+
+TEST(loss_tracker, runs_overflow) {
+    Queue queue;
+    LossTracker lt(queue);
+
+    // every second packet is lost, more runs than fit into report
+    const size_t n_packets = LossRuns::MaxRuns * 2;
+    for (size_t n = 0; n < n_packets; n++) {
+        lt.write(new_packet(seqnum_t(n * 2)));
+    }
+
+    LossRuns runs;
+    size_t n_reported = 0;
+    size_t n_lost = 0;
+
+    for (;;) {
+        lt.report_loss_runs(runs);
+        if (runs.n_runs == 0) {
+            break;
+        }
+
+        CHECK(runs.n_runs <= LossRuns::MaxRuns);
+        UNSIGNED_LONGS_EQUAL(seqnum_t(n_reported), runs.begin);
+
+        n_reported += runs.n_packets();
+        n_lost += runs.n_lost();
+    }
+
+    // all sequence numbers are reported exactly once
+    UNSIGNED_LONGS_EQUAL((n_packets - 1) * 2 + 1, n_reported);
+    UNSIGNED_LONGS_EQUAL(n_packets - 1, n_lost);
+}
+
+TEST(loss_tracker, window_overrun) {
+    Queue queue;
+    LossTracker lt(queue);
+
+    write_packets(lt, 0, 10);
+
+    // long gap, oldest sequence numbers fall out of window
+    write_packets(lt, 5000, 10);
+
+    LossRuns runs;
+    lt.report_loss_runs(runs);
+
+    CHECK(runs.n_packets() <= 1024);
+    UNSIGNED_LONGS_EQUAL(5009, seqnum_t(runs.begin + runs.n_packets() - 1));
+    UNSIGNED_LONGS_EQUAL(10, runs.runs[runs.n_runs - 1]);
+
+    // cumulative statistics are not affected by window
+    LONGS_EQUAL(5000 - 10, lt.n_lost());
+}
+
+} // namespace packet
+} // namespace roc
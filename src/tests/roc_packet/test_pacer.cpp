@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/pacer.h"
+#include "roc_packet/queue.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+const core::nanoseconds_t Start = core::Second;
+const core::nanoseconds_t Interval = 10 * core::Millisecond;
+
+core::HeapAllocator allocator;
+PacketFactory packet_factory(allocator, true);
+
+PacerConfig make_config(float headroom, size_t burst) {
+    PacerConfig config;
+    config.rate_headroom = headroom;
+    config.burst_packets = burst;
+    config.max_delay = 100 * core::Millisecond;
+    config.max_queue_packets = 4;
+    return config;
+}
+
+PacketPtr new_packet(seqnum_t sn) {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagRTP);
+    packet->rtp()->seqnum = sn;
+
+    return packet;
+}
+
+void write_packets(IWriter& writer, seqnum_t first_sn, size_t n_packets) {
+    for (size_t n = 0; n < n_packets; n++) {
+        writer.write(new_packet(seqnum_t(first_sn + n)));
+    }
+}
+
+void expect_packets(Queue& queue, seqnum_t first_sn, size_t n_packets) {
+    LONGS_EQUAL(n_packets, queue.size());
+
+    for (size_t n = 0; n < n_packets; n++) {
+        PacketPtr pp = queue.read();
+        CHECK(pp);
+        LONGS_EQUAL(seqnum_t(first_sn + n), pp->rtp()->seqnum);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(pacer) {};
+
+TEST(pacer, no_interval) {
+    Queue queue;
+    Pacer pacer(queue, allocator, make_config(1.0f, 1));
+    CHECK(pacer.valid());
+
+    pacer.advance(Start);
+    write_packets(pacer, 0, 10);
+
+    expect_packets(queue, 0, 10);
+
+    LONGS_EQUAL(0, pacer.queue_size());
+    LONGS_EQUAL(0, pacer.deadline());
+
+    LONGS_EQUAL(10, pacer.n_sent_packets());
+    LONGS_EQUAL(0, pacer.n_delayed_packets());
+    LONGS_EQUAL(0, pacer.n_forced_packets());
+}
+
+TEST(pacer, burst) {
+    Queue queue;
+    Pacer pacer(queue, allocator, make_config(1.0f, 2));
+    CHECK(pacer.valid());
+
+    pacer.set_interval(Interval);
+    pacer.advance(Start);
+
+    // first burst_packets are sent immediately
+    write_packets(pacer, 0, 5);
+    expect_packets(queue, 0, 2);
+
+    LONGS_EQUAL(3, pacer.queue_size());
+    CHECK(pacer.deadline() == Start + Interval);
+
+    pacer.advance(Start + Interval / 2);
+    expect_packets(queue, 0, 0);
+
+    pacer.advance(Start + Interval);
+    expect_packets(queue, 2, 1);
+    CHECK(pacer.deadline() == Start + Interval * 2);
+
+    // credit is accumulated while packets are waiting
+    pacer.advance(Start + Interval * 3);
+    expect_packets(queue, 3, 2);
+
+    LONGS_EQUAL(0, pacer.queue_size());
+    LONGS_EQUAL(0, pacer.deadline());
+
+    LONGS_EQUAL(5, pacer.n_sent_packets());
+    LONGS_EQUAL(3, pacer.n_delayed_packets());
+    LONGS_EQUAL(0, pacer.n_forced_packets());
+}
+
+TEST(pacer, steady_rate) {
+    Queue queue;
+    Pacer pacer(queue, allocator, make_config(1.0f, 1));
+    CHECK(pacer.valid());
+
+    pacer.set_interval(Interval);
+
+    core::nanoseconds_t now = Start;
+
+    for (seqnum_t sn = 0; sn < 100; sn++) {
+        pacer.advance(now);
+        write_packets(pacer, sn, 1);
+        expect_packets(queue, sn, 1);
+
+        now += Interval;
+    }
+
+    LONGS_EQUAL(100, pacer.n_sent_packets());
+    LONGS_EQUAL(0, pacer.n_delayed_packets());
+}
+
+TEST(pacer, headroom) {
+    Queue queue;
+    Pacer pacer(queue, allocator, make_config(2.0f, 1));
+    CHECK(pacer.valid());
+
+    pacer.set_interval(Interval);
+    pacer.advance(Start);
+
+    write_packets(pacer, 0, 3);
+    expect_packets(queue, 0, 1);
+
+    // packets are released twice faster than nominal rate
+    CHECK(pacer.deadline() == Start + Interval / 2);
+
+    pacer.advance(Start + Interval / 2);
+    expect_packets(queue, 1, 1);
+
+    pacer.advance(Start + Interval);
+    expect_packets(queue, 2, 1);
+
+    LONGS_EQUAL(0, pacer.queue_size());
+}
+
+TEST(pacer, max_delay) {
+    PacerConfig config = make_config(1.0f, 1);
+    config.max_delay = Interval * 3 / 2;
+
+    Queue queue;
+    Pacer pacer(queue, allocator, config);
+    CHECK(pacer.valid());
+
+    pacer.set_interval(Interval);
+    pacer.advance(Start);
+
+    write_packets(pacer, 0, 4);
+    expect_packets(queue, 0, 1);
+
+    pacer.advance(Start + Interval);
+    expect_packets(queue, 1, 1);
+
+    CHECK(pacer.deadline() == Start + config.max_delay);
+
+    // remaining packets waited too long
+    pacer.advance(Start + config.max_delay);
+    expect_packets(queue, 2, 2);
+
+    LONGS_EQUAL(4, pacer.n_sent_packets());
+    LONGS_EQUAL(3, pacer.n_delayed_packets());
+    LONGS_EQUAL(2, pacer.n_forced_packets());
+}
+
+TEST(pacer, queue_overflow) {
+    Queue queue;
+    Pacer pacer(queue, allocator, make_config(1.0f, 1));
+    CHECK(pacer.valid());
+
+    pacer.set_interval(Interval);
+    pacer.advance(Start);
+
+    // one sent immediately, four queued, two forced out of queue
+    write_packets(pacer, 0, 7);
+    expect_packets(queue, 0, 3);
+
+    LONGS_EQUAL(4, pacer.queue_size());
+    LONGS_EQUAL(2, pacer.n_forced_packets());
+
+    pacer.advance(Start + Interval * 4);
+    expect_packets(queue, 3, 1);
+
+    pacer.flush();
+    expect_packets(queue, 4, 3);
+
+    LONGS_EQUAL(7, pacer.n_sent_packets());
+    LONGS_EQUAL(6, pacer.n_delayed_packets());
+}
+
+TEST(pacer, clock_backwards) {
+    Queue queue;
+    Pacer pacer(queue, allocator, make_config(1.0f, 1));
+    CHECK(pacer.valid());
+
+    pacer.set_interval(Interval);
+    pacer.advance(Start);
+
+    write_packets(pacer, 0, 3);
+    expect_packets(queue, 0, 1);
+
+    pacer.advance(Start - Interval * 10);
+    expect_packets(queue, 0, 0);
+
+    pacer.advance(Start + Interval);
+    expect_packets(queue, 1, 1);
+}
+
+TEST(pacer, disable_interval) {
+    Queue queue;
+    Pacer pacer(queue, allocator, make_config(1.0f, 1));
+    CHECK(pacer.valid());
+
+    pacer.set_interval(Interval);
+    pacer.advance(Start);
+
+    write_packets(pacer, 0, 3);
+    expect_packets(queue, 0, 1);
+
+    // queued packets are flushed
+    pacer.set_interval(0);
+    expect_packets(queue, 1, 2);
+
+    write_packets(pacer, 3, 3);
+    expect_packets(queue, 3, 3);
+
+    LONGS_EQUAL(0, pacer.deadline());
+}
+
+TEST(pacer, invalid_config) {
+    Queue queue;
+
+    PacerConfig config;
+    config.rate_headroom = 0.5f;
+
+    Pacer pacer(queue, allocator, config);
+    CHECK(!pacer.valid());
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+enum {
+    CacheLineSize = 64,
+
+    // Budget for packet metadata excluding UDP header, on 64-bit targets.
+    // If you hit this limit, consider keeping new fields out of hot path.
+    MaxPacketSizeWithoutUDP = 288
+};
+
+core::HeapAllocator allocator;
+PacketFactory packet_factory(allocator, true);
+
+size_t offset_in_packet(const Packet& packet, const void* field) {
+    return size_t((const char*)field - (const char*)&packet);
+}
+
+} // namespace
+
+TEST_GROUP(packet) {};
+
+TEST(packet, compare_keys_layout) {
+    PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+
+    pp->add_flags(Packet::FlagUDP | Packet::FlagRTP | Packet::FlagFEC);
+
+    // keys used by SortedQueue::write() should not be farther than the line
+    // following intrusive list node, which is touched on every insert
+    CHECK(offset_in_packet(*pp, &pp->rtp()->source) < CacheLineSize * 2);
+    CHECK(offset_in_packet(*pp, &pp->rtp()->seqnum) < CacheLineSize * 2);
+    CHECK(offset_in_packet(*pp, &pp->rtp()->timestamp) < CacheLineSize * 2);
+    CHECK(offset_in_packet(*pp, &pp->rtp()->duration) < CacheLineSize * 2);
+
+    // large UDP header should not push other headers away
+    CHECK(offset_in_packet(*pp, pp->udp()) > offset_in_packet(*pp, pp->rtp()));
+    CHECK(offset_in_packet(*pp, pp->udp()) > offset_in_packet(*pp, pp->fec()));
+}
+
+TEST(packet, size) {
+    if (sizeof(void*) != 8) {
+        return;
+    }
+
+    CHECK(sizeof(Packet) - sizeof(UDP) <= MaxPacketSizeWithoutUDP);
+}
+
+TEST(packet, container_of) {
+    PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+
+    pp->add_flags(Packet::FlagUDP);
+
+    CHECK(Packet::container_of(pp->udp()) == pp.get());
+}
+
+} // namespace packet
+} // namespace roc
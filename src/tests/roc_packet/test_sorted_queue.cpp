@@ -9,6 +9,7 @@
 #include <CppUTest/TestHarness.h>
 
 #include "roc_core/heap_allocator.h"
+#include "roc_core/macro_helpers.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_packet/sorted_queue.h"
 
@@ -393,5 +394,72 @@ TEST(sorted_queue, latest) {
     CHECK(queue.latest() == p4);
 }
 
+TEST(sorted_queue, interleaved) {
+    enum { BlockLen = 10, NumGroups = 3, MaxDepth = 12 };
+
+    const size_t depths[] = { 1, 4, MaxDepth };
+
+    SortedQueue queue(0);
+
+    seqnum_t base = 0;
+
+    for (size_t n_depth = 0; n_depth < ROC_ARRAY_SIZE(depths); n_depth++) {
+        const size_t depth = depths[n_depth];
+
+        for (size_t n_group = 0; n_group < NumGroups; n_group++) {
+            // packets of depth blocks are written column-wise, as
+            // produced by block interleaver on sender
+            for (size_t esi = 0; esi < BlockLen; esi++) {
+                for (size_t blk = 0; blk < depth; blk++) {
+                    const seqnum_t sn = seqnum_t(base + blk * BlockLen + esi);
+                    queue.write(new_packet(sn));
+
+                    // duplicate
+                    if ((esi + blk) % 7 == 0) {
+                        queue.write(new_packet(sn));
+                    }
+                }
+            }
+
+            LONGS_EQUAL(depth * BlockLen, queue.size());
+
+            for (size_t n = 0; n < depth * BlockLen; n++) {
+                PacketPtr pp = queue.read();
+                CHECK(pp);
+                LONGS_EQUAL(seqnum_t(base + n), pp->rtp()->seqnum);
+            }
+
+            CHECK(!queue.read());
+
+            base = seqnum_t(base + depth * BlockLen);
+        }
+    }
+}
+
+TEST(sorted_queue, read_releases_packets) {
+    enum { NumPackets = 20 };
+
+    SortedQueue queue(0);
+
+    PacketPtr packets[NumPackets];
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet(seqnum_t(n));
+        queue.write(packets[n]);
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        CHECK(queue.read() == packets[n]);
+    }
+
+    CHECK(!queue.read());
+
+    // only latest packet is still referenced by queue
+    for (size_t n = 0; n < NumPackets - 1; n++) {
+        LONGS_EQUAL(1, packets[n]->getref());
+    }
+    LONGS_EQUAL(2, packets[NumPackets - 1]->getref());
+}
+
 } // namespace packet
 } // namespace roc
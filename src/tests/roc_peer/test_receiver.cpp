@@ -67,6 +67,36 @@ TEST(receiver, bind) {
     UNSIGNED_LONGS_EQUAL(context.network_loop().num_ports(), 0);
 }
 
+TEST(receiver, bind_control) {
+    Context context(context_config, allocator);
+    CHECK(context.valid());
+
+    UNSIGNED_LONGS_EQUAL(context.network_loop().num_ports(), 0);
+
+    {
+        Receiver receiver(context, receiver_config);
+        CHECK(receiver.valid());
+
+        address::EndpointUri source_endp(allocator);
+        parse_uri(source_endp, "rtp://127.0.0.1:0");
+
+        CHECK(receiver.bind(DefaultSlot, address::Iface_AudioSource, source_endp));
+
+        UNSIGNED_LONGS_EQUAL(context.network_loop().num_ports(), 1);
+
+        address::EndpointUri control_endp(allocator);
+        parse_uri(control_endp, "rtcp://127.0.0.1:0");
+
+        CHECK(receiver.bind(DefaultSlot, address::Iface_AudioControl, control_endp));
+        CHECK(control_endp.port() != 0);
+
+        // control interface has incoming port and outgoing port for reports
+        UNSIGNED_LONGS_EQUAL(context.network_loop().num_ports(), 3);
+    }
+
+    UNSIGNED_LONGS_EQUAL(context.network_loop().num_ports(), 0);
+}
+
 TEST(receiver, bind_slots) {
     Context context(context_config, allocator);
     CHECK(context.valid());
@@ -364,5 +364,43 @@ TEST(sender, port_sharing) {
     UNSIGNED_LONGS_EQUAL(context.network_loop().num_ports(), 0);
 }
 
+TEST(sender, pacing) {
+    enum { NumFrames = 20, FrameSize = 200 };
+
+    Context context(context_config, allocator);
+    CHECK(context.valid());
+
+    {
+        sender_config.fec_encoder.scheme = packet::FEC_None;
+        sender_config.pacing = true;
+
+        Sender sender(context, sender_config);
+        CHECK(sender.valid());
+
+        address::EndpointUri source_endp(allocator);
+        parse_uri(source_endp, "rtp://127.0.0.1:123");
+
+        address::EndpointUri control_endp(allocator);
+        parse_uri(control_endp, "rtcp://127.0.0.1:124");
+
+        CHECK(sender.connect(DefaultSlot, address::Iface_AudioSource, source_endp));
+        CHECK(sender.connect(DefaultSlot, address::Iface_AudioControl, control_endp));
+        CHECK(sender.is_ready());
+
+        audio::sample_t samples[FrameSize] = {};
+
+        // packets queued by pacer and control packets are sent from
+        // control loop, which keeps running until sender is destroyed
+        for (size_t nf = 0; nf < NumFrames; nf++) {
+            audio::Frame frame(samples, FrameSize);
+            sender.sink().write(frame);
+        }
+
+        core::sleep_for(core::ClockMonotonic, core::Millisecond * 50);
+    }
+
+    UNSIGNED_LONGS_EQUAL(context.network_loop().num_ports(), 0);
+}
+
 } // namespace peer
 } // namespace roc
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/iframe_encoder.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/receiver_source.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace pipeline {
+namespace {
+
+// --------
+// Overview
+// --------
+//
+// This benchmark emulates a burst of new senders joining a receiver at once.
+//
+// Each iteration reads one frame from ReceiverSource, as the sound card thread
+// would do. At the beginning of the run, the first packets from NumSenders new
+// senders arrive at once; after that, every sender delivers one packet per frame.
+//
+// A frame read is considered a deadline miss if it took longer than the frame
+// duration, i.e. if a real-time sink would get an underrun.
+//
+// ----------
+// Benchmarks
+// ----------
+//
+// Bench_SyncCreation   - sessions are constructed in-place on pipeline thread
+// Bench_AsyncCreation  - sessions are constructed on background thread
+//
+// --------------
+// Output columns
+// --------------
+//
+// (all time units are microseconds)
+//
+// f_avg       -  average frame read duration
+// f_max       -  maximum frame read duration
+// miss        -  number of frame reads that exceeded frame duration
+// sess        -  number of sessions at the end of the run
+
+enum {
+    SampleRate = 44100,
+    ChMask = 0x3,
+    NumCh = 2,
+
+    SamplesPerFrame = 220, // ~5ms
+    SamplesPerPacket = SamplesPerFrame,
+
+    NumSenders = 100,
+    NumIterations = 400,
+
+    MaxBufSize = 4096
+};
+
+const rtp::PayloadType PayloadType = rtp::PayloadType_L16_Stereo;
+
+const core::nanoseconds_t FrameDuration = SamplesPerFrame * core::Second / SampleRate;
+
+core::HeapAllocator allocator;
+core::BufferFactory<audio::sample_t> sample_buffer_factory(allocator, MaxBufSize, true);
+core::BufferFactory<uint8_t> byte_buffer_factory(allocator, MaxBufSize, true);
+packet::PacketFactory packet_factory(allocator, true);
+
+rtp::FormatMap format_map;
+rtp::Composer rtp_composer(NULL);
+
+class Sender {
+public:
+    Sender()
+        : writer_(NULL)
+        , seqnum_(0)
+        , timestamp_(0) {
+    }
+
+    void init(packet::IWriter& writer, int port) {
+        writer_ = &writer;
+        src_addr_.set_host_port(address::Family_IPv4, "127.0.0.1", port);
+        dst_addr_.set_host_port(address::Family_IPv4, "127.0.0.1", 1);
+        encoder_.reset(format_map.format(PayloadType)->new_encoder(allocator), allocator);
+        roc_panic_if(!encoder_);
+    }
+
+    void write_packet() {
+        packet::PacketPtr pp = packet_factory.new_packet();
+        roc_panic_if(!pp);
+
+        core::Slice<uint8_t> bp = byte_buffer_factory.new_buffer();
+        roc_panic_if(!bp);
+
+        roc_panic_if(!rtp_composer.prepare(
+            *pp, bp, encoder_->encoded_byte_count(SamplesPerPacket)));
+
+        pp->set_data(bp);
+
+        pp->rtp()->source = 0;
+        pp->rtp()->seqnum = seqnum_++;
+        pp->rtp()->timestamp = timestamp_;
+        pp->rtp()->payload_type = PayloadType;
+
+        timestamp_ += SamplesPerPacket;
+
+        audio::sample_t samples[SamplesPerPacket * NumCh] = {};
+
+        encoder_->begin(pp->rtp()->payload.data(), pp->rtp()->payload.size());
+        encoder_->write(samples, SamplesPerPacket);
+        encoder_->end();
+
+        roc_panic_if(!rtp_composer.compose(*pp));
+
+        packet::PacketPtr wp = packet_factory.new_packet();
+        roc_panic_if(!wp);
+
+        wp->add_flags(packet::Packet::FlagUDP);
+        wp->udp()->src_addr = src_addr_;
+        wp->udp()->dst_addr = dst_addr_;
+        wp->set_data(pp->data());
+
+        writer_->write(wp);
+    }
+
+private:
+    packet::IWriter* writer_;
+
+    address::SocketAddr src_addr_;
+    address::SocketAddr dst_addr_;
+
+    core::ScopedPtr<audio::IFrameEncoder> encoder_;
+
+    packet::seqnum_t seqnum_;
+    packet::timestamp_t timestamp_;
+};
+
+void run_burst(benchmark::State& state, bool async_session_creation) {
+    ReceiverConfig config;
+
+    config.common.output_sample_spec = audio::SampleSpec(SampleRate, ChMask);
+    config.common.internal_frame_length = FrameDuration;
+    config.common.resampling = true;
+    config.common.async_session_creation = async_session_creation;
+
+    config.default_session.target_latency = FrameDuration * 4;
+    config.default_session.latency_monitor.min_latency = -core::Second;
+    config.default_session.latency_monitor.max_latency = core::Second;
+    config.default_session.watchdog.no_playback_timeout = 0;
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+    roc_panic_if(!receiver.valid());
+
+    ReceiverSlot* slot = receiver.create_slot();
+    roc_panic_if(!slot);
+
+    ReceiverEndpoint* endpoint =
+        slot->create_endpoint(address::Iface_AudioSource, address::Proto_RTP, NULL);
+    roc_panic_if(!endpoint);
+
+    Sender senders[NumSenders];
+    for (size_t ns = 0; ns < NumSenders; ns++) {
+        senders[ns].init(endpoint->writer(), int(ns + 1000));
+    }
+
+    audio::sample_t samples[SamplesPerFrame * NumCh];
+
+    core::nanoseconds_t total_time = 0;
+    core::nanoseconds_t max_time = 0;
+    size_t n_frames = 0;
+    size_t n_misses = 0;
+
+    while (state.KeepRunning()) {
+        for (size_t ns = 0; ns < NumSenders; ns++) {
+            senders[ns].write_packet();
+        }
+
+        audio::Frame frame(samples, SamplesPerFrame * NumCh);
+
+        const core::nanoseconds_t start = core::timestamp(core::ClockMonotonic);
+        receiver.read(frame);
+        const core::nanoseconds_t elapsed = core::timestamp(core::ClockMonotonic) - start;
+
+        total_time += elapsed;
+        if (elapsed > max_time) {
+            max_time = elapsed;
+        }
+        if (elapsed > FrameDuration) {
+            n_misses++;
+        }
+        n_frames++;
+    }
+
+    state.counters["f_avg"] = double(total_time) / n_frames / core::Microsecond;
+    state.counters["f_max"] = double(max_time) / core::Microsecond;
+    state.counters["miss"] = n_misses;
+    state.counters["sess"] = receiver.num_sessions();
+}
+
+void BM_ReceiverSessionBurst_SyncCreation(benchmark::State& state) {
+    run_burst(state, false);
+}
+
+BENCHMARK(BM_ReceiverSessionBurst_SyncCreation)
+    ->Iterations(NumIterations)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_ReceiverSessionBurst_AsyncCreation(benchmark::State& state) {
+    run_burst(state, true);
+}
+
+BENCHMARK(BM_ReceiverSessionBurst_AsyncCreation)
+    ->Iterations(NumIterations)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace pipeline
+} // namespace roc
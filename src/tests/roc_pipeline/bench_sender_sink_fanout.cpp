@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/sender_sink.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace pipeline {
+namespace {
+
+// --------
+// Overview
+// --------
+//
+// This benchmark emulates one sender streaming to many unicast receivers.
+//
+// Each iteration writes one frame to SenderSink, which has one slot per
+// destination. All slots have the same configuration, so they share a single
+// transport pipeline (resampler, packetizer, encoder), and packets are only
+// duplicated to the endpoint of each slot.
+//
+// Argument is number of destinations. With shared pipeline, cost of a frame
+// should grow much slower than linearly with the number of destinations.
+
+enum {
+    InputRate = 48000,
+    ChMask = 0x3,
+    NumCh = 2,
+
+    SamplesPerFrame = 240, // 5ms
+    SamplesPerPacket = 220,
+
+    MaxBufSize = 4096
+};
+
+core::HeapAllocator allocator;
+core::BufferFactory<audio::sample_t> sample_buffer_factory(allocator, MaxBufSize, true);
+core::BufferFactory<uint8_t> byte_buffer_factory(allocator, MaxBufSize, true);
+packet::PacketFactory packet_factory(allocator, true);
+
+rtp::FormatMap format_map;
+
+// Drops packets, like a socket that never blocks.
+class NullWriter : public packet::IWriter {
+public:
+    virtual void write(const packet::PacketPtr&) {
+    }
+};
+
+void BM_SenderSink_Fanout(benchmark::State& state) {
+    const size_t num_dests = (size_t)state.range(0);
+
+    SenderConfig config;
+    config.input_sample_spec = audio::SampleSpec(InputRate, ChMask);
+    config.packet_length = SamplesPerPacket * core::Second / 44100;
+    config.internal_frame_length = SamplesPerFrame * core::Second / InputRate;
+    config.payload_type = rtp::PayloadType_L16_Stereo;
+    config.fec_encoder.scheme = packet::FEC_None;
+    config.resampling = true;
+    config.interleaving = false;
+    config.timing = false;
+    config.poisoning = false;
+    config.profiling = false;
+
+    SenderSink sink(config, format_map, packet_factory, byte_buffer_factory,
+                    sample_buffer_factory, allocator);
+    roc_panic_if(!sink.valid());
+
+    NullWriter null_writer;
+
+    for (size_t n = 0; n < num_dests; n++) {
+        SenderSlot* slot = sink.create_slot();
+        roc_panic_if(!slot);
+
+        SenderEndpoint* endpoint =
+            slot->create_endpoint(address::Iface_AudioSource, address::Proto_RTP);
+        roc_panic_if(!endpoint);
+
+        address::SocketAddr addr;
+        roc_panic_if(!addr.set_host_port(address::Family_IPv4, "127.0.0.1",
+                                         int(10000 + n)));
+
+        endpoint->set_destination_writer(null_writer);
+        endpoint->set_destination_address(addr);
+    }
+
+    audio::sample_t samples[SamplesPerFrame * NumCh];
+    for (size_t n = 0; n < SamplesPerFrame * NumCh; n++) {
+        samples[n] = audio::sample_t(n) / (SamplesPerFrame * NumCh);
+    }
+
+    while (state.KeepRunning()) {
+        audio::Frame frame(samples, SamplesPerFrame * NumCh);
+        sink.write(frame);
+    }
+}
+
+BENCHMARK(BM_SenderSink_Fanout)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(50)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_factory.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_fec/redundancy_controller.h"
+#include "roc_packet/loss_tracker.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+#include "roc_rtcp/composer.h"
+#include "roc_rtcp/session.h"
+
+namespace roc {
+namespace pipeline {
+
+// Simulates feedback loop between receiver and sender: receiver tracks
+// losses of a simulated packet stream and sends RTCP reports, and sender
+// parses them and adjusts FEC redundancy.
+
+namespace {
+
+enum {
+    Source = 123,
+    NumSourcePackets = 20,
+    NumRepairPackets = 10,
+    PacketsPerReport = 200,
+    MaxBufSize = 2048
+};
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, MaxBufSize, true);
+packet::PacketFactory packet_factory(allocator, true);
+
+class ReceiverHooks : public rtcp::IReceiverHooks {
+public:
+    ReceiverHooks(packet::LossTracker& tracker)
+        : tracker_(tracker) {
+    }
+
+    virtual void on_update_source(packet::source_t, const char*) {
+    }
+
+    virtual void on_remove_source(packet::source_t) {
+    }
+
+    virtual size_t on_get_num_sources() {
+        return 1;
+    }
+
+    virtual rtcp::ReceptionMetrics on_get_reception_metrics(size_t source_index) {
+        CHECK(source_index == 0);
+
+        rtcp::ReceptionMetrics metrics;
+        metrics.ssrc = tracker_.source();
+        metrics.fract_loss = tracker_.report_fract_loss();
+        tracker_.report_loss_runs(metrics.loss_runs);
+
+        return metrics;
+    }
+
+    virtual void on_add_sending_metrics(const rtcp::SendingMetrics&) {
+    }
+
+    virtual void on_add_link_metrics(const rtcp::LinkMetrics&) {
+    }
+
+private:
+    packet::LossTracker& tracker_;
+};
+
+class SenderHooks : public rtcp::ISenderHooks {
+public:
+    SenderHooks(fec::RedundancyController& controller)
+        : controller_(controller)
+        , n_reports_(0) {
+    }
+
+    virtual size_t on_get_num_sources() {
+        return 0;
+    }
+
+    virtual packet::source_t on_get_sending_source(size_t) {
+        FAIL("unexpected call");
+        return 0;
+    }
+
+    virtual rtcp::SendingMetrics on_get_sending_metrics(packet::ntp_timestamp_t) {
+        return rtcp::SendingMetrics();
+    }
+
+    virtual void on_add_reception_metrics(const rtcp::ReceptionMetrics& metrics) {
+        UNSIGNED_LONGS_EQUAL(Source, metrics.ssrc);
+
+        controller_.update(metrics.fract_loss, metrics.loss_runs);
+        n_reports_++;
+    }
+
+    virtual void on_add_link_metrics(const rtcp::LinkMetrics&) {
+    }
+
+    size_t n_reports() const {
+        return n_reports_;
+    }
+
+private:
+    fec::RedundancyController& controller_;
+    size_t n_reports_;
+};
+
+// Decides which packets are lost.
+class LossModel {
+public:
+    virtual ~LossModel() {
+    }
+
+    virtual bool lost(size_t n) = 0;
+};
+
+class NoLoss : public LossModel {
+public:
+    virtual bool lost(size_t) {
+        return false;
+    }
+};
+
+// Every n-th packet is lost.
+class PeriodicLoss : public LossModel {
+public:
+    PeriodicLoss(size_t period)
+        : period_(period) {
+    }
+
+    virtual bool lost(size_t n) {
+        return n % period_ == period_ - 1;
+    }
+
+private:
+    size_t period_;
+};
+
+// Each packet is lost with given probability.
+class RandomLoss : public LossModel {
+public:
+    RandomLoss(size_t percent)
+        : percent_(percent) {
+    }
+
+    virtual bool lost(size_t) {
+        return core::fast_random(0, 99) < percent_;
+    }
+
+private:
+    size_t percent_;
+};
+
+// Bursts of consecutive losses with given period.
+class BurstLoss : public LossModel {
+public:
+    BurstLoss(size_t period, size_t burst)
+        : period_(period)
+        , burst_(burst) {
+    }
+
+    virtual bool lost(size_t n) {
+        return n % period_ >= period_ - burst_;
+    }
+
+private:
+    size_t period_;
+    size_t burst_;
+};
+
+class Link {
+public:
+    Link()
+        : tracker_(tracker_queue_)
+        , controller_(fec::RedundancyControllerConfig(), NumSourcePackets,
+                      NumRepairPackets)
+        , recv_hooks_(tracker_)
+        , send_hooks_(controller_)
+        , recv_session_(&recv_hooks_,
+                        NULL,
+                        &report_queue_,
+                        composer_,
+                        packet_factory,
+                        buffer_factory)
+        , send_session_(
+              NULL, &send_hooks_, NULL, composer_, packet_factory, buffer_factory)
+        , seqnum_(65000)
+        , n_packets_(0) {
+        CHECK(recv_session_.valid());
+        CHECK(send_session_.valid());
+    }
+
+    // Send packets for one report interval through simulated network
+    // and deliver receiver report to sender.
+    void run(LossModel& loss, size_t n_reports) {
+        for (size_t r = 0; r < n_reports; r++) {
+            for (size_t n = 0; n < PacketsPerReport; n++) {
+                if (!loss.lost(n_packets_)) {
+                    tracker_.write(new_packet_());
+                } else {
+                    seqnum_++;
+                }
+                n_packets_++;
+            }
+
+            while (tracker_queue_.read()) {
+            }
+
+            const size_t n_reports_before = send_hooks_.n_reports();
+
+            recv_session_.generate_packets();
+
+            packet::PacketPtr report = report_queue_.read();
+            CHECK(report);
+            CHECK(!report_queue_.read());
+
+            send_session_.process_packet(report);
+
+            UNSIGNED_LONGS_EQUAL(n_reports_before + 1, send_hooks_.n_reports());
+        }
+    }
+
+    size_t n_repair_packets() const {
+        return controller_.n_repair_packets();
+    }
+
+    size_t n_source_packets() const {
+        return controller_.n_source_packets();
+    }
+
+private:
+    packet::PacketPtr new_packet_() {
+        packet::PacketPtr packet = packet_factory.new_packet();
+        CHECK(packet);
+
+        packet->add_flags(packet::Packet::FlagRTP);
+        packet->rtp()->source = Source;
+        packet->rtp()->seqnum = seqnum_++;
+
+        return packet;
+    }
+
+    packet::Queue tracker_queue_;
+    packet::LossTracker tracker_;
+
+    fec::RedundancyController controller_;
+
+    ReceiverHooks recv_hooks_;
+    SenderHooks send_hooks_;
+
+    packet::Queue report_queue_;
+    rtcp::Composer composer_;
+
+    rtcp::Session recv_session_;
+    rtcp::Session send_session_;
+
+    packet::seqnum_t seqnum_;
+    size_t n_packets_;
+};
+
+} // namespace
+
+TEST_GROUP(fec_adaptation) {};
+
+TEST(fec_adaptation, clean_link) {
+    Link link;
+    NoLoss no_loss;
+
+    UNSIGNED_LONGS_EQUAL(NumRepairPackets, link.n_repair_packets());
+
+    link.run(no_loss, 1);
+    CHECK(link.n_repair_packets() < NumRepairPackets);
+
+    link.run(no_loss, 100);
+    UNSIGNED_LONGS_EQUAL(fec::RedundancyControllerConfig().min_repair_packets,
+                         link.n_repair_packets());
+
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets, link.n_source_packets());
+}
+
+TEST(fec_adaptation, periodic_loss) {
+    Link link;
+    NoLoss no_loss;
+    PeriodicLoss loss(10);
+
+    link.run(no_loss, 100);
+    UNSIGNED_LONGS_EQUAL(1, link.n_repair_packets());
+
+    // 10% of isolated losses, 20 * 0.1 * 2 = 4
+    link.run(loss, 1);
+    UNSIGNED_LONGS_EQUAL(4, link.n_repair_packets());
+
+    link.run(loss, 20);
+    UNSIGNED_LONGS_EQUAL(4, link.n_repair_packets());
+}
+
+TEST(fec_adaptation, random_loss) {
+    Link link;
+    NoLoss no_loss;
+    RandomLoss loss(10);
+
+    link.run(no_loss, 100);
+    UNSIGNED_LONGS_EQUAL(1, link.n_repair_packets());
+
+    // about 10% of losses, a few of them consecutive
+    link.run(loss, 20);
+    CHECK(link.n_repair_packets() >= 4);
+    CHECK(link.n_repair_packets() <= 8);
+}
+
+TEST(fec_adaptation, burst_loss) {
+    Link link;
+    NoLoss no_loss;
+    BurstLoss loss(100, 6);
+
+    link.run(no_loss, 100);
+    UNSIGNED_LONGS_EQUAL(1, link.n_repair_packets());
+
+    // 6% of losses in bursts of 6, repair packets cover whole burst
+    link.run(loss, 1);
+    UNSIGNED_LONGS_EQUAL(6, link.n_repair_packets());
+
+    link.run(loss, 20);
+    UNSIGNED_LONGS_EQUAL(6, link.n_repair_packets());
+}
+
+TEST(fec_adaptation, link_recovery) {
+    Link link;
+    NoLoss no_loss;
+    BurstLoss loss(100, 6);
+
+    link.run(no_loss, 100);
+    UNSIGNED_LONGS_EQUAL(1, link.n_repair_packets());
+
+    link.run(loss, 20);
+    UNSIGNED_LONGS_EQUAL(6, link.n_repair_packets());
+
+    // redundancy is released gradually
+    link.run(no_loss, 1);
+    UNSIGNED_LONGS_EQUAL(6, link.n_repair_packets());
+
+    link.run(no_loss, 10);
+    CHECK(link.n_repair_packets() > 1);
+    CHECK(link.n_repair_packets() < 6);
+
+    link.run(no_loss, 100);
+    UNSIGNED_LONGS_EQUAL(1, link.n_repair_packets());
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -46,6 +46,36 @@ public:
         }
     }
 
+    bool read_samples_or_zeros(size_t num_samples, size_t num_sessions) {
+        core::Slice<audio::sample_t> samples = buffer_factory_.new_buffer();
+        CHECK(samples);
+
+        samples.reslice(0, num_samples);
+        memset(samples.data(), 0, samples.size() * sizeof(audio::sample_t));
+
+        audio::Frame frame(samples.data(), samples.size());
+        CHECK(source_.read(frame));
+
+        bool is_zero = true;
+        for (size_t n = 0; n < num_samples; n++) {
+            if (std::abs((double)frame.samples()[n]) > Epsilon) {
+                is_zero = false;
+            }
+        }
+
+        if (is_zero) {
+            return false;
+        }
+
+        for (size_t n = 0; n < num_samples; n++) {
+            DOUBLES_EQUAL((double)nth_sample(offset_) * num_sessions,
+                          (double)frame.samples()[n], Epsilon);
+            offset_++;
+        }
+
+        return true;
+    }
+
     void skip_zeros(size_t num_samples) {
         core::Slice<audio::sample_t> samples = buffer_factory_.new_buffer();
         CHECK(samples);
@@ -11,17 +11,21 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include "roc_core/atomic.h"
 #include "roc_core/mutex.h"
 #include "roc_ctl/control_task_executor.h"
 #include "roc_ctl/control_task_queue.h"
 #include "roc_pipeline/ipipeline_task_scheduler.h"
+#include "roc_pipeline/isender_update_scheduler.h"
 #include "roc_pipeline/pipeline_loop.h"
+#include "roc_pipeline/sender_loop.h"
 
 namespace roc {
 namespace pipeline {
 namespace test {
 
 class Scheduler : public pipeline::IPipelineTaskScheduler,
+                  public pipeline::ISenderUpdateScheduler,
                   public ctl::ControlTaskExecutor<Scheduler> {
     class ProcessingTask : public ctl::ControlTask {
     public:
@@ -36,18 +40,38 @@ class Scheduler : public pipeline::IPipelineTaskScheduler,
         PipelineLoop& pipeline_;
     };
 
+    class UpdateTask : public ctl::ControlTask {
+    public:
+        UpdateTask(SenderLoop& sender)
+            : ControlTask(&Scheduler::do_update_)
+            , sender_(sender) {
+        }
+
+    private:
+        friend class Scheduler;
+
+        SenderLoop& sender_;
+    };
+
 public:
     Scheduler()
-        : task_(NULL) {
+        : task_(NULL)
+        , update_task_(NULL)
+        , updates_stopped_(false)
+        , n_updates_(0) {
         CHECK(queue_.valid());
     }
 
     ~Scheduler() {
-        if (task_) {
+        if (task_ || update_task_) {
             FAIL("wait_done() was not called before desctructor");
         }
     }
 
+    size_t num_updates() const {
+        return (size_t)n_updates_;
+    }
+
     void wait_done() {
         ProcessingTask* task = NULL;
 
@@ -64,6 +88,28 @@ public:
             delete task_;
             task_ = NULL;
         }
+
+        UpdateTask* update_task = NULL;
+
+        {
+            // update task reschedules itself, so prevent it before cancelling
+            core::Mutex::Lock lock(mutex_);
+            update_task = update_task_;
+            updates_stopped_ = true;
+
+            if (update_task) {
+                queue_.async_cancel(*update_task);
+            }
+        }
+
+        if (update_task) {
+            queue_.wait(*update_task);
+
+            core::Mutex::Lock lock(mutex_);
+
+            delete update_task_;
+            update_task_ = NULL;
+        }
     }
 
     virtual void schedule_task_processing(pipeline::PipelineLoop& pipeline,
@@ -82,15 +128,36 @@ public:
         }
     }
 
+    virtual void schedule_update(pipeline::SenderLoop& sender,
+                                 core::nanoseconds_t deadline) {
+        core::Mutex::Lock lock(mutex_);
+        if (updates_stopped_) {
+            return;
+        }
+        if (!update_task_) {
+            update_task_ = new UpdateTask(sender);
+        }
+        queue_.schedule_at(*update_task_, deadline, *this, NULL);
+    }
+
 private:
     ctl::ControlTaskResult do_processing_(ctl::ControlTask& task) {
         ((ProcessingTask&)task).pipeline_.process_tasks();
         return ctl::ControlTaskSuccess;
     }
 
+    ctl::ControlTaskResult do_update_(ctl::ControlTask& task) {
+        ((UpdateTask&)task).sender_.update();
+        n_updates_++;
+        return ctl::ControlTaskSuccess;
+    }
+
     core::Mutex mutex_;
     ctl::ControlTaskQueue queue_;
     ProcessingTask* task_;
+    UpdateTask* update_task_;
+    bool updates_stopped_;
+    core::Atomic<int> n_updates_;
 };
 
 } // namespace test
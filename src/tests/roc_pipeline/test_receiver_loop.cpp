@@ -68,7 +68,7 @@ public:
             slot_ = task_create_slot_->get_handle();
             roc_panic_if_not(slot_);
             task_create_endpoint_ = new ReceiverLoop::Tasks::CreateEndpoint(
-                slot_, address::Iface_AudioSource, address::Proto_RTP);
+                slot_, address::Iface_AudioSource, address::Proto_RTP, NULL);
             pipeline_.schedule(*task_create_endpoint_, *this);
             return;
         }
@@ -134,7 +134,7 @@ TEST(receiver_loop, endpoints_sync) {
 
     {
         ReceiverLoop::Tasks::CreateEndpoint task(slot, address::Iface_AudioSource,
-                                                 address::Proto_RTP);
+                                                 address::Proto_RTP, NULL);
         CHECK(receiver.schedule_and_wait(task));
         CHECK(task.success());
         CHECK(task.get_writer());
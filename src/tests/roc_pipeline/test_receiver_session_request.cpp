@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "test_helpers/utils.h"
+
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/receiver_session_request.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+enum { MaxBufSize = 500, SrcPort = 1, Source = 123 };
+
+core::HeapAllocator allocator;
+core::BufferFactory<audio::sample_t> sample_buffer_factory(allocator, MaxBufSize, true);
+core::BufferFactory<uint8_t> byte_buffer_factory(allocator, MaxBufSize, true);
+packet::PacketFactory packet_factory(allocator, true);
+
+rtp::FormatMap format_map;
+
+packet::PacketPtr
+new_packet(int src_port, packet::source_t source, packet::seqnum_t seqnum) {
+    packet::PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+
+    pp->add_flags(packet::Packet::FlagUDP | packet::Packet::FlagRTP);
+
+    pp->udp()->src_addr = test::new_address(src_port);
+    pp->udp()->dst_addr = test::new_address(2);
+
+    pp->rtp()->source = source;
+    pp->rtp()->seqnum = seqnum;
+
+    return pp;
+}
+
+} // namespace
+
+TEST_GROUP(receiver_session_request) {
+    ReceiverSessionConfig session_config;
+    ReceiverCommonConfig common_config;
+};
+
+TEST(receiver_session_request, buffer_packets) {
+    const ReceiverSessionMatcher matcher(*new_packet(SrcPort, Source, 0), false);
+
+    core::SharedPtr<ReceiverSessionRequest> request = new (allocator)
+        ReceiverSessionRequest(session_config, common_config, matcher, format_map,
+                               packet_factory, byte_buffer_factory,
+                               sample_buffer_factory, allocator);
+    CHECK(request);
+
+    CHECK(request->handle(new_packet(SrcPort, Source, 1)));
+    CHECK(request->handle(new_packet(SrcPort, Source, 2)));
+    CHECK(!request->handle(new_packet(SrcPort + 1, Source, 3)));
+
+    UNSIGNED_LONGS_EQUAL(2, request->num_packets());
+    UNSIGNED_LONGS_EQUAL(0, request->num_dropped_packets());
+
+    packet::PacketPtr pp = request->next_packet();
+    CHECK(pp);
+    LONGS_EQUAL(1, pp->rtp()->seqnum);
+
+    pp = request->next_packet();
+    CHECK(pp);
+    LONGS_EQUAL(2, pp->rtp()->seqnum);
+
+    CHECK(!request->next_packet());
+}
+
+TEST(receiver_session_request, buffer_limit) {
+    const ReceiverSessionMatcher matcher(*new_packet(SrcPort, Source, 0), false);
+
+    core::SharedPtr<ReceiverSessionRequest> request = new (allocator)
+        ReceiverSessionRequest(session_config, common_config, matcher, format_map,
+                               packet_factory, byte_buffer_factory,
+                               sample_buffer_factory, allocator);
+    CHECK(request);
+
+    const size_t n_extra = 10;
+
+    for (size_t n = 0; n < ReceiverSessionRequest::MaxPackets + n_extra; n++) {
+        // packets beyond limit are still consumed, but dropped
+        CHECK(request->handle(new_packet(SrcPort, Source, packet::seqnum_t(n))));
+    }
+
+    UNSIGNED_LONGS_EQUAL(ReceiverSessionRequest::MaxPackets, request->num_packets());
+    UNSIGNED_LONGS_EQUAL(n_extra, request->num_dropped_packets());
+
+    // oldest packets are kept
+    packet::PacketPtr pp = request->next_packet();
+    CHECK(pp);
+    LONGS_EQUAL(0, pp->rtp()->seqnum);
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -10,6 +10,7 @@
 
 #include "test_helpers/frame_reader.h"
 #include "test_helpers/packet_writer.h"
+#include "test_helpers/utils.h"
 
 #include "roc_core/atomic.h"
 #include "roc_core/buffer_factory.h"
@@ -17,7 +18,10 @@
 #include "roc_core/time.h"
 #include "roc_fec/codec_map.h"
 #include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
 #include "roc_pipeline/receiver_source.h"
+#include "roc_rtcp/builder.h"
+#include "roc_rtcp/traverser.h"
 #include "roc_rtp/composer.h"
 #include "roc_rtp/format_map.h"
 
@@ -70,11 +74,42 @@ ReceiverSlot* create_slot(ReceiverSource& source) {
 packet::IWriter*
 create_endpoint(ReceiverSlot* slot, address::Interface iface, address::Protocol proto) {
     CHECK(slot);
-    ReceiverEndpoint* endpoint = slot->create_endpoint(iface, proto);
+    ReceiverEndpoint* endpoint = slot->create_endpoint(iface, proto, NULL);
     CHECK(endpoint);
     return &endpoint->writer();
 }
 
+packet::PacketPtr
+new_control_packet(packet::source_t ssrc, int src_port, bool bye = false) {
+    core::Slice<uint8_t> buff = byte_buffer_factory.new_buffer();
+    CHECK(buff);
+    buff.reslice(0, 0);
+
+    rtcp::Builder builder(buff);
+
+    rtcp::header::SenderReportPacket sr;
+    sr.set_ssrc(ssrc);
+    sr.set_ntp_timestamp(packet::ntp_timestamp());
+
+    builder.begin_sr(sr);
+    builder.end_sr();
+
+    if (bye) {
+        builder.begin_bye();
+        builder.add_bye_ssrc(ssrc);
+        builder.end_bye();
+    }
+
+    packet::PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+
+    pp->add_flags(packet::Packet::FlagUDP);
+    pp->udp()->src_addr = test::new_address(src_port);
+    pp->set_data(buff);
+
+    return pp;
+}
+
 } // namespace
 
 TEST_GROUP(receiver_source) {
@@ -171,6 +206,304 @@ TEST(receiver_source, one_session) {
     }
 }
 
+TEST(receiver_source, metrics) {
+    enum { Source = 123, NumPackets = 10, MaxSessions = 5 };
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint1_writer);
+
+    ReceiverSessionMetrics metrics[MaxSessions];
+    size_t metrics_size = MaxSessions;
+
+    receiver.get_metrics(metrics, &metrics_size);
+    UNSIGNED_LONGS_EQUAL(0, metrics_size);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketWriter packet_writer(allocator, *endpoint1_writer, rtp_composer,
+                                     format_map, packet_factory, byte_buffer_factory,
+                                     PayloadType, src1, dst1);
+
+    packet_writer.set_source(Source);
+    packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                SampleSpecs);
+
+    for (size_t np = 0; np < NumPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+        }
+
+        packet_writer.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+
+    metrics_size = MaxSessions;
+    receiver.get_metrics(metrics, &metrics_size);
+    UNSIGNED_LONGS_EQUAL(1, metrics_size);
+
+    UNSIGNED_LONGS_EQUAL(Source, metrics[0].source);
+    CHECK(metrics[0].frames.n_frames >= NumPackets * FramesPerPacket);
+    UNSIGNED_LONGS_EQUAL(0, metrics[0].frames.n_blank_frames);
+    UNSIGNED_LONGS_EQUAL(0, metrics[0].frames.n_merged_statuses);
+
+    metrics_size = 0;
+    receiver.get_metrics(metrics, &metrics_size);
+    UNSIGNED_LONGS_EQUAL(0, metrics_size);
+}
+
+TEST(receiver_source, control_reports) {
+    enum { Source = 123, SenderSsrc = 456, SenderPort = 789 };
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint1_writer);
+
+    packet::Queue outbound_queue;
+
+    ReceiverEndpoint* control_endpoint = slot->create_endpoint(
+        address::Iface_AudioControl, address::Proto_RTCP, &outbound_queue);
+    CHECK(control_endpoint);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketWriter packet_writer(allocator, *endpoint1_writer, rtp_composer,
+                                     format_map, packet_factory, byte_buffer_factory,
+                                     PayloadType, src1, dst1);
+
+    packet_writer.set_source(Source);
+    packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                SampleSpecs);
+
+    for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+        frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+
+    // no reports until we know where to send them
+    UNSIGNED_LONGS_EQUAL(0, outbound_queue.size());
+
+    control_endpoint->writer().write(new_control_packet(SenderSsrc, SenderPort));
+
+    frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+    packet::PacketPtr pp = outbound_queue.read();
+    CHECK(pp);
+    CHECK(!outbound_queue.read());
+
+    CHECK(pp->flags() & packet::Packet::FlagComposed);
+    CHECK(pp->udp());
+    CHECK(pp->udp()->dst_addr == test::new_address(SenderPort));
+
+    rtcp::Traverser traverser(pp->data());
+    CHECK(traverser.parse());
+
+    rtcp::Traverser::Iterator iter = traverser.iter();
+    CHECK_EQUAL(rtcp::Traverser::Iterator::RR, iter.next());
+
+    UNSIGNED_LONGS_EQUAL(1, iter.get_rr().num_blocks());
+    UNSIGNED_LONGS_EQUAL(Source, iter.get_rr().get_block(0).ssrc());
+}
+
+TEST(receiver_source, control_sending_metrics) {
+    enum { Source1 = 123, Source2 = 456, SenderPort = 789 };
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint1_writer);
+
+    packet::Queue outbound_queue;
+
+    ReceiverEndpoint* control_endpoint = slot->create_endpoint(
+        address::Iface_AudioControl, address::Proto_RTCP, &outbound_queue);
+    CHECK(control_endpoint);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketWriter packet_writer1(allocator, *endpoint1_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src1, dst1);
+
+    test::PacketWriter packet_writer2(allocator, *endpoint1_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src2, dst1);
+
+    packet_writer1.set_source(Source1);
+    packet_writer2.set_source(Source2);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, SampleSpecs);
+        packet_writer2.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+
+    for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+        frame_reader.read_samples(SamplesPerFrame * NumCh, 2);
+    }
+
+    UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+
+    // sender report from first source
+    control_endpoint->writer().write(new_control_packet(Source1, SenderPort));
+
+    frame_reader.read_samples(SamplesPerFrame * NumCh, 2);
+
+    packet::PacketPtr pp = outbound_queue.read();
+    CHECK(pp);
+
+    rtcp::Traverser traverser(pp->data());
+    CHECK(traverser.parse());
+
+    rtcp::Traverser::Iterator iter = traverser.iter();
+    CHECK_EQUAL(rtcp::Traverser::Iterator::RR, iter.next());
+
+    const rtcp::header::ReceiverReportPacket& rr = iter.get_rr();
+    UNSIGNED_LONGS_EQUAL(2, rr.num_blocks());
+
+    // only session of first source got sender report
+    for (size_t n = 0; n < rr.num_blocks(); n++) {
+        const rtcp::header::ReceptionReportBlock& blk = rr.get_block(n);
+
+        if (blk.ssrc() == Source1) {
+            CHECK(blk.last_sr() != 0);
+        } else {
+            UNSIGNED_LONGS_EQUAL(Source2, blk.ssrc());
+            UNSIGNED_LONGS_EQUAL(0, blk.last_sr());
+        }
+    }
+}
+
+TEST(receiver_source, control_bye) {
+    enum { Source1 = 123, Source2 = 456, SenderPort = 789 };
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint1_writer);
+
+    ReceiverEndpoint* control_endpoint =
+        slot->create_endpoint(address::Iface_AudioControl, address::Proto_RTCP, NULL);
+    CHECK(control_endpoint);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketWriter packet_writer1(allocator, *endpoint1_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src1, dst1);
+
+    test::PacketWriter packet_writer2(allocator, *endpoint1_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src2, dst1);
+
+    packet_writer1.set_source(Source1);
+    packet_writer2.set_source(Source2);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, SampleSpecs);
+        packet_writer2.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+
+    for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+        frame_reader.read_samples(SamplesPerFrame * NumCh, 2);
+    }
+
+    UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+
+    // first source says goodbye
+    control_endpoint->writer().write(new_control_packet(Source1, SenderPort, true));
+
+    frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+    UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+}
+
+TEST(receiver_source, one_session_async_creation) {
+    enum { MaxWaitIterations = 1000 };
+
+    config.common.async_session_creation = true;
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketWriter packet_writer(allocator, *endpoint1_writer, rtp_composer,
+                                     format_map, packet_factory, byte_buffer_factory,
+                                     PayloadType, src1, dst1);
+
+    packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                SampleSpecs);
+
+    // session is built in background, and until it's attached, we get silence;
+    // packets received meanwhile should not be lost
+    size_t nf = 0;
+    for (size_t ni = 0;; ni++) {
+        CHECK(ni < MaxWaitIterations);
+
+        if (frame_reader.read_samples_or_zeros(SamplesPerFrame * NumCh, 1)) {
+            nf++;
+            break;
+        }
+
+        UNSIGNED_LONGS_EQUAL(0, receiver.num_sessions());
+        CHECK(receiver.state() == sndio::DeviceState_Active);
+
+        core::sleep_for(core::ClockMonotonic, core::Millisecond);
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+            UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+        }
+        nf = 0;
+
+        packet_writer.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+}
+
 TEST(receiver_source, one_session_long_run) {
     enum { NumIterations = 10 };
 
@@ -583,6 +916,173 @@ TEST(receiver_source, two_sessions_same_address_different_streams) {
     }
 }
 
+TEST(receiver_source, multipath_same_stream) {
+    config.common.multipath = true;
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot1 = create_slot(receiver);
+    CHECK(slot1);
+
+    packet::IWriter* endpoint1_writer =
+        create_endpoint(slot1, address::Iface_AudioSource, proto1);
+    CHECK(endpoint1_writer);
+
+    ReceiverSlot* slot2 = create_slot(receiver);
+    CHECK(slot2);
+
+    packet::IWriter* endpoint2_writer =
+        create_endpoint(slot2, address::Iface_AudioSource, proto2);
+    CHECK(endpoint2_writer);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketWriter packet_writer1(allocator, *endpoint1_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src1, dst1);
+
+    test::PacketWriter packet_writer2(allocator, *endpoint2_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src2, dst2);
+
+    packet_writer1.set_source(11);
+    packet_writer2.set_source(11);
+
+    // every packet is delivered twice, via both paths
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, SampleSpecs);
+        packet_writer2.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+            UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, SampleSpecs);
+        packet_writer2.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+}
+
+TEST(receiver_source, multipath_losses_on_both_paths) {
+    config.common.multipath = true;
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot1 = create_slot(receiver);
+    CHECK(slot1);
+
+    packet::IWriter* endpoint1_writer =
+        create_endpoint(slot1, address::Iface_AudioSource, proto1);
+    CHECK(endpoint1_writer);
+
+    ReceiverSlot* slot2 = create_slot(receiver);
+    CHECK(slot2);
+
+    packet::IWriter* endpoint2_writer =
+        create_endpoint(slot2, address::Iface_AudioSource, proto2);
+    CHECK(endpoint2_writer);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketWriter packet_writer1(allocator, *endpoint1_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src1, dst1);
+
+    test::PacketWriter packet_writer2(allocator, *endpoint2_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src2, dst2);
+
+    packet_writer1.set_source(11);
+    packet_writer2.set_source(11);
+
+    // first path loses odd packets, second path loses even packets,
+    // together they deliver every packet
+    size_t sn = 0;
+
+    for (; sn < Latency / SamplesPerPacket; sn++) {
+        test::PacketWriter& lossy_writer = sn % 2 ? packet_writer1 : packet_writer2;
+        test::PacketWriter& good_writer = sn % 2 ? packet_writer2 : packet_writer1;
+
+        good_writer.write_packets(1, SamplesPerPacket, SampleSpecs);
+        lossy_writer.shift_to(sn + 1, SamplesPerPacket, SampleSpecs);
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++, sn++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+            UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+        }
+
+        test::PacketWriter& lossy_writer = sn % 2 ? packet_writer1 : packet_writer2;
+        test::PacketWriter& good_writer = sn % 2 ? packet_writer2 : packet_writer1;
+
+        good_writer.write_packets(1, SamplesPerPacket, SampleSpecs);
+        lossy_writer.shift_to(sn + 1, SamplesPerPacket, SampleSpecs);
+    }
+}
+
+TEST(receiver_source, multipath_different_streams) {
+    config.common.multipath = true;
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot1 = create_slot(receiver);
+    CHECK(slot1);
+
+    packet::IWriter* endpoint1_writer =
+        create_endpoint(slot1, address::Iface_AudioSource, proto1);
+    CHECK(endpoint1_writer);
+
+    ReceiverSlot* slot2 = create_slot(receiver);
+    CHECK(slot2);
+
+    packet::IWriter* endpoint2_writer =
+        create_endpoint(slot2, address::Iface_AudioSource, proto2);
+    CHECK(endpoint2_writer);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketWriter packet_writer1(allocator, *endpoint1_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src1, dst1);
+
+    test::PacketWriter packet_writer2(allocator, *endpoint2_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src2, dst2);
+
+    packet_writer1.set_source(11);
+    packet_writer2.set_source(22);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, SampleSpecs);
+        packet_writer2.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, 2);
+
+            UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, SampleSpecs);
+        packet_writer2.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+}
+
 TEST(receiver_source, seqnum_overflow) {
     ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
                             sample_buffer_factory, allocator);
@@ -12,6 +12,8 @@
 
 #include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_core/mutex.h"
+#include "roc_core/time.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/sender_loop.h"
 #include "roc_rtp/format_map.h"
@@ -21,7 +23,7 @@ namespace pipeline {
 
 namespace {
 
-enum { MaxBufSize = 1000 };
+enum { MaxBufSize = 1000, MaxPackets = 100 };
 
 core::HeapAllocator allocator;
 core::BufferFactory<audio::sample_t> sample_buffer_factory(allocator, MaxBufSize, true);
@@ -30,6 +32,38 @@ packet::PacketFactory packet_factory(allocator, true);
 
 rtp::FormatMap format_map;
 
+class TimestampWriter : public packet::IWriter {
+public:
+    TimestampWriter()
+        : n_packets_(0) {
+    }
+
+    virtual void write(const packet::PacketPtr&) {
+        core::Mutex::Lock lock(mutex_);
+
+        CHECK(n_packets_ < MaxPackets);
+        timestamps_[n_packets_++] = core::timestamp(core::ClockMonotonic);
+    }
+
+    size_t num_packets() const {
+        core::Mutex::Lock lock(mutex_);
+
+        return n_packets_;
+    }
+
+    core::nanoseconds_t timestamp(size_t n) const {
+        core::Mutex::Lock lock(mutex_);
+
+        CHECK(n < n_packets_);
+        return timestamps_[n];
+    }
+
+private:
+    core::Mutex mutex_;
+    core::nanoseconds_t timestamps_[MaxPackets];
+    size_t n_packets_;
+};
+
 class TaskIssuer : public IPipelineTaskCompleter {
 public:
     TaskIssuer(PipelineLoop& pipeline)
@@ -97,8 +131,8 @@ TEST_GROUP(sender_loop) {
 };
 
 TEST(sender_loop, endpoints_sync) {
-    SenderLoop sender(scheduler, config, format_map, packet_factory, byte_buffer_factory,
-                      sample_buffer_factory, allocator);
+    SenderLoop sender(scheduler, scheduler, config, format_map, packet_factory,
+                      byte_buffer_factory, sample_buffer_factory, allocator);
     CHECK(sender.valid());
 
     SenderLoop::SlotHandle slot = NULL;
@@ -122,8 +156,8 @@ TEST(sender_loop, endpoints_sync) {
 }
 
 TEST(sender_loop, endpoints_async) {
-    SenderLoop sender(scheduler, config, format_map, packet_factory, byte_buffer_factory,
-                      sample_buffer_factory, allocator);
+    SenderLoop sender(scheduler, scheduler, config, format_map, packet_factory,
+                      byte_buffer_factory, sample_buffer_factory, allocator);
     CHECK(sender.valid());
 
     TaskIssuer ti(sender);
@@ -134,5 +168,82 @@ TEST(sender_loop, endpoints_async) {
     scheduler.wait_done();
 }
 
+TEST(sender_loop, pacing) {
+    enum { NumPackets = 10, SamplesPerPacket = 200 };
+
+    config.packet_length =
+        config.input_sample_spec.samples_per_chan_2_ns(SamplesPerPacket);
+    config.pacing = true;
+    config.pacer.max_delay = core::Second;
+
+    const core::nanoseconds_t cost = core::nanoseconds_t(
+        double(config.packet_length) / double(config.pacer.rate_headroom));
+    const size_t burst = config.pacer.burst_packets;
+
+    SenderLoop sender(scheduler, scheduler, config, format_map, packet_factory,
+                      byte_buffer_factory, sample_buffer_factory, allocator);
+    CHECK(sender.valid());
+
+    TimestampWriter writer;
+
+    SenderLoop::SlotHandle slot = NULL;
+    SenderLoop::EndpointHandle endpoint = NULL;
+
+    {
+        SenderLoop::Tasks::CreateSlot task;
+        CHECK(sender.schedule_and_wait(task));
+        slot = task.get_handle();
+        CHECK(slot);
+    }
+
+    {
+        SenderLoop::Tasks::CreateEndpoint task(slot, address::Iface_AudioSource,
+                                               address::Proto_RTP);
+        CHECK(sender.schedule_and_wait(task));
+        endpoint = task.get_handle();
+        CHECK(endpoint);
+    }
+
+    {
+        SenderLoop::Tasks::SetEndpointDestinationWriter task(endpoint, writer);
+        CHECK(sender.schedule_and_wait(task));
+    }
+
+    CHECK_EQUAL(2, config.input_sample_spec.num_channels());
+
+    audio::sample_t samples[SamplesPerPacket * 2] = {};
+
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+
+    // all packets are produced at once, and pacer sends only a burst of them
+    for (size_t np = 0; np < NumPackets; np++) {
+        audio::Frame frame(samples, SamplesPerPacket * 2);
+        sender.sink().write(frame);
+    }
+
+    CHECK(writer.num_packets() < NumPackets);
+
+    // the rest is sent from update scheduler, without writing frames
+    while (writer.num_packets() < NumPackets) {
+        CHECK(core::timestamp(core::ClockMonotonic) - start_time < core::Second);
+        core::sleep_for(core::ClockMonotonic, core::Millisecond);
+    }
+
+    scheduler.wait_done();
+
+    CHECK(scheduler.num_updates() > 0);
+
+    // pacer is a token bucket, so packet can't be sent earlier than
+    // burst is exhausted and enough tokens are accumulated for it
+    for (size_t np = burst; np < NumPackets; np++) {
+        CHECK(writer.timestamp(np)
+              >= start_time + core::nanoseconds_t(np - burst + 1) * cost);
+    }
+
+    // and packets are not delayed much more than that
+    CHECK(writer.timestamp(NumPackets - 1)
+          < start_time + core::nanoseconds_t(NumPackets) * cost + core::Second / 2);
+}
+
 } // namespace pipeline
 } // namespace roc
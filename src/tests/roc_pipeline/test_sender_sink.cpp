@@ -20,6 +20,8 @@
 #include "roc_packet/queue.h"
 #include "roc_pipeline/sender_sink.h"
 #include "roc_rtp/format_map.h"
+#include "roc_rtcp/sdes_traverser.h"
+#include "roc_rtcp/traverser.h"
 #include "roc_rtp/parser.h"
 
 namespace roc {
@@ -56,6 +58,26 @@ packet::PacketFactory packet_factory(allocator, true);
 rtp::FormatMap format_map;
 rtp::Parser rtp_parser(format_map, NULL);
 
+size_t count_rtcp_chunks(const packet::Packet& packet) {
+    rtcp::Traverser traverser(packet.data());
+    CHECK(traverser.parse());
+
+    size_t n_chunks = 0;
+
+    rtcp::Traverser::Iterator iter = traverser.iter();
+    rtcp::Traverser::Iterator::State state;
+
+    while ((state = iter.next()) != rtcp::Traverser::Iterator::END) {
+        if (state == rtcp::Traverser::Iterator::SDES) {
+            rtcp::SdesTraverser sdes = iter.get_sdes();
+            CHECK(sdes.parse());
+            n_chunks += sdes.chunks_count();
+        }
+    }
+
+    return n_chunks;
+}
+
 } // namespace
 
 TEST_GROUP(sender_sink) {
@@ -112,6 +134,50 @@ TEST(sender_sink, write) {
     CHECK(!queue.read());
 }
 
+TEST(sender_sink, pacing) {
+    packet::Queue queue;
+
+    config.pacing = true;
+
+    SenderSink sender(config, format_map, packet_factory, byte_buffer_factory,
+                      sample_buffer_factory, allocator);
+    CHECK(sender.valid());
+
+    SenderSlot* slot = sender.create_slot();
+    CHECK(slot);
+
+    SenderEndpoint* source_endpoint =
+        slot->create_endpoint(address::Iface_AudioSource, source_proto);
+    CHECK(source_endpoint);
+
+    source_endpoint->set_destination_writer(queue);
+    source_endpoint->set_destination_address(dst_addr);
+
+    test::FrameWriter frame_writer(sender, sample_buffer_factory);
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    // frames are written faster than real time, so pacer holds packets
+    CHECK(queue.size() < ManyFrames / FramesPerPacket);
+    CHECK(sender.get_update_deadline() != 0);
+
+    while (core::nanoseconds_t deadline = sender.get_update_deadline()) {
+        core::sleep_until(core::ClockMonotonic, deadline);
+        sender.update();
+    }
+
+    test::PacketReader packet_reader(allocator, queue, rtp_parser, format_map,
+                                     packet_factory, PayloadType, dst_addr);
+
+    for (size_t np = 0; np < ManyFrames / FramesPerPacket; np++) {
+        packet_reader.read_packet(SamplesPerPacket, SampleSpecs);
+    }
+
+    CHECK(!queue.read());
+}
+
 TEST(sender_sink, frame_size_small) {
     enum {
         SamplesPerSmallFrame = SamplesPerFrame / 2,
@@ -190,5 +256,92 @@ TEST(sender_sink, frame_size_large) {
     CHECK(!queue.read());
 }
 
+TEST(sender_sink, many_slots) {
+    enum { NumSlots = 3 };
+
+    packet::Queue queues[NumSlots];
+    address::SocketAddr addrs[NumSlots];
+
+    SenderSink sender(config, format_map, packet_factory, byte_buffer_factory,
+                      sample_buffer_factory, allocator);
+    CHECK(sender.valid());
+
+    for (size_t ns = 0; ns < NumSlots; ns++) {
+        SenderSlot* slot = sender.create_slot();
+        CHECK(slot);
+
+        SenderEndpoint* source_endpoint =
+            slot->create_endpoint(address::Iface_AudioSource, source_proto);
+        CHECK(source_endpoint);
+
+        addrs[ns] = test::new_address(int(123 + ns));
+
+        source_endpoint->set_destination_writer(queues[ns]);
+        source_endpoint->set_destination_address(addrs[ns]);
+
+        CHECK(slot->is_ready());
+    }
+
+    test::FrameWriter frame_writer(sender, sample_buffer_factory);
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    for (size_t ns = 0; ns < NumSlots; ns++) {
+        test::PacketReader packet_reader(allocator, queues[ns], rtp_parser, format_map,
+                                         packet_factory, PayloadType, addrs[ns]);
+
+        for (size_t np = 0; np < ManyFrames / FramesPerPacket; np++) {
+            packet_reader.read_packet(SamplesPerPacket, SampleSpecs);
+        }
+
+        CHECK(!queues[ns].read());
+    }
+}
+
+TEST(sender_sink, many_slots_control) {
+    enum { NumSlots = 3 };
+
+    packet::Queue source_queues[NumSlots];
+    packet::Queue control_queues[NumSlots];
+
+    SenderSink sender(config, format_map, packet_factory, byte_buffer_factory,
+                      sample_buffer_factory, allocator);
+    CHECK(sender.valid());
+
+    for (size_t ns = 0; ns < NumSlots; ns++) {
+        SenderSlot* slot = sender.create_slot();
+        CHECK(slot);
+
+        SenderEndpoint* source_endpoint =
+            slot->create_endpoint(address::Iface_AudioSource, source_proto);
+        CHECK(source_endpoint);
+
+        source_endpoint->set_destination_writer(source_queues[ns]);
+        source_endpoint->set_destination_address(test::new_address(int(123 + ns)));
+
+        SenderEndpoint* control_endpoint =
+            slot->create_endpoint(address::Iface_AudioControl, address::Proto_RTCP);
+        CHECK(control_endpoint);
+
+        control_endpoint->set_destination_writer(control_queues[ns]);
+        control_endpoint->set_destination_address(test::new_address(int(223 + ns)));
+
+        CHECK(slot->is_ready());
+    }
+
+    sender.update();
+
+    // every slot, including ones that share transport pipeline of the first
+    // slot, reports own ssrc and source of that pipeline
+    for (size_t ns = 0; ns < NumSlots; ns++) {
+        packet::PacketPtr pp = control_queues[ns].read();
+        CHECK(pp);
+        UNSIGNED_LONGS_EQUAL(2, count_rtcp_chunks(*pp));
+        CHECK(!control_queues[ns].read());
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -14,11 +14,15 @@
 
 #include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_core/time.h"
 #include "roc_fec/codec_map.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_packet/queue.h"
 #include "roc_pipeline/receiver_source.h"
 #include "roc_pipeline/sender_sink.h"
+#include "roc_rtcp/builder.h"
+#include "roc_rtcp/headers.h"
+#include "roc_rtcp/traverser.h"
 #include "roc_rtp/format_map.h"
 
 namespace roc {
@@ -71,7 +75,10 @@ enum {
     FlagReedSolomon = (1 << 4),
 
     // enable LDPC-Staircase FEC scheme on sender
-    FlagLDPC = (1 << 5)
+    FlagLDPC = (1 << 5),
+
+    // enable redundant audio on sender
+    FlagRedundancy = (1 << 6)
 };
 
 core::HeapAllocator allocator;
@@ -99,6 +106,7 @@ SenderConfig sender_config(int flags) {
     config.fec_writer.n_repair_packets = RepairPackets;
 
     config.interleaving = (flags & FlagInterleaving);
+    config.redundancy_depth = (flags & FlagRedundancy) ? 1 : 0;
     config.timing = false;
     config.poisoning = true;
     config.profiling = true;
@@ -226,13 +234,13 @@ void send_receive(int flags, size_t num_sessions) {
     packet::IWriter* receiver_repair_endpoint_writer = NULL;
 
     receiver_source_endpoint =
-        receiver_slot->create_endpoint(address::Iface_AudioSource, source_proto);
+        receiver_slot->create_endpoint(address::Iface_AudioSource, source_proto, NULL);
     CHECK(receiver_source_endpoint);
     receiver_source_endpoint_writer = &receiver_source_endpoint->writer();
 
     if (repair_proto != address::Proto_None) {
-        receiver_repair_endpoint =
-            receiver_slot->create_endpoint(address::Iface_AudioRepair, repair_proto);
+        receiver_repair_endpoint = receiver_slot->create_endpoint(
+            address::Iface_AudioRepair, repair_proto, NULL);
         CHECK(receiver_repair_endpoint);
         receiver_repair_endpoint_writer = &receiver_repair_endpoint->writer();
     }
@@ -263,6 +271,64 @@ void send_receive(int flags, size_t num_sessions) {
     }
 }
 
+// Returns block length of last repair packet in queue, and drains queue.
+size_t last_block_length(packet::Queue& queue) {
+    size_t block_length = 0;
+
+    while (packet::PacketPtr pp = queue.read()) {
+        if (pp->flags() & packet::Packet::FlagRepair) {
+            CHECK(pp->fec());
+            block_length = pp->fec()->block_length;
+        }
+    }
+
+    return block_length;
+}
+
+// Simulates delivery of control packet over network.
+packet::PacketPtr deliver_control_packet(const packet::PacketPtr& pa,
+                                         const address::SocketAddr& src_addr) {
+    packet::PacketPtr pb = packet_factory.new_packet();
+    CHECK(pb);
+
+    CHECK(pa->flags() & packet::Packet::FlagUDP);
+    pb->add_flags(packet::Packet::FlagUDP);
+    *pb->udp() = *pa->udp();
+    pb->udp()->src_addr = src_addr;
+
+    pb->set_data(pa->data());
+
+    return pb;
+}
+
+packet::PacketPtr new_receiver_report(packet::source_t ssrc) {
+    core::Slice<uint8_t> buff = byte_buffer_factory.new_buffer();
+    CHECK(buff);
+    buff.reslice(0, 0);
+
+    rtcp::Builder builder(buff);
+
+    rtcp::header::ReceiverReportPacket rr;
+    rr.set_ssrc(ssrc + 1);
+
+    rtcp::header::ReceptionReportBlock blk;
+    blk.set_ssrc(ssrc);
+    blk.set_fract_loss(0, 1);
+
+    builder.begin_rr(rr);
+    builder.add_rr_report(blk);
+    builder.end_rr();
+
+    packet::PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+
+    pp->add_flags(packet::Packet::FlagUDP);
+    pp->udp()->src_addr = test::new_address(33);
+    pp->set_data(buff);
+
+    return pp;
+}
+
 } // namespace
 
 TEST_GROUP(sender_sink_receiver_source) {};
@@ -275,6 +341,10 @@ TEST(sender_sink_receiver_source, interleaving) {
     send_receive(FlagInterleaving, 1);
 }
 
+TEST(sender_sink_receiver_source, redundancy_loss) {
+    send_receive(FlagRedundancy | FlagLosses, 1);
+}
+
 TEST(sender_sink_receiver_source, fec_rs) {
     if (is_fec_supported(FlagReedSolomon)) {
         send_receive(FlagReedSolomon, 1);
@@ -311,5 +381,210 @@ TEST(sender_sink_receiver_source, fec_drop_repair) {
     }
 }
 
+// Sender sends report to receiver, receiver replies with report about the
+// stream, and sender adapts FEC redundancy to it and measures round-trip.
+TEST(sender_sink_receiver_source, control_feedback) {
+    if (!is_fec_supported(FlagLDPC)) {
+        return;
+    }
+
+    enum { BlockFrames = SourcePackets * FramesPerPacket };
+
+    const core::nanoseconds_t NetworkDelay = 5 * core::Millisecond;
+
+    packet::Queue queue;
+    packet::Queue sender_control_queue;
+    packet::Queue receiver_control_queue;
+
+    const address::SocketAddr sender_control_addr = test::new_address(33);
+    const address::SocketAddr receiver_control_addr = test::new_address(44);
+
+    SenderConfig config = sender_config(FlagLDPC);
+    config.fec_adaptation = true;
+
+    SenderSink sender(config, format_map, packet_factory, byte_buffer_factory,
+                      sample_buffer_factory, allocator);
+    CHECK(sender.valid());
+
+    SenderSlot* sender_slot = sender.create_slot();
+    CHECK(sender_slot);
+
+    SenderEndpoint* sender_source_endpoint = sender_slot->create_endpoint(
+        address::Iface_AudioSource, address::Proto_RTP_LDPC_Source);
+    CHECK(sender_source_endpoint);
+    sender_source_endpoint->set_destination_writer(queue);
+    sender_source_endpoint->set_destination_address(test::new_address(11));
+
+    SenderEndpoint* sender_repair_endpoint = sender_slot->create_endpoint(
+        address::Iface_AudioRepair, address::Proto_LDPC_Repair);
+    CHECK(sender_repair_endpoint);
+    sender_repair_endpoint->set_destination_writer(queue);
+    sender_repair_endpoint->set_destination_address(test::new_address(22));
+
+    SenderEndpoint* sender_control_endpoint =
+        sender_slot->create_endpoint(address::Iface_AudioControl, address::Proto_RTCP);
+    CHECK(sender_control_endpoint);
+    CHECK(sender_control_endpoint->inbound_writer());
+    sender_control_endpoint->set_destination_writer(sender_control_queue);
+    sender_control_endpoint->set_destination_address(receiver_control_addr);
+
+    ReceiverSource receiver(receiver_config(), format_map, packet_factory,
+                            byte_buffer_factory, sample_buffer_factory, allocator);
+    CHECK(receiver.valid());
+
+    ReceiverSlot* receiver_slot = receiver.create_slot();
+    CHECK(receiver_slot);
+
+    ReceiverEndpoint* receiver_source_endpoint = receiver_slot->create_endpoint(
+        address::Iface_AudioSource, address::Proto_RTP_LDPC_Source, NULL);
+    CHECK(receiver_source_endpoint);
+
+    ReceiverEndpoint* receiver_repair_endpoint = receiver_slot->create_endpoint(
+        address::Iface_AudioRepair, address::Proto_LDPC_Repair, NULL);
+    CHECK(receiver_repair_endpoint);
+
+    ReceiverEndpoint* receiver_control_endpoint = receiver_slot->create_endpoint(
+        address::Iface_AudioControl, address::Proto_RTCP, &receiver_control_queue);
+    CHECK(receiver_control_endpoint);
+
+    test::FrameWriter frame_writer(sender, sample_buffer_factory);
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketSender packet_sender(packet_factory, &receiver_source_endpoint->writer(),
+                                     &receiver_repair_endpoint->writer());
+
+    for (size_t nf = 0; nf < BlockFrames * 2; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    // first report is generated immediately
+    sender.update();
+
+    packet::PacketPtr sr = sender_control_queue.read();
+    CHECK(sr);
+    CHECK(sr->udp());
+    CHECK(sr->udp()->dst_addr == receiver_control_addr);
+
+    filter_packets(FlagNone, queue, packet_sender);
+    packet_sender.deliver(Latency / SamplesPerPacket);
+
+    frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+    UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+
+    core::sleep_for(core::ClockMonotonic, NetworkDelay);
+
+    // receiver learns where to send reports from sender report
+    receiver_control_endpoint->writer().write(
+        deliver_control_packet(sr, sender_control_addr));
+
+    frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+    packet::PacketPtr rr = receiver_control_queue.read();
+    CHECK(rr);
+    CHECK(rr->udp());
+    CHECK(rr->udp()->dst_addr == sender_control_addr);
+
+    SenderSessionMetrics metrics;
+    size_t metrics_size = 1;
+    sender.get_metrics(&metrics, &metrics_size);
+
+    UNSIGNED_LONGS_EQUAL(1, metrics_size);
+    UNSIGNED_LONGS_EQUAL(0, metrics.rtt);
+
+    // receiver reports about the stream identified in sender report
+    rtcp::Traverser traverser(rr->data());
+    CHECK(traverser.parse());
+    rtcp::Traverser::Iterator iter = traverser.iter();
+    CHECK_EQUAL(rtcp::Traverser::Iterator::RR, iter.next());
+    UNSIGNED_LONGS_EQUAL(1, iter.get_rr().num_blocks());
+    UNSIGNED_LONGS_EQUAL(metrics.source, iter.get_rr().get_block(0).ssrc());
+    CHECK(iter.get_rr().get_block(0).last_sr() != 0);
+
+    core::sleep_for(core::ClockMonotonic, NetworkDelay);
+
+    // no losses were reported, so sender releases one repair packet
+    // starting from next block
+    sender_control_endpoint->inbound_writer()->write(
+        deliver_control_packet(rr, receiver_control_addr));
+
+    for (size_t nf = 0; nf < BlockFrames * 2; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    UNSIGNED_LONGS_EQUAL(SourcePackets + RepairPackets - 1, last_block_length(queue));
+
+    sender.get_metrics(&metrics, &metrics_size);
+    UNSIGNED_LONGS_EQUAL(1, metrics_size);
+
+    // round-trip covers both delays, but not time spent by receiver
+    // between getting sender report and sending its own
+    CHECK(metrics.rtt >= NetworkDelay * 2 - core::Millisecond);
+    CHECK(metrics.rtt < NetworkDelay * 2 + core::Second);
+}
+
+// Reports about streams of other senders don't affect this sender.
+TEST(sender_sink_receiver_source, control_feedback_foreign_source) {
+    if (!is_fec_supported(FlagLDPC)) {
+        return;
+    }
+
+    enum { BlockFrames = SourcePackets * FramesPerPacket, ForeignSource = 123 };
+
+    packet::Queue queue;
+    packet::Queue control_queue;
+
+    SenderConfig config = sender_config(FlagLDPC);
+    config.fec_adaptation = true;
+
+    SenderSink sender(config, format_map, packet_factory, byte_buffer_factory,
+                      sample_buffer_factory, allocator);
+    CHECK(sender.valid());
+
+    SenderSlot* slot = sender.create_slot();
+    CHECK(slot);
+
+    SenderEndpoint* source_endpoint = slot->create_endpoint(
+        address::Iface_AudioSource, address::Proto_RTP_LDPC_Source);
+    CHECK(source_endpoint);
+    source_endpoint->set_destination_writer(queue);
+
+    SenderEndpoint* repair_endpoint =
+        slot->create_endpoint(address::Iface_AudioRepair, address::Proto_LDPC_Repair);
+    CHECK(repair_endpoint);
+    repair_endpoint->set_destination_writer(queue);
+
+    SenderEndpoint* control_endpoint =
+        slot->create_endpoint(address::Iface_AudioControl, address::Proto_RTCP);
+    CHECK(control_endpoint);
+    control_endpoint->set_destination_writer(control_queue);
+
+    test::FrameWriter frame_writer(sender, sample_buffer_factory);
+
+    for (size_t nf = 0; nf < BlockFrames * 2; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    packet::PacketPtr pp = queue.read();
+    CHECK(pp);
+    CHECK(pp->rtp());
+    CHECK(pp->rtp()->source != ForeignSource);
+
+    control_endpoint->inbound_writer()->write(new_receiver_report(ForeignSource));
+
+    for (size_t nf = 0; nf < BlockFrames * 2; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    UNSIGNED_LONGS_EQUAL(SourcePackets + RepairPackets, last_block_length(queue));
+
+    control_endpoint->inbound_writer()->write(new_receiver_report(pp->rtp()->source));
+
+    for (size_t nf = 0; nf < BlockFrames * 2; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    UNSIGNED_LONGS_EQUAL(SourcePackets + RepairPackets - 1, last_block_length(queue));
+}
+
 } // namespace pipeline
 } // namespace roc
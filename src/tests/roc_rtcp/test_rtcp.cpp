@@ -12,10 +12,14 @@
 #include "roc_core/heap_allocator.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_core/stddefs.h"
+#include "roc_packet/ntp.h"
 #include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
 
 #include "roc_rtcp/builder.h"
 #include "roc_rtcp/bye_traverser.h"
+#include "roc_rtcp/composer.h"
+#include "roc_rtcp/session.h"
 #include "roc_rtcp/traverser.h"
 
 namespace roc {
@@ -37,6 +41,80 @@ core::Slice<uint8_t> new_buffer(const uint8_t* data, size_t datasz) {
     return buf;
 }
 
+class TestReceiverHooks : public IReceiverHooks {
+public:
+    TestReceiverHooks()
+        : n_sending_metrics(0) {
+    }
+
+    virtual void on_update_source(packet::source_t, const char*) {
+    }
+
+    virtual void on_remove_source(packet::source_t) {
+    }
+
+    virtual size_t on_get_num_sources() {
+        return 1;
+    }
+
+    virtual ReceptionMetrics on_get_reception_metrics(size_t source_index) {
+        CHECK(source_index == 0);
+        return reception_metrics;
+    }
+
+    virtual void on_add_sending_metrics(const SendingMetrics& metrics) {
+        sending_metrics = metrics;
+        n_sending_metrics++;
+    }
+
+    virtual void on_add_link_metrics(const LinkMetrics&) {
+    }
+
+    ReceptionMetrics reception_metrics;
+
+    SendingMetrics sending_metrics;
+    size_t n_sending_metrics;
+};
+
+class TestSenderHooks : public ISenderHooks {
+public:
+    TestSenderHooks()
+        : n_reception_metrics(0)
+        , n_link_metrics(0) {
+    }
+
+    virtual size_t on_get_num_sources() {
+        return 0;
+    }
+
+    virtual packet::source_t on_get_sending_source(size_t) {
+        FAIL("unexpected call");
+        return 0;
+    }
+
+    virtual SendingMetrics on_get_sending_metrics(packet::ntp_timestamp_t report_time) {
+        SendingMetrics metrics;
+        metrics.origin_ntp = report_time;
+        return metrics;
+    }
+
+    virtual void on_add_reception_metrics(const ReceptionMetrics& metrics) {
+        reception_metrics = metrics;
+        n_reception_metrics++;
+    }
+
+    virtual void on_add_link_metrics(const LinkMetrics& metrics) {
+        link_metrics = metrics;
+        n_link_metrics++;
+    }
+
+    ReceptionMetrics reception_metrics;
+    size_t n_reception_metrics;
+
+    LinkMetrics link_metrics;
+    size_t n_link_metrics;
+};
+
 } // namespace
 
 TEST_GROUP(rtcp) {};
@@ -440,6 +518,223 @@ TEST(rtcp, loopback_bye) {
     CHECK_EQUAL(Traverser::Iterator::END, it.next());
 }
 
+TEST(rtcp, report_block_losses) {
+    header::ReceptionReportBlock blk;
+
+    blk.set_fract_loss(1, 4);
+    DOUBLES_EQUAL(0.25, blk.fract_loss(), 1e-6);
+
+    blk.set_fract_loss(5, 5);
+    DOUBLES_EQUAL(255. / 256., blk.fract_loss(), 1e-6);
+
+    // cumulative loss is 24-bit signed and doesn't overlap fraction lost
+    blk.set_fract_loss(1, 2);
+
+    blk.set_cumloss(100000);
+    CHECK_EQUAL(100000, blk.cumloss());
+    DOUBLES_EQUAL(0.5, blk.fract_loss(), 1e-6);
+
+    blk.set_cumloss(-5);
+    CHECK_EQUAL(-5, blk.cumloss());
+    DOUBLES_EQUAL(0.5, blk.fract_loss(), 1e-6);
+
+    blk.set_cumloss(0x7FFFFFFF);
+    CHECK_EQUAL(0x7FFFFF, blk.cumloss());
+
+    blk.set_cumloss(-0x7FFFFFFF);
+    CHECK_EQUAL(-0x800000, blk.cumloss());
+    DOUBLES_EQUAL(0.5, blk.fract_loss(), 1e-6);
+}
+
+TEST(rtcp, loopback_rr_xr_loss_rle) {
+    core::Slice<uint8_t> buff = new_buffer(NULL, 0).subslice(0, 0);
+    Builder builder(buff);
+
+    header::ReceiverReportPacket rr;
+    rr.set_ssrc(1);
+
+    header::XrPacket xr;
+    xr.set_ssrc(1);
+
+    header::XrRrtrBlock ref_time;
+    ref_time.set_ntp_timestamp(123);
+
+    // odd number of chunks, padded with null chunk
+    header::XrLossRleBlock loss_rle_1;
+    loss_rle_1.set_ssrc(222);
+    loss_rle_1.set_begin_seqnum(65530);
+    loss_rle_1.set_end_seqnum(12);
+
+    header::XrLossRleChunk chunks_1[3];
+    chunks_1[0].set_run(true, 5);
+    chunks_1[1].set_run(false, 3);
+    chunks_1[2].set_run(true, 10);
+
+    // even number of chunks, including bit vector
+    header::XrLossRleBlock loss_rle_2;
+    loss_rle_2.set_ssrc(333);
+    loss_rle_2.set_begin_seqnum(100);
+    loss_rle_2.set_end_seqnum(100 + 15 + 0x3FFF);
+
+    header::XrLossRleChunk chunks_2[2];
+    chunks_2[0].set_bit_vector(0x7F0F);
+    chunks_2[1].set_run(false, 0x3FFF);
+
+    builder.begin_rr(rr);
+    builder.end_rr();
+
+    builder.begin_xr(xr);
+    builder.add_xr_rrtr(ref_time);
+    builder.begin_xr_loss_rle(loss_rle_1);
+    for (size_t n = 0; n < 3; n++) {
+        builder.add_xr_loss_rle_chunk(chunks_1[n]);
+    }
+    builder.end_xr_loss_rle();
+    builder.begin_xr_loss_rle(loss_rle_2);
+    for (size_t n = 0; n < 2; n++) {
+        builder.add_xr_loss_rle_chunk(chunks_2[n]);
+    }
+    builder.end_xr_loss_rle();
+    builder.end_xr();
+
+    CHECK(buff.size() % 4 == 0);
+
+    Traverser parser(buff);
+    CHECK(parser.parse());
+
+    Traverser::Iterator it = parser.iter();
+    CHECK_EQUAL(Traverser::Iterator::RR, it.next());
+    CHECK_EQUAL(Traverser::Iterator::XR, it.next());
+
+    XrTraverser xr_tr = it.get_xr();
+    CHECK(xr_tr.parse());
+    UNSIGNED_LONGS_EQUAL(3, xr_tr.blocks_count());
+
+    XrTraverser::Iterator xr_it = xr_tr.iter();
+    CHECK_EQUAL(XrTraverser::Iterator::RRTR_BLOCK, xr_it.next());
+    CHECK_EQUAL(XrTraverser::Iterator::LOSS_RLE_BLOCK, xr_it.next());
+
+    {
+        const header::XrLossRleBlock& blk = xr_it.get_loss_rle();
+        UNSIGNED_LONGS_EQUAL(222, blk.ssrc());
+        UNSIGNED_LONGS_EQUAL(65530, blk.begin_seqnum());
+        UNSIGNED_LONGS_EQUAL(12, blk.end_seqnum());
+        UNSIGNED_LONGS_EQUAL(4, blk.num_chunks());
+
+        for (size_t n = 0; n < 3; n++) {
+            CHECK(!blk.get_chunk(n).is_null());
+            CHECK(!blk.get_chunk(n).is_bit_vector());
+            CHECK_EQUAL(chunks_1[n].run_received(), blk.get_chunk(n).run_received());
+            UNSIGNED_LONGS_EQUAL(chunks_1[n].run_length(), blk.get_chunk(n).run_length());
+        }
+        CHECK(blk.get_chunk(3).is_null());
+    }
+
+    CHECK_EQUAL(XrTraverser::Iterator::LOSS_RLE_BLOCK, xr_it.next());
+
+    {
+        const header::XrLossRleBlock& blk = xr_it.get_loss_rle();
+        UNSIGNED_LONGS_EQUAL(333, blk.ssrc());
+        UNSIGNED_LONGS_EQUAL(2, blk.num_chunks());
+
+        CHECK(blk.get_chunk(0).is_bit_vector());
+        UNSIGNED_LONGS_EQUAL(0x7F0F, blk.get_chunk(0).bit_vector());
+
+        CHECK(!blk.get_chunk(1).is_bit_vector());
+        CHECK(!blk.get_chunk(1).run_received());
+        UNSIGNED_LONGS_EQUAL(0x3FFF, blk.get_chunk(1).run_length());
+    }
+
+    CHECK_EQUAL(XrTraverser::Iterator::END, xr_it.next());
+    CHECK_EQUAL(Traverser::Iterator::END, it.next());
+}
+
+TEST(rtcp, session_reception_report) {
+    Composer composer;
+    packet::Queue queue;
+
+    TestReceiverHooks recv_hooks;
+    TestSenderHooks send_hooks;
+
+    Session recv_session(&recv_hooks, NULL, &queue, composer, packet_factory,
+                         buffer_factory);
+    Session send_session(NULL, &send_hooks, &queue, composer, packet_factory,
+                         buffer_factory);
+
+    CHECK(recv_session.valid());
+    CHECK(send_session.valid());
+
+    // sender report
+    send_session.generate_packets();
+
+    packet::PacketPtr sr = queue.read();
+    CHECK(sr);
+    recv_session.process_packet(sr);
+
+    UNSIGNED_LONGS_EQUAL(1, recv_hooks.n_sending_metrics);
+    CHECK(recv_hooks.sending_metrics.origin_ntp != 0);
+
+    {
+        Traverser traverser(sr->data());
+        CHECK(traverser.parse());
+
+        Traverser::Iterator iter = traverser.iter();
+        CHECK_EQUAL(Traverser::Iterator::SR, iter.next());
+
+        UNSIGNED_LONGS_EQUAL(iter.get_sr().ssrc(), recv_hooks.sending_metrics.ssrc);
+    }
+
+    // receiver report, as if sender report was received 50ms ago
+    // and receiver held it for 20ms
+    ReceptionMetrics& metrics = recv_hooks.reception_metrics;
+    metrics.ssrc = 123;
+    metrics.fract_loss = 0.25f;
+    metrics.cum_loss = -5;
+    metrics.ext_last_seqnum = 0x10005;
+    metrics.jitter = 777;
+    metrics.last_sr =
+        packet::ntp_timestamp() - packet::nanoseconds_2_ntp(50 * core::Millisecond);
+    metrics.delay_last_sr = packet::nanoseconds_2_ntp(20 * core::Millisecond);
+
+    recv_session.generate_packets();
+
+    packet::PacketPtr rr = queue.read();
+    CHECK(rr);
+    send_session.process_packet(rr);
+
+    UNSIGNED_LONGS_EQUAL(1, send_hooks.n_reception_metrics);
+
+    const ReceptionMetrics& parsed = send_hooks.reception_metrics;
+    UNSIGNED_LONGS_EQUAL(123, parsed.ssrc);
+    DOUBLES_EQUAL(0.25, parsed.fract_loss, 1e-6);
+    LONGS_EQUAL(-5, parsed.cum_loss);
+    UNSIGNED_LONGS_EQUAL(0x10005, parsed.ext_last_seqnum);
+    UNSIGNED_LONGS_EQUAL(777, parsed.jitter);
+
+    // LSR and DLSR keep only middle 32 bits of NTP timestamp
+    UNSIGNED_LONGS_EQUAL(uint32_t(metrics.last_sr >> 16), parsed.last_sr >> 16);
+    UNSIGNED_LONGS_EQUAL(uint32_t(metrics.delay_last_sr >> 16),
+                         parsed.delay_last_sr >> 16);
+
+    UNSIGNED_LONGS_EQUAL(1, send_hooks.n_link_metrics);
+    UNSIGNED_LONGS_EQUAL(123, send_hooks.link_metrics.ssrc);
+    CHECK(send_hooks.link_metrics.rtt >= 30 * core::Millisecond - core::Millisecond);
+    CHECK(send_hooks.link_metrics.rtt < 30 * core::Millisecond + 100 * core::Millisecond);
+
+    // no sender report, no round-trip time
+    metrics.last_sr = 0;
+    metrics.delay_last_sr = 0;
+
+    recv_session.generate_packets();
+
+    rr = queue.read();
+    CHECK(rr);
+    send_session.process_packet(rr);
+
+    UNSIGNED_LONGS_EQUAL(2, send_hooks.n_reception_metrics);
+    UNSIGNED_LONGS_EQUAL(1, send_hooks.n_link_metrics);
+}
+
 // Check unknown xr blocks.
 // Check unknown rtcp packet type.
 
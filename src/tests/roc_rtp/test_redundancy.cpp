@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
+#include "roc_rtp/parser.h"
+#include "roc_rtp/redundancy_composer.h"
+#include "roc_rtp/redundancy_parser.h"
+#include "roc_rtp/redundancy_reader.h"
+
+namespace roc {
+namespace rtp {
+
+namespace {
+
+const PayloadType Pt = PayloadType_L16_Stereo;
+
+enum {
+    Src = 55,
+    SamplesPerPacket = 10,
+    PayloadSize = SamplesPerPacket * 2 * 2,
+    RtpHeaderSize = sizeof(Header),
+    BlockSize = sizeof(RedundantHeader) + PayloadSize,
+    MaxBufSize = 500
+};
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, MaxBufSize, true);
+packet::PacketFactory packet_factory(allocator, true);
+
+FormatMap format_map;
+
+uint8_t payload_byte(packet::seqnum_t sn, size_t n) {
+    return uint8_t(sn * 7 + n);
+}
+
+packet::PacketPtr compose_packet(packet::IComposer& composer,
+                                 core::BufferFactory<uint8_t>& factory,
+                                 packet::seqnum_t sn) {
+    packet::PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+
+    pp->add_flags(packet::Packet::FlagAudio);
+
+    core::Slice<uint8_t> buffer = factory.new_buffer();
+    CHECK(buffer);
+
+    CHECK(composer.prepare(*pp, buffer, PayloadSize));
+    pp->set_data(buffer);
+
+    packet::RTP& rtp = *pp->rtp();
+
+    rtp.source = Src;
+    rtp.seqnum = sn;
+    rtp.timestamp = packet::timestamp_t(sn * SamplesPerPacket);
+    rtp.duration = SamplesPerPacket;
+    rtp.payload_type = Pt;
+
+    LONGS_EQUAL(PayloadSize, rtp.payload.size());
+
+    for (size_t n = 0; n < PayloadSize; n++) {
+        rtp.payload.data()[n] = payload_byte(sn, n);
+    }
+
+    CHECK(composer.compose(*pp));
+
+    return pp;
+}
+
+packet::PacketPtr parse_packet(packet::IParser& parser, const packet::PacketPtr& sent) {
+    packet::PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+
+    CHECK(parser.parse(*pp, sent->data()));
+    pp->set_data(sent->data());
+
+    return pp;
+}
+
+void check_payload(const packet::PacketPtr& pp, packet::seqnum_t sn) {
+    const packet::RTP* rtp = pp->rtp();
+    CHECK(rtp);
+
+    LONGS_EQUAL(Src, rtp->source);
+    LONGS_EQUAL(sn, rtp->seqnum);
+    LONGS_EQUAL(sn * SamplesPerPacket, rtp->timestamp);
+    LONGS_EQUAL(Pt, rtp->payload_type);
+
+    LONGS_EQUAL(PayloadSize, rtp->payload.size());
+
+    for (size_t n = 0; n < PayloadSize; n++) {
+        LONGS_EQUAL(payload_byte(sn, n), rtp->payload.data()[n]);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(redundancy) {};
+
+TEST(redundancy, compose_parse) {
+    enum { Depth = 2, NumPackets = 5 };
+
+    Composer composer(NULL);
+    RedundancyComposer redundancy_composer(composer, Depth);
+
+    Parser parser(format_map, NULL);
+    RedundancyParser redundancy_parser(format_map, parser);
+
+    for (packet::seqnum_t sn = 0; sn < NumPackets; sn++) {
+        packet::PacketPtr sent = compose_packet(redundancy_composer, buffer_factory, sn);
+
+        const size_t n_blocks = std::min((size_t)sn, (size_t)Depth);
+
+        LONGS_EQUAL(RtpHeaderSize + n_blocks * BlockSize + sizeof(PrimaryHeader)
+                        + PayloadSize,
+                    sent->data().size());
+
+        const Header& header = *(const Header*)sent->data().data();
+        LONGS_EQUAL(PayloadType_Redundant, header.payload_type());
+
+        packet::PacketPtr received = parse_packet(redundancy_parser, sent);
+
+        CHECK(received->flags() & packet::Packet::FlagAudio);
+        check_payload(received, sn);
+
+        const packet::RTP& rtp = *received->rtp();
+
+        LONGS_EQUAL(n_blocks * BlockSize + sizeof(PrimaryHeader), rtp.redundancy_size);
+
+        const uint8_t* redundancy = rtp.payload.data() - rtp.redundancy_size;
+
+        const RedundantHeader* headers = (const RedundantHeader*)redundancy;
+        const uint8_t* blocks =
+            redundancy + n_blocks * sizeof(RedundantHeader) + sizeof(PrimaryHeader);
+
+        for (size_t n = 0; n < n_blocks; n++) {
+            const packet::seqnum_t block_sn = packet::seqnum_t(sn - n_blocks + n);
+
+            CHECK(headers[n].follow());
+            LONGS_EQUAL(Pt, headers[n].payload_type());
+            LONGS_EQUAL((n_blocks - n) * SamplesPerPacket, headers[n].timestamp_offset());
+            LONGS_EQUAL(PayloadSize, headers[n].block_length());
+
+            for (size_t i = 0; i < PayloadSize; i++) {
+                LONGS_EQUAL(payload_byte(block_sn, i), blocks[n * PayloadSize + i]);
+            }
+        }
+
+        const PrimaryHeader& primary = *(const PrimaryHeader*)&headers[n_blocks];
+        CHECK(!primary.follow());
+        LONGS_EQUAL(Pt, primary.payload_type());
+    }
+}
+
+TEST(redundancy, small_buffer) {
+    enum { Depth = 3 };
+
+    // room for only one redundant block
+    core::BufferFactory<uint8_t> small_buffer_factory(
+        allocator, RtpHeaderSize + BlockSize + sizeof(PrimaryHeader) + PayloadSize, true);
+
+    Composer composer(NULL);
+    RedundancyComposer redundancy_composer(composer, Depth);
+
+    Parser parser(format_map, NULL);
+    RedundancyParser redundancy_parser(format_map, parser);
+
+    for (packet::seqnum_t sn = 0; sn < Depth + 2; sn++) {
+        packet::PacketPtr sent =
+            compose_packet(redundancy_composer, small_buffer_factory, sn);
+
+        packet::PacketPtr received = parse_packet(redundancy_parser, sent);
+        check_payload(received, sn);
+
+        const size_t n_blocks = sn == 0 ? 0 : 1;
+
+        LONGS_EQUAL(n_blocks * BlockSize + sizeof(PrimaryHeader),
+                    received->rtp()->redundancy_size);
+    }
+}
+
+TEST(redundancy, parse_non_redundant) {
+    Composer composer(NULL);
+
+    Parser parser(format_map, NULL);
+    RedundancyParser redundancy_parser(format_map, parser);
+
+    packet::PacketPtr sent = compose_packet(composer, buffer_factory, 10);
+    packet::PacketPtr received = parse_packet(redundancy_parser, sent);
+
+    check_payload(received, 10);
+    LONGS_EQUAL(0, received->rtp()->redundancy_size);
+}
+
+TEST(redundancy, parse_truncated) {
+    enum { Depth = 1 };
+
+    Composer composer(NULL);
+    RedundancyComposer redundancy_composer(composer, Depth);
+
+    Parser parser(format_map, NULL);
+    RedundancyParser redundancy_parser(format_map, parser);
+
+    compose_packet(redundancy_composer, buffer_factory, 0);
+
+    packet::PacketPtr sent = compose_packet(redundancy_composer, buffer_factory, 1);
+
+    // block length exceeds payload
+    {
+        RedundantHeader& header =
+            *(RedundantHeader*)(sent->data().data() + RtpHeaderSize);
+        header.set_block_length(PayloadSize * 2 + 1);
+
+        packet::PacketPtr pp = packet_factory.new_packet();
+        CHECK(pp);
+        CHECK(!redundancy_parser.parse(*pp, sent->data()));
+
+        header.set_block_length(PayloadSize);
+    }
+
+    // no primary header
+    {
+        core::Slice<uint8_t> buffer =
+            sent->data().subslice(0, RtpHeaderSize + sizeof(RedundantHeader));
+
+        packet::PacketPtr pp = packet_factory.new_packet();
+        CHECK(pp);
+        CHECK(!redundancy_parser.parse(*pp, buffer));
+    }
+
+    // valid packet
+    {
+        packet::PacketPtr pp = packet_factory.new_packet();
+        CHECK(pp);
+        CHECK(redundancy_parser.parse(*pp, sent->data()));
+    }
+}
+
+TEST(redundancy, restore_losses) {
+    enum { Depth = 2, NumPackets = 14 };
+
+    Composer composer(NULL);
+    RedundancyComposer redundancy_composer(composer, Depth);
+
+    Parser parser(format_map, NULL);
+    RedundancyParser redundancy_parser(format_map, parser);
+
+    const Format* format = format_map.format(Pt);
+    CHECK(format);
+
+    core::ScopedPtr<audio::IFrameDecoder> decoder(format->new_decoder(allocator),
+                                                  allocator);
+    CHECK(decoder);
+
+    packet::Queue queue;
+    RedundancyReader reader(queue, *decoder, packet_factory);
+
+    // 2 is restored from 3, 5 and 6 from 7, 10 and 11 from 12,
+    // and 9 is lost because it is too far from 12
+    const bool lost[NumPackets] = {
+        false, false, true, false, false, true, true,
+        false, false, true, true,  true,  false, false,
+    };
+
+    for (packet::seqnum_t sn = 0; sn < NumPackets; sn++) {
+        packet::PacketPtr sent = compose_packet(redundancy_composer, buffer_factory, sn);
+
+        if (!lost[sn]) {
+            queue.write(parse_packet(redundancy_parser, sent));
+        }
+    }
+
+    for (packet::seqnum_t sn = 0; sn < NumPackets; sn++) {
+        if (sn == 9) {
+            continue;
+        }
+
+        packet::PacketPtr pp = reader.read();
+        CHECK(pp);
+
+        check_payload(pp, sn);
+
+        CHECK(pp->flags() & packet::Packet::FlagAudio);
+        LONGS_EQUAL(lost[sn], !!(pp->flags() & packet::Packet::FlagRestored));
+
+        if (lost[sn]) {
+            LONGS_EQUAL(SamplesPerPacket, pp->rtp()->duration);
+        }
+    }
+
+    CHECK(!reader.read());
+    LONGS_EQUAL(5, reader.n_restored());
+}
+
+TEST(redundancy, no_restore_without_redundancy) {
+    Composer composer(NULL);
+
+    Parser parser(format_map, NULL);
+    RedundancyParser redundancy_parser(format_map, parser);
+
+    const Format* format = format_map.format(Pt);
+    CHECK(format);
+
+    core::ScopedPtr<audio::IFrameDecoder> decoder(format->new_decoder(allocator),
+                                                  allocator);
+    CHECK(decoder);
+
+    packet::Queue queue;
+    RedundancyReader reader(queue, *decoder, packet_factory);
+
+    // packet 1 is lost
+    for (packet::seqnum_t sn = 0; sn < 4; sn += 2) {
+        packet::PacketPtr sent = compose_packet(composer, buffer_factory, sn);
+        queue.write(parse_packet(redundancy_parser, sent));
+    }
+
+    check_payload(reader.read(), 0);
+    check_payload(reader.read(), 2);
+
+    CHECK(!reader.read());
+    LONGS_EQUAL(0, reader.n_restored());
+}
+
+TEST(redundancy, pass_non_rtp) {
+    const Format* format = format_map.format(Pt);
+    CHECK(format);
+
+    core::ScopedPtr<audio::IFrameDecoder> decoder(format->new_decoder(allocator),
+                                                  allocator);
+    CHECK(decoder);
+
+    packet::Queue queue;
+    RedundancyReader reader(queue, *decoder, packet_factory);
+
+    packet::PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+
+    queue.write(pp);
+
+    CHECK(reader.read() == pp);
+    CHECK(!reader.read());
+    LONGS_EQUAL(0, reader.n_restored());
+}
+
+} // namespace rtp
+} // namespace roc
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_core/temp_file.h"
+#include "roc_sndio/mmap_format.h"
+#include "roc_sndio/mmap_sink.h"
+#include "roc_sndio/mmap_source.h"
+
+namespace roc {
+namespace sndio {
+namespace {
+
+// Measures throughput of file-to-file conversion (what roc-conv does without
+// resampling) using mmap backend. Compare with BM_File_Sox, which is built
+// when sox backend is enabled.
+
+enum {
+    SampleRate = 44100,
+    ChMask = 0x3,
+    NumChans = 2,
+    FrameSize = 441 * NumChans,
+    FileDuration = 60 // seconds
+};
+
+core::HeapAllocator allocator;
+
+Config make_config() {
+    Config config;
+    config.sample_spec = audio::SampleSpec(SampleRate, ChMask);
+    config.frame_length = config.sample_spec.samples_overall_2_ns(FrameSize);
+    return config;
+}
+
+void write_input(const char* path) {
+    MmapSink sink(allocator, make_config());
+    roc_panic_if(!sink.valid() || !sink.open(*mmap_find_format(NULL, path), path));
+
+    audio::sample_t samples[FrameSize];
+    for (size_t n = 0; n < FrameSize; n++) {
+        samples[n] = audio::sample_t(n) / FrameSize;
+    }
+
+    for (size_t n = 0; n < SampleRate * NumChans * FileDuration / FrameSize; n++) {
+        audio::Frame frame(samples, FrameSize);
+        sink.write(frame);
+    }
+}
+
+void BM_File_Mmap(benchmark::State& state) {
+    core::TempFile input_file("input.wav");
+    core::TempFile output_file("output.wav");
+
+    write_input(input_file.path());
+
+    audio::sample_t samples[FrameSize];
+    size_t n_samples = 0;
+
+    while (state.KeepRunning()) {
+        MmapSource source(allocator, make_config());
+        roc_panic_if(!source.valid()
+                     || !source.open(*mmap_find_format(NULL, input_file.path()),
+                                     input_file.path()));
+
+        MmapSink sink(allocator, make_config());
+        roc_panic_if(!sink.valid()
+                     || !sink.open(*mmap_find_format(NULL, output_file.path()),
+                                   output_file.path()));
+
+        for (;;) {
+            audio::Frame frame(samples, FrameSize);
+            if (!source.read(frame)) {
+                break;
+            }
+            sink.write(frame);
+            n_samples += FrameSize;
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(n_samples));
+}
+
+BENCHMARK(BM_File_Mmap)->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace sndio
+} // namespace roc
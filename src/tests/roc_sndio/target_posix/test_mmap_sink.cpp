@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <stdio.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/temp_file.h"
+#include "roc_sndio/mmap_format.h"
+#include "roc_sndio/mmap_sink.h"
+#include "roc_sndio/wav_header.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum { FrameSize = 500, SampleRate = 44100, ChMask = 0x3, NumChans = 2, NumFrames = 3 };
+
+const core::nanoseconds_t FrameDuration = FrameSize * core::Second
+    / core::nanoseconds_t(SampleRate * NumChans);
+
+core::HeapAllocator allocator;
+
+uint8_t file_data[1024 * 1024];
+
+size_t read_file(const char* path) {
+    FILE* fp = fopen(path, "rb");
+    CHECK(fp);
+
+    const size_t size = fread(file_data, 1, sizeof(file_data), fp);
+    fclose(fp);
+
+    return size;
+}
+
+void write_frames(MmapSink& sink, size_t n_frames) {
+    audio::sample_t samples[FrameSize * NumChans] = {};
+    for (size_t n = 0; n < FrameSize * NumChans; n++) {
+        samples[n] = audio::sample_t(n) / (FrameSize * NumChans);
+    }
+
+    for (size_t n = 0; n < n_frames; n++) {
+        audio::Frame frame(samples, FrameSize * NumChans);
+        sink.write(frame);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(mmap_sink) {
+    Config sink_config;
+
+    void setup() {
+        sink_config.sample_spec = audio::SampleSpec(SampleRate, ChMask);
+        sink_config.frame_length = FrameDuration;
+    }
+};
+
+TEST(mmap_sink, noop) {
+    MmapSink mmap_sink(allocator, sink_config);
+    CHECK(mmap_sink.valid());
+}
+
+TEST(mmap_sink, error) {
+    MmapSink mmap_sink(allocator, sink_config);
+
+    CHECK(!mmap_sink.open(*mmap_find_format("mmap_wav", NULL), "/bad/file"));
+}
+
+TEST(mmap_sink, has_clock) {
+    core::TempFile file("test.wav");
+
+    MmapSink mmap_sink(allocator, sink_config);
+
+    CHECK(mmap_sink.open(*mmap_find_format(NULL, file.path()), file.path()));
+    CHECK(!mmap_sink.has_clock());
+}
+
+TEST(mmap_sink, sample_rate) {
+    core::TempFile file("test.wav");
+
+    MmapSink mmap_sink(allocator, sink_config);
+
+    CHECK(mmap_sink.open(*mmap_find_format(NULL, file.path()), file.path()));
+    CHECK(mmap_sink.sample_spec().sample_rate() == SampleRate);
+}
+
+TEST(mmap_sink, sample_rate_required) {
+    core::TempFile file("test.wav");
+
+    sink_config.sample_spec.set_sample_rate(0);
+    MmapSink mmap_sink(allocator, sink_config);
+
+    CHECK(!mmap_sink.open(*mmap_find_format(NULL, file.path()), file.path()));
+}
+
+TEST(mmap_sink, write_wav) {
+    core::TempFile file("test.wav");
+
+    {
+        MmapSink mmap_sink(allocator, sink_config);
+        CHECK(mmap_sink.open(*mmap_find_format(NULL, file.path()), file.path()));
+
+        write_frames(mmap_sink, NumFrames);
+    }
+
+    const size_t data_size = FrameSize * NumChans * NumFrames * sizeof(int32_t);
+
+    CHECK_EQUAL(WavHeader::ComposedSize + data_size, read_file(file.path()));
+
+    WavHeader header;
+    CHECK(header.parse(file_data, WavHeader::ComposedSize + data_size));
+
+    CHECK_EQUAL(audio::PcmEncoding_SInt32, header.format().encoding);
+    CHECK_EQUAL(NumChans, header.num_channels());
+    CHECK_EQUAL(SampleRate, header.sample_rate());
+    CHECK_EQUAL(data_size, header.data_size());
+}
+
+TEST(mmap_sink, write_raw) {
+    core::TempFile file("test.raw");
+
+    {
+        MmapSink mmap_sink(allocator, sink_config);
+        CHECK(mmap_sink.open(*mmap_find_format("mmap_f32", NULL), file.path()));
+
+        write_frames(mmap_sink, NumFrames);
+    }
+
+    CHECK_EQUAL(FrameSize * NumChans * NumFrames * sizeof(float),
+                read_file(file.path()));
+
+    const float* samples = (const float*)file_data;
+
+    for (size_t n = 0; n < FrameSize * NumChans * NumFrames; n++) {
+        DOUBLES_EQUAL(double(n % (FrameSize * NumChans)) / (FrameSize * NumChans),
+                      samples[n], 0.0001);
+    }
+}
+
+TEST(mmap_sink, write_nothing) {
+    core::TempFile file("test.wav");
+
+    {
+        MmapSink mmap_sink(allocator, sink_config);
+        CHECK(mmap_sink.open(*mmap_find_format(NULL, file.path()), file.path()));
+    }
+
+    CHECK_EQUAL(WavHeader::ComposedSize, read_file(file.path()));
+
+    WavHeader header;
+    CHECK(header.parse(file_data, WavHeader::ComposedSize));
+    CHECK_EQUAL(0, header.data_size());
+}
+
+} // namespace sndio
+} // namespace roc
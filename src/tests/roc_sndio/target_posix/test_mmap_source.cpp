@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/temp_file.h"
+#include "roc_sndio/mmap_format.h"
+#include "roc_sndio/mmap_sink.h"
+#include "roc_sndio/mmap_source.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum { FrameSize = 500, SampleRate = 44100, ChMask = 0x3, NumChans = 2 };
+
+const core::nanoseconds_t FrameDuration = FrameSize * core::Second
+    / core::nanoseconds_t(SampleRate * NumChans);
+
+core::HeapAllocator allocator;
+
+audio::sample_t nth_sample(size_t n) {
+    return audio::sample_t(uint8_t(n)) / audio::sample_t(1 << 8);
+}
+
+void write_file(const Config& config,
+                const char* driver,
+                const char* path,
+                size_t n_samples) {
+    MmapSink mmap_sink(allocator, config);
+    CHECK(mmap_sink.open(*mmap_find_format(driver, path), path));
+
+    audio::sample_t samples[FrameSize * NumChans];
+    size_t pos = 0;
+
+    while (pos < n_samples) {
+        size_t frame_size = n_samples - pos;
+        if (frame_size > FrameSize * NumChans) {
+            frame_size = FrameSize * NumChans;
+        }
+
+        for (size_t n = 0; n < frame_size; n++) {
+            samples[n] = nth_sample(pos + n);
+        }
+
+        audio::Frame frame(samples, frame_size);
+        mmap_sink.write(frame);
+
+        pos += frame_size;
+    }
+}
+
+} // namespace
+
+TEST_GROUP(mmap_source) {
+    Config sink_config;
+    Config source_config;
+
+    void setup() {
+        sink_config.sample_spec = audio::SampleSpec(SampleRate, ChMask);
+        sink_config.frame_length = FrameDuration;
+
+        source_config.sample_spec = audio::SampleSpec(SampleRate, ChMask);
+        source_config.frame_length = FrameDuration;
+    }
+};
+
+TEST(mmap_source, noop) {
+    MmapSource mmap_source(allocator, source_config);
+    CHECK(mmap_source.valid());
+}
+
+TEST(mmap_source, error) {
+    MmapSource mmap_source(allocator, source_config);
+
+    CHECK(!mmap_source.open(*mmap_find_format("mmap_wav", NULL), "/bad/file"));
+}
+
+TEST(mmap_source, has_clock) {
+    core::TempFile file("test.wav");
+
+    write_file(sink_config, NULL, file.path(), FrameSize * NumChans);
+
+    MmapSource mmap_source(allocator, source_config);
+
+    CHECK(mmap_source.open(*mmap_find_format(NULL, file.path()), file.path()));
+    CHECK(!mmap_source.has_clock());
+}
+
+TEST(mmap_source, sample_rate_auto) {
+    core::TempFile file("test.wav");
+
+    write_file(sink_config, NULL, file.path(), FrameSize * NumChans);
+
+    source_config.sample_spec.set_sample_rate(0);
+    MmapSource mmap_source(allocator, source_config);
+
+    CHECK(mmap_source.open(*mmap_find_format(NULL, file.path()), file.path()));
+    CHECK(mmap_source.sample_spec().sample_rate() == SampleRate);
+}
+
+TEST(mmap_source, sample_rate_mismatch) {
+    core::TempFile file("test.wav");
+
+    write_file(sink_config, NULL, file.path(), FrameSize * NumChans);
+
+    source_config.sample_spec.set_sample_rate(SampleRate * 2);
+    MmapSource mmap_source(allocator, source_config);
+
+    // rate from header wins
+    CHECK(mmap_source.open(*mmap_find_format(NULL, file.path()), file.path()));
+    CHECK(mmap_source.sample_spec().sample_rate() == SampleRate);
+}
+
+TEST(mmap_source, channels_mismatch) {
+    core::TempFile file("test.wav");
+
+    write_file(sink_config, NULL, file.path(), FrameSize * NumChans);
+
+    source_config.sample_spec.set_channel_mask(0x1);
+    MmapSource mmap_source(allocator, source_config);
+
+    CHECK(!mmap_source.open(*mmap_find_format(NULL, file.path()), file.path()));
+}
+
+TEST(mmap_source, raw_sample_rate_required) {
+    core::TempFile file("test.raw");
+
+    write_file(sink_config, "mmap_s16", file.path(), FrameSize * NumChans);
+
+    source_config.sample_spec.set_sample_rate(0);
+    MmapSource mmap_source(allocator, source_config);
+
+    CHECK(!mmap_source.open(*mmap_find_format("mmap_s16", NULL), file.path()));
+}
+
+TEST(mmap_source, read) {
+    const char* drivers[] = { "mmap_wav", "mmap_f32", "mmap_s16", "mmap_s32" };
+
+    for (size_t n_drv = 0; n_drv < ROC_ARRAY_SIZE(drivers); n_drv++) {
+        core::TempFile file("test.pcm");
+
+        // one full frame and one partial frame
+        write_file(sink_config, drivers[n_drv], file.path(), FrameSize * NumChans * 3 / 2);
+
+        MmapSource mmap_source(allocator, source_config);
+        CHECK(mmap_source.open(*mmap_find_format(drivers[n_drv], NULL), file.path()));
+
+        audio::sample_t frame_data[FrameSize * NumChans];
+        size_t pos = 0;
+
+        for (size_t n_frame = 0; n_frame < 2; n_frame++) {
+            audio::Frame frame(frame_data, FrameSize * NumChans);
+            CHECK(mmap_source.read(frame));
+
+            for (size_t n = 0; n < FrameSize * NumChans; n++) {
+                const audio::sample_t expected =
+                    pos < FrameSize * NumChans * 3 / 2 ? nth_sample(pos) : 0;
+                DOUBLES_EQUAL(expected, frame_data[n], 0.0001);
+                pos++;
+            }
+        }
+
+        audio::Frame frame(frame_data, FrameSize * NumChans);
+        CHECK(!mmap_source.read(frame));
+    }
+}
+
+TEST(mmap_source, pause_resume) {
+    core::TempFile file("test.wav");
+
+    write_file(sink_config, NULL, file.path(), FrameSize * NumChans * 2);
+
+    MmapSource mmap_source(allocator, source_config);
+
+    CHECK(mmap_source.open(*mmap_find_format(NULL, file.path()), file.path()));
+
+    audio::sample_t frame_data1[FrameSize * NumChans] = {};
+    audio::Frame frame1(frame_data1, FrameSize * NumChans);
+
+    CHECK(mmap_source.state() == DeviceState_Active);
+    CHECK(mmap_source.read(frame1));
+
+    mmap_source.pause();
+    CHECK(mmap_source.state() == DeviceState_Paused);
+
+    audio::sample_t frame_data2[FrameSize * NumChans] = {};
+    audio::Frame frame2(frame_data2, FrameSize * NumChans);
+
+    CHECK(!mmap_source.read(frame2));
+
+    CHECK(mmap_source.resume());
+    CHECK(mmap_source.state() == DeviceState_Active);
+
+    CHECK(mmap_source.read(frame2));
+
+    if (memcmp(frame_data1, frame_data2, sizeof(frame_data1)) == 0) {
+        FAIL("frames should not be equal");
+    }
+}
+
+TEST(mmap_source, pause_restart) {
+    core::TempFile file("test.wav");
+
+    write_file(sink_config, NULL, file.path(), FrameSize * NumChans * 2);
+
+    MmapSource mmap_source(allocator, source_config);
+
+    CHECK(mmap_source.open(*mmap_find_format(NULL, file.path()), file.path()));
+
+    audio::sample_t frame_data1[FrameSize * NumChans] = {};
+    audio::Frame frame1(frame_data1, FrameSize * NumChans);
+
+    CHECK(mmap_source.state() == DeviceState_Active);
+    CHECK(mmap_source.read(frame1));
+
+    mmap_source.pause();
+    CHECK(mmap_source.state() == DeviceState_Paused);
+
+    audio::sample_t frame_data2[FrameSize * NumChans] = {};
+    audio::Frame frame2(frame_data2, FrameSize * NumChans);
+
+    CHECK(!mmap_source.read(frame2));
+
+    CHECK(mmap_source.restart());
+    CHECK(mmap_source.state() == DeviceState_Active);
+
+    CHECK(mmap_source.read(frame2));
+
+    if (memcmp(frame_data1, frame_data2, sizeof(frame_data1)) != 0) {
+        FAIL("frames should be equal");
+    }
+}
+
+TEST(mmap_source, eof_restart) {
+    core::TempFile file("test.wav");
+
+    write_file(sink_config, NULL, file.path(), FrameSize * NumChans * 2);
+
+    MmapSource mmap_source(allocator, source_config);
+
+    CHECK(mmap_source.open(*mmap_find_format(NULL, file.path()), file.path()));
+
+    audio::sample_t frame_data[FrameSize * NumChans] = {};
+    audio::Frame frame(frame_data, FrameSize * NumChans);
+
+    for (int i = 0; i < 3; i++) {
+        CHECK(mmap_source.read(frame));
+        CHECK(mmap_source.read(frame));
+        CHECK(!mmap_source.read(frame));
+
+        CHECK(mmap_source.restart());
+    }
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_core/temp_file.h"
+#include "roc_sndio/sox_sink.h"
+#include "roc_sndio/sox_source.h"
+
+namespace roc {
+namespace sndio {
+namespace {
+
+// Measures throughput of file-to-file conversion (what roc-conv does without
+// resampling) using sox backend. Compare with BM_File_Mmap, which is built
+// on posix targets.
+
+enum {
+    SampleRate = 44100,
+    ChMask = 0x3,
+    NumChans = 2,
+    FrameSize = 441 * NumChans,
+    FileDuration = 60 // seconds
+};
+
+core::HeapAllocator allocator;
+
+Config make_config() {
+    Config config;
+    config.sample_spec = audio::SampleSpec(SampleRate, ChMask);
+    config.frame_length = config.sample_spec.samples_overall_2_ns(FrameSize);
+    return config;
+}
+
+void write_input(const char* path) {
+    SoxSink sink(allocator, make_config());
+    roc_panic_if(!sink.valid() || !sink.open(NULL, path));
+
+    audio::sample_t samples[FrameSize];
+    for (size_t n = 0; n < FrameSize; n++) {
+        samples[n] = audio::sample_t(n) / FrameSize;
+    }
+
+    for (size_t n = 0; n < SampleRate * NumChans * FileDuration / FrameSize; n++) {
+        audio::Frame frame(samples, FrameSize);
+        sink.write(frame);
+    }
+}
+
+void BM_File_Sox(benchmark::State& state) {
+    core::TempFile input_file("input.wav");
+    core::TempFile output_file("output.wav");
+
+    write_input(input_file.path());
+
+    audio::sample_t samples[FrameSize];
+    size_t n_samples = 0;
+
+    while (state.KeepRunning()) {
+        SoxSource source(allocator, make_config());
+        roc_panic_if(!source.valid() || !source.open(NULL, input_file.path()));
+
+        SoxSink sink(allocator, make_config());
+        roc_panic_if(!sink.valid() || !sink.open(NULL, output_file.path()));
+
+        for (;;) {
+            audio::Frame frame(samples, FrameSize);
+            if (!source.read(frame)) {
+                break;
+            }
+            sink.write(frame);
+            n_samples += FrameSize;
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(n_samples));
+}
+
+BENCHMARK(BM_File_Sox)->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace sndio
+} // namespace roc
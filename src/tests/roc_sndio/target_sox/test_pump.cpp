@@ -13,8 +13,11 @@
 
 #include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_core/semaphore.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/temp_file.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
 #include "roc_sndio/pump.h"
 #include "roc_sndio/sox_sink.h"
 #include "roc_sndio/sox_source.h"
@@ -34,6 +37,80 @@ const core::nanoseconds_t BufDuration = BufSize * core::Second
 core::HeapAllocator allocator;
 core::BufferFactory<audio::sample_t> buffer_factory(allocator, BufSize, true);
 
+// Source that notifies when given number of frames was read.
+class NotifyingSource : public test::MockSource {
+public:
+    explicit NotifyingSource(size_t notify_frames)
+        : notify_frames_(notify_frames)
+        , n_frames_(0)
+        , tid_(0) {
+    }
+
+    virtual bool read(audio::Frame& frame) {
+        tid_ = core::Thread::get_tid();
+
+        if (!test::MockSource::read(frame)) {
+            return false;
+        }
+
+        if (++n_frames_ == notify_frames_) {
+            sem_.post();
+        }
+
+        return true;
+    }
+
+    bool wait_notified() {
+        return sem_.timed_wait(core::timestamp(core::ClockUnix) + core::Second * 10);
+    }
+
+    uint64_t tid() const {
+        return tid_;
+    }
+
+private:
+    const size_t notify_frames_;
+    size_t n_frames_;
+    uint64_t tid_;
+    core::Semaphore sem_;
+};
+
+// Sink that blocks on first write until source is notified.
+class BlockingSink : public test::MockSink {
+public:
+    explicit BlockingSink(NotifyingSource& source)
+        : source_(source)
+        , first_write_(true)
+        , notified_(false)
+        , tid_(0) {
+    }
+
+    virtual void write(audio::Frame& frame) {
+        tid_ = core::Thread::get_tid();
+
+        if (first_write_) {
+            first_write_ = false;
+            notified_ = source_.wait_notified();
+        }
+
+        test::MockSink::write(frame);
+    }
+
+    bool notified() const {
+        return notified_;
+    }
+
+    uint64_t tid() const {
+        return tid_;
+    }
+
+private:
+    NotifyingSource& source_;
+    bool first_write_;
+    bool notified_;
+    uint64_t tid_;
+};
+
 } // namespace
 
 TEST_GROUP(pump) {
@@ -127,5 +204,47 @@ TEST(pump, write_overwrite_read) {
     mock_writer.check(num_returned1, num_returned2);
 }
 
+TEST(pump, decoupled) {
+    enum { NumSamples = BufSize * 100, NumBufs = 4 };
+
+    test::MockSource mock_source;
+    mock_source.add(NumSamples);
+
+    test::MockSink mock_writer;
+
+    Pump pump(buffer_factory, mock_source, NULL, mock_writer, BufDuration, SampleSpecs,
+              Pump::ModeOneshot, BufDuration * NumBufs);
+    CHECK(pump.valid());
+    CHECK(pump.run());
+
+    mock_writer.check(0, NumSamples);
+
+    // neither source nor sink has clock
+    UNSIGNED_LONGS_EQUAL(0, pump.num_underruns());
+    UNSIGNED_LONGS_EQUAL(0, pump.num_overruns());
+}
+
+TEST(pump, decoupled_slow_sink) {
+    enum { NumSamples = BufSize * 100, NumBufs = 4 };
+
+    // source should be able to fill whole ring while sink is still
+    // blocked in its first write; in synchronous mode this would
+    // time out because sink is written before next read
+    NotifyingSource notifying_source(NumBufs);
+    notifying_source.add(NumSamples);
+
+    BlockingSink blocking_sink(notifying_source);
+
+    Pump pump(buffer_factory, notifying_source, NULL, blocking_sink, BufDuration,
+              SampleSpecs, Pump::ModeOneshot, BufDuration * NumBufs);
+    CHECK(pump.valid());
+    CHECK(pump.run());
+
+    CHECK(blocking_sink.notified());
+    CHECK(notifying_source.tid() != blocking_sink.tid());
+
+    blocking_sink.check(0, NumSamples);
+}
+
 } // namespace sndio
 } // namespace roc
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/macro_helpers.h"
+#include "roc_core/stddefs.h"
+#include "roc_sndio/wav_header.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum { SampleRate = 44100, NumChans = 2, DataSize = 400 };
+
+uint8_t file_data[WavHeader::ComposedSize + DataSize];
+
+} // namespace
+
+TEST_GROUP(wav_header) {};
+
+TEST(wav_header, compose_parse) {
+    const audio::PcmEncoding encodings[] = {
+        audio::PcmEncoding_UInt8,   audio::PcmEncoding_SInt16,
+        audio::PcmEncoding_SInt24,  audio::PcmEncoding_SInt32,
+        audio::PcmEncoding_Float32, audio::PcmEncoding_Float64,
+    };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(encodings); n++) {
+        WavHeader composed(encodings[n], NumChans, SampleRate);
+        composed.set_data_size(DataSize);
+        composed.compose(file_data);
+
+        WavHeader parsed;
+        CHECK(parsed.parse(file_data, sizeof(file_data)));
+
+        CHECK_EQUAL(encodings[n], parsed.format().encoding);
+        CHECK_EQUAL(audio::PcmEndian_Little, parsed.format().endian);
+        CHECK_EQUAL(NumChans, parsed.num_channels());
+        CHECK_EQUAL(SampleRate, parsed.sample_rate());
+        CHECK_EQUAL(WavHeader::ComposedSize, parsed.data_offset());
+    }
+}
+
+TEST(wav_header, truncated_data) {
+    WavHeader composed(audio::PcmEncoding_SInt16, NumChans, SampleRate);
+    composed.set_data_size(DataSize * 10);
+    composed.compose(file_data);
+
+    WavHeader parsed;
+    CHECK(parsed.parse(file_data, sizeof(file_data)));
+
+    CHECK_EQUAL(DataSize, parsed.data_size());
+
+    // incomplete trailing block is dropped
+    CHECK(parsed.parse(file_data, sizeof(file_data) - 1));
+
+    CHECK_EQUAL(DataSize - NumChans * 2, parsed.data_size());
+}
+
+TEST(wav_header, max_data_size) {
+    WavHeader composed(audio::PcmEncoding_SInt16, NumChans, SampleRate);
+    composed.set_data_size(WavHeader::MaxDataSize);
+    composed.compose(file_data);
+
+    // RIFF chunk size reaches 32-bit limit
+    for (size_t n = 4; n < 8; n++) {
+        UNSIGNED_LONGS_EQUAL(0xFF, file_data[n]);
+    }
+}
+
+TEST(wav_header, bad_header) {
+    WavHeader composed(audio::PcmEncoding_SInt16, NumChans, SampleRate);
+    composed.set_data_size(DataSize);
+    composed.compose(file_data);
+
+    WavHeader parsed;
+
+    CHECK(!parsed.parse(file_data, WavHeader::ComposedSize - 1));
+
+    file_data[0] = 'X';
+    CHECK(!parsed.parse(file_data, sizeof(file_data)));
+}
+
+} // namespace sndio
+} // namespace roc
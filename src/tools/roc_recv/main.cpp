@@ -66,6 +66,7 @@ int main(int argc, char** argv) {
     peer::ContextConfig context_config;
 
     context_config.poisoning = args.poisoning_flag;
+    context_config.network_loop.io_uring = args.io_uring_flag;
 
     if (args.packet_limit_given) {
         if (args.packet_limit_arg <= 0) {
@@ -195,6 +196,9 @@ int main(int argc, char** argv) {
     case resampler_backend_arg_speex:
         receiver_config.default_session.resampler_backend = audio::ResamplerBackend_Speex;
         break;
+    case resampler_backend_arg_drift:
+        receiver_config.default_session.resampler_backend = audio::ResamplerBackend_Drift;
+        break;
     default:
         break;
     }
@@ -217,6 +221,7 @@ int main(int argc, char** argv) {
         break;
     }
 
+    receiver_config.common.multipath = args.multipath_flag;
     receiver_config.common.poisoning = args.poisoning_flag;
     receiver_config.common.profiling = args.profiling_flag;
     receiver_config.common.beeping = args.beeping_flag;
@@ -489,11 +494,23 @@ int main(int argc, char** argv) {
         }
     }
 
+    core::nanoseconds_t pump_buffer_length = 0;
+    if (args.io_thread_flag) {
+        pump_buffer_length = io_config.latency;
+        if (pump_buffer_length == 0) {
+            pump_buffer_length = output_sink->latency();
+        }
+        if (pump_buffer_length == 0) {
+            pump_buffer_length = receiver_config.common.internal_frame_length;
+        }
+    }
+
     sndio::Pump pump(
         context.sample_buffer_factory(), receiver.source(), backup_pipeline.get(),
         *output_sink, receiver_config.common.internal_frame_length,
         receiver_config.common.output_sample_spec,
-        args.oneshot_flag ? sndio::Pump::ModeOneshot : sndio::Pump::ModePermanent);
+        args.oneshot_flag ? sndio::Pump::ModeOneshot : sndio::Pump::ModePermanent,
+        pump_buffer_length);
     if (!pump.valid()) {
         roc_log(LogError, "can't create pump");
         return 1;
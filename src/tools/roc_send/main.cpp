@@ -66,6 +66,7 @@ int main(int argc, char** argv) {
     peer::ContextConfig context_config;
 
     context_config.poisoning = args.poisoning_flag;
+    context_config.network_loop.io_uring = args.io_uring_flag;
 
     if (args.packet_limit_given) {
         if (args.packet_limit_arg <= 0) {
@@ -198,6 +199,42 @@ int main(int argc, char** argv) {
     }
 
     sender_config.interleaving = args.interleaving_flag;
+
+    if (args.interleaving_depth_given) {
+        if (!args.interleaving_flag) {
+            roc_log(LogError,
+                    "--interleaving-depth can't be used when interleaving is disabled");
+            return 1;
+        }
+        if (args.interleaving_depth_arg <= 0) {
+            roc_log(LogError, "invalid --interleaving-depth: should be > 0");
+            return 1;
+        }
+        sender_config.interleaving_depth = (size_t)args.interleaving_depth_arg;
+    }
+
+    if (args.redundancy_given) {
+        if (args.redundancy_arg <= 0) {
+            roc_log(LogError, "invalid --redundancy: should be > 0");
+            return 1;
+        }
+        sender_config.redundancy_depth = (size_t)args.redundancy_arg;
+    }
+
+    sender_config.pacing = args.pacing_flag;
+
+    if (args.pacing_headroom_given) {
+        if (!args.pacing_flag) {
+            roc_log(LogError, "--pacing-headroom can't be used when pacing is disabled");
+            return 1;
+        }
+        if (args.pacing_headroom_arg < 1) {
+            roc_log(LogError, "invalid --pacing-headroom: should be >= 1");
+            return 1;
+        }
+        sender_config.pacer.rate_headroom = args.pacing_headroom_arg;
+    }
+
     sender_config.poisoning = args.poisoning_flag;
     sender_config.profiling = args.profiling_flag;
 